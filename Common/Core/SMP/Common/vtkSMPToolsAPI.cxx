@@ -18,6 +18,9 @@ namespace smp
 {
 VTK_ABI_NAMESPACE_BEGIN
 
+//------------------------------------------------------------------------------
+vtkSMPTaskObserver::~vtkSMPTaskObserver() = default;
+
 //------------------------------------------------------------------------------
 vtkSMPToolsAPI::vtkSMPToolsAPI()
 {
@@ -271,6 +274,24 @@ bool vtkSMPToolsAPI::GetSingleThread()
   }
 }
 
+//------------------------------------------------------------------------------
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsAPI::NewTaskGroup()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      return this->SequentialBackend->NewTaskGroup();
+    case BackendType::STDThread:
+      return this->STDThreadBackend->NewTaskGroup();
+    case BackendType::TBB:
+      return this->TBBBackend->NewTaskGroup();
+    case BackendType::OpenMP:
+      return this->OpenMPBackend->NewTaskGroup();
+    default:
+      return nullptr;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Must NOT be initialized. Default initialization to zero is necessary.
 unsigned int vtkSMPToolsAPIInitializeCount;
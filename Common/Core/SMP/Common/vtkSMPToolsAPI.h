@@ -9,6 +9,7 @@
 #include "vtkObject.h"
 #include "vtkSMP.h"
 
+#include <atomic>
 #include <memory>
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
@@ -35,6 +36,17 @@ VTK_ABI_NAMESPACE_BEGIN
 
 using vtkSMPToolsDefaultImpl = vtkSMPToolsImpl<DefaultBackend>;
 
+//--------------------------------------------------------------------------------
+// Notified of the execution of each range of a vtkSMPTools::For, from the
+// thread executing it. Used to profile the tasks of the backends.
+class VTKCOMMONCORE_EXPORT vtkSMPTaskObserver
+{
+public:
+  virtual ~vtkSMPTaskObserver();
+  virtual void TaskBegin(vtkIdType first, vtkIdType last) = 0;
+  virtual void TaskEnd(vtkIdType first, vtkIdType last) = 0;
+};
+
 class VTKCOMMONCORE_EXPORT vtkSMPToolsAPI
 {
 public:
@@ -71,9 +83,18 @@ public:
   //--------------------------------------------------------------------------------
   bool GetSingleThread();
 
+  //--------------------------------------------------------------------------------
+  std::unique_ptr<vtkSMPTaskGroupImpl> NewTaskGroup();
+
   //--------------------------------------------------------------------------------
   int GetInternalDesiredNumberOfThread() { return this->DesiredNumberOfThread; }
 
+  //--------------------------------------------------------------------------------
+  void SetTaskObserver(vtkSMPTaskObserver* observer) { this->TaskObserver = observer; }
+
+  //--------------------------------------------------------------------------------
+  vtkSMPTaskObserver* GetTaskObserver() { return this->TaskObserver; }
+
   //------------------------------------------------------------------------------
   template <typename Config, typename T>
   void LocalScope(Config const& config, T&& lambda)
@@ -295,6 +316,45 @@ private:
 #else
   std::unique_ptr<vtkSMPToolsDefaultImpl> OpenMPBackend;
 #endif
+
+  /**
+   * Observer of the tasks, read concurrently by the threads executing them
+   */
+  std::atomic<vtkSMPTaskObserver*> TaskObserver{ nullptr };
+};
+
+//--------------------------------------------------------------------------------
+// Notifies the task observer, if any, of the execution of a range for the
+// lifetime of the scope.
+class vtkSMPTaskScope
+{
+public:
+  vtkSMPTaskScope(vtkIdType first, vtkIdType last)
+    : Observer(vtkSMPToolsAPI::GetInstance().GetTaskObserver())
+    , First(first)
+    , Last(last)
+  {
+    if (this->Observer)
+    {
+      this->Observer->TaskBegin(first, last);
+    }
+  }
+
+  ~vtkSMPTaskScope()
+  {
+    if (this->Observer)
+    {
+      this->Observer->TaskEnd(this->First, this->Last);
+    }
+  }
+
+  vtkSMPTaskScope(const vtkSMPTaskScope&) = delete;
+  void operator=(const vtkSMPTaskScope&) = delete;
+
+private:
+  vtkSMPTaskObserver* Observer;
+  vtkIdType First;
+  vtkIdType Last;
 };
 
 //--------------------------------------------------------------------------------
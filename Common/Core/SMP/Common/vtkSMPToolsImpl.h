@@ -9,6 +9,8 @@
 #include "vtkSMP.h"
 
 #include <atomic>
+#include <functional>
+#include <memory>
 
 #define VTK_SMP_MAX_BACKENDS_NB 4
 
@@ -42,6 +44,26 @@ const BackendType DefaultBackend = BackendType::TBB;
 const BackendType DefaultBackend = BackendType::OpenMP;
 #endif
 
+//--------------------------------------------------------------------------------
+// Group of tasks of a backend, see vtkSMPTools::TaskGroup.
+class VTKCOMMONCORE_EXPORT vtkSMPTaskGroupImpl
+{
+public:
+  virtual ~vtkSMPTaskGroupImpl() = default;
+  virtual void Spawn(std::function<void()> task) = 0;
+  virtual void Wait() = 0;
+};
+
+//--------------------------------------------------------------------------------
+// Group executing its tasks when they are spawned, for the backends that do
+// not execute tasks concurrently.
+class VTKCOMMONCORE_EXPORT vtkSMPSequentialTaskGroup : public vtkSMPTaskGroupImpl
+{
+public:
+  void Spawn(std::function<void()> task) override { task(); }
+  void Wait() override {}
+};
+
 template <BackendType Backend>
 class VTKCOMMONCORE_EXPORT vtkSMPToolsImpl
 {
@@ -67,6 +89,9 @@ public:
   //--------------------------------------------------------------------------------
   bool GetSingleThread();
 
+  //--------------------------------------------------------------------------------
+  std::unique_ptr<vtkSMPTaskGroupImpl> NewTaskGroup();
+
   //--------------------------------------------------------------------------------
   template <typename FunctorInternal>
   void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi);
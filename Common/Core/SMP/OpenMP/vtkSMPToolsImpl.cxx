@@ -101,6 +101,13 @@ bool vtkSMPToolsImpl<BackendType::OpenMP>::GetSingleThread()
   return GetSingleThreadOpenMP();
 }
 
+//------------------------------------------------------------------------------
+template <>
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsImpl<BackendType::OpenMP>::NewTaskGroup()
+{
+  return std::unique_ptr<vtkSMPTaskGroupImpl>(new vtkSMPSequentialTaskGroup);
+}
+
 //------------------------------------------------------------------------------
 void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
   ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated)
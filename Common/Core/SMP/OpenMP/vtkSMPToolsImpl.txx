@@ -159,6 +159,10 @@ int vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedDefaultNumberOfThreads();
 template <>
 bool vtkSMPToolsImpl<BackendType::OpenMP>::GetSingleThread();
 
+//--------------------------------------------------------------------------------
+template <>
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsImpl<BackendType::OpenMP>::NewTaskGroup();
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
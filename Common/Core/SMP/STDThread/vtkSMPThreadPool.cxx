@@ -5,10 +5,8 @@
 
 #include <vtkObject.h>
 
-#include <algorithm>
 #include <cassert>
-#include <condition_variable>
-#include <future>
+#include <deque>
 #include <iostream>
 
 namespace vtk
@@ -19,8 +17,6 @@ namespace smp
 {
 VTK_ABI_NAMESPACE_BEGIN
 
-static constexpr std::size_t NoRunningJob = (std::numeric_limits<std::size_t>::max)();
-
 struct vtkSMPThreadPool::ThreadJob
 {
   // This constructor is needed because aggregate initialization can not have default value
@@ -34,20 +30,19 @@ struct vtkSMPThreadPool::ThreadJob
 
   ProxyData* Proxy{};               // Proxy that allocated this job
   std::function<void()> Function{}; // Actual user job
-  std::promise<void> Promise{};     // Set when job is done
 };
 
 struct vtkSMPThreadPool::ThreadData
 {
-  // stack of jobs, any thread can push, and only push, jobs (and Mutex must be locked)
-  std::vector<ThreadJob> Jobs{};
-  // Current job (used to map thread to Proxy), using an index is okay as only this thread can
-  // erase the job and other threads can only push back new jobs not insert. This constraint could
-  // be relaxed by using unique ids instead.
-  std::size_t RunningJob{ NoRunningJob };
-  std::thread SystemThread{};                  // the system thread, not really used
-  std::mutex Mutex{};                          // thread mutex, used for Jobs manipulation
-  std::condition_variable ConditionVariable{}; // thread cv, used to wake up the thread
+  // Deque of jobs: the thread pushes and pops its jobs at the back, the other threads steal them
+  // from the front (and Mutex must be locked)
+  std::deque<ThreadJob> Jobs{};
+  std::mutex Mutex{};         // thread mutex, used for Jobs manipulation
+  vtkSMPThreadPool* Pool{};   // Pool of the thread
+  std::size_t Index{};        // Index of the thread in the pool
+  ProxyData* RunningProxy{};  // Proxy of the running job, only accessed by this thread
+  std::size_t RunningId{};    // Virtual thread ID in RunningProxy
+  std::thread SystemThread{}; // the system thread, not really used
 };
 
 struct vtkSMPThreadPool::ProxyThreadData
@@ -67,137 +62,217 @@ struct vtkSMPThreadPool::ProxyThreadData
 
 struct vtkSMPThreadPool::ProxyData
 {
-  vtkSMPThreadPool* Pool{};                     // Pool that created this proxy
-  ProxyData* Parent{};                          // either null (for top level) or the parent
-  std::vector<ProxyThreadData> Threads{};       // Threads used by this
-  std::size_t NextThread{};                     // Round-robin thread for jobs
-  std::vector<std::future<void>> JobsFutures{}; // Used to know when job is done
-  std::mutex Mutex{};                           // Used to synchronize
+  vtkSMPThreadPool* Pool{};                // Pool that created this proxy
+  ProxyData* Parent{};                     // either null (for top level) or the parent
+  std::size_t MaxThreads{};                // Maximum number of threads running its jobs
+  std::vector<ProxyThreadData> Threads{};  // Threads that ran its jobs, the creating one first
+  std::mutex Mutex{};                      // Used to synchronize Threads
+  std::atomic<std::size_t> PendingJobs{};  // Jobs pushed and not done yet
+  std::atomic<ThreadData*> SingleThread{}; // First thread that ran one of its jobs
 };
 
-void vtkSMPThreadPool::RunJob(
-  ThreadData& data, std::size_t jobIndex, std::unique_lock<std::mutex>& lock)
+void vtkSMPThreadPool::RunJob(ThreadData& data, ThreadJob& job, std::size_t threadId)
 {
-  assert(lock.owns_lock() && "Caller must have locked mutex");
-  assert(jobIndex < data.Jobs.size() && "jobIndex out of range");
+  ProxyData* proxy = job.Proxy;
+
+  // store old running proxy for nested proxies, joining threads run jobs within their own job
+  ProxyData* const oldRunningProxy = data.RunningProxy;
+  const std::size_t oldRunningId = data.RunningId;
+  data.RunningProxy = proxy;
+  data.RunningId = threadId;
 
-  const auto oldRunningJob = data.RunningJob; // store old running job for nested threads
-  data.RunningJob = jobIndex;                 // Set thread running job
-  auto function = std::move(data.Jobs[data.RunningJob].Function);
-  lock.unlock(); // MSVC: warning C26110 is a false positive
+  ThreadData* noSingleThread = nullptr;
+  proxy->SingleThread.compare_exchange_strong(noSingleThread, &data, std::memory_order_relaxed);
 
   try
   {
-    function(); // run the function
+    job.Function(); // run the function
   }
   catch (const std::exception& e)
   {
     vtkErrorWithObjectMacro(nullptr,
-      "Function called by " << vtkSMPThreadPool::GetInstance().GetThreadId()
+      "Function called by " << this->GetThreadId()
                             << " has thrown an exception. The exception is ignored. what():\n"
                             << e.what());
   }
   catch (...)
   {
     vtkErrorWithObjectMacro(nullptr,
-      "Function called by " << vtkSMPThreadPool::GetInstance().GetThreadId()
+      "Function called by " << this->GetThreadId()
                             << " has thrown an unknown exception. The exception is ignored.");
   }
 
-  lock.lock();
-  data.Jobs[data.RunningJob].Promise.set_value();
-  data.Jobs.erase(data.Jobs.begin() + jobIndex);
-  data.RunningJob = oldRunningJob;
-}
-
-vtkSMPThreadPool::Proxy::Proxy(std::unique_ptr<ProxyData>&& data)
-  : Data{ std::move(data) }
-{
-}
+  // Release what the job captured before the proxy can be joined
+  job.Function = nullptr;
+  data.RunningProxy = oldRunningProxy;
+  data.RunningId = oldRunningId;
 
-vtkSMPThreadPool::Proxy::~Proxy()
-{
-  if (!this->Data->JobsFutures.empty())
+  // The proxy may be destroyed as soon as its last job is done, don't use it afterward
+  if (proxy->PendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1)
   {
-    vtkErrorWithObjectMacro(nullptr, "Proxy not joined. Terminating.");
-    std::terminate();
+    {
+      std::lock_guard<std::mutex> lock{ this->Mutex };
+    }
+    this->JoinConditionVariable.notify_all();
   }
 }
 
-vtkSMPThreadPool::Proxy::Proxy(Proxy&&) noexcept = default;
-vtkSMPThreadPool::Proxy& vtkSMPThreadPool::Proxy::operator=(Proxy&&) noexcept = default;
-
-void vtkSMPThreadPool::Proxy::Join()
+bool vtkSMPThreadPool::RunNextJob(ThreadData& data, ProxyData* joining)
 {
-  if (this->IsTopLevel()) // wait for all futures, all jobs are done by other threads
-  {
-    for (auto& future : this->Data->JobsFutures)
+  // A joining thread only runs the jobs of the joined proxy and of its nested proxies: running
+  // another job could wait for the job the thread is running, or interleave thread local values.
+  const auto canRun = [joining](const ThreadJob& job) {
+    if (!joining)
     {
-      future.wait();
+      return true;
     }
-  }
-  else // nested run code in calling thread too
+    for (auto* proxy = job.Proxy; proxy != nullptr; proxy = proxy->Parent)
+    {
+      if (proxy == joining)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // Look at the own deque of the thread first, then steal from the next ones
+  const std::size_t threadCount = this->Threads.size();
+  for (std::size_t i = 0; i < threadCount; ++i)
   {
-    // Run jobs associated with this thread and proxy
-    ThreadData& threadData = *this->Data->Threads[0].Thread;
-    assert(threadData.SystemThread.get_id() == std::this_thread::get_id());
+    ThreadData& victim = *this->Threads[(data.Index + i) % threadCount];
+    std::unique_lock<std::mutex> lock{ victim.Mutex };
 
-    while (true)
+    const std::size_t jobCount = victim.Jobs.size();
+    for (std::size_t j = 0; j < jobCount; ++j)
     {
-      // protect access in case other thread push work for current thread
-      std::unique_lock<std::mutex> lock{ threadData.Mutex };
-
-      auto it = std::find_if(threadData.Jobs.begin(), threadData.Jobs.end(),
-        [this](ThreadJob& job) { return job.Proxy == this->Data.get(); });
+      // Most recent job of the own deque, oldest job of the other ones
+      const std::size_t jobIndex = i == 0 ? jobCount - 1 - j : j;
+      ThreadJob& candidate = victim.Jobs[jobIndex];
+      if (!canRun(candidate))
+      {
+        continue;
+      }
 
-      if (it == threadData.Jobs.end()) // no remaining job associated to this proxy
+      const std::size_t threadId = this->GetProxyThreadId(candidate.Proxy, &data);
+      if (threadId == 0) // the proxy already uses as many threads as requested
       {
-        break;
+        continue;
       }
 
-      const auto jobIndex = static_cast<std::size_t>(std::distance(threadData.Jobs.begin(), it));
-      RunJob(threadData, jobIndex, lock);
-    }
+      ThreadJob job{ std::move(candidate) };
+      victim.Jobs.erase(victim.Jobs.begin() + jobIndex);
+      lock.unlock();
 
-    for (auto& future : this->Data->JobsFutures)
-    {
-      future.wait();
+      this->RunJob(data, job, threadId);
+      return true;
     }
   }
 
-  this->Data->JobsFutures.clear();
+  return false;
 }
 
-void vtkSMPThreadPool::Proxy::DoJob(std::function<void()> job)
+void vtkSMPThreadPool::PushJob(ProxyData* proxy, std::function<void()> job)
 {
-  this->Data->NextThread = (this->Data->NextThread + 1) % this->Data->Threads.size();
-  auto& proxyThread = this->Data->Threads[this->Data->NextThread];
+  proxy->PendingJobs.fetch_add(1, std::memory_order_relaxed);
 
-  if (!this->IsTopLevel() && this->Data->NextThread == 0) // when nested, thread 0 is "this_thread"
+  // Threads of the pool push on their own deque, other threads spread their jobs
+  ThreadData* data = this->GetCallerThreadData();
+  if (!data)
   {
-    assert(std::this_thread::get_id() == proxyThread.Thread->SystemThread.get_id());
+    const auto next = this->NextThread.fetch_add(1, std::memory_order_relaxed);
+    data = this->Threads[next % this->Threads.size()].get();
+  }
 
-    std::unique_lock<std::mutex> lock{ proxyThread.Thread->Mutex };
-    proxyThread.Thread->Jobs.emplace_back(this->Data.get(), std::move(job));
+  {
+    std::lock_guard<std::mutex> lock{ data->Mutex };
+    data->Jobs.emplace_back(proxy, std::move(job));
+  }
+
+  bool notifyJoiningThreads;
+  {
+    std::lock_guard<std::mutex> lock{ this->Mutex };
+    this->Epoch.fetch_add(1, std::memory_order_release);
+    notifyJoiningThreads = this->JoiningThreads != 0;
+  }
+
+  // Any idle thread can run the job, unless the proxy may not use all the threads
+  if (proxy->MaxThreads < this->Threads.size())
+  {
+    this->WorkConditionVariable.notify_all();
   }
   else
   {
-    std::unique_lock<std::mutex> lock{ proxyThread.Thread->Mutex };
+    this->WorkConditionVariable.notify_one();
+  }
 
-    auto& jobs = proxyThread.Thread->Jobs;
-    jobs.emplace_back(this->Data.get(), std::move(job));
-    this->Data->JobsFutures.emplace_back(jobs.back().Promise.get_future());
+  if (notifyJoiningThreads)
+  {
+    this->JoinConditionVariable.notify_all();
+  }
+}
+
+void vtkSMPThreadPool::Wait(ProxyData* proxy)
+{
+  ThreadData* data = this->GetCallerThreadData();
 
-    lock.unlock();
+  while (proxy->PendingJobs.load(std::memory_order_acquire) != 0)
+  {
+    const std::size_t epoch = this->Epoch.load(std::memory_order_acquire);
+    if (data && this->RunNextJob(*data, proxy))
+    {
+      continue;
+    }
 
-    proxyThread.Thread->ConditionVariable.notify_one();
+    // Threads of the pool are woken up by new jobs too, as they may belong to the proxy
+    std::unique_lock<std::mutex> lock{ this->Mutex };
+    if (data)
+    {
+      ++this->JoiningThreads;
+    }
+    this->JoinConditionVariable.wait(lock, [this, proxy, data, epoch] {
+      return proxy->PendingJobs.load(std::memory_order_acquire) == 0 ||
+        (data && this->Epoch.load(std::memory_order_relaxed) != epoch);
+    });
+    if (data)
+    {
+      --this->JoiningThreads;
+    }
   }
 }
 
+vtkSMPThreadPool::Proxy::Proxy(std::unique_ptr<ProxyData>&& data)
+  : Data{ std::move(data) }
+{
+}
+
+vtkSMPThreadPool::Proxy::~Proxy()
+{
+  if (this->Data && this->Data->PendingJobs.load(std::memory_order_acquire) != 0)
+  {
+    vtkErrorWithObjectMacro(nullptr, "Proxy not joined. Terminating.");
+    std::terminate();
+  }
+}
+
+vtkSMPThreadPool::Proxy::Proxy(Proxy&&) noexcept = default;
+vtkSMPThreadPool::Proxy& vtkSMPThreadPool::Proxy::operator=(Proxy&&) noexcept = default;
+
+void vtkSMPThreadPool::Proxy::Join()
+{
+  this->Data->Pool->Wait(this->Data.get());
+}
+
+void vtkSMPThreadPool::Proxy::DoJob(std::function<void()> job)
+{
+  this->Data->Pool->PushJob(this->Data.get(), std::move(job));
+}
+
 std::vector<std::reference_wrapper<std::thread>> vtkSMPThreadPool::Proxy::GetThreads() const
 {
   std::vector<std::reference_wrapper<std::thread>> output;
 
+  std::lock_guard<std::mutex> lock{ this->Data->Mutex };
   for (auto& proxyThread : this->Data->Threads)
   {
     output.emplace_back(proxyThread.Thread->SystemThread);
@@ -219,7 +294,9 @@ vtkSMPThreadPool::vtkSMPThreadPool()
   for (std::size_t i{}; i < threadCount; ++i)
   {
     std::unique_ptr<ThreadData> data{ new ThreadData{} };
-    data->SystemThread = this->MakeThread();
+    data->Pool = this;
+    data->Index = i;
+    data->SystemThread = this->MakeThread(data.get());
     this->Threads.emplace_back(std::move(data));
   }
 
@@ -228,12 +305,11 @@ vtkSMPThreadPool::vtkSMPThreadPool()
 
 vtkSMPThreadPool::~vtkSMPThreadPool()
 {
-  this->Joining.store(true, std::memory_order_release);
-
-  for (auto& threadData : this->Threads)
   {
-    threadData->ConditionVariable.notify_one();
+    std::lock_guard<std::mutex> lock{ this->Mutex };
+    this->Joining.store(true, std::memory_order_release);
   }
+  this->WorkConditionVariable.notify_all();
 
   for (auto& threadData : this->Threads)
   {
@@ -250,25 +326,21 @@ vtkSMPThreadPool::Proxy vtkSMPThreadPool::AllocateThreads(std::size_t threadCoun
 
   std::unique_ptr<ProxyData> proxy{ new ProxyData{} };
   proxy->Pool = this;
+  proxy->MaxThreads = threadCount;
   proxy->Threads.reserve(threadCount);
 
   // Check if we are in the pool
   ThreadData* threadData = this->GetCallerThreadData();
   if (threadData)
   {
-    // Don't lock since we are in the running job, in this thread
-    proxy->Parent = threadData->Jobs[threadData->RunningJob].Proxy;
-    // First thread is always current thread
+    proxy->Parent = threadData->RunningProxy;
+    // First thread is always current thread, so that joining always makes progress
     proxy->Threads.emplace_back(threadData, this->GetNextThreadId());
-    this->FillThreadsForNestedProxy(proxy.get(), threadCount);
   }
   else
   {
+    // Threads are added when they run their first job of the proxy
     proxy->Parent = nullptr;
-    for (std::size_t i{}; i < threadCount; ++i)
-    {
-      proxy->Threads.emplace_back(this->Threads[i].get(), this->GetNextThreadId());
-    }
   }
 
   return Proxy{ std::move(proxy) };
@@ -278,20 +350,9 @@ std::size_t vtkSMPThreadPool::GetThreadId() const noexcept
 {
   auto* threadData = this->GetCallerThreadData();
 
-  if (threadData)
+  if (threadData && threadData->RunningProxy)
   {
-    std::unique_lock<std::mutex> lock{ threadData->Mutex }; // protect threadData->Jobs access
-    assert(threadData->RunningJob != NoRunningJob && "Invalid state");
-    auto& proxyThreads = threadData->Jobs[threadData->RunningJob].Proxy->Threads;
-    lock.unlock();
-
-    for (const auto& proxyThread : proxyThreads)
-    {
-      if (proxyThread.Thread == threadData)
-      {
-        return proxyThread.Id;
-      }
-    }
+    return threadData->RunningId;
   }
 
   // Use 1 for any thread outside the pool and 2+ for ids of proxy thread because thread local
@@ -306,14 +367,12 @@ bool vtkSMPThreadPool::IsParallelScope() const noexcept
 
 bool vtkSMPThreadPool::GetSingleThread() const
 {
-  // Return true if the caller is the thread[0] of the current running proxy
+  // Return true if the caller is the first thread that ran a job of the current running proxy
 
   auto* threadData = GetCallerThreadData();
-  if (threadData)
+  if (threadData && threadData->RunningProxy)
   {
-    std::lock_guard<std::mutex> lock{ threadData->Mutex };
-    assert(threadData->RunningJob != NoRunningJob && "Invalid state");
-    return threadData->Jobs[threadData->RunningJob].Proxy->Threads[0].Thread == threadData;
+    return threadData->RunningProxy->SingleThread.load(std::memory_order_relaxed) == threadData;
   }
 
   return false;
@@ -326,90 +385,70 @@ std::size_t vtkSMPThreadPool::ThreadCount() const noexcept
 
 vtkSMPThreadPool::ThreadData* vtkSMPThreadPool::GetCallerThreadData() const noexcept
 {
-  for (const auto& threadData : this->Threads)
-  {
-    if (threadData->SystemThread.get_id() == std::this_thread::get_id())
-    {
-      return threadData.get();
-    }
-  }
+  ThreadData* threadData = GetCallerThreadSlot();
+  return threadData && threadData->Pool == this ? threadData : nullptr;
+}
 
-  return nullptr;
+vtkSMPThreadPool::ThreadData*& vtkSMPThreadPool::GetCallerThreadSlot() noexcept
+{
+  static thread_local ThreadData* threadData = nullptr;
+  return threadData;
 }
 
-std::thread vtkSMPThreadPool::MakeThread()
+std::thread vtkSMPThreadPool::MakeThread(ThreadData* data)
 {
-  return std::thread{ [this]() {
+  return std::thread{ [this, data]() {
     while (!this->Initialized.load(std::memory_order_acquire))
     {
     }
 
-    ThreadData& threadData = *this->GetCallerThreadData();
+    GetCallerThreadSlot() = data;
 
     // Main loop for threads of the pool
-    // When they are woke up, they check for new job and stop if "this->Joining" is true
-    // and no more jobs are running
+    // They run their own jobs or steal jobs from the other threads, sleep when no job is left,
+    // and stop when "this->Joining" is true
     while (true)
     {
-      std::unique_lock<std::mutex> lock{ threadData.Mutex };
-
-      // Job stealing could be implemented but it will requires some changes in the process
-      // A thread that as no longer work to do could look at other threads jobs to "steal" a job
-      // from them and thus increase parallelism. This must take care of not generating deadlocks
-      // and should not increase Proxy parallelism above requested thread count.
-      // This goes out of the scope of current implementation.
-      threadData.ConditionVariable.wait(lock, [this, &threadData] {
-        return !threadData.Jobs.empty() || this->Joining.load(std::memory_order_acquire);
+      const std::size_t epoch = this->Epoch.load(std::memory_order_acquire);
+      if (this->RunNextJob(*data, nullptr))
+      {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock{ this->Mutex };
+      this->WorkConditionVariable.wait(lock, [this, epoch] {
+        return this->Epoch.load(std::memory_order_relaxed) != epoch ||
+          this->Joining.load(std::memory_order_acquire);
       });
 
-      if (threadData.Jobs.empty())
+      if (this->Joining.load(std::memory_order_acquire))
       {
-        break; // joining
+        break;
       }
-
-      RunJob(threadData, threadData.Jobs.size() - 1, lock);
     }
   } };
 }
 
-void vtkSMPThreadPool::FillThreadsForNestedProxy(ProxyData* proxy, std::size_t maxCount)
+std::size_t vtkSMPThreadPool::GetProxyThreadId(ProxyData* proxy, ThreadData* data)
 {
-  // This function assigns thread for proxies, this function assumes that the calling thread is
-  // already part of the assigned thread for the proxy.
-  // Otherwise it will assign thread pool threads that are not already used by any of proxy parents
-
-  if (proxy->Parent->Threads.size() == this->Threads.size())
+  // Returns the virtual ID of the thread in the proxy, adding the thread to the proxy if it may
+  // use one more thread, or 0 if the thread may not run the jobs of the proxy
+  std::lock_guard<std::mutex> lock{ proxy->Mutex };
+  for (const auto& proxyThread : proxy->Threads)
   {
-    return; // No thread will be available
-  }
-
-  const auto isFree = [proxy](ThreadData* threadData) {
-    for (auto* parent = proxy->Parent; parent != nullptr; parent = parent->Parent)
+    if (proxyThread.Thread == data)
     {
-      for (auto& proxyThread : parent->Threads)
-      {
-        if (proxyThread.Thread == threadData)
-        {
-          return false;
-        }
-      }
+      return proxyThread.Id;
     }
+  }
 
-    return true;
-  };
-
-  for (auto& threadData : this->Threads)
+  if (proxy->Threads.size() >= proxy->MaxThreads)
   {
-    if (isFree(threadData.get()))
-    {
-      proxy->Threads.emplace_back(threadData.get(), this->GetNextThreadId());
-    }
-
-    if (proxy->Threads.size() == maxCount)
-    {
-      break;
-    }
+    return 0;
   }
+
+  proxy->Threads.emplace_back(data, this->GetNextThreadId());
+  return proxy->Threads.back().Id;
 }
 
 std::size_t vtkSMPThreadPool::GetNextThreadId() noexcept
@@ -3,11 +3,10 @@
 // .NAME vtkSMPThreadPool - A thread pool implementation using std::thread
 //
 // .SECTION Description
-// vtkSMPThreadPool class creates a thread pool of std::thread, the number
-// of thread must be specified at the initialization of the class.
-// The DoJob() method is used attributes the job to a free thread, if all
-// threads are working, the job is kept in a queue. Note that vtkSMPThreadPool
-// destructor joins threads and finish the jobs in the queue.
+// vtkSMPThreadPool class creates a thread pool of std::thread, one per
+// hardware thread. Each thread has its own queue of jobs, and a thread that
+// has no more jobs to run steals the jobs of the other threads. Note that
+// vtkSMPThreadPool destructor joins threads.
 
 #ifndef vtkSMPThreadPool_h
 #define vtkSMPThreadPool_h
@@ -15,11 +14,13 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkSystemIncludes.h"
 
-#include <atomic>     // For std::atomic
-#include <functional> // For std::function
-#include <mutex>      // For std::unique_lock
-#include <thread>     // For std::thread
-#include <vector>     // For std::vector
+#include <atomic>             // For std::atomic
+#include <condition_variable> // For std::condition_variable
+#include <functional>         // For std::function
+#include <memory>             // For std::unique_ptr
+#include <mutex>              // For std::mutex
+#include <thread>             // For std::thread
+#include <vector>             // For std::vector
 
 namespace vtk
 {
@@ -36,6 +37,14 @@ VTK_ABI_NAMESPACE_BEGIN
  * This thread pool use a Proxy system that is used to allocate a certain amount of threads from
  * the pool, which enable support for SMP local scopes.
  * You need to have a Proxy to submit job to the pool.
+ *
+ * Jobs are scheduled by work stealing: each thread of the pool has a deque of jobs. A job
+ * submitted from a thread of the pool is pushed at the back of the deque of this thread, which
+ * runs the most recent jobs of its deque first, while the threads with no jobs left steal the
+ * oldest jobs of the other deques. Jobs submitted from a thread that does not belong to the pool
+ * are spread over the deques. Stealing the oldest jobs balances the load with few steals, as
+ * they are usually the largest ones in recursive algorithms, and running the most recent ones
+ * keeps the data in the cache of the thread.
  */
 class VTKCOMMONCORE_EXPORT vtkSMPThreadPool
 {
@@ -50,11 +59,8 @@ public:
    * @brief Proxy class used to submit work to the thread pool.
    *
    * A proxy act like a single thread pool, but it submits work to its parent thread pool.
-   * Using a proxy from multiple threads at the same time is undefined behaviour.
-   *
-   * Note: Even if nothing prevent a proxy to be moved around threads, it should either be used in
-   * the creating thread or in a thread that does not belong to the pool, otherwise it may create a
-   * deadlock when joining.
+   * Jobs may be submitted to a proxy by the thread that created it and by its running jobs, but
+   * only the thread that created it may join it.
    */
   class VTKCOMMONCORE_EXPORT Proxy final
   {
@@ -73,8 +79,9 @@ public:
     /**
      * @brief Blocks calling thread until all jobs are done.
      *
-     * Note: nested proxies may execute jobs on calling thread during this function to maximize
-     * parallelism.
+     * When called from a thread of the pool, the calling thread runs the jobs of this proxy, and
+     * of the proxies created by these jobs, while waiting. It never runs the jobs of the other
+     * proxies, so that the job it was running is not interleaved with unrelated jobs.
      */
     void Join();
 
@@ -84,7 +91,9 @@ public:
     void DoJob(std::function<void()> job);
 
     /**
-     * @brief Get a reference on all system threads used by this proxy
+     * @brief Get a reference on all system threads that ran jobs of this proxy
+     *
+     * For a nested proxy, the thread that created it comes first.
      */
     std::vector<std::reference_wrapper<std::thread>> GetThreads() const;
 
@@ -114,9 +123,9 @@ public:
    * this prevent threads to be created every time a SMP function is called.
    *
    * If the current thread not in the pool, it will create a "top-level" proxy, otherwise it will
-   * create a nested proxy. A nested proxy will never use a thread that is already in use by its
-   * "parent" proxies to prevent deadlocks. It means that nested paralism may have a more limited
-   * amount of threads.
+   * create a nested proxy. The jobs of a nested proxy may run on any thread of the pool that is
+   * idle or that is joining one of its parent proxies, so that nested parallelism uses all the
+   * threads of the pool. The thread that created a nested proxy is always one of its threads.
    *
    * @param threadCount max amount of thread to use. If 0, uses the number of thread of the pool.
    * If greater than the number of thread of the pool, uses the number of thread of the pool.
@@ -145,6 +154,8 @@ public:
 
   /**
    * @brief Returns true for a single proxy thread, false for the others.
+   *
+   * The single thread is the first thread that ran a job of the proxy.
    */
   bool GetSingleThread() const;
 
@@ -154,19 +165,29 @@ public:
   std::size_t ThreadCount() const noexcept;
 
 private:
-  // static because also used by proxy
-  static void RunJob(ThreadData& data, std::size_t jobIndex, std::unique_lock<std::mutex>& lock);
+  void RunJob(ThreadData& data, ThreadJob& job, std::size_t threadId);
+  bool RunNextJob(ThreadData& data, ProxyData* joining);
+  void PushJob(ProxyData* proxy, std::function<void()> job);
+  void Wait(ProxyData* proxy);
 
   ThreadData* GetCallerThreadData() const noexcept;
+  static ThreadData*& GetCallerThreadSlot() noexcept;
 
-  std::thread MakeThread();
-  void FillThreadsForNestedProxy(ProxyData* proxy, std::size_t maxCount);
+  std::thread MakeThread(ThreadData* data);
+  std::size_t GetProxyThreadId(ProxyData* proxy, ThreadData* data);
   std::size_t GetNextThreadId() noexcept;
 
   std::atomic<bool> Initialized{};
   std::atomic<bool> Joining{};
   std::vector<std::unique_ptr<ThreadData>> Threads; // Thread pool, fixed size
   std::atomic<std::size_t> NextProxyThreadId{ 1 };
+  std::atomic<std::size_t> NextThread{}; // Round-robin deque for jobs pushed by external threads
+
+  std::mutex Mutex{};                              // Used to wait for jobs or for a proxy
+  std::condition_variable WorkConditionVariable{}; // Wakes up the idle threads
+  std::condition_variable JoinConditionVariable{}; // Wakes up the joining threads
+  std::atomic<std::size_t> Epoch{};                // Incremented under Mutex by each push
+  std::size_t JoiningThreads{};                    // Threads of the pool waiting for a proxy
 
 public:
   static vtkSMPThreadPool& GetInstance();
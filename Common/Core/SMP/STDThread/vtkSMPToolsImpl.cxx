@@ -67,6 +67,34 @@ bool vtkSMPToolsImpl<BackendType::STDThread>::GetSingleThread()
   return vtkSMPThreadPool::GetInstance().GetSingleThread();
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Tasks of a group are the jobs of a proxy of the thread pool
+class vtkSMPTaskGroupSTDThread : public vtkSMPTaskGroupImpl
+{
+public:
+  vtkSMPTaskGroupSTDThread()
+    : Pool(vtkSMPThreadPool::GetInstance().AllocateThreads(GetNumberOfThreadsSTDThread()))
+  {
+  }
+
+  void Spawn(std::function<void()> task) override { this->Pool.DoJob(std::move(task)); }
+
+  void Wait() override { this->Pool.Join(); }
+
+private:
+  vtkSMPThreadPool::Proxy Pool;
+};
+}
+
+//------------------------------------------------------------------------------
+template <>
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsImpl<BackendType::STDThread>::NewTaskGroup()
+{
+  return std::unique_ptr<vtkSMPTaskGroupImpl>(new vtkSMPTaskGroupSTDThread);
+}
+
 //------------------------------------------------------------------------------
 template <>
 bool vtkSMPToolsImpl<BackendType::STDThread>::IsParallelScope()
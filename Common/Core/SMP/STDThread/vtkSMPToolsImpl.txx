@@ -131,6 +131,10 @@ int vtkSMPToolsImpl<BackendType::STDThread>::GetEstimatedDefaultNumberOfThreads(
 template <>
 bool vtkSMPToolsImpl<BackendType::STDThread>::GetSingleThread();
 
+//--------------------------------------------------------------------------------
+template <>
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsImpl<BackendType::STDThread>::NewTaskGroup();
+
 //--------------------------------------------------------------------------------
 template <>
 bool vtkSMPToolsImpl<BackendType::STDThread>::IsParallelScope();
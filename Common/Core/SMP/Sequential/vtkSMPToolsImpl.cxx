@@ -39,6 +39,13 @@ bool vtkSMPToolsImpl<BackendType::Sequential>::GetSingleThread()
   return true;
 }
 
+//------------------------------------------------------------------------------
+template <>
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsImpl<BackendType::Sequential>::NewTaskGroup()
+{
+  return std::unique_ptr<vtkSMPTaskGroupImpl>(new vtkSMPSequentialTaskGroup);
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
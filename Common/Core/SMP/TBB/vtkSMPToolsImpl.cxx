@@ -14,6 +14,7 @@
 #endif
 
 #include <tbb/task_arena.h> // For tbb:task_arena
+#include <tbb/task_group.h> // For tbb:task_group
 
 #ifdef _MSC_VER
 #pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
@@ -128,6 +129,48 @@ bool vtkSMPToolsImpl<BackendType::TBB>::GetSingleThread()
   return threadIdStack->top() == tbb::this_task_arena::current_thread_index();
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+class vtkSMPTaskGroupTBB : public vtkSMPTaskGroupImpl
+{
+public:
+  void Spawn(std::function<void()> task) override
+  {
+    if (taskArena->is_active())
+    {
+      taskArena->execute([&] { this->Group.run(std::move(task)); });
+    }
+    else
+    {
+      this->Group.run(std::move(task));
+    }
+  }
+
+  void Wait() override
+  {
+    if (taskArena->is_active())
+    {
+      taskArena->execute([this] { this->Group.wait(); });
+    }
+    else
+    {
+      this->Group.wait();
+    }
+  }
+
+private:
+  tbb::task_group Group;
+};
+}
+
+//------------------------------------------------------------------------------
+template <>
+std::unique_ptr<vtkSMPTaskGroupImpl> vtkSMPToolsImpl<BackendType::TBB>::NewTaskGroup()
+{
+  return std::unique_ptr<vtkSMPTaskGroupImpl>(new vtkSMPTaskGroupTBB);
+}
+
 //------------------------------------------------------------------------------
 void vtkSMPToolsImplForTBB(vtkIdType first, vtkIdType last, vtkIdType grain,
   ExecuteFunctorPtrType functorExecuter, void* functor)
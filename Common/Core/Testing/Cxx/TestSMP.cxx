@@ -7,6 +7,7 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <functional>
@@ -128,6 +129,23 @@ public:
   }
 };
 
+// Counts the nodes of a binary tree of the given depth, spawning a task per
+// child in a new group
+static int TaskGroupCount(int depth)
+{
+  if (depth == 0)
+  {
+    return 1;
+  }
+  int left = 0;
+  int right = 0;
+  vtkSMPTools::TaskGroup group;
+  group.Spawn([&left, depth]() { left = TaskGroupCount(depth - 1); });
+  group.Spawn([&right, depth]() { right = TaskGroupCount(depth - 1); });
+  group.Wait();
+  return left + right + 1;
+}
+
 class MyVTKClass : public vtkObject
 {
   int Value;
@@ -286,6 +304,54 @@ int doTestSMP()
     }
   }
 
+  // Test TaskGroup
+  if (TaskGroupCount(10) != 2047)
+  {
+    cerr << "Error: on vtkSMPTools::TaskGroup with nested groups" << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::atomic<int> spawned(0);
+  {
+    // Tasks spawned by the tasks of the group are waited for too
+    vtkSMPTools::TaskGroup group;
+    std::function<void(int)> spawn = [&](int depth) {
+      ++spawned;
+      for (int i = 0; depth > 0 && i < 2; ++i)
+      {
+        group.Spawn([&spawn, depth]() { spawn(depth - 1); });
+      }
+    };
+    group.Spawn([&spawn]() { spawn(10); });
+    group.Wait();
+  }
+  if (spawned != 2047)
+  {
+    cerr << "Error: on vtkSMPTools::TaskGroup got " << spawned << " tasks instead of 2047" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSMPThreadLocal<int> taskCounter(0);
+  {
+    // Loops in tasks, the group waits in its destructor
+    vtkSMPTools::TaskGroup group;
+    for (int i = 0; i < 10; ++i)
+    {
+      group.Spawn([&taskCounter]() {
+        vtkSMPTools::For(0, Target, [&taskCounter](vtkIdType begin, vtkIdType end) {
+          taskCounter.Local() += static_cast<int>(end - begin);
+        });
+      });
+    }
+  }
+  total = std::accumulate(taskCounter.begin(), taskCounter.end(), 0);
+  if (total != 10 * Target)
+  {
+    cerr << "Error: on vtkSMPTools::For in vtkSMPTools::TaskGroup got " << total << " instead of "
+         << 10 * Target << endl;
+    return EXIT_FAILURE;
+  }
+
   /* This Test is faulty, see: https://gitlab.kitware.com/vtk/vtk/-/issues/19338
   // Test GetSingleThread
   if (std::string(vtkSMPTools::GetBackend()) != "Sequential")
@@ -68,4 +68,42 @@ bool vtkSMPTools::GetSingleThread()
   auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
   return SMPToolsAPI.GetSingleThread();
 }
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetTaskObserver(TaskObserver* observer)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetTaskObserver(observer);
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskObserver* vtkSMPTools::GetTaskObserver()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetTaskObserver();
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::TaskGroup()
+  : Impl(vtk::detail::smp::vtkSMPToolsAPI::GetInstance().NewTaskGroup())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::~TaskGroup()
+{
+  this->Wait();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Spawn(std::function<void()> task)
+{
+  this->Impl->Spawn(std::move(task));
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Wait()
+{
+  this->Impl->Wait();
+}
 VTK_ABI_NAMESPACE_END
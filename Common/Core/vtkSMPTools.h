@@ -25,6 +25,7 @@
 #include "vtkSMPThreadLocal.h" // For Initialized
 
 #include <functional>  // For std::function
+#include <memory>      // For std::unique_ptr
 #include <type_traits> // For std:::enable_if
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -82,7 +83,11 @@ struct vtkSMPTools_FunctorInternal<Functor, false>
     : F(f)
   {
   }
-  void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    vtkSMPTaskScope scope(first, last);
+    this->F(first, last);
+  }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
     auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
@@ -105,6 +110,7 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   }
   void Execute(vtkIdType first, vtkIdType last)
   {
+    vtkSMPTaskScope scope(first, last);
     unsigned char& inited = this->Initialized.Local();
     if (!inited)
     {
@@ -424,7 +430,8 @@ public:
    * When enabled the comportement is different for each backend:
    *    - TBB support nested parallelism using a single thread pool
    *    - For OpenMP, set `omp_set_nested` to the value of `isNested`.
-   *    - For STDThread nested parallelism implies creating new threads pools.
+   *    - For STDThread nested loops are executed by the threads of the pool
+   *      that are idle or waiting for the outer loop.
    *    - For Sequential nothing changes.
    *
    * Default to false except for TBB.
@@ -448,6 +455,23 @@ public:
    */
   static bool GetSingleThread();
 
+  /**
+   * Observer notified of the execution of each range of the loops of For(),
+   * from the thread executing it, such as the profiler of the pipeline
+   * executions. Its TaskBegin() and TaskEnd() methods must be thread safe.
+   */
+  using TaskObserver = vtk::detail::smp::vtkSMPTaskObserver;
+
+  ///@{
+  /**
+   * /!\ This method is not thread safe.
+   * Set the observer of the tasks, nullptr by default. The observer is not
+   * reference counted and must outlive its use.
+   */
+  static void SetTaskObserver(TaskObserver* observer);
+  static TaskObserver* GetTaskObserver();
+  ///@}
+
   /**
    * Structure used to specify configuration for LocalScope() method.
    * Several parameters can be configured:
@@ -623,6 +647,60 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  /**
+   * A group of tasks executed concurrently, for the parallel algorithms that
+   * do not fit in a For loop, such as recursive ones. Spawn() submits a task
+   * to the backend and Wait() blocks until all the tasks of the group are
+   * done. A task may spawn tasks in its own group, or in a new group that it
+   * waits for, so that the work is split as the recursion goes deeper.
+   *
+   * Usage example:
+   * \code
+   * void Sort(Node* node)
+   * {
+   *   vtkSMPTools::TaskGroup group;
+   *   group.Spawn([node]() { Sort(node->Left); });
+   *   group.Spawn([node]() { Sort(node->Right); });
+   *   group.Wait();
+   * }
+   * \endcode
+   *
+   * The backend is the one active when the group is created:
+   *    - TBB executes the tasks in a tbb::task_group.
+   *    - STDThread executes the tasks in its work stealing thread pool. A
+   *      thread waiting for a group executes the tasks of this group while
+   *      waiting.
+   *    - Sequential and OpenMP execute each task when it is spawned.
+   *
+   * Tasks are executed concurrently whatever the nested parallelism. Wait()
+   * must be called by the thread that created the group, and is called by
+   * the destructor. For STDThread, the exceptions thrown by the tasks are
+   * reported and ignored.
+   */
+  class VTKCOMMONCORE_EXPORT TaskGroup
+  {
+  public:
+    TaskGroup();
+    ~TaskGroup();
+
+    /**
+     * Submit a task to the group.
+     */
+    void Spawn(std::function<void()> task);
+
+    /**
+     * Block until all the tasks of the group, including those spawned by
+     * its tasks, are done.
+     */
+    void Wait();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+  private:
+    std::unique_ptr<vtk::detail::smp::vtkSMPTaskGroupImpl> Impl;
+  };
 };
 
 VTK_ABI_NAMESPACE_END
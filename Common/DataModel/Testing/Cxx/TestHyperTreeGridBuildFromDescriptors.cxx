@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkHyperTreeGrid::BuildTreesFromBreadthFirstOrderDescriptors
+// rebuilds the trees described by vtkHyperTree::ComputeBreadthFirstOrderDescriptor,
+// and rejects duplicate or out of range tree indices.
+
+#include "vtkBitArray.h"
+#include "vtkCommand.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridNonOrientedCursor.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTypeInt64Array.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+// Subdivide some of the leaves and mask some of the others, depending on a
+// hash of their position in the grid
+void BuildTree(vtkHyperTreeGridNonOrientedCursor* cursor, vtkBitArray* mask, unsigned int key)
+{
+  const unsigned int hash = (key * 2654435761u) >> 7;
+  if (cursor->GetLevel() < 4 && hash % 5 < 2)
+  {
+    mask->InsertValue(cursor->GetGlobalNodeIndex(), 0);
+    cursor->SubdivideLeaf();
+    for (int child = 0; child < cursor->GetNumberOfChildren(); ++child)
+    {
+      cursor->ToChild(child);
+      BuildTree(cursor, mask, 16 * key + child + 1);
+      cursor->ToParent();
+    }
+  }
+  else
+  {
+    mask->InsertValue(cursor->GetGlobalNodeIndex(), hash % 7 == 0);
+  }
+}
+
+bool SameTree(vtkHyperTreeGridNonOrientedCursor* reference, vtkBitArray* referenceMask,
+  vtkHyperTreeGridNonOrientedCursor* built, vtkBitArray* builtMask,
+  const std::unordered_map<vtkIdType, vtkIdType>& breadthFirstIds)
+{
+  const vtkIdType referenceId = reference->GetGlobalNodeIndex();
+  const vtkIdType builtId = built->GetGlobalNodeIndex();
+  if (reference->IsLeaf() != built->IsLeaf() || breadthFirstIds.at(referenceId) != builtId ||
+    referenceMask->GetValue(referenceId) != builtMask->GetValue(builtId))
+  {
+    std::cerr << "Vertex " << referenceId << " was not rebuilt as vertex " << builtId << std::endl;
+    return false;
+  }
+  if (!reference->IsLeaf())
+  {
+    for (int child = 0; child < reference->GetNumberOfChildren(); ++child)
+    {
+      reference->ToChild(child);
+      built->ToChild(child);
+      const bool same = SameTree(reference, referenceMask, built, builtMask, breadthFirstIds);
+      reference->ToParent();
+      built->ToParent();
+      if (!same)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Build trees with invalid indices, which must fail without building any tree
+bool RejectsTreeIds(const unsigned int dimensions[3], vtkIdTypeArray* treeIds,
+  vtkBitArray* descriptors, vtkIdTypeArray* startIndices, vtkIdTypeArray* numberOfBits,
+  const std::string& expectedError)
+{
+  vtkNew<vtkHyperTreeGrid> grid;
+  grid->SetDimensions(dimensions);
+  grid->SetBranchFactor(2);
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  grid->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  if (grid->BuildTreesFromBreadthFirstOrderDescriptors(
+        treeIds, descriptors, startIndices, numberOfBits) != -1 ||
+    errorObserver->CheckErrorMessage(expectedError) != 0 || grid->GetNumberOfCells() != 0)
+  {
+    std::cerr << "Invalid tree indices were not rejected" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestHyperTreeGridBuildFromDescriptors(int, char*[])
+{
+  const unsigned int dimensions[3] = { 6, 5, 4 };
+
+  vtkNew<vtkHyperTreeGrid> reference;
+  reference->SetDimensions(dimensions);
+  reference->SetBranchFactor(2);
+  vtkNew<vtkBitArray> referenceMask;
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
+  const vtkIdType numberOfTrees = reference->GetMaxNumberOfTrees();
+  for (vtkIdType treeId = 0; treeId < numberOfTrees; ++treeId)
+  {
+    reference->InitializeNonOrientedCursor(cursor, treeId, true);
+    cursor->SetGlobalIndexStart(reference->GetNumberOfCells());
+    BuildTree(cursor, referenceMask, static_cast<unsigned int>(treeId) + 1);
+  }
+  reference->SetMask(referenceMask);
+
+  // Describe the trees by decreasing indices, so that the global indices of
+  // the rebuilt grid follow another order than the reference one
+  vtkNew<vtkIdTypeArray> treeIds;
+  vtkNew<vtkIdTypeArray> startIndices;
+  vtkNew<vtkIdTypeArray> numberOfBits;
+  vtkNew<vtkBitArray> descriptors;
+  vtkNew<vtkTypeInt64Array> numberOfVerticesPerDepth;
+  vtkNew<vtkIdList> breadthFirstIdMap;
+  for (vtkIdType treeId = numberOfTrees - 1; treeId >= 0; --treeId)
+  {
+    const vtkIdType start = descriptors->GetNumberOfValues();
+    reference->GetTree(treeId)->ComputeBreadthFirstOrderDescriptor(
+      std::numeric_limits<unsigned int>::max(), nullptr, numberOfVerticesPerDepth, descriptors,
+      breadthFirstIdMap);
+    treeIds->InsertNextValue(treeId);
+    startIndices->InsertNextValue(start);
+    numberOfBits->InsertNextValue(descriptors->GetNumberOfValues() - start);
+  }
+  std::unordered_map<vtkIdType, vtkIdType> breadthFirstIds;
+  vtkNew<vtkBitArray> mask;
+  for (vtkIdType id = 0; id < breadthFirstIdMap->GetNumberOfIds(); ++id)
+  {
+    breadthFirstIds[breadthFirstIdMap->GetId(id)] = id;
+    mask->InsertNextValue(referenceMask->GetValue(breadthFirstIdMap->GetId(id)));
+  }
+
+  vtkNew<vtkHyperTreeGrid> built;
+  built->SetDimensions(dimensions);
+  built->SetBranchFactor(2);
+  const vtkIdType numberOfVertices = built->BuildTreesFromBreadthFirstOrderDescriptors(
+    treeIds, descriptors, startIndices, numberOfBits, mask);
+  if (numberOfVertices != reference->GetNumberOfCells() ||
+    built->GetNumberOfCells() != reference->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of vertices: " << numberOfVertices << " instead of "
+              << reference->GetNumberOfCells() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> builtCursor;
+  for (vtkIdType treeId = 0; treeId < numberOfTrees; ++treeId)
+  {
+    reference->InitializeNonOrientedCursor(cursor, treeId);
+    built->InitializeNonOrientedCursor(builtCursor, treeId);
+    if (!builtCursor->HasTree() ||
+      reference->GetTree(treeId)->GetNumberOfLevels() !=
+        built->GetTree(treeId)->GetNumberOfLevels() ||
+      !SameTree(cursor, referenceMask, builtCursor, built->GetMask(), breadthFirstIds))
+    {
+      std::cerr << "Tree " << treeId << " was not rebuilt" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  treeIds->SetValue(1, treeIds->GetValue(0));
+  if (!RejectsTreeIds(dimensions, treeIds, descriptors, startIndices, numberOfBits,
+        "is described more than once"))
+  {
+    return EXIT_FAILURE;
+  }
+  treeIds->SetValue(1, numberOfTrees);
+  if (!RejectsTreeIds(
+        dimensions, treeIds, descriptors, startIndices, numberOfBits, "Invalid tree index"))
+  {
+    return EXIT_FAILURE;
+  }
+  treeIds->SetValue(1, -1);
+  if (!RejectsTreeIds(
+        dimensions, treeIds, descriptors, startIndices, numberOfBits, "Invalid tree index"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
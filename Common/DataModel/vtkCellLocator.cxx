@@ -9,9 +9,14 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 //------------------------------------------------------------------------------
@@ -720,10 +725,9 @@ void vtkCellLocator::BuildLocatorInternal()
   cellBoundsPtr = cellBounds;
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
-  vtkIdType cellId, idx;
+  int i, j, k;
+  vtkIdType idx;
   int parentOffset;
-  vtkSmartPointer<vtkIdList> octant;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
   int prod, numOctants;
   double hTol[3];
@@ -788,53 +792,122 @@ void vtkCellLocator::BuildLocatorInternal()
   }
 
   //  Insert each cell into the appropriate octant.  Make sure cell
-  //  falls within octant.
+  //  falls within octant. The cells are counted and inserted concurrently,
+  //  and the cells of each octant are then sorted, so the octants are the
+  //  same as when the cells are inserted one after the other.
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  auto parentOctant = vtkSmartPointer<vtkIdList>::New(); // This is just a place-holder for parents
-  for (cellId = 0; cellId < numCells; cellId++)
-  {
-    this->GetCellBounds(cellId, cellBoundsPtr);
+  const vtkIdType numLeaves = static_cast<vtkIdType>(product) * ndivs;
+  std::vector<int> cellIJK(6 * numCells);
+  std::unique_ptr<std::atomic<vtkIdType>[]> leafCounts(new std::atomic<vtkIdType>[numLeaves]);
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType leaf = begin; leaf < end; ++leaf)
+    {
+      leafCounts[leaf] = 0;
+    }
+  });
+
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCellBounds().
+  this->GetCellBounds(0, cellBoundsPtr);
 
-    // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    double box[6], *bds;
+    for (vtkIdType id = begin; id < end; id++)
     {
-      ijkMin[i] =
-        static_cast<int>((cellBoundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((cellBoundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
+      bds = box;
+      this->GetCellBounds(id, bds);
 
-      if (ijkMin[i] < 0)
+      // find min/max locations of bounding box
+      int* ijk = cellIJK.data() + 6 * id;
+      for (int ii = 0; ii < 3; ii++)
       {
-        ijkMin[i] = 0;
+        ijk[ii] = static_cast<int>((bds[2 * ii] - this->Bounds[2 * ii] - hTol[ii]) / this->H[ii]);
+        ijk[3 + ii] =
+          static_cast<int>((bds[2 * ii + 1] - this->Bounds[2 * ii] + hTol[ii]) / this->H[ii]);
+
+        if (ijk[ii] < 0)
+        {
+          ijk[ii] = 0;
+        }
+        if (ijk[3 + ii] >= ndivs)
+        {
+          ijk[3 + ii] = ndivs - 1;
+        }
       }
-      if (ijkMax[i] >= ndivs)
+
+      // each octant between min/max point may have cell in it
+      for (int kk = ijk[2]; kk <= ijk[5]; kk++)
       {
-        ijkMax[i] = ndivs - 1;
+        for (int jj = ijk[1]; jj <= ijk[4]; jj++)
+        {
+          for (int ii = ijk[0]; ii <= ijk[3]; ii++)
+          {
+            leafCounts[ii + jj * ndivs + kk * product]++;
+          }
+        }
       }
     }
+  });
 
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
+  // Turn the counts into offsets, and the leaf counts into insertion cursors
+  std::vector<vtkIdType> leafOffsets(numLeaves + 1);
+  leafOffsets[0] = 0;
+  for (vtkIdType leaf = 0; leaf < numLeaves; ++leaf)
+  {
+    leafOffsets[leaf + 1] = leafOffsets[leaf] + leafCounts[leaf];
+    leafCounts[leaf] = leafOffsets[leaf];
+  }
+
+  std::vector<vtkIdType> leafCells(leafOffsets[numLeaves]);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; id++)
     {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
+      const int* ijk = cellIJK.data() + 6 * id;
+      for (int kk = ijk[2]; kk <= ijk[5]; kk++)
       {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        for (int jj = ijk[1]; jj <= ijk[4]; jj++)
         {
-          idx = parentOffset + i + j * ndivs + k * product;
-          this->MarkParents(parentOctant, i, j, k, ndivs, this->Level);
-          octant = this->Tree[idx];
-          if (!octant)
+          for (int ii = ijk[0]; ii <= ijk[3]; ii++)
           {
-            octant = vtkSmartPointer<vtkIdList>::New();
-            octant->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
-            this->Tree[idx] = octant;
+            leafCells[leafCounts[ii + jj * ndivs + kk * product]++] = id;
           }
-          octant->InsertNextId(cellId);
         }
       }
     }
-  } // for all cells
+  });
+
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType leaf = begin; leaf < end; ++leaf)
+    {
+      const vtkIdType numLeafCells = leafOffsets[leaf + 1] - leafOffsets[leaf];
+      if (numLeafCells > 0)
+      {
+        vtkIdType* cells = leafCells.data() + leafOffsets[leaf];
+        std::sort(cells, cells + numLeafCells);
+        auto leafOctant = vtkSmartPointer<vtkIdList>::New();
+        leafOctant->SetNumberOfIds(numLeafCells);
+        std::copy(cells, cells + numLeafCells, leafOctant->GetPointer(0));
+        this->Tree[parentOffset + leaf] = leafOctant;
+      }
+    }
+  });
+
+  auto parentOctant = vtkSmartPointer<vtkIdList>::New(); // This is just a place-holder for parents
+  for (k = 0; k < ndivs; k++)
+  {
+    for (j = 0; j < ndivs; j++)
+    {
+      for (i = 0; i < ndivs; i++)
+      {
+        idx = parentOffset + i + j * ndivs + k * product;
+        if (this->Tree[idx])
+        {
+          this->MarkParents(parentOctant, i, j, k, ndivs, this->Level);
+        }
+      }
+    }
+  }
 
   this->BuildTime.Modified();
 }
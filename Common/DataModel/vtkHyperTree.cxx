@@ -195,12 +195,16 @@ public:
     }
     else
     {
+      this->CompactDatas->ParentToElderChild_stl.reserve(numberOfBits);
+      // The bits are read in place, so that several trees can be built
+      // concurrently from the same descriptor
+      const unsigned char* bits = descriptor->GetPointer(0);
       vtkIdType currentDepthSize = 1;
       vtkIdType nextDepthSize = 0;
       vtkIdType currentPositionAtDepth = 0;
       for (vtkIdType id = startIndex; id < startIndex + numberOfBits; ++id)
       {
-        if (descriptor->GetValue(id))
+        if (bits[id / 8] & (0x80 >> (id % 8)))
         {
           this->CompactDatas->ParentToElderChild_stl.emplace_back(numberOfVertices);
           numberOfVertices += this->NumberOfChildren;
@@ -222,6 +222,10 @@ public:
    * descriptor, as we know that they are full of zeros (because leaves have no children).
    *
    * @param startIndex: Input descriptor is being read starting at this index.
+   *
+   * The descriptor is only read, so several trees can be built concurrently
+   * from the same descriptor, see
+   * vtkHyperTreeGrid::BuildTreesFromBreadthFirstOrderDescriptors.
    */
   virtual void BuildFromBreadthFirstOrderDescriptor(
     vtkBitArray* descriptor, vtkIdType numberOfBits, vtkIdType startIndex = 0) = 0;
@@ -31,13 +31,16 @@
 #include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredData.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <deque>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkInformationKeyMacro(vtkHyperTreeGrid, LEVELS, Integer);
@@ -1118,6 +1121,112 @@ void vtkHyperTreeGrid::SetTree(vtkIdType index, vtkHyperTree* tree)
   this->HyperTrees[index] = tree;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkHyperTreeGrid::BuildTreesFromBreadthFirstOrderDescriptors(vtkIdTypeArray* treeIds,
+  vtkBitArray* descriptors, vtkIdTypeArray* startIndices, vtkIdTypeArray* numberOfBits,
+  vtkBitArray* mask, vtkIdType globalIndexStart)
+{
+  if (!treeIds || !descriptors || !startIndices || !numberOfBits)
+  {
+    vtkErrorMacro(<< "Missing tree indices or descriptors.");
+    return -1;
+  }
+  const vtkIdType numberOfTrees = treeIds->GetNumberOfValues();
+  if (startIndices->GetNumberOfValues() != numberOfTrees ||
+    numberOfBits->GetNumberOfValues() != numberOfTrees)
+  {
+    vtkErrorMacro(<< "Expected one descriptor start index and size per tree.");
+    return -1;
+  }
+  const vtkIdType maxNumberOfTrees = this->GetMaxNumberOfTrees();
+  const vtkIdType numberOfDescriptorBits = descriptors->GetNumberOfValues();
+  for (vtkIdType i = 0; i < numberOfTrees; ++i)
+  {
+    const vtkIdType index = treeIds->GetValue(i);
+    const vtkIdType start = startIndices->GetValue(i);
+    const vtkIdType numBits = numberOfBits->GetValue(i);
+    if (index < 0 || index >= maxNumberOfTrees)
+    {
+      vtkErrorMacro(<< "Invalid tree index " << index << ", expected an index between 0 and "
+                    << maxNumberOfTrees - 1 << ".");
+      return -1;
+    }
+    if (start < 0 || numBits < 0 || start + numBits > numberOfDescriptorBits)
+    {
+      vtkErrorMacro(<< "Invalid descriptor range for tree " << index << ".");
+      return -1;
+    }
+  }
+
+  // Two descriptors of the same tree would be built concurrently into it
+  std::vector<vtkIdType> sortedTreeIds(treeIds->GetPointer(0), treeIds->GetPointer(numberOfTrees));
+  std::sort(sortedTreeIds.begin(), sortedTreeIds.end());
+  auto duplicate = std::adjacent_find(sortedTreeIds.begin(), sortedTreeIds.end());
+  if (duplicate != sortedTreeIds.end())
+  {
+    vtkErrorMacro(<< "Tree " << *duplicate << " is described more than once.");
+    return -1;
+  }
+
+  // The tree map cannot be filled concurrently, the trees are only created here
+  std::vector<vtkSmartPointer<vtkHyperTree>> trees(numberOfTrees);
+  for (vtkIdType i = 0; i < numberOfTrees; ++i)
+  {
+    trees[i] = vtkSmartPointer<vtkHyperTree>::Take(
+      vtkHyperTree::CreateInstance(this->BranchFactor, this->Dimension));
+    this->SetTree(treeIds->GetValue(i), trees[i]);
+  }
+
+  // Each tree only reads its own range of the descriptors
+  vtkSMPTools::For(0, numberOfTrees, [&](vtkIdType begin, vtkIdType end) {
+    double origin[3];
+    double size[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkHyperTree* tree = trees[i];
+      this->GetLevelZeroOriginAndSizeFromIndex(tree->GetTreeIndex(), origin, size);
+      tree->SetScales(std::make_shared<vtkHyperTreeGridScales>(this->BranchFactor, size));
+      tree->BuildFromBreadthFirstOrderDescriptor(
+        descriptors, numberOfBits->GetValue(i), startIndices->GetValue(i));
+    }
+  });
+
+  // Implicit global indices follow the order of the trees
+  vtkIdType numberOfVertices = 0;
+  for (vtkIdType i = 0; i < numberOfTrees; ++i)
+  {
+    trees[i]->SetGlobalIndexStart(globalIndexStart + numberOfVertices);
+    numberOfVertices += trees[i]->GetNumberOfVertices();
+  }
+
+  if (mask)
+  {
+    vtkSmartPointer<vtkBitArray> gridMask = this->Mask;
+    if (!gridMask)
+    {
+      gridMask = vtkSmartPointer<vtkBitArray>::New();
+    }
+    const vtkIdType previousSize = gridMask->GetNumberOfValues();
+    if (previousSize < globalIndexStart + numberOfVertices)
+    {
+      gridMask->SetNumberOfValues(globalIndexStart + numberOfVertices);
+      for (vtkIdType id = previousSize; id < globalIndexStart; ++id)
+      {
+        gridMask->SetValue(id, 0);
+      }
+    }
+    const vtkIdType numberOfMaskValues = std::min(mask->GetNumberOfValues(), numberOfVertices);
+    for (vtkIdType id = 0; id < numberOfVertices; ++id)
+    {
+      gridMask->SetValue(globalIndexStart + id, id < numberOfMaskValues ? mask->GetValue(id) : 0);
+    }
+    this->SetMask(gridMask);
+  }
+
+  this->Modified();
+  return numberOfVertices;
+}
+
 //------------------------------------------------------------------------------
 void vtkHyperTreeGrid::ShallowCopy(vtkDataObject* src)
 {
@@ -1548,9 +1657,9 @@ void vtkHyperTreeGrid::GetLevelZeroOriginAndSizeFromIndex(
   vtkDataArray* xCoords = this->XCoordinates;
   vtkDataArray* yCoords = this->YCoordinates;
   vtkDataArray* zCoords = this->ZCoordinates;
-  Origin[0] = xCoords->GetTuple1(i);
-  Origin[1] = yCoords->GetTuple1(j);
-  Origin[2] = zCoords->GetTuple1(k);
+  Origin[0] = xCoords->GetComponent(i, 0);
+  Origin[1] = yCoords->GetComponent(j, 0);
+  Origin[2] = zCoords->GetComponent(k, 0);
 
   if (this->Dimensions[0] == 1)
   {
@@ -1558,7 +1667,7 @@ void vtkHyperTreeGrid::GetLevelZeroOriginAndSizeFromIndex(
   }
   else
   {
-    Size[0] = xCoords->GetTuple1(i + 1) - Origin[0];
+    Size[0] = xCoords->GetComponent(i + 1, 0) - Origin[0];
   }
   if (this->Dimensions[1] == 1)
   {
@@ -1566,7 +1675,7 @@ void vtkHyperTreeGrid::GetLevelZeroOriginAndSizeFromIndex(
   }
   else
   {
-    Size[1] = yCoords->GetTuple1(j + 1) - Origin[1];
+    Size[1] = yCoords->GetComponent(j + 1, 0) - Origin[1];
   }
   if (this->Dimensions[2] == 1)
   {
@@ -1574,7 +1683,7 @@ void vtkHyperTreeGrid::GetLevelZeroOriginAndSizeFromIndex(
   }
   else
   {
-    Size[2] = zCoords->GetTuple1(k + 1) - Origin[2];
+    Size[2] = zCoords->GetComponent(k + 1, 0) - Origin[2];
   }
 }
 
@@ -1590,9 +1699,9 @@ void vtkHyperTreeGrid::GetLevelZeroOriginFromIndex(vtkIdType treeindex, double*
   vtkDataArray* xCoords = this->XCoordinates;
   vtkDataArray* yCoords = this->YCoordinates;
   vtkDataArray* zCoords = this->ZCoordinates;
-  Origin[0] = xCoords->GetTuple1(i);
-  Origin[1] = yCoords->GetTuple1(j);
-  Origin[2] = zCoords->GetTuple1(k);
+  Origin[0] = xCoords->GetComponent(i, 0);
+  Origin[1] = yCoords->GetComponent(j, 0);
+  Origin[2] = zCoords->GetComponent(k, 0);
 }
 
 //------------------------------------------------------------------------------
@@ -477,6 +477,31 @@ public:
    */
   void SetTree(vtkIdType, vtkHyperTree*);
 
+  /**
+   * Build the hyper trees at the given indices from breadth first order
+   * descriptors, as computed by vtkHyperTree::ComputeBreadthFirstOrderDescriptor
+   * and stored by vtkXMLHyperTreeGridWriter. The descriptor of the tree
+   * `treeIds[i]` is made of the `numberOfBits[i]` bits of `descriptors`
+   * starting at `startIndices[i]`.
+   *
+   * Existing trees at these indices are replaced. The trees are built in
+   * parallel with vtkSMPTools. Their vertices are given implicit global
+   * indices in breadth first order, starting at `globalIndexStart`, the trees
+   * following each other in the order of `treeIds`. The cell data of the
+   * built vertices is expected in that same order.
+   *
+   * If `mask` is given, it holds the mask values of the built vertices in that
+   * order, which are copied to the mask of this grid. As in
+   * vtkHyperTree::InitializeForReader, missing values are false.
+   *
+   * Return the number of vertices of the built trees, or -1 if the arguments
+   * are not consistent, for instance if a tree index is out of range or given
+   * more than once. No tree is built in that case.
+   */
+  vtkIdType BuildTreesFromBreadthFirstOrderDescriptors(vtkIdTypeArray* treeIds,
+    vtkBitArray* descriptors, vtkIdTypeArray* startIndices, vtkIdTypeArray* numberOfBits,
+    vtkBitArray* mask = nullptr, vtkIdType globalIndexStart = 0);
+
   /**
    * Create shallow copy of hyper tree grid.
    */
@@ -12,17 +12,22 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -32,6 +37,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -637,25 +643,11 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     }
   }
 
-  double* weights = new double[maxCellSize];
-
   float* cptr = center;
-  double dcenter[3];
 
   if (set)
   {
-    for (int j = 0; j < totalCells; j++)
-    {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
-    }
+    this->ComputeCellCenters(set, maxCellSize, cptr);
   }
   else
   {
@@ -664,29 +656,53 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
-      int nCells = iset->GetNumberOfCells();
-
-      for (int j = 0; j < nCells; j++)
-      {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
-        {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-        }
-      }
+      this->ComputeCellCenters(iset, maxCellSize, cptr);
+      cptr += 3 * iset->GetNumberOfCells();
     }
   }
 
-  delete[] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTree::ComputeCellCenters(vtkDataSet* set, int maxCellSize, float* center)
+{
+  int nCells = set->GetNumberOfCells();
+  if (nCells == 0)
+  {
+    return;
+  }
+
+  // Build the cells of the data set, if needed, before they are
+  // accessed concurrently.
+  vtkNew<vtkGenericCell> cell;
+  set->GetCell(0, cell);
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  vtkSMPTools::For(0, nCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* genericCell = localCell.Local();
+    std::vector<double>& weights = localWeights.Local();
+    weights.resize(maxCellSize);
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    double dcenter[3];
+    for (vtkIdType j = begin; j < end; j++)
+    {
+      set->GetCell(j, genericCell);
+      this->ComputeCellCenter(genericCell, dcenter, weights.data());
+      float* cptr = center + 3 * j;
+      cptr[0] = static_cast<float>(dcenter[0]);
+      cptr[1] = static_cast<float>(dcenter[1]);
+      cptr[2] = static_cast<float>(dcenter[2]);
+      if (isFirst && j % 1000 == 0)
+      {
+        this->UpdateSubOperationProgress(static_cast<double>(j) / nCells);
+      }
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 void vtkKdTree::ComputeCellCenter(vtkDataSet* set, int cellId, float* center)
 {
@@ -912,7 +928,7 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegionInParallel(kd, ptarray, nullptr);
 
     TIMERDONE("Build tree");
 
@@ -1256,6 +1272,26 @@ int vtkKdTree::DivideTest(int size, int level)
 
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->DivideNode(kd, c1, ids, level))
+  {
+    return 0; // unable to divide region further
+  }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int* leftIds = ids;
+  int* rightIds = ids ? ids + nleft : nullptr;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkKdTree::DivideNode(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1310,21 +1346,68 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 
   this->DoMedianFind(kd, c1, ids, dim1, dim2, dim3);
 
-  if (kd->GetLeft() == nullptr)
-  {
-    return 0; // unable to divide region further
-  }
+  return kd->GetLeft() != nullptr;
+}
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
+//------------------------------------------------------------------------------
+namespace
+{
+// A region left to divide, with its points
+struct vtkKdTreeRegionTask
+{
+  vtkKdNode* Node;
+  float* Centers;
+  int* Ids;
+  int Level;
+};
+}
 
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
+//------------------------------------------------------------------------------
+// The regions are divided level by level, the regions of a level being
+// divided concurrently, until there are enough regions to keep all the
+// threads busy. Their subtrees are then divided concurrently. Regions do not
+// share points, and each region is divided as by DivideRegion.
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids)
+{
+  const size_t minNumberOfTasks = 4 * vtkSMPTools::GetEstimatedNumberOfThreads();
+  std::vector<vtkKdTreeRegionTask> tasks(1, vtkKdTreeRegionTask{ kd, c1, ids, 0 });
 
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+  while (!tasks.empty() && tasks.size() < minNumberOfTasks)
+  {
+    std::vector<unsigned char> divided(tasks.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          const vtkKdTreeRegionTask& task = tasks[i];
+          divided[i] = static_cast<unsigned char>(
+            this->DivideNode(task.Node, task.Centers, task.Ids, task.Level));
+        }
+      });
 
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+    std::vector<vtkKdTreeRegionTask> children;
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      if (divided[i])
+      {
+        const vtkKdTreeRegionTask& task = tasks[i];
+        int nleft = task.Node->GetLeft()->GetNumberOfPoints();
+        children.push_back(
+          vtkKdTreeRegionTask{ task.Node->GetLeft(), task.Centers, task.Ids, task.Level + 1 });
+        children.push_back(vtkKdTreeRegionTask{ task.Node->GetRight(), task.Centers + nleft * 3,
+          task.Ids ? task.Ids + nleft : nullptr, task.Level + 1 });
+      }
+    }
+    tasks.swap(children);
+  }
 
-  return 0;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkKdTreeRegionTask& task = tasks[i];
+      this->DivideRegion(task.Node, task.Centers, task.Ids, task.Level);
+    }
+  });
 }
 
 //------------------------------------------------------------------------------
@@ -1873,7 +1956,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -768,6 +768,20 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  /**
+   * Divide the region kd once, if DivideTest allows it. Return 1 if kd was
+   * given two children, 0 otherwise. Regions that do not overlap may be
+   * divided concurrently.
+   */
+  int DivideNode(vtkKdNode* kd, float* c1, int* ids, int level);
+
+  /**
+   * Divide the region kd of level 0 and its descendants, as DivideRegion
+   * does, the regions of a level and then the subtrees being divided
+   * concurrently. The tree does not depend on the number of threads.
+   */
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
@@ -787,6 +801,9 @@ protected:
 
   void ComputeCellCenter(vtkCell* cell, double* center, double* weights);
 
+  // Compute the centers of the cells of set concurrently, into center.
+  void ComputeCellCenters(vtkDataSet* set, int maxCellSize, float* center);
+
   void GenerateRepresentationDataBounds(int level, vtkPolyData* pd);
   void _generateRepresentationDataBounds(
     vtkKdNode* kd, vtkPoints* pts, vtkCellArray* polys, int level);
@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that the arrays requested with UPDATE_POINT_ARRAYS are propagated
+// upstream through the algorithms setting PROPAGATE_ARRAY_REQUESTS, along with
+// the arrays they process, that the other algorithms request all the arrays,
+// that the pipeline executes again when more arrays are requested, and that
+// the requests of several consumers of an output are combined.
+
+#include "vtkArrayCalculator.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationArrayRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkShrinkFilter.h"
+#include "vtkShrinkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTransform.h"
+#include "vtkTransformFilter.h"
+#include "vtkTriangleFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Generates the point arrays "a", "b" and "c", skipping those that are
+// not requested as a reader would.
+class ArraySource : public vtkPolyDataAlgorithm
+{
+public:
+  static ArraySource* New();
+  vtkTypeMacro(ArraySource, vtkPolyDataAlgorithm);
+
+  int Executions = 0;
+
+protected:
+  ArraySource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    ++this->Executions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(0., 0., 0.);
+    points->InsertNextPoint(1., 1., 1.);
+    output->SetPoints(points);
+    vtkNew<vtkCellArray> verts;
+    const vtkIdType vertex[2] = { 0, 1 };
+    verts->InsertNextCell(2, vertex);
+    output->SetVerts(verts);
+    for (const char* name : { "a", "b", "c" })
+    {
+      if (vtkStreamingDemandDrivenPipeline::IsArrayRequested(outInfo, vtkDataObject::POINT, name))
+      {
+        vtkNew<vtkDoubleArray> array;
+        array->SetName(name);
+        array->SetNumberOfTuples(2);
+        array->FillValue(1.);
+        output->GetPointData()->AddArray(array);
+      }
+    }
+    return 1;
+  }
+
+private:
+  ArraySource(const ArraySource&) = delete;
+  void operator=(const ArraySource&) = delete;
+};
+vtkStandardNewMacro(ArraySource);
+
+// Gathers the point arrays of all its inputs, forwarding the arrays requested
+// from its output to them.
+class ArrayGatherer : public vtkPolyDataAlgorithm
+{
+public:
+  static ArrayGatherer* New();
+  vtkTypeMacro(ArrayGatherer, vtkPolyDataAlgorithm);
+
+protected:
+  ArrayGatherer() = default;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override
+  {
+    this->Superclass::FillInputPortInformation(port, info);
+    info->Set(vtkAlgorithm::INPUT_IS_REPEATABLE(), 1);
+    info->Set(vtkStreamingDemandDrivenPipeline::PROPAGATE_ARRAY_REQUESTS(), 1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(vtkPolyData::GetData(inputVector[0], 0));
+    for (int i = 1; i < inputVector[0]->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkPointData* pointData = vtkPolyData::GetData(inputVector[0], i)->GetPointData();
+      for (int arrayId = 0; arrayId < pointData->GetNumberOfArrays(); ++arrayId)
+      {
+        output->GetPointData()->AddArray(pointData->GetAbstractArray(arrayId));
+      }
+    }
+    return 1;
+  }
+
+private:
+  ArrayGatherer(const ArrayGatherer&) = delete;
+  void operator=(const ArrayGatherer&) = delete;
+};
+vtkStandardNewMacro(ArrayGatherer);
+
+bool CheckArrays(
+  ArraySource* source, vtkDataSet* output, int executions, bool a, bool b, bool c, int line)
+{
+  vtkPointData* pointData = output->GetPointData();
+  if (source->Executions != executions || (pointData->HasArray("a") != 0) != a ||
+    (pointData->HasArray("b") != 0) != b || (pointData->HasArray("c") != 0) != c ||
+    !pointData->HasArray("Elevation"))
+  {
+    std::cerr << "Unexpected output or number of executions on line " << line << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestArrayRequest(int, char*[])
+{
+  using vtkSDDP = vtkStreamingDemandDrivenPipeline;
+  vtkNew<ArraySource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  vtkInformation* outInfo = elevation->GetOutputInformation(0);
+  bool success = true;
+
+  // Only the requested arrays are generated. As the other update requests,
+  // they are requested once the information is up to date.
+  elevation->UpdateInformation();
+  outInfo->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "a");
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 1, true, false, false, __LINE__);
+
+  // Requesting fewer arrays does not execute the pipeline again.
+  outInfo->Remove(vtkSDDP::UPDATE_POINT_ARRAYS());
+  outInfo->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "");
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 1, true, false, false, __LINE__);
+
+  // Requesting an array that was not generated does.
+  outInfo->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "b");
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 2, false, true, false, __LINE__);
+
+  // The arrays processed by an algorithm are requested from its input.
+  elevation->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "c");
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 3, false, true, true, __LINE__);
+  vtkInformation* inInfo = elevation->GetInputInformation(0, 0);
+  if (!vtkSDDP::UPDATE_POINT_ARRAYS()->IsArrayRequested(inInfo, "c") ||
+    vtkSDDP::UPDATE_POINT_ARRAYS()->IsArrayRequested(inInfo, "a"))
+  {
+    std::cerr << "Wrong arrays requested from the input" << std::endl;
+    success = false;
+  }
+
+  // Requesting all the arrays executes the pipeline again, once.
+  outInfo->Remove(vtkSDDP::UPDATE_POINT_ARRAYS());
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 4, true, true, true, __LINE__);
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 4, true, true, true, __LINE__);
+
+  // Requesting some of them then does not.
+  outInfo->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "a");
+  elevation->Update();
+  success &= CheckArrays(source, elevation->GetOutput(), 4, true, true, true, __LINE__);
+
+  // The filters passing the arrays of their input propagate the requests.
+  vtkNew<ArraySource> passSource;
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(passSource->GetOutputPort());
+  vtkNew<vtkShrinkPolyData> shrinkPolyData;
+  shrinkPolyData->SetInputConnection(triangles->GetOutputPort());
+  vtkNew<vtkTransform> transform;
+  transform->Translate(1., 2., 3.);
+  vtkNew<vtkTransformFilter> transformFilter;
+  transformFilter->SetTransform(transform);
+  transformFilter->SetInputConnection(shrinkPolyData->GetOutputPort());
+  vtkNew<vtkShrinkFilter> shrink;
+  shrink->SetInputConnection(transformFilter->GetOutputPort());
+  elevation->SetInputConnection(shrink->GetOutputPort());
+  elevation->UpdateInformation();
+  outInfo->Remove(vtkSDDP::UPDATE_POINT_ARRAYS());
+  outInfo->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "b");
+  elevation->Update();
+  success &= CheckArrays(passSource, elevation->GetOutput(), 1, false, true, true, __LINE__);
+
+  // An algorithm using arrays by name without declaring them, as the
+  // calculator, does not propagate the requests: its input generates all the
+  // arrays.
+  vtkNew<ArraySource> calculatorSource;
+  vtkNew<vtkArrayCalculator> calculator;
+  calculator->SetInputConnection(calculatorSource->GetOutputPort());
+  calculator->AddScalarArrayName("b");
+  calculator->SetFunction("b*2");
+  calculator->SetResultArrayName("r");
+  elevation->SetInputConnection(calculator->GetOutputPort());
+  elevation->UpdateInformation();
+  outInfo->Remove(vtkSDDP::UPDATE_POINT_ARRAYS());
+  outInfo->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "r");
+  elevation->Update();
+  vtkDataSet* output = elevation->GetOutput();
+  success &= CheckArrays(calculatorSource, output, 1, true, true, true, __LINE__);
+  vtkDataArray* result = output->GetPointData()->GetArray("r");
+  if (!result || result->GetTuple1(0) != 2.)
+  {
+    std::cerr << "Wrong calculator result" << std::endl;
+    success = false;
+  }
+  inInfo = calculator->GetInputInformation(0, 0);
+  if (inInfo->Has(vtkSDDP::UPDATE_POINT_ARRAYS()) ||
+    !vtkSDDP::UPDATE_POINT_ARRAYS()->IsArrayRequested(calculator->GetOutputInformation(0), "r"))
+  {
+    std::cerr << "Wrong arrays requested through the calculator" << std::endl;
+    success = false;
+  }
+
+  // The arrays requested by two consumers of the same output, updated
+  // together, are all generated by a single execution.
+  vtkNew<ArraySource> sharedSource;
+  vtkNew<vtkElevationFilter> elevationA;
+  elevationA->SetInputConnection(sharedSource->GetOutputPort());
+  elevationA->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "a");
+  vtkNew<vtkElevationFilter> elevationB;
+  elevationB->SetInputConnection(sharedSource->GetOutputPort());
+  elevationB->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "b");
+  vtkNew<ArrayGatherer> gatherer;
+  gatherer->AddInputConnection(elevationA->GetOutputPort());
+  gatherer->AddInputConnection(elevationB->GetOutputPort());
+  gatherer->UpdateInformation();
+  gatherer->GetOutputInformation(0)->Append(vtkSDDP::UPDATE_POINT_ARRAYS(), "");
+  gatherer->Update();
+  success &= CheckArrays(sharedSource, elevationA->GetOutput(), 1, true, true, false, __LINE__);
+  success &= CheckArrays(sharedSource, elevationB->GetOutput(), 1, true, true, false, __LINE__);
+  success &= CheckArrays(sharedSource, gatherer->GetOutput(), 1, true, true, false, __LINE__);
+  gatherer->Update();
+  success &= CheckArrays(sharedSource, gatherer->GetOutput(), 1, true, true, false, __LINE__);
+
+  // A consumer processing the active scalars, which can be any array,
+  // requests all of them.
+  elevationB->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
+  gatherer->Update();
+  success &= CheckArrays(sharedSource, gatherer->GetOutput(), 2, true, true, true, __LINE__);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkCachedCompositeDataPipeline restores the outputs of time
+// steps already generated without executing the pipeline again, and keeps
+// its cache within the memory budget.
+
+#include "vtkCachedCompositeDataPipeline.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Generates a line whose number of points depends on the time step.
+class TemporalLineSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TemporalLineSource* New();
+  vtkTypeMacro(TemporalLineSource, vtkPolyDataAlgorithm);
+
+  int Executions = 0;
+
+protected:
+  TemporalLineSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[] = { 0., 1., 2., 3. };
+    double timeRange[] = { 0., 3. };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 4);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    ++this->Executions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkIdType numberOfPoints = 1000 * (static_cast<vtkIdType>(time) + 2);
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> lines;
+    lines->InsertNextCell(numberOfPoints);
+    for (vtkIdType id = 0; id < numberOfPoints; ++id)
+    {
+      points->InsertNextPoint(id, time, 0.);
+      lines->InsertCellPoint(id);
+    }
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->SetPoints(points);
+    output->SetLines(lines);
+    return 1;
+  }
+
+private:
+  TemporalLineSource(const TemporalLineSource&) = delete;
+  void operator=(const TemporalLineSource&) = delete;
+};
+vtkStandardNewMacro(TemporalLineSource);
+
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+}
+
+int TestCachedCompositeDataPipeline(int, char*[])
+{
+  vtkNew<TemporalLineSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  vtkNew<vtkCachedCompositeDataPipeline> executive;
+  elevation->SetExecutive(executive);
+  elevation->SetInputConnection(source->GetOutputPort());
+  bool success = true;
+
+  // Going back to a time step already generated does not execute the
+  // pipeline again.
+  elevation->UpdateTimeStep(0.);
+  elevation->UpdateTimeStep(1.);
+  elevation->UpdateTimeStep(0.);
+  success &= Check(source->Executions == 2, "The cached time step was generated again");
+  success &= Check(elevation->GetOutput()->GetNumberOfPoints() == 2000 &&
+      elevation->GetOutput()->GetPoints()->GetPoint(0)[1] == 0.,
+    "The output restored from the cache is wrong");
+  success &= Check(elevation->GetOutput()->GetPointData()->GetArray("Elevation") != nullptr,
+    "The output restored from the cache has no elevation");
+  success &= Check(executive->GetNumberOfCacheEntries() == 2, "Wrong number of cache entries");
+
+  // Nothing is restored when the output is up to date.
+  elevation->UpdateTimeStep(0.);
+  success &= Check(source->Executions == 2, "The up to date time step was generated again");
+
+  // Modifying the pipeline invalidates the cache.
+  source->Modified();
+  elevation->UpdateTimeStep(1.);
+  success &= Check(source->Executions == 3, "The modified pipeline was not executed again");
+  success &= Check(executive->GetNumberOfCacheEntries() == 1, "Stale entries were not evicted");
+  elevation->UpdateTimeStep(0.);
+  success &= Check(source->Executions == 4, "A stale entry was used");
+
+  // A small budget evicts the least recently used entries.
+  vtkTypeUInt64 budget = vtkCachedCompositeDataPipeline::GetMemoryBudget();
+  vtkCachedCompositeDataPipeline::SetMemoryBudget(vtkCachedCompositeDataPipeline::GetMemoryUsage());
+  elevation->UpdateTimeStep(2.);
+  success &= Check(executive->GetNumberOfCacheEntries() == 1, "The budget was exceeded");
+  success &= Check(vtkCachedCompositeDataPipeline::GetMemoryUsage() <=
+      vtkCachedCompositeDataPipeline::GetMemoryBudget(),
+    "The memory usage exceeds the budget");
+  elevation->UpdateTimeStep(1.);
+  success &= Check(source->Executions == 6, "An evicted entry was used");
+  elevation->UpdateTimeStep(2.);
+  success &= Check(source->Executions == 7, "An evicted entry was used");
+  vtkCachedCompositeDataPipeline::SetMemoryBudget(budget);
+
+  executive->ClearCache();
+  success &= Check(executive->GetNumberOfCacheEntries() == 0 &&
+      vtkCachedCompositeDataPipeline::GetMemoryUsage() == 0,
+    "The cache was not cleared");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkExecutionProfiler records the executions of the algorithms,
+// of the blocks of composite datasets and of the tasks of vtkSMPTools, and
+// exports them as a Chrome trace.
+
+#include "vtkElevationFilter.h"
+#include "vtkExecutionProfiler.h"
+#include "vtkExecutive.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+int CountSpans(vtkExecutionProfiler* profiler, const std::string& category,
+  const std::string& name, const std::string& argument = std::string())
+{
+  int count = 0;
+  for (vtkIdType span = 0; span < profiler->GetNumberOfSpans(); ++span)
+  {
+    if (profiler->GetSpanCategory(span) == category && profiler->GetSpanName(span) == name &&
+      profiler->GetSpanArguments(span).find(argument) != std::string::npos &&
+      profiler->GetSpanDuration(span) >= 0. && profiler->GetSpanThread(span) >= 0)
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+}
+
+int TestExecutionProfiler(int, char*[])
+{
+  vtkNew<vtkExecutionProfiler> profiler;
+  vtkExecutive::SetProfiler(profiler);
+  bool success = true;
+
+  // The requests processed by each algorithm.
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->Update();
+  success &= Check(CountSpans(profiler, "RequestInformation", "vtkSphereSource") == 1 &&
+      CountSpans(profiler, "RequestData", "vtkSphereSource") == 1 &&
+      CountSpans(profiler, "RequestData", "vtkElevationFilter") == 1,
+    "The executions of the algorithms were not recorded");
+  success &= Check(CountSpans(profiler, "RequestData", "vtkElevationFilter",
+                     "\"algorithm\":\"vtkElevationFilter (") == 1,
+    "The algorithm was not recorded");
+
+  // The blocks of a composite dataset.
+  profiler->Clear();
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetBlock(0, sphere->GetOutput());
+  blocks->SetBlock(1, sphere->GetOutput());
+  vtkNew<vtkElevationFilter> blockElevation;
+  blockElevation->SetInputData(blocks);
+  blockElevation->Update();
+  success &= Check(CountSpans(profiler, "Block", "vtkElevationFilter", "\"block\":1") == 1 &&
+      CountSpans(profiler, "Block", "vtkElevationFilter", "\"block\":2") == 1 &&
+      CountSpans(profiler, "RequestData", "vtkElevationFilter") == 2,
+    "The executions of the blocks were not recorded");
+
+  // The tasks of vtkSMPTools.
+  profiler->Clear();
+  vtkSMPTools::For(0, 1000, [](vtkIdType, vtkIdType) {});
+  success &= Check(CountSpans(profiler, "SMP", "vtkSMPTools::For") > 0,
+    "The tasks of vtkSMPTools were not recorded");
+  profiler->Clear();
+  profiler->RecordSMPTasksOff();
+  vtkSMPTools::For(0, 1000, [](vtkIdType, vtkIdType) {});
+  success &= Check(profiler->GetNumberOfSpans() == 0, "The tasks of vtkSMPTools were recorded");
+
+  // The trace.
+  elevation->Modified();
+  elevation->Update();
+  std::ostringstream trace;
+  profiler->PrintChromeTrace(trace);
+  success &= Check(trace.str().rfind("{\"traceEvents\":[", 0) == 0 &&
+      trace.str().find("\"name\":\"vtkElevationFilter\",\"cat\":\"RequestData\",\"ph\":\"X\"") !=
+        std::string::npos,
+    "Wrong trace");
+  profiler->PrintSummary(std::cout);
+
+  // Nothing is recorded once the profiler is unset.
+  vtkExecutive::SetProfiler(nullptr);
+  profiler->Clear();
+  elevation->Modified();
+  elevation->Update();
+  vtkSMPTools::For(0, 1000, [](vtkIdType, vtkIdType) {});
+  success &= Check(profiler->GetNumberOfSpans() == 0, "Spans were recorded without profiler");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkTaskGraphPipeline executes each algorithm of a pipeline
+// fanning out into several branches once, and generates the same output as
+// vtkCompositeDataPipeline.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTaskGraphPipeline.h"
+#include "vtkTestSMPUtilities.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+struct Pipeline
+{
+  vtkSmartPointer<vtkSphereSource> Source;
+  vtkSmartPointer<vtkElevationFilter> Shared;
+  std::vector<vtkSmartPointer<vtkElevationFilter>> Branches;
+  vtkSmartPointer<vtkAppendPolyData> Append;
+  std::vector<vtkAlgorithm*> Algorithms;
+  std::vector<std::atomic<int>> Executions;
+
+  // One source feeding 8 branches, 2 of them through a shared filter, all
+  // appended together.
+  Pipeline()
+    : Executions(11)
+  {
+    this->Source = vtkSmartPointer<vtkSphereSource>::New();
+    this->Source->SetThetaResolution(128);
+    this->Source->SetPhiResolution(64);
+    this->Shared = vtkSmartPointer<vtkElevationFilter>::New();
+    this->Shared->SetInputConnection(this->Source->GetOutputPort());
+    this->Append = vtkSmartPointer<vtkAppendPolyData>::New();
+    for (int branch = 0; branch < 8; ++branch)
+    {
+      auto elevation = vtkSmartPointer<vtkElevationFilter>::New();
+      elevation->SetInputConnection(
+        branch < 2 ? this->Shared->GetOutputPort() : this->Source->GetOutputPort());
+      elevation->SetLowPoint(-1., -0.1 * branch, 0.);
+      elevation->SetHighPoint(1., 0.1 * branch, 0.5);
+      this->Append->AddInputConnection(elevation->GetOutputPort());
+      this->Branches.push_back(elevation);
+    }
+    this->Algorithms = { this->Source, this->Shared };
+    this->Algorithms.insert(this->Algorithms.end(), this->Branches.begin(), this->Branches.end());
+    this->Algorithms.push_back(this->Append);
+
+    for (std::size_t id = 0; id < this->Algorithms.size(); ++id)
+    {
+      this->Executions[id] = 0;
+      vtkNew<vtkCallbackCommand> counter;
+      counter->SetClientData(&this->Executions[id]);
+      counter->SetCallback([](vtkObject*, unsigned long, void* clientData, void*)
+        { ++*static_cast<std::atomic<int>*>(clientData); });
+      this->Algorithms[id]->AddObserver(vtkCommand::StartEvent, counter);
+    }
+  }
+
+  bool CheckExecutions(const std::vector<int>& expected)
+  {
+    bool success = true;
+    for (std::size_t id = 0; id < this->Algorithms.size(); ++id)
+    {
+      if (this->Executions[id] != expected[id])
+      {
+        std::cerr << "Algorithm " << id << " executed " << this->Executions[id]
+                  << " times instead of " << expected[id] << std::endl;
+        success = false;
+      }
+      this->Executions[id] = 0;
+    }
+    return success;
+  }
+};
+}
+
+int TestTaskGraphPipeline(int, char*[])
+{
+  Pipeline reference;
+  reference.Append->Update();
+
+  vtkNew<vtkTaskGraphPipeline> prototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+  Pipeline pipeline;
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+  for (vtkAlgorithm* algorithm : pipeline.Algorithms)
+  {
+    if (!vtkTaskGraphPipeline::SafeDownCast(algorithm->GetExecutive()))
+    {
+      std::cerr << "The executive of " << algorithm->GetClassName()
+                << " is not a vtkTaskGraphPipeline" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  bool success = true;
+
+  pipeline.Append->Update();
+  success &= pipeline.CheckExecutions({ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 });
+  vtkPolyData* output = pipeline.Append->GetOutput();
+  vtkPolyData* referenceOutput = reference.Append->GetOutput();
+  if (output->GetNumberOfPoints() == 0 || !vtkTest::SamePolyData(output, referenceOutput))
+  {
+    std::cerr << "The output differs from the one of vtkCompositeDataPipeline" << std::endl;
+    success = false;
+  }
+
+  // Nothing is executed again when the pipeline is up to date.
+  pipeline.Append->Update();
+  success &= pipeline.CheckExecutions({ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+
+  // Only the modified branches are executed again.
+  pipeline.Branches[5]->SetHighPoint(0., 0., 1.);
+  pipeline.Shared->SetLowPoint(0., 0., -1.);
+  pipeline.Append->Update();
+  success &= pipeline.CheckExecutions({ 0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1 });
+
+  // Everything is executed again when the source is modified, and a
+  // single number of threads gives the same result.
+  pipeline.Source->SetThetaResolution(32);
+  reference.Source->SetThetaResolution(32);
+  pipeline.Branches[5]->SetHighPoint(1., 0.5, 0.5);
+  reference.Branches[5]->SetHighPoint(1., 0.5, 0.5);
+  pipeline.Shared->SetLowPoint(0., 0., 0.);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { pipeline.Append->Update(); });
+  reference.Append->Update();
+  success &= pipeline.CheckExecutions({ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 });
+  if (!vtkTest::SamePolyData(pipeline.Append->GetOutput(), reference.Append->GetOutput()))
+  {
+    std::cerr << "The output differs from the one of vtkCompositeDataPipeline" << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,328 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCachedCompositeDataPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationArrayRequestKey.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkCachedCompositeDataPipeline);
+
+//------------------------------------------------------------------------------
+namespace
+{
+struct CacheEntry
+{
+  vtkCachedCompositeDataPipeline* Owner;
+  vtkMTimeType PipelineMTime;
+  std::string Key;
+  std::vector<vtkSmartPointer<vtkDataObject>> Outputs;
+  vtkTypeUInt64 Size;
+};
+
+// The entries of all the executives, the most recently used first
+struct Cache
+{
+  std::mutex Mutex;
+  std::list<CacheEntry> Entries;
+  vtkTypeUInt64 Budget = vtkTypeUInt64(1) << 30;
+  vtkTypeUInt64 Usage = 0;
+
+  // Evict the least recently used entries until size more bytes fit in
+  // the budget. The mutex must be locked.
+  void Evict(vtkTypeUInt64 size)
+  {
+    while (!this->Entries.empty() && this->Usage + size > this->Budget)
+    {
+      this->Usage -= this->Entries.back().Size;
+      this->Entries.pop_back();
+    }
+  }
+};
+
+// The cache is never destroyed, so that executives destroyed at exit can
+// still remove their entries.
+Cache& GetCache()
+{
+  static Cache* cache = new Cache;
+  return *cache;
+}
+}
+
+//------------------------------------------------------------------------------
+class vtkCachedCompositeDataPipeline::vtkInternals
+{
+public:
+  // Outputs found in the cache by NeedToExecuteData, restored by ExecuteData
+  std::vector<vtkSmartPointer<vtkDataObject>> CachedOutputs;
+  bool CacheHit = false;
+};
+
+//------------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::vtkCachedCompositeDataPipeline()
+{
+  this->Internals = new vtkInternals;
+}
+
+//------------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::~vtkCachedCompositeDataPipeline()
+{
+  this->ClearCache();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfCacheEntries: " << this->GetNumberOfCacheEntries() << "\n";
+  os << indent << "MemoryBudget: " << vtkCachedCompositeDataPipeline::GetMemoryBudget() << "\n";
+  os << indent << "MemoryUsage: " << vtkCachedCompositeDataPipeline::GetMemoryUsage() << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::SetMemoryBudget(vtkTypeUInt64 budget)
+{
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Budget = budget;
+  cache.Evict(0);
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkCachedCompositeDataPipeline::GetMemoryBudget()
+{
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Budget;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkCachedCompositeDataPipeline::GetMemoryUsage()
+{
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Usage;
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::GetNumberOfCacheEntries()
+{
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  int count = 0;
+  for (const CacheEntry& entry : cache.Entries)
+  {
+    count += entry.Owner == this;
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ClearCache()
+{
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  for (auto it = cache.Entries.begin(); it != cache.Entries.end();)
+  {
+    if (it->Owner == this)
+    {
+      cache.Usage -= it->Size;
+      it = cache.Entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+std::string vtkCachedCompositeDataPipeline::ComputeCacheKey(vtkInformationVector* outInfoVec)
+{
+  std::ostringstream key;
+  key.precision(17);
+  for (int port = 0; port < outInfoVec->GetNumberOfInformationObjects(); ++port)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(port);
+    key << "[";
+    if (outInfo->Has(UPDATE_TIME_STEP()))
+    {
+      key << "t" << outInfo->Get(UPDATE_TIME_STEP());
+    }
+    key << "p" << outInfo->Get(UPDATE_PIECE_NUMBER()) << "/"
+        << outInfo->Get(UPDATE_NUMBER_OF_PIECES()) << "g"
+        << outInfo->Get(UPDATE_NUMBER_OF_GHOST_LEVELS());
+    if (outInfo->Has(UPDATE_EXTENT()))
+    {
+      const int* extent = outInfo->Get(UPDATE_EXTENT());
+      key << "e";
+      for (int i = 0; i < 6; ++i)
+      {
+        key << " " << extent[i];
+      }
+    }
+    if (outInfo->Has(UPDATE_COMPOSITE_INDICES()))
+    {
+      const int* indices = outInfo->Get(UPDATE_COMPOSITE_INDICES());
+      key << "c";
+      for (int i = 0; i < outInfo->Length(UPDATE_COMPOSITE_INDICES()); ++i)
+      {
+        key << " " << indices[i];
+      }
+    }
+    vtkInformationArrayRequestKey* arrayKeys[] = { UPDATE_POINT_ARRAYS(), UPDATE_CELL_ARRAYS(),
+      UPDATE_FIELD_ARRAYS() };
+    for (vtkInformationArrayRequestKey* arrayKey : arrayKeys)
+    {
+      if (outInfo->Has(arrayKey))
+      {
+        key << "a";
+        for (int i = 0; i < outInfo->Length(arrayKey); ++i)
+        {
+          key << " \"" << outInfo->Get(arrayKey, i) << "\"";
+        }
+      }
+      key << ";";
+    }
+    key << "]";
+  }
+  return key.str();
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::NeedToExecuteData(
+  int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  this->Internals->CacheHit = false;
+  this->Internals->CachedOutputs.clear();
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+  {
+    return 0;
+  }
+
+  // Has the algorithm asked to be executed again?
+  if (this->ContinueExecuting)
+  {
+    return 1;
+  }
+
+  // The algorithm still needs to execute, but its outputs may be restored
+  // from the cache instead.
+  const std::string key = this->ComputeCacheKey(outInfoVec);
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  for (auto it = cache.Entries.begin(); it != cache.Entries.end(); ++it)
+  {
+    if (it->Owner == this && it->PipelineMTime == this->PipelineMTime && it->Key == key)
+    {
+      cache.Entries.splice(cache.Entries.begin(), cache.Entries, it);
+      this->Internals->CachedOutputs = it->Outputs;
+      this->Internals->CacheHit = true;
+      break;
+    }
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::ForwardUpstream(vtkInformation* request)
+{
+  // The inputs are not needed to restore the outputs from the cache.
+  if (request->Has(REQUEST_DATA()) && this->Internals->CacheHit)
+  {
+    return 1;
+  }
+  return this->Superclass::ForwardUpstream(request);
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (this->Internals->CacheHit)
+  {
+    // Restore the outputs as if the algorithm had generated them.
+    this->Internals->CacheHit = false;
+    for (int port = 0; port < outInfoVec->GetNumberOfInformationObjects(); ++port)
+    {
+      vtkInformation* outInfo = outInfoVec->GetInformationObject(port);
+      vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      vtkDataObject* cached = this->Internals->CachedOutputs[port];
+      if (output && cached)
+      {
+        output->PrepareForNewData();
+        output->CopyInformationFromPipeline(outInfo);
+        output->ShallowCopy(cached);
+      }
+    }
+    this->Internals->CachedOutputs.clear();
+    this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+    return 1;
+  }
+
+  const std::string key = this->ComputeCacheKey(outInfoVec);
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  if (!result || this->ContinueExecuting)
+  {
+    return result;
+  }
+
+  // Keep a copy of the generated outputs.
+  CacheEntry entry;
+  entry.Owner = this;
+  entry.PipelineMTime = this->PipelineMTime;
+  entry.Key = key;
+  entry.Size = 0;
+  for (int port = 0; port < outInfoVec->GetNumberOfInformationObjects(); ++port)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(port);
+    vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    vtkSmartPointer<vtkDataObject> cached;
+    if (output && !outInfo->Get(DATA_NOT_GENERATED()))
+    {
+      cached = vtkSmartPointer<vtkDataObject>::Take(output->NewInstance());
+      cached->ShallowCopy(output);
+      entry.Size += static_cast<vtkTypeUInt64>(cached->GetActualMemorySize()) * 1024;
+    }
+    entry.Outputs.push_back(cached);
+  }
+
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  for (auto it = cache.Entries.begin(); it != cache.Entries.end();)
+  {
+    // Remove the entries that can no longer be used.
+    if (it->Owner == this && (it->PipelineMTime != entry.PipelineMTime || it->Key == key))
+    {
+      cache.Usage -= it->Size;
+      it = cache.Entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  if (entry.Size <= cache.Budget)
+  {
+    cache.Evict(entry.Size);
+    cache.Usage += entry.Size;
+    cache.Entries.push_front(std::move(entry));
+  }
+  return result;
+}
+VTK_ABI_NAMESPACE_END
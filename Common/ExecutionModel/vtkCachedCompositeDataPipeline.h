@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkCachedCompositeDataPipeline
+ * @brief   Executive keeping the outputs of its algorithm in a memory budgeted cache
+ *
+ * vtkCachedCompositeDataPipeline is a vtkCompositeDataPipeline that keeps
+ * the outputs generated by its algorithm for different requests. Each entry
+ * of the cache is keyed on the pipeline modification time of the
+ * algorithm, which accounts for the modification time of the algorithm and
+ * of the algorithms upstream, and on the request of each output port: time
+ * step, piece, number of pieces, ghost levels, update extent, composite
+ * indices and requested arrays. When the algorithm needs to execute for a
+ * request found in the cache, its outputs are restored from the cache and
+ * neither the algorithm nor its inputs are updated. This avoids executing a
+ * whole pipeline again when going back and forth between time steps, for
+ * example.
+ *
+ * The entries of all the vtkCachedCompositeDataPipeline share a process
+ * wide budget, in bytes, on the sum of the vtkDataObject::GetActualMemorySize
+ * of their outputs. When a new entry does not fit in the budget, the least
+ * recently used entries of all the executives are evicted. Entries keyed on
+ * an older pipeline modification time can no longer be used, and are
+ * evicted as soon as the algorithm executes again.
+ *
+ * The cached outputs are shallow copies of the outputs of the algorithm.
+ * Algorithms generating their outputs in arrays they keep across
+ * executions must not use this executive.
+ *
+ * @sa
+ * vtkCachedStreamingDemandDrivenPipeline vtkTemporalDataSetCache
+ */
+
+#ifndef vtkCachedCompositeDataPipeline_h
+#define vtkCachedCompositeDataPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+#include <string> // For std::string
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkCachedCompositeDataPipeline
+  : public vtkCompositeDataPipeline
+{
+public:
+  static vtkCachedCompositeDataPipeline* New();
+  vtkTypeMacro(vtkCachedCompositeDataPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Memory budget, in bytes, shared by the caches of all the
+   * vtkCachedCompositeDataPipeline of the process. Reducing it evicts the
+   * least recently used entries that do not fit anymore. It defaults to
+   * 1 GiB.
+   */
+  static void SetMemoryBudget(vtkTypeUInt64 budget);
+  static vtkTypeUInt64 GetMemoryBudget();
+  ///@}
+
+  /**
+   * Memory, in bytes, used by the caches of all the
+   * vtkCachedCompositeDataPipeline of the process.
+   */
+  static vtkTypeUInt64 GetMemoryUsage();
+
+  /**
+   * Number of entries in the cache of this executive.
+   */
+  int GetNumberOfCacheEntries();
+
+  /**
+   * Remove all the entries of the cache of this executive.
+   */
+  void ClearCache();
+
+protected:
+  vtkCachedCompositeDataPipeline();
+  ~vtkCachedCompositeDataPipeline() override;
+
+  using Superclass::ForwardUpstream;
+  int ForwardUpstream(vtkInformation* request) override;
+
+  int NeedToExecuteData(
+    int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec) override;
+
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
+  /**
+   * Compute the part of the key of a cache entry describing the request of
+   * the output ports.
+   */
+  virtual std::string ComputeCacheKey(vtkInformationVector* outInfoVec);
+
+private:
+  vtkCachedCompositeDataPipeline(const vtkCachedCompositeDataPipeline&) = delete;
+  void operator=(const vtkCachedCompositeDataPipeline&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -6,6 +6,7 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataObjectTreeIterator.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkFieldData.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -282,6 +283,9 @@ void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
     if (dobj)
     {
       algo->SetProgressShiftScale(progress_scale * block_index, progress_scale);
+      vtkExecutionProfiler::SpanScope span(
+        vtkExecutive::GetProfiler(), algo->GetClassName(), "Block");
+      span.AddArgument("block", iter->GetCurrentFlatIndex());
       // Note that since VisitOnlyLeaves is ON on the iterator,
       // this method is called only for leaves, hence, we are assured that
       // neither dobj nor outObj are vtkCompositeDataSet subclasses.
@@ -0,0 +1,438 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkExecutionProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkExecutionProfiler);
+
+//------------------------------------------------------------------------------
+namespace
+{
+// Quote and escape a string as a JSON string.
+std::string ToJSON(const std::string& value)
+{
+  std::string json = "\"";
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      case '\n':
+        json += "\\n";
+        break;
+      case '\t':
+        json += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          static const char* digits = "0123456789abcdef";
+          json += "\\u00";
+          json += digits[(c >> 4) & 0xf];
+          json += digits[c & 0xf];
+        }
+        else
+        {
+          json += c;
+        }
+    }
+  }
+  json += "\"";
+  return json;
+}
+
+// Start times of the tasks executing on this thread, innermost last.
+std::vector<double>& GetTaskStartTimes()
+{
+  static thread_local std::vector<double> startTimes;
+  return startTimes;
+}
+}
+
+//------------------------------------------------------------------------------
+// Also the observer of the tasks of vtkSMPTools while the profiler is set on
+// vtkExecutive.
+class vtkExecutionProfiler::vtkInternals : public vtkSMPTools::TaskObserver
+{
+public:
+  struct Span
+  {
+    std::string Name;
+    std::string Category;
+    std::string Arguments;
+    double StartTime;
+    double Duration;
+    long long MemoryDelta;
+    int Thread;
+  };
+
+  vtkInternals(vtkExecutionProfiler* self)
+    : Self(self)
+    , Origin(std::chrono::steady_clock::now())
+  {
+  }
+
+  double GetTime()
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->Origin).count();
+  }
+
+  // Memory used by the process in KiB, or -1 if not recorded.
+  long long GetMemory()
+  {
+    return this->Self->RecordMemory ? this->SystemInformation.GetProcMemoryUsed() : -1;
+  }
+
+  void Record(Span&& span)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto thread = this->Threads.emplace(
+      std::this_thread::get_id(), static_cast<int>(this->Threads.size()));
+    span.Thread = thread.first->second;
+    this->Spans.push_back(std::move(span));
+  }
+
+  void TaskBegin(vtkIdType, vtkIdType) override
+  {
+    GetTaskStartTimes().push_back(this->GetTime());
+  }
+
+  void TaskEnd(vtkIdType first, vtkIdType last) override
+  {
+    std::vector<double>& startTimes = GetTaskStartTimes();
+    if (startTimes.empty())
+    {
+      return;
+    }
+    Span span;
+    span.StartTime = startTimes.back();
+    span.Duration = this->GetTime() - span.StartTime;
+    startTimes.pop_back();
+    if (this->Self->RecordSMPTasks)
+    {
+      span.Name = "vtkSMPTools::For";
+      span.Category = "SMP";
+      span.Arguments = "{\"first\":" + std::to_string(first) +
+        ",\"last\":" + std::to_string(last) + "}";
+      span.MemoryDelta = 0;
+      this->Record(std::move(span));
+    }
+  }
+
+  const Span& GetSpan(vtkIdType span)
+  {
+    static const Span invalid{ "", "", "{}", 0., 0., 0, -1 };
+    return span >= 0 && span < static_cast<vtkIdType>(this->Spans.size()) ? this->Spans[span]
+                                                                           : invalid;
+  }
+
+  vtkExecutionProfiler* Self;
+  std::chrono::steady_clock::time_point Origin;
+  vtksys::SystemInformation SystemInformation;
+  std::mutex Mutex;
+  std::vector<Span> Spans;
+  std::map<std::thread::id, int> Threads;
+};
+
+//------------------------------------------------------------------------------
+vtkExecutionProfiler::vtkExecutionProfiler()
+{
+  this->RecordSMPTasks = true;
+  this->RecordMemory = true;
+  this->Internals = new vtkInternals(this);
+}
+
+//------------------------------------------------------------------------------
+vtkExecutionProfiler::~vtkExecutionProfiler()
+{
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "RecordSMPTasks: " << (this->RecordSMPTasks ? "On" : "Off") << "\n";
+  os << indent << "RecordMemory: " << (this->RecordMemory ? "On" : "Off") << "\n";
+  os << indent << "NumberOfSpans: " << this->GetNumberOfSpans() << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Spans.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Origin = std::chrono::steady_clock::now();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkExecutionProfiler::GetNumberOfSpans()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkIdType>(this->Internals->Spans.size());
+}
+
+//------------------------------------------------------------------------------
+std::string vtkExecutionProfiler::GetSpanName(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).Name;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkExecutionProfiler::GetSpanCategory(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).Category;
+}
+
+//------------------------------------------------------------------------------
+double vtkExecutionProfiler::GetSpanStartTime(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).StartTime;
+}
+
+//------------------------------------------------------------------------------
+double vtkExecutionProfiler::GetSpanDuration(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).Duration;
+}
+
+//------------------------------------------------------------------------------
+int vtkExecutionProfiler::GetSpanThread(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).Thread;
+}
+
+//------------------------------------------------------------------------------
+long long vtkExecutionProfiler::GetSpanMemoryDelta(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).MemoryDelta;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkExecutionProfiler::GetSpanArguments(vtkIdType span)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->GetSpan(span).Arguments;
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::PrintSummary(ostream& os)
+{
+  struct Total
+  {
+    std::string Category;
+    std::string Name;
+    vtkIdType Count;
+    double Duration;
+  };
+  std::vector<Total> totals;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    std::map<std::pair<std::string, std::string>, size_t> indices;
+    for (const vtkInternals::Span& span : this->Internals->Spans)
+    {
+      auto index = indices.emplace(std::make_pair(span.Category, span.Name), totals.size());
+      if (index.second)
+      {
+        totals.push_back(Total{ span.Category, span.Name, 0, 0. });
+      }
+      Total& total = totals[index.first->second];
+      ++total.Count;
+      total.Duration += span.Duration;
+    }
+  }
+  std::stable_sort(totals.begin(), totals.end(),
+    [](const Total& a, const Total& b) { return a.Duration > b.Duration; });
+  for (const Total& total : totals)
+  {
+    os << total.Category << " " << total.Name << ": " << total.Count << " spans, "
+       << total.Duration << " s\n";
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::PrintChromeTrace(ostream& os)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  os << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const auto& thread : this->Internals->Threads)
+  {
+    os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+       << thread.second << ",\"args\":{\"name\":\"Thread " << thread.second << "\"}}";
+    separator = ",\n";
+  }
+  const std::streamsize precision = os.precision(3);
+  const std::ios::fmtflags flags = os.setf(std::ios::fixed, std::ios::floatfield);
+  for (const vtkInternals::Span& span : this->Internals->Spans)
+  {
+    // Times are in microseconds.
+    os << separator << "{\"name\":" << ToJSON(span.Name) << ",\"cat\":" << ToJSON(span.Category)
+       << ",\"ph\":\"X\",\"ts\":" << span.StartTime * 1e6 << ",\"dur\":" << span.Duration * 1e6
+       << ",\"pid\":0,\"tid\":" << span.Thread << ",\"args\":" << span.Arguments << "}";
+    separator = ",\n";
+  }
+  os.precision(precision);
+  os.flags(flags);
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+//------------------------------------------------------------------------------
+bool vtkExecutionProfiler::WriteChromeTrace(const char* fileName)
+{
+  if (!fileName)
+  {
+    vtkErrorMacro("No file name given.");
+    return false;
+  }
+  vtksys::ofstream file(fileName);
+  if (!file)
+  {
+    vtkErrorMacro("Cannot open " << fileName << " for writing.");
+    return false;
+  }
+  this->PrintChromeTrace(file);
+  if (!file)
+  {
+    vtkErrorMacro("Cannot write " << fileName << ".");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::ObserveSMPTasks(bool observe)
+{
+  vtkSMPTools::SetTaskObserver(observe ? this->Internals : nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkExecutionProfiler::SpanScope::SpanScope(
+  vtkExecutionProfiler* profiler, const char* name, const char* category)
+  : Profiler(nullptr)
+  , StartMemory(-1)
+  , StartTime(0.)
+{
+  this->Start(profiler, name, category);
+}
+
+//------------------------------------------------------------------------------
+vtkExecutionProfiler::SpanScope::SpanScope(
+  vtkExecutionProfiler* profiler, vtkAlgorithm* algorithm, vtkInformation* request)
+  : Profiler(nullptr)
+  , StartMemory(-1)
+  , StartTime(0.)
+{
+  if (!profiler || !algorithm || !request)
+  {
+    return;
+  }
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    this->Start(profiler, algorithm->GetClassName(), "RequestData");
+  }
+  else if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    this->Start(profiler, algorithm->GetClassName(), "RequestInformation");
+  }
+  if (this->IsRecording())
+  {
+    this->AddArgument("algorithm", algorithm->GetObjectDescription());
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::SpanScope::Start(
+  vtkExecutionProfiler* profiler, const char* name, const char* category)
+{
+  if (!profiler)
+  {
+    return;
+  }
+  this->Profiler = profiler;
+  this->Name = name ? name : "";
+  this->Category = category ? category : "";
+  // Sample the memory first, so that it is not part of the span.
+  this->StartMemory = this->Profiler->Internals->GetMemory();
+  this->StartTime = this->Profiler->Internals->GetTime();
+}
+
+//------------------------------------------------------------------------------
+vtkExecutionProfiler::SpanScope::~SpanScope()
+{
+  if (!this->Profiler)
+  {
+    return;
+  }
+  vtkInternals* internals = this->Profiler->Internals;
+  vtkInternals::Span span;
+  span.StartTime = this->StartTime;
+  span.Duration = internals->GetTime() - this->StartTime;
+  span.MemoryDelta = 0;
+  if (this->StartMemory >= 0)
+  {
+    long long memory = internals->GetMemory();
+    if (memory >= 0)
+    {
+      span.MemoryDelta = memory - this->StartMemory;
+      this->AddArgument("memory_kib", span.MemoryDelta);
+    }
+  }
+  span.Name = std::move(this->Name);
+  span.Category = std::move(this->Category);
+  span.Arguments = "{";
+  const char* separator = "";
+  for (const auto& argument : this->Arguments)
+  {
+    span.Arguments += separator + ToJSON(argument.first) + ":" + argument.second;
+    separator = ",";
+  }
+  span.Arguments += "}";
+  internals->Record(std::move(span));
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::SpanScope::AddArgument(const char* key, const std::string& value)
+{
+  if (this->Profiler && key)
+  {
+    this->Arguments.emplace_back(key, ToJSON(value));
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkExecutionProfiler::SpanScope::AddArgument(const char* key, long long value)
+{
+  if (this->Profiler && key)
+  {
+    this->Arguments.emplace_back(key, std::to_string(value));
+  }
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkExecutionProfiler
+ * @brief   Record the executions of the algorithms of all the pipelines
+ *
+ * vtkExecutionProfiler records a span, that is a start time, a duration and
+ * the thread it ran on, for each execution of the algorithms of all the
+ * pipelines while it is set as the profiler of vtkExecutive:
+ * @code
+ * vtkNew<vtkExecutionProfiler> profiler;
+ * vtkExecutive::SetProfiler(profiler);
+ * writer->Write();
+ * vtkExecutive::SetProfiler(nullptr);
+ * profiler->WriteChromeTrace("trace.json");
+ * @endcode
+ *
+ * The spans recorded are, with their category:
+ * - RequestInformation and RequestData: a REQUEST_INFORMATION or a
+ *   REQUEST_DATA processed by an algorithm, named after its class.
+ * - Block: the execution of a simple algorithm on a block of a composite
+ *   dataset by vtkCompositeDataPipeline, including its RequestInformation
+ *   and RequestData spans. Its "block" argument is the flat index of the
+ *   block.
+ * - SMP: a range of a vtkSMPTools::For loop executed by a thread, when
+ *   RecordSMPTasks is on. Its "first" and "last" arguments are the bounds
+ *   of the range.
+ *
+ * When RecordMemory is on, the RequestInformation, RequestData and Block
+ * spans also record the change of the memory used by the process, in KiB.
+ * The memory is sampled outside of the span, but sampling it may be costly
+ * on some platforms. As it is process wide, the change includes the memory
+ * allocated by the other threads during the span.
+ *
+ * The spans can be exported in the JSON trace event format of Chrome, to
+ * be opened with Perfetto or chrome://tracing, or summed by algorithm with
+ * PrintSummary.
+ *
+ * Recording is thread safe: the executives of vtkTaskGraphPipeline and
+ * vtkThreadedCompositeDataPipeline, and the threads of vtkSMPTools, record
+ * their spans concurrently.
+ *
+ * @sa
+ * vtkExecutive::SetProfiler vtkSMPTools::SetTaskObserver vtkExecutionTimer
+ */
+
+#ifndef vtkExecutionProfiler_h
+#define vtkExecutionProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <string>  // For std::string
+#include <utility> // For std::pair
+#include <vector>  // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformation;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExecutionProfiler : public vtkObject
+{
+public:
+  static vtkExecutionProfiler* New();
+  vtkTypeMacro(vtkExecutionProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Whether to record the ranges of the vtkSMPTools::For loops executed by
+   * each thread. On by default.
+   */
+  vtkSetMacro(RecordSMPTasks, bool);
+  vtkGetMacro(RecordSMPTasks, bool);
+  vtkBooleanMacro(RecordSMPTasks, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Whether to record the change of the memory used by the process during
+   * the executions of the algorithms. On by default.
+   */
+  vtkSetMacro(RecordMemory, bool);
+  vtkGetMacro(RecordMemory, bool);
+  vtkBooleanMacro(RecordMemory, bool);
+  ///@}
+
+  /**
+   * Remove all the spans recorded and restart the clock.
+   */
+  void Clear();
+
+  /**
+   * Number of spans recorded.
+   */
+  vtkIdType GetNumberOfSpans();
+
+  ///@{
+  /**
+   * Properties of a recorded span. Times are in seconds, from the creation
+   * of the profiler or the last call to Clear. Threads are numbered from 0
+   * in the order they record their first span. The memory delta, in KiB, is
+   * 0 when not recorded. The arguments are a JSON object.
+   */
+  std::string GetSpanName(vtkIdType span);
+  std::string GetSpanCategory(vtkIdType span);
+  double GetSpanStartTime(vtkIdType span);
+  double GetSpanDuration(vtkIdType span);
+  int GetSpanThread(vtkIdType span);
+  long long GetSpanMemoryDelta(vtkIdType span);
+  std::string GetSpanArguments(vtkIdType span);
+  ///@}
+
+  /**
+   * Print, for each category and name, the number of spans and their total
+   * duration, the longest first.
+   */
+  void PrintSummary(ostream& os);
+
+  /**
+   * Print the spans in the JSON trace event format of Chrome.
+   */
+  void PrintChromeTrace(ostream& os);
+
+  /**
+   * Write the spans in the JSON trace event format of Chrome to a file.
+   * Returns false if the file cannot be written.
+   */
+  bool WriteChromeTrace(const char* fileName);
+
+#if !defined(__WRAP__)
+  /**
+   * Records a span for its lifetime, used by the executives. Nothing is
+   * recorded when the profiler is nullptr.
+   */
+  class VTKCOMMONEXECUTIONMODEL_EXPORT SpanScope
+  {
+  public:
+    SpanScope(vtkExecutionProfiler* profiler, const char* name, const char* category);
+
+    /**
+     * Record the execution of a REQUEST_INFORMATION or a REQUEST_DATA by
+     * an algorithm. Nothing is recorded for the other requests.
+     */
+    SpanScope(vtkExecutionProfiler* profiler, vtkAlgorithm* algorithm, vtkInformation* request);
+
+    ~SpanScope();
+
+    /**
+     * Whether the span is recorded, to skip computing its arguments.
+     */
+    bool IsRecording() const { return this->Profiler != nullptr; }
+
+    ///@{
+    /**
+     * Add an argument to the span.
+     */
+    void AddArgument(const char* key, const std::string& value);
+    void AddArgument(const char* key, long long value);
+    ///@}
+
+    SpanScope(const SpanScope&) = delete;
+    void operator=(const SpanScope&) = delete;
+
+  private:
+    void Start(vtkExecutionProfiler* profiler, const char* name, const char* category);
+
+    vtkExecutionProfiler* Profiler;
+    std::string Name;
+    std::string Category;
+    std::vector<std::pair<std::string, std::string>> Arguments;
+    long long StartMemory;
+    double StartTime;
+  };
+#endif
+
+protected:
+  vtkExecutionProfiler();
+  ~vtkExecutionProfiler() override;
+
+  bool RecordSMPTasks;
+  bool RecordMemory;
+
+private:
+  vtkExecutionProfiler(const vtkExecutionProfiler&) = delete;
+  void operator=(const vtkExecutionProfiler&) = delete;
+
+  // Make this profiler the observer of the tasks of vtkSMPTools, or stop
+  // observing them, when set on vtkExecutive.
+  friend class vtkExecutive;
+  void ObserveSMPTasks(bool observe);
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
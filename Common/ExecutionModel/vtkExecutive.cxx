@@ -5,6 +5,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -31,6 +32,11 @@ vtkInformationKeyMacro(vtkExecutive, FROM_OUTPUT_PORT, Integer);
 vtkInformationKeyMacro(vtkExecutive, KEYS_TO_COPY, KeyVector);
 vtkInformationKeyMacro(vtkExecutive, PRODUCER, ExecutivePort);
 
+namespace
+{
+vtkExecutionProfiler* vtkExecutiveProfiler = nullptr;
+}
+
 //------------------------------------------------------------------------------
 class vtkExecutiveInternals
 {
@@ -718,6 +724,9 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
+  // Record the execution when profiling.
+  vtkExecutionProfiler::SpanScope span(vtkExecutiveProfiler, this->Algorithm, request);
+
   // Invoke the request on the algorithm.
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
@@ -784,4 +793,30 @@ bool vtkExecutive::CheckAbortedInput(vtkInformationVector** inInfoVec)
   }
   return false;
 }
+
+//------------------------------------------------------------------------------
+void vtkExecutive::SetProfiler(vtkExecutionProfiler* profiler)
+{
+  if (vtkExecutiveProfiler == profiler)
+  {
+    return;
+  }
+  if (vtkExecutiveProfiler)
+  {
+    vtkExecutiveProfiler->ObserveSMPTasks(false);
+    vtkExecutiveProfiler->UnRegister(nullptr);
+  }
+  vtkExecutiveProfiler = profiler;
+  if (vtkExecutiveProfiler)
+  {
+    vtkExecutiveProfiler->Register(nullptr);
+    vtkExecutiveProfiler->ObserveSMPTasks(true);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkExecutionProfiler* vtkExecutive::GetProfiler()
+{
+  return vtkExecutiveProfiler;
+}
 VTK_ABI_NAMESPACE_END
@@ -24,6 +24,7 @@ class vtkAlgorithm;
 class vtkAlgorithmOutput;
 class vtkAlgorithmToExecutiveFriendship;
 class vtkDataObject;
+class vtkExecutionProfiler;
 class vtkExecutiveInternals;
 class vtkInformation;
 class vtkInformationExecutivePortKey;
@@ -220,6 +221,18 @@ public:
   virtual int CallAlgorithm(vtkInformation* request, int direction, vtkInformationVector** inInfo,
     vtkInformationVector* outInfo);
 
+  ///@{
+  /**
+   * /!\ These methods are not thread safe.
+   * Set the profiler recording the executions of the algorithms of all the
+   * pipelines, and the tasks of vtkSMPTools, see vtkExecutionProfiler.
+   * nullptr by default, in which case nothing is recorded. It must not be
+   * changed while a pipeline updates.
+   */
+  static void SetProfiler(vtkExecutionProfiler* profiler);
+  static vtkExecutionProfiler* GetProfiler();
+  ///@}
+
 protected:
   vtkExecutive();
   ~vtkExecutive() override;
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkInformationArrayRequestKey.h"
+
+#include "vtkInformation.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <cstring>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+vtkInformationArrayRequestKey::vtkInformationArrayRequestKey(
+  const char* name, const char* location)
+  : vtkInformationStringVectorKey(name, location)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkInformationArrayRequestKey::~vtkInformationArrayRequestKey() = default;
+
+//------------------------------------------------------------------------------
+bool vtkInformationArrayRequestKey::IsArrayRequested(vtkInformation* info, const char* name)
+{
+  if (!info || !info->Has(this))
+  {
+    return true;
+  }
+  if (!name)
+  {
+    return false;
+  }
+  for (int i = 0; i < this->Length(info); ++i)
+  {
+    if (strcmp(this->Get(info, i), name) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void vtkInformationArrayRequestKey::CopyDefaultInformation(
+  vtkInformation* request, vtkInformation* fromInfo, vtkInformation* toInfo)
+{
+  if (!request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    return;
+  }
+  if (!toInfo->Has(vtkStreamingDemandDrivenPipeline::COMBINED_UPDATE_ARRAYS()))
+  {
+    toInfo->Remove(this);
+    this->ShallowCopy(fromInfo, toInfo);
+  }
+  else if (toInfo->Has(this))
+  {
+    // Another consumer of the same output requested some arrays in this
+    // update, add the missing ones. If it requested all of them, the key is
+    // not set.
+    for (int i = 0; i < this->Length(fromInfo); ++i)
+    {
+      const char* name = this->Get(fromInfo, i);
+      if (!this->IsArrayRequested(toInfo, name))
+      {
+        this->Append(toInfo, name);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkInformationArrayRequestKey::NeedToExecute(
+  vtkInformation* pipelineInfo, vtkInformation* dobjInfo)
+{
+  for (int i = 0; i < this->Length(pipelineInfo); ++i)
+  {
+    // An empty name requests no array.
+    const char* name = this->Get(pipelineInfo, i);
+    if (*name && !this->IsArrayRequested(dobjInfo, name))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void vtkInformationArrayRequestKey::StoreMetaData(
+  vtkInformation*, vtkInformation* pipelineInfo, vtkInformation* dobjInfo)
+{
+  dobjInfo->Remove(this);
+  this->ShallowCopy(pipelineInfo, dobjInfo);
+}
+
+//------------------------------------------------------------------------------
+void vtkInformationArrayRequestKey::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+VTK_ABI_NAMESPACE_END
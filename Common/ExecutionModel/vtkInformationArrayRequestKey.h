@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkInformationArrayRequestKey
+ * @brief   key that can be used to request a subset of the arrays from the pipeline
+ *
+ * vtkInformationArrayRequestKey is a vtkInformationStringVectorKey listing
+ * the names of the arrays a consumer needs. A good example of this is
+ * UPDATE_POINT_ARRAYS where downstream can request that upstream only
+ * provides some of the point arrays, so that readers do not read the
+ * others. There are several components that make this work. First, the key
+ * will copy itself upstream during REQUEST_UPDATE_EXTENT, combining the
+ * requests of the consumers of an output updated together. Second, after a
+ * successful execution, it will store its value into the data object's
+ * information using itself as key. Third, before execution, it will check
+ * if all the requested arrays were requested for the data object. If not,
+ * it will ask the pipeline to execute.
+ *
+ * When the key is not set, all the arrays are requested. This case is
+ * handled by vtkStreamingDemandDrivenPipeline.
+ */
+
+#ifndef vtkInformationArrayRequestKey_h
+#define vtkInformationArrayRequestKey_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkInformationStringVectorKey.h"
+
+#include "vtkCommonInformationKeyManager.h" // Manage instances of this type.
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkInformationArrayRequestKey
+  : public vtkInformationStringVectorKey
+{
+public:
+  vtkTypeMacro(vtkInformationArrayRequestKey, vtkInformationStringVectorKey);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  vtkInformationArrayRequestKey(const char* name, const char* location);
+  ~vtkInformationArrayRequestKey() override;
+
+  /**
+   * This method simply returns a new vtkInformationArrayRequestKey,
+   * given a name and a location. This method is provided for wrappers. Use
+   * the constructor directly from C++ instead.
+   */
+  static VTK_NEWINSTANCE vtkInformationArrayRequestKey* MakeKey(
+    const char* name, const char* location)
+  {
+    return new vtkInformationArrayRequestKey(name, location);
+  }
+
+  /**
+   * Returns true if info does not have this key, meaning that all the
+   * arrays are requested, or if name is listed in it.
+   */
+  bool IsArrayRequested(vtkInformation* info, const char* name);
+
+  /**
+   * Returns true if dobjInfo has this key and an array requested in
+   * pipelineInfo is not listed in it.
+   */
+  bool NeedToExecute(vtkInformation* pipelineInfo, vtkInformation* dobjInfo) override;
+
+  /**
+   * Copies the value stored in pipelineInfo using this key into
+   * dobjInfo.
+   */
+  void StoreMetaData(
+    vtkInformation* request, vtkInformation* pipelineInfo, vtkInformation* dobjInfo) override;
+
+  /**
+   * Copies the value stored in fromInfo using this key into toInfo
+   * if request has the REQUEST_UPDATE_EXTENT key. If toInfo has the
+   * COMBINED_UPDATE_ARRAYS key, another consumer already requested arrays
+   * from it during this update, and the arrays are added to its request.
+   */
+  void CopyDefaultInformation(
+    vtkInformation* request, vtkInformation* fromInfo, vtkInformation* toInfo) override;
+
+private:
+  vtkInformationArrayRequestKey(const vtkInformationArrayRequestKey&) = delete;
+  void operator=(const vtkInformationArrayRequestKey&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
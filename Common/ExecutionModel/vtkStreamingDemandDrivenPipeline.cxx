@@ -9,6 +9,7 @@
 #include "vtkDataSetAttributes.h"
 #include "vtkExtentTranslator.h"
 #include "vtkInformation.h"
+#include "vtkInformationArrayRequestKey.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
 #include "vtkInformationIdTypeKey.h"
@@ -27,6 +28,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 
+#include <cstring>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStreamingDemandDrivenPipeline);
 
@@ -40,10 +44,15 @@ vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT_INITIALIZ
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_PIECE_NUMBER, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_NUMBER_OF_PIECES, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_NUMBER_OF_GHOST_LEVELS, Integer);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_POINT_ARRAYS, ArrayRequest);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_CELL_ARRAYS, ArrayRequest);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_FIELD_ARRAYS, ArrayRequest);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PROPAGATE_ARRAY_REQUESTS, Integer);
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, WHOLE_EXTENT, IntegerVector, 6);
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT, IntegerVector, 6);
 vtkInformationKeyRestrictedMacro(
   vtkStreamingDemandDrivenPipeline, COMBINED_UPDATE_EXTENT, IntegerVector, 6);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, COMBINED_UPDATE_ARRAYS, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UNRESTRICTED_UPDATE_EXTENT, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, TIME_STEPS, DoubleVector);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_TIME_STEP, Double);
@@ -78,6 +87,92 @@ void vtkSDDPSetUpdateExtentToWholeExtent(vtkInformation* info)
     info->Set(vtkSDDP::UPDATE_EXTENT(), extent, 6);
   }
 }
+
+vtkInformationArrayRequestKey* vtkSDDPGetArrayRequestKey(int association)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  switch (association)
+  {
+    case vtkDataObject::POINT:
+      return vtkSDDP::UPDATE_POINT_ARRAYS();
+    case vtkDataObject::CELL:
+      return vtkSDDP::UPDATE_CELL_ARRAYS();
+    case vtkDataObject::FIELD:
+      return vtkSDDP::UPDATE_FIELD_ARRAYS();
+    default:
+      return nullptr;
+  }
+}
+
+// Request from an input connection the arrays requested from the output,
+// along with the arrays the algorithm processes from that input port, if the
+// port propagates the array requests. Request all the arrays otherwise.
+void vtkSDDPRequestInputArrays(
+  vtkAlgorithm* algorithm, int port, vtkInformation* outInfo, vtkInformation* inInfo)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  vtkInformationArrayRequestKey* keys[] = { vtkSDDPGetArrayRequestKey(vtkDataObject::POINT),
+    vtkSDDPGetArrayRequestKey(vtkDataObject::CELL),
+    vtkSDDPGetArrayRequestKey(vtkDataObject::FIELD) };
+  const bool propagate =
+    algorithm->GetInputPortInformation(port)->Get(vtkSDDP::PROPAGATE_ARRAY_REQUESTS()) != 0;
+  bool requested = false;
+  for (vtkInformationArrayRequestKey* key : keys)
+  {
+    // The key copied itself if the output requests some arrays only.
+    if (!propagate || !outInfo->Has(key))
+    {
+      inInfo->Remove(key);
+    }
+    requested |= inInfo->Has(key) != 0;
+  }
+  vtkInformationVector* inArrayVec =
+    algorithm->GetInformation()->Get(vtkAlgorithm::INPUT_ARRAYS_TO_PROCESS());
+  if (!requested || !inArrayVec)
+  {
+    return;
+  }
+
+  for (int i = 0; i < inArrayVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkInformation* arrayInfo = inArrayVec->GetInformationObject(i);
+    if (!arrayInfo || arrayInfo->Get(vtkAlgorithm::INPUT_PORT()) != port)
+    {
+      continue;
+    }
+    std::vector<vtkInformationArrayRequestKey*> arrayKeys;
+    switch (arrayInfo->Get(vtkDataObject::FIELD_ASSOCIATION()))
+    {
+      case vtkDataObject::FIELD_ASSOCIATION_POINTS:
+        arrayKeys = { keys[0] };
+        break;
+      case vtkDataObject::FIELD_ASSOCIATION_CELLS:
+        arrayKeys = { keys[1] };
+        break;
+      case vtkDataObject::FIELD_ASSOCIATION_NONE:
+        arrayKeys = { keys[2] };
+        break;
+      case vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS:
+        arrayKeys = { keys[0], keys[1] };
+        break;
+      default:
+        break;
+    }
+    const char* name = arrayInfo->Get(vtkDataObject::FIELD_NAME());
+    for (vtkInformationArrayRequestKey* key : arrayKeys)
+    {
+      if (!name)
+      {
+        // An active attribute can be any array.
+        inInfo->Remove(key);
+      }
+      else if (!key->IsArrayRequested(inInfo, name))
+      {
+        inInfo->Append(key, name);
+      }
+    }
+  }
+}
 }
 
 //------------------------------------------------------------------------------
@@ -271,6 +366,15 @@ vtkTypeBool vtkStreamingDemandDrivenPipeline ::ProcessRequest(
       }
     }
 
+    // The arrays requested by the next consumers of this output are added to
+    // the arrays requested so far, until the output is updated. Unlike the
+    // update extent, they are still combined when the output is up to date,
+    // as the other consumers may need arrays it does not have.
+    if (outInfo)
+    {
+      outInfo->Set(COMBINED_UPDATE_ARRAYS(), 1);
+    }
+
     // If we need to execute, propagate the update extent.
     int result = 1;
     int N2E = this->NeedToExecuteData(outputPort, inInfoVec, outInfoVec);
@@ -351,6 +455,7 @@ vtkTypeBool vtkStreamingDemandDrivenPipeline ::ProcessRequest(
           static int emptyExt[6] = { 0, -1, 0, -1, 0, -1 };
           info->Set(COMBINED_UPDATE_EXTENT(), emptyExt, 6);
         }
+        info->Remove(COMBINED_UPDATE_ARRAYS());
       }
 
       // If input ports have the key NO_PRIOR_TEMPORAL_ACCESS set to NO_PRIOR_TEMPORAL_ACCESS_RESET,
@@ -659,6 +764,8 @@ void vtkStreamingDemandDrivenPipeline ::CopyDefaultInformation(vtkInformation* r
           inInfo->CopyEntry(outInfo, UPDATE_NUMBER_OF_GHOST_LEVELS());
 
           inInfo->CopyEntry(outInfo, UPDATE_EXTENT_INITIALIZED());
+
+          vtkSDDPRequestInputArrays(this->Algorithm, i, outInfo, inInfo);
         }
       }
     }
@@ -676,6 +783,10 @@ void vtkStreamingDemandDrivenPipeline ::ResetPipelineInformation(int port, vtkIn
   info->Remove(UPDATE_PIECE_NUMBER());
   info->Remove(UPDATE_NUMBER_OF_PIECES());
   info->Remove(UPDATE_NUMBER_OF_GHOST_LEVELS());
+  info->Remove(UPDATE_POINT_ARRAYS());
+  info->Remove(UPDATE_CELL_ARRAYS());
+  info->Remove(UPDATE_FIELD_ARRAYS());
+  info->Remove(COMBINED_UPDATE_ARRAYS());
   info->Remove(TIME_STEPS());
   info->Remove(TIME_RANGE());
   info->Remove(UPDATE_TIME_STEP());
@@ -1148,6 +1259,12 @@ void vtkStreamingDemandDrivenPipeline ::MarkOutputsGenerated(
         outInfo->Remove(PREVIOUS_UPDATE_TIME_STEP());
       }
 
+      // The arrays requested for the last execution are stored by
+      // their keys, if they are set.
+      dataInfo->Remove(UPDATE_POINT_ARRAYS());
+      dataInfo->Remove(UPDATE_CELL_ARRAYS());
+      dataInfo->Remove(UPDATE_FIELD_ARRAYS());
+
       // Give the keys an opportunity to store meta-data in
       // the data object about what update request lead to
       // the last execution. This information can later be
@@ -1285,6 +1402,15 @@ int vtkStreamingDemandDrivenPipeline ::NeedToExecuteData(
     return 1;
   }
 
+  // If all the arrays are requested but only some of them were requested
+  // for the last execution, we need to execute.
+  if ((!outInfo->Has(UPDATE_POINT_ARRAYS()) && dataInfo->Has(UPDATE_POINT_ARRAYS())) ||
+    (!outInfo->Has(UPDATE_CELL_ARRAYS()) && dataInfo->Has(UPDATE_CELL_ARRAYS())) ||
+    (!outInfo->Has(UPDATE_FIELD_ARRAYS()) && dataInfo->Has(UPDATE_FIELD_ARRAYS())))
+  {
+    return 1;
+  }
+
   // Ask the keys if we need to execute. Keys can overwrite
   // NeedToExecute() to make their own decision about whether
   // what they are asking for is different than what is in the
@@ -1508,6 +1634,18 @@ int vtkStreamingDemandDrivenPipeline ::GetUpdateGhostLevel(vtkInformation* info)
   return info->Get(UPDATE_NUMBER_OF_GHOST_LEVELS());
 }
 
+//------------------------------------------------------------------------------
+bool vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+  vtkInformation* info, int association, const char* name)
+{
+  vtkInformationArrayRequestKey* key = vtkSDDPGetArrayRequestKey(association);
+  if (!key || (name && strcmp(name, vtkDataSetAttributes::GhostArrayName()) == 0))
+  {
+    return true;
+  }
+  return key->IsArrayRequested(info, name);
+}
+
 //------------------------------------------------------------------------------
 int vtkStreamingDemandDrivenPipeline::SetRequestExactExtent(int port, int flag)
 {
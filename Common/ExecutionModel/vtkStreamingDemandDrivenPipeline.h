@@ -22,6 +22,7 @@
 #define VTK_UPDATE_EXTENT_REPLACE 2
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkInformationArrayRequestKey;
 class vtkInformationDoubleKey;
 class vtkInformationDoubleVectorKey;
 class vtkInformationIdTypeKey;
@@ -167,6 +168,37 @@ public:
    */
   static vtkInformationIntegerKey* UPDATE_NUMBER_OF_GHOST_LEVELS();
 
+  ///@{
+  /**
+   * Keys to request only some of the point, cell and field arrays in
+   * pipeline information. When a key is not set, all the arrays of its
+   * association are requested. Consumers append the names of the arrays
+   * they need to the information of their inputs in RequestUpdateExtent,
+   * and an empty name requests none of them. By default, an algorithm
+   * requests all the arrays from its inputs. The arrays requested from the
+   * outputs of an algorithm are only requested from an input whose port
+   * sets PROPAGATE_ARRAY_REQUESTS, along with the named arrays the
+   * algorithm processes (see vtkAlgorithm::SetInputArrayToProcess). Readers
+   * can skip the arrays that are not requested, see IsArrayRequested. The
+   * pipeline executes again when arrays that were not requested before are
+   * requested.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationArrayRequestKey* UPDATE_POINT_ARRAYS();
+  static vtkInformationArrayRequestKey* UPDATE_CELL_ARRAYS();
+  static vtkInformationArrayRequestKey* UPDATE_FIELD_ARRAYS();
+  ///@}
+
+  /**
+   * Key set in the information of an input port, in FillInputPortInformation,
+   * by an algorithm forwarding the arrays requested from its outputs to that
+   * input. The algorithm must only use the requested arrays and the named
+   * arrays it processes, or append the other arrays it needs to the request
+   * of its input in RequestUpdateExtent.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* PROPAGATE_ARRAY_REQUESTS();
+
   /**
    * Key for combining the update extents requested by all consumers,
    * so that the final extent that is produced satisfies all consumers.
@@ -174,6 +206,14 @@ public:
    */
   static vtkInformationIntegerVectorKey* COMBINED_UPDATE_EXTENT();
 
+  /**
+   * Key set on an output while the arrays requested by its consumers are
+   * combined, from the first request of an update until the output is
+   * updated, so that the output provides the arrays of all the consumers.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* COMBINED_UPDATE_ARRAYS();
+
   /**
    * Key to store the whole extent provided in pipeline information.
    * \ingroup InformationKeys
@@ -277,6 +317,15 @@ public:
   static int GetUpdateGhostLevel(vtkInformation*);
   ///@}
 
+  /**
+   * Returns true if the array named name, of the given association
+   * (vtkDataObject::POINT, vtkDataObject::CELL or vtkDataObject::FIELD), is
+   * requested in the pipeline information of an output port. info may be
+   * nullptr, in which case all the arrays are requested. Ghost arrays are
+   * always requested.
+   */
+  static bool IsArrayRequested(vtkInformation* info, int association, const char* name);
+
 protected:
   vtkStreamingDemandDrivenPipeline();
   ~vtkStreamingDemandDrivenPipeline() override;
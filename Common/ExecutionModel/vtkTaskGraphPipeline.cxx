@@ -0,0 +1,324 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkTaskGraphPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkEndFor.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiTimeStepAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkTaskGraphPipeline);
+
+//------------------------------------------------------------------------------
+namespace
+{
+// Index standing for the executive building the graph
+constexpr std::size_t ROOT = static_cast<std::size_t>(-1);
+
+// An upstream executive that needs to execute
+struct TaskNode
+{
+  vtkTaskGraphPipeline* Executive = nullptr;
+  // Output ports requested by the consumers of the node
+  std::vector<int> Ports;
+  // Nodes producing the inputs of the node
+  std::vector<std::size_t> Producers;
+  // Nodes that must be done before the node executes
+  std::vector<std::size_t> Dependencies;
+  // Whether executing the node modifies the information of its inputs
+  bool ModifiesInputs = false;
+};
+
+template <typename T>
+void AddUnique(std::vector<T>& values, T value)
+{
+  if (std::find(values.begin(), values.end(), value) == values.end())
+  {
+    values.push_back(value);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::vtkTaskGraphPipeline()
+{
+  this->InTaskGraph = false;
+}
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::~vtkTaskGraphPipeline() = default;
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (!request->Has(REQUEST_DATA()) || this->SharedInputInformation)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (this->InTaskGraph)
+  {
+    // The task graph has already updated the producers of this executive.
+    return this->Algorithm->ModifyRequest(request, BeforeForward) &&
+      this->Algorithm->ModifyRequest(request, AfterForward);
+  }
+
+  int result = this->ExecuteTaskGraph(request);
+  if (result < 0)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::ExecuteTaskGraph(vtkInformation* request)
+{
+  // Gather the upstream executives that need to execute, as
+  // vtkCompositeDataPipeline::ForwardUpstream would reach them. The nodes
+  // are numbered in the order they are found, and listed in a topological
+  // order, producers first.
+  std::vector<TaskNode> nodes;
+  std::vector<std::size_t> order;
+  std::vector<std::size_t> rootProducers;
+  std::unordered_map<vtkExecutive*, std::size_t> nodeIds;
+  std::set<std::pair<vtkExecutive*, int>> checkedPorts;
+  // Consumers of each requested output port, by producer node and port
+  std::map<std::pair<std::size_t, int>, std::vector<std::size_t>> consumers;
+
+  std::function<bool(vtkTaskGraphPipeline*, std::size_t)> gather =
+    [&](vtkTaskGraphPipeline* consumer, std::size_t consumerId) {
+      // Inputs shared with another executive are not forwarded to.
+      if (consumer->SharedInputInformation)
+      {
+        return true;
+      }
+      for (int i = 0; i < consumer->GetNumberOfInputPorts(); ++i)
+      {
+        int nic = consumer->Algorithm->GetNumberOfInputConnections(i);
+        vtkInformationVector* inVector = consumer->GetInputInformation()[i];
+        for (int j = 0; j < nic; ++j)
+        {
+          vtkInformation* info = inVector->GetInformationObject(j);
+          vtkExecutive* e;
+          int producerPort;
+          vtkExecutive::PRODUCER()->Get(info, e, producerPort);
+          if (!e)
+          {
+            continue;
+          }
+
+          // Released data would have to be generated again for each consumer.
+          vtkTaskGraphPipeline* producer = vtkTaskGraphPipeline::SafeDownCast(e);
+          if (!producer || vtkDataObject::GetGlobalReleaseDataFlag() || info->Get(RELEASE_DATA()))
+          {
+            return false;
+          }
+
+          auto found = nodeIds.find(producer);
+          std::size_t producerId;
+          if (found != nodeIds.end() &&
+            std::find(nodes[found->second].Ports.begin(), nodes[found->second].Ports.end(),
+              producerPort) != nodes[found->second].Ports.end())
+          {
+            producerId = found->second;
+          }
+          else
+          {
+            if (!checkedPorts.insert(std::make_pair(e, producerPort)).second ||
+              !producer->NeedToExecuteData(
+                producerPort, producer->GetInputInformation(), producer->GetOutputInformation()))
+            {
+              continue;
+            }
+            if (found == nodeIds.end())
+            {
+              // Algorithms updating their inputs several times are executed serially.
+              vtkAlgorithm* algorithm = producer->GetAlgorithm();
+              if (vtkMultiTimeStepAlgorithm::SafeDownCast(algorithm) ||
+                vtkEndFor::SafeDownCast(algorithm))
+              {
+                return false;
+              }
+              producerId = nodes.size();
+              nodes.emplace_back();
+              nodes[producerId].Executive = producer;
+              nodeIds[producer] = producerId;
+              if (!gather(producer, producerId))
+              {
+                return false;
+              }
+              order.push_back(producerId);
+            }
+            else
+            {
+              producerId = found->second;
+            }
+            nodes[producerId].Ports.push_back(producerPort);
+          }
+
+          AddUnique(consumerId == ROOT ? rootProducers : nodes[consumerId].Producers, producerId);
+          AddUnique(consumers[std::make_pair(producerId, producerPort)], consumerId);
+        }
+      }
+      return true;
+    };
+  if (!gather(this, ROOT))
+  {
+    return -1;
+  }
+
+  // Consumers sharing an input execute one after the other when one of them
+  // modifies the information of that input while executing.
+  std::vector<std::size_t> positions(nodes.size());
+  for (std::size_t position = 0; position < order.size(); ++position)
+  {
+    positions[order[position]] = position;
+  }
+  bool concurrent = rootProducers.size() > 1;
+  for (TaskNode& node : nodes)
+  {
+    vtkInformationVector** inInfoVec = node.Executive->GetInputInformation();
+    int compositePort;
+    node.ModifiesInputs = node.Executive->ShouldIterateOverInput(inInfoVec, compositePort);
+    for (int i = 0; i < node.Executive->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < inInfoVec[i]->GetNumberOfInformationObjects(); ++j)
+      {
+        node.ModifiesInputs |= inInfoVec[i]->GetInformationObject(j)->Has(
+                                 vtkStreamingDemandDrivenPipeline::NO_PRIOR_TEMPORAL_ACCESS()) != 0;
+      }
+    }
+    node.Dependencies = node.Producers;
+    concurrent |= node.Producers.size() > 1;
+  }
+  for (auto& portConsumers : consumers)
+  {
+    std::vector<std::size_t>& ids = portConsumers.second;
+    ids.erase(std::remove(ids.begin(), ids.end(), ROOT), ids.end());
+    std::sort(ids.begin(), ids.end(),
+      [&](std::size_t id0, std::size_t id1) { return positions[id0] < positions[id1]; });
+    for (std::size_t second = 1; second < ids.size(); ++second)
+    {
+      for (std::size_t first = 0; first < second; ++first)
+      {
+        if (nodes[ids[first]].ModifiesInputs || nodes[ids[second]].ModifiesInputs)
+        {
+          AddUnique(nodes[ids[second]].Dependencies, ids[first]);
+        }
+      }
+    }
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+
+  // Each node executes with its own copy of the request, once its
+  // producers are done, and only if they all succeeded.
+  std::vector<char> succeeded(nodes.size(), 0);
+  auto execute = [&](std::size_t id) {
+    TaskNode& node = nodes[id];
+    for (std::size_t producerId : node.Producers)
+    {
+      if (!succeeded[producerId])
+      {
+        return;
+      }
+    }
+    vtkNew<vtkInformation> nodeRequest;
+    nodeRequest->Copy(request);
+    nodeRequest->Set(REQUEST_DATA());
+    bool result = true;
+    for (int port : node.Ports)
+    {
+      nodeRequest->Set(FROM_OUTPUT_PORT(), port);
+      node.Executive->InTaskGraph = true;
+      if (!node.Executive->ProcessRequest(nodeRequest, node.Executive->GetInputInformation(),
+            node.Executive->GetOutputInformation()))
+      {
+        result = false;
+      }
+      node.Executive->InTaskGraph = false;
+    }
+    succeeded[id] = result;
+  };
+
+  if (!concurrent)
+  {
+    // A chain of executives: nothing can execute concurrently.
+    for (std::size_t id : order)
+    {
+      execute(id);
+    }
+  }
+  else
+  {
+    // Group the nodes by level, each node being one level after the nodes
+    // it depends on, and execute the nodes of each level concurrently.
+    std::vector<std::size_t> levels(nodes.size(), 0);
+    std::vector<std::vector<std::size_t>> levelNodes;
+    for (std::size_t id : order)
+    {
+      for (std::size_t dependencyId : nodes[id].Dependencies)
+      {
+        levels[id] = std::max(levels[id], levels[dependencyId] + 1);
+      }
+      levelNodes.resize(std::max(levelNodes.size(), levels[id] + 1));
+      levelNodes[levels[id]].push_back(id);
+    }
+    for (const std::vector<std::size_t>& ids : levelNodes)
+    {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(ids.size()), 1,
+        [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            execute(ids[i]);
+          }
+        });
+    }
+  }
+
+  int result = 1;
+  for (std::size_t producerId : rootProducers)
+  {
+    if (!succeeded[producerId])
+    {
+      result = 0;
+    }
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+  return result;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkTaskGraphPipeline
+ * @brief   Executive that updates independent pipeline branches concurrently
+ *
+ * vtkTaskGraphPipeline is a vtkCompositeDataPipeline that does not update
+ * its inputs one after the other. When it receives a REQUEST_DATA, it
+ * gathers the upstream algorithms that need to execute into a graph of
+ * tasks. The tasks are grouped by levels, each algorithm executing one
+ * level after the algorithms producing its inputs, and the algorithms of
+ * each level execute concurrently with vtkSMPTools. The branches of a
+ * pipeline fanning out from a common source thus execute concurrently.
+ * The number of threads is the one of vtkSMPTools, and the algorithms of
+ * a level use nested parallelism only if vtkSMPTools allows it.
+ *
+ * Only the REQUEST_DATA pass is concurrent. The REQUEST_DATA_OBJECT,
+ * REQUEST_INFORMATION and REQUEST_UPDATE_EXTENT passes are unchanged, and
+ * an algorithm executes only when vtkCompositeDataPipeline would execute
+ * it. An algorithm shared by several branches executes once, before all of
+ * them. An algorithm whose producer failed does not execute, as if its
+ * inputs had been updated serially.
+ *
+ * The graph is used only when every executive it involves is a
+ * vtkTaskGraphPipeline and no input releases its data after use.
+ * Otherwise, the inputs are updated serially as in vtkCompositeDataPipeline.
+ * The executive that builds the graph is the one receiving the request
+ * first, usually the one of the algorithm that is updated.
+ *
+ * Several algorithms may read the same input at the same time. They must
+ * not modify it, which is the usual contract of VTK algorithms, but a data
+ * object that builds internal structures on first access (such as the cells
+ * of a vtkPolyData) should have them built by its producer. Some executions
+ * modify the information of their inputs: an algorithm that iterates over
+ * the blocks of a composite input, or whose input is accessed over time
+ * without prior access, executes after the other consumers of that input.
+ * The inputs of an algorithm that updates its inputs several times, such
+ * as a vtkMultiTimeStepAlgorithm or a vtkEndFor, are updated serially.
+ * Events, such as progress events, are invoked from the threads of
+ * vtkSMPTools.
+ *
+ * To use it for a whole pipeline, set it as the default executive
+ * prototype before creating the algorithms:
+ * @code
+ * vtkNew<vtkTaskGraphPipeline> prototype;
+ * vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+ * @endcode
+ *
+ * @sa
+ * vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkTaskGraphPipeline_h
+#define vtkTaskGraphPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkInformation;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTaskGraphPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTaskGraphPipeline* New();
+  vtkTypeMacro(vtkTaskGraphPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+protected:
+  vtkTaskGraphPipeline();
+  ~vtkTaskGraphPipeline() override;
+
+  using Superclass::ForwardUpstream;
+  int ForwardUpstream(vtkInformation* request) override;
+
+  /**
+   * Execute the REQUEST_DATA pass of the upstream algorithms as a graph of
+   * tasks. Returns -1 when the graph cannot be used, and the result of the
+   * pass otherwise.
+   */
+  virtual int ExecuteTaskGraph(vtkInformation* request);
+
+  // True while a task of a graph asks this executive to execute, its
+  // producers having already been updated.
+  bool InTaskGraph;
+
+private:
+  vtkTaskGraphPipeline(const vtkTaskGraphPipeline&) = delete;
+  void operator=(const vtkTaskGraphPipeline&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
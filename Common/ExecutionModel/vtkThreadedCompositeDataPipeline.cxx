@@ -5,6 +5,7 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkExecutive.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -103,7 +104,8 @@ class ProcessBlock
 public:
   ProcessBlock(vtkThreadedCompositeDataPipeline* exec, vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
-    const std::vector<vtkDataObject*>& inObjs, std::vector<vtkDataObject*>& outObjs)
+    const std::vector<vtkDataObject*>& inObjs, const std::vector<unsigned int>& flatIndices,
+    std::vector<vtkDataObject*>& outObjs)
     : Exec(exec)
     , InInfoVec(inInfoVec)
     , OutInfoVec(outInfoVec)
@@ -111,6 +113,7 @@ public:
     , Connection(connection)
     , Request(request)
     , InObjs(inObjs)
+    , FlatIndices(flatIndices)
   {
     int numInputPorts = this->Exec->GetNumberOfInputPorts();
     this->OutObjs = outObjs.data();
@@ -160,6 +163,9 @@ public:
 
     for (vtkIdType i = begin; i < end; ++i)
     {
+      vtkExecutionProfiler::SpanScope span(
+        vtkExecutive::GetProfiler(), this->Exec->GetAlgorithm()->GetClassName(), "Block");
+      span.AddArgument("block", this->FlatIndices[i]);
       std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
         &inInfoVec[0], outInfoVec, inInfo, request, this->InObjs[i]);
       for (int j = 0; j < outInfoVec->GetNumberOfInformationObjects(); ++j)
@@ -180,6 +186,7 @@ protected:
   int Connection;
   vtkInformation* Request;
   const std::vector<vtkDataObject*>& InObjs;
+  const std::vector<unsigned int>& FlatIndices;
   vtkDataObject** OutObjs;
 
   vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
@@ -209,6 +216,7 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   // inObjs are the non-null objects that we will loop over.
   // indices map the input objects to inObjs
   std::vector<vtkDataObject*> inObjs;
+  std::vector<unsigned int> flatIndices;
   std::vector<int> indices;
   for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
   {
@@ -216,6 +224,7 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
     if (dobj)
     {
       inObjs.push_back(dobj);
+      flatIndices.push_back(iter->GetCurrentFlatIndex());
       indices.push_back(static_cast<int>(inObjs.size()) - 1);
     }
     else
@@ -229,8 +238,8 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   outObjs.resize(indices.size() * outInfoVec->GetNumberOfInformationObjects(), nullptr);
 
   // create the parallel task processBlock
-  ProcessBlock processBlock(
-    this, inInfoVec, outInfoVec, compositePort, connection, request, inObjs, outObjs);
+  ProcessBlock processBlock(this, inInfoVec, outInfoVec, compositePort, connection, request,
+    inObjs, flatIndices, outObjs);
 
   vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
   vtkNew<vtkSMPProgressObserver> po;
@@ -264,6 +273,9 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
+  // Record the execution when profiling.
+  vtkExecutionProfiler::SpanScope span(vtkExecutive::GetProfiler(), this->Algorithm, request);
+
   // Invoke the request on the algorithm.
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
 
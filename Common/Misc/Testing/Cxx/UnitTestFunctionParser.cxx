@@ -74,6 +74,7 @@ static bool TestScalarLogic();
 static bool TestVectorLogic();
 static bool TestMiscFunctions();
 static bool TestErrors();
+static bool TestEvaluateBatch();
 
 int UnitTestFunctionParser(int, char*[])
 {
@@ -108,6 +109,7 @@ int UnitTestFunctionParser(int, char*[])
 
   status &= TestMiscFunctions();
   status &= TestErrors();
+  status &= TestEvaluateBatch();
   if (status == STATUS_FAILURE)
   {
     return EXIT_FAILURE;
@@ -1078,3 +1080,129 @@ bool TestErrors()
   }
   return status;
 }
+
+bool TestEvaluateBatch()
+{
+  std::cout << "Testing EvaluateBatch"
+            << "...";
+
+  // Values for the scalar variables a, b and c, and the vector variables u
+  // and v.
+  const int numberOfValues = 100;
+  auto rand = vtkSmartPointer<vtkMinimalStandardRandomSequence>::New();
+  std::vector<double> a(numberOfValues), b(numberOfValues), c(numberOfValues);
+  std::vector<double> u(3 * numberOfValues), v(3 * numberOfValues);
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    a[i] = rand->GetNextRangeValue(-2.0, 2.0);
+    b[i] = rand->GetNextRangeValue(0.1, 2.0);
+    c[i] = rand->GetNextRangeValue(-1.0, 1.0);
+    for (int k = 0; k < 3; ++k)
+    {
+      u[3 * i + k] = rand->GetNextRangeValue(-1.0, 1.0);
+      v[3 * i + k] = rand->GetNextRangeValue(-1.0, 1.0);
+    }
+  }
+  a[0] = b[0];
+
+  // Every operation of the parser, with scalar and vector results
+  const char* functions[] = { "a+b*2-a/b", "a^2+(-a)-(+b)", "abs(a)+exp(b)+ceil(a)+floor(b)",
+    "ln(b)+log(b)+log10(b)+sqrt(b)", "sin(a)+cos(a)+tan(a)+asin(c)+acos(c)+atan(a)",
+    "sinh(c)+cosh(c)+tanh(c)", "min(a,b)+max(a,b)+sign(a)+sign(a-a)", "u.v+mag(u)",
+    "if(a<b,a,b)+(a>b)+(a=b)+(a<b&b>0)+(a>b|b<0)", "cross(u,v)", "-u+v-u", "a*u+u*b",
+    "u/b+norm(v)", "iHat*a+jHat+kHat*c", "if(a<b,u,v)" };
+
+  auto parser = vtkSmartPointer<vtkFunctionParser>::New();
+  parser->SetScalarVariableValue("a", 0.0);
+  parser->SetScalarVariableValue("b", 0.0);
+  parser->SetScalarVariableValue("c", 0.0);
+  parser->SetVectorVariableValue("u", 0.0, 0.0, 0.0);
+  parser->SetVectorVariableValue("v", 0.0, 0.0, 0.0);
+  const double* scalarValues[3] = { a.data(), b.data(), c.data() };
+  const double* vectorValues[2] = { u.data(), v.data() };
+  std::vector<double> results(3 * numberOfValues);
+
+  bool status = STATUS_SUCCESS;
+  for (const char* function : functions)
+  {
+    parser->SetFunction(function);
+    if (!parser->EvaluateBatch(numberOfValues, scalarValues, vectorValues, results.data()))
+    {
+      std::cout << "EvaluateBatch failed for " << function << ". ";
+      status = STATUS_FAILURE;
+      continue;
+    }
+    // The results are the ones of evaluating the values one at a time
+    for (int i = 0; i < numberOfValues; ++i)
+    {
+      parser->SetScalarVariableValue("a", a[i]);
+      parser->SetScalarVariableValue("b", b[i]);
+      parser->SetScalarVariableValue("c", c[i]);
+      parser->SetVectorVariableValue("u", &u[3 * i]);
+      parser->SetVectorVariableValue("v", &v[3 * i]);
+      bool same;
+      if (parser->IsScalarResult())
+      {
+        same = parser->GetScalarResult() == results[i];
+      }
+      else
+      {
+        const double* expected = parser->GetVectorResult();
+        same = std::equal(expected, expected + 3, &results[3 * i]);
+      }
+      if (!same)
+      {
+        std::cout << "EvaluateBatch differs for " << function << " at " << i << ". ";
+        status = STATUS_FAILURE;
+        break;
+      }
+    }
+  }
+
+  // Variables without values keep their value
+  parser->SetFunction("a+b");
+  parser->SetScalarVariableValue("b", 10.0);
+  const double* onlyA[3] = { a.data(), nullptr, nullptr };
+  if (!parser->EvaluateBatch(numberOfValues, onlyA, nullptr, results.data()) ||
+    results[1] != a[1] + 10.0)
+  {
+    std::cout << "EvaluateBatch ignored the value of b. ";
+    status = STATUS_FAILURE;
+  }
+
+  // Invalid values are replaced, or make the evaluation fail
+  parser->SetFunction("sqrt(a)");
+  parser->ReplaceInvalidValuesOn();
+  parser->SetReplacementValue(-1.0);
+  const double negative[2] = { -4.0, 4.0 };
+  const double* invalidValues[3] = { negative, nullptr, nullptr };
+  if (!parser->EvaluateBatch(2, invalidValues, nullptr, results.data()) || results[0] != -1.0 ||
+    results[1] != 2.0)
+  {
+    std::cout << "EvaluateBatch did not replace invalid values. ";
+    status = STATUS_FAILURE;
+  }
+  parser->ReplaceInvalidValuesOff();
+  auto errorObserver = vtkSmartPointer<vtkTest::ErrorObserver>::New();
+  parser->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  if (parser->EvaluateBatch(2, invalidValues, nullptr, results.data()))
+  {
+    std::cout << "EvaluateBatch accepted invalid values. ";
+    status = STATUS_FAILURE;
+  }
+  if (errorObserver->GetError())
+  {
+    std::cout << "EvaluateBatch reported invalid values. ";
+    status = STATUS_FAILURE;
+  }
+
+  if (status == STATUS_SUCCESS)
+  {
+    std::cout << "PASSED\n";
+  }
+  else
+  {
+    std::cout << "FAILED\n";
+  }
+  return status;
+}
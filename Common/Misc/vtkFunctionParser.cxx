@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkFunctionParser);
@@ -834,6 +835,503 @@ bool vtkFunctionParser::Evaluate()
   return true;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Apply function to the values of a stack column. Values for which isValid
+// is false are replaced, or make the evaluation fail when replace is false.
+template <typename TIsValid, typename TFunction>
+bool vtkFunctionParserApply(double* values, vtkIdType numberOfValues, TIsValid isValid,
+  TFunction function, bool replace, double replacementValue)
+{
+  for (vtkIdType i = 0; i < numberOfValues; i++)
+  {
+    if (!isValid(values[i]))
+    {
+      if (!replace)
+      {
+        return false;
+      }
+      values[i] = replacementValue;
+    }
+    else
+    {
+      values[i] = function(values[i]);
+    }
+  }
+  return true;
+}
+
+// Apply function to the values of a stack column
+template <typename TFunction>
+void vtkFunctionParserApply(double* values, vtkIdType numberOfValues, TFunction function)
+{
+  for (vtkIdType i = 0; i < numberOfValues; i++)
+  {
+    values[i] = function(values[i]);
+  }
+}
+
+bool vtkFunctionParserIsPositive(double x)
+{
+  return !(x <= 0);
+}
+
+bool vtkFunctionParserIsNonNegative(double x)
+{
+  return !(x < 0);
+}
+
+bool vtkFunctionParserIsInUnitInterval(double x)
+{
+  return !(x < -1 || x > 1);
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkFunctionParser::EvaluateBatch(vtkIdType numberOfValues,
+  const double* const* scalarVariableValues, const double* const* vectorVariableValues,
+  double* result)
+{
+  if (this->FunctionMTime.GetMTime() > this->ParseMTime.GetMTime())
+  {
+    if (this->Parse() == 0)
+    {
+      return false;
+    }
+  }
+  if (numberOfValues < 1)
+  {
+    return true;
+  }
+
+  // Each entry of the stack is a column of numberOfValues values
+  const vtkIdType n = numberOfValues;
+  this->BatchStack.resize(static_cast<size_t>(this->StackSize * n));
+  double* stack = this->BatchStack.data();
+  auto column = [stack, n](int position) { return stack + position * n; };
+  const bool replace = this->ReplaceInvalidValues != 0;
+  const double replacement = this->ReplacementValue;
+  const int numberOfScalarVariables = this->GetNumberOfScalarVariables();
+  int numImmediatesProcessed = 0;
+  int stackPosition = -1;
+  vtkIdType i;
+
+  for (int numBytesProcessed = 0; numBytesProcessed < this->ByteCodeSize; numBytesProcessed++)
+  {
+    double* x = stackPosition >= 0 ? column(stackPosition) : nullptr;
+    double* y = stackPosition >= 1 ? column(stackPosition - 1) : nullptr;
+    switch (this->ByteCode[numBytesProcessed])
+    {
+      case VTK_PARSER_IMMEDIATE:
+        std::fill_n(column(++stackPosition), n, this->Immediates[numImmediatesProcessed++]);
+        break;
+      case VTK_PARSER_UNARY_MINUS:
+        vtkFunctionParserApply(x, n, [](double v) { return -v; });
+        break;
+      case VTK_PARSER_UNARY_PLUS:
+        break;
+      case VTK_PARSER_ADD:
+        for (i = 0; i < n; i++)
+        {
+          y[i] += x[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_SUBTRACT:
+        for (i = 0; i < n; i++)
+        {
+          y[i] -= x[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MULTIPLY:
+        for (i = 0; i < n; i++)
+        {
+          y[i] *= x[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_DIVIDE:
+        for (i = 0; i < n; i++)
+        {
+          if (x[i] == 0)
+          {
+            if (!replace)
+            {
+              return false;
+            }
+            y[i] = replacement;
+          }
+          else
+          {
+            y[i] /= x[i];
+          }
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_POWER:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = pow(y[i], x[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_ABSOLUTE_VALUE:
+        vtkFunctionParserApply(x, n, [](double v) { return fabs(v); });
+        break;
+      case VTK_PARSER_EXPONENT:
+        vtkFunctionParserApply(x, n, [](double v) { return exp(v); });
+        break;
+      case VTK_PARSER_CEILING:
+        vtkFunctionParserApply(x, n, [](double v) { return ceil(v); });
+        break;
+      case VTK_PARSER_FLOOR:
+        vtkFunctionParserApply(x, n, [](double v) { return floor(v); });
+        break;
+      case VTK_PARSER_LOGARITHM:
+      case VTK_PARSER_LOGARITHME:
+        if (!vtkFunctionParserApply(x, n, vtkFunctionParserIsPositive,
+              [](double v) { return log(v); }, replace, replacement))
+        {
+          return false;
+        }
+        break;
+      case VTK_PARSER_LOGARITHM10:
+        if (!vtkFunctionParserApply(x, n, vtkFunctionParserIsPositive,
+              [](double v) { return log10(v); }, replace, replacement))
+        {
+          return false;
+        }
+        break;
+      case VTK_PARSER_SQUARE_ROOT:
+        if (!vtkFunctionParserApply(x, n, vtkFunctionParserIsNonNegative,
+              [](double v) { return sqrt(v); }, replace, replacement))
+        {
+          return false;
+        }
+        break;
+      case VTK_PARSER_SINE:
+        vtkFunctionParserApply(x, n, [](double v) { return sin(v); });
+        break;
+      case VTK_PARSER_COSINE:
+        vtkFunctionParserApply(x, n, [](double v) { return cos(v); });
+        break;
+      case VTK_PARSER_TANGENT:
+        vtkFunctionParserApply(x, n, [](double v) { return tan(v); });
+        break;
+      case VTK_PARSER_ARCSINE:
+        if (!vtkFunctionParserApply(x, n, vtkFunctionParserIsInUnitInterval,
+              [](double v) { return asin(v); }, replace, replacement))
+        {
+          return false;
+        }
+        break;
+      case VTK_PARSER_ARCCOSINE:
+        if (!vtkFunctionParserApply(x, n, vtkFunctionParserIsInUnitInterval,
+              [](double v) { return acos(v); }, replace, replacement))
+        {
+          return false;
+        }
+        break;
+      case VTK_PARSER_ARCTANGENT:
+        vtkFunctionParserApply(x, n, [](double v) { return atan(v); });
+        break;
+      case VTK_PARSER_HYPERBOLIC_SINE:
+        vtkFunctionParserApply(x, n, [](double v) { return sinh(v); });
+        break;
+      case VTK_PARSER_HYPERBOLIC_COSINE:
+        vtkFunctionParserApply(x, n, [](double v) { return cosh(v); });
+        break;
+      case VTK_PARSER_HYPERBOLIC_TANGENT:
+        vtkFunctionParserApply(x, n, [](double v) { return tanh(v); });
+        break;
+      case VTK_PARSER_MIN:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = x[i] < y[i] ? x[i] : y[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAX:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = x[i] > y[i] ? x[i] : y[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_CROSS:
+      {
+        double* ux = column(stackPosition - 5);
+        double* uy = column(stackPosition - 4);
+        double* uz = column(stackPosition - 3);
+        double* vx = column(stackPosition - 2);
+        double* vy = column(stackPosition - 1);
+        double* vz = column(stackPosition);
+        for (i = 0; i < n; i++)
+        {
+          const double cx = uy[i] * vz[i] - uz[i] * vy[i];
+          const double cy = uz[i] * vx[i] - ux[i] * vz[i];
+          const double cz = ux[i] * vy[i] - uy[i] * vx[i];
+          ux[i] = cx;
+          uy[i] = cy;
+          uz[i] = cz;
+        }
+        stackPosition -= 3;
+        break;
+      }
+      case VTK_PARSER_SIGN:
+        vtkFunctionParserApply(x, n, [](double v) { return v < 0 ? -1.0 : (v == 0 ? 0.0 : 1.0); });
+        break;
+      case VTK_PARSER_VECTOR_UNARY_MINUS:
+        for (int k = 0; k < 3; k++)
+        {
+          vtkFunctionParserApply(column(stackPosition - k), n, [](double v) { return -v; });
+        }
+        break;
+      case VTK_PARSER_VECTOR_UNARY_PLUS:
+        break;
+      case VTK_PARSER_DOT_PRODUCT:
+      {
+        double* ux = column(stackPosition - 5);
+        double* uy = column(stackPosition - 4);
+        double* uz = column(stackPosition - 3);
+        double* vx = column(stackPosition - 2);
+        double* vy = column(stackPosition - 1);
+        double* vz = column(stackPosition);
+        for (i = 0; i < n; i++)
+        {
+          ux[i] = ux[i] * vx[i] + uy[i] * vy[i] + uz[i] * vz[i];
+        }
+        stackPosition -= 5;
+        break;
+      }
+      case VTK_PARSER_VECTOR_ADD:
+      case VTK_PARSER_VECTOR_SUBTRACT:
+      {
+        const bool add = this->ByteCode[numBytesProcessed] == VTK_PARSER_VECTOR_ADD;
+        for (int k = 0; k < 3; k++)
+        {
+          double* u = column(stackPosition - 3 - k);
+          double* v = column(stackPosition - k);
+          if (add)
+          {
+            for (i = 0; i < n; i++)
+            {
+              u[i] += v[i];
+            }
+          }
+          else
+          {
+            for (i = 0; i < n; i++)
+            {
+              u[i] -= v[i];
+            }
+          }
+        }
+        stackPosition -= 3;
+        break;
+      }
+      case VTK_PARSER_SCALAR_TIMES_VECTOR:
+      {
+        // The scalar is below the vector, which moves down in its place
+        double* s = column(stackPosition - 3);
+        double* vx = column(stackPosition - 2);
+        double* vy = column(stackPosition - 1);
+        double* vz = column(stackPosition);
+        for (i = 0; i < n; i++)
+        {
+          const double scale = s[i];
+          s[i] = vx[i] * scale;
+          vx[i] = vy[i] * scale;
+          vy[i] = vz[i] * scale;
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_VECTOR_TIMES_SCALAR:
+        for (int k = 1; k <= 3; k++)
+        {
+          double* v = column(stackPosition - k);
+          for (i = 0; i < n; i++)
+          {
+            v[i] *= x[i];
+          }
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_VECTOR_OVER_SCALAR:
+        for (int k = 1; k <= 3; k++)
+        {
+          double* v = column(stackPosition - k);
+          for (i = 0; i < n; i++)
+          {
+            if (x[i] != 0.0)
+            {
+              v[i] /= x[i];
+            }
+          }
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAGNITUDE:
+      {
+        double* vx = column(stackPosition - 2);
+        for (i = 0; i < n; i++)
+        {
+          vx[i] = sqrt(pow(x[i], 2) + pow(y[i], 2) + pow(vx[i], 2));
+        }
+        stackPosition -= 2;
+        break;
+      }
+      case VTK_PARSER_NORMALIZE:
+      {
+        double* vx = column(stackPosition - 2);
+        for (i = 0; i < n; i++)
+        {
+          const double magnitude = sqrt(pow(x[i], 2) + pow(y[i], 2) + pow(vx[i], 2));
+          if (magnitude != 0)
+          {
+            x[i] /= magnitude;
+            y[i] /= magnitude;
+            vx[i] /= magnitude;
+          }
+        }
+        break;
+      }
+      case VTK_PARSER_IHAT:
+      case VTK_PARSER_JHAT:
+      case VTK_PARSER_KHAT:
+      {
+        const int axis = this->ByteCode[numBytesProcessed] - VTK_PARSER_IHAT;
+        for (int k = 0; k < 3; k++)
+        {
+          std::fill_n(column(++stackPosition), n, k == axis ? 1.0 : 0.0);
+        }
+        break;
+      }
+      case VTK_PARSER_LESS_THAN:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = (y[i] < x[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_GREATER_THAN:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = (y[i] > x[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_EQUAL_TO:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = (y[i] == x[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_AND:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = (y[i] && x[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_OR:
+        for (i = 0; i < n; i++)
+        {
+          y[i] = (y[i] || x[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_IF:
+      {
+        // if(bool,valtrue,valfalse): the boolean is on top of the stack,
+        // above valtrue and valfalse
+        double* valFalse = column(stackPosition - 2);
+        for (i = 0; i < n; i++)
+        {
+          valFalse[i] = x[i] != 0.0 ? y[i] : valFalse[i];
+        }
+        stackPosition -= 2;
+        break;
+      }
+      case VTK_PARSER_VECTOR_IF:
+        for (int k = 0; k < 3; k++)
+        {
+          double* valFalse = column(stackPosition - 6 + k);
+          double* valTrue = column(stackPosition - 3 + k);
+          for (i = 0; i < n; i++)
+          {
+            valFalse[i] = x[i] != 0.0 ? valTrue[i] : valFalse[i];
+          }
+        }
+        stackPosition -= 4;
+        break;
+      default:
+      {
+        const int variable =
+          static_cast<int>(this->ByteCode[numBytesProcessed] - VTK_PARSER_BEGIN_VARIABLES);
+        if (variable < numberOfScalarVariables)
+        {
+          double* values = column(++stackPosition);
+          const double* input = scalarVariableValues ? scalarVariableValues[variable] : nullptr;
+          if (input)
+          {
+            std::copy(input, input + n, values);
+          }
+          else
+          {
+            std::fill_n(values, n, this->ScalarVariableValues[variable]);
+          }
+        }
+        else
+        {
+          const int vectorNum = variable - numberOfScalarVariables;
+          const double* input = vectorVariableValues ? vectorVariableValues[vectorNum] : nullptr;
+          for (int k = 0; k < 3; k++)
+          {
+            double* values = column(++stackPosition);
+            if (input)
+            {
+              for (i = 0; i < n; i++)
+              {
+                values[i] = input[3 * i + k];
+              }
+            }
+            else
+            {
+              std::fill_n(values, n, this->VectorVariableValues[vectorNum][k]);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (stackPosition == 0)
+  {
+    std::copy(stack, stack + n, result);
+  }
+  else if (stackPosition == 2)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      const double* values = column(k);
+      for (i = 0; i < n; i++)
+      {
+        result[3 * i + k] = values[i];
+      }
+    }
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkFunctionParser::IsScalarResult()
 {
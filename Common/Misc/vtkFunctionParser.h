@@ -170,6 +170,31 @@ public:
   }
   ///@}
 
+  /**
+   * Evaluate the function for numberOfValues sets of variable values at
+   * once. Each operation of the parsed function is applied to all the values
+   * before the next one, in loops that compilers can vectorize, instead of
+   * interpreting the function once per set of values as GetScalarResult()
+   * and GetVectorResult() do.
+   *
+   * scalarVariableValues has one entry per scalar variable, pointing to its
+   * numberOfValues values, and vectorVariableValues one entry per vector
+   * variable, pointing to its numberOfValues interleaved 3-component values.
+   * Variables whose entry is nullptr, or all of them if the array itself is
+   * nullptr, keep the value set with SetScalarVariableValue() or
+   * SetVectorVariableValue(). The results are written to result, which holds
+   * numberOfValues values for a scalar result, and numberOfValues
+   * interleaved 3-component values for a vector result. They are the ones
+   * that evaluating the values one at a time would give.
+   *
+   * Return false if the function cannot be parsed, or if it is invalid for
+   * one of the values while ReplaceInvalidValues is off. The results are then
+   * undefined. Invalid values are not reported as errors, so that callers can
+   * evaluate the values one at a time to report them.
+   */
+  bool EvaluateBatch(vtkIdType numberOfValues, const double* const* scalarVariableValues,
+    const double* const* vectorVariableValues, double* result);
+
   ///@{
   /**
    * Set the value of a scalar variable.  If a variable with this name
@@ -431,6 +456,9 @@ protected:
   int StackSize;
   int StackPointer;
 
+  // Stack of EvaluateBatch, each entry holding a column of values
+  std::vector<double> BatchStack;
+
   vtkTimeStamp FunctionMTime;
   vtkTimeStamp ParseMTime;
   vtkTimeStamp CheckMTime;
@@ -2,15 +2,24 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <vtkArrayCalculator.h>
+#include <vtkDoubleArray.h>
 #include <vtkImageData.h>
+#include <vtkLogger.h>
 #include <vtkNew.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkSOADataArrayTemplate.h>
 #include <vtkSmartPointer.h>
+#include <vtkStringOutputWindow.h>
 #include <vtkTestUtilities.h>
 #include <vtkXMLImageDataReader.h>
 #include <vtkXMLPolyDataReader.h>
 
+#include <cmath>
+#include <string>
+
 int TestArrayCalculator(int argc, char* argv[])
 {
   for (int i = 0; i < vtkArrayCalculator::NumberOfFunctionParserTypes; ++i)
@@ -151,5 +160,111 @@ int TestArrayCalculator(int argc, char* argv[])
       return EXIT_FAILURE;
     }
   }
+
+  // Both parsers give the expected values for many tuples, reading
+  // coordinates, an AOS array and the selected components of an SOA array.
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("s");
+  vtkNew<vtkSOADataArrayTemplate<float>> vectors;
+  vectors->SetName("v");
+  vectors->SetNumberOfComponents(4);
+  const vtkIdType numPoints = 5000;
+  vectors->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    points->InsertNextPoint(0.001 * i, std::sin(0.01 * i), 1.0);
+    scalars->InsertNextValue(std::cos(0.02 * i));
+    for (int c = 0; c < 4; ++c)
+    {
+      vectors->SetTypedComponent(i, c, static_cast<float>(c * i % 7));
+    }
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+  cloud->GetPointData()->AddArray(scalars);
+  cloud->GetPointData()->AddArray(vectors);
+
+  for (int i = 0; i < vtkArrayCalculator::NumberOfFunctionParserTypes; ++i)
+  {
+    vtkNew<vtkArrayCalculator> calc;
+    calc->SetInputData(cloud);
+    calc->SetFunctionParserType(static_cast<vtkArrayCalculator::FunctionParserTypes>(i));
+    calc->SetAttributeTypeToPointData();
+    calc->AddScalarArrayName("s");
+    calc->AddVectorVariable("v", "v", 3, 1, 2);
+    calc->AddCoordinateScalarVariable("y", 1);
+    calc->AddCoordinateVectorVariable("p", 0, 1, 2);
+    calc->SetFunction("(s * y + mag(v)) * p + v");
+    calc->SetResultArrayName("Result");
+    calc->Update();
+
+    vtkDataArray* results =
+      vtkPolyData::SafeDownCast(calc->GetOutput())->GetPointData()->GetArray("Result");
+    if (!results || results->GetNumberOfTuples() != numPoints ||
+      results->GetNumberOfComponents() != 3)
+    {
+      std::cerr << "Unexpected result array for parser " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType j = 0; j < numPoints; ++j)
+    {
+      double p[3], v[3] = { vectors->GetTypedComponent(j, 3), vectors->GetTypedComponent(j, 1),
+                     vectors->GetTypedComponent(j, 2) };
+      points->GetPoint(j, p);
+      const double scale =
+        scalars->GetValue(j) * p[1] + std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+      for (int c = 0; c < 3; ++c)
+      {
+        const double expected = scale * p[c] + v[c];
+        if (std::abs(results->GetComponent(j, c) - expected) > 1e-12 * (1.0 + std::abs(expected)))
+        {
+          std::cerr << "Unexpected result " << results->GetComponent(j, c) << " instead of "
+                    << expected << " for parser " << i << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // Invalid values are reported once each when they are not replaced, even
+  // when the batch holding them is evaluated again one tuple at a time.
+  vtkNew<vtkDoubleArray> radicands;
+  radicands->SetName("r");
+  radicands->SetNumberOfTuples(numPoints);
+  radicands->Fill(4.0);
+  radicands->SetValue(10, -1.0);
+  radicands->SetValue(2500, -4.0);
+  cloud->GetPointData()->AddArray(radicands);
+  vtkNew<vtkArrayCalculator> invalidCalc;
+  invalidCalc->SetInputData(cloud);
+  invalidCalc->SetFunctionParserTypeToFunctionParser();
+  invalidCalc->SetAttributeTypeToPointData();
+  invalidCalc->AddScalarArrayName("r");
+  invalidCalc->SetFunction("sqrt(r)");
+  invalidCalc->ReplaceInvalidValuesOff();
+  auto previousVerbosity = vtkLogger::GetCurrentVerbosityCutoff();
+  vtkLogger::SetStderrVerbosity(vtkLogger::VERBOSITY_OFF);
+  vtkOutputWindow* outputWindow = vtkOutputWindow::GetInstance();
+  outputWindow->Register(nullptr);
+  vtkNew<vtkStringOutputWindow> errors;
+  vtkOutputWindow::SetInstance(errors);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { invalidCalc->Update(); });
+  vtkOutputWindow::SetInstance(outputWindow);
+  outputWindow->UnRegister(nullptr);
+  vtkLogger::SetStderrVerbosity(previousVerbosity);
+  const std::string message = "Trying to take a square root of a negative value";
+  const std::string output = errors->GetOutput();
+  int numErrors = 0;
+  for (size_t pos = output.find(message); pos != std::string::npos;
+       pos = output.find(message, pos + 1))
+  {
+    ++numErrors;
+  }
+  if (numErrors != 2)
+  {
+    std::cerr << "Expected 2 errors for the invalid values, got " << numErrors << std::endl;
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
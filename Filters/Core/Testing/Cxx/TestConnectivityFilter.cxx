@@ -8,9 +8,12 @@
 #include <vtkImageData.h>
 #include <vtkPointData.h>
 #include <vtkRTAnalyticSource.h>
+#include <vtkSMPTools.h>
 #include <vtkTestUtilities.h>
 #include <vtkUnstructuredGrid.h>
 
+#include <algorithm>
+
 namespace
 {
 //------------------------------------------------------------------------------
@@ -178,6 +181,81 @@ bool TestRegionIdArraySize()
 
   return true;
 }
+
+//------------------------------------------------------------------------------
+bool SameValues(vtkDataArray* array0, vtkDataArray* array1)
+{
+  if (!array0 || !array1 || array0->GetNumberOfValues() != array1->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < array0->GetNumberOfValues(); ++i)
+  {
+    if (array0->GetVariantValue(i) != array1->GetVariantValue(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestRegionIdsIndependentOfThreads()
+{
+  std::cout << "TestRegionIdsIndependentOfThreads\n";
+  // Scalar connectivity splits the wavelet in many regions
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+
+  vtkNew<vtkConnectivityFilter> connectivityFilter;
+  connectivityFilter->SetInputConnection(wavelet->GetOutputPort());
+  connectivityFilter->ScalarConnectivityOn();
+  connectivityFilter->SetScalarRange(150, 200);
+  connectivityFilter->SetExtractionModeToAllRegions();
+  connectivityFilter->ColorRegionsOn();
+  connectivityFilter->CompressArraysOff();
+  connectivityFilter->Update();
+  vtkNew<vtkUnstructuredGrid> output;
+  output->DeepCopy(connectivityFilter->GetUnstructuredGridOutput());
+  const int numRegions = connectivityFilter->GetNumberOfExtractedRegions();
+
+  connectivityFilter->Modified();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { connectivityFilter->Update(); });
+  vtkUnstructuredGrid* serialOutput = connectivityFilter->GetUnstructuredGridOutput();
+
+  if (numRegions < 2 || numRegions != connectivityFilter->GetNumberOfExtractedRegions() ||
+    !SameValues(output->GetCellData()->GetScalars(), serialOutput->GetCellData()->GetScalars()) ||
+    !SameValues(output->GetPointData()->GetScalars(), serialOutput->GetPointData()->GetScalars()) ||
+    !SameValues(output->GetPoints()->GetData(), serialOutput->GetPoints()->GetData()))
+  {
+    std::cerr << "ERROR: The regions depend on the number of threads.\n";
+    return false;
+  }
+
+  // A region starts at the first cell not yet visited
+  vtkDataArray* regionIds = output->GetCellData()->GetScalars();
+  double nextRegionId = 0;
+  for (vtkIdType cellId = 0; cellId < regionIds->GetNumberOfTuples(); ++cellId)
+  {
+    const double regionId = regionIds->GetTuple1(cellId);
+    if (regionId > nextRegionId)
+    {
+      std::cerr << "ERROR: Region " << regionId << " starts before region " << nextRegionId
+                << ".\n";
+      return false;
+    }
+    nextRegionId = std::max(nextRegionId, regionId + 1);
+  }
+
+  // The largest region is extracted on any number of threads
+  connectivityFilter->SetExtractionModeToLargestRegion();
+  connectivityFilter->Update();
+  const vtkIdType numLargestCells = connectivityFilter->GetOutput()->GetNumberOfCells();
+  connectivityFilter->Modified();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { connectivityFilter->Update(); });
+  return CompareValues(
+    "largest region size", connectivityFilter->GetOutput()->GetNumberOfCells(), numLargestCells);
+}
 }
 
 //------------------------------------------------------------------------------
@@ -217,5 +295,10 @@ int TestConnectivityFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     return EXIT_FAILURE;
   }
 
+  if (!TestRegionIdsIndependentOfThreads())
+  {
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,380 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkGlyph3D generates the same glyphs with any number of threads,
+// and as the serial implementation did, in all its scaling, orientation and
+// indexing modes, and that IsPointVisible is still called serially in point
+// order.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestSMPUtilities.h"
+#include "vtkTransform.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr int Resolution = 40;
+
+// Points on a grid with scalars, vectors, normals, a label and ghost points
+vtkSmartPointer<vtkPolyData> MakeInput()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scale");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Velocity");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Label");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        const double x = i, y = j, z = k;
+        points->InsertNextPoint(x, y, z);
+        scalars->InsertNextValue(std::sin(0.3 * x) * std::cos(0.2 * y) + 0.01 * z);
+        // Some vectors only have an x component, to flip the glyphs
+        vectors->InsertNextTuple3(
+          std::cos(0.1 * x + y), (i % 3) ? std::sin(0.2 * y) : 0.0, (i % 3) ? 0.1 * z : 0.0);
+        normals->InsertNextTuple3(0.0, std::sin(0.3 * z), std::cos(0.3 * z));
+        labels->InsertNextValue(i + j + k);
+        ghosts->InsertNextValue((i + j) % 17 ? 0 : vtkDataSetAttributes::DUPLICATEPOINT);
+      }
+    }
+  }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetNormals(normals);
+  input->GetPointData()->AddArray(labels);
+  input->GetPointData()->AddArray(ghosts);
+  return input;
+}
+
+// A glyph with normals, polys and verts, whose cell data are ordered by cell type
+vtkSmartPointer<vtkPolyData> MakeMixedGlyph()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(0.5, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 0.5, 0.0);
+  points->InsertNextPoint(0.0, 0.0, 0.5);
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  polys->InsertNextCell(3, triangle);
+  vtkNew<vtkCellArray> verts;
+  const vtkIdType vertex = 3;
+  verts->InsertNextCell(1, &vertex);
+  vtkNew<vtkDoubleArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  normals->InsertNextTuple3(0.0, 0.0, 1.0);
+  normals->InsertNextTuple3(0.0, 0.6, 0.8);
+  normals->InsertNextTuple3(0.6, 0.0, 0.8);
+  normals->InsertNextTuple3(1.0, 0.0, 0.0);
+  vtkSmartPointer<vtkPolyData> glyph = vtkSmartPointer<vtkPolyData>::New();
+  glyph->SetPoints(points);
+  glyph->SetPolys(polys);
+  glyph->SetVerts(verts);
+  glyph->GetPointData()->SetNormals(normals);
+  return glyph;
+}
+
+// Order sensitive hash of the values of a single component array
+unsigned long long HashValues(vtkDataArray* array)
+{
+  unsigned long long hash = 7;
+  for (vtkIdType tupleId = 0; array && tupleId < array->GetNumberOfTuples(); ++tupleId)
+  {
+    hash = hash * 1000003ULL + static_cast<unsigned long long>(array->GetTuple1(tupleId) + 1);
+  }
+  return hash;
+}
+
+// Weighted sum of the components of an array
+double Checksum(vtkDataArray* array)
+{
+  double sum = 0.0;
+  for (vtkIdType tupleId = 0; array && tupleId < array->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+    {
+      sum += (tupleId % 7 + comp + 1) * array->GetComponent(tupleId, comp);
+    }
+  }
+  return sum;
+}
+
+// The glyphs generated by the serial implementation, in the order of the modes
+struct Baseline
+{
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfCells;
+  unsigned long long VertsHash;
+  unsigned long long PolysHash;
+  unsigned long long PointIdsHash;
+  double PointsChecksum;
+  double NormalsChecksum;
+  double ScalarsChecksum;
+};
+
+const Baseline Baselines[] = {
+  { 542520, 542520, 7ULL, 1455370865558064231ULL, 4392578317482515287ULL,
+    158552222.63198048, 0, 432366.78309165186 },
+  { 542520, 542520, 7ULL, 1455370865558064231ULL, 4392578317482515287ULL,
+    158667039.88293019, 0, 2170077 },
+  { 542520, 542520, 7ULL, 1455370865558064231ULL, 4392578317482515287ULL,
+    158550808.4219, 0, 432366.78312301339 },
+  { 542520, 542520, 7ULL, 1455370865558064231ULL, 4392578317482515287ULL,
+    158654129.27299699, 0, 432366.78309165186 },
+  { 928584, 1564716, 4141558237734876395ULL, 17256105259679651203ULL, 7144666675543898019ULL,
+    267362047.46678212, 57405.234801108862, -401188.94652754709 },
+  { 684536, 1118246, 6202625649605613493ULL, 11621535101015624903ULL, 12855319432151481031ULL,
+    200212556.64345878, 16817.684141969265, 4894418.9892780473 },
+};
+
+bool SameChecksum(double checksum, double expected)
+{
+  return std::abs(checksum - expected) <= 1e-6 * std::abs(expected);
+}
+
+bool MatchesBaseline(vtkPolyData* glyphs, const Baseline& baseline)
+{
+  return glyphs->GetNumberOfPoints() == baseline.NumberOfPoints &&
+    glyphs->GetNumberOfCells() == baseline.NumberOfCells &&
+    glyphs->GetNumberOfLines() == 0 && glyphs->GetNumberOfStrips() == 0 &&
+    HashValues(glyphs->GetVerts()->GetConnectivityArray()) == baseline.VertsHash &&
+    HashValues(glyphs->GetPolys()->GetConnectivityArray()) == baseline.PolysHash &&
+    HashValues(glyphs->GetPointData()->GetArray("InputPointIds")) == baseline.PointIdsHash &&
+    SameChecksum(Checksum(glyphs->GetPoints()->GetData()), baseline.PointsChecksum) &&
+    SameChecksum(Checksum(glyphs->GetPointData()->GetNormals()), baseline.NormalsChecksum) &&
+    SameChecksum(Checksum(glyphs->GetPointData()->GetScalars()), baseline.ScalarsChecksum);
+}
+
+// Hides every other point it is asked about, which only gives the same output
+// as a serial traversal when it is called in point order.
+class vtkAlternateGlyph3D : public vtkGlyph3D
+{
+public:
+  static vtkAlternateGlyph3D* New();
+  vtkTypeMacro(vtkAlternateGlyph3D, vtkGlyph3D);
+
+  std::vector<vtkIdType> VisitedPoints;
+
+protected:
+  vtkAlternateGlyph3D() = default;
+  ~vtkAlternateGlyph3D() override = default;
+
+  int IsPointVisible(vtkDataSet*, vtkIdType ptId) override
+  {
+    this->VisitedPoints.push_back(ptId);
+    return this->VisitedPoints.size() % 2;
+  }
+
+private:
+  vtkAlternateGlyph3D(const vtkAlternateGlyph3D&) = delete;
+  void operator=(const vtkAlternateGlyph3D&) = delete;
+};
+vtkStandardNewMacro(vtkAlternateGlyph3D);
+
+int TestIsPointVisible(vtkPolyData* input, vtkConeSource* cone)
+{
+  vtkNew<vtkAlternateGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceConnection(cone->GetOutputPort());
+  glyph->GeneratePointIdsOn();
+  glyph->Update();
+
+  // Only the points that are not ghosts are visited, once each and in order
+  const std::vector<vtkIdType>& visited = glyph->VisitedPoints;
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+  std::vector<vtkIdType> expected;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    if (!ghosts->GetValue(ptId))
+    {
+      expected.push_back(ptId);
+    }
+  }
+  if (visited != expected)
+  {
+    std::cerr << "IsPointVisible was called for " << visited.size() << " points instead of "
+              << expected.size() << ", or not in point order" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Every other visited point is glyphed
+  vtkPolyData* output = glyph->GetOutput();
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("InputPointIds");
+  const vtkIdType numGlyphPts = cone->GetOutput()->GetNumberOfPoints();
+  const vtkIdType numGlyphs = static_cast<vtkIdType>((expected.size() + 1) / 2);
+  bool valid = pointIds && output->GetNumberOfPoints() == numGlyphs * numGlyphPts;
+  for (vtkIdType glyphId = 0; valid && glyphId < numGlyphs; ++glyphId)
+  {
+    valid = pointIds->GetComponent(glyphId * numGlyphPts, 0) == expected[2 * glyphId];
+  }
+  if (!valid)
+  {
+    std::cerr << "The points hidden by IsPointVisible were glyphed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestGlyph3DThreads(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = MakeInput();
+  vtkNew<vtkConeSource> cone;
+  cone->SetResolution(8);
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.3);
+  vtkNew<vtkSphereSource> smallSphere;
+  smallSphere->SetRadius(0.15);
+  smallSphere->SetThetaResolution(5);
+  smallSphere->SetPhiResolution(4);
+  vtkSmartPointer<vtkPolyData> mixed = MakeMixedGlyph();
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateZ(30.0);
+  sourceTransform->Scale(0.5, 1.0, 2.0);
+
+  struct Mode
+  {
+    const char* Name;
+    int ScaleMode;
+    int VectorMode;
+    int IndexMode;
+    int ColorMode;
+    bool Clamping;
+    bool DoublePrecision;
+    bool WithSourceTransform;
+  };
+  const Mode modes[] = {
+    { "scale by scalar", VTK_SCALE_BY_SCALAR, VTK_USE_VECTOR, VTK_INDEXING_OFF, VTK_COLOR_BY_SCALE,
+      false, false, false },
+    { "scale by vector", VTK_SCALE_BY_VECTOR, VTK_USE_NORMAL, VTK_INDEXING_OFF,
+      VTK_COLOR_BY_VECTOR, true, true, true },
+    { "scale by vector components", VTK_SCALE_BY_VECTORCOMPONENTS, VTK_USE_VECTOR,
+      VTK_INDEXING_OFF, VTK_COLOR_BY_SCALAR, true, false, true },
+    { "follow camera", VTK_DATA_SCALING_OFF, VTK_FOLLOW_CAMERA_DIRECTION, VTK_INDEXING_OFF,
+      VTK_COLOR_BY_SCALE, false, true, false },
+    { "index by scalar", VTK_SCALE_BY_SCALAR, VTK_USE_VECTOR, VTK_INDEXING_BY_SCALAR,
+      VTK_COLOR_BY_SCALE, false, false, false },
+    { "index by vector", VTK_SCALE_BY_VECTOR, VTK_USE_VECTOR, VTK_INDEXING_BY_VECTOR,
+      VTK_COLOR_BY_VECTOR, true, false, true },
+  };
+
+  int status = EXIT_SUCCESS;
+  for (int modeId = 0; modeId < static_cast<int>(sizeof(modes) / sizeof(modes[0])); ++modeId)
+  {
+    const Mode& mode = modes[modeId];
+    vtkNew<vtkGlyph3D> glyph;
+    glyph->SetInputData(input);
+    if (mode.IndexMode == VTK_INDEXING_OFF)
+    {
+      glyph->SetSourceConnection(cone->GetOutputPort());
+    }
+    else
+    {
+      glyph->SetSourceConnection(0, sphere->GetOutputPort());
+      glyph->SetSourceData(1, mixed);
+      glyph->SetSourceConnection(2, smallSphere->GetOutputPort());
+      glyph->SetRange(-1.0, 1.0);
+    }
+    glyph->SetScaleMode(mode.ScaleMode);
+    glyph->SetVectorMode(mode.VectorMode);
+    glyph->SetIndexMode(mode.IndexMode);
+    glyph->SetColorMode(mode.ColorMode);
+    glyph->SetClamping(mode.Clamping);
+    glyph->SetScaleFactor(0.4);
+    const double cameraPosition[3] = { 20.0, 30.0, 100.0 };
+    const double cameraViewUp[3] = { 0.0, 0.0, 1.0 };
+    glyph->SetFollowedCameraPosition(cameraPosition);
+    glyph->SetFollowedCameraViewUp(cameraViewUp);
+    glyph->SetOutputPointsPrecision(
+      mode.DoublePrecision ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::SINGLE_PRECISION);
+    if (mode.WithSourceTransform)
+    {
+      glyph->SetSourceTransform(sourceTransform);
+    }
+    glyph->GeneratePointIdsOn();
+    glyph->FillCellDataOn();
+
+    vtkSmartPointer<vtkPolyData> glyphs = vtkTest::UpdateAndCopy(glyph.GetPointer());
+    vtkSmartPointer<vtkPolyData> singleThreaded =
+      vtkTest::ExecuteOnOneThread([&]() { return vtkTest::UpdateAndCopy(glyph.GetPointer()); });
+
+    if (glyphs->GetNumberOfCells() == 0 || !vtkTest::SamePolyData(glyphs, singleThreaded))
+    {
+      std::cerr << "The glyphs of mode " << mode.Name << " depend on the number of threads"
+                << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (!MatchesBaseline(glyphs, Baselines[modeId]))
+    {
+      std::cerr << "The glyphs of mode " << mode.Name << " differ from the serial implementation"
+                << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // The points ids and the cell data match the glyphed points
+    vtkDataArray* pointIds = glyphs->GetPointData()->GetArray("InputPointIds");
+    if (!pointIds || pointIds->GetNumberOfTuples() != glyphs->GetNumberOfPoints())
+    {
+      std::cerr << "Missing point ids for mode " << mode.Name << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (mode.IndexMode == VTK_INDEXING_OFF)
+    {
+      vtkDataArray* labels = glyphs->GetCellData()->GetArray("Label");
+      vtkDataArray* inLabels = input->GetPointData()->GetArray("Label");
+      const vtkIdType numCells = cone->GetOutput()->GetNumberOfCells();
+      const vtkIdType numPts = cone->GetOutput()->GetNumberOfPoints();
+      bool validCellData = labels && labels->GetNumberOfTuples() == glyphs->GetNumberOfCells();
+      for (vtkIdType cellId = 0; validCellData && cellId < glyphs->GetNumberOfCells(); ++cellId)
+      {
+        // The glyphs of the cone only have polys
+        const vtkIdType inPtId =
+          static_cast<vtkIdType>(pointIds->GetComponent(cellId / numCells * numPts, 0));
+        validCellData = labels->GetComponent(cellId, 0) == inLabels->GetComponent(inPtId, 0);
+      }
+      if (!validCellData)
+      {
+        std::cerr << "Unexpected cell data for mode " << mode.Name << std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (TestIsPointVisible(input, cone) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
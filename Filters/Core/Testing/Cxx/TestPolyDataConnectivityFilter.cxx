@@ -3,13 +3,20 @@
 
 #include <vtkAppendPolyData.h>
 #include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkMinimalStandardRandomSequence.h>
 #include <vtkPointData.h>
 #include <vtkPolyDataConnectivityFilter.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkSphereSource.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace
 {
 void InitializePolyData(vtkPolyData* polyData, int dataType)
@@ -173,6 +180,121 @@ bool MarkVisitedPoints()
 
   return succeeded;
 }
+
+std::vector<vtkIdType> GetRegionIds(vtkPolyData* polyData)
+{
+  vtkDataArray* regionIds = polyData->GetPointData()->GetArray("RegionId");
+  std::vector<vtkIdType> values;
+  for (vtkIdType i = 0; regionIds && i < regionIds->GetNumberOfTuples(); ++i)
+  {
+    values.push_back(static_cast<vtkIdType>(regionIds->GetTuple1(i)));
+  }
+  return values;
+}
+
+// Order sensitive hash of the region ids
+unsigned long long HashRegionIds(const std::vector<vtkIdType>& regionIds)
+{
+  unsigned long long hash = 7;
+  for (vtkIdType regionId : regionIds)
+  {
+    hash = hash * 1000003ULL + static_cast<unsigned long long>(regionId + 1);
+  }
+  return hash;
+}
+
+bool RegionIdsIndependentOfThreads()
+{
+  // The regions extracted by the serial wave propagation, without and with
+  // full scalar connectivity
+  const vtkIdType baselineNumberOfRegions[2] = { 49554, 56024 };
+  const unsigned long long baselineRegionIdsHash[2] = { 16997473848252607362ULL,
+    2264137623605762172ULL };
+
+  // A sphere split in many regions by scalar connectivity
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    const double* x = input->GetPoint(ptId);
+    scalars->SetValue(ptId, std::sin(20.0 * x[0]) * std::cos(20.0 * x[1]));
+  }
+  input->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkPolyDataConnectivityFilter> connectivity;
+  connectivity->SetInputData(input);
+  connectivity->ScalarConnectivityOn();
+  connectivity->SetScalarRange(0.2, 1.0);
+  connectivity->SetExtractionModeToAllRegions();
+  connectivity->ColorRegionsOn();
+
+  bool succeeded = true;
+  for (vtkTypeBool fullScalarConnectivity : { 0, 1 })
+  {
+    connectivity->SetFullScalarConnectivity(fullScalarConnectivity);
+    connectivity->Update();
+    const std::vector<vtkIdType> regionIds = GetRegionIds(connectivity->GetOutput());
+    vtkNew<vtkIdTypeArray> regionSizes;
+    regionSizes->DeepCopy(connectivity->GetRegionSizes());
+
+    connectivity->Modified();
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { connectivity->Update(); });
+    vtkIdTypeArray* serialRegionSizes = connectivity->GetRegionSizes();
+    if (regionSizes->GetNumberOfValues() < 2 ||
+      regionSizes->GetNumberOfValues() != serialRegionSizes->GetNumberOfValues() ||
+      !std::equal(regionSizes->GetPointer(0),
+        regionSizes->GetPointer(0) + regionSizes->GetNumberOfValues(),
+        serialRegionSizes->GetPointer(0)) ||
+      regionIds.size() != static_cast<size_t>(input->GetNumberOfPoints()) ||
+      regionIds != GetRegionIds(connectivity->GetOutput()))
+    {
+      std::cerr << "The regions depend on the number of threads with full scalar connectivity "
+                << fullScalarConnectivity << std::endl;
+      succeeded = false;
+    }
+
+    const int mode = fullScalarConnectivity;
+    if (connectivity->GetNumberOfExtractedRegions() != baselineNumberOfRegions[mode] ||
+      HashRegionIds(regionIds) != baselineRegionIdsHash[mode])
+    {
+      std::cerr << "The regions differ from the serial ones with full scalar connectivity "
+                << fullScalarConnectivity << std::endl;
+      succeeded = false;
+    }
+
+    // The points are ordered by region
+    if (!std::is_sorted(regionIds.begin(), regionIds.end()))
+    {
+      std::cerr << "The points are not ordered by region" << std::endl;
+      succeeded = false;
+    }
+  }
+
+  // Cell seeded regions grow through the cells in the scalar range
+  connectivity->SetFullScalarConnectivity(0);
+  connectivity->SetExtractionModeToCellSeededRegions();
+  connectivity->InitializeSeedList();
+  connectivity->AddSeed(0);
+  connectivity->AddSeed(input->GetNumberOfCells() - 1);
+  connectivity->Update();
+  const vtkIdType numSeededCells = connectivity->GetOutput()->GetNumberOfCells();
+  connectivity->Modified();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { connectivity->Update(); });
+  if (numSeededCells < 2 || numSeededCells != connectivity->GetOutput()->GetNumberOfCells() ||
+    numSeededCells != connectivity->GetRegionSizes()->GetValue(0))
+  {
+    std::cerr << "Unexpected seeded region of " << numSeededCells << " cells" << std::endl;
+    succeeded = false;
+  }
+
+  return succeeded;
+}
 }
 
 int TestPolyDataConnectivityFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
@@ -224,5 +346,10 @@ int TestPolyDataConnectivityFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[
     return EXIT_FAILURE;
   }
 
+  if (!RegionIdsIndependentOfThreads())
+  {
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
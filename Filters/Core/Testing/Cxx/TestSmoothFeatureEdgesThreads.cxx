@@ -0,0 +1,297 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkSmoothPolyDataFilter, vtkFeatureEdges and vtkTriangleFilter
+// generate the same output with any number of threads, and the cell data of
+// vtkTriangleFilter.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkTestSMPUtilities.h"
+#include "vtkTriangleFilter.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool CheckThreads(vtkPolyDataAlgorithm* filter, const char* description)
+{
+  if (!vtkTest::SamePolyDataOnOneThread(filter))
+  {
+    std::cerr << "The output of " << description << " depends on the number of threads"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// A bumpy sphere made of triangles, quads, hexagons and triangle strips, with
+// holes, a few non-manifold fins, lines and vertices.
+vtkSmartPointer<vtkPolyData> MakeSurface()
+{
+  const int nu = 120;
+  const int nv = 80;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int j = 0; j < nv; ++j)
+  {
+    for (int i = 0; i < nu; ++i)
+    {
+      const double u = 2.0 * vtkMath::Pi() * i / nu;
+      const double v = vtkMath::Pi() * (j + 0.5) / nv;
+      const double r = 1.0 + 0.1 * std::sin(5.0 * u) * std::sin(3.0 * v) + 0.01 * ((i * j) % 7);
+      points->InsertNextPoint(
+        r * std::cos(u) * std::sin(v), r * std::sin(u) * std::sin(v), r * std::cos(v));
+    }
+  }
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  for (int j = 0; j + 1 < nv; ++j)
+  {
+    for (int i = 0; i < nu; ++i)
+    {
+      const vtkIdType p0 = j * nu + i;
+      const vtkIdType p1 = j * nu + (i + 1) % nu;
+      const vtkIdType quad[4] = { p0, p1, p1 + nu, p0 + nu };
+      if ((3 * i + 5 * j) % 41 == 0)
+      {
+        continue; // hole
+      }
+      if (j % 5 == 0)
+      {
+        const vtkIdType strip[4] = { p0, p0 + nu, p1, p1 + nu };
+        strips->InsertNextCell(4, strip);
+      }
+      else if (j % 5 == 2 && i % 2 == 0 && i + 2 < nu)
+      {
+        const vtkIdType hexagon[6] = { p0, p0 + 1, p0 + 2, p0 + nu + 2, p0 + nu + 1, p0 + nu };
+        polys->InsertNextCell(6, hexagon);
+      }
+      else if (j % 5 == 2)
+      {
+        continue; // covered by a hexagon
+      }
+      else if ((i + j) % 17 == 0)
+      {
+        polys->InsertNextCell(4, quad);
+      }
+      else
+      {
+        const vtkIdType triangle0[3] = { quad[0], quad[1], quad[2] };
+        const vtkIdType triangle1[3] = { quad[0], quad[2], quad[3] };
+        polys->InsertNextCell(3, triangle0);
+        polys->InsertNextCell(3, triangle1);
+      }
+    }
+  }
+  for (int k = 0; k < 20; ++k)
+  {
+    const vtkIdType fin[3] = { 5 + 300 * k, 6 + 300 * k, 6000 - k };
+    polys->InsertNextCell(3, fin);
+    const vtkIdType line[4] = { 17 + 200 * k, 18 + 200 * k, 19 + 200 * k, 20 + 200 * k };
+    lines->InsertNextCell(4, line);
+    const vtkIdType vert = 333 * k;
+    verts->InsertNextCell(1, &vert);
+  }
+
+  vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+  surface->SetPoints(points);
+  surface->SetVerts(verts);
+  surface->SetLines(lines);
+  surface->SetPolys(polys);
+  surface->SetStrips(strips);
+  vtkNew<vtkDoubleArray> cellData;
+  cellData->SetName("CellData");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+  {
+    cellData->InsertNextValue(cellId);
+    ghosts->InsertNextValue(cellId % 23 == 0 ? vtkDataSetAttributes::DUPLICATECELL : 0);
+  }
+  surface->GetCellData()->AddArray(cellData);
+  surface->GetCellData()->AddArray(ghosts);
+  return surface;
+}
+
+// The surface with its polygons and strips triangulated, and either its
+// polylines or their segments. The cell data is the id of the cells.
+vtkSmartPointer<vtkPolyData> MakeTriangleSurface(vtkPolyData* surface, bool splitLines)
+{
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputData(surface);
+  triangles->Update();
+  vtkSmartPointer<vtkPolyData> triangleSurface = vtkSmartPointer<vtkPolyData>::New();
+  triangleSurface->SetPoints(surface->GetPoints());
+  triangleSurface->SetVerts(surface->GetVerts());
+  triangleSurface->SetLines(splitLines ? triangles->GetOutput()->GetLines() : surface->GetLines());
+  triangleSurface->SetPolys(triangles->GetOutput()->GetPolys());
+  vtkNew<vtkDoubleArray> cellData;
+  cellData->SetName("CellData");
+  for (vtkIdType cellId = 0; cellId < triangleSurface->GetNumberOfCells(); ++cellId)
+  {
+    cellData->InsertNextValue(cellId);
+  }
+  triangleSurface->GetCellData()->AddArray(cellData);
+  return triangleSurface;
+}
+
+// Check that the cell data of the output cells from firstCellId on are the
+// ones of the input cells they come from, given by the CellData array.
+bool CheckCellData(vtkPolyData* input, vtkPolyData* output, vtkIdType firstCellId)
+{
+  vtkDataArray* inCellIds = output->GetCellData()->GetArray("CellData");
+  if (!inCellIds || inCellIds->GetNumberOfTuples() < output->GetNumberOfCells())
+  {
+    std::cerr << "Missing cell data in the output of vtkTriangleFilter" << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> inPtIds;
+  vtkNew<vtkIdList> outPtIds;
+  for (vtkIdType cellId = firstCellId; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inCellId = static_cast<vtkIdType>(inCellIds->GetComponent(cellId, 0));
+    input->GetCellPoints(inCellId, inPtIds);
+    output->GetCellPoints(cellId, outPtIds);
+    for (vtkIdType i = 0; i < outPtIds->GetNumberOfIds(); ++i)
+    {
+      if (inPtIds->IsId(outPtIds->GetId(i)) < 0)
+      {
+        std::cerr << "The cell data of the output cell " << cellId
+                  << " of vtkTriangleFilter are not the ones of its input cell" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Check the cells and the cell data of vtkTriangleFilter, with and without
+// passing the vertices and the lines.
+bool CheckTriangleFilter(vtkPolyData* input)
+{
+  bool success = true;
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputData(input);
+  for (int preservePolys = 0; preservePolys < 2; ++preservePolys)
+  {
+    for (int passVerts = 0; passVerts < 2; ++passVerts)
+    {
+      for (int passLines = 0; passLines < 2; ++passLines)
+      {
+        triangles->SetPreservePolys(preservePolys);
+        triangles->SetPassVerts(passVerts);
+        triangles->SetPassLines(passLines);
+        success &= CheckThreads(triangles, "vtkTriangleFilter");
+        vtkPolyData* output = triangles->GetOutput();
+
+        // The lines are only passed if asked, and split into segments
+        // unless the polygons are preserved.
+        if ((!passLines && output->GetNumberOfLines() > 0) ||
+          (passLines && !preservePolys && output->GetLines()->GetMaxCellSize() != 2))
+        {
+          std::cerr << "Unexpected lines in the output of vtkTriangleFilter" << std::endl;
+          success = false;
+        }
+
+        // With PreservePolys, the cell data of the vertices, lines and
+        // polygons are passed whether or not they are, so only the cell data
+        // of the triangles of the strips are checked when some are not.
+        vtkIdType firstCellId = 0;
+        if (preservePolys && (!passVerts || !passLines))
+        {
+          firstCellId = output->GetNumberOfVerts() + output->GetNumberOfLines() +
+            input->GetNumberOfPolys();
+        }
+        success &= CheckCellData(input, output, firstCellId);
+      }
+    }
+  }
+  return success;
+}
+
+// The largest distance between the points of two polydata
+double GetMaxDistance(vtkPolyData* polyData0, vtkPolyData* polyData1)
+{
+  double maxDistance = 0.0;
+  double x0[3], x1[3];
+  for (vtkIdType ptId = 0; ptId < polyData0->GetNumberOfPoints(); ++ptId)
+  {
+    polyData0->GetPoint(ptId, x0);
+    polyData1->GetPoint(ptId, x1);
+    maxDistance = std::max(maxDistance, std::sqrt(vtkMath::Distance2BetweenPoints(x0, x1)));
+  }
+  return maxDistance;
+}
+}
+
+int TestSmoothFeatureEdgesThreads(int, char*[])
+{
+  bool success = true;
+  vtkSmartPointer<vtkPolyData> surface = MakeSurface();
+
+  vtkNew<vtkSmoothPolyDataFilter> smoother;
+  smoother->SetInputData(surface);
+  smoother->SetNumberOfIterations(10);
+  smoother->SetRelaxationFactor(0.1);
+  smoother->GenerateErrorScalarsOn();
+  smoother->GenerateErrorVectorsOn();
+  for (int featureEdgeSmoothing = 0; featureEdgeSmoothing < 2; ++featureEdgeSmoothing)
+  {
+    smoother->SetFeatureEdgeSmoothing(featureEdgeSmoothing);
+    smoother->SetBoundarySmoothing(!featureEdgeSmoothing);
+    success &= CheckThreads(smoother, "vtkSmoothPolyDataFilter");
+  }
+
+  // The Jacobi iterations move the points in parallel, and smooth the surface
+  // almost as the default Gauss-Seidel iterations do, with or without a source.
+  for (int constrained = 0; constrained < 2; ++constrained)
+  {
+    smoother->SetSourceData(constrained ? surface.Get() : nullptr);
+    smoother->JacobiSmoothingOff();
+    vtkSmartPointer<vtkPolyData> gaussSeidel = vtkTest::UpdateAndCopy(smoother.Get());
+    smoother->JacobiSmoothingOn();
+    success &= CheckThreads(smoother, "vtkSmoothPolyDataFilter with Jacobi iterations");
+    const double moved = GetMaxDistance(surface, smoother->GetOutput());
+    const double difference = GetMaxDistance(gaussSeidel, smoother->GetOutput());
+    if (moved == 0.0 || difference > 0.5 * moved)
+    {
+      std::cerr << "Jacobi iterations moved the points by " << moved << " and by " << difference
+                << " from the Gauss-Seidel iterations" << std::endl;
+      success = false;
+    }
+    smoother->JacobiSmoothingOff();
+  }
+  smoother->SetSourceData(nullptr);
+
+  vtkNew<vtkFeatureEdges> featureEdges;
+  featureEdges->SetInputData(surface);
+  featureEdges->SetFeatureAngle(15.0);
+  featureEdges->ExtractAllEdgeTypesOn();
+  for (int removeGhostInterfaces = 0; removeGhostInterfaces < 2; ++removeGhostInterfaces)
+  {
+    featureEdges->SetRemoveGhostInterfaces(removeGhostInterfaces);
+    success &= CheckThreads(featureEdges, "vtkFeatureEdges");
+  }
+
+  success &= CheckTriangleFilter(surface);
+  success &= CheckTriangleFilter(MakeTriangleSurface(surface, true));
+  success &= CheckTriangleFilter(MakeTriangleSurface(surface, false));
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
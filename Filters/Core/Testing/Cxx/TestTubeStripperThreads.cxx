@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkTubeFilter and vtkStripper generate the same output with any
+// number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStripper.h"
+#include "vtkTestSMPUtilities.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool CheckThreads(vtkPolyDataAlgorithm* filter, const char* description)
+{
+  if (!vtkTest::SamePolyDataOnOneThread(filter))
+  {
+    std::cerr << "The output of " << description << " depends on the number of threads"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Streamline-like polylines. Some of them are closed, and some share a
+// point with the previous one.
+vtkSmartPointer<vtkPolyData> MakeStreamlines()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkDoubleArray> lineData;
+  lineData->SetName("LineData");
+  std::vector<vtkIdType> ptIds;
+  for (int line = 0; line < 500; ++line)
+  {
+    ptIds.clear();
+    for (int i = 0; i < 20; ++i)
+    {
+      const double t = 0.1 * i;
+      ptIds.push_back(points->InsertNextPoint(
+        std::cos(t + line), std::sin(1.3 * t + line), t + 0.01 * line));
+      scalars->InsertNextValue(1.0 + std::sin(t * line));
+      vectors->InsertNextTuple3(1.0 + t, std::cos(line), 0.5);
+    }
+    if (line % 5 == 1)
+    {
+      ptIds.push_back(ptIds[0]);
+    }
+    if (line % 7 == 2)
+    {
+      ptIds[3] = ptIds[0] - 5;
+    }
+    lines->InsertNextCell(static_cast<vtkIdType>(ptIds.size()), ptIds.data());
+    lineData->InsertNextValue(line);
+  }
+
+  vtkSmartPointer<vtkPolyData> streamlines = vtkSmartPointer<vtkPolyData>::New();
+  streamlines->SetPoints(points);
+  streamlines->SetLines(lines);
+  streamlines->GetPointData()->SetScalars(scalars);
+  streamlines->GetPointData()->SetVectors(vectors);
+  streamlines->GetCellData()->AddArray(lineData);
+  return streamlines;
+}
+
+// Separate patches of triangles and quads, and line segments along the rows
+vtkSmartPointer<vtkPolyData> MakeSegmentsAndTriangles()
+{
+  const int dim = 80;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j + 1 < dim; ++j)
+  {
+    for (int i = 0; i + 1 < dim; ++i)
+    {
+      const vtkIdType p0 = j * dim + i;
+      const vtkIdType quad[4] = { p0, p0 + 1, p0 + dim + 1, p0 + dim };
+      if (j % 4 == 0)
+      {
+        if (i % 9 != 8)
+        {
+          lines->InsertNextCell(2, (i % 2) ? quad : quad + 1);
+        }
+      }
+      else if (i % 6 != 5 && j % 4 != 3)
+      {
+        if ((i + j) % 11 == 0)
+        {
+          polys->InsertNextCell(4, quad);
+        }
+        else
+        {
+          const vtkIdType triangle0[3] = { quad[0], quad[1], quad[2] };
+          const vtkIdType triangle1[3] = { quad[0], quad[2], quad[3] };
+          polys->InsertNextCell(3, triangle0);
+          polys->InsertNextCell(3, triangle1);
+        }
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->SetPoints(points);
+  mesh->SetLines(lines);
+  mesh->SetPolys(polys);
+  vtkNew<vtkDoubleArray> cellData;
+  cellData->SetName("CellData");
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    cellData->InsertNextValue(cellId);
+  }
+  mesh->GetCellData()->AddArray(cellData);
+  return mesh;
+}
+}
+
+int TestTubeStripperThreads(int, char*[])
+{
+  bool success = true;
+
+  vtkSmartPointer<vtkPolyData> streamlines = MakeStreamlines();
+  vtkNew<vtkTubeFilter> tubes;
+  tubes->SetInputData(streamlines);
+  tubes->SetRadius(0.02);
+  tubes->SetNumberOfSides(7);
+  for (int varyRadius : { VTK_VARY_RADIUS_OFF, VTK_VARY_RADIUS_BY_SCALAR,
+         VTK_VARY_RADIUS_BY_VECTOR, VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR })
+  {
+    tubes->SetVaryRadius(varyRadius);
+    tubes->SetCapping(varyRadius % 2);
+    tubes->SetSidesShareVertices(varyRadius < 2);
+    tubes->SetGenerateTCoords(varyRadius);
+    success &= CheckThreads(tubes, "vtkTubeFilter");
+  }
+
+  vtkSmartPointer<vtkPolyData> mesh = MakeSegmentsAndTriangles();
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputData(mesh);
+  stripper->PassCellDataAsFieldDataOn();
+  stripper->PassThroughCellIdsOn();
+  for (int maximumLength : { 1000, 6 })
+  {
+    stripper->SetMaximumLength(maximumLength);
+    stripper->SetJoinContiguousSegments(maximumLength < 10);
+    success &= CheckThreads(stripper, "vtkStripper");
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
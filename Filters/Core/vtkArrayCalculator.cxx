@@ -23,6 +23,9 @@
 #include "vtkTable.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkArrayCalculator);
@@ -94,6 +97,53 @@ typedef enum
 } ResultType;
 static ResultType resultType = SCALAR_RESULT;
 
+//------------------------------------------------------------------------------
+// Number of tuples evaluated at once by vtkFunctionParser::EvaluateBatch
+static const vtkIdType vtkArrayCalculatorBatchSize = 1024;
+
+//------------------------------------------------------------------------------
+// Copy the selected components of the tuples [begin, end) of an array to
+// interleaved values.
+struct vtkArrayCalculatorGatherWorker
+{
+  template <typename TArray>
+  void operator()(TArray* array, vtkIdType begin, vtkIdType end, const int* components,
+    int numberOfComponents, double* values) const
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    for (const auto tuple : tuples)
+    {
+      for (int c = 0; c < numberOfComponents; c++)
+      {
+        *values++ = static_cast<double>(tuple[components[c]]);
+      }
+    }
+  }
+};
+
+static void vtkArrayCalculatorGather(vtkDataArray* array, vtkIdType begin, vtkIdType end,
+  const int* components, int numberOfComponents, double* values)
+{
+  vtkArrayCalculatorGatherWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        array, worker, begin, end, components, numberOfComponents, values))
+  {
+    worker(array, begin, end, components, numberOfComponents, values);
+  }
+}
+
+//------------------------------------------------------------------------------
+// The values of the variables and the results of a batch of tuples
+struct vtkArrayCalculatorBatch
+{
+  std::vector<std::vector<double>> ScalarValues;
+  std::vector<std::vector<double>> VectorValues;
+  std::vector<double> Points;
+  std::vector<const double*> ScalarColumns;
+  std::vector<const double*> VectorColumns;
+  std::vector<double> Results;
+};
+
 //------------------------------------------------------------------------------
 template <typename TFunctionParser, typename TResultArray>
 class vtkArrayCalculatorFunctor
@@ -135,6 +185,7 @@ private:
   // // thread local
   vtkSMPThreadLocal<vtkSmartPointer<TFunctionParser>> FunctionParser;
   vtkSMPThreadLocal<std::vector<double>> Tuple;
+  vtkSMPThreadLocal<vtkArrayCalculatorBatch> Batch;
   int MaxTupleSize;
 
 public:
@@ -317,9 +368,17 @@ public:
   }
 
   void operator()(vtkIdType begin, vtkIdType end)
+  {
+    this->Evaluate(this->FunctionParser.Local().Get(), begin, end);
+  }
+
+  /**
+   * Evaluate the function one tuple at a time.
+   */
+  template <typename TParser>
+  void Evaluate(TParser* functionParser, vtkIdType begin, vtkIdType end)
   {
     auto resultArrayItr = vtk::DataArrayTupleRange(this->ResultArray, begin, end).begin();
-    auto& functionParser = this->FunctionParser.Local();
     auto tuple = this->Tuple.Local().data();
     vtkDataArray* currentArray;
     int j = 0;
@@ -385,6 +444,133 @@ public:
     }
   }
 
+  /**
+   * Evaluate the function over batches of tuples with
+   * vtkFunctionParser::EvaluateBatch. The values of the variables are copied
+   * from the arrays a batch at a time, and each operation of the function is
+   * applied to the whole batch. Batches for which the function is invalid,
+   * while invalid values are not replaced, are evaluated one tuple at a time
+   * to report the errors as before.
+   */
+  void Evaluate(vtkFunctionParser* functionParser, vtkIdType begin, vtkIdType end)
+  {
+    vtkArrayCalculatorBatch& batch = this->Batch.Local();
+    const int numScalarVariables = functionParser->GetNumberOfScalarVariables();
+    const int numVectorVariables = functionParser->GetNumberOfVectorVariables();
+    batch.ScalarValues.resize(this->ScalarArrayNamesSize + this->CoordinateScalarVariableNamesSize);
+    batch.VectorValues.resize(this->VectorArrayNamesSize + this->CoordinateVectorVariableNamesSize);
+    batch.ScalarColumns.assign(numScalarVariables, nullptr);
+    batch.VectorColumns.assign(numVectorVariables, nullptr);
+    const int numResultComponents = resultType == SCALAR_RESULT ? 1 : 3;
+    batch.Results.resize(numResultComponents * vtkArrayCalculatorBatchSize);
+    const bool useCoordinates = (this->AttributeType == vtkDataObject::POINT ||
+                                  this->AttributeType == vtkDataObject::VERTEX) &&
+      (this->CoordinateScalarVariableNamesSize > 0 || this->CoordinateVectorVariableNamesSize > 0);
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(this->DsInput);
+    vtkDataArray* points =
+      pointSet && pointSet->GetPoints() ? pointSet->GetPoints()->GetData() : nullptr;
+    const int xyz[3] = { 0, 1, 2 };
+
+    for (vtkIdType batchBegin = begin; batchBegin < end; batchBegin += vtkArrayCalculatorBatchSize)
+    {
+      const vtkIdType batchEnd = std::min(end, batchBegin + vtkArrayCalculatorBatchSize);
+      const vtkIdType numTuples = batchEnd - batchBegin;
+
+      for (int j = 0; j < this->ScalarArrayNamesSize; j++)
+      {
+        if (vtkDataArray* currentArray = this->ScalarArrays[j])
+        {
+          std::vector<double>& values = batch.ScalarValues[j];
+          values.resize(numTuples);
+          vtkArrayCalculatorGather(currentArray, batchBegin, batchEnd,
+            &this->SelectedScalarComponents[j], 1, values.data());
+          batch.ScalarColumns[this->ScalarArrayIndices[j]] = values.data();
+        }
+      }
+      for (int j = 0; j < this->VectorArrayNamesSize; j++)
+      {
+        if (vtkDataArray* currentArray = this->VectorArrays[j])
+        {
+          std::vector<double>& values = batch.VectorValues[j];
+          values.resize(3 * numTuples);
+          vtkArrayCalculatorGather(currentArray, batchBegin, batchEnd,
+            this->SelectedVectorComponents[j].GetData(), 3, values.data());
+          batch.VectorColumns[this->VectorArrayIndices[j]] = values.data();
+        }
+      }
+      if (useCoordinates)
+      {
+        batch.Points.resize(3 * numTuples);
+        if (points)
+        {
+          vtkArrayCalculatorGather(points, batchBegin, batchEnd, xyz, 3, batch.Points.data());
+        }
+        else
+        {
+          for (vtkIdType i = batchBegin; i < batchEnd; i++)
+          {
+            double* pt = batch.Points.data() + 3 * (i - batchBegin);
+            if (this->DsInput)
+            {
+              this->DsInput->GetPoint(i, pt);
+            }
+            else
+            {
+              this->GraphInput->GetPoint(i, pt);
+            }
+          }
+        }
+        for (int j = 0; j < this->CoordinateScalarVariableNamesSize; j++)
+        {
+          std::vector<double>& values = batch.ScalarValues[this->ScalarArrayNamesSize + j];
+          values.resize(numTuples);
+          const int component = this->SelectedCoordinateScalarComponents[j];
+          for (vtkIdType i = 0; i < numTuples; i++)
+          {
+            values[i] = batch.Points[3 * i + component];
+          }
+          if (j + this->ScalarArrayNamesSize < numScalarVariables)
+          {
+            batch.ScalarColumns[j + this->ScalarArrayNamesSize] = values.data();
+          }
+        }
+        for (int j = 0; j < this->CoordinateVectorVariableNamesSize; j++)
+        {
+          std::vector<double>& values = batch.VectorValues[this->VectorArrayNamesSize + j];
+          values.resize(3 * numTuples);
+          const vtkTuple<int, 3>& components = this->SelectedCoordinateVectorComponents[j];
+          for (vtkIdType i = 0; i < numTuples; i++)
+          {
+            for (int c = 0; c < 3; c++)
+            {
+              values[3 * i + c] = batch.Points[3 * i + components[c]];
+            }
+          }
+          if (j + this->VectorArrayNamesSize < numVectorVariables)
+          {
+            batch.VectorColumns[j + this->VectorArrayNamesSize] = values.data();
+          }
+        }
+      }
+
+      if (!functionParser->EvaluateBatch(numTuples, batch.ScalarColumns.data(),
+            batch.VectorColumns.data(), batch.Results.data()))
+      {
+        this->Evaluate<vtkFunctionParser>(functionParser, batchBegin, batchEnd);
+        continue;
+      }
+
+      const double* result = batch.Results.data();
+      for (auto resultTuple : vtk::DataArrayTupleRange(this->ResultArray, batchBegin, batchEnd))
+      {
+        for (int c = 0; c < numResultComponents; c++)
+        {
+          resultTuple[c] = *result++;
+        }
+      }
+    }
+  }
+
   void Reduce() {}
 };
 
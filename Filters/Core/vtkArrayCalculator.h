@@ -51,6 +51,12 @@
  * tuple-wise (i.e., tuple-by-tuple). The user must specify which arrays to use as
  * vectors and/or scalars, and the name of the output data array.
  *
+ * With vtkFunctionParser, the function is evaluated over batches of tuples
+ * with vtkFunctionParser::EvaluateBatch: the values of the variables are read
+ * from the arrays a batch at a time, and each operation of the function is
+ * applied to a whole batch. The results are the same as when the tuples are
+ * evaluated one at a time.
+ *
  * @sa
  * For more detailed documentation of the supported functionality see:
  * 1) vtkFunctionParser
@@ -0,0 +1,403 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConnectedRegionsInternal
+ * @brief   label the regions of connected cells of a dataset in parallel
+ *
+ * vtkConnectedRegionsInternal labels the regions of cells sharing points for
+ * vtkConnectivityFilter and vtkPolyDataConnectivityFilter. The qualifying
+ * cells (all the cells, or with scalar connectivity the cells whose scalars
+ * fall in the scalar range) are joined to their points in a lock-free
+ * union-find over the cells and the points, where each component is rooted at
+ * its smallest cell id. The regions are then numbered by a sweep over the
+ * cells which reproduces the wave propagation of the serial algorithm: a
+ * region starts at the first cell not yet labeled, and grows through the
+ * qualifying cells sharing a point with its cells. Hence the RegionIds are
+ * the ones of the serial algorithm, whatever the number of threads.
+ *
+ * The points used by the labeled cells are numbered by region, and by
+ * increasing id within a region. A point used by cells of several regions
+ * belongs to the first one.
+ *
+ * vtkStripper only uses the union-find, to strip the regions independently.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter vtkStripper
+ */
+
+#ifndef vtkConnectedRegionsInternal_h
+#define vtkConnectedRegionsInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+class vtkConnectedRegions
+{
+public:
+  vtkConnectedRegions(vtkDataSet* input, vtkAlgorithm* filter)
+    : Input(input)
+    , Filter(filter)
+    , NumberOfCells(input->GetNumberOfCells())
+    , NumberOfPoints(input->GetNumberOfPoints())
+    , Parent(new std::atomic<vtkIdType>[input->GetNumberOfCells() + input->GetNumberOfPoints()])
+  {
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellPoints
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkNew<vtkIdList> ptIds;
+    input->GetCellPoints(0, npts, pts, ptIds);
+  }
+
+  /**
+   * Only connect the cells whose scalars fall in the given range: one of the
+   * scalars of their points, or all of them with allInRange. The first
+   * component of the scalars is compared in single precision, as the serial
+   * algorithm does.
+   */
+  void QualifyCells(vtkDataArray* scalars, const double range[2], bool allInRange)
+  {
+    this->Qualified.resize(this->NumberOfCells);
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        double cellRange[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const double s = static_cast<float>(scalars->GetComponent(pts[i], 0));
+          cellRange[0] = std::min(cellRange[0], s);
+          cellRange[1] = std::max(cellRange[1], s);
+        }
+        this->Qualified[cellId] = allInRange
+          ? (cellRange[0] >= range[0] && cellRange[1] <= range[1])
+          : (cellRange[1] >= range[0] && cellRange[0] <= range[1]);
+      }
+    });
+  }
+
+  /**
+   * Join the qualifying cells to their points. Each node of the union-find
+   * ends up pointing to the root of its component.
+   */
+  void Connect()
+  {
+    const vtkIdType numNodes = this->NumberOfCells + this->NumberOfPoints;
+    vtkSMPTools::For(0, numNodes, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType node = begin; node < end; ++node)
+      {
+        this->Parent[node] = node;
+      }
+    });
+
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType begin, vtkIdType end) {
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (cellId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->Filter->CheckAbort();
+          }
+          if (this->Filter->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        if (this->IsQualified(cellId))
+        {
+          this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            this->Union(cellId, this->NumberOfCells + pts[i]);
+          }
+        }
+      }
+    });
+
+    vtkSMPTools::For(0, numNodes, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType node = begin; node < end; ++node)
+      {
+        this->Parent[node] = this->Find(node);
+      }
+    });
+  }
+
+  /**
+   * Return the smallest id of the cells connected to the given cell.
+   * Connect() must have been called first.
+   */
+  vtkIdType GetRoot(vtkIdType cellId) const { return this->Parent[cellId]; }
+
+  /**
+   * Label all the cells with their region number, in the order of the serial
+   * algorithm. Fill the number of cells of each region in regionSizes, and
+   * return the number of regions.
+   */
+  vtkIdType LabelAllRegions(vtkIdType* regions, vtkIdTypeArray* regionSizes)
+  {
+    std::vector<vtkIdType> regionOfRoot(this->NumberOfCells, -1);
+    std::vector<vtkIdType> sizes;
+    vtkNew<vtkIdList> ptIds;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    const vtkIdType checkAbortInterval = std::min(this->NumberOfCells / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0 && this->Filter->CheckAbort())
+      {
+        std::fill(regions + cellId, regions + this->NumberOfCells, -1);
+        break;
+      }
+      if (this->IsQualified(cellId))
+      {
+        vtkIdType& region = regionOfRoot[this->Parent[cellId]];
+        if (region < 0)
+        {
+          region = static_cast<vtkIdType>(sizes.size());
+          sizes.push_back(0);
+        }
+        regions[cellId] = region;
+      }
+      else
+      {
+        // A cell which does not qualify starts its own region, which grows
+        // through the qualifying cells around it.
+        const vtkIdType region = static_cast<vtkIdType>(sizes.size());
+        sizes.push_back(0);
+        regions[cellId] = region;
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType root = this->Parent[this->NumberOfCells + pts[i]];
+          if (root < this->NumberOfCells && regionOfRoot[root] < 0)
+          {
+            regionOfRoot[root] = region;
+          }
+        }
+      }
+      ++sizes[regions[cellId]];
+    }
+
+    regionSizes->SetNumberOfValues(static_cast<vtkIdType>(sizes.size()));
+    std::copy(sizes.begin(), sizes.end(), regionSizes->GetPointer(0));
+    return static_cast<vtkIdType>(sizes.size());
+  }
+
+  /**
+   * Label with region 0 the seed cells, and the qualifying cells connected
+   * to them. Other cells are labeled -1. Return the number of labeled cells.
+   */
+  vtkIdType LabelSeededRegion(const std::vector<unsigned char>& seeds, vtkIdType* regions)
+  {
+    std::vector<unsigned char> claimed(this->NumberOfCells, 0);
+    vtkNew<vtkIdList> ptIds;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
+    {
+      if (seeds[cellId])
+      {
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType root = this->Parent[this->NumberOfCells + pts[i]];
+          if (root < this->NumberOfCells)
+          {
+            claimed[root] = 1;
+          }
+        }
+      }
+    }
+
+    vtkIdType numCellsInRegion = 0;
+    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
+    {
+      const bool inRegion = seeds[cellId] ||
+        (this->IsQualified(cellId) && claimed[this->Parent[cellId]]);
+      regions[cellId] = inRegion ? 0 : -1;
+      numCellsInRegion += inRegion ? 1 : 0;
+    }
+    return numCellsInRegion;
+  }
+
+  /**
+   * Mark in cells the cells using one of the given points.
+   */
+  void MarkCellsUsingPoints(
+    const std::vector<unsigned char>& points, std::vector<unsigned char>& cells)
+  {
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        for (vtkIdType i = 0; i < npts && !cells[cellId]; ++i)
+        {
+          cells[cellId] = points[pts[i]];
+        }
+      }
+    });
+  }
+
+  /**
+   * Number the points of the labeled cells by region, then by increasing
+   * point id. Fill pointMap with the new point ids (-1 for the unused points)
+   * and pointRegions with the region of each new point. Return the number of
+   * new points.
+   */
+  vtkIdType MapPoints(
+    const vtkIdType* regions, vtkIdType numRegions, vtkIdType* pointMap, vtkIdType* pointRegions)
+  {
+    // The region of a point is the smallest region of the cells using it
+    std::unique_ptr<std::atomic<vtkIdType>[]> regionOfPoint(
+      new std::atomic<vtkIdType>[this->NumberOfPoints]);
+    vtkSMPTools::For(0, this->NumberOfPoints, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        regionOfPoint[ptId] = numRegions;
+      }
+    });
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType region = regions[cellId];
+        if (region < 0)
+        {
+          continue;
+        }
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          std::atomic<vtkIdType>& pointRegion = regionOfPoint[pts[i]];
+          vtkIdType current = pointRegion;
+          while (region < current && !pointRegion.compare_exchange_weak(current, region))
+          {
+          }
+        }
+      }
+    });
+
+    std::vector<vtkIdType> offsets(numRegions + 1, 0);
+    for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+    {
+      ++offsets[regionOfPoint[ptId]];
+    }
+    vtkIdType numNewPts = 0;
+    for (vtkIdType region = 0; region < numRegions; ++region)
+    {
+      const vtkIdType count = offsets[region];
+      offsets[region] = numNewPts;
+      numNewPts += count;
+    }
+    for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+    {
+      const vtkIdType region = regionOfPoint[ptId];
+      if (region < numRegions)
+      {
+        pointMap[ptId] = offsets[region]++;
+        pointRegions[pointMap[ptId]] = region;
+      }
+      else
+      {
+        pointMap[ptId] = -1;
+      }
+    }
+    return numNewPts;
+  }
+
+private:
+  bool IsQualified(vtkIdType cellId) const
+  {
+    return this->Qualified.empty() || this->Qualified[cellId];
+  }
+
+  // Find the root of a node, halving its path on the way
+  vtkIdType Find(vtkIdType node)
+  {
+    vtkIdType parent = this->Parent[node];
+    while (parent != node)
+    {
+      vtkIdType grandParent = this->Parent[parent];
+      if (grandParent != parent)
+      {
+        vtkIdType expected = parent;
+        this->Parent[node].compare_exchange_weak(expected, grandParent);
+      }
+      node = grandParent;
+      parent = this->Parent[node];
+    }
+    return node;
+  }
+
+  // Link the larger root under the smaller one, so that the root of a
+  // component is its smallest node whatever the order of the unions.
+  void Union(vtkIdType node0, vtkIdType node1)
+  {
+    for (;;)
+    {
+      vtkIdType root0 = this->Find(node0);
+      vtkIdType root1 = this->Find(node1);
+      if (root0 == root1)
+      {
+        return;
+      }
+      if (root0 < root1)
+      {
+        std::swap(root0, root1);
+      }
+      vtkIdType expected = root0;
+      if (this->Parent[root0].compare_exchange_strong(expected, root1))
+      {
+        return;
+      }
+    }
+  }
+
+  vtkDataSet* Input;
+  vtkAlgorithm* Filter;
+  const vtkIdType NumberOfCells;
+  const vtkIdType NumberOfPoints;
+  // The union-find over the cells, then the points
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parent;
+  std::vector<unsigned char> Qualified;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+};
+
+} // anonymous namespace
+
+#endif // vtkConnectedRegionsInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectedRegionsInternal.h
@@ -1,9 +1,14 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkConnectivityFilter.h"
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -19,7 +24,9 @@
 #include "vtkToImplicitTypeErasureStrategy.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -103,7 +110,7 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* pdOutput = vtkPolyData::SafeDownCast(output);
   vtkUnstructuredGrid* ugOutput = vtkUnstructuredGrid::SafeDownCast(output);
 
-  vtkIdType numPts, numCells, cellId, i, j, pt;
+  vtkIdType numPts, numCells, cellId, i, pt;
   vtkPoints* newPts;
   vtkIdType id;
   vtkIdType maxCellsInRegion;
@@ -150,15 +157,7 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   this->RegionSizes->Reset();
   this->Visited = new vtkIdType[numCells];
-  for (i = 0; i < numCells; i++)
-  {
-    this->Visited[i] = -1;
-  }
   this->PointMap = new vtkIdType[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->PointMap[i] = -1;
-  }
 
   this->NewScalars->SetName("RegionId");
   this->NewScalars->SetNumberOfTuples(numPts);
@@ -192,21 +191,21 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   newPts->Allocate(numPts);
 
-  // Traverse all cells marking those visited.  Each new search
-  // starts a new connected region. Connected region grows
-  // using a connected wave propagation.
+  // Join the cells sharing points and meeting the connectivity criterion,
+  // then number the regions in the order of a wave propagation started from
+  // each cell not yet visited.
   //
-  this->Wave = vtkIdList::New();
-  this->Wave->Allocate(numPts / 4 + 1, numPts);
-  this->Wave2 = vtkIdList::New();
-  this->Wave2->Allocate(numPts / 4 + 1, numPts);
+  vtkConnectedRegions regions(input, this);
+  if (this->InScalars)
+  {
+    regions.QualifyCells(this->InScalars, this->ScalarRange, false);
+  }
+  regions.Connect();
+  this->UpdateProgress(0.5);
 
-  this->PointNumber = 0;
   this->RegionNumber = 0;
   maxCellsInRegion = 0;
 
-  this->CellIds = vtkIdList::New();
-  this->CellIds->Allocate(8, VTK_CELL_SIZE);
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
@@ -214,73 +213,41 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    this->RegionNumber = regions.LabelAllRegions(this->Visited, this->RegionSizes);
+    for (i = 0; i < this->RegionNumber; i++)
     {
-      if (cellId && !(cellId % 5000))
+      if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
       {
-        if (this->CheckAbort())
-        {
-          break;
-        }
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
-      {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        maxCellsInRegion = this->RegionSizes->GetValue(i);
+        largestRegionId = i;
       }
     }
   }
   else // regions have been seeded, everything considered in same region
   {
-    this->NumCellsInRegion = 0;
-    int checkAbortInterval = 0;
+    std::vector<unsigned char> seedCells(numCells, 0);
+    std::vector<unsigned char> seedPoints;
 
     if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
     {
-      checkAbortInterval = std::min(this->Seeds->GetNumberOfIds() / 10 + 1, (vtkIdType)1000);
+      seedPoints.resize(numPts, 0);
       for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
       {
-        if (i % checkAbortInterval == 0 && this->CheckAbort())
-        {
-          break;
-        }
         pt = this->Seeds->GetId(i);
-        if (pt >= 0)
+        if (pt >= 0 && pt < numPts)
         {
-          input->GetPointCells(pt, this->CellIds);
-          for (j = 0; j < this->CellIds->GetNumberOfIds(); j++)
-          {
-            this->Wave->InsertNextId(this->CellIds->GetId(j));
-          }
+          seedPoints[pt] = 1;
         }
       }
     }
     else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
     {
-      checkAbortInterval = std::min(this->Seeds->GetNumberOfIds() / 10 + 1, (vtkIdType)1000);
       for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
       {
-        if (i % checkAbortInterval == 0 && this->CheckAbort())
-        {
-          break;
-        }
         cellId = this->Seeds->GetId(i);
-        if (cellId >= 0)
+        if (cellId >= 0 && cellId < numCells)
         {
-          this->Wave->InsertNextId(cellId);
+          seedCells[cellId] = 1;
         }
       }
     }
@@ -288,7 +255,7 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     { // loop over points, find closest one
       double minDist2, dist2, x[3];
       vtkIdType minId = 0;
-      checkAbortInterval = std::min(numPts / 10 + 1, (vtkIdType)1000);
+      int checkAbortInterval = std::min(numPts / 10 + 1, (vtkIdType)1000);
       for (minDist2 = VTK_DOUBLE_MAX, i = 0; i < numPts; i++)
       {
         if (i % checkAbortInterval == 0 && this->CheckAbort())
@@ -303,28 +270,27 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
           minDist2 = dist2;
         }
       }
-      input->GetPointCells(minId, this->CellIds);
-      checkAbortInterval = std::min(this->CellIds->GetNumberOfIds() / 10 + 1, (vtkIdType)1000);
-      for (j = 0; j < this->CellIds->GetNumberOfIds(); j++)
-      {
-        if (j % checkAbortInterval == 0 && this->CheckAbort())
-        {
-          break;
-        }
-        this->Wave->InsertNextId(this->CellIds->GetId(j));
-      }
+      seedPoints.resize(numPts, 0);
+      seedPoints[minId] = 1;
+    }
+    if (!seedPoints.empty())
+    {
+      regions.MarkCellsUsingPoints(seedPoints, seedCells);
     }
-    this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark(input);
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
-    this->UpdateProgress(0.9);
+    this->RegionSizes->InsertValue(
+      this->RegionNumber, regions.LabelSeededRegion(seedCells, this->Visited));
   }
+  this->UpdateProgress(0.9);
+
+  // Number the points of the visited cells region by region
+  vtkIdType numNewPts = regions.MapPoints(this->Visited, this->RegionSizes->GetNumberOfValues(),
+    this->PointMap, this->NewScalars->GetPointer(0));
+  this->NewScalars->SetNumberOfTuples(numNewPts);
+  std::copy(this->Visited, this->Visited + numCells, this->NewCellScalars->GetPointer(0));
 
   vtkDebugMacro(<< "Extracted " << this->RegionNumber << " region(s)");
-  this->Wave->Delete();
-  this->Wave2->Delete();
 
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
@@ -488,7 +454,6 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   delete[] this->Visited;
   delete[] this->PointMap;
   this->PointIds->Delete();
-  this->CellIds->Delete();
   output->Squeeze();
   vtkDataArray* outScalars = nullptr;
   if (this->ColorRegions && (outScalars = output->GetPointData()->GetScalars()))
@@ -38,6 +38,11 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * The regions are labeled in parallel with vtkSMPTools. Processing the cells
+ * in order, a region starts at the first cell not yet visited, so the
+ * RegionIds do not depend on the number of threads. The output points are
+ * ordered by region, then by increasing input point id.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -45,6 +50,7 @@
 #ifndef vtkConnectivityFilter_h
 #define vtkConnectivityFilter_h
 
+#include "vtkDeprecation.h"      // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPointSetAlgorithm.h"
 
@@ -266,6 +272,7 @@ protected:
    * Mark current cell as visited and assign region number.  Note:
    * traversal occurs across shared vertices.
    */
+  VTK_DEPRECATED_IN_9_4_0("The regions are labeled in parallel, without wave propagation.")
   void TraverseAndMark(vtkDataSet* input);
 
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
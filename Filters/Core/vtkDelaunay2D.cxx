@@ -352,39 +352,13 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   }
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPoints, i;
-  vtkIdType numTriangles = 0;
-  vtkIdType ptId, tri[4], nei[3];
-  vtkIdType p1 = 0;
-  vtkIdType p2 = 0;
-  vtkIdType p3 = 0;
+  vtkIdType numPoints;
   vtkPoints* inPoints;
-  vtkSmartPointer<vtkPoints> tPoints;
-  int ncells;
-  vtkIdType nodes[4][3];
-  const vtkIdType* neiPts;
-  const vtkIdType* triPts = nullptr;
-  vtkIdType numNeiPts;
-  vtkIdType npts = 0;
-  vtkIdType pts[3], swapPts[3];
-  vtkIdType tri1, tri2;
-  double center[3], radius, tol, x[3];
-  double n1[3], n2[3];
-  int* triUse = nullptr;
+  double radius, tol;
 
   vtkDebugMacro(<< "Generating 2D Delaunay triangulation");
 
-  if (this->Transform && this->BoundingTriangulation)
-  {
-    vtkWarningMacro(<< "Bounding triangulation cannot be used when an input transform is "
-                       "specified.  Output will not contain bounding triangulation.");
-  }
-
-  if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE && this->BoundingTriangulation)
-  {
-    vtkWarningMacro(<< "Bounding triangulation cannot be used when the best fitting plane option "
-                       "is on.  Output will not contain bounding triangulation.");
-  }
+  this->WarnIfNoBoundingTriangulation();
 
   // Initialize; check input
   //
@@ -400,15 +374,35 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  vtkNew<vtkIdList> neighbors;
-  neighbors->Allocate(2);
-  vtkNew<vtkIdList> cells;
-  cells->Allocate(64);
+  vtkSmartPointer<vtkPoints> points = this->CreateMeshPoints(input, radius, tol);
+  vtkSmartPointer<vtkPolyData> mesh = this->TriangulatePoints(points, numPoints, radius, tol);
+  return this->GenerateOutput(input, source, mesh, radius, output);
+}
 
-  this->NumberOfDuplicatePoints = 0;
-  this->NumberOfDegeneracies = 0;
+//------------------------------------------------------------------------------
+void vtkDelaunay2D::WarnIfNoBoundingTriangulation()
+{
+  if (this->Transform && this->BoundingTriangulation)
+  {
+    vtkWarningMacro(<< "Bounding triangulation cannot be used when an input transform is "
+                       "specified.  Output will not contain bounding triangulation.");
+  }
 
-  this->Mesh = vtkSmartPointer<vtkPolyData>::New();
+  if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE && this->BoundingTriangulation)
+  {
+    vtkWarningMacro(<< "Bounding triangulation cannot be used when the best fitting plane option "
+                       "is on.  Output will not contain bounding triangulation.");
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> vtkDelaunay2D::CreateMeshPoints(
+  vtkPointSet* input, double& radius, double& tol)
+{
+  vtkPoints* inPoints = input->GetPoints();
+  const vtkIdType numPoints = inPoints->GetNumberOfPoints();
+  vtkSmartPointer<vtkPoints> tPoints;
+  double center[3], x[3];
 
   // If the user specified a transform, apply it to the input data.
   //
@@ -439,9 +433,8 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Create initial bounding triangulation. Have to create bounding points.
-  // Initialize mesh structure.
   //
-  vtkNew<vtkPoints> points;
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
   // This will copy doubles to doubles if the input is double.
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(numPoints);
@@ -460,17 +453,42 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   center[2] = (bounds[4] + bounds[5]) / 2.0;
   tol = input->GetLength();
   radius = this->Offset * tol;
-  this->BoundingRadius2 = 4 * radius * radius; // use (2*r)**2
   tol *= this->Tolerance;
 
   // Add the eight bounding points to the end of the points list.
-  for (ptId = 0; ptId < 8; ptId++)
+  for (vtkIdType ptId = 0; ptId < 8; ptId++)
   {
     x[0] = center[0] + radius * cos(ptId * vtkMath::RadiansFromDegrees(45.0));
     x[1] = center[1] + radius * sin(ptId * vtkMath::RadiansFromDegrees(45.0));
     x[2] = center[2];
     points->InsertPoint(numPoints + ptId, x);
   }
+
+  return points;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkDelaunay2D::TriangulatePoints(
+  vtkPoints* points, vtkIdType numPoints, double radius, double tol)
+{
+  vtkIdType i, ptId, tri[4], nei[3];
+  vtkIdType p1 = 0;
+  vtkIdType p2 = 0;
+  vtkIdType nodes[4][3];
+  const vtkIdType* neiPts;
+  vtkIdType numNeiPts;
+  vtkIdType pts[3];
+  double x[3];
+
+  vtkNew<vtkIdList> neighbors;
+  neighbors->Allocate(2);
+
+  this->NumberOfDuplicatePoints = 0;
+  this->NumberOfDegeneracies = 0;
+  this->BoundingRadius2 = 4 * radius * radius; // use (2*r)**2
+
+  this->Mesh = vtkSmartPointer<vtkPolyData>::New();
+
   // We do this for speed accessing points
   this->Points = static_cast<vtkDoubleArray*>(points->GetData())->GetPointer(0);
 
@@ -634,6 +652,41 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
                   << " degenerate triangles encountered, mesh quality suspect");
   }
 
+  return this->Mesh;
+}
+
+//------------------------------------------------------------------------------
+int vtkDelaunay2D::GenerateOutput(
+  vtkPointSet* input, vtkPolyData* source, vtkPolyData* mesh, double radius, vtkPolyData* output)
+{
+  vtkPoints* inPoints = input->GetPoints();
+  vtkPoints* points = mesh->GetPoints();
+  vtkCellArray* triangles = mesh->GetPolys();
+  const vtkIdType numPoints = points->GetNumberOfPoints() - 8;
+  vtkIdType numTriangles = 0;
+  vtkIdType ptId, i;
+  vtkIdType p1 = 0;
+  vtkIdType p2 = 0;
+  vtkIdType p3 = 0;
+  int ncells;
+  const vtkIdType* neiPts;
+  const vtkIdType* triPts = nullptr;
+  vtkIdType npts = 0;
+  vtkIdType pts[3], swapPts[3];
+  vtkIdType tri1, tri2;
+  double center[3];
+  double n1[3], n2[3];
+  int* triUse = nullptr;
+
+  this->Mesh = mesh;
+  this->Points = static_cast<vtkDoubleArray*>(points->GetData())->GetPointer(0);
+  this->BoundingRadius2 = 4 * radius * radius; // use (2*r)**2
+
+  vtkNew<vtkIdList> neighbors;
+  neighbors->Allocate(2);
+  vtkNew<vtkIdList> cells;
+  cells->Allocate(64);
+
   // Finish up by recovering the boundary, or deleting all triangles connected
   // to the bounding triangulation points or not satisfying alpha criterion,
   if (!this->BoundingTriangulation || this->Alpha > 0.0 || source)
@@ -109,7 +109,7 @@
  * but the more likely you are to see numerical problems.
  *
  * @sa
- * vtkDelaunay3D vtkTransformFilter vtkGaussianSplatter
+ * vtkDelaunay3D vtkTransformFilter vtkGaussianSplatter vtkSMPDelaunay2D
  */
 
 #ifndef vtkDelaunay2D_h
@@ -122,6 +122,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
 class vtkIdList;
+class vtkPoints;
 class vtkPointSet;
 
 #define VTK_DELAUNAY_XY_PLANE 0
@@ -272,6 +273,37 @@ protected:
   int ProjectionPlaneMode; // selects the plane in 3D where the Delaunay triangulation will be
                            // computed.
 
+  /**
+   * Warn when BoundingTriangulation is requested but cannot be used, because
+   * of the Transform or of the ProjectionPlaneMode.
+   */
+  void WarnIfNoBoundingTriangulation();
+
+  /**
+   * Copy the input points in double precision, transformed as requested by
+   * Transform and ProjectionPlaneMode, followed by the eight bounding points.
+   * Also returns the radius of the bounding points and the distance below
+   * which points are considered duplicates.
+   */
+  vtkSmartPointer<vtkPoints> CreateMeshPoints(vtkPointSet* input, double& radius, double& tol);
+
+  /**
+   * Triangulate the first numPoints points, which must be followed by the
+   * eight bounding points of the given radius, as CreateMeshPoints() does.
+   * Returns the mesh of all triangles, with editable links.
+   */
+  vtkSmartPointer<vtkPolyData> TriangulatePoints(
+    vtkPoints* points, vtkIdType numPoints, double radius, double tol);
+
+  /**
+   * Recover the edges of the source (if any) in a mesh built by
+   * TriangulatePoints(), and send its triangles to the output, applying the
+   * alpha criterion and the BoundingTriangulation setting. Returns 0 on
+   * error.
+   */
+  int GenerateOutput(vtkPointSet* input, vtkPolyData* source, vtkPolyData* mesh, double radius,
+    vtkPolyData* output);
+
 private:
   vtkSmartPointer<vtkPolyData> Mesh; // the created mesh
 
@@ -427,10 +427,7 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* points;
   vtkUnstructuredGrid* Mesh;
   double x[3];
-  vtkIdType npts;
-  const vtkIdType* tetraPts;
-  vtkIdType pts[4];
-  vtkIdList *cells, *holeTetras;
+  vtkIdList* holeTetras;
   double center[3], tol;
   char* tetraUse;
 
@@ -451,8 +448,6 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  cells = vtkIdList::New();
-  cells->Allocate(64);
   holeTetras = vtkIdList::New();
   holeTetras->Allocate(12);
 
@@ -529,6 +524,45 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     tetraUse[holeTetras->GetId(i)] = 0; // mark as deleted
   }
 
+  double* radii2 = nullptr;
+  if (this->Alpha > 0.0)
+  {
+    radii2 = new double[numTetras];
+    for (i = 0; i < numTetras; i++)
+    {
+      radii2[i] = tetraUse[i] ? this->TetraArray->GetTetra(i)->r2 : 0.0;
+    }
+  }
+
+  this->GenerateOutput(input, Mesh, numPoints, tetraUse, radii2, output);
+
+  delete[] radii2;
+  delete[] tetraUse;
+  holeTetras->Delete();
+
+  Mesh->Delete();
+
+  output->Squeeze();
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+// Send the tetrahedra in use to the output, applying the bounding
+// triangulation and alpha criteria. This is shared with subclasses that
+// build the triangulation differently.
+void vtkDelaunay3D::GenerateOutput(vtkPointSet* input, vtkUnstructuredGrid* Mesh,
+  vtkIdType numPoints, char* tetraUse, const double* radii2, vtkUnstructuredGrid* output)
+{
+  vtkPoints* inPoints = input->GetPoints();
+  vtkPoints* points = Mesh->GetPoints();
+  vtkIdType numTetras = Mesh->GetNumberOfCells();
+  vtkIdType ptId, i, npts;
+  const vtkIdType* tetraPts;
+  vtkIdType pts[4];
+  vtkIdList* cells = vtkIdList::New();
+  cells->Allocate(64);
+
   // if boundary triangulation not desired, delete tetras connected to
   // boundary points
   if (!this->BoundingTriangulation)
@@ -554,7 +588,6 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     vtkIdType p1, p2, p3, nei;
     int hasNei, j, k;
     double x1[3], x2[3], x3[3];
-    vtkDelaunayTetra* tetra;
     static const int edge[6][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 0, 3 }, { 1, 3 }, { 2, 3 } };
 
     edges = vtkEdgeTable::New();
@@ -574,8 +607,7 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
         // check tetras
         if (tetraUse[i] == 2) // if not deleted
         {
-          tetra = this->TetraArray->GetTetra(i);
-          if (tetra->r2 > alpha2)
+          if (radii2[i] > alpha2)
           {
             tetraUse[i] = 1; // mark as visited and discarded
           }
@@ -749,15 +781,7 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
                 << output->GetNumberOfCells() << " tetrahedra");
 
-  delete[] tetraUse;
   cells->Delete();
-  holeTetras->Delete();
-
-  Mesh->Delete();
-
-  output->Squeeze();
-
-  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -76,7 +76,7 @@
  * not be found and the point will be rejected.
  *
  * @sa
- * vtkDelaunay2D vtkGaussianSplatter vtkUnstructuredGrid
+ * vtkDelaunay2D vtkGaussianSplatter vtkUnstructuredGrid vtkSMPDelaunay3D
  */
 
 #ifndef vtkDelaunay3D_h
@@ -284,6 +284,17 @@ protected:
   vtkIdType FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Mesh, vtkIdList* tetras,
     vtkIdList* faces, vtkIncrementalPointLocator* Locator);
 
+  /**
+   * Send the tetrahedra of Mesh to the output, applying the alpha criterion
+   * and the BoundingTriangulation setting. The first numPoints points of Mesh
+   * are the input points and the next six the bounding octahedron. Tetras
+   * with a tetraUse value of 0 are ignored, the others must be set to 2;
+   * tetraUse is modified. radii2 holds the squared circumsphere radius of
+   * each tetra and is only accessed when Alpha is non-zero.
+   */
+  void GenerateOutput(vtkPointSet* input, vtkUnstructuredGrid* Mesh, vtkIdType numPoints,
+    char* tetraUse, const double* radii2, vtkUnstructuredGrid* output);
+
   int FillInputPortInformation(int, vtkInformation*) override;
 
 private:                    // members added for performance
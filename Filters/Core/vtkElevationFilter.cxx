@@ -15,6 +15,7 @@
 #include "vtkPointSet.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkElevationFilter);
@@ -143,6 +144,18 @@ void vtkElevationFilter::PrintSelf(ostream& os, vtkIndent indent)
      << ")\n";
 }
 
+//------------------------------------------------------------------------------
+int vtkElevationFilter::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  // Only the points of the input are used, its arrays are passed
+  info->Set(vtkStreamingDemandDrivenPipeline::PROPAGATE_ARRAY_REQUESTS(), 1);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkElevationFilter::RequestData(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
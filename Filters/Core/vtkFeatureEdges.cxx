@@ -15,11 +15,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkFeatureEdges);
@@ -28,6 +32,17 @@ namespace
 {
 constexpr unsigned char CELL_NOT_VISIBLE =
   vtkDataSetAttributes::HIDDENCELL | vtkDataSetAttributes::DUPLICATECELL;
+
+// Type of the edges of the polygons, as classified in parallel before the
+// extracted edges are generated.
+enum EdgeType : unsigned char
+{
+  NOT_EXTRACTED = 0,
+  BOUNDARY_EDGE,
+  NON_MANIFOLD_EDGE,
+  FEATURE_EDGE,
+  MANIFOLD_EDGE
+};
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -79,17 +94,15 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   vtkCellArray* newLines;
   vtkPolyData* Mesh;
   int i;
-  vtkIdType j, numNei;
   vtkIdType numBEdges, numNonManifoldEdges, numFedges, numManifoldEdges;
-  double scalar, n[3], x1[3], x2[3];
+  double scalar, x1[3], x2[3];
   double cosAngle = 0;
   vtkIdType lineIds[2];
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
   vtkCellArray *inPolys, *inStrips, *newPolys;
   vtkFloatArray* polyNormals = nullptr;
-  vtkIdType numPts, numCells, numPolys, numStrips, numLines, nei;
-  vtkIdList* neighbors;
+  vtkIdType numPts, numCells, numPolys, numStrips, numLines;
   vtkIdType p1, p2, newId;
   vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
   vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
@@ -257,21 +270,26 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   {
     polyNormals = vtkFloatArray::New();
     polyNormals->SetNumberOfComponents(3);
-    polyNormals->Allocate(3 * newPolys->GetNumberOfCells());
-
-    vtkIdType cellId;
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-    {
-      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-      polyNormals->InsertTuple(cellId, n);
-    }
+    polyNormals->SetNumberOfTuples(newPolys->GetNumberOfCells());
+
+    vtkSMPThreadLocalObject<vtkIdList> tlIdList;
+    vtkSMPTools::For(0, newPolys->GetNumberOfCells(),
+      [&, inPts, newPolys, polyNormals](vtkIdType cellId, vtkIdType endCellId) {
+        vtkIdList* idList = tlIdList.Local();
+        vtkIdType npts;
+        const vtkIdType* pts;
+        double n[3];
+        for (; cellId < endCellId; ++cellId)
+        {
+          newPolys->GetCellAtId(cellId, npts, pts, idList);
+          vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+          polyNormals->SetTuple(cellId, n);
+        }
+      }); // end lambda
 
     cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
   }
 
-  neighbors = vtkIdList::New();
-  neighbors->Allocate(VTK_CELL_SIZE);
-
   bool abort = false;
   vtkIdType progressInterval = newPolys->GetNumberOfCells() / 20 + 1;
 
@@ -322,140 +340,181 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  for (newCellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts) && !abort;
-       newCellId++)
-  {
-    if (!(newCellId % progressInterval)) // manage progress / early abort
-    {
-      this->UpdateProgress(static_cast<double>(newCellId) / numCells);
-      abort = this->CheckAbort();
-    }
-
+  // Map the ids of the polygons of the mesh to the ids of the input cells.
+  auto getInputCellId = [&](vtkIdType newCellId) -> vtkIdType {
     if (numPolys == numCells) // Input only has Polys
     {
-      cellId = newCellId;
+      return newCellId;
     }
     else if (newCellId < numPolys) // Input has mixed types, and we currently are on a Poly
     {
-      cellId = polyIdToCellIdMap->GetId(newCellId);
-    }
-    else // Input has mixed types and we are dealing with triangle strips
-    {
-      auto it = decomposedStripIdToStripIdMap.lower_bound(newCellId + 1);
-      cellId = stripIdToCellIdMap->GetId(it->second);
+      return polyIdToCellIdMap->GetId(newCellId);
     }
+    // Input has mixed types and we are dealing with triangle strips
+    auto it = decomposedStripIdToStripIdMap.lower_bound(newCellId + 1);
+    return stripIdToCellIdMap->GetId(it->second);
+  };
+
+  // Classify the edges of the polygons in parallel. The type of the i-th edge
+  // of a polygon is stored at the offset of its i-th point in the connectivity
+  // of the polygons.
+  std::vector<unsigned char> edgeTypes(newPolys->GetNumberOfConnectivityIds(), NOT_EXTRACTED);
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+  vtkSMPThreadLocalObject<vtkIdList> tlEdgesRemapping;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPoints;
+  vtkSMPTools::For(0, newPolys->GetNumberOfCells(),
+    [&, Mesh, newPolys, polyNormals, ghosts](vtkIdType newCellId, vtkIdType endCellId) {
+      vtkIdList* neighbors = tlNeighbors.Local();
+      // Used with non manifold edges when there are ghost cells in the input
+      vtkIdList* edgesRemapping = tlEdgesRemapping.Local();
+      vtkIdList* cellPoints = tlCellPoints.Local();
+      vtkIdType j, numNei, nei, npts;
+      const vtkIdType* pts;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((endCellId - newCellId) / 10 + 1, (vtkIdType)1000);
+
+      for (; newCellId < endCellId; ++newCellId)
+      {
+        if (newCellId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
 
-    if (ghosts && ghosts[cellId] & CELL_NOT_VISIBLE)
-    {
-      continue;
-    }
+        if (ghosts && ghosts[getInputCellId(newCellId)] & CELL_NOT_VISIBLE)
+        {
+          continue;
+        }
 
-    // Used with non manifold edges when there are ghost cells in the input
-    vtkNew<vtkIdList> edgesRemapping;
+        newPolys->GetCellAtId(newCellId, npts, pts, cellPoints);
+        unsigned char* cellEdgeTypes = edgeTypes.data() + newPolys->GetOffset(newCellId);
+        edgesRemapping->Reset();
 
-    for (i = 0; i < npts; i++)
-    {
-      p1 = pts[i];
-      p2 = pts[(i + 1) % npts];
+        for (vtkIdType i = 0; i < npts; i++)
+        {
+          vtkIdType p1 = pts[i];
+          vtkIdType p2 = pts[(i + 1) % npts];
 
-      Mesh->GetCellEdgeNeighbors(newCellId, p1, p2, neighbors);
-      numNei = neighbors->GetNumberOfIds();
+          Mesh->GetCellEdgeNeighbors(newCellId, p1, p2, neighbors);
+          numNei = neighbors->GetNumberOfIds();
 
-      vtkIdType numNeiWithoutGhosts = numNei;
-      vtkIdType firstNeighbor = 0;
-      if (ghosts)
-      {
-        for (j = 0; j < numNei; ++j)
-        {
-          vtkIdType neiId = neighbors->GetId(j);
-          vtkIdType neighborCellIdInInput;
-          if (numPolys == numCells)
+          vtkIdType numNeiWithoutGhosts = numNei;
+          vtkIdType firstNeighbor = 0;
+          if (ghosts)
           {
-            neighborCellIdInInput = neiId;
+            for (j = 0; j < numNei; ++j)
+            {
+              if (ghosts[getInputCellId(neighbors->GetId(j))] & CELL_NOT_VISIBLE)
+              {
+                if (this->NonManifoldEdges)
+                {
+                  edgesRemapping->InsertNextId(j);
+                }
+                if (j == firstNeighbor)
+                {
+                  ++firstNeighbor;
+                }
+                --numNeiWithoutGhosts;
+              }
+            }
           }
-          else if (neiId < numPolys)
+          // Ignoring edges that are not visible
+          if (numNeiWithoutGhosts != numNei && this->RemoveGhostInterfaces)
           {
-            neighborCellIdInInput = polyIdToCellIdMap->GetId(neiId);
+            continue;
           }
-          else
+
+          if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
           {
-            auto it = decomposedStripIdToStripIdMap.lower_bound(neiId + 1);
-            neighborCellIdInInput = stripIdToCellIdMap->GetId(it->second);
+            cellEdgeTypes[i] = BOUNDARY_EDGE;
           }
-          if (ghosts[neighborCellIdInInput] & CELL_NOT_VISIBLE)
+
+          else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
           {
-            if (this->NonManifoldEdges)
+            // check to make sure that this edge hasn't been created before
+            for (j = 0; j < (ghosts ? edgesRemapping->GetNumberOfIds() : numNei); j++)
+            {
+              if (neighbors->GetId(ghosts ? edgesRemapping->GetId(j) : j) < newCellId)
+              {
+                break;
+              }
+            }
+            edgesRemapping->Reset();
+            if (j >= numNeiWithoutGhosts)
             {
-              edgesRemapping->InsertNextId(j);
+              cellEdgeTypes[i] = NON_MANIFOLD_EDGE;
             }
-            if (j == firstNeighbor)
+          }
+          else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
+            (nei = neighbors->GetId(firstNeighbor)) > newCellId)
+          {
+            double neiTuple[3];
+            double cellTuple[3];
+            polyNormals->GetTuple(nei, neiTuple);
+            polyNormals->GetTuple(newCellId, cellTuple);
+            if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
             {
-              ++firstNeighbor;
+              cellEdgeTypes[i] = FEATURE_EDGE;
             }
-            --numNeiWithoutGhosts;
+          }
+          else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
+            neighbors->GetId(firstNeighbor) > newCellId)
+          {
+            cellEdgeTypes[i] = MANIFOLD_EDGE;
           }
         }
       }
-      // Ignoring edges that are not visible
-      if (numNeiWithoutGhosts != numNei && this->RemoveGhostInterfaces)
-      {
-        continue;
-      }
+    }); // end lambda
 
-      if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
-      {
-        numBEdges++;
-        scalar = 0.0;
-      }
+  // Generate the extracted edges in order, merging their points.
+  for (newCellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts) && !abort;
+       newCellId++)
+  {
+    if (!(newCellId % progressInterval)) // manage progress / early abort
+    {
+      this->UpdateProgress(static_cast<double>(newCellId) / numCells);
+      abort = this->CheckAbort();
+    }
+
+    const unsigned char* cellEdgeTypes = edgeTypes.data() + newPolys->GetOffset(newCellId);
+    if (std::all_of(cellEdgeTypes, cellEdgeTypes + npts,
+          [](unsigned char type) { return type == NOT_EXTRACTED; }))
+    {
+      continue;
+    }
+    cellId = getInputCellId(newCellId);
 
-      else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
+    for (i = 0; i < npts; i++)
+    {
+      switch (cellEdgeTypes[i])
       {
-        // check to make sure that this edge hasn't been created before
-        for (j = 0; j < (ghosts ? edgesRemapping->GetNumberOfIds() : numNei); j++)
-        {
-          if (neighbors->GetId(ghosts ? edgesRemapping->GetId(j) : j) < newCellId)
-          {
-            break;
-          }
-        }
-        edgesRemapping->Reset();
-        if (j >= numNeiWithoutGhosts)
-        {
+        case BOUNDARY_EDGE:
+          numBEdges++;
+          scalar = 0.0;
+          break;
+        case NON_MANIFOLD_EDGE:
           numNonManifoldEdges++;
           scalar = 0.222222;
-        }
-        else
-        {
-          continue;
-        }
-      }
-      else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
-        (nei = neighbors->GetId(firstNeighbor)) > newCellId)
-      {
-        double neiTuple[3];
-        double cellTuple[3];
-        polyNormals->GetTuple(nei, neiTuple);
-        polyNormals->GetTuple(newCellId, cellTuple);
-        if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
-        {
+          break;
+        case FEATURE_EDGE:
           numFedges++;
           scalar = 0.444444;
-        }
-        else
-        {
+          break;
+        case MANIFOLD_EDGE:
+          numManifoldEdges++;
+          scalar = 0.666667;
+          break;
+        default:
           continue;
-        }
-      }
-      else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
-        neighbors->GetId(firstNeighbor) > newCellId)
-      {
-        numManifoldEdges++;
-        scalar = 0.666667;
-      }
-      else
-      {
-        continue;
       }
+      p1 = pts[i];
+      p2 = pts[(i + 1) % npts];
 
       // Add edge to output
       Mesh->GetPoint(p1, x1);
@@ -497,7 +556,6 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
 
   output->SetPoints(newPts);
   newPts->Delete();
-  neighbors->Delete();
 
   output->SetLines(newLines);
   newLines->Delete();
@@ -2,18 +2,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
+#include "vtkBatch.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
-#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -21,6 +26,129 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// The size of the output generated by a batch of input points: the number
+// of points, and the number of cells and connectivity entries of the verts,
+// lines, polys and strips. These are turned into offsets once all the
+// batches are counted.
+struct GlyphBatchData
+{
+  vtkIdType Points;
+  vtkIdType Cells[4];
+  vtkIdType Connectivity[4];
+
+  GlyphBatchData()
+    : Points(0)
+    , Cells{ 0, 0, 0, 0 }
+    , Connectivity{ 0, 0, 0, 0 }
+  {
+  }
+  ~GlyphBatchData() = default;
+  GlyphBatchData& operator+=(const GlyphBatchData& other)
+  {
+    this->Points += other.Points;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->Cells[type] += other.Cells[type];
+      this->Connectivity[type] += other.Connectivity[type];
+    }
+    return *this;
+  }
+  GlyphBatchData operator+(const GlyphBatchData& other) const
+  {
+    GlyphBatchData result = *this;
+    result += other;
+    return result;
+  }
+};
+using GlyphBatch = vtkBatch<GlyphBatchData>;
+using GlyphBatches = vtkBatches<GlyphBatchData>;
+
+// The geometry of a glyph source, gathered once so that every glyph only
+// has to transform its points and offset its connectivity.
+struct GlyphSource
+{
+  vtkIdType NumberOfPoints = 0;
+  std::vector<double> Points; // with the source transform applied
+  vtkDataArray* Normals = nullptr;
+  // Offsets and connectivity of the verts, lines, polys and strips
+  std::vector<vtkIdType> Offsets[4];
+  std::vector<vtkIdType> Connectivity[4];
+
+  void Initialize(vtkPolyData* source, vtkTransform* sourceTransform)
+  {
+    vtkPoints* points = source->GetPoints();
+    this->NumberOfPoints = points ? points->GetNumberOfPoints() : 0;
+    this->Points.resize(3 * this->NumberOfPoints);
+    if (this->NumberOfPoints > 0 && sourceTransform)
+    {
+      vtkNew<vtkPoints> transformedPoints;
+      transformedPoints->SetDataTypeToDouble();
+      transformedPoints->Allocate(this->NumberOfPoints);
+      sourceTransform->TransformPoints(points, transformedPoints);
+      std::copy_n(vtkArrayDownCast<vtkDoubleArray>(transformedPoints->GetData())->GetPointer(0),
+        3 * this->NumberOfPoints, this->Points.begin());
+    }
+    else
+    {
+      for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+      {
+        points->GetPoint(ptId, &this->Points[3 * ptId]);
+      }
+    }
+    this->Normals = source->GetPointData()->GetNormals();
+
+    vtkCellArray* cells[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    for (int type = 0; type < 4; ++type)
+    {
+      this->Offsets[type].assign(1, 0);
+      this->Connectivity[type].clear();
+      if (!cells[type])
+      {
+        continue;
+      }
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (cells[type]->InitTraversal(); cells[type]->GetNextCell(npts, pts);)
+      {
+        this->Connectivity[type].insert(this->Connectivity[type].end(), pts, pts + npts);
+        this->Offsets[type].push_back(static_cast<vtkIdType>(this->Connectivity[type].size()));
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfCells(int type) const
+  {
+    return static_cast<vtkIdType>(this->Offsets[type].size()) - 1;
+  }
+  vtkIdType GetConnectivitySize(int type) const
+  {
+    return static_cast<vtkIdType>(this->Connectivity[type].size());
+  }
+};
+
+// Transform the points of a glyph by a 3x3 matrix and a translation
+template <typename TPoint>
+void TransformGlyphPoints(const GlyphSource& source, const double matrix[3][3],
+  const double translation[3], TPoint* outPoints)
+{
+  const double* x = source.Points.data();
+  for (vtkIdType ptId = 0; ptId < source.NumberOfPoints; ++ptId, x += 3, outPoints += 3)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      outPoints[i] = static_cast<TPoint>(matrix[i][0] * x[0] + matrix[i][1] * x[1] +
+        matrix[i][2] * x[2] + translation[i]);
+    }
+  }
+}
+}
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
@@ -125,40 +253,24 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
+  vtkIdType numPts;
   vtkPoints* newPts;
   vtkDataArray* newScalars = nullptr;
-  vtkDataArray* newVectors = nullptr;
-  vtkDataArray* newNormals = nullptr;
-  vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
+  vtkFloatArray* newVectors = nullptr;
+  vtkFloatArray* newNormals = nullptr;
+  vtkFloatArray* newTCoords = nullptr;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
   vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -185,8 +297,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -208,6 +318,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     haveVectors = 0;
   }
 
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
+  }
+
   if ((this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
     (this->IndexMode == VTK_INDEXING_BY_VECTOR &&
       ((!inVectors && this->VectorMode == VTK_USE_VECTOR) ||
@@ -216,8 +337,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -249,71 +368,232 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Gather the geometry of the glyphs once. Sources that are missing from
+  // the table of glyphs are not glyphed.
+  std::vector<GlyphSource> glyphSources;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    glyphSources.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
-      source = this->GetSource(i, sourceVector);
-      if (source != nullptr)
+      vtkPolyData* indexedSource = this->GetSource(i, sourceVector);
+      if (indexedSource != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
+        glyphSources[i].Initialize(indexedSource, this->SourceTransform);
+        if (!glyphSources[i].Normals)
         {
           haveNormals = 0;
         }
       }
+      else
+      {
+        glyphSources[i].NumberOfPoints = -1;
+      }
     }
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
+    glyphSources.resize(1);
+    glyphSources[0].Initialize(source, this->SourceTransform);
+    haveNormals = glyphSources[0].Normals ? 1 : 0;
 
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
+    sourceTCoords = source->GetPointData()->GetTCoords();
+    if (sourceTCoords)
     {
-      haveNormals = 1;
+      haveTCoords = 1;
     }
     else
     {
-      haveNormals = 0;
+      haveTCoords = 0;
     }
+  }
 
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
+  // Glyph scale, vector and source of an input point. Returns -1 if the
+  // point indexes an empty glyph.
+  auto evaluateGlyph = [&](vtkIdType inPtId, double scale[3], double v[3], double& vMag) -> int {
+    double s = 0.0;
+    vMag = 0.0;
+    scale[0] = scale[1] = scale[2] = 1.0;
+
+    // Get the scalar and vector data
+    if (inSScalars)
     {
-      haveTCoords = 1;
+      s = inSScalars->GetComponent(inPtId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
     }
-    else
+
+    v[0] = v[1] = v[2] = 0.0;
+    if (haveVectors)
     {
-      haveTCoords = 0;
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        vMag = 1.0; // v will be set later
+      }
+      else
+      {
+        array3D->GetTuple(inPtId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = vMag;
+        }
+      }
+    }
+
+    // Clamp data scale if enabled
+    if (this->Clamping)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = (scale[i] < this->Range[0]
+            ? this->Range[0]
+            : (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / den;
+      }
     }
 
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
+    // Compute index into table of glyphs
+    int index = 0;
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      double value = this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : vMag;
+      index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+
+    // Make sure we're not indexing into empty glyph
+    return glyphSources[index].NumberOfPoints < 0 ? -1 : index;
+  };
+
+  // Whether an input point is hidden by its ghost flags or by blanking
+  auto isHidden = [&](vtkIdType inPtId) -> bool {
+    // Check ghost points.
+    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
+    if (inGhostLevels &&
+      inGhostLevels[inPtId] &
+        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
+    {
+      return true;
+    }
+
+    if (inputUG && !inputUG->IsPointVisible(inPtId))
+    {
+      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
+      // it.
+      return true;
+    }
+
+    return false;
+  };
+
+  // First pass: select the glyph of every input point.
+  {
+    double x[3];
+    input->GetPoint(0, x); // for thread safety of GetPoint later on
+  }
+  std::vector<int> glyphIndices(numPts);
+  GlyphBatches batches;
+  batches.Initialize(numPts);
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    double scale[3], v[3], vMag;
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      const GlyphBatch& batch = batches[batchId];
+      for (vtkIdType inPtId = batch.BeginId; inPtId < batch.EndId; ++inPtId)
+      {
+        int index = evaluateGlyph(inPtId, scale, v, vMag);
+        glyphIndices[inPtId] = index >= 0 && isHidden(inPtId) ? -1 : index;
+      }
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return true;
+  }
+
+  // IsPointVisible() may be overridden by subclasses that are not thread safe
+  // or that depend on the order of the calls, so it is called from this thread
+  // in point order, for the same points as a serial traversal would.
+  for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+  {
+    if (glyphIndices[inPtId] >= 0 && !this->IsPointVisible(input, inPtId))
+    {
+      glyphIndices[inPtId] = -1;
+    }
+  }
+
+  // Second pass: count the output of each batch of points to size the output
+  // up front.
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      GlyphBatch& batch = batches[batchId];
+      for (vtkIdType inPtId = batch.BeginId; inPtId < batch.EndId; ++inPtId)
+      {
+        const int index = glyphIndices[inPtId];
+        if (index >= 0)
+        {
+          const GlyphSource& glyphSource = glyphSources[index];
+          batch.Data.Points += glyphSource.NumberOfPoints;
+          for (int type = 0; type < 4; ++type)
+          {
+            batch.Data.Cells[type] += glyphSource.GetNumberOfCells(type);
+            batch.Data.Connectivity[type] += glyphSource.GetConnectivitySize(type);
+          }
+        }
+      }
+    }
+  });
+  const GlyphBatchData totals = batches.BuildOffsetsAndGetGlobalSum();
+  this->UpdateProgress(0.5);
+  const vtkIdType numNewPts = totals.Points;
+  const vtkIdType numNewCells =
+    totals.Cells[0] + totals.Cells[1] + totals.Cells[2] + totals.Cells[3];
+
+  // Prepare to copy output.
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numNewPts);
+    if (this->GeneratePointIds && this->PointIdsName)
+    {
+      // replaced by the generated point ids
+      vtkAbstractArray* inPointIds = pd->GetAbstractArray(this->PointIdsName);
+      if (inPointIds)
+      {
+        pointArrays.ExcludeArray(inPointIds);
+      }
+    }
+    pointArrays.AddArrays(numNewPts, pd, outputPD, 0.0, false);
     if (this->FillCellData)
     {
       outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      outputCD->CopyAllocate(pd, numNewCells);
+      cellArrays.AddArrays(numNewCells, pd, outputCD, 0.0, false);
     }
   }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
-
   newPts = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
@@ -330,12 +610,22 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numPts * numSourcePts);
+  newPts->SetNumberOfPoints(numNewPts);
+  float* newFloatPts = nullptr;
+  double* newDoublePts = nullptr;
+  if (newPts->GetDataType() == VTK_DOUBLE)
+  {
+    newDoublePts = vtkArrayDownCast<vtkDoubleArray>(newPts->GetData())->GetPointer(0);
+  }
+  else
+  {
+    newFloatPts = vtkArrayDownCast<vtkFloatArray>(newPts->GetData())->GetPointer(0);
+  }
   if (this->GeneratePointIds)
   {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
+    pointIds->SetNumberOfValues(numNewPts);
     outputPD->AddArray(pointIds);
     pointIds->Delete();
   }
@@ -343,13 +633,13 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -359,21 +649,21 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName("VectorMagnitude");
   }
   if (haveVectors)
   {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numNewPts);
     newVectors->SetName("GlyphVector");
   }
   if (haveNormals)
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numNewPts);
     newNormals->SetName("Normals");
   }
   if (haveTCoords)
@@ -381,339 +671,276 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords = vtkFloatArray::New();
     int numComps = sourceTCoords->GetNumberOfComponents();
     newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords->SetNumberOfTuples(numNewPts);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
-
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  // The verts, lines, polys and strips of the output. Output cells are
+  // numbered in this order, which is used to fill the cell data.
+  vtkSmartPointer<vtkIdTypeArray> newOffsets[4];
+  vtkSmartPointer<vtkIdTypeArray> newConnectivity[4];
+  vtkIdType cellIdOffsets[4] = { 0, totals.Cells[0], totals.Cells[0] + totals.Cells[1],
+    totals.Cells[0] + totals.Cells[1] + totals.Cells[2] };
+  for (int type = 0; type < 4; ++type)
   {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
-    {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
-      {
-        break;
-      }
-    }
+    newOffsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+    newOffsets[type]->SetNumberOfValues(totals.Cells[type] + 1);
+    newOffsets[type]->SetValue(totals.Cells[type], totals.Connectivity[type]);
+    newConnectivity[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+    newConnectivity[type]->SetNumberOfValues(totals.Connectivity[type]);
+  }
 
-    // Get the scalar and vector data
-    if (inSScalars)
+  // Third pass: transform and copy the glyphs of each batch of points
+  // directly into the output.
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    double x[3], scale[3], v[3], vMag, vNew[3], tc[3];
+    double matrix[3][3], normalMatrix[4][4];
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      if (isFirst)
       {
-        scalex = scaley = scalez = s;
+        this->CheckAbort();
       }
-    }
-
-    if (haveVectors)
-    {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      if (this->GetAbortOutput())
       {
-        vMag = 1.0; // v will be set later
+        break;
       }
-      else
+      const GlyphBatch& batch = batches[batchId];
+      GlyphBatchData offsets = batch.Data;
+      for (vtkIdType inPtId = batch.BeginId; inPtId < batch.EndId; ++inPtId)
       {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        const int index = glyphIndices[inPtId];
+        if (index < 0)
+        {
+          continue;
+        }
+        evaluateGlyph(inPtId, scale, v, vMag);
+        const GlyphSource& glyphSource = glyphSources[index];
+        const vtkIdType numSourcePts = glyphSource.NumberOfPoints;
+        const vtkIdType ptIncr = offsets.Points;
+
+        // Copy all topology (transformation independent)
+        for (int type = 0; type < 4; ++type)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
+          vtkIdType* outOffsets = newOffsets[type]->GetPointer(offsets.Cells[type]);
+          vtkIdType* outConnectivity =
+            newConnectivity[type]->GetPointer(offsets.Connectivity[type]);
+          const vtkIdType numCells = glyphSource.GetNumberOfCells(type);
+          for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
           {
-            newPts->Delete();
+            outOffsets[cellId] = offsets.Connectivity[type] + glyphSource.Offsets[type][cellId];
+            cellArrays.Copy(inPtId, cellIdOffsets[type] + offsets.Cells[type] + cellId);
           }
-          if (newVectors)
+          for (const vtkIdType ptId : glyphSource.Connectivity[type])
           {
-            newVectors->Delete();
+            *outConnectivity++ = ptId + ptIncr;
           }
-          return false;
         }
 
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        // translate Source to Input point, and orient it
+        input->GetPoint(inPtId, x);
+        matrix[0][0] = matrix[1][1] = matrix[2][2] = 1.0;
+        matrix[0][1] = matrix[0][2] = matrix[1][0] = matrix[1][2] = matrix[2][0] = matrix[2][1] =
+          0.0;
+        if (haveVectors)
         {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
+          if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+          {
+            // v = glyphNormal_World (glyph normal direction in World coordinate system)
+            v[0] = this->FollowedCameraPosition[0] - x[0];
+            v[1] = this->FollowedCameraPosition[1] - x[1];
+            v[2] = this->FollowedCameraPosition[2] - x[2];
+            vtkMath::Normalize(v);
+          }
+          // Copy Input vector
+          float* outVectors = newVectors->GetPointer(3 * ptIncr);
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            outVectors[3 * i] = static_cast<float>(v[0]);
+            outVectors[3 * i + 1] = static_cast<float>(v[1]);
+            outVectors[3 * i + 2] = static_cast<float>(v[2]);
+          }
+          if (this->Orient)
+          {
+            if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+            {
+              double glyphRight_World[3]; // glyph right direction in World coordinate system
+              vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+              // glyph up direction in World coordinate system
+              // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to
+              // be orthogonal to the normal direction)
+              double glyphUp_World[3];
+              vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+              for (int i = 0; i < 3; ++i)
+              {
+                matrix[i][0] = glyphRight_World[i];
+                matrix[i][1] = glyphUp_World[i];
+                matrix[i][2] = v[i];
+              }
+            }
+            else if (vMag > 0.0)
+            {
+              // if there is no y or z component
+              if (v[1] == 0.0 && v[2] == 0.0)
+              {
+                if (v[0] < 0) // just flip x if we need to
+                {
+                  matrix[0][0] = matrix[2][2] = -1.0;
+                }
+              }
+              else
+              {
+                // Rotation of 180 degrees around the bisector of the x axis and v
+                vNew[0] = (v[0] + vMag) / 2.0;
+                vNew[1] = v[1] / 2.0;
+                vNew[2] = v[2] / 2.0;
+                vtkMath::Normalize(vNew);
+                for (int i = 0; i < 3; ++i)
+                {
+                  for (int j = 0; j < 3; ++j)
+                  {
+                    matrix[i][j] = 2.0 * vNew[i] * vNew[j] - (i == j ? 1.0 : 0.0);
+                  }
+                }
+              }
+            }
+          }
         }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+
+        if (haveTCoords)
         {
-          scalex = scaley = scalez = vMag;
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            sourceTCoords->GetTuple(i, tc);
+            newTCoords->SetTuple(i + ptIncr, tc);
+          }
         }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
 
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
+        // determine scale factor from scalars if appropriate
+        // Copy scalar value
+        if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
+        {
+          std::fill_n(vtkArrayDownCast<vtkFloatArray>(newScalars)->GetPointer(ptIncr),
+            numSourcePts, static_cast<float>(scale[0]));
+        }
+        else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
+        {
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(ptIncr + i, inPtId, inCScalars);
+          }
+        }
+        if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+        {
+          std::fill_n(vtkArrayDownCast<vtkFloatArray>(newScalars)->GetPointer(ptIncr),
+            numSourcePts, static_cast<float>(vMag));
+        }
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+        // scale data if appropriate
+        if (this->Scaling)
+        {
+          if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+          {
+            scale[0] = scale[1] = scale[2] = this->ScaleFactor;
+          }
+          else
+          {
+            scale[0] *= this->ScaleFactor;
+            scale[1] *= this->ScaleFactor;
+            scale[2] *= this->ScaleFactor;
+          }
+          for (int j = 0; j < 3; ++j)
+          {
+            if (scale[j] == 0.0)
+            {
+              scale[j] = 1.0e-10;
+            }
+            for (int i = 0; i < 3; ++i)
+            {
+              matrix[i][j] *= scale[j];
+            }
+          }
+        }
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+        // multiply points and normals by resulting matrix
+        if (newDoublePts)
         {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
+          TransformGlyphPoints(glyphSource, matrix, x, newDoublePts + 3 * ptIncr);
         }
-        else if (vMag > 0.0)
+        else
         {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
+          TransformGlyphPoints(glyphSource, matrix, x, newFloatPts + 3 * ptIncr);
+        }
+
+        if (haveNormals)
+        {
+          // Normals are transformed by the inverse transpose of the matrix,
+          // computed as vtkLinearTransform::TransformNormals() does.
+          for (int i = 0; i < 3; ++i)
           {
-            if (v[0] < 0) // just flip x if we need to
+            for (int j = 0; j < 3; ++j)
             {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
+              normalMatrix[i][j] = matrix[i][j];
             }
+            normalMatrix[i][3] = x[i];
+            normalMatrix[3][i] = 0.0;
           }
-          else
+          normalMatrix[3][3] = 1.0;
+          vtkMatrix4x4::Invert(*normalMatrix, *normalMatrix);
+          vtkMatrix4x4::Transpose(*normalMatrix, *normalMatrix);
+          float* outNormals = newNormals->GetPointer(3 * ptIncr);
+          double n[3];
+          for (vtkIdType i = 0; i < numSourcePts; i++)
           {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+            glyphSource.Normals->GetTuple(i, n);
+            float* outNormal = outNormals + 3 * i;
+            for (int j = 0; j < 3; ++j)
+            {
+              outNormal[j] = static_cast<float>(normalMatrix[j][0] * n[0] +
+                normalMatrix[j][1] * n[1] + normalMatrix[j][2] * n[2]);
+            }
+            vtkMath::Normalize(outNormal);
           }
         }
-      }
-    }
 
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
-
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
-      }
-    }
-
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
-
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
-    }
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
-
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
+        // Copy point data from source (if possible)
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+        {
+          pointArrays.Copy(inPtId, ptIncr + i);
+        }
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
-      {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
+        // If point ids are to be generated, do it here
+        if (this->GeneratePointIds)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          std::fill_n(pointIds->GetPointer(ptIncr), numSourcePts, inPtId);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
 
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
+        offsets.Points += numSourcePts;
+        for (int type = 0; type < 4; ++type)
+        {
+          offsets.Cells[type] += glyphSource.GetNumberOfCells(type);
+          offsets.Connectivity[type] += glyphSource.GetConnectivitySize(type);
+        }
       }
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
-  }
+  });
 
   // Update ourselves and release memory
   //
   output->SetPoints(newPts);
   newPts->Delete();
 
+  vtkNew<vtkCellArray> newVerts, newLines, newPolys, newStrips;
+  newVerts->SetData(newOffsets[0], newConnectivity[0]);
+  newLines->SetData(newOffsets[1], newConnectivity[1]);
+  newPolys->SetData(newOffsets[2], newConnectivity[2]);
+  newStrips->SetData(newOffsets[3], newConnectivity[3]);
+  output->SetVerts(newVerts);
+  output->SetLines(newLines);
+  output->SetPolys(newPolys);
+  output->SetStrips(newStrips);
+
   if (newScalars)
   {
     int idx = outputPD->AddArray(newScalars);
@@ -740,8 +967,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
 
   output->Squeeze();
-  trans->Delete();
-  pts->Delete();
 
   return true;
 }
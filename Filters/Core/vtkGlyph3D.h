@@ -61,6 +61,16 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The glyph of every input
+ * point is selected first, which sizes the output exactly, and the glyphs
+ * are then transformed and copied directly into the output. Using TBB or
+ * other non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly. The
+ * output does not depend on the number of threads. The cells of the output
+ * are ordered by type (verts, lines, polys then strips), and the cell data
+ * generated with FillCellData follows this order.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -3,13 +3,13 @@
 #include "vtkImplicitPolyDataDistance.h"
 
 #include "vtkCellData.h"
-#include "vtkCellLocator.h"
 #include "vtkCleanPolyData.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkTriangleFilter.h"
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -62,9 +62,7 @@ void vtkImplicitPolyDataDistance::SetInput(vtkPolyData* input)
 
     this->CreateDefaultLocator();
     this->Locator->SetDataSet(this->Input);
-    this->Locator->SetTolerance(this->Tolerance);
-    this->Locator->SetNumberOfCellsPerBucket(10);
-    this->Locator->CacheCellBoundsOn();
+    this->Locator->SetNumberOfCellsPerNode(10);
     this->Locator->AutomaticOn();
     this->Locator->BuildLocator();
   }
@@ -100,7 +98,7 @@ void vtkImplicitPolyDataDistance::CreateDefaultLocator()
 {
   if (this->Locator == nullptr)
   {
-    this->Locator = vtkCellLocator::New();
+    this->Locator = vtkStaticCellLocator::New();
   }
 }
 
@@ -225,6 +223,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       // The first argument is the cell ID. We pass a bogus cell ID so that
       // all face IDs attached to the edge are returned in the idList.
       this->Input->GetCellEdgeNeighbors(VTK_ID_MAX, a, b, idList);
+      idList->Sort();
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
       {
         double norm[3];
@@ -267,6 +266,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       }
 
       this->Input->GetPointCells(a, idList);
+      idList->Sort();
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
       {
         double norm[3];
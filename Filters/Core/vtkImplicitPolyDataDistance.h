@@ -14,6 +14,11 @@
  * vtkPolyData have a distance of zero. The gradient of the function
  * is the angle-weighted pseudonormal at the nearest point.
  *
+ * Once the input is set, the function may be evaluated concurrently from
+ * several threads, e.g. in a vtkSMPTools loop. The closest cell is found
+ * with a vtkStaticCellLocator, and each thread uses its own cell and id
+ * list for the evaluation.
+ *
  * Baerentzen, J. A. and Aanaes, H. (2005). Signed distance
  * computation using the angle weighted pseudonormal. IEEE
  * Transactions on Visualization and Computer Graphics, 11:243-253.
@@ -34,7 +39,7 @@
 #include "vtkSMPThreadLocalObject.h" // For thread local storage
 
 VTK_ABI_NAMESPACE_BEGIN
-class vtkCellLocator;
+class vtkStaticCellLocator;
 class vtkPolyData;
 
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
@@ -103,7 +108,8 @@ public:
 
   ///@{
   /**
-   * Set/get the tolerance used for the locator.
+   * Set/get the tolerance used to decide whether the closest point lies on
+   * an edge or a vertex of the closest triangle.
    */
   vtkGetMacro(Tolerance, double);
   vtkSetMacro(Tolerance, double);
@@ -126,7 +132,7 @@ protected:
   double Tolerance;
 
   vtkPolyData* Input;
-  vtkCellLocator* Locator;
+  vtkStaticCellLocator* Locator;
   vtkSMPThreadLocalObject<vtkGenericCell> TLCell;
   vtkSMPThreadLocalObject<vtkIdList> TLCellIds;
 
@@ -1,10 +1,15 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkPolyDataConnectivityFilter.h"
 
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -15,7 +20,8 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 
-#include <algorithm> // for fill_n
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -73,10 +79,9 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkIdType cellId, newCellId, i, pt;
   vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkIdType *cells, id, n;
+  vtkIdType id, n;
   vtkIdType npts;
   const vtkIdType* pts;
-  vtkIdType ncells;
   vtkIdType maxCellsInRegion;
   vtkIdType largestRegionId = 0;
   vtkPointData *pd = input->GetPointData(), *outputPD = output->GetPointData();
@@ -122,7 +127,6 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -132,13 +136,12 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->RegionSizes->Reset();
   this->Visited = new vtkIdType[numCells];
-  std::fill_n(this->Visited, numCells, -1);
   this->PointMap = new vtkIdType[numPts];
-  std::fill_n(this->PointMap, numPts, -1);
 
-  this->NewScalars = vtkIdTypeArray::New();
-  this->NewScalars->SetName("RegionId");
-  this->NewScalars->SetNumberOfTuples(numPts);
+  vtkIdTypeArray* newScalars = vtkIdTypeArray::New();
+  newScalars->SetName("RegionId");
+  newScalars->SetNumberOfTuples(numPts);
+  this->NewScalars = newScalars;
   newPts = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
@@ -157,19 +160,21 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
 
   newPts->Allocate(numPts);
 
-  // Traverse all cells marking those visited.  Each new search
-  // starts a new connected region. Connected region grows
-  // using a connected wave propagation.
+  // Join the cells sharing points and meeting the connectivity criterion,
+  // then number the regions in the order of a wave propagation started from
+  // each cell not yet visited.
   //
-  this->Wave.reserve(numPts);
-  this->Wave2.reserve(numPts);
+  vtkConnectedRegions regions(this->Mesh, this);
+  if (this->InScalars)
+  {
+    regions.QualifyCells(this->InScalars, this->ScalarRange, this->FullScalarConnectivity != 0);
+  }
+  regions.Connect();
+  this->UpdateProgress(0.5);
 
-  this->PointNumber = 0;
   this->RegionNumber = 0;
   maxCellsInRegion = 0;
 
-  this->CellIds = vtkIdList::New();
-  this->CellIds->Allocate(8, VTK_CELL_SIZE);
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
   vtkIdType checkAbortInterval = 0;
@@ -178,79 +183,48 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    this->RegionNumber = regions.LabelAllRegions(this->Visited, this->RegionSizes);
+    for (i = 0; i < this->RegionNumber; i++)
     {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-        if (this->CheckAbort())
-        {
-          break;
-        }
-      }
-
-      if (this->Visited[cellId] < 0)
+      if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        maxCellsInRegion = this->RegionSizes->GetValue(i);
+        largestRegionId = i;
       }
     }
   }
   else // regions have been seeded, everything considered in same region
   {
-    this->NumCellsInRegion = 0;
+    std::vector<unsigned char> seedCells(numCells, 0);
+    std::vector<unsigned char> seedPoints;
 
     if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
     {
-      checkAbortInterval = std::min(this->Seeds->GetNumberOfIds() / 10 + 1, (vtkIdType)1000);
+      seedPoints.resize(numPts, 0);
       for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
       {
-        if (i % checkAbortInterval == 0 && this->CheckAbort())
-        {
-          break;
-        }
         pt = this->Seeds->GetId(i);
-        if (pt >= 0)
+        if (pt >= 0 && pt < numPts)
         {
-          this->Mesh->GetPointCells(pt, ncells, cells);
-          for (vtkIdType j = 0; j < ncells; ++j)
-          {
-            this->Wave.push_back(cells[j]);
-          }
+          seedPoints[pt] = 1;
         }
       }
     }
     else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
     {
-      checkAbortInterval = std::min(this->Seeds->GetNumberOfIds() / 10 + 1, (vtkIdType)1000);
       for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
       {
-        if (i % checkAbortInterval == 0 && this->CheckAbort())
-        {
-          break;
-        }
         cellId = this->Seeds->GetId(i);
-        if (cellId >= 0)
+        if (cellId >= 0 && cellId < numCells)
         {
-          this->Wave.push_back(cellId);
+          seedCells[cellId] = 1;
         }
       }
     }
     else if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
     { // loop over points, find closest one
       double minDist2, dist2, x[3];
-      int minId = 0;
+      vtkIdType minId = 0;
       checkAbortInterval = std::min(numPts / 10 + 1, (vtkIdType)1000);
       for (minDist2 = VTK_DOUBLE_MAX, i = 0; i < numPts; i++)
       {
@@ -266,19 +240,24 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
           minDist2 = dist2;
         }
       }
-      this->Mesh->GetPointCells(minId, ncells, cells);
-      for (vtkIdType j = 0; j < ncells; ++j)
-      {
-        this->Wave.push_back(cells[j]);
-      }
+      seedPoints.resize(numPts, 0);
+      seedPoints[minId] = 1;
+    }
+    if (!seedPoints.empty())
+    {
+      regions.MarkCellsUsingPoints(seedPoints, seedCells);
     }
-    this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark();
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
-    this->UpdateProgress(0.9);
+    this->RegionSizes->InsertValue(
+      this->RegionNumber, regions.LabelSeededRegion(seedCells, this->Visited));
   } // else extracted seeded cells
+  this->UpdateProgress(0.9);
+
+  // Number the points of the visited cells region by region
+  vtkIdType numNewPts = regions.MapPoints(this->Visited, this->RegionSizes->GetNumberOfValues(),
+    this->PointMap, newScalars->GetPointer(0));
+  newScalars->SetNumberOfTuples(numNewPts);
 
   vtkDebugMacro(<< "Extracted " << this->RegionNumber << " region(s)");
 
@@ -450,7 +429,6 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   delete[] this->PointMap;
   this->Mesh->Delete();
   output->Squeeze();
-  this->CellIds->Delete();
   this->PointIds->Delete();
 
 #ifndef NDEBUG
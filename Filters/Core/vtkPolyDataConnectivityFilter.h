@@ -31,6 +31,11 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * The regions are labeled in parallel with vtkSMPTools. Processing the cells
+ * in order, a region starts at the first cell not yet visited, so the
+ * RegionIds do not depend on the number of threads. The output points are
+ * ordered by region, then by increasing input point id.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -38,9 +43,12 @@
 #ifndef vtkPolyDataConnectivityFilter_h
 #define vtkPolyDataConnectivityFilter_h
 
+#include "vtkDeprecation.h"      // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+#include <vector> // For std::vector
+
 #define VTK_EXTRACT_POINT_SEEDED_REGIONS 1
 #define VTK_EXTRACT_CELL_SEEDED_REGIONS 2
 #define VTK_EXTRACT_SPECIFIED_REGIONS 3
@@ -235,27 +243,36 @@ protected:
   vtkTypeBool FullScalarConnectivity;
 
   // Does this cell qualify as being scalar connected ?
+  VTK_DEPRECATED_IN_9_4_0("The regions are labeled in parallel, without wave propagation.")
   int IsScalarConnected(vtkIdType cellId);
 
   double ScalarRange[2];
 
+  VTK_DEPRECATED_IN_9_4_0("The regions are labeled in parallel, without wave propagation.")
   void TraverseAndMark();
 
   // used to support algorithm execution
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated IsScalarConnected.")
   vtkDataArray* CellScalars;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated IsScalarConnected.")
   vtkIdList* NeighborCellPointIds;
   vtkIdType* Visited;
   vtkIdType* PointMap;
   vtkDataArray* NewScalars;
   vtkIdType RegionNumber;
-  vtkIdType PointNumber;
-  vtkIdType NumCellsInRegion;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated TraverseAndMark.")
+  vtkIdType PointNumber = 0;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated TraverseAndMark.")
+  vtkIdType NumCellsInRegion = 0;
   vtkDataArray* InScalars;
   vtkPolyData* Mesh;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated TraverseAndMark.")
   std::vector<vtkIdType> Wave;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated TraverseAndMark.")
   std::vector<vtkIdType> Wave2;
   vtkIdList* PointIds;
-  vtkIdList* CellIds;
+  VTK_DEPRECATED_IN_9_4_0("Unused.")
+  vtkIdList* CellIds = nullptr;
   vtkIdList* VisitedPointIds;
 
   vtkTypeBool MarkVisitedPointIds;
@@ -55,6 +55,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->EndPoint2List = vtkIdList::New();
   this->ErrorQuadrics = nullptr;
   this->VolumeConstraints = nullptr;
+  this->Mesh = nullptr;
   this->TargetPoints = vtkDoubleArray::New();
 
   this->TargetReduction = 0.9;
@@ -231,46 +232,15 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   int j;
   double cost;
   double* x;
-  vtkCellArray* polys;
-  vtkDataArray* attrib;
-  vtkPoints* points;
   vtkIdType endPtIds[2];
-  vtkIdList* outputCellList;
   vtkIdType npts;
   const vtkIdType* pts;
   vtkIdType numDeletedTris = 0;
 
-  // check some assumptions about the data
-  if (input->GetPolys() == nullptr || input->GetPoints() == nullptr ||
-    input->GetPointData() == nullptr || input->GetFieldData() == nullptr)
-  {
-    vtkErrorMacro("Nothing to decimate");
-    return 1;
-  }
-
-  if (input->GetPolys()->GetMaxCellSize() > 3)
+  if (!this->InitializeMesh(input))
   {
-    vtkErrorMacro("Can only decimate triangles");
     return 1;
   }
-
-  polys = vtkCellArray::New();
-  points = vtkPoints::New();
-  outputCellList = vtkIdList::New();
-
-  // copy the input (only polys) to our working mesh
-  this->Mesh = vtkPolyData::New();
-  points->DeepCopy(input->GetPoints());
-  this->Mesh->SetPoints(points);
-  points->Delete();
-  polys->DeepCopy(input->GetPolys());
-  this->Mesh->SetPolys(polys);
-  polys->Delete();
-  if (this->AttributeErrorMetric || this->MapPointData)
-  {
-    this->Mesh->GetPointData()->DeepCopy(input->GetPointData());
-  }
-  this->Mesh->GetFieldData()->PassData(input->GetFieldData());
   this->Mesh->BuildCells();
   this->Mesh->EditableOn();
   this->Mesh->BuildLinks();
@@ -423,6 +393,54 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   delete[] this->TempData;
 
   // copy the simplified mesh from the working mesh to the output mesh
+  this->GenerateOutput(output);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkQuadricDecimation::InitializeMesh(vtkPolyData* input)
+{
+  // check some assumptions about the data
+  if (input->GetPolys() == nullptr || input->GetPoints() == nullptr ||
+    input->GetPointData() == nullptr || input->GetFieldData() == nullptr)
+  {
+    vtkErrorMacro("Nothing to decimate");
+    return false;
+  }
+
+  if (input->GetPolys()->GetMaxCellSize() > 3)
+  {
+    vtkErrorMacro("Can only decimate triangles");
+    return false;
+  }
+
+  vtkCellArray* polys = vtkCellArray::New();
+  vtkPoints* points = vtkPoints::New();
+
+  // copy the input (only polys) to our working mesh
+  this->Mesh = vtkPolyData::New();
+  points->DeepCopy(input->GetPoints());
+  this->Mesh->SetPoints(points);
+  points->Delete();
+  polys->DeepCopy(input->GetPolys());
+  this->Mesh->SetPolys(polys);
+  polys->Delete();
+  if (this->AttributeErrorMetric || this->MapPointData)
+  {
+    this->Mesh->GetPointData()->DeepCopy(input->GetPointData());
+  }
+  this->Mesh->GetFieldData()->PassData(input->GetFieldData());
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkQuadricDecimation::GenerateOutput(vtkPolyData* output)
+{
+  vtkIdList* outputCellList = vtkIdList::New();
+  vtkDataArray* attrib;
+  vtkIdType i;
+
   for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
   {
     if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
@@ -438,6 +456,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->Mesh->DeleteLinks();
   this->Mesh->Delete();
+  this->Mesh = nullptr;
   outputCellList->Delete();
 
   // renormalize, clamp attributes
@@ -452,36 +471,19 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     }
     // might want to add clamping texture coordinates??
   }
-
-  return 1;
 }
 
 //------------------------------------------------------------------------------
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
-  vtkPolyData* input = this->Mesh;
   double* QEM;
   vtkIdType ptId;
   int i, j;
   vtkCellArray* polys;
   vtkIdType npts;
   const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
   double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
-
-  double regularizationVariance = 0.0;
-  if (this->Regularize)
-  {
-    regularizationVariance = std::pow(this->Regularization, 2);
-  }
+  double d, triArea2;
 
   // allocate local QEM sparse matrix
   QEM = new double[11 + 4 * this->NumberOfComponents];
@@ -496,162 +498,11 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     }
   }
 
-  polys = input->GetPolys();
+  polys = this->Mesh->GetPolys();
   // compute the QEM for each face
   for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
   {
-    input->GetPoint(pts[0], point0);
-    input->GetPoint(pts[1], point1);
-    input->GetPoint(pts[2], point2);
-    for (i = 0; i < 3; i++)
-    {
-      tempP1[i] = point1[i] - point0[i];
-      tempP2[i] = point2[i] - point0[i];
-    }
-    vtkMath::Cross(tempP1, tempP2, n);
-    triArea2 = vtkMath::Normalize(n);
-    // triArea2 = (triArea2 * triArea2 * 0.25);
-    triArea2 = triArea2 * 0.5;
-    // I am unsure whether this should be squared or not??
-    d = -vtkMath::Dot(n, point0);
-    // could possible add in angle weights??
-
-    // set the geometric part of the QEM
-    QEM[0] = n[0] * n[0];
-    QEM[1] = n[0] * n[1];
-    QEM[2] = n[0] * n[2];
-    QEM[3] = d * n[0];
-
-    QEM[4] = n[1] * n[1];
-    QEM[5] = n[1] * n[2];
-    QEM[6] = d * n[1];
-
-    QEM[7] = n[2] * n[2];
-    QEM[8] = d * n[2];
-
-    QEM[9] = d * d;
-    QEM[10] = 1;
-
-    if (this->Regularize)
-    {
-      // Add in some regularizing identity \Sigma_n
-      QEM[0] += regularizationVariance;
-      QEM[4] += regularizationVariance;
-      QEM[7] += regularizationVariance;
-
-      // -\Sigma_n . q
-      QEM[3] -= regularizationVariance * point0[0];
-      QEM[6] -= regularizationVariance * point0[1];
-      QEM[8] -= regularizationVariance * point0[2];
-
-      // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
-      QEM[9] +=
-        regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
-    }
-
-    if (this->AttributeErrorMetric)
-    {
-      for (i = 0; i < 3; i++)
-      {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
-      }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
-
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
-      {
-        for (i = 0; i < this->NumberOfComponents; i++)
-        {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
-          {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-          }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
-          {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-          }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
-
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[3] * x[0];
-
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[3] * x[1];
-
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[3] * x[2];
-
-          QEM[9] += x[3] * x[3];
-
-          QEM[11 + i * 4] = -x[0];
-          QEM[12 + i * 4] = -x[1];
-          QEM[13 + i * 4] = -x[2];
-          QEM[14 + i * 4] = -x[3];
-        }
-      }
-      else
-      {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
-      }
-    }
+    triArea2 = this->ComputeTriangleQuadric(pts, QEM, n, d);
 
     // add the QEM to all points of the face
     for (i = 0; i < 3; i++)
@@ -680,6 +531,184 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   delete[] QEM;
 }
 
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeTriangleQuadric(
+  const vtkIdType pts[3], double* QEM, double n[3], double& d)
+{
+  vtkPolyData* input = this->Mesh;
+  int i;
+  double point0[3], point1[3], point2[3];
+  double tempP1[3], tempP2[3], triArea2;
+  double data[16];
+  double *A[4], x[4];
+  int index[4];
+  A[0] = data;
+  A[1] = data + 4;
+  A[2] = data + 8;
+  A[3] = data + 12;
+
+  double regularizationVariance = 0.0;
+  if (this->Regularize)
+  {
+    regularizationVariance = std::pow(this->Regularization, 2);
+  }
+
+  input->GetPoint(pts[0], point0);
+  input->GetPoint(pts[1], point1);
+  input->GetPoint(pts[2], point2);
+  for (i = 0; i < 3; i++)
+  {
+    tempP1[i] = point1[i] - point0[i];
+    tempP2[i] = point2[i] - point0[i];
+  }
+  vtkMath::Cross(tempP1, tempP2, n);
+  triArea2 = vtkMath::Normalize(n);
+  // triArea2 = (triArea2 * triArea2 * 0.25);
+  triArea2 = triArea2 * 0.5;
+  // I am unsure whether this should be squared or not??
+  d = -vtkMath::Dot(n, point0);
+  // could possible add in angle weights??
+
+  // set the geometric part of the QEM
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+  QEM[10] = 1;
+
+  if (this->Regularize)
+  {
+    // Add in some regularizing identity \Sigma_n
+    QEM[0] += regularizationVariance;
+    QEM[4] += regularizationVariance;
+    QEM[7] += regularizationVariance;
+
+    // -\Sigma_n . q
+    QEM[3] -= regularizationVariance * point0[0];
+    QEM[6] -= regularizationVariance * point0[1];
+    QEM[8] -= regularizationVariance * point0[2];
+
+    // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
+    QEM[9] +=
+      regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
+  }
+
+  if (this->AttributeErrorMetric)
+  {
+    for (i = 0; i < 3; i++)
+    {
+      A[0][i] = point0[i];
+      A[1][i] = point1[i];
+      A[2][i] = point2[i];
+      A[3][i] = n[i];
+    }
+    A[0][3] = A[1][3] = A[2][3] = 1;
+    A[3][3] = 0;
+
+    // should handle poorly condition matrix better
+    if (vtkMath::LUFactorLinearSystem(A, index, 4))
+    {
+      for (i = 0; i < this->NumberOfComponents; i++)
+      {
+        x[3] = 0;
+        if (i < this->AttributeComponents[0])
+        {
+          x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
+            this->AttributeScale[0];
+          x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
+            this->AttributeScale[0];
+          x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
+            this->AttributeScale[0];
+        }
+        else if (i < this->AttributeComponents[1])
+        {
+          x[0] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[0], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+          x[1] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[1], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+          x[2] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[2], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+        }
+        else if (i < this->AttributeComponents[2])
+        {
+          x[0] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[0], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+          x[1] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[1], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+          x[2] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[2], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+        }
+        else if (i < this->AttributeComponents[3])
+        {
+          x[0] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[0], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+          x[1] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[1], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+          x[2] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[2], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+        }
+        else if (i < this->AttributeComponents[4])
+        {
+          x[0] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[0], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+          x[1] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[1], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+          x[2] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[2], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+        }
+        vtkMath::LUSolveLinearSystem(A, index, x, 4);
+
+        // add in the contribution of this element into the QEM
+        QEM[0] += x[0] * x[0];
+        QEM[1] += x[0] * x[1];
+        QEM[2] += x[0] * x[2];
+        QEM[3] += x[3] * x[0];
+
+        QEM[4] += x[1] * x[1];
+        QEM[5] += x[1] * x[2];
+        QEM[6] += x[3] * x[1];
+
+        QEM[7] += x[2] * x[2];
+        QEM[8] += x[3] * x[2];
+
+        QEM[9] += x[3] * x[3];
+
+        QEM[11 + i * 4] = -x[0];
+        QEM[12 + i * 4] = -x[1];
+        QEM[13 + i * 4] = -x[2];
+        QEM[14 + i * 4] = -x[3];
+      }
+    }
+    else
+    {
+      vtkErrorMacro(<< "Unable to factor attribute matrix!");
+    }
+  }
+
+  return triArea2;
+}
+
 void vtkQuadricDecimation::AddBoundaryConstraints()
 {
   vtkPolyData* input = this->Mesh;
@@ -688,8 +717,7 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   int i, j;
   vtkIdType npts;
   const vtkIdType* pts;
-  double t0[3], t1[3], t2[3];
-  double e0[3], e1[3], n[3], c, w;
+  double w;
   vtkIdList* cellIds = vtkIdList::New();
 
   // allocate local QEM space matrix
@@ -705,73 +733,7 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
       if (cellIds->GetNumberOfIds() == 0)
       {
         // this is a boundary
-        input->GetPoint(pts[(i + 2) % 3], t0);
-        input->GetPoint(pts[i], t1);
-        input->GetPoint(pts[(i + 1) % 3], t2);
-
-        // computing a plane which is orthogonal to line t1, t2 and incident
-        // with it
-        for (j = 0; j < 3; j++)
-        {
-          e0[j] = t2[j] - t1[j];
-        }
-        for (j = 0; j < 3; j++)
-        {
-          e1[j] = t0[j] - t1[j];
-        }
-
-        // compute n so that it is orthogonal to e0 and parallel to the
-        // triangle
-        c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-        for (j = 0; j < 3; j++)
-        {
-          n[j] = e1[j] - c * e0[j];
-        }
-        vtkMath::Normalize(n);
-
-#if defined(_MSC_VER) && _MSC_VER >= 1929
-        // Visual Studio toolset starting at toolset 14.29.30133, when building in Release mode
-        // incorrectly optimizes away the line
-        //    QEM[9] = d * d;
-        // By making volatile, we are telling the compiler not to optimize out
-        // or reorder operations regarding this variable.
-        volatile
-#endif
-          double d = -vtkMath::Dot(n, t1);
-        // The above line might merit some review: The same quadric gets added to t1 and t2 and one
-        // might prefer adding a quadric calculated using t1 at t1 and using t2 at t2
-        w = vtkMath::Norm(e0);
-
-        if (!this->WeighBoundaryConstraintsByLength)
-        {
-          /*
-           * The argument for using area instead of length is based on homogeneity here: The quadric
-           * field is already weighted by triangle area. It makes sense weighting the boundary
-           * constraints by area instead of length. Length technically has zero measure in terms of
-           * units of area. The squared version also seems to give more coherent results at the
-           * boundary.
-           */
-          w *= w;
-        }
-        w *= this->BoundaryWeightFactor;
-
-        // could possible add in
-        // angle weights??
-        QEM[0] = n[0] * n[0];
-        QEM[1] = n[0] * n[1];
-        QEM[2] = n[0] * n[2];
-        QEM[3] = d * n[0];
-
-        QEM[4] = n[1] * n[1];
-        QEM[5] = n[1] * n[2];
-        QEM[6] = d * n[1];
-
-        QEM[7] = n[2] * n[2];
-        QEM[8] = d * n[2];
-
-        QEM[9] = d * d;
-
-        QEM[10] = 1;
+        w = this->ComputeBoundaryQuadric(pts, i, QEM);
 
         // need to add orthogonal plane with the other Attributes, but this
         // is not clear??
@@ -788,6 +750,85 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   delete[] QEM;
 }
 
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeBoundaryQuadric(const vtkIdType pts[3], int i, double* QEM)
+{
+  vtkPolyData* input = this->Mesh;
+  int j;
+  double t0[3], t1[3], t2[3];
+  double e0[3], e1[3], n[3], c, w;
+
+  input->GetPoint(pts[(i + 2) % 3], t0);
+  input->GetPoint(pts[i], t1);
+  input->GetPoint(pts[(i + 1) % 3], t2);
+
+  // computing a plane which is orthogonal to line t1, t2 and incident
+  // with it
+  for (j = 0; j < 3; j++)
+  {
+    e0[j] = t2[j] - t1[j];
+  }
+  for (j = 0; j < 3; j++)
+  {
+    e1[j] = t0[j] - t1[j];
+  }
+
+  // compute n so that it is orthogonal to e0 and parallel to the
+  // triangle
+  c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+  for (j = 0; j < 3; j++)
+  {
+    n[j] = e1[j] - c * e0[j];
+  }
+  vtkMath::Normalize(n);
+
+#if defined(_MSC_VER) && _MSC_VER >= 1929
+  // Visual Studio toolset starting at toolset 14.29.30133, when building in Release mode
+  // incorrectly optimizes away the line
+  //    QEM[9] = d * d;
+  // By making volatile, we are telling the compiler not to optimize out
+  // or reorder operations regarding this variable.
+  volatile
+#endif
+    double d = -vtkMath::Dot(n, t1);
+  // The above line might merit some review: The same quadric gets added to t1 and t2 and one
+  // might prefer adding a quadric calculated using t1 at t1 and using t2 at t2
+  w = vtkMath::Norm(e0);
+
+  if (!this->WeighBoundaryConstraintsByLength)
+  {
+    /*
+     * The argument for using area instead of length is based on homogeneity here: The quadric
+     * field is already weighted by triangle area. It makes sense weighting the boundary
+     * constraints by area instead of length. Length technically has zero measure in terms of
+     * units of area. The squared version also seems to give more coherent results at the
+     * boundary.
+     */
+    w *= w;
+  }
+  w *= this->BoundaryWeightFactor;
+
+  // could possible add in
+  // angle weights??
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+
+  QEM[10] = 1;
+
+  return w;
+}
+
 //------------------------------------------------------------------------------
 void vtkQuadricDecimation::AddQuadric(vtkIdType oldPtId, vtkIdType newPtId)
 {
@@ -932,10 +973,19 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
+{
+  vtkIdType pointIds[2];
+
+  pointIds[0] = this->EndPoint1List->GetId(edgeId);
+  pointIds[1] = this->EndPoint2List->GetId(edgeId);
+  return this->ComputeCost(pointIds, x, this->TempQuad);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(const vtkIdType pointIds[2], double* x, double* quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
-  vtkIdType pointIds[2];
   double cost = 0.0;
   double* index;
   int i, j;
@@ -943,25 +993,22 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
   double v[3], c, norm, normTemp, temp2[3];
   double pt1[3], pt2[3];
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
-
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -1013,7 +1060,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++) * newPoint[i] * newPoint[i];
@@ -1028,44 +1075,51 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
+{
+  vtkIdType pointIds[2];
+
+  pointIds[0] = this->EndPoint1List->GetId(edgeId);
+  pointIds[1] = this->EndPoint2List->GetId(edgeId);
+  return this->ComputeCost2(pointIds, x, this->TempQuad, this->TempB, this->TempA);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(
+  const vtkIdType pointIds[2], double* x, double* quad, double* b, double** a)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
   // neither was multiplication and some other matrix and vector primitives
   static const double errorNumber = 1e-10;
-  vtkIdType pointIds[2];
   double cost = 0.0;
   int i, j;
   int solveOk;
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
-
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
   // copy the temp quad into TempA
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  a[0][0] = quad[0];
+  a[0][1] = a[1][0] = quad[1];
+  a[0][2] = a[2][0] = quad[2];
+  a[1][1] = quad[4];
+  a[1][2] = a[2][1] = quad[5];
+  a[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-    this->TempB[i] = -this->TempQuad[11 + 4 * (i - 3) + 3];
+    a[0][i] = a[i][0] = quad[11 + 4 * (i - 3)];
+    a[1][i] = a[i][1] = quad[11 + 4 * (i - 3) + 1];
+    a[2][i] = a[i][2] = quad[11 + 4 * (i - 3) + 2];
+    b[i] = -quad[11 + 4 * (i - 3) + 3];
   }
 
   // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
@@ -1075,11 +1129,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        a[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        a[i][j] = 0;
       }
     }
   }
@@ -1090,48 +1144,48 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        a[i][3 + this->NumberOfComponents] = 0;
+        a[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        a[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        a[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        a[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        a[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
+    b[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
+    b[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = b[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
   solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+    a, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  a[0][0] = quad[0];
+  a[0][1] = a[1][0] = quad[1];
+  a[0][2] = a[2][0] = quad[2];
+  a[1][1] = quad[4];
+  a[1][2] = a[2][1] = quad[5];
+  a[2][2] = quad[7];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
+    a[0][i] = a[i][0] = quad[11 + 4 * (i - 3)];
+    a[1][i] = a[i][1] = quad[11 + 4 * (i - 3) + 1];
+    a[2][i] = a[i][2] = quad[11 + 4 * (i - 3) + 2];
   }
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
@@ -1140,11 +1194,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        a[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        a[i][j] = 0;
       }
     }
   }
@@ -1155,16 +1209,16 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        a[i][3 + this->NumberOfComponents] = 0;
+        a[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        a[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        a[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        a[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        a[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
@@ -1198,7 +1252,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j] * v[j];
+        temp2[i] += a[i][j] * v[j];
       }
     }
 
@@ -1216,13 +1270,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j] * pt1[j];
+          temp[i] += a[i][j] * pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = b[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1256,18 +1310,18 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i] * x[i] * x[i];
+    cost += a[i][i] * x[i] * x[i];
     for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      cost += 2.0 * a[i][j] * x[i] * x[j];
     }
   }
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -= 2.0 * this->TempB[i] * x[i];
+    cost -= 2.0 * b[i] * x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
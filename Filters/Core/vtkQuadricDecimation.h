@@ -39,6 +39,9 @@
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
+ *
+ * @sa
+ * vtkSMPQuadricDecimation
  */
 
 #ifndef vtkQuadricDecimation_h
@@ -200,6 +203,18 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Check the input and copy its triangles, points and (when needed) point
+   * data to the working Mesh. Return false if there is nothing to decimate.
+   */
+  bool InitializeMesh(vtkPolyData* input);
+
+  /**
+   * Copy the cells of the working Mesh that were not deleted to the output,
+   * then release the Mesh.
+   */
+  void GenerateOutput(vtkPolyData* output);
+
   /**
    * Do the dirty work of eliminating the edge; return the number of
    * triangles deleted.
@@ -216,6 +231,18 @@ protected:
    */
   void AddBoundaryConstraints();
 
+  /**
+   * Compute in QEM the quadric of the triangle pts of the Mesh, along with
+   * its unit normal n and plane offset d. Return the area of the triangle.
+   */
+  double ComputeTriangleQuadric(const vtkIdType pts[3], double* QEM, double n[3], double& d);
+
+  /**
+   * Compute in QEM the geometric quadric constraining the boundary edge
+   * (pts[i], pts[(i + 1) % 3]) of the triangle pts. Return its weight.
+   */
+  double ComputeBoundaryQuadric(const vtkIdType pts[3], int i, double* QEM);
+
   /**
    * Compute quadric for this vertex.
    */
@@ -236,6 +263,17 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  ///@{
+  /**
+   * Same as above for the edge between two points, using the given scratch
+   * buffers instead of TempQuad, TempB and TempA so that costs can be
+   * computed concurrently.
+   */
+  double ComputeCost(const vtkIdType pointIds[2], double* x, double* quad);
+  double ComputeCost2(
+    const vtkIdType pointIds[2], double* x, double* quad, double* b, double** a);
+  ///@}
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -13,11 +14,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
@@ -109,6 +115,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->NumberOfIterations = 20;
 
   this->RelaxationFactor = .01;
+  this->JacobiSmoothing = 0;
 
   this->FeatureAngle = 45.0;
   this->EdgeAngle = 15.0;
@@ -274,6 +281,348 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// Move all the points toward the positions of their neighbors at the end of
+// the previous iteration (Jacobi iterations). The points are moved in
+// parallel, and the result does not depend on the number of threads.
+template <typename T>
+void vtkSPDF_MovePointsJacobi(vtkSPDF_InternalParams<T>& params)
+{
+  T* coords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> prevCoords(3 * params.numPts);
+  const T* prev = prevCoords.data();
+  vtkSMPThreadLocal<T> tlMaxDist(0);
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  const int maxCellSize = params.source ? params.source->GetMaxCellSize() : 0;
+  if (params.source && params.source->NeedToBuildCells())
+  {
+    params.source->BuildCells(); // for thread safety of GetCell later on
+  }
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
+      if (params.spdf->CheckAbort())
+      {
+        break;
+      }
+    }
+
+    vtkSMPTools::For(0, params.numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      std::copy(coords + 3 * ptId, coords + 3 * endPtId, prevCoords.begin() + 3 * ptId);
+    });
+    for (T& localMaxDist : tlMaxDist)
+    {
+      localMaxDist = 0.0;
+    }
+
+    // For each non-fixed vertex of the mesh, move the point toward the mean
+    // position of its connected neighbors using the relaxation factor.
+    vtkSMPTools::For(0, params.numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      T& localMaxDist = tlMaxDist.Local();
+      vtkGenericCell* cell = tlCell.Local();
+      std::vector<double>& weights = tlWeights.Local();
+      weights.resize(maxCellSize);
+      T deltaX[3];
+      double dist2, xNew[3], closestPt[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkMeshVertex& vert = params.vertexPtr[ptId];
+        vtkIdType npts;
+        if (vert.type == VTK_FIXED_VERTEX || !vert.edges ||
+          (npts = vert.edges->GetNumberOfIds()) <= 0)
+        {
+          continue;
+        }
+
+        // Compute the mean (cumulated) direction vector
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+        const vtkIdType* edgeIdPtr = vert.edges->GetPointer(0);
+        for (vtkIdType j = 0; j < npts; ++j, ++edgeIdPtr)
+        {
+          for (int k = 0; k < 3; ++k)
+          {
+            deltaX[k] += prev[3 * (*edgeIdPtr) + k];
+          }
+        } // for all connected points
+
+        // Move the point
+        T* x = coords + 3 * ptId;
+        for (int k = 0; k < 3; ++k)
+        {
+          x[k] = prev[3 * ptId + k] + params.factor * (deltaX[k] / npts - prev[3 * ptId + k]);
+          xNew[k] = x[k];
+        }
+
+        // Constrain point to surface
+        if (params.source)
+        {
+          vtkSmoothPoint* sPtr = params.SmoothPoints->GetSmoothPoint(ptId);
+          bool inCell = false;
+          if (sPtr->cellId >= 0) // in cell
+          {
+            params.source->GetCell(sPtr->cellId, cell);
+            const int status = cell->EvaluatePosition(
+              xNew, closestPt, sPtr->subId, sPtr->p, dist2, weights.data());
+            inCell = status != 0;
+          }
+          if (!inCell) // not in cell anymore
+          {
+            params.cellLocator->FindClosestPoint(
+              xNew, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+          }
+          for (int k = 0; k < 3; ++k)
+          {
+            x[k] = static_cast<T>(closestPt[k]);
+          }
+        }
+
+        localMaxDist = std::max(localMaxDist, static_cast<T>(vtkMath::Norm(deltaX)));
+      } // for all points
+    });
+
+    maxDist = 0.0;
+    for (T localMaxDist : tlMaxDist)
+    {
+      maxDist = std::max(maxDist, localMaxDist);
+    }
+  } // for not converged or within iteration count
+  params.newPts->Modified();
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
+// Edges of the polygons which were already analyzed from a neighbor polygon
+constexpr signed char VTK_VISITED_EDGE = -1;
+
+// Classify the edges of the polygons of the mesh. An edge is either visited
+// from a neighbor polygon with a smaller id, or a simple, feature or boundary
+// edge. The type of the i-th edge of a polygon is stored at the offset of its
+// i-th point in the connectivity of the polygons.
+struct ClassifyEdges
+{
+  vtkPolyData* Mesh;
+  vtkPoints* InPts;
+  signed char* EdgeTypes;
+  vtkTypeBool FeatureEdgeSmoothing;
+  double CosFeatureAngle;
+  vtkSmoothPolyDataFilter* Filter;
+  vtkSMPThreadLocalObject<vtkIdList> Neighbors;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocalObject<vtkIdList> NeiPoints;
+
+  ClassifyEdges(vtkPolyData* mesh, vtkPoints* inPts, signed char* edgeTypes,
+    vtkTypeBool featureEdgeSmoothing, double cosFeatureAngle, vtkSmoothPolyDataFilter* filter)
+    : Mesh(mesh)
+    , InPts(inPts)
+    , EdgeTypes(edgeTypes)
+    , FeatureEdgeSmoothing(featureEdgeSmoothing)
+    , CosFeatureAngle(cosFeatureAngle)
+    , Filter(filter)
+  {
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArray* polys = this->Mesh->GetPolys();
+    vtkIdList* neighbors = this->Neighbors.Local();
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    vtkIdList* neiPoints = this->NeiPoints.Local();
+    vtkIdType npts, numNei, nei, numNeiPts, j;
+    const vtkIdType *pts, *neiPts;
+    double normal[3], neiNormal[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      polys->GetCellAtId(cellId, npts, pts, cellPoints);
+      signed char* edgeTypes = this->EdgeTypes + polys->GetOffset(cellId);
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        this->Mesh->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % npts], neighbors);
+        numNei = neighbors->GetNumberOfIds();
+
+        signed char edge = VTK_SIMPLE_VERTEX;
+        if (numNei == 0)
+        {
+          edge = VTK_BOUNDARY_EDGE_VERTEX;
+        }
+
+        else if (numNei >= 2)
+        {
+          // check to make sure that this edge hasn't been marked already
+          for (j = 0; j < numNei; j++)
+          {
+            if (neighbors->GetId(j) < cellId)
+            {
+              break;
+            }
+          }
+          if (j >= numNei)
+          {
+            edge = VTK_FEATURE_EDGE_VERTEX;
+          }
+        }
+
+        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
+        {
+          if (this->FeatureEdgeSmoothing)
+          {
+            vtkPolygon::ComputeNormal(this->InPts, npts, pts, normal);
+            polys->GetCellAtId(nei, numNeiPts, neiPts, neiPoints);
+            vtkPolygon::ComputeNormal(this->InPts, numNeiPts, neiPts, neiNormal);
+
+            if (vtkMath::Dot(normal, neiNormal) <= this->CosFeatureAngle)
+            {
+              edge = VTK_FEATURE_EDGE_VERTEX;
+            }
+          }
+        }
+        else // a visited edge; skip rest of analysis
+        {
+          edge = VTK_VISITED_EDGE;
+        }
+        edgeTypes[i] = edge;
+      }
+    }
+  }
+};
+
+// Update the classification and the connected edges of a vertex with one of
+// its edges.
+void UpdateMeshVertex(vtkMeshVertex& vertex, vtkIdType otherPtId, int edge)
+{
+  if (edge && vertex.type == VTK_SIMPLE_VERTEX)
+  {
+    vertex.edges->Reset();
+    vertex.edges->InsertNextId(otherPtId);
+    vertex.type = edge;
+  }
+  else if ((edge && vertex.type == VTK_BOUNDARY_EDGE_VERTEX) ||
+    (edge && vertex.type == VTK_FEATURE_EDGE_VERTEX) ||
+    (!edge && vertex.type == VTK_SIMPLE_VERTEX))
+  {
+    vertex.edges->InsertNextId(otherPtId);
+    if (vertex.type && edge == VTK_BOUNDARY_EDGE_VERTEX)
+    {
+      vertex.type = VTK_BOUNDARY_EDGE_VERTEX;
+    }
+  }
+}
+
+// Build the connected edges of the vertices of the polygons from the
+// classified edges. The polygons using a vertex are visited in increasing
+// order, so that each vertex goes through the same states, and lists its
+// edges in the same order, as when the polygons are traversed one after the
+// other.
+struct BuildVertexEdges
+{
+  vtkPolyData* Mesh;
+  const signed char* EdgeTypes;
+  vtkMeshVertex* Verts;
+  vtkSmoothPolyDataFilter* Filter;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Cells;
+
+  BuildVertexEdges(vtkPolyData* mesh, const signed char* edgeTypes, vtkMeshVertex* verts,
+    vtkSmoothPolyDataFilter* filter)
+    : Mesh(mesh)
+    , EdgeTypes(edgeTypes)
+    , Verts(verts)
+    , Filter(filter)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkCellArray* polys = this->Mesh->GetPolys();
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    std::vector<vtkIdType>& sortedCells = this->Cells.Local();
+    vtkIdType ncells, npts;
+    vtkIdType* cells;
+    const vtkIdType* pts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      this->Mesh->GetPointCells(ptId, ncells, cells);
+      if (ncells == 0)
+      {
+        continue;
+      }
+      vtkMeshVertex& vertex = this->Verts[ptId];
+      if (vertex.edges == nullptr)
+      {
+        vertex.edges = vtkIdList::New();
+        vertex.edges->Allocate(16, 6);
+      }
+
+      sortedCells.assign(cells, cells + ncells);
+      std::sort(sortedCells.begin(), sortedCells.end());
+      sortedCells.erase(std::unique(sortedCells.begin(), sortedCells.end()), sortedCells.end());
+      for (vtkIdType cellId : sortedCells)
+      {
+        polys->GetCellAtId(cellId, npts, pts, cellPoints);
+        const signed char* edgeTypes = this->EdgeTypes + polys->GetOffset(cellId);
+        for (vtkIdType i = 0; i < npts; i++)
+        {
+          if (edgeTypes[i] == VTK_VISITED_EDGE)
+          {
+            continue;
+          }
+          const vtkIdType p1 = pts[i];
+          const vtkIdType p2 = pts[(i + 1) % npts];
+          if (p1 == ptId)
+          {
+            UpdateMeshVertex(vertex, p2, edgeTypes[i]);
+          }
+          if (p2 == ptId)
+          {
+            UpdateMeshVertex(vertex, p1, edgeTypes[i]);
+          }
+        }
+      }
+    }
+  }
+};
+
+// The number of vertices of each type, for debugging
+struct VertexCounts
+{
+  vtkIdType NumSimple = 0;
+  vtkIdType NumBEdges = 0;
+  vtkIdType NumFixed = 0;
+  vtkIdType NumFEdges = 0;
+};
+
 } // namespace
 
 //------------------------------------------------------------------------------
@@ -295,15 +644,13 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numPts, numCells, i, numPolys, numStrips;
-  int j, k;
+  int j;
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
   double conv;
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double x2[3], x3[3];
   double CosFeatureAngle; // Cosine of angle between adjacent polys
   double CosEdgeAngle;    // Cosine of angle between adjacent edges
-  double closestPt[3], dist2;
   vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
   vtkPolyData* Mesh;
   vtkPoints* inPts;
@@ -419,16 +766,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (numPolys > 0 || numStrips > 0)
   { // build cell structure
-    vtkCellArray* polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-
-    vtkNew<vtkIdList> neighbors;
-    neighbors->Allocate(VTK_CELL_SIZE);
-
     vtkNew<vtkPolyData> inMesh;
     inMesh->SetPoints(inPts);
     inMesh->SetPolys(inPolys);
@@ -445,181 +782,110 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     Mesh->BuildLinks(); // to do neighborhood searching
-    polys = Mesh->GetPolys();
     this->UpdateProgress(0.375);
 
-    checkAbortInterval = std::min(polys->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
+    // Classify the edges of the polygons, then update the vertices from the
+    // edges using them. Both passes are threaded.
+    std::vector<signed char> edgeTypes(Mesh->GetPolys()->GetNumberOfConnectivityIds());
+    ClassifyEdges classifyEdges(
+      Mesh, inPts, edgeTypes.data(), this->FeatureEdgeSmoothing, CosFeatureAngle, this);
+    vtkSMPTools::For(0, Mesh->GetPolys()->GetNumberOfCells(), classifyEdges);
 
-    for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
+    if (!this->GetAbortOutput())
     {
-      if (cellId % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-      for (i = 0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i + 1) % npts];
-
-        if (Verts[p1].edges == nullptr)
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16, 6);
-        }
-        if (Verts[p2].edges == nullptr)
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16, 6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j = 0; j < numNei; j++)
-          {
-            if (neighbors->GetId(j) < cellId)
-            {
-              break;
-            }
-          }
-          if (j >= numNei)
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if (edge && Verts[p1].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ((edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if (Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if (edge && Verts[p2].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ((edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if (Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
+      BuildVertexEdges buildVertexEdges(Mesh, edgeTypes.data(), Verts, this);
+      vtkSMPTools::For(0, numPts, buildVertexEdges);
     }
   } // if strips or polys
 
   this->UpdateProgress(0.50);
 
-  checkAbortInterval = std::min(numPts / 10 + 1, (vtkIdType)1000);
-
   // post-process edge vertices to make sure we can smooth them
-  for (i = 0; i < numPts; i++)
-  {
-    if (i % checkAbortInterval == 0 && this->CheckAbort())
+  vtkSMPThreadLocal<VertexCounts> localCounts;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    VertexCounts& counts = localCounts.Local();
+    double x1[3], x2[3], x3[3], l1[3], l2[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
     {
-      break;
-    }
-    if (Verts[i].type == VTK_SIMPLE_VERTEX)
-    {
-      numSimple++;
-    }
-
-    else if (Verts[i].type == VTK_FIXED_VERTEX)
-    {
-      numFixed++;
-    }
-
-    else if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX || Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-    { // see how many edges; if two, what the angle is
-
-      if (!this->BoundarySmoothing && Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
+      if (ptId % checkAbortInterval == 0)
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
       }
-
-      else if ((npts = Verts[i].edges->GetNumberOfIds()) != 2)
+      vtkMeshVertex& vertex = Verts[ptId];
+      if (vertex.type == VTK_SIMPLE_VERTEX)
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numFixed++;
+        counts.NumSimple++;
       }
 
-      else // check angle between edges
+      else if (vertex.type == VTK_FIXED_VERTEX)
       {
-        inPts->GetPoint(Verts[i].edges->GetId(0), x1);
-        inPts->GetPoint(i, x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1), x3);
+        counts.NumFixed++;
+      }
 
-        for (k = 0; k < 3; k++)
+      else if (vertex.type == VTK_FEATURE_EDGE_VERTEX || vertex.type == VTK_BOUNDARY_EDGE_VERTEX)
+      { // see how many edges; if two, what the angle is
+
+        if (!this->BoundarySmoothing && vertex.type == VTK_BOUNDARY_EDGE_VERTEX)
         {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
+          vertex.type = VTK_FIXED_VERTEX;
+          counts.NumBEdges++;
         }
-        if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
-          vtkMath::Dot(l1, l2) < CosEdgeAngle)
+
+        else if (vertex.edges->GetNumberOfIds() != 2)
         {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          vertex.type = VTK_FIXED_VERTEX;
+          counts.NumFixed++;
         }
-        else
+
+        else // check angle between edges
         {
-          if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX)
+          inPts->GetPoint(vertex.edges->GetId(0), x1);
+          inPts->GetPoint(ptId, x2);
+          inPts->GetPoint(vertex.edges->GetId(1), x3);
+
+          for (int k = 0; k < 3; k++)
           {
-            numFEdges++;
+            l1[k] = x2[k] - x1[k];
+            l2[k] = x3[k] - x2[k];
+          }
+          if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
+            vtkMath::Dot(l1, l2) < CosEdgeAngle)
+          {
+            counts.NumFixed++;
+            vertex.type = VTK_FIXED_VERTEX;
           }
           else
           {
-            numBEdges++;
+            if (vertex.type == VTK_FEATURE_EDGE_VERTEX)
+            {
+              counts.NumFEdges++;
+            }
+            else
+            {
+              counts.NumBEdges++;
+            }
           }
-        }
-      } // if along edge
-    }   // if edge vertex
-  }     // for all points
+        } // if along edge
+      }   // if edge vertex
+    }     // for all points
+  });
+  for (const VertexCounts& counts : localCounts)
+  {
+    numSimple += counts.NumSimple;
+    numBEdges += counts.NumBEdges;
+    numFixed += counts.NumFixed;
+    numFEdges += counts.NumFEdges;
+  }
 
   vtkDebugMacro(<< "Found\n\t" << numSimple << " simple vertices\n\t" << numFEdges
                 << " feature edge vertices\n\t" << numBEdges << " boundary edge vertices\n\t"
@@ -658,27 +924,37 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   if (source)
   {
     this->SmoothPoints = std::unique_ptr<vtkSmoothPoints>(new vtkSmoothPoints);
-    vtkSmoothPoint* sPtr;
     cellLocator.TakeReference(vtkCellLocator::New());
     auto maxCellSize = source->GetMaxCellSize();
     w.reset(new double[maxCellSize]);
     cellLocator->SetDataSet(source);
     cellLocator->BuildLocator();
 
-    for (i = 0; i < numPts; i++)
-    {
-      sPtr = this->SmoothPoints->InsertSmoothPoint(i);
-      cellLocator->FindClosestPoint(
-        inPts->GetPoint(i), closestPt, sPtr->cellId, sPtr->subId, dist2);
-      newPts->SetPoint(i, closestPt);
-    }
+    this->SmoothPoints->InsertSmoothPoint(numPts - 1); // allocate all the points
+    vtkSmoothPoints* smoothPoints = this->SmoothPoints.get();
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      vtkGenericCell* cell = tlCell.Local();
+      double x[3], closestPt[3], dist2;
+      for (; ptId < endPtId; ++ptId)
+      {
+        vtkSmoothPoint* sPtr = smoothPoints->GetSmoothPoint(ptId);
+        inPts->GetPoint(ptId, x);
+        cellLocator->FindClosestPoint(x, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+        newPts->SetPoint(ptId, closestPt);
+      }
+    });
   }
   else // smooth normally
   {
-    for (i = 0; i < numPts; i++) // initialize to old coordinates
-    {
-      newPts->SetPoint(i, inPts->GetPoint(i));
-    }
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId) // initialize to old coordinates
+      {
+        inPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptId, x);
+      }
+    });
   }
 
   if (newPts->GetDataType() == VTK_DOUBLE)
@@ -687,7 +963,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints.get(), w.get(),
       cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->JacobiSmoothing)
+    {
+      vtkSPDF_MovePointsJacobi(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
   else
   {
@@ -695,7 +978,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
       this->SmoothPoints.get(), w.get(), cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->JacobiSmoothing)
+    {
+      vtkSPDF_MovePointsJacobi(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
 
   // Release memory if it's been allocated
@@ -710,12 +1000,15 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     vtkNew<vtkFloatArray> newScalars;
     newScalars->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      newScalars->SetComponent(i, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
-    }
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x1[3], x2[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        inPts->GetPoint(ptId, x1);
+        newPts->GetPoint(ptId, x2);
+        newScalars->SetComponent(ptId, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
+      }
+    });
     int idx = output->GetPointData()->AddArray(newScalars);
     output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
@@ -725,16 +1018,19 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     vtkNew<vtkFloatArray> newVectors;
     newVectors->SetNumberOfComponents(3);
     newVectors->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      for (j = 0; j < 3; j++)
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x1[3], x2[3], x3[3];
+      for (; ptId < endPtId; ++ptId)
       {
-        x3[j] = x2[j] - x1[j];
+        inPts->GetPoint(ptId, x1);
+        newPts->GetPoint(ptId, x2);
+        for (int k = 0; k < 3; k++)
+        {
+          x3[k] = x2[k] - x1[k];
+        }
+        newVectors->SetTuple(ptId, x3);
       }
-      newVectors->SetTuple(i, x3);
-    }
+    });
     output->GetPointData()->SetVectors(newVectors);
   }
 
@@ -781,6 +1077,7 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Convergence: " << this->Convergence << "\n";
   os << indent << "Number of Iterations: " << this->NumberOfIterations << "\n";
   os << indent << "Relaxation Factor: " << this->RelaxationFactor << "\n";
+  os << indent << "Jacobi Smoothing: " << (this->JacobiSmoothing ? "On\n" : "Off\n");
   os << indent << "Feature Edge Smoothing: " << (this->FeatureEdgeSmoothing ? "On\n" : "Off\n");
   os << indent << "Feature Angle: " << this->FeatureAngle << "\n";
   os << indent << "Edge Angle: " << this->EdgeAngle << "\n";
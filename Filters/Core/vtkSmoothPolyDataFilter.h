@@ -140,6 +140,22 @@ public:
   vtkGetMacro(RelaxationFactor, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off Jacobi smoothing iterations. By default, an iteration moves
+   * the points one after the other and in place, so that each point is
+   * moved toward the neighbors already moved during the same iteration
+   * (Gauss-Seidel iterations), which is sequential. If on, an iteration moves
+   * every point toward the positions of its neighbors at the end of the
+   * previous iteration, and the points are moved in parallel with
+   * vtkSMPTools. The result differs slightly from the default one, but does
+   * not depend on the number of threads. Off by default.
+   */
+  vtkSetMacro(JacobiSmoothing, vtkTypeBool);
+  vtkGetMacro(JacobiSmoothing, vtkTypeBool);
+  vtkBooleanMacro(JacobiSmoothing, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Turn on/off smoothing along sharp interior edges.
@@ -223,6 +239,7 @@ protected:
   double Convergence;
   int NumberOfIterations;
   double RelaxationFactor;
+  vtkTypeBool JacobiSmoothing;
   vtkTypeBool FeatureEdgeSmoothing;
   double FeatureAngle;
   double EdgeAngle;
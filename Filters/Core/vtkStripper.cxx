@@ -4,20 +4,350 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStripper);
 
+namespace
+{
+
+struct StripperLocalData;
+
+// An output cell grown from a starting cell of the mesh: a triangle strip, a
+// poly-line, or a polygon passed through.
+struct StripperCell
+{
+  vtkIdType StartCellId;
+  int Type; // VTK_TRIANGLE_STRIP, VTK_POLY_LINE or VTK_POLYGON
+  vtkIdType PointsBegin;
+  vtkIdType NumberOfPoints;
+  // the mesh cells whose data is passed as field data
+  vtkIdType CellsBegin;
+  vtkIdType NumberOfCells;
+  const StripperLocalData* Local;
+  // where the cell goes in the output
+  vtkIdType OutputCellId;
+  vtkIdType OutputPointsBegin;
+  vtkIdType OutputCellsBegin;
+};
+
+// The output cells of the regions stripped by a thread
+struct StripperLocalData
+{
+  vtkSmartPointer<vtkIdList> CellIds;
+  vtkSmartPointer<vtkIdList> PointIds;
+  std::vector<vtkIdType> WorkingPoints;
+  std::vector<StripperCell> OutputCells;
+  std::vector<vtkIdType> Points;
+  std::vector<vtkIdType> Cells;
+  vtkIdType NumberOfStrips = 0;
+  int LongestStrip = 0;
+  vtkIdType NumberOfLines = 0;
+  int LongestLine = 0;
+
+  void BeginCell(vtkIdType startCellId, int type)
+  {
+    StripperCell cell;
+    cell.StartCellId = startCellId;
+    cell.Type = type;
+    cell.PointsBegin = cell.NumberOfPoints = 0;
+    cell.CellsBegin = static_cast<vtkIdType>(this->Cells.size());
+    cell.NumberOfCells = 0;
+    cell.Local = nullptr;
+    cell.OutputCellId = cell.OutputPointsBegin = cell.OutputCellsBegin = 0;
+    this->OutputCells.push_back(cell);
+    this->Cells.push_back(startCellId);
+  }
+
+  void EndCell(vtkIdType npts, const vtkIdType* pts)
+  {
+    StripperCell& cell = this->OutputCells.back();
+    cell.PointsBegin = static_cast<vtkIdType>(this->Points.size());
+    cell.NumberOfPoints = npts;
+    this->Points.insert(this->Points.end(), pts, pts + npts);
+    cell.NumberOfCells = static_cast<vtkIdType>(this->Cells.size()) - cell.CellsBegin;
+  }
+};
+
+// Grows the triangle strips and poly-lines from the cells of the mesh. A strip
+// or a poly-line only grows through cells sharing points, so that the regions
+// of connected cells are stripped independently. Stripping the cells of a
+// region by increasing ids gives the cells of the serial algorithm. The
+// neighbors are looked up by decreasing ids, as the links built by a single
+// thread list them, so that the walk does not depend on how the links were
+// built.
+struct StripperWalker
+{
+  vtkPolyData* Mesh;
+  char* Visited;
+  int MaximumLength;
+
+  void Strip(vtkIdType cellId, StripperLocalData& local) const
+  {
+    vtkPolyData* mesh = this->Mesh;
+    char* visited = this->Visited;
+    if (!local.CellIds)
+    {
+      local.CellIds = vtkSmartPointer<vtkIdList>::New();
+      local.CellIds->Allocate(this->MaximumLength + 2);
+      local.PointIds = vtkSmartPointer<vtkIdList>::New();
+      local.WorkingPoints.resize(this->MaximumLength + 2);
+    }
+    vtkIdList* cellIds = local.CellIds;
+    vtkIdType* pts = local.WorkingPoints.data();
+    vtkIdType npts;
+    const vtkIdType* cellPts;
+    vtkIdType neighbor = 0;
+    int numPts, i, j;
+
+    visited[cellId] = 1;
+    const int cellType = mesh->GetCellType(cellId);
+    if (cellType == VTK_TRIANGLE)
+    {
+      //  Got a starting point for the strip.  Initialize.  Find a neighbor
+      //  to extend strip.
+      //
+      local.NumberOfStrips++;
+      numPts = 3;
+
+      mesh->GetCellPoints(cellId, npts, cellPts, local.PointIds);
+
+      for (i = 0; i < 3; i++)
+      {
+        pts[1] = cellPts[i];
+        pts[2] = cellPts[(i + 1) % 3];
+
+        mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
+        std::sort(cellIds->begin(), cellIds->end(), std::greater<vtkIdType>());
+        if (cellIds->GetNumberOfIds() > 0 && !visited[neighbor = cellIds->GetId(0)] &&
+          mesh->GetCellType(neighbor) == VTK_TRIANGLE)
+        {
+          pts[0] = cellPts[(i + 2) % 3];
+          break;
+        }
+      }
+
+      local.BeginCell(cellId, VTK_TRIANGLE_STRIP);
+      //  If no unvisited neighbor, just create the strip of one triangle.
+      //
+      if (i >= 3)
+      {
+        local.EndCell(3, cellPts);
+      }
+      else // continue strip
+      {
+        //  Have a neighbor.  March along grabbing new points
+        //
+        while (neighbor >= 0)
+        {
+          visited[neighbor] = 1;
+          mesh->GetCellPoints(neighbor, npts, cellPts, local.PointIds);
+          local.Cells.push_back(neighbor);
+          for (i = 0; i < 3; i++)
+          {
+            if (cellPts[i] != pts[numPts - 2] && cellPts[i] != pts[numPts - 1])
+            {
+              break;
+            }
+          }
+
+          // only add the triangle to the strip if it isn't degenerate.
+          if (i < 3)
+          {
+            pts[numPts] = cellPts[i];
+            mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+            std::sort(cellIds->begin(), cellIds->end(), std::greater<vtkIdType>());
+            numPts++;
+          }
+
+          if (numPts > local.LongestStrip)
+          {
+            local.LongestStrip = numPts;
+          }
+
+          // note: if updates value of neighbor
+          // Note2: for a degenerate triangle this test will
+          // correctly fail because the visited[neighbor] will
+          // now be visited
+          if (cellIds->GetNumberOfIds() <= 0 || visited[neighbor = cellIds->GetId(0)] ||
+            mesh->GetCellType(neighbor) != VTK_TRIANGLE || numPts >= (this->MaximumLength + 2))
+          {
+            local.EndCell(numPts, pts);
+            neighbor = (-1);
+          }
+        } // while
+      }   // else continue strip
+    }     // if triangle
+
+    else if (cellType == VTK_LINE)
+    {
+      //
+      //  Got a starting point for the line.  Initialize.  Find a neighbor
+      //  to extend poly-line.
+      //
+      local.NumberOfLines++;
+      numPts = 2;
+
+      mesh->GetCellPoints(cellId, npts, cellPts, local.PointIds);
+
+      bool foundOne = false;
+      for (i = 0; !foundOne && i < 2; i++)
+      {
+        pts[0] = cellPts[i];
+        pts[1] = cellPts[(i + 1) % 2];
+        mesh->GetPointCells(pts[1], cellIds);
+        std::sort(cellIds->begin(), cellIds->end(), std::greater<vtkIdType>());
+        for (j = 0; j < cellIds->GetNumberOfIds(); j++)
+        {
+          neighbor = cellIds->GetId(j);
+          if (neighbor != cellId && !visited[neighbor] && mesh->GetCellType(neighbor) == VTK_LINE)
+          {
+            foundOne = true;
+            break;
+          }
+        }
+      }
+
+      // for each polyline that we construct, we set the cell data to be that
+      // for the first cell that formed the polyline.
+      local.BeginCell(cellId, VTK_POLY_LINE);
+      //  If no unvisited neighbor, just create the poly-line from one line.
+      //
+      if (!foundOne)
+      {
+        local.EndCell(2, cellPts);
+      }
+      else // continue poly-line
+      {
+        //  Have a neighbor.  March along grabbing new points
+        //
+        while (neighbor >= 0)
+        {
+          visited[neighbor] = 1;
+          mesh->GetCellPoints(neighbor, npts, cellPts, local.PointIds);
+          for (i = 0; i < 2; i++)
+          {
+            if (cellPts[i] != pts[numPts - 1])
+            {
+              break;
+            }
+          }
+          pts[numPts] = cellPts[i];
+          mesh->GetPointCells(pts[numPts], cellIds);
+          std::sort(cellIds->begin(), cellIds->end(), std::greater<vtkIdType>());
+          if (++numPts > local.LongestLine)
+          {
+            local.LongestLine = numPts;
+          }
+
+          // get new neighbor
+          for (j = 0; j < cellIds->GetNumberOfIds(); j++)
+          {
+            const vtkIdType nei = cellIds->GetId(j);
+            if (nei != neighbor && !visited[nei] && mesh->GetCellType(nei) == VTK_LINE)
+            {
+              neighbor = nei;
+              break;
+            }
+          }
+
+          if (j >= cellIds->GetNumberOfIds() || numPts >= (this->MaximumLength + 1))
+          {
+            local.EndCell(numPts, pts);
+            neighbor = (-1);
+          }
+        } // while
+      }   // else continue line
+    }     // if line
+
+    // not line, triangle, or strip must be quad or tpolygon which we pass through
+    else if (cellType == VTK_POLYGON || cellType == VTK_QUAD)
+    {
+      mesh->GetCellPoints(cellId, npts, cellPts, local.PointIds);
+      local.BeginCell(cellId, VTK_POLYGON);
+      local.EndCell(npts, cellPts);
+    }
+  }
+};
+
+// The cells of one type in the output: the input cells passed through, then
+// the cells grown from the mesh. The field data of each cell comes from the
+// input cells in SourceIds.
+struct StripperOutput
+{
+  vtkNew<vtkIdTypeArray> Offsets;
+  vtkNew<vtkIdTypeArray> Connectivity;
+  std::vector<vtkIdType> SourceIds;
+  vtkIdType NumberOfCells = 0;
+  vtkIdType ConnectivitySize = 0;
+  vtkIdType NumberOfSourceIds = 0;
+
+  void PassCell(vtkIdType npts, const vtkIdType* pts)
+  {
+    this->Offsets->InsertNextValue(this->ConnectivitySize);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      this->Connectivity->InsertNextValue(pts[i]);
+    }
+    this->NumberOfCells++;
+    this->ConnectivitySize += npts;
+  }
+
+  // Compute where a grown cell goes, after the cells already there
+  void PlaceCell(StripperCell& cell)
+  {
+    cell.OutputCellId = this->NumberOfCells++;
+    cell.OutputPointsBegin = this->ConnectivitySize;
+    this->ConnectivitySize += cell.NumberOfPoints;
+    cell.OutputCellsBegin = this->NumberOfSourceIds;
+    this->NumberOfSourceIds += cell.NumberOfCells;
+  }
+
+  void Allocate()
+  {
+    this->Offsets->SetNumberOfValues(this->NumberOfCells + 1);
+    this->Offsets->SetValue(this->NumberOfCells, this->ConnectivitySize);
+    this->Connectivity->SetNumberOfValues(this->ConnectivitySize);
+    this->SourceIds.resize(this->NumberOfSourceIds);
+  }
+
+  void CopyCell(const StripperCell& cell)
+  {
+    this->Offsets->SetValue(cell.OutputCellId, cell.OutputPointsBegin);
+    std::copy_n(cell.Local->Points.data() + cell.PointsBegin, cell.NumberOfPoints,
+      this->Connectivity->GetPointer(cell.OutputPointsBegin));
+    std::copy_n(cell.Local->Cells.data() + cell.CellsBegin, cell.NumberOfCells,
+      this->SourceIds.data() + cell.OutputCellsBegin);
+  }
+
+  vtkSmartPointer<vtkCellArray> GetCells()
+  {
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(this->Offsets, this->Connectivity);
+    return cells;
+  }
+};
+
+} // anonymous namespace
+
 // Construct object with MaximumLength set to 1000.
 vtkStripper::vtkStripper()
 {
@@ -40,32 +370,15 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType cellId, numCells, i;
-  int longestStrip, longestLine, j, numPts;
-  vtkIdType numLines, numStrips, nei;
-  vtkCellArray *newStrips = nullptr, *inStrips, *newLines = nullptr, *inLines, *inPolys;
-  vtkCellArray* newPolys = nullptr;
+  vtkCellArray *inStrips, *inLines, *inPolys;
   vtkIdType numLinePts = 0;
-  vtkIdList* cellIds;
-  int foundOne;
-  vtkIdType *pts, neighbor = 0;
   vtkPolyData* mesh;
-  char* visited;
   vtkIdType numStripPts = 0;
   const vtkIdType* stripPts = nullptr;
   const vtkIdType* linePts = nullptr;
-  const vtkIdType* triPts;
-  vtkIdType numTriPts;
   vtkPointData* pd = input->GetPointData();
   vtkCellData* cd = input->GetCellData();
 
-  // The field data, needs to be ordered properly for rendering
-  // to work.Hence cell data for each type of cell is collected
-  // separately and appended later.
-  vtkFieldData* newfd = nullptr;
-  vtkFieldData* newfdPolys = nullptr;
-  vtkFieldData* newfdLines = nullptr;
-  vtkFieldData* newfdStrips = nullptr;
-
   vtkDebugMacro(<< "Executing triangle strip / poly-line filter");
 
   // build cell structure
@@ -73,8 +386,6 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   inLines = input->GetLines();
   inPolys = input->GetPolys();
   vtkIdType inNumVerts = input->GetVerts()->GetNumberOfCells();
-  vtkIdType inNumLines = inLines->GetNumberOfCells();
-  vtkIdType inNumPolys = inPolys->GetNumberOfCells();
 
   mesh = vtkPolyData::New();
   mesh->SetPoints(input->GetPoints());
@@ -96,98 +407,50 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  pts = new vtkIdType[this->MaximumLength + 2]; // working array
-  cellIds = vtkIdList::New();
-  cellIds->Allocate(this->MaximumLength + 2);
-
-  // The new field data object that maintains the transformed cell data.
-  if (this->PassCellDataAsFieldData)
-  {
-    newfd = vtkFieldData::New();
-    newfd->CopyStructure(cd);
-    newfd->Allocate(3 * numCells + 3);
-
-    newfdPolys = vtkFieldData::New();
-    newfdPolys->CopyStructure(cd);
-    newfdPolys->Allocate(inNumPolys + 1);
-
-    newfdLines = vtkFieldData::New();
-    newfdLines->CopyStructure(cd);
-    newfdLines->Allocate(inNumLines + 1);
-
-    newfdStrips = vtkFieldData::New();
-    newfdStrips->CopyStructure(cd);
-    // this is a very gross estimate since we cannot know how long the already
-    // present strips are.
-    newfdStrips->Allocate(3 * inNumPolys + 3);
-  }
-
   vtkUnsignedCharArray* ghostCells = input->GetCellData()->GetGhostArray();
 
-  vtkIdTypeArray* OriginalCellIds = nullptr;
-  vtkIdTypeArray* origPolyIds = nullptr;
-  vtkIdTypeArray* origLineIds = nullptr;
-  vtkIdTypeArray* origStripIds = nullptr;
-  if (this->PassThroughCellIds)
-  {
-    OriginalCellIds = vtkIdTypeArray::New();
-    OriginalCellIds->SetName("vtkOriginalCellIds");
-    OriginalCellIds->SetNumberOfComponents(1);
-    OriginalCellIds->Allocate(3 * numCells + 3);
-
-    origPolyIds = vtkIdTypeArray::New();
-    origPolyIds->SetNumberOfComponents(1);
-    origPolyIds->Allocate(inNumPolys + 1);
-
-    origLineIds = vtkIdTypeArray::New();
-    origLineIds->SetNumberOfComponents(1);
-    origLineIds->Allocate(inNumLines + 1);
-
-    origStripIds = vtkIdTypeArray::New();
-    origStripIds->SetNumberOfComponents(1);
-    origStripIds->Allocate(3 * inNumPolys + 3);
-  }
+  // The output cells of each type. The field data, needs to be ordered
+  // properly for rendering to work. Hence cell data for each type of cell is
+  // collected separately and appended later.
+  const bool hasStrips = inStrips->GetNumberOfCells() > 0 || inPolys->GetNumberOfCells() > 0;
+  const bool hasLines = inLines->GetNumberOfCells() > 0;
+  StripperOutput strips;
+  StripperOutput lines;
+  StripperOutput polys;
+  std::vector<vtkIdType> passedStripIds; // the original ids of the strips passed
 
   // pre-load existing strips
-  if (inStrips->GetNumberOfCells() > 0 || inPolys->GetNumberOfCells() > 0)
+  if (hasStrips)
   {
-    newStrips = vtkCellArray::New();
-    newStrips->AllocateEstimate(numCells, 6);
-    cellId = inNumVerts + inNumLines + inNumPolys;
+    cellId = inNumVerts + inLines->GetNumberOfCells() + inPolys->GetNumberOfCells();
     for (inStrips->InitTraversal(); inStrips->GetNextCell(numStripPts, stripPts);)
     {
       if (ghostCells && ghostCells->GetValue(cellId))
       {
         continue;
       }
-      newStrips->InsertNextCell(numStripPts, stripPts);
-      if (this->PassCellDataAsFieldData)
+      strips.PassCell(numStripPts, stripPts);
+      for (i = 2; i < numStripPts; i++)
       {
-        for (i = 2; i < numStripPts; i++)
-        {
-          newfdStrips->InsertNextTuple(cellId, cd);
-        }
+        strips.SourceIds.push_back(cellId);
       }
       if (this->PassThroughCellIds)
       {
-        origStripIds->InsertNextValue(cellId);
+        passedStripIds.push_back(cellId);
         for (i = 2; i < numStripPts; i++)
         {
-          origStripIds->InsertNextValue(cellId);
+          passedStripIds.push_back(cellId);
         }
       }
       cellId++;
     }
-    // These are for passing through non-triangle polygons
-    newPolys = vtkCellArray::New();
-    newPolys->AllocateEstimate(numCells / 2, 4);
   }
 
+  const vtkIdType numPassedStripSourceIds = static_cast<vtkIdType>(strips.SourceIds.size());
+
   // pre-load existing poly-lines
-  if (inLines->GetNumberOfCells() > 0)
+  if (hasLines)
   {
-    newLines = vtkCellArray::New();
-    newLines->AllocateEstimate(numCells, 6);
     cellId = inNumVerts;
     for (inLines->InitTraversal(); inLines->GetNextCell(numLinePts, linePts); cellId++)
     {
@@ -197,261 +460,139 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
       }
       if (numLinePts > 2)
       {
-        newLines->InsertNextCell(numLinePts, linePts);
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdLines->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origLineIds->InsertNextValue(cellId);
-        }
+        lines.PassCell(numLinePts, linePts);
+        lines.SourceIds.push_back(cellId);
       }
     }
   }
 
   // array keeps track of data that's been visited
-  visited = new char[numCells];
-  for (i = 0; i < numCells; i++)
+  std::vector<char> visited(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; id++)
+    {
+      visited[id] = ghostCells && ghostCells->GetValue(id) ? 1 : 0;
+    }
+  });
+
+  // Group the cells by region of cells connected through their points. The
+  // cells of a region are sorted by increasing id.
+  std::vector<vtkIdType> regionRoots;
+  std::vector<vtkIdType> regionOffsets;
+  std::vector<vtkIdType> regionCells;
+  if (numCells > 0)
   {
-    visited[i] = ghostCells && ghostCells->GetValue(i) ? 1 : 0;
+    vtkConnectedRegions regions(mesh, this);
+    regions.Connect();
+    if (!this->GetAbortOutput())
+    {
+      regionOffsets.resize(numCells + 1, 0);
+      for (cellId = 0; cellId < numCells; cellId++)
+      {
+        regionOffsets[regions.GetRoot(cellId) + 1]++;
+      }
+      for (cellId = 0; cellId < numCells; cellId++)
+      {
+        if (regionOffsets[cellId + 1] > 0)
+        {
+          regionRoots.push_back(cellId);
+        }
+        regionOffsets[cellId + 1] += regionOffsets[cellId];
+      }
+      regionCells.resize(numCells);
+      std::vector<vtkIdType> regionEnds(regionOffsets.begin(), regionOffsets.end() - 1);
+      for (cellId = 0; cellId < numCells; cellId++)
+      {
+        regionCells[regionEnds[regions.GetRoot(cellId)]++] = cellId;
+      }
+    }
   }
+  this->UpdateProgress(0.2);
 
-  // Loop over all cells and find one that hasn't been visited.
-  // Start a triangle strip (or poly-line) and mark as visited, and
+  // Loop over the cells of each region and find one that hasn't been
+  // visited. Start a triangle strip (or poly-line) and mark as visited, and
   // then find a neighbor that isn't visited.  Add this to the strip
   // (or poly-line) and mark as visited (and so on).
   //
-  longestStrip = 0;
-  numStrips = 0;
-  longestLine = 0;
-  numLines = 0;
-
-  int cellType;
-  bool abort = false;
-  vtkIdType progressInterval = numCells / 20 + 1;
-  for (cellId = 0; cellId < numCells && !abort; cellId++)
-  {
-    if (ghostCells && ghostCells->GetValue(cellId))
-    {
-      continue;
-    }
-    if (!(cellId % progressInterval))
-    {
-      this->UpdateProgress((float)cellId / numCells);
-      abort = this->CheckAbort();
-    }
-    if (!visited[cellId])
-    {
-      visited[cellId] = 1;
-      if ((cellType = mesh->GetCellType(cellId)) == VTK_TRIANGLE)
+  StripperWalker walker;
+  walker.Mesh = mesh;
+  walker.Visited = visited.data();
+  walker.MaximumLength = this->MaximumLength;
+  vtkSMPThreadLocal<StripperLocalData> localData;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regionRoots.size()),
+    [&](vtkIdType beginRegion, vtkIdType endRegion) {
+      StripperLocalData& local = localData.Local();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType regionId = beginRegion; regionId < endRegion; regionId++)
       {
-        //  Got a starting point for the strip.  Initialize.  Find a neighbor
-        //  to extend strip.
-        //
-        numStrips++;
-        numPts = 3;
-
-        mesh->GetCellPoints(cellId, numTriPts, triPts);
-
-        for (i = 0; i < 3; i++)
+        if (isFirst)
         {
-          pts[1] = triPts[i];
-          pts[2] = triPts[(i + 1) % 3];
-
-          mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
-          if (cellIds->GetNumberOfIds() > 0 && !visited[neighbor = cellIds->GetId(0)] &&
-            mesh->GetCellType(neighbor) == VTK_TRIANGLE)
-          {
-            pts[0] = triPts[(i + 2) % 3];
-            break;
-          }
+          this->CheckAbort();
         }
-        //  If no unvisited neighbor, just create the strip of one triangle.
-        //
-        if (i >= 3)
+        if (this->GetAbortOutput())
         {
-          pts[0] = triPts[0];
-          pts[1] = triPts[1];
-          pts[2] = triPts[2];
-          newStrips->InsertNextCell(3, pts);
-          if (this->PassCellDataAsFieldData)
-          {
-            newfdStrips->InsertNextTuple(cellId, cd);
-          }
-          if (this->PassThroughCellIds)
-          {
-            origStripIds->InsertNextValue(cellId);
-          }
+          break;
         }
-        else // continue strip
+        const vtkIdType root = regionRoots[regionId];
+        for (vtkIdType k = regionOffsets[root]; k < regionOffsets[root + 1]; k++)
         {
-          //  Have a neighbor.  March along grabbing new points
-          //
-          if (this->PassCellDataAsFieldData)
-          {
-            newfdStrips->InsertNextTuple(cellId, cd);
-          }
-          if (this->PassThroughCellIds)
+          if (!visited[regionCells[k]])
           {
-            origStripIds->InsertNextValue(cellId);
+            walker.Strip(regionCells[k], local);
           }
-          while (neighbor >= 0)
-          {
-            visited[neighbor] = 1;
-            mesh->GetCellPoints(neighbor, numTriPts, triPts);
-            if (this->PassCellDataAsFieldData)
-            {
-              newfdStrips->InsertNextTuple(neighbor, cd);
-            }
-            if (this->PassThroughCellIds)
-            {
-              origStripIds->InsertNextValue(neighbor);
-            }
-            for (i = 0; i < 3; i++)
-            {
-              if (triPts[i] != pts[numPts - 2] && triPts[i] != pts[numPts - 1])
-              {
-                break;
-              }
-            }
-
-            // only add the triangle to the strip if it isn't degenerate.
-            if (i < 3)
-            {
-              pts[numPts] = triPts[i];
-              mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
-              numPts++;
-            }
-
-            if (numPts > longestStrip)
-            {
-              longestStrip = numPts;
-            }
-
-            // note: if updates value of neighbor
-            // Note2: for a degenerate triangle this test will
-            // correctly fail because the visited[neighbor] will
-            // now be visited
-            if (cellIds->GetNumberOfIds() <= 0 || visited[neighbor = cellIds->GetId(0)] ||
-              mesh->GetCellType(neighbor) != VTK_TRIANGLE || numPts >= (this->MaximumLength + 2))
-            {
-              newStrips->InsertNextCell(numPts, pts);
-              neighbor = (-1);
-            }
-          } // while
-        }   // else continue strip
-      }     // if triangle
-
-      else if (cellType == VTK_LINE)
-      {
-        //
-        //  Got a starting point for the line.  Initialize.  Find a neighbor
-        //  to extend poly-line.
-        //
-        numLines++;
-        numPts = 2;
-
-        mesh->GetCellPoints(cellId, numLinePts, linePts);
-
-        for (foundOne = i = 0; !foundOne && i < 2; i++)
-        {
-          pts[0] = linePts[i];
-          pts[1] = linePts[(i + 1) % 2];
-          mesh->GetPointCells(pts[1], cellIds);
-          for (j = 0; j < cellIds->GetNumberOfIds(); j++)
-          {
-            neighbor = cellIds->GetId(j);
-            if (neighbor != cellId && !visited[neighbor] && mesh->GetCellType(neighbor) == VTK_LINE)
-            {
-              foundOne = 1;
-              break;
-            }
-          }
-        }
-
-        // for each polyline that we construct, we set the cell data to be that
-        // for the first cell that formed the polyline. We may build the field data
-        // for the mini-cells in the polyline, similar to triangle strips,
-        // but that is not required currently.
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdLines->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origLineIds->InsertNextValue(cellId);
         }
-        //  If no unvisited neighbor, just create the poly-line from one line.
-        //
-        if (!foundOne)
-        {
-          newLines->InsertNextCell(2, linePts);
-        }
-        else // continue poly-line
-        {
-          //  Have a neighbor.  March along grabbing new points
-          //
-          while (neighbor >= 0)
-          {
-            visited[neighbor] = 1;
-            mesh->GetCellPoints(neighbor, numLinePts, linePts);
-            for (i = 0; i < 2; i++)
-            {
-              if (linePts[i] != pts[numPts - 1])
-              {
-                break;
-              }
-            }
-            pts[numPts] = linePts[i];
-            mesh->GetPointCells(pts[numPts], cellIds);
-            if (++numPts > longestLine)
-            {
-              longestLine = numPts;
-            }
-
-            // get new neighbor
-            for (j = 0; j < cellIds->GetNumberOfIds(); j++)
-            {
-              nei = cellIds->GetId(j);
-              if (nei != neighbor && !visited[nei] && mesh->GetCellType(nei) == VTK_LINE)
-              {
-                neighbor = nei;
-                break;
-              }
-            }
-
-            if (j >= cellIds->GetNumberOfIds() || numPts >= (this->MaximumLength + 1))
-            {
-              newLines->InsertNextCell(numPts, pts);
-              neighbor = (-1);
-            }
-          } // while
-        }   // else continue line
-      }     // if line
-
-      // not line, triangle, or strip must be quad or tpolygon which we pass through
-      else if (cellType == VTK_POLYGON || cellType == VTK_QUAD)
+      }
+    });
+
+  // The cells are output in the order of their starting cells
+  std::vector<StripperCell> grownCells;
+  int longestStrip = 0;
+  vtkIdType numStrips = 0;
+  int longestLine = 0;
+  vtkIdType numLines = 0;
+  for (StripperLocalData& local : localData)
+  {
+    for (StripperCell& cell : local.OutputCells)
+    {
+      cell.Local = &local;
+    }
+    grownCells.insert(grownCells.end(), local.OutputCells.begin(), local.OutputCells.end());
+    numStrips += local.NumberOfStrips;
+    longestStrip = std::max(longestStrip, local.LongestStrip);
+    numLines += local.NumberOfLines;
+    longestLine = std::max(longestLine, local.LongestLine);
+  }
+  vtkSMPTools::Sort(grownCells.begin(), grownCells.end(),
+    [](const StripperCell& cell0, const StripperCell& cell1) {
+      return cell0.StartCellId < cell1.StartCellId;
+    });
+  this->UpdateProgress(0.8);
+
+  // Compute the offsets of the cells, then copy them to the output
+  strips.NumberOfSourceIds = static_cast<vtkIdType>(strips.SourceIds.size());
+  lines.NumberOfSourceIds = static_cast<vtkIdType>(lines.SourceIds.size());
+  StripperOutput* outputs[3] = { &strips, &lines, &polys };
+  auto getOutput = [&](int type) -> StripperOutput* {
+    return outputs[type == VTK_TRIANGLE_STRIP ? 0 : (type == VTK_POLY_LINE ? 1 : 2)];
+  };
+  for (StripperCell& cell : grownCells)
+  {
+    getOutput(cell.Type)->PlaceCell(cell);
+  }
+  for (StripperOutput* out : outputs)
+  {
+    out->Allocate();
+  }
+  vtkSMPTools::For(0, static_cast<vtkIdType>(grownCells.size()),
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType k = begin; k < end; k++)
       {
-        mesh->GetCellPoints(cellId, numTriPts, triPts);
-        newPolys->InsertNextCell(numTriPts, triPts);
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdPolys->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origPolyIds->InsertNextValue(cellId);
-        }
+        getOutput(grownCells[k].Type)->CopyCell(grownCells[k]);
       }
-
-    } // if not visited
-  }   // for all elements
+    });
 
   // Update output and release memory
   //
-  delete[] pts;
-  delete[] visited;
   mesh->Delete();
 
   output->SetPoints(input->GetPoints());
@@ -466,37 +607,37 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     outputPD->AddArray(originalPointIds);
     vtkIdType numTup = output->GetNumberOfPoints();
     originalPointIds->SetNumberOfValues(numTup);
-    for (vtkIdType cId = 0; cId < numTup; cId++)
-    {
-      originalPointIds->SetValue(cId, cId);
-    }
+    vtkSMPTools::For(0, numTup, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cId = begin; cId < end; cId++)
+      {
+        originalPointIds->SetValue(cId, cId);
+      }
+    });
     originalPointIds->Delete();
   }
 
   // output strips
-  if (newStrips)
+  if (hasStrips)
   {
-    newStrips->Squeeze();
-    output->SetStrips(newStrips);
-    newStrips->Delete();
+    output->SetStrips(strips.GetCells());
     vtkDebugMacro(<< "Reduced " << numCells << " cells to " << numStrips
                   << " triangle strips \n\t(Average " << (float)numCells / numStrips
                   << " triangles per strip, longest strip = "
                   << ((longestStrip - 2) > 0 ? (longestStrip - 2) : 0) << " triangles)");
     (void)numStrips;
+    (void)longestStrip;
 
-    if (newPolys->GetNumberOfCells() > 0)
+    if (polys.NumberOfCells > 0)
     {
-      vtkDebugMacro(<< "Passed " << newPolys->GetNumberOfCells() << " polygons");
-      newPolys->Squeeze();
-      output->SetPolys(newPolys);
+      vtkDebugMacro(<< "Passed " << polys.NumberOfCells << " polygons");
+      output->SetPolys(polys.GetCells());
     }
-    newPolys->Delete();
   }
 
   // output poly-lines
-  if (newLines)
+  if (hasLines)
   {
+    vtkSmartPointer<vtkCellArray> newLines = lines.GetCells();
     if (this->JoinContiguousSegments)
     {
       // In some cases it may be possible to optimize the output
@@ -625,101 +766,66 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     }
     else
     {
-      newLines->Squeeze();
       output->SetLines(newLines);
     }
 
-    newLines->Delete();
-
     vtkDebugMacro(<< "Reduced " << numCells << " cells to " << numLines
                   << " poly-lines \n\t(Average " << (float)numCells / numLines
                   << " lines per poly-line, longest poly-line = "
                   << ((longestLine - 1) > 0 ? (longestLine - 1) : 0) << " lines)");
     (void)numLines;
+    (void)longestLine;
   }
 
   // pass through verts
   output->SetVerts(input->GetVerts());
-  cellIds->Delete();
 
+  // The field data and the original cell ids follow the order of the cell
+  // data, i.e. (verts,lines,polys,strips).
+  const vtkIdType numSourceIds =
+    inNumVerts + lines.NumberOfSourceIds + polys.NumberOfSourceIds + strips.NumberOfSourceIds;
   if (this->PassCellDataAsFieldData)
   {
-    cellId = 0;
-    int max;
-    for (i = 0; i < inNumVerts; i++, cellId++)
-    {
-      newfd->InsertNextTuple(cellId, cd);
-    }
-    if (newfdLines)
+    vtkNew<vtkIdList> sourceIds;
+    sourceIds->SetNumberOfIds(numSourceIds);
+    vtkIdType* ids = sourceIds->GetPointer(0);
+    for (i = 0; i < inNumVerts; i++)
     {
-      max = newfdLines->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        newfd->InsertNextTuple(i, newfdLines);
-      }
-      newfdLines->Delete();
-    }
-    if (newfdPolys)
-    {
-      max = newfdPolys->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        newfd->InsertNextTuple(i, newfdPolys);
-      }
-      newfdPolys->Delete();
+      *ids++ = i;
     }
-    if (newfdStrips)
+    ids = std::copy(lines.SourceIds.begin(), lines.SourceIds.end(), ids);
+    ids = std::copy(polys.SourceIds.begin(), polys.SourceIds.end(), ids);
+    std::copy(strips.SourceIds.begin(), strips.SourceIds.end(), ids);
+
+    vtkNew<vtkFieldData> newfd;
+    newfd->CopyStructure(cd);
+    for (int arrayId = 0; arrayId < newfd->GetNumberOfArrays(); arrayId++)
     {
-      max = newfdStrips->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        newfd->InsertNextTuple(i, newfdStrips);
-      }
-      newfdStrips->Delete();
+      newfd->GetAbstractArray(arrayId)->InsertTuplesStartingAt(
+        0, sourceIds, cd->GetAbstractArray(arrayId));
     }
-    newfd->Squeeze();
     output->SetFieldData(newfd);
-    newfd->Delete();
   }
 
   if (this->PassThroughCellIds)
   {
-    cellId = 0;
-    int max;
-    for (i = 0; i < inNumVerts; i++, cellId++)
-    {
-      OriginalCellIds->InsertNextValue(cellId);
-    }
-    if (origLineIds)
-    {
-      max = origLineIds->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        OriginalCellIds->InsertNextTuple(i, origLineIds);
-      }
-      origLineIds->Delete();
-    }
-    if (origPolyIds)
-    {
-      max = origPolyIds->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        OriginalCellIds->InsertNextTuple(i, origPolyIds);
-      }
-      origPolyIds->Delete();
-    }
-    if (origStripIds)
+    // The strips passed through have one more original id than field data
+    // tuples.
+    vtkNew<vtkIdTypeArray> OriginalCellIds;
+    OriginalCellIds->SetName("vtkOriginalCellIds");
+    OriginalCellIds->SetNumberOfComponents(1);
+    OriginalCellIds->SetNumberOfValues(numSourceIds - numPassedStripSourceIds +
+      static_cast<vtkIdType>(passedStripIds.size()));
+    vtkIdType* ids = OriginalCellIds->GetPointer(0);
+    for (i = 0; i < inNumVerts; i++)
     {
-      max = origStripIds->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        OriginalCellIds->InsertNextTuple(i, origStripIds);
-      }
-      origStripIds->Delete();
+      *ids++ = i;
     }
-    OriginalCellIds->Squeeze();
+    ids = std::copy(lines.SourceIds.begin(), lines.SourceIds.end(), ids);
+    ids = std::copy(polys.SourceIds.begin(), polys.SourceIds.end(), ids);
+    ids = std::copy(passedStripIds.begin(), passedStripIds.end(), ids);
+    std::copy(strips.SourceIds.begin() + numPassedStripSourceIds, strips.SourceIds.end(), ids);
     output->GetFieldData()->AddArray(OriginalCellIds);
-    OriginalCellIds->Delete();
   }
 
   return 1;
@@ -41,6 +41,13 @@
  * triangle strips if triangle polygons are available; and will only
  * construct poly-lines if lines are available.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The regions of cells
+ * connected through their points are stripped independently, and the output
+ * is the same with any number of threads. Using TBB or other non-sequential
+ * type (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve
+ * performance significantly.
+ *
  * @sa
  * vtkTriangleFilter
  */
@@ -2,20 +2,120 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkTriangleFilter.h"
 
+#include "vtkBatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
-#include "vtkTriangleStrip.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTriangleFilter);
 
+namespace
+{
+// The number of triangles generated by a batch of polygons or triangle
+// strips. These are turned into offsets once all the batches are counted.
+struct TriangleBatchData
+{
+  vtkIdType NumberOfTriangles;
+
+  TriangleBatchData()
+    : NumberOfTriangles(0)
+  {
+  }
+  ~TriangleBatchData() = default;
+  TriangleBatchData& operator+=(const TriangleBatchData& other)
+  {
+    this->NumberOfTriangles += other.NumberOfTriangles;
+    return *this;
+  }
+  TriangleBatchData operator+(const TriangleBatchData& other) const
+  {
+    TriangleBatchData result = *this;
+    result += other;
+    return result;
+  }
+};
+using TriangleBatch = vtkBatch<TriangleBatchData>;
+using TriangleBatches = vtkBatches<TriangleBatchData>;
+
+// The triangles generated by batches of cells, written directly into the
+// offsets and connectivity of a cell array. The input cell of each triangle
+// is recorded to copy the cell data afterwards.
+struct TriangleOutput
+{
+  vtkNew<vtkIdTypeArray> Offsets;
+  vtkNew<vtkIdTypeArray> Connectivity;
+  vtkNew<vtkIdList> SourceIds;
+
+  void Allocate(vtkIdType numTriangles)
+  {
+    this->Offsets->SetNumberOfValues(numTriangles + 1);
+    this->Connectivity->SetNumberOfValues(3 * numTriangles);
+    this->SourceIds->SetNumberOfIds(numTriangles);
+    vtkIdType* offsets = this->Offsets->GetPointer(0);
+    vtkSMPTools::For(0, numTriangles + 1, [offsets](vtkIdType triId, vtkIdType endTriId) {
+      for (; triId < endTriId; ++triId)
+      {
+        offsets[triId] = 3 * triId;
+      }
+    });
+  }
+
+  void SetTriangle(vtkIdType triId, vtkIdType p1, vtkIdType p2, vtkIdType p3, vtkIdType cellId)
+  {
+    vtkIdType* triPts = this->Connectivity->GetPointer(3 * triId);
+    triPts[0] = p1;
+    triPts[1] = p2;
+    triPts[2] = p3;
+    this->SourceIds->SetId(triId, cellId);
+  }
+
+  // Add the triangles to the cells, and copy their cell data to the output
+  // cell data from outCellId on.
+  void Finalize(vtkSmartPointer<vtkCellArray>& cells, vtkCellData* inCD, vtkCellData* outCD,
+    vtkIdType outCellId)
+  {
+    if (cells == nullptr)
+    {
+      cells = vtkSmartPointer<vtkCellArray>::New();
+      cells->SetData(this->Offsets, this->Connectivity);
+    }
+    else
+    {
+      vtkNew<vtkCellArray> triangles;
+      triangles->SetData(this->Offsets, this->Connectivity);
+      cells->Append(triangles);
+    }
+    outCD->CopyData(inCD, this->SourceIds, outCellId);
+  }
+};
+}
+
+//-------------------------------------------------------------------------
+int vtkTriangleFilter::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  // Only the cells of the input are used, its arrays are passed
+  info->Set(vtkStreamingDemandDrivenPipeline::PROPAGATE_ARRAY_REQUESTS(), 1);
+  return 1;
+}
+
 //-------------------------------------------------------------------------
 int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -59,6 +159,7 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
       }
       else if (inVerts->GetMaxCellSize() == 1)
       {
+        outCellId = output->GetNumberOfCells();
         output->SetVerts(inVerts);
         if (numInVerts == numInCells)
         {
@@ -66,7 +167,7 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
         }
         else
         {
-          outCD->CopyData(inCD, output->GetNumberOfCells(), numInVerts, inCellId);
+          outCD->CopyData(inCD, outCellId, numInVerts, inCellId);
         }
         inCellId += numInVerts;
       }
@@ -120,6 +221,7 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
       }
       else if (inLines->GetMaxCellSize() == 2)
       {
+        outCellId = output->GetNumberOfCells();
         output->SetLines(inLines);
         if (numInLines == numInCells)
         {
@@ -127,7 +229,7 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
         }
         else
         {
-          outCD->CopyData(inCD, output->GetNumberOfCells(), numInLines, inCellId);
+          outCD->CopyData(inCD, outCellId, numInLines, inCellId);
         }
         inCellId += numInLines;
       }
@@ -198,73 +300,131 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
       {
         newPolys->DeepCopy(inPolys);
       }
+      outCellId = output->GetNumberOfCells();
       output->SetPolys(newPolys);
-      output->SetLines(inLines);
       if (numInPolys == numInCells)
       {
         outCD->PassData(inCD);
       }
       else
       {
-        outCD->CopyData(inCD, output->GetNumberOfCells(), numInPolys, inCellId);
+        outCD->CopyData(inCD, outCellId, numInPolys, inCellId);
       }
       inCellId += numInPolys;
     }
     else
     {
       outCellId = output->GetNumberOfCells();
-      newPolys->AllocateCopy(inPolys);
-
-      vtkNew<vtkIdList> ptIds;
-      ptIds->Allocate(VTK_CELL_SIZE);
-      vtkIdType triPts[3];
-      // It may be necessary to specify a custom tessellation
-      // tolerance.
-      vtkNew<vtkPolygon> poly;
-      if (this->Tolerance > 0.0)
-      {
-        poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
-      }
 
-      auto iter = vtk::TakeSmartPointer(inPolys->NewIterator());
-      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal() && !abort;
-           iter->GoToNextCell(), ++inCellId)
-      {
-        if (!(inCellId % updateInterval)) // manage progress reports / early abort
-        {
-          this->UpdateProgress((float)inCellId / numInCells);
-          abort = this->CheckAbort();
-        }
-        iter->GetCurrentCell(npts, pts);
-        if (npts == 3)
-        {
-          newPolys->InsertNextCell(3, pts);
-          outCD->CopyData(inCD, inCellId, outCellId++);
-        }
-        else // triangulate polygon
-        {
-          // initialize polygon
-          poly->PointIds->SetNumberOfIds(npts);
-          poly->Points->SetNumberOfPoints(npts);
-          for (vtkIdType i = 0; i < npts; i++)
+      // First pass: triangulate the polygons, and count the triangles of
+      // each batch of polygons. The triangulations of the polygons which are
+      // not triangles are kept until the second pass, each one preceded by
+      // its number of triangles.
+      TriangleBatches batches;
+      batches.Initialize(numInPolys);
+      std::vector<std::vector<vtkIdType>> batchTriangles(batches.GetNumberOfBatches());
+      vtkSMPThreadLocalObject<vtkPolygon> tlPolygon;
+      vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+      vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+      vtkSMPTools::For(
+        0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+          // It may be necessary to specify a custom tessellation
+          // tolerance.
+          vtkPolygon* poly = tlPolygon.Local();
+          if (this->Tolerance > 0.0)
           {
-            poly->PointIds->SetId(i, pts[i]);
-            poly->Points->SetPoint(i, inPts->GetPoint(pts[i]));
+            poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
           }
-          poly->TriangulateLocalIds(0, ptIds);
-          const int numSimplices = ptIds->GetNumberOfIds() / 3;
-          for (vtkIdType i = 0; i < numSimplices; i++)
+          vtkIdList* ptIds = tlPtIds.Local();
+          vtkIdList* cellPts = tlCellPts.Local();
+          const vtkIdType* polyPts;
+          vtkIdType numPolyPts;
+          const bool isFirst = vtkSMPTools::GetSingleThread();
+          double x[3];
+          for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
           {
-            for (vtkIdType j = 0; j < 3; j++)
+            if (isFirst)
             {
-              triPts[j] = poly->PointIds->GetId(ptIds->GetId(3 * i + j));
+              this->CheckAbort();
             }
-            newPolys->InsertNextCell(3, triPts);
-            outCD->CopyData(inCD, inCellId, outCellId++);
-          } // for each simplex
-        }   // triangulate polygon
+            if (this->GetAbortOutput())
+            {
+              break;
+            }
+            TriangleBatch& batch = batches[batchId];
+            std::vector<vtkIdType>& triangles = batchTriangles[batchId];
+            for (vtkIdType polyId = batch.BeginId; polyId < batch.EndId; ++polyId)
+            {
+              inPolys->GetCellAtId(polyId, numPolyPts, polyPts, cellPts);
+              if (numPolyPts == 3)
+              {
+                ++batch.Data.NumberOfTriangles;
+                continue;
+              }
+              // triangulate polygon
+              poly->PointIds->SetNumberOfIds(numPolyPts);
+              poly->Points->SetNumberOfPoints(numPolyPts);
+              for (vtkIdType i = 0; i < numPolyPts; i++)
+              {
+                poly->PointIds->SetId(i, polyPts[i]);
+                inPts->GetPoint(polyPts[i], x);
+                poly->Points->SetPoint(i, x);
+              }
+              poly->TriangulateLocalIds(0, ptIds);
+              const int numSimplices = ptIds->GetNumberOfIds() / 3;
+              triangles.push_back(numSimplices);
+              for (vtkIdType i = 0; i < 3 * numSimplices; i++)
+              {
+                triangles.push_back(poly->PointIds->GetId(ptIds->GetId(i)));
+              }
+              batch.Data.NumberOfTriangles += numSimplices;
+            }
+          }
+        });
+      abort = this->GetAbortOutput();
+
+      if (!abort)
+      {
+        const TriangleBatchData totals = batches.BuildOffsetsAndGetGlobalSum();
+        this->UpdateProgress((float)(inCellId + numInPolys / 2) / numInCells);
+
+        // Second pass: write the triangles at the offsets of their batch.
+        TriangleOutput triangleOutput;
+        triangleOutput.Allocate(totals.NumberOfTriangles);
+        vtkSMPTools::For(
+          0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+            vtkIdList* cellPts = tlCellPts.Local();
+            const vtkIdType* polyPts;
+            vtkIdType numPolyPts;
+            for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+            {
+              const TriangleBatch& batch = batches[batchId];
+              vtkIdType triId = batch.Data.NumberOfTriangles;
+              const vtkIdType* triangles = batchTriangles[batchId].data();
+              for (vtkIdType polyId = batch.BeginId; polyId < batch.EndId; ++polyId)
+              {
+                const vtkIdType cellId = inCellId + polyId;
+                inPolys->GetCellAtId(polyId, numPolyPts, polyPts, cellPts);
+                if (numPolyPts == 3)
+                {
+                  triangleOutput.SetTriangle(
+                    triId++, polyPts[0], polyPts[1], polyPts[2], cellId);
+                  continue;
+                }
+                const vtkIdType numSimplices = *triangles++;
+                for (vtkIdType i = 0; i < numSimplices; i++, triangles += 3)
+                {
+                  triangleOutput.SetTriangle(
+                    triId++, triangles[0], triangles[1], triangles[2], cellId);
+                } // for each simplex
+              }
+              std::vector<vtkIdType>().swap(batchTriangles[batchId]);
+            }
+          });
+        triangleOutput.Finalize(newPolys, inCD, outCD, outCellId);
+        output->SetPolys(newPolys);
       }
-      output->SetPolys(newPolys);
+      inCellId += numInPolys;
     }
   }
 
@@ -279,7 +439,7 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
     else
     {
       outCD->CopyData(inCD, 0, numInCellsHere, 0);
-      inCellId += numInCellsHere;
+      inCellId = numInCellsHere;
     }
   }
 
@@ -287,29 +447,73 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   if (!abort && numInStrips > 0)
   {
     outCellId = output->GetNumberOfCells();
-    if (newPolys == nullptr)
-    {
-      newPolys = vtkSmartPointer<vtkCellArray>::New();
-      newPolys->AllocateCopy(inStrips);
-    }
 
-    auto iter = vtk::TakeSmartPointer(inStrips->NewIterator());
-    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal() && !abort;
-         iter->GoToNextCell(), ++inCellId)
+    // A strip of n points is decomposed into n-2 triangles, so that the
+    // triangles of each batch of strips are counted without decomposing them.
+    TriangleBatches batches;
+    batches.Initialize(numInStrips);
+    vtkSMPTools::For(
+      0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+        for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+        {
+          TriangleBatch& batch = batches[batchId];
+          for (vtkIdType stripId = batch.BeginId; stripId < batch.EndId; ++stripId)
+          {
+            batch.Data.NumberOfTriangles +=
+              std::max(inStrips->GetCellSize(stripId) - 2, static_cast<vtkIdType>(0));
+          }
+        }
+      });
+    const TriangleBatchData totals = batches.BuildOffsetsAndGetGlobalSum();
+
+    TriangleOutput triangleOutput;
+    triangleOutput.Allocate(totals.NumberOfTriangles);
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+    vtkSMPTools::For(
+      0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+        vtkIdList* cellPts = tlCellPts.Local();
+        const vtkIdType* stripPts;
+        vtkIdType numStripPts;
+        const bool isFirst = vtkSMPTools::GetSingleThread();
+        for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+          const TriangleBatch& batch = batches[batchId];
+          vtkIdType triId = batch.Data.NumberOfTriangles;
+          for (vtkIdType stripId = batch.BeginId; stripId < batch.EndId; ++stripId)
+          {
+            // Same decomposition as vtkTriangleStrip::DecomposeStrip()
+            inStrips->GetCellAtId(stripId, numStripPts, stripPts, cellPts);
+            for (vtkIdType i = 0; i < (numStripPts - 2); i++)
+            {
+              if ((i % 2)) // flip ordering to preserve consistency
+              {
+                triangleOutput.SetTriangle(
+                  triId++, stripPts[i + 1], stripPts[i], stripPts[i + 2], inCellId + stripId);
+              }
+              else
+              {
+                triangleOutput.SetTriangle(
+                  triId++, stripPts[i], stripPts[i + 1], stripPts[i + 2], inCellId + stripId);
+              }
+            }
+          }
+        }
+      });
+    abort = this->GetAbortOutput();
+    if (!abort)
     {
-      if (!(inCellId % updateInterval)) // manage progress reports / early abort
-      {
-        this->UpdateProgress((float)inCellId / numInCells);
-        abort = this->CheckAbort();
-      }
-      iter->GetCurrentCell(npts, pts);
-      vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
-      for (vtkIdType i = 0; i < (npts - 2); i++)
-      {
-        outCD->CopyData(inCD, inCellId, outCellId++);
-      }
-    } // for all strips
-    output->SetPolys(newPolys);
+      triangleOutput.Finalize(newPolys, inCD, outCD, outCellId);
+      output->SetPolys(newPolys);
+    }
+    inCellId += numInStrips;
   }
 
   // Update output
@@ -84,6 +84,8 @@ protected:
   }
   ~vtkTriangleFilter() override = default;
 
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
   // Usual data generation method
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
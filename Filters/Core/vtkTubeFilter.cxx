@@ -1,19 +1,36 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkTubeFilter.h"
 
+#include "vtkArrayListTemplate.h"
+#include "vtkBatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -71,704 +88,1034 @@ struct IdPointsEqual
   vtkPoints* Points;
 };
 
-}
-
-int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+// The size of the tubes generated by a batch of polylines. These are turned
+// into offsets once all the batches are counted.
+struct TubeBatchData
 {
-  // get the info objects
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
-
-  // get the input and output
-  vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
-  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkPointData* pd = input->GetPointData();
-  vtkPointData* outPD = output->GetPointData();
-  vtkCellData* cd = input->GetCellData();
-  vtkCellData* outCD = output->GetCellData();
-  vtkCellArray* inLines;
-  vtkDataArray* inNormals;
-  vtkDataArray* inScalars = this->GetInputArrayToProcess(0, inputVector);
-  vtkDataArray* inVectors = this->GetInputArrayToProcess(1, inputVector);
-
-  vtkPoints* inPts;
-  vtkIdType numPts;
-  vtkIdType numLines;
-  vtkIdType numNewPts, numNewCells;
-  vtkPoints* newPts;
-  int deleteNormals = 0;
-  vtkFloatArray* newNormals;
-  vtkIdType i;
-  double range[2], maxSpeed = 0;
-  vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* ptsOrig = nullptr;
-  vtkIdType offset = 0;
-  vtkFloatArray* newTCoords = nullptr;
-  bool abort = false;
-  vtkIdType inCellId;
-  double oldRadius = 1.0;
-
-  // Check input and initialize
-  //
-  vtkDebugMacro(<< "Creating tube");
-
-  if (!(inPts = input->GetPoints()) || (numPts = inPts->GetNumberOfPoints()) < 1 ||
-    !(inLines = input->GetLines()) || (numLines = inLines->GetNumberOfCells()) < 1)
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfCells;
+  vtkIdType ConnectivitySize;
+
+  TubeBatchData()
+    : NumberOfPoints(0)
+    , NumberOfCells(0)
+    , ConnectivitySize(0)
   {
-    return 1;
   }
-
-  // Create the geometry and topology
-  numNewPts = numPts * this->NumberOfSides;
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  ~TubeBatchData() = default;
+  TubeBatchData& operator+=(const TubeBatchData& other)
   {
-    newPts->SetDataType(inPts->GetDataType());
+    this->NumberOfPoints += other.NumberOfPoints;
+    this->NumberOfCells += other.NumberOfCells;
+    this->ConnectivitySize += other.ConnectivitySize;
+    return *this;
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  TubeBatchData operator+(const TubeBatchData& other) const
   {
-    newPts->SetDataType(VTK_FLOAT);
+    TubeBatchData result = *this;
+    result += other;
+    return result;
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-
-  newPts->Allocate(numNewPts);
-  newNormals = vtkFloatArray::New();
-  newNormals->SetName("TubeNormals");
-  newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
-  newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
+};
+using TubeBatch = vtkBatch<TubeBatchData>;
+using TubeBatches = vtkBatches<TubeBatchData>;
 
-  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
-  outPD->CopyNormalsOff();
-  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    newTCoords = vtkFloatArray::New();
-    newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
-    outPD->CopyTCoordsOff();
-  }
-  outPD->CopyAllocate(pd, numNewPts);
+// Per thread scratch space used to tube one polyline
+struct TubeLocalData
+{
+  vtkSmartPointer<vtkIdList> CellIds;
+  std::vector<vtkIdType> Pts;
+  // the polyline alone, to generate its normals independently
+  std::unordered_map<vtkIdType, vtkIdType> LinePointIds;
+  std::vector<vtkIdType> LineIds;
+  vtkSmartPointer<vtkPoints> LinePoints;
+  vtkSmartPointer<vtkCellArray> Line;
+  vtkSmartPointer<vtkFloatArray> LineNormals;
+  // for each point: the point, the two axes of the tube around it, and its radius
+  std::vector<double> Frames;
+  double StartCapNormal[3];
+  double EndCapNormal[3];
+  // warnings of the skipped polylines, reported once all the lines are processed
+  std::vector<std::pair<vtkIdType, std::string>> Warnings;
+};
 
-  int generateNormals = 0;
-  if (!(inNormals = pd->GetNormals()) || this->UseDefaultNormal)
+// Generates the tube around each polyline independently. The layout of the
+// output of a polyline only depends on its number of points, so that the
+// tubes can be written concurrently once their offsets are known.
+struct TubeGenerator
+{
+  vtkPoints* InPts;
+  vtkCellArray* InLines;
+  vtkDataArray* InNormals; // nullptr if the normals are generated
+  bool UseDefaultNormal;
+  double DefaultNormal[3];
+  vtkDataArray* InScalars;
+  vtkDataArray* InVectors;
+  double Range[2];
+  double MaxSpeed;
+  double Radius;
+  int VaryRadius;
+  double RadiusFactor;
+  int NumberOfSides;
+  bool SidesShareVertices;
+  bool Capping;
+  int OnRatio;
+  int Offset;
+  int GenerateTCoords;
+  double TextureLength;
+  double Theta;
+
+  vtkIdType GetNumberOfStripSides() const
   {
-    deleteNormals = 1;
-    inNormals = vtkFloatArray::New();
-    inNormals->SetNumberOfComponents(3);
-    inNormals->SetNumberOfTuples(numPts);
-
-    if (this->UseDefaultNormal)
+    vtkIdType numStripSides = 0;
+    for (int k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
     {
-      for (i = 0; i < numPts; i++)
-      {
-        inNormals->SetTuple(i, this->DefaultNormal);
-      }
-    }
-    else
-    {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their tubes) calculated independently
-      generateNormals = 1;
+      numStripSides++;
     }
+    return numStripSides;
   }
 
-  // If varying width, get appropriate info.
-  //
-  if (inScalars)
+  // Number of points of a tube, including the duplicated cap points
+  vtkIdType GetNumberOfPoints(vtkIdType npts) const
   {
-    pd->GetRange(inScalars->GetName(), range, 0);
-    if ((range[1] - range[0]) == 0.0)
+    vtkIdType numPts = (this->SidesShareVertices ? 1 : 2) * this->NumberOfSides * npts;
+    if (this->Capping)
     {
-      if (this->VaryRadius == VTK_VARY_RADIUS_BY_SCALAR)
-      {
-        vtkWarningMacro(<< "Scalar range is zero!");
-      }
-      range[1] = range[0] + 1.0;
-    }
-    if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
-    {
-      // temporarily set the radius to 1.0 so that radius*scalar = scalar
-      oldRadius = this->Radius;
-      this->Radius = 1.0;
-      if (range[0] < 0.0)
-      {
-        vtkWarningMacro(<< "Scalar values fall below zero when using absolute radius values!");
-      }
+      numPts += 2 * this->NumberOfSides;
     }
+    return numPts;
   }
-  if (inVectors)
+
+  vtkIdType GetNumberOfCells() const
   {
-    maxSpeed = inVectors->GetMaxNorm();
+    return this->GetNumberOfStripSides() + (this->Capping ? 2 : 0);
   }
 
-  // Copy selected parts of cell data; certainly don't want normals
-  //
-  numNewCells = inLines->GetNumberOfCells() * this->NumberOfSides + 2;
-  outCD->CopyNormalsOff();
-  outCD->CopyAllocate(cd, numNewCells);
+  vtkIdType GetConnectivitySize(vtkIdType npts) const
+  {
+    return this->GetNumberOfStripSides() * 2 * npts + (this->Capping ? 2 * this->NumberOfSides : 0);
+  }
 
-  //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
-  //
-  this->Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  // the line cellIds start after the last vert cellId
-  inCellId = input->GetNumberOfVerts();
-  int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
-  int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
+  // Remove the degenerate segments of a polyline and compute the frames of
+  // its tube. Returns the number of points of the polyline, or 0 if it is
+  // not tubed, with a warning if it is invalid.
+  vtkIdType PrepareLine(vtkIdType lineId, TubeLocalData& local, std::string& warning) const
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+    if (!local.CellIds)
     {
-      abort = this->CheckAbort();
-      break;
+      local.CellIds = vtkSmartPointer<vtkIdList>::New();
+      local.LinePoints = vtkSmartPointer<vtkPoints>::New();
+      local.LinePoints->SetDataType(this->InPts->GetDataType());
+      local.Line = vtkSmartPointer<vtkCellArray>::New();
+      local.LineNormals = vtkSmartPointer<vtkFloatArray>::New();
+      local.LineNormals->SetNumberOfComponents(3);
     }
-    progressCounter++;
 
-    // Make a copy of point indices to avoid modifying input polydata cells
-    // while removing degenerate lines.
+    vtkIdType npts;
+    const vtkIdType* ptsOrig;
+    this->InLines->GetCellAtId(lineId, npts, ptsOrig, local.CellIds);
     if (npts < 2)
     {
-      continue; // skip tubing this polyline
+      return 0; // skip tubing this polyline
     }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
+
+    // Make a copy of point indices to avoid modifying input polydata cells
+    // while removing degenerate lines.
+    local.Pts.assign(ptsOrig, ptsOrig + npts);
+    vtkIdType* pts = local.Pts.data();
 
     // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
+    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(this->InPts)) - pts);
+    local.Pts.resize(npts);
     if (npts < 2)
     {
-      continue; // skip tubing this polyline
+      return 0; // skip tubing this polyline
     }
 
     // If necessary calculate normals, each polyline calculates its
     // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
-    }
-
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
+    if (!this->InNormals && !this->UseDefaultNormal)
     {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
+      // A polyline may visit a point more than once, e.g. when it is closed.
+      // Such a point gets a single normal, the last one generated.
+      double x[3];
+      local.LinePointIds.clear();
+      local.LineIds.resize(npts);
+      local.LinePoints->Reset();
+      local.Line->Reset();
+      local.Line->InsertNextCell(npts);
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        auto inserted = local.LinePointIds.emplace(pts[i], local.LinePoints->GetNumberOfPoints());
+        if (inserted.second)
+        {
+          this->InPts->GetPoint(pts[i], x);
+          local.LinePoints->InsertNextPoint(x);
+        }
+        local.LineIds[i] = inserted.first->second;
+        local.Line->InsertCellPoint(local.LineIds[i]);
+      }
+      local.LineNormals->SetNumberOfTuples(local.LinePoints->GetNumberOfPoints());
+      vtkPolyLine::GenerateSlidingNormals(local.LinePoints, local.Line, local.LineNormals);
     }
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
+    if (!this->ComputeFrames(npts, local, warning))
     {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      return 0;
     }
-
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
-
-  // reset the radius to ite original value if necessary
-  if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
-  {
-    this->Radius = oldRadius;
-  }
-
-  // Update ourselves
-  //
-  if (deleteNormals)
-  {
-    inNormals->Delete();
+    return npts;
   }
 
-  if (newTCoords)
+  // Use "averaged" segment to create beveled effect.
+  // Watch out for first and last points.
+  bool ComputeFrames(vtkIdType npts, TubeLocalData& local, std::string& warning) const
   {
-    outPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
-  }
-
-  output->SetPoints(newPts);
-  newPts->Delete();
+    const vtkIdType* pts = local.Pts.data();
+    double p[3];
+    double pNext[3];
+    double sNext[3] = { 0.0, 0.0, 0.0 };
+    double sPrev[3];
+    double n[3];
+    double s[3];
+    double w[3];
+    double nP[3];
+    double* startCapNorm = local.StartCapNormal;
+    double* endCapNorm = local.EndCapNormal;
+    local.Frames.resize(10 * npts);
+
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      if (j == 0) // first point
+      {
+        this->InPts->GetPoint(pts[0], p);
+        this->InPts->GetPoint(pts[1], pNext);
+        for (int i = 0; i < 3; i++)
+        {
+          sNext[i] = pNext[i] - p[i];
+          sPrev[i] = sNext[i];
+          startCapNorm[i] = -sPrev[i];
+        }
+        vtkMath::Normalize(startCapNorm);
+      }
+      else if (j == (npts - 1)) // last point
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          sPrev[i] = sNext[i];
+          p[i] = pNext[i];
+          endCapNorm[i] = sNext[i];
+        }
+        vtkMath::Normalize(endCapNorm);
+      }
+      else
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          p[i] = pNext[i];
+        }
+        this->InPts->GetPoint(pts[j + 1], pNext);
+        for (int i = 0; i < 3; i++)
+        {
+          sPrev[i] = sNext[i];
+          sNext[i] = pNext[i] - p[i];
+        }
+      }
 
-  output->SetStrips(newStrips);
-  newStrips->Delete();
+      if (this->UseDefaultNormal)
+      {
+        std::copy_n(this->DefaultNormal, 3, n);
+      }
+      else if (this->InNormals)
+      {
+        this->InNormals->GetTuple(pts[j], n);
+      }
+      else
+      {
+        local.LineNormals->GetTuple(local.LineIds[j], n);
+      }
 
-  outPD->SetNormals(newNormals);
-  newNormals->Delete();
-  lineNormalGenerator->Delete();
+      if (vtkMath::Normalize(sNext) == 0.0)
+      {
+        warning = "Coincident points!";
+        return false;
+      }
 
-  output->Squeeze();
+      for (int i = 0; i < 3; i++)
+      {
+        s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
+      }
+      // if s is zero then just use sPrev cross n
+      if (vtkMath::Normalize(s) == 0.0)
+      {
+        vtkMath::Cross(sPrev, n, s);
+        vtkMath::Normalize(s);
+      }
 
-  return 1;
-}
+      vtkMath::Cross(s, n, w);
+      if (vtkMath::Normalize(w) == 0.0)
+      {
+        std::ostringstream message;
+        message << "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
+                << " " << n[1] << " " << n[2];
+        warning = message.str();
+        return false;
+      }
 
-int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
-  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
-  double maxSpeed, vtkDataArray* inNormals)
-{
-  vtkIdType j;
-  int i, k;
-  double p[3];
-  double pNext[3];
-  double sNext[3] = { 0.0, 0.0, 0.0 };
-  double sPrev[3];
-  double startCapNorm[3], endCapNorm[3];
-  double n[3];
-  double s[3];
-  // double bevelAngle;
-  double w[3];
-  double nP[3];
-  double sFactor = 1.0;
-  double normal[3];
-  vtkIdType ptId = offset;
+      vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
+      vtkMath::Normalize(nP);
 
-  // Use "averaged" segment to create beveled effect.
-  // Watch out for first and last points.
-  //
-  for (j = 0; j < npts; j++)
-  {
-    if (j == 0) // first point
-    {
-      inPts->GetPoint(pts[0], p);
-      inPts->GetPoint(pts[1], pNext);
-      for (i = 0; i < 3; i++)
+      // Compute a scale factor based on scalars or vectors
+      double sFactor = 1.0;
+      if (this->InScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_SCALAR)
       {
-        sNext[i] = pNext[i] - p[i];
-        sPrev[i] = sNext[i];
-        startCapNorm[i] = -sPrev[i];
+        const double scalar = this->InScalars->GetComponent(pts[j], 0);
+        sFactor = 1.0 +
+          ((this->RadiusFactor - 1.0) * (scalar - this->Range[0]) /
+            (this->Range[1] - this->Range[0]));
       }
-      vtkMath::Normalize(startCapNorm);
-    }
-    else if (j == (npts - 1)) // last point
-    {
-      for (i = 0; i < 3; i++)
+      else if (this->InVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
       {
-        sPrev[i] = sNext[i];
-        p[i] = pNext[i];
-        endCapNorm[i] = sNext[i];
+        double v[3];
+        this->InVectors->GetTuple(pts[j], v);
+        sFactor = sqrt(this->MaxSpeed / vtkMath::Norm(v));
+        if (sFactor > this->RadiusFactor)
+        {
+          sFactor = this->RadiusFactor;
+        }
       }
-      vtkMath::Normalize(endCapNorm);
-    }
-    else
-    {
-      for (i = 0; i < 3; i++)
+      else if (this->InVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
       {
-        p[i] = pNext[i];
+        double v[3];
+        this->InVectors->GetTuple(pts[j], v);
+        sFactor = 1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(v) / this->MaxSpeed;
       }
-      inPts->GetPoint(pts[j + 1], pNext);
-      for (i = 0; i < 3; i++)
+      else if (this->InScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
       {
-        sPrev[i] = sNext[i];
-        sNext[i] = pNext[i] - p[i];
+        sFactor = this->InScalars->GetComponent(pts[j], 0);
+        if (sFactor < 0.0)
+        {
+          warning = "Scalar value less than zero, skipping line";
+          return false;
+        }
       }
-    }
 
-    inNormals->GetTuple(pts[j], n);
-
-    if (vtkMath::Normalize(sNext) == 0.0)
-    {
-      vtkWarningMacro(<< "Coincident points!");
-      return 0;
+      double* frame = local.Frames.data() + 10 * j;
+      std::copy_n(p, 3, frame);
+      std::copy_n(w, 3, frame + 3);
+      std::copy_n(nP, 3, frame + 6);
+      frame[9] = this->Radius * sFactor;
     }
+    return true;
+  }
 
-    for (i = 0; i < 3; i++)
-    {
-      s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
-    }
-    // if s is zero then just use sPrev cross n
-    if (vtkMath::Normalize(s) == 0.0)
+  // Generate the points around the polyline, from the frames computed by
+  // PrepareLine().
+  void GeneratePoints(vtkIdType offset, vtkIdType npts, const TubeLocalData& local,
+    vtkPoints* newPts, vtkFloatArray* newNormals, ArrayList& pointArrays) const
+  {
+    const vtkIdType* pts = local.Pts.data();
+    double s[3];
+    double normal[3];
+    vtkIdType ptId = offset;
+
+    for (vtkIdType j = 0; j < npts; j++)
     {
-      vtkDebugMacro(<< "Using alternate bevel vector");
-      vtkMath::Cross(sPrev, n, s);
-      if (vtkMath::Normalize(s) == 0.0)
+      const double* frame = local.Frames.data() + 10 * j;
+      const double* p = frame;
+      const double* w = frame + 3;
+      const double* nP = frame + 6;
+      const double radius = frame[9];
+
+      // create points around line
+      if (this->SidesShareVertices)
       {
-        vtkDebugMacro(<< "Using alternate bevel vector");
-      }
-    }
-
-    /*    if ( (bevelAngle = vtkMath::Dot(sNext,sPrev)) > 1.0 )
-          {
-          bevelAngle = 1.0;
-          }
-        if ( bevelAngle < -1.0 )
+        for (int k = 0; k < this->NumberOfSides; k++)
+        {
+          for (int i = 0; i < 3; i++)
           {
-          bevelAngle = -1.0;
+            normal[i] = w[i] * cos((double)k * this->Theta) + nP[i] * sin((double)k * this->Theta);
+            s[i] = p[i] + radius * normal[i];
           }
-        bevelAngle = acos((double)bevelAngle) / 2.0; //(0->90 degrees)
-        if ( (bevelAngle = cos(bevelAngle)) == 0.0 )
+          newPts->SetPoint(ptId, s);
+          newNormals->SetTuple(ptId, normal);
+          pointArrays.Copy(pts[j], ptId);
+          ptId++;
+        } // for each side
+      }
+      else
+      {
+        double n_left[3], n_right[3];
+        for (int k = 0; k < this->NumberOfSides; k++)
+        {
+          for (int i = 0; i < 3; i++)
           {
-          bevelAngle = 1.0;
+            // Create duplicate vertices at each point
+            // and adjust the associated normals so that they are
+            // oriented with the facets. This preserves the tube's
+            // polygonal appearance, as if by flat-shading around the tube,
+            // while still allowing smooth (gouraud) shading along the
+            // tube as it bends.
+            normal[i] = w[i] * cos((double)(k + 0.0) * this->Theta) +
+              nP[i] * sin((double)(k + 0.0) * this->Theta);
+            n_right[i] = w[i] * cos((double)(k - 0.5) * this->Theta) +
+              nP[i] * sin((double)(k - 0.5) * this->Theta);
+            n_left[i] = w[i] * cos((double)(k + 0.5) * this->Theta) +
+              nP[i] * sin((double)(k + 0.5) * this->Theta);
+            s[i] = p[i] + radius * normal[i];
           }
-
-        bevelAngle = this->Radius / bevelAngle; //keep tube constant radius
-    */
-    vtkMath::Cross(s, n, w);
-    if (vtkMath::Normalize(w) == 0.0)
+          newPts->SetPoint(ptId, s);
+          newNormals->SetTuple(ptId, n_right);
+          pointArrays.Copy(pts[j], ptId);
+          newPts->SetPoint(ptId + 1, s);
+          newNormals->SetTuple(ptId + 1, n_left);
+          pointArrays.Copy(pts[j], ptId + 1);
+          ptId += 2;
+        } // for each side
+      }   // else separate vertices
+    }     // for all points in polyline
+
+    // Produce end points for cap. They are placed at tail end of points.
+    if (this->Capping)
     {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
-      return 0;
-    }
+      int numCapSides = this->NumberOfSides;
+      int capIncr = 1;
+      if (!this->SidesShareVertices)
+      {
+        numCapSides = 2 * this->NumberOfSides;
+        capIncr = 2;
+      }
 
-    vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
-    vtkMath::Normalize(nP);
+      // the start cap
+      for (int k = 0; k < numCapSides; k += capIncr)
+      {
+        newPts->GetPoint(offset + k, s);
+        newPts->SetPoint(ptId, s);
+        newNormals->SetTuple(ptId, local.StartCapNormal);
+        pointArrays.Copy(pts[0], ptId);
+        ptId++;
+      }
+      // the end cap
+      vtkIdType endOffset = offset + (npts - 1) * this->NumberOfSides;
+      if (!this->SidesShareVertices)
+      {
+        endOffset = offset + 2 * (npts - 1) * this->NumberOfSides;
+      }
+      for (int k = 0; k < numCapSides; k += capIncr)
+      {
+        newPts->GetPoint(endOffset + k, s);
+        newPts->SetPoint(ptId, s);
+        newNormals->SetTuple(ptId, local.EndCapNormal);
+        pointArrays.Copy(pts[npts - 1], ptId);
+        ptId++;
+      }
+    } // if capping
+  }
 
-    // Compute a scale factor based on scalars or vectors
-    if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_SCALAR)
-    {
-      sFactor = 1.0 +
-        ((this->RadiusFactor - 1.0) * (inScalars->GetComponent(pts[j], 0) - range[0]) /
-          (range[1] - range[0]));
-    }
-    else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
+  // Generate the strips of the polyline (including caps), starting at the
+  // given output cell and connectivity entry.
+  void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType inCellId, vtkIdType outCellId,
+    vtkIdType connOffset, vtkIdType* outOffsets, vtkIdType* outConnectivity,
+    ArrayList& cellArrays) const
+  {
+    vtkIdType* conn = outConnectivity + connOffset;
+    auto insertNextCell = [&](vtkIdType size) {
+      outOffsets[outCellId] = connOffset;
+      cellArrays.Copy(inCellId, outCellId);
+      connOffset += size;
+      outCellId++;
+    };
+
+    const int numSides = this->SidesShareVertices ? this->NumberOfSides : 2 * this->NumberOfSides;
+    for (int k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
     {
-      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(inVectors->GetTuple(pts[j])));
-      if (sFactor > this->RadiusFactor)
+      int i1 = k % this->NumberOfSides;
+      int i2 = (k + 1) % this->NumberOfSides;
+      if (!this->SidesShareVertices)
       {
-        sFactor = this->RadiusFactor;
+        i1 = 2 * i1 + 1;
+        i2 = 2 * i2;
       }
-    }
-    else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
-    {
-      sFactor =
-        1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(inVectors->GetTuple(pts[j])) / maxSpeed;
-    }
-    else if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
-    {
-      sFactor = inScalars->GetComponent(pts[j], 0);
-      if (sFactor < 0.0)
+      insertNextCell(npts * 2);
+      for (vtkIdType i = 0; i < npts; i++)
       {
-        vtkWarningMacro(<< "Scalar value less than zero, skipping line");
-        return 0;
+        const vtkIdType i3 = i * numSides;
+        *conn++ = offset + i2 + i3;
+        *conn++ = offset + i1 + i3;
       }
-    }
+    } // for each side of the tube
 
-    // create points around line
-    if (this->SidesShareVertices)
+    // Take care of capping. The caps are n-sided polygons that can be
+    // easily triangle stripped.
+    if (this->Capping)
     {
-      for (k = 0; k < this->NumberOfSides; k++)
+      vtkIdType startIdx = offset + npts * numSides;
+
+      // The start cap
+      insertNextCell(this->NumberOfSides);
+      *conn++ = startIdx;
+      *conn++ = startIdx + 1;
+      int i1 = this->NumberOfSides - 1;
+      int i2 = 2;
+      for (int k = 0; k < (this->NumberOfSides - 2); k++)
       {
-        for (i = 0; i < 3; i++)
+        if ((k % 2))
         {
-          normal[i] = w[i] * cos((double)k * this->Theta) + nP[i] * sin((double)k * this->Theta);
-          s[i] = p[i] + this->Radius * sFactor * normal[i];
+          *conn++ = startIdx + i2;
+          i2++;
         }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, normal);
-        outPD->CopyData(pd, pts[j], ptId);
-        ptId++;
-      } // for each side
-    }
-    else
-    {
-      double n_left[3], n_right[3];
-      for (k = 0; k < this->NumberOfSides; k++)
+        else
+        {
+          *conn++ = startIdx + i1;
+          i1--;
+        }
+      }
+
+      // The end cap - reversed order to be consistent with normal
+      startIdx += this->NumberOfSides;
+      insertNextCell(this->NumberOfSides);
+      *conn++ = startIdx;
+      *conn++ = startIdx + this->NumberOfSides - 1;
+      i1 = this->NumberOfSides - 2;
+      i2 = 1;
+      for (int k = 0; k < (this->NumberOfSides - 2); k++)
       {
-        for (i = 0; i < 3; i++)
+        if ((k % 2))
         {
-          // Create duplicate vertices at each point
-          // and adjust the associated normals so that they are
-          // oriented with the facets. This preserves the tube's
-          // polygonal appearance, as if by flat-shading around the tube,
-          // while still allowing smooth (gouraud) shading along the
-          // tube as it bends.
-          normal[i] = w[i] * cos((double)(k + 0.0) * this->Theta) +
-            nP[i] * sin((double)(k + 0.0) * this->Theta);
-          n_right[i] = w[i] * cos((double)(k - 0.5) * this->Theta) +
-            nP[i] * sin((double)(k - 0.5) * this->Theta);
-          n_left[i] = w[i] * cos((double)(k + 0.5) * this->Theta) +
-            nP[i] * sin((double)(k + 0.5) * this->Theta);
-          s[i] = p[i] + this->Radius * sFactor * normal[i];
+          *conn++ = startIdx + i1;
+          i1--;
         }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, n_right);
-        outPD->CopyData(pd, pts[j], ptId);
-        newPts->InsertPoint(ptId + 1, s);
-        newNormals->InsertTuple(ptId + 1, n_left);
-        outPD->CopyData(pd, pts[j], ptId + 1);
-        ptId += 2;
-      } // for each side
-    }   // else separate vertices
-  }     // for all points in polyline
-
-  // Produce end points for cap. They are placed at tail end of points.
-  if (this->Capping)
-  {
-    int numCapSides = this->NumberOfSides;
-    int capIncr = 1;
-    if (!this->SidesShareVertices)
-    {
-      numCapSides = 2 * this->NumberOfSides;
-      capIncr = 2;
+        else
+        {
+          *conn++ = startIdx + i2;
+          i2++;
+        }
+      }
     }
+  }
 
-    // the start cap
-    for (k = 0; k < numCapSides; k += capIncr)
-    {
-      newPts->GetPoint(offset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, startCapNorm);
-      outPD->CopyData(pd, pts[0], ptId);
-      ptId++;
-    }
-    // the end cap
-    int endOffset = offset + (npts - 1) * this->NumberOfSides;
+  // Generate the texture coordinates of the polyline
+  void GenerateTextureCoords(
+    vtkIdType offset, vtkIdType npts, const TubeLocalData& local, vtkFloatArray* newTCoords) const
+  {
+    const vtkIdType* pts = local.Pts.data();
+    double tc = 0.0;
+
+    int numSides = this->NumberOfSides;
     if (!this->SidesShareVertices)
     {
-      endOffset = offset + 2 * (npts - 1) * this->NumberOfSides;
+      numSides = 2 * this->NumberOfSides;
     }
-    for (k = 0; k < numCapSides; k += capIncr)
-    {
-      newPts->GetPoint(endOffset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, endCapNorm);
-      outPD->CopyData(pd, pts[npts - 1], ptId);
-      ptId++;
-    }
-  } // if capping
-
-  return 1;
-}
-
-void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
-  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
-  vtkCellArray* newStrips)
-{
-  vtkIdType i, outCellId;
-  int k;
-  int i1, i2, i3;
 
-  if (this->SidesShareVertices)
-  {
-    for (k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
+    double s0, s;
+    if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS)
     {
-      i1 = k % this->NumberOfSides;
-      i2 = (k + 1) % this->NumberOfSides;
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
-      for (i = 0; i < npts; i++)
+      s0 = this->InScalars->GetTuple1(pts[0]);
+      for (vtkIdType i = 0; i < npts; i++)
       {
-        i3 = i * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        s = this->InScalars->GetTuple1(pts[i]);
+        tc = (s - s0) / this->TextureLength;
+        for (int k = 0; k < numSides; k++)
+        {
+          double tcy = static_cast<double>(k) / (numSides - 1);
+          newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
+        }
       }
-    } // for each side of the tube
-  }
-  else
-  {
-    for (k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
+    }
+    else if (this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH)
     {
-      i1 = 2 * (k % this->NumberOfSides) + 1;
-      i2 = 2 * ((k + 1) % this->NumberOfSides);
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
-      for (i = 0; i < npts; i++)
+      double xPrev[3], x[3], len = 0.0;
+      this->InPts->GetPoint(pts[0], xPrev);
+      for (vtkIdType i = 0; i < npts; i++)
       {
-        i3 = i * 2 * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
-      }
-    } // for each side of the tube
-  }
-
-  // Take care of capping. The caps are n-sided polygons that can be
-  // easily triangle stripped.
-  if (this->Capping)
-  {
-    vtkIdType startIdx = offset + npts * this->NumberOfSides;
-    vtkIdType idx;
+        this->InPts->GetPoint(pts[i], x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        tc = len / this->TextureLength;
+        for (int k = 0; k < numSides; k++)
+        {
+          double tcy = static_cast<double>(k) / (numSides - 1);
+          newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
+        }
 
-    if (!this->SidesShareVertices)
-    {
-      startIdx = offset + 2 * npts * this->NumberOfSides;
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
+      }
     }
-
-    // The start cap
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + 1);
-    for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
+    else if (this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
     {
-      if ((k % 2))
+      double xPrev[3], x[3], length = 0.0, len = 0.0;
+      this->InPts->GetPoint(pts[0], xPrev);
+      for (vtkIdType i = 0; i < npts; i++)
       {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
-        i2++;
+        this->InPts->GetPoint(pts[i], x);
+        length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
       }
-      else
+
+      this->InPts->GetPoint(pts[0], xPrev);
+      for (vtkIdType i = 0; i < npts; i++)
       {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
-        i1--;
+        this->InPts->GetPoint(pts[i], x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        tc = len / length;
+        for (int k = 0; k < numSides; k++)
+        {
+          double tcy = static_cast<double>(k) / (numSides - 1);
+          newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
+        }
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
       }
     }
 
-    // The end cap - reversed order to be consistent with normal
-    startIdx += this->NumberOfSides;
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
-    for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
+    // Capping, set the endpoints as appropriate
+    if (this->Capping)
     {
-      if ((k % 2))
+      vtkIdType startIdx = offset + npts * numSides;
+
+      // start cap
+      for (int ik = 0; ik < this->NumberOfSides; ik++)
       {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
-        i1--;
+        newTCoords->SetTuple2(startIdx + ik, 0.0, 0.0);
       }
-      else
+
+      // end cap
+      for (int ik = 0; ik < this->NumberOfSides; ik++)
       {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
-        i2++;
+        newTCoords->SetTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
       }
     }
   }
+};
+
+// A generator with the settings of the filter, used to tube a single
+// polyline with the deprecated helper methods.
+TubeGenerator MakeGenerator(vtkTubeFilter* self, double theta)
+{
+  TubeGenerator generator;
+  generator.InPts = nullptr;
+  generator.InLines = nullptr;
+  generator.InNormals = nullptr;
+  generator.UseDefaultNormal = false;
+  self->GetDefaultNormal(generator.DefaultNormal);
+  generator.InScalars = nullptr;
+  generator.InVectors = nullptr;
+  generator.Range[0] = 0.0;
+  generator.Range[1] = 1.0;
+  generator.MaxSpeed = 0.0;
+  generator.Radius = self->GetRadius();
+  generator.VaryRadius = self->GetVaryRadius();
+  generator.RadiusFactor = self->GetRadiusFactor();
+  generator.NumberOfSides = self->GetNumberOfSides();
+  generator.SidesShareVertices = self->GetSidesShareVertices() != 0;
+  generator.Capping = self->GetCapping() != 0;
+  generator.OnRatio = self->GetOnRatio();
+  generator.Offset = self->GetOffset();
+  generator.GenerateTCoords = self->GetGenerateTCoords();
+  generator.TextureLength = self->GetTextureLength();
+  generator.Theta = theta;
+  return generator;
 }
 
-void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-  vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords)
+}
+
+int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  vtkIdType i;
-  int k;
-  double tc = 0.0;
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
-  int numSides = this->NumberOfSides;
-  if (!this->SidesShareVertices)
+  // get the input and output
+  vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  vtkCellArray* inLines;
+  vtkDataArray* inScalars = this->GetInputArrayToProcess(0, inputVector);
+  vtkDataArray* inVectors = this->GetInputArrayToProcess(1, inputVector);
+
+  vtkPoints* inPts;
+  vtkIdType numPts;
+  vtkIdType numLines;
+  double range[2] = { 0.0, 1.0 }, maxSpeed = 0;
+
+  // Check input and initialize
+  //
+  vtkDebugMacro(<< "Creating tube");
+
+  if (!(inPts = input->GetPoints()) || (numPts = inPts->GetNumberOfPoints()) < 1 ||
+    !(inLines = input->GetLines()) || (numLines = inLines->GetNumberOfCells()) < 1)
   {
-    numSides = 2 * this->NumberOfSides;
+    return 1;
+  }
+
+  TubeGenerator generator;
+  generator.InPts = inPts;
+  generator.InLines = inLines;
+  generator.InScalars = inScalars;
+  generator.InVectors = inVectors;
+  generator.Radius = this->Radius;
+  generator.VaryRadius = this->VaryRadius;
+  generator.RadiusFactor = this->RadiusFactor;
+  generator.NumberOfSides = this->NumberOfSides;
+  generator.SidesShareVertices = this->SidesShareVertices != 0;
+  generator.Capping = this->Capping != 0;
+  generator.OnRatio = this->OnRatio;
+  generator.Offset = this->Offset;
+  generator.GenerateTCoords = this->GenerateTCoords;
+  generator.TextureLength = this->TextureLength;
+  generator.Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
+  this->Theta = generator.Theta;
+
+  // Normals are either given, the default normal, or generated for each
+  // polyline. The default normal is stored as the float normals would be.
+  generator.UseDefaultNormal = this->UseDefaultNormal != 0;
+  generator.InNormals = this->UseDefaultNormal ? nullptr : pd->GetNormals();
+  for (int i = 0; i < 3; i++)
+  {
+    generator.DefaultNormal[i] = static_cast<float>(this->DefaultNormal[i]);
   }
 
-  double s0, s;
-  if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS)
+  // If varying width, get appropriate info.
+  //
+  if (inScalars)
   {
-    s0 = inScalars->GetTuple1(pts[0]);
-    for (i = 0; i < npts; i++)
+    pd->GetRange(inScalars->GetName(), range, 0);
+    if ((range[1] - range[0]) == 0.0)
     {
-      s = inScalars->GetTuple1(pts[i]);
-      tc = (s - s0) / this->TextureLength;
-      for (k = 0; k < numSides; k++)
+      if (this->VaryRadius == VTK_VARY_RADIUS_BY_SCALAR)
       {
-        double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        vtkWarningMacro(<< "Scalar range is zero!");
       }
+      range[1] = range[0] + 1.0;
     }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH)
-  {
-    double xPrev[3], x[3], len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 0; i < npts; i++)
+    if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
     {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / this->TextureLength;
-      for (k = 0; k < numSides; k++)
+      // use a radius of 1.0 so that radius*scalar = scalar
+      generator.Radius = 1.0;
+      if (range[0] < 0.0)
       {
-        double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        vtkWarningMacro(<< "Scalar values fall below zero when using absolute radius values!");
       }
-
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
     }
   }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  if (inVectors)
+  {
+    maxSpeed = inVectors->GetMaxNorm();
+  }
+  generator.Range[0] = range[0];
+  generator.Range[1] = range[1];
+  generator.MaxSpeed = maxSpeed;
+
+  // First pass: remove the degenerate segments of the polylines, compute the
+  // frames of their tubes, and count the output of each batch of polylines.
+  // The polylines are processed again in the second pass, which avoids
+  // keeping the frames of all the polylines in memory.
+  TubeBatches batches;
+  batches.Initialize(numLines);
+  vtkSMPThreadLocal<TubeLocalData> localData;
+  const vtkIdType numCellsPerLine = generator.GetNumberOfCells();
   {
-    double xPrev[3], x[3], length = 0.0, len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 0; i < npts; i++)
+    double x[3];
+    inPts->GetPoint(0, x); // for thread safety of GetPoint later on
+  }
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    TubeLocalData& local = localData.Local();
+    std::string warning;
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      inPts->GetPoint(pts[i], x);
-      length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      TubeBatch& batch = batches[batchId];
+      for (vtkIdType lineId = batch.BeginId; lineId < batch.EndId; ++lineId)
+      {
+        warning.clear();
+        const vtkIdType npts = generator.PrepareLine(lineId, local, warning);
+        if (npts > 0)
+        {
+          batch.Data.NumberOfPoints += generator.GetNumberOfPoints(npts);
+          batch.Data.NumberOfCells += numCellsPerLine;
+          batch.Data.ConnectivitySize += generator.GetConnectivitySize(npts);
+        }
+        else if (!warning.empty())
+        {
+          local.Warnings.emplace_back(lineId, warning);
+        }
+      }
     }
+  });
 
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 0; i < npts; i++)
+  // Report the polylines that could not be tubed, in order
+  std::vector<std::pair<vtkIdType, std::string>> warnings;
+  for (TubeLocalData& local : localData)
+  {
+    warnings.insert(warnings.end(), local.Warnings.begin(), local.Warnings.end());
+    local.Warnings.clear();
+  }
+  std::sort(warnings.begin(), warnings.end());
+  for (const auto& warning : warnings)
+  {
+    vtkWarningMacro(<< warning.second);
+    vtkWarningMacro(<< "Could not generate points!");
+  }
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+  const TubeBatchData totals = batches.BuildOffsetsAndGetGlobalSum();
+  this->UpdateProgress(0.5);
+
+  // Create the geometry and topology
+  const vtkIdType numNewPts = totals.NumberOfPoints;
+  const vtkIdType numNewCells = totals.NumberOfCells;
+  vtkNew<vtkPoints> newPts;
+
+  // Set the desired precision for the points in the output.
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkFloatArray> newNormals;
+  newNormals->SetName("TubeNormals");
+  newNormals->SetNumberOfComponents(3);
+  newNormals->SetNumberOfTuples(numNewPts);
+  vtkNew<vtkIdTypeArray> newOffsets;
+  newOffsets->SetNumberOfValues(numNewCells + 1);
+  newOffsets->SetValue(numNewCells, totals.ConnectivitySize);
+  vtkNew<vtkIdTypeArray> newConnectivity;
+  newConnectivity->SetNumberOfValues(totals.ConnectivitySize);
+
+  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
+  vtkSmartPointer<vtkFloatArray> newTCoords;
+  outPD->CopyNormalsOff();
+  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  {
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(2);
+    newTCoords->SetNumberOfTuples(numNewPts);
+    outPD->CopyTCoordsOff();
+  }
+  outPD->CopyAllocate(pd, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+
+  // Copy selected parts of cell data; certainly don't want normals
+  //
+  outCD->CopyNormalsOff();
+  outCD->CopyAllocate(cd, numNewCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
+
+  //  Second pass: create points along each polyline that are connected into
+  //  NumberOfSides triangle strips. Texture coordinates are optionally
+  //  generated.
+  //
+  // the line cellIds start after the last vert cellId
+  const vtkIdType numVerts = input->GetNumberOfVerts();
+  vtkIdType* outOffsets = newOffsets->GetPointer(0);
+  vtkIdType* outConnectivity = newConnectivity->GetPointer(0);
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    TubeLocalData& local = localData.Local();
+    std::string warning;
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / length;
-      for (k = 0; k < numSides; k++)
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
       {
-        double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        break;
       }
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
+      const TubeBatch& batch = batches[batchId];
+      TubeBatchData offsets = batch.Data;
+      for (vtkIdType lineId = batch.BeginId; lineId < batch.EndId; ++lineId)
+      {
+        const vtkIdType npts = generator.PrepareLine(lineId, local, warning);
+        if (npts == 0)
+        {
+          continue; // skip tubing this polyline
+        }
+
+        // Generate the points around the polyline.
+        generator.GeneratePoints(
+          offsets.NumberOfPoints, npts, local, newPts, newNormals, pointArrays);
+
+        // Generate the strips for this polyline (including caps)
+        generator.GenerateStrips(offsets.NumberOfPoints, npts, numVerts + lineId,
+          offsets.NumberOfCells, offsets.ConnectivitySize, outOffsets, outConnectivity,
+          cellArrays);
+
+        // Generate the texture coordinates for this polyline
+        if (newTCoords)
+        {
+          generator.GenerateTextureCoords(offsets.NumberOfPoints, npts, local, newTCoords);
+        }
+
+        // Compute the new offsets for the next polyline
+        offsets.NumberOfPoints += generator.GetNumberOfPoints(npts);
+        offsets.NumberOfCells += numCellsPerLine;
+        offsets.ConnectivitySize += generator.GetConnectivitySize(npts);
+      } // for all polylines
     }
+  });
+
+  // Update ourselves
+  //
+  if (newTCoords)
+  {
+    outPD->SetTCoords(newTCoords);
   }
 
-  // Capping, set the endpoints as appropriate
-  if (this->Capping)
+  output->SetPoints(newPts);
+
+  vtkNew<vtkCellArray> newStrips;
+  newStrips->SetData(newOffsets, newConnectivity);
+  output->SetStrips(newStrips);
+
+  outPD->SetNormals(newNormals);
+
+  output->Squeeze();
+
+  return 1;
+}
+
+int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
+  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
+  double maxSpeed, vtkDataArray* inNormals)
+{
+  TubeGenerator generator = MakeGenerator(this, this->Theta);
+  generator.InPts = inPts;
+  generator.InNormals = inNormals;
+  generator.InScalars = inScalars;
+  generator.InVectors = inVectors;
+  generator.Range[0] = range[0];
+  generator.Range[1] = range[1];
+  generator.MaxSpeed = maxSpeed;
+
+  TubeLocalData local;
+  local.Pts.assign(pts, pts + npts);
+  std::string warning;
+  if (!generator.ComputeFrames(npts, local, warning))
   {
-    int ik;
-    vtkIdType startIdx = offset + npts * numSides;
+    vtkWarningMacro(<< warning);
+    return 0;
+  }
 
-    // start cap
-    for (ik = 0; ik < this->NumberOfSides; ik++)
+  // Generate the tube alone, then insert it at the offset
+  const vtkIdType numTubePts = generator.GetNumberOfPoints(npts);
+  vtkNew<vtkPoints> tubePts;
+  tubePts->SetDataType(VTK_DOUBLE);
+  tubePts->SetNumberOfPoints(numTubePts);
+  vtkNew<vtkFloatArray> tubeNormals;
+  tubeNormals->SetNumberOfComponents(3);
+  tubeNormals->SetNumberOfTuples(numTubePts);
+  ArrayList noArrays;
+  generator.GeneratePoints(0, npts, local, tubePts, tubeNormals, noArrays);
+  for (vtkIdType i = 0; i < numTubePts; i++)
+  {
+    newPts->InsertPoint(offset + i, tubePts->GetPoint(i));
+    newNormals->InsertTuple(offset + i, tubeNormals->GetTuple(i));
+  }
+
+  // The points around each point of the polyline, then the caps
+  const vtkIdType numSides =
+    this->SidesShareVertices ? this->NumberOfSides : 2 * this->NumberOfSides;
+  vtkIdType ptId = offset;
+  for (vtkIdType j = 0; j < npts; j++)
+  {
+    for (vtkIdType k = 0; k < numSides; k++)
     {
-      newTCoords->InsertTuple2(startIdx + ik, 0.0, 0.0);
+      outPD->CopyData(pd, pts[j], ptId++);
     }
-
-    // end cap
-    for (ik = 0; ik < this->NumberOfSides; ik++)
+  }
+  if (this->Capping)
+  {
+    for (int k = 0; k < this->NumberOfSides; k++)
+    {
+      outPD->CopyData(pd, pts[0], ptId++);
+    }
+    for (int k = 0; k < this->NumberOfSides; k++)
     {
-      newTCoords->InsertTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
+      outPD->CopyData(pd, pts[npts - 1], ptId++);
     }
   }
+  return 1;
 }
 
-// Compute the number of points in this tube
-vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
+void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
+  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
+  vtkCellArray* newStrips)
 {
-  if (this->SidesShareVertices)
+  TubeGenerator generator = MakeGenerator(this, this->Theta);
+  const vtkIdType numCells = generator.GetNumberOfCells();
+  std::vector<vtkIdType> offsets(numCells + 1);
+  offsets[numCells] = generator.GetConnectivitySize(npts);
+  std::vector<vtkIdType> connectivity(offsets[numCells]);
+  ArrayList noArrays;
+  generator.GenerateStrips(
+    offset, npts, inCellId, 0, 0, offsets.data(), connectivity.data(), noArrays);
+
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
   {
-    offset += this->NumberOfSides * npts;
-  }
-  else
-  {
-    offset += 2 * this->NumberOfSides * npts; // points are duplicated
+    const vtkIdType outCellId = newStrips->InsertNextCell(
+      offsets[cellId + 1] - offsets[cellId], connectivity.data() + offsets[cellId]);
+    outCD->CopyData(cd, inCellId, outCellId);
   }
+}
 
-  if (this->Capping)
+void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+  vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords)
+{
+  TubeGenerator generator = MakeGenerator(this, this->Theta);
+  generator.InPts = inPts;
+  generator.InScalars = inScalars;
+
+  TubeLocalData local;
+  local.Pts.assign(pts, pts + npts);
+  const vtkIdType numTubePts = generator.GetNumberOfPoints(npts);
+  vtkNew<vtkFloatArray> tubeTCoords;
+  tubeTCoords->SetNumberOfComponents(2);
+  tubeTCoords->SetNumberOfTuples(numTubePts);
+  tubeTCoords->FillValue(0.0f);
+  generator.GenerateTextureCoords(0, npts, local, tubeTCoords);
+  for (vtkIdType i = 0; i < numTubePts; i++)
   {
-    offset += 2 * this->NumberOfSides; // cap points are duplicated
+    newTCoords->InsertTuple(offset + i, tubeTCoords->GetTuple(i));
   }
+}
 
-  return offset;
+vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
+{
+  return offset + MakeGenerator(this, this->Theta).GetNumberOfPoints(npts);
 }
 
 // Description:
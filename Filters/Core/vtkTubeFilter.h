@@ -33,6 +33,12 @@
  * can be removed with vtkCleanPolyData.) If a line does not meet this
  * criteria, then that line is not tubed.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The polylines are tubed
+ * independently, and the output is the same with any number of threads.
+ * Using TBB or other non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkRibbonFilter vtkStreamTracer vtkTubeBender
  *
@@ -43,6 +49,7 @@
 #ifndef vtkTubeFilter_h
 #define vtkTubeFilter_h
 
+#include "vtkDeprecation.h"      // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
@@ -241,19 +248,24 @@ protected:
   int OutputPointsPrecision;
   double TextureLength; // this length is mapped to [0,1) texture space
 
-  // Helper methods
+  // Helper methods, which tube a single polyline
+  VTK_DEPRECATED_IN_9_4_0("The polylines are tubed concurrently by RequestData.")
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
     vtkDataArray* inNormals);
+  VTK_DEPRECATED_IN_9_4_0("The polylines are tubed concurrently by RequestData.")
   void GenerateStrips(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
+  VTK_DEPRECATED_IN_9_4_0("The polylines are tubed concurrently by RequestData.")
   void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
+  VTK_DEPRECATED_IN_9_4_0("The polylines are tubed concurrently by RequestData.")
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
   // Helper data members
-  double Theta;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated helper methods.")
+  double Theta = 0.0;
 
 private:
   vtkTubeFilter(const vtkTubeFilter&) = delete;
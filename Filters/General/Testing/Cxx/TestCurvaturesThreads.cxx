@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkCurvatures computes the same curvatures with any number of
+// threads.
+
+#include "vtkCellArray.h"
+#include "vtkCurvatures.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestSMPUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// A triangulated torus
+vtkSmartPointer<vtkPolyData> MakeSurface()
+{
+  const int nu = 150;
+  const int nv = 60;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < nv; ++j)
+  {
+    for (int i = 0; i < nu; ++i)
+    {
+      const double u = 2.0 * vtkMath::Pi() * i / nu;
+      const double v = 2.0 * vtkMath::Pi() * j / nv;
+      const double r = 1.0 + 0.4 * std::cos(v);
+      points->InsertNextPoint(r * std::cos(u), r * std::sin(u), 0.4 * std::sin(v));
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < nv; ++j)
+  {
+    for (int i = 0; i < nu; ++i)
+    {
+      const vtkIdType p0 = j * nu + i;
+      const vtkIdType p1 = j * nu + (i + 1) % nu;
+      const vtkIdType p2 = ((j + 1) % nv) * nu + (i + 1) % nu;
+      const vtkIdType p3 = ((j + 1) % nv) * nu + i;
+      const vtkIdType triangle0[3] = { p0, p1, p2 };
+      const vtkIdType triangle1[3] = { p0, p2, p3 };
+      polys->InsertNextCell(3, triangle0);
+      polys->InsertNextCell(3, triangle1);
+    }
+  }
+  vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+  return surface;
+}
+}
+
+int TestCurvaturesThreads(int, char*[])
+{
+  bool success = true;
+  vtkNew<vtkCurvatures> curvatures;
+  curvatures->SetInputData(MakeSurface());
+  for (int type : { VTK_CURVATURE_GAUSS, VTK_CURVATURE_MEAN, VTK_CURVATURE_MAXIMUM,
+         VTK_CURVATURE_MINIMUM })
+  {
+    curvatures->SetCurvatureType(type);
+    curvatures->SetInvertMeanCurvature(type == VTK_CURVATURE_MEAN);
+    if (!vtkTest::SamePolyDataOnOneThread(curvatures.GetPointer()) ||
+      !curvatures->GetOutput()->GetPointData()->GetScalars())
+    {
+      std::cerr << "The curvatures of type " << type << " depend on the number of threads"
+                << std::endl;
+      success = false;
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
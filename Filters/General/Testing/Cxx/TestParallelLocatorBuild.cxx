@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkCellLocator, vtkKdTree and vtkOBBTree build the same search
+// structures with any number of threads, and the same ones as the serial
+// implementations they replace, whose results are stored below.
+
+#include "vtkCellLocator.h"
+#include "vtkIdList.h"
+#include "vtkKdTree.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+
+namespace
+{
+bool SameIds(vtkIdList* ids0, vtkIdList* ids1)
+{
+  if (!ids0 || !ids1)
+  {
+    return ids0 == ids1;
+  }
+  return ids0->GetNumberOfIds() == ids1->GetNumberOfIds() &&
+    std::equal(ids0->begin(), ids0->end(), ids1->begin());
+}
+
+bool SamePoints(vtkPolyData* polyData0, vtkPolyData* polyData1)
+{
+  vtkPoints* points0 = polyData0->GetPoints();
+  vtkPoints* points1 = polyData1->GetPoints();
+  if (!points0 || !points1 || points0->GetNumberOfPoints() != points1->GetNumberOfPoints())
+  {
+    return false;
+  }
+  double x0[3], x1[3];
+  for (vtkIdType ptId = 0; ptId < points0->GetNumberOfPoints(); ++ptId)
+  {
+    points0->GetPoint(ptId, x0);
+    points1->GetPoint(ptId, x1);
+    if (x0[0] != x1[0] || x0[1] != x1[1] || x0[2] != x1[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Order-sensitive checksum of the ids of a list, chained with the previous lists
+void HashIds(vtkIdList* ids, std::uint64_t& hash)
+{
+  hash = hash * 31 + 7;
+  if (ids)
+  {
+    for (vtkIdType id : *ids)
+    {
+      hash = hash * 1000003 + static_cast<std::uint64_t>(id + 1);
+    }
+  }
+}
+
+// Run build on a single thread
+void BuildOnSingleThread(const std::function<void()>& build)
+{
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, build);
+}
+}
+
+int TestParallelLocatorBuild(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(300);
+  sphere->SetPhiResolution(300);
+  sphere->Update();
+  vtkPolyData* mesh = sphere->GetOutput();
+  const vtkIdType numCells = mesh->GetNumberOfCells();
+
+  int status = EXIT_SUCCESS;
+
+  // The octants of the cell locators hold the same cells in the same order
+  vtkNew<vtkCellLocator> cellLocator;
+  cellLocator->SetDataSet(mesh);
+  cellLocator->BuildLocator();
+  vtkNew<vtkCellLocator> serialCellLocator;
+  serialCellLocator->SetDataSet(mesh);
+  BuildOnSingleThread([&]() { serialCellLocator->BuildLocator(); });
+  bool sameOctants = cellLocator->GetNumberOfBuckets() > 1 &&
+    cellLocator->GetNumberOfBuckets() == serialCellLocator->GetNumberOfBuckets();
+  vtkIdType numLeafCells = 0;
+  for (int octant = 0; sameOctants && octant < cellLocator->GetNumberOfBuckets(); ++octant)
+  {
+    vtkIdList* cells = cellLocator->GetCells(octant);
+    sameOctants = SameIds(cells, serialCellLocator->GetCells(octant));
+    numLeafCells += cells ? cells->GetNumberOfIds() : 0;
+  }
+  if (!sameOctants || numLeafCells < numCells)
+  {
+    std::cerr << "The cell locator depends on the number of threads" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  std::uint64_t octantsHash = 0;
+  for (int octant = 0; octant < cellLocator->GetNumberOfBuckets(); ++octant)
+  {
+    HashIds(cellLocator->GetCells(octant), octantsHash);
+  }
+  if (cellLocator->GetNumberOfBuckets() != 37449 || numLeafCells != 290808 ||
+    octantsHash != UINT64_C(17563791269741187955))
+  {
+    std::cerr << "The cell locator differs from the serial implementation" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // The k-d trees have the same regions and cells
+  vtkNew<vtkKdTree> kdTree;
+  kdTree->SetDataSet(mesh);
+  kdTree->SetMinCells(50);
+  kdTree->BuildLocator();
+  kdTree->CreateCellLists();
+  vtkNew<vtkKdTree> serialKdTree;
+  serialKdTree->SetDataSet(mesh);
+  serialKdTree->SetMinCells(50);
+  BuildOnSingleThread([&]() { serialKdTree->BuildLocator(); });
+  serialKdTree->CreateCellLists();
+  bool sameRegions = kdTree->GetNumberOfRegions() > 1 &&
+    kdTree->GetNumberOfRegions() == serialKdTree->GetNumberOfRegions() &&
+    kdTree->GetLevel() == serialKdTree->GetLevel();
+  for (int region = 0; sameRegions && region < kdTree->GetNumberOfRegions(); ++region)
+  {
+    double bounds[6], serialBounds[6];
+    kdTree->GetRegionBounds(region, bounds);
+    serialKdTree->GetRegionBounds(region, serialBounds);
+    sameRegions = std::equal(bounds, bounds + 6, serialBounds) &&
+      SameIds(kdTree->GetCellList(region), serialKdTree->GetCellList(region));
+  }
+  if (!sameRegions)
+  {
+    std::cerr << "The k-d tree depends on the number of threads" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  std::uint64_t regionsHash = 0;
+  vtkIdType numRegionCells = 0;
+  double boundsSum = 0.0;
+  for (int region = 0; region < kdTree->GetNumberOfRegions(); ++region)
+  {
+    HashIds(kdTree->GetCellList(region), regionsHash);
+    numRegionCells += kdTree->GetCellList(region)->GetNumberOfIds();
+    double bounds[6];
+    kdTree->GetRegionBounds(region, bounds);
+    for (int i = 0; i < 6; ++i)
+    {
+      boundsSum += (i + 1) * bounds[i] * (region + 1);
+    }
+  }
+  if (kdTree->GetNumberOfRegions() != 2059 || kdTree->GetLevel() != 13 ||
+    numRegionCells != 178800 || regionsHash != UINT64_C(12792027695579540819) ||
+    std::abs(boundsSum - 4640515.0105100814) > 1e-6)
+  {
+    std::cerr << "The k-d tree differs from the serial implementation" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // The OBB trees have the same boxes, and find the same intersections
+  vtkNew<vtkOBBTree> obbTree;
+  obbTree->SetDataSet(mesh);
+  obbTree->BuildLocator();
+  vtkNew<vtkOBBTree> serialOBBTree;
+  serialOBBTree->SetDataSet(mesh);
+  BuildOnSingleThread([&]() { serialOBBTree->BuildLocator(); });
+  vtkNew<vtkPolyData> leaves, serialLeaves;
+  obbTree->GenerateRepresentation(-1, leaves);
+  serialOBBTree->GenerateRepresentation(-1, serialLeaves);
+  bool sameBoxes = obbTree->GetLevel() > 1 && obbTree->GetLevel() == serialOBBTree->GetLevel() &&
+    SamePoints(leaves, serialLeaves);
+  const double p0[3] = { -1.0, -0.9, -0.8 };
+  const double p1[3] = { 1.0, 0.8, 0.9 };
+  vtkNew<vtkPoints> intersections, serialIntersections;
+  vtkNew<vtkIdList> cellIds, serialCellIds;
+  obbTree->IntersectWithLine(p0, p1, intersections, cellIds);
+  serialOBBTree->IntersectWithLine(p0, p1, serialIntersections, serialCellIds);
+  if (!sameBoxes || cellIds->GetNumberOfIds() != 2 || !SameIds(cellIds, serialCellIds))
+  {
+    std::cerr << "The OBB tree depends on the number of threads" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  double cornersSum = 0.0;
+  for (vtkIdType ptId = 0; ptId < leaves->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    leaves->GetPoint(ptId, x);
+    cornersSum += (ptId % 97 + 1) * (x[0] + 2 * x[1] + 3 * x[2]);
+  }
+  if (obbTree->GetLevel() != 12 || leaves->GetNumberOfPoints() != 29584 ||
+    std::abs(cornersSum + 15275.577063731529) > 1e-6 || cellIds->GetNumberOfIds() != 2 ||
+    cellIds->GetId(0) != 112061 || cellIds->GetId(1) != 17397)
+  {
+    std::cerr << "The OBB tree differs from the serial implementation" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
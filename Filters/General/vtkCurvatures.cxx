@@ -16,15 +16,393 @@
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkTriangleStrip.h"
 
-#include <memory> // For unique_ptr
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCurvatures);
 
+namespace
+{
+// Sort the cells in the range [cells,cells+ncells) by increasing ids, without
+// duplicates. The curvatures are accumulated over the cells using a point in
+// this order, so that the sums do not depend on the order of the links.
+void SortCells(const vtkIdType* cells, vtkIdType ncells, std::vector<vtkIdType>& sortedCells)
+{
+  sortedCells.assign(cells, cells + ncells);
+  std::sort(sortedCells.begin(), sortedCells.end());
+  sortedCells.erase(std::unique(sortedCells.begin(), sortedCells.end()), sortedCells.end());
+}
+
+// Compute the contribution Hf of the edge (v_l,v_r) of the facet f to the mean
+// curvature of its end points. Only the edges with exactly one neighbor n > f
+// contribute, so that every edge comes only once.
+bool ComputeEdgeCurvature(vtkPolyData* polyData, vtkIdType f, vtkIdType v_l, vtkIdType v_r,
+  vtkIdType v_o, vtkIdList* vertices_n, vtkIdList* neighbours, double& Hf)
+{
+  polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
+
+  vtkIdType n; // n short for neighbor
+
+  // compute only if there is really ONE neighbour
+  // AND meanCurvature has not been computed yet!
+  // (ensured by n > f)
+  if (neighbours->GetNumberOfIds() != 1 || (n = neighbours->GetId(0)) <= f)
+  {
+    return false;
+  }
+
+  double n_f[3]; // normal of facet (could be stored for later?)
+  double n_n[3]; // normal of edge
+  double t[3];   // to store the cross product of n_f n_n
+  double ore[3]; // origin of e
+  double end[3]; // end of e
+  double oth[3]; //     third vertex necessary for comp of n
+  double vn0[3];
+  double vn1[3]; // vertices for computation of neighbour's n
+  double vn2[3];
+  double e[3]; // edge (oriented)
+
+  // find 3 corners of f: in order!
+  polyData->GetPoint(v_l, ore);
+  polyData->GetPoint(v_r, end);
+  polyData->GetPoint(v_o, oth);
+  // compute normal of f
+  vtkTriangle::ComputeNormal(ore, end, oth, n_f);
+  // compute common edge
+  e[0] = end[0];
+  e[1] = end[1];
+  e[2] = end[2];
+  e[0] -= ore[0];
+  e[1] -= ore[1];
+  e[2] -= ore[2];
+  const double length = vtkMath::Normalize(e);
+  double Af = vtkTriangle::TriangleArea(ore, end, oth);
+  // find 3 corners of n: in order!
+  polyData->GetCellPoints(n, vertices_n);
+  polyData->GetPoint(vertices_n->GetId(0), vn0);
+  polyData->GetPoint(vertices_n->GetId(1), vn1);
+  polyData->GetPoint(vertices_n->GetId(2), vn2);
+  Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
+  // compute normal of n
+  vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
+  // the cosine is n_f * n_n
+  const double cs = vtkMath::Dot(n_f, n_n);
+  // the sin is (n_f x n_n) * e
+  vtkMath::Cross(n_f, n_n, t);
+  const double sn = vtkMath::Dot(t, e);
+  // signed angle in [-pi,pi]
+  if (sn != 0.0 || cs != 0.0)
+  {
+    const double angle = atan2(sn, cs);
+    Hf = length * angle;
+  }
+  else
+  {
+    Hf = 0.0;
+  }
+  // weight Hf by the area of the facets
+  if (Af != 0.0)
+  {
+    (Hf /= Af) *= 3.0;
+  }
+  return true;
+}
+
+// Gather the mean curvature of each point from the edges using it. The
+// facets using a point are visited in increasing order, so that the
+// contributions of the edges are summed in the same order as when they were
+// scattered to the points by a loop over the facets.
+struct MeanCurvature
+{
+  vtkPolyData* PolyData;
+  double* MeanCurvatureData;
+  bool Invert;
+  vtkCurvatures* Filter;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> Vertices;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> Vertices_n;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> Neighbours;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Facets;
+
+  MeanCurvature(
+    vtkPolyData* polyData, double* meanCurvatureData, bool invert, vtkCurvatures* filter)
+    : PolyData(polyData)
+    , MeanCurvatureData(meanCurvatureData)
+    , Invert(invert)
+    , Filter(filter)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Vertices.Local().TakeReference(vtkIdList::New());
+    this->Vertices_n.Local().TakeReference(vtkIdList::New());
+    this->Neighbours.Local().TakeReference(vtkIdList::New());
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkPolyData* polyData = this->PolyData;
+    vtkIdList* vertices = this->Vertices.Local();
+    vtkIdList* vertices_n = this->Vertices_n.Local();
+    vtkIdList* neighbours = this->Neighbours.Local();
+    std::vector<vtkIdType>& facets = this->Facets.Local();
+    vtkIdType ncells, nv;
+    vtkIdType* cells;
+    const vtkIdType* pts;
+    double Hf;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      polyData->GetPointCells(ptId, ncells, cells);
+      SortCells(cells, ncells, facets);
+      double H = 0.0;
+      int num_neighb = 0;
+      for (vtkIdType f : facets)
+      {
+        polyData->GetCellPoints(f, nv, pts, vertices);
+        for (vtkIdType v = 0; v < nv; v++)
+        {
+          const vtkIdType v_l = pts[v];
+          const vtkIdType v_r = pts[(v + 1) % nv];
+          if ((v_l == ptId || v_r == ptId) &&
+            ComputeEdgeCurvature(
+              polyData, f, v_l, v_r, pts[(v + 2) % nv], vertices_n, neighbours, Hf))
+          {
+            // add weighted Hf to scalar at v_l and v_r
+            if (v_l == ptId)
+            {
+              H += Hf;
+              num_neighb += 1;
+            }
+            if (v_r == ptId)
+            {
+              H += Hf;
+              num_neighb += 1;
+            }
+          }
+        }
+      }
+
+      // put curvature in vtkArray
+      if (num_neighb > 0)
+      {
+        H = 0.5 * H / num_neighb;
+        this->MeanCurvatureData[ptId] = this->Invert ? -H : H;
+      }
+      else
+      {
+        this->MeanCurvatureData[ptId] = 0.0;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Gather the Gauss curvature of each point from the facets using it, in
+// increasing order as for the mean curvature.
+struct GaussCurvature
+{
+  vtkCellArray* Facets;
+  vtkPolyData* Output;
+  vtkStaticCellLinksTemplate<vtkIdType>* Links;
+  double* GaussCurvatureData;
+  vtkCurvatures* Filter;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> Vertices;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> SortedFacets;
+
+  GaussCurvature(vtkCellArray* facets, vtkPolyData* output,
+    vtkStaticCellLinksTemplate<vtkIdType>* links, double* gaussCurvatureData,
+    vtkCurvatures* filter)
+    : Facets(facets)
+    , Output(output)
+    , Links(links)
+    , GaussCurvatureData(gaussCurvatureData)
+    , Filter(filter)
+  {
+  }
+
+  void Initialize() { this->Vertices.Local().TakeReference(vtkIdList::New()); }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkPolyData* output = this->Output;
+    vtkIdList* vertices = this->Vertices.Local();
+    std::vector<vtkIdType>& facets = this->SortedFacets.Local();
+    double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
+    const double* edges[3] = { e0, e1, e2 };
+    const double pi2 = 2.0 * vtkMath::Pi();
+    vtkIdType npts;
+    const vtkIdType* vert;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      SortCells(this->Links->GetCells(ptId), this->Links->GetNumberOfCells(ptId), facets);
+      double K = pi2;
+      double dA = 0.0;
+      for (vtkIdType f : facets)
+      {
+        this->Facets->GetCellAtId(f, npts, vert, vertices);
+        output->GetPoint(vert[0], v0);
+        output->GetPoint(vert[1], v1);
+        output->GetPoint(vert[2], v2);
+        // edges
+        e0[0] = v1[0];
+        e0[1] = v1[1];
+        e0[2] = v1[2];
+        e0[0] -= v0[0];
+        e0[1] -= v0[1];
+        e0[2] -= v0[2];
+
+        e1[0] = v2[0];
+        e1[1] = v2[1];
+        e1[2] = v2[2];
+        e1[0] -= v1[0];
+        e1[1] -= v1[1];
+        e1[2] -= v1[2];
+
+        e2[0] = v0[0];
+        e2[1] = v0[1];
+        e2[2] = v0[2];
+        e2[0] -= v2[0];
+        e2[1] -= v2[1];
+        e2[2] -= v2[2];
+
+        // surf. area
+        const double A = double(vtkTriangle::TriangleArea(v0, v1, v2));
+        // UPDATE with the angle of the facet at the point
+        for (int j = 0; j < 3; ++j)
+        {
+          if (vert[j] == ptId)
+          {
+            dA += A;
+            K -= vtkMath::Pi() - vtkMath::AngleBetweenVectors(edges[(j + 2) % 3], edges[j]);
+          }
+        }
+      }
+
+      // put curvature in vtkArray
+      if (dA > 0.0)
+      {
+        this->GaussCurvatureData[ptId] = 3.0 * K / dA;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Compute the maximum (Sign = 1) or minimum (Sign = -1) curvature of the
+// points from their Gauss and mean curvatures. The points where the
+// curvatures are inconsistent are reported in increasing order.
+struct PrincipalCurvature
+{
+  const double* Gauss;
+  const double* Mean;
+  double* Curvature;
+  double Sign;
+  vtkCurvatures* Filter;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> LocalInaccurate;
+  std::vector<vtkIdType> Inaccurate;
+
+  PrincipalCurvature(const double* gauss, const double* mean, double* curvature, double sign,
+    vtkCurvatures* filter)
+    : Gauss(gauss)
+    , Mean(mean)
+    , Curvature(curvature)
+    , Sign(sign)
+    , Filter(filter)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    std::vector<vtkIdType>& inaccurate = this->LocalInaccurate.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      const double k = this->Gauss[ptId];
+      const double h = this->Mean[ptId];
+      const double tmp = h * h - k;
+      if (tmp >= 0)
+      {
+        this->Curvature[ptId] = h + this->Sign * sqrt(tmp);
+      }
+      else
+      {
+        this->Curvature[ptId] = h;
+        if (tmp < -0.1)
+        {
+          inaccurate.push_back(ptId);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (const auto& inaccurate : this->LocalInaccurate)
+    {
+      this->Inaccurate.insert(this->Inaccurate.end(), inaccurate.begin(), inaccurate.end());
+    }
+    std::sort(this->Inaccurate.begin(), this->Inaccurate.end());
+  }
+};
+}
+
 //-------------------------------------------------------//
 vtkCurvatures::vtkCurvatures()
 {
@@ -65,9 +443,6 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   int numPts = polyData->GetNumberOfPoints();
 
   //     create-allocate
-  const vtkNew<vtkIdList> vertices;
-  const vtkNew<vtkIdList> vertices_n;
-  const vtkNew<vtkIdList> neighbours;
   const vtkNew<vtkDoubleArray> meanCurvature;
   meanCurvature->SetName("Mean_Curvature");
   meanCurvature->SetNumberOfComponents(1);
@@ -75,130 +450,15 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   // Get the array so we can write to it directly
   double* meanCurvatureData = meanCurvature->GetPointer(0);
 
-  //     create-allocate
-  double n_f[3]; // normal of facet (could be stored for later?)
-  double n_n[3]; // normal of edge
-  double t[3];   // to store the cross product of n_f n_n
-  double ore[3]; // origin of e
-  double end[3]; // end of e
-  double oth[3]; //     third vertex necessary for comp of n
-  double vn0[3];
-  double vn1[3]; // vertices for computation of neighbour's n
-  double vn2[3];
-  double e[3]; // edge (oriented)
-
   polyData->BuildLinks();
-  // data init
-  const int F = polyData->GetNumberOfCells();
-  // init, preallocate the mean curvature
-  const std::unique_ptr<int[]> num_neighb(new int[numPts]);
-  for (int v = 0; v < numPts; v++)
-  {
-    meanCurvatureData[v] = 0.0;
-    num_neighb[v] = 0;
-  }
 
   //     main loop
-  vtkDebugMacro(<< "Main loop: loop over facets such that id > id of neighb");
-  vtkDebugMacro(<< "so that every edge comes only once");
+  vtkDebugMacro(<< "Main loop: loop over points, and over the edges of the facets");
+  vtkDebugMacro(<< "using them such that id of facet < id of neighb");
 
-  for (vtkIdType f = 0; f < F; ++f)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    polyData->GetCellPoints(f, vertices);
-    const vtkIdType nv = vertices->GetNumberOfIds();
-
-    for (vtkIdType v = 0; v < nv; v++)
-    {
-      // get neighbour
-      const vtkIdType v_l = vertices->GetId(v);
-      const vtkIdType v_r = vertices->GetId((v + 1) % nv);
-      const vtkIdType v_o = vertices->GetId((v + 2) % nv);
-      polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
-
-      vtkIdType n; // n short for neighbor
-
-      // compute only if there is really ONE neighbour
-      // AND meanCurvature has not been computed yet!
-      // (ensured by n > f)
-      if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
-      {
-        double Hf; // temporary store
-
-        // find 3 corners of f: in order!
-        polyData->GetPoint(v_l, ore);
-        polyData->GetPoint(v_r, end);
-        polyData->GetPoint(v_o, oth);
-        // compute normal of f
-        vtkTriangle::ComputeNormal(ore, end, oth, n_f);
-        // compute common edge
-        e[0] = end[0];
-        e[1] = end[1];
-        e[2] = end[2];
-        e[0] -= ore[0];
-        e[1] -= ore[1];
-        e[2] -= ore[2];
-        const double length = vtkMath::Normalize(e);
-        double Af = vtkTriangle::TriangleArea(ore, end, oth);
-        // find 3 corners of n: in order!
-        polyData->GetCellPoints(n, vertices_n);
-        polyData->GetPoint(vertices_n->GetId(0), vn0);
-        polyData->GetPoint(vertices_n->GetId(1), vn1);
-        polyData->GetPoint(vertices_n->GetId(2), vn2);
-        Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
-        // compute normal of n
-        vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
-        // the cosine is n_f * n_n
-        const double cs = vtkMath::Dot(n_f, n_n);
-        // the sin is (n_f x n_n) * e
-        vtkMath::Cross(n_f, n_n, t);
-        const double sn = vtkMath::Dot(t, e);
-        // signed angle in [-pi,pi]
-        if (sn != 0.0 || cs != 0.0)
-        {
-          const double angle = atan2(sn, cs);
-          Hf = length * angle;
-        }
-        else
-        {
-          Hf = 0.0;
-        }
-        // add weighted Hf to scalar at v_l and v_r
-        if (Af != 0.0)
-        {
-          (Hf /= Af) *= 3.0;
-        }
-        meanCurvatureData[v_l] += Hf;
-        meanCurvatureData[v_r] += Hf;
-        num_neighb[v_l] += 1;
-        num_neighb[v_r] += 1;
-      }
-    }
-  }
-
-  // put curvature in vtkArray
-  for (int v = 0; v < numPts; v++)
-  {
-    if (num_neighb[v] > 0)
-    {
-      const double Hf = 0.5 * meanCurvatureData[v] / num_neighb[v];
-      if (this->InvertMeanCurvature)
-      {
-        meanCurvatureData[v] = -Hf;
-      }
-      else
-      {
-        meanCurvatureData[v] = Hf;
-      }
-    }
-    else
-    {
-      meanCurvatureData[v] = 0.0;
-    }
-  }
+  MeanCurvature meanCurvatureWorker(
+    polyData, meanCurvatureData, this->InvertMeanCurvature != 0, this);
+  vtkSMPTools::For(0, numPts, meanCurvatureWorker);
 
   mesh->GetPointData()->AddArray(meanCurvature);
   mesh->GetPointData()->SetActiveScalars("Mean_Curvature");
@@ -261,80 +521,14 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
 void vtkCurvatures::ComputeGaussCurvature(
   vtkCellArray* facets, vtkPolyData* output, double* gaussCurvatureData)
 {
-  double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
-
-  double A, alpha0, alpha1, alpha2;
-
-  vtkIdType f;
-  const vtkIdType* vert = nullptr;
-
   // other data
   vtkIdType Nv = output->GetNumberOfPoints();
 
-  const std::unique_ptr<double[]> K(new double[Nv]);
-  const std::unique_ptr<double[]> dA(new double[Nv]);
-  double pi2 = 2.0 * vtkMath::Pi();
-  for (int k = 0; k < Nv; k++)
-  {
-    K[k] = pi2;
-    dA[k] = 0.0;
-  }
-
-  facets->InitTraversal();
-  while (facets->GetNextCell(f, vert))
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    output->GetPoint(vert[0], v0);
-    output->GetPoint(vert[1], v1);
-    output->GetPoint(vert[2], v2);
-    // edges
-    e0[0] = v1[0];
-    e0[1] = v1[1];
-    e0[2] = v1[2];
-    e0[0] -= v0[0];
-    e0[1] -= v0[1];
-    e0[2] -= v0[2];
-
-    e1[0] = v2[0];
-    e1[1] = v2[1];
-    e1[2] = v2[2];
-    e1[0] -= v1[0];
-    e1[1] -= v1[1];
-    e1[2] -= v1[2];
-
-    e2[0] = v0[0];
-    e2[1] = v0[1];
-    e2[2] = v0[2];
-    e2[0] -= v2[0];
-    e2[1] -= v2[1];
-    e2[2] -= v2[2];
-
-    alpha0 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2);
-    alpha1 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0);
-    alpha2 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1);
-
-    // surf. area
-    A = double(vtkTriangle::TriangleArea(v0, v1, v2));
-    // UPDATE
-    dA[vert[0]] += A;
-    dA[vert[1]] += A;
-    dA[vert[2]] += A;
-    K[vert[0]] -= alpha1;
-    K[vert[1]] -= alpha2;
-    K[vert[2]] -= alpha0;
-  }
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.ThreadedBuildLinks(Nv, facets->GetNumberOfCells(), facets);
 
-  // put curvature in vtkArray
-  for (int v = 0; v < Nv; v++)
-  {
-    if (dA[v] > 0.0)
-    {
-      gaussCurvatureData[v] = 3.0 * K[v] / dA[v];
-    }
-  }
+  GaussCurvature gaussCurvatureWorker(facets, output, &links, gaussCurvatureData, this);
+  vtkSMPTools::For(0, Nv, gaussCurvatureWorker);
 }
 
 void vtkCurvatures::GetMaximumCurvature(vtkPolyData* input, vtkPolyData* output)
@@ -355,33 +549,15 @@ void vtkCurvatures::GetMaximumCurvature(vtkPolyData* input, vtkPolyData* output)
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Gauss_Curvature"));
   vtkDoubleArray* mean =
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Mean_Curvature"));
-  double k, h, k_max, tmp;
 
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
+  PrincipalCurvature maximumCurvatureWorker(gauss->GetPointer(0), mean->GetPointer(0),
+    maximumCurvature->GetPointer(0), 1.0, this);
+  vtkSMPTools::For(0, numPts, maximumCurvatureWorker);
 
-    k = gauss->GetComponent(i, 0);
-    h = mean->GetComponent(i, 0);
-    tmp = h * h - k;
-    if (tmp >= 0)
-    {
-      k_max = h + sqrt(tmp);
-    }
-    else
-    {
-      k_max = h;
-      if (tmp < -0.1)
-      {
-        vtkWarningMacro(
-          << "The Gaussian or mean curvature at point " << i
-          << " have a large computation error... The maximum curvature is likely off.");
-      }
-    }
-    maximumCurvature->SetComponent(i, 0, k_max);
+  for (vtkIdType i : maximumCurvatureWorker.Inaccurate)
+  {
+    vtkWarningMacro(<< "The Gaussian or mean curvature at point " << i
+                    << " have a large computation error... The maximum curvature is likely off.");
   }
 }
 
@@ -403,33 +579,15 @@ void vtkCurvatures::GetMinimumCurvature(vtkPolyData* input, vtkPolyData* output)
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Gauss_Curvature"));
   vtkDoubleArray* mean =
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Mean_Curvature"));
-  double k, h, k_min, tmp;
 
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
+  PrincipalCurvature minimumCurvatureWorker(gauss->GetPointer(0), mean->GetPointer(0),
+    minimumCurvature->GetPointer(0), -1.0, this);
+  vtkSMPTools::For(0, numPts, minimumCurvatureWorker);
 
-    k = gauss->GetComponent(i, 0);
-    h = mean->GetComponent(i, 0);
-    tmp = h * h - k;
-    if (tmp >= 0)
-    {
-      k_min = h - sqrt(tmp);
-    }
-    else
-    {
-      k_min = h;
-      if (tmp < -0.1)
-      {
-        vtkWarningMacro(
-          << "The Gaussian or mean curvature at point " << i
-          << " have a large computation error... The minimum curvature is likely off.");
-      }
-    }
-    minimumCurvature->SetComponent(i, 0, k_min);
+  for (vtkIdType i : minimumCurvatureWorker.Inaccurate)
+  {
+    vtkWarningMacro(<< "The Gaussian or mean curvature at point " << i
+                    << " have a large computation error... The minimum curvature is likely off.");
   }
 }
 
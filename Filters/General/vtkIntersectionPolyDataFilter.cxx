@@ -20,6 +20,8 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkTransform.h"
@@ -28,8 +30,14 @@
 #include "vtkTriangleFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -49,6 +57,39 @@ struct simPolygon
   int orientation;
 };
 
+// Intersection line of a triangle of each input
+struct TriangleIntersection
+{
+  vtkIdType CellIds[2];
+  vtkIdType TriPtIds[2][3];
+  double Points[2][3];
+  double SurfaceId[2];
+};
+
+// New cell of a split cell which lies along intersection lines
+struct NewCellOnLines
+{
+  vtkIdType CellIndex;
+  int InterPtCount;
+  int InterPts[3];
+};
+
+// Split of a single cell. The cells are split independently, and the
+// boundary points and the new cell ids of the intersection lines are then
+// updated in the order of the cells.
+struct CellSplit
+{
+  vtkSmartPointer<vtkCellArray> Cells;
+
+  // Points of the cell and of the intersection lines splitting it, and sign
+  // of the transform of the cell to the XY-plane
+  vtkSmartPointer<vtkPoints> Points;
+  int TransformSign = 0;
+
+  std::vector<std::pair<vtkIdType, int>> BoundaryPoints;
+  std::vector<NewCellOnLines> NewCells;
+};
+
 }
 
 typedef std::multimap<vtkIdType, vtkIdType> IntersectionMapType;
@@ -73,17 +114,24 @@ public:
   Impl();
   virtual ~Impl();
 
-  // Finds all triangle triangle intersections between two input OOBTrees
+  // Collects the pairs of intersecting leaf nodes of the two input OBBTrees
   static int FindTriangleIntersections(
     vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
 
+  // Finds all triangle triangle intersections between the collected node
+  // pairs, and adds them to the intersection lines and maps
+  void IntersectNodePairs();
+
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
 protected:
+  // Adds a triangle triangle intersection to the intersection lines and maps
+  void AddIntersection(TriangleIntersection& intersection);
+
   // Split cells into polygons created by intersection lines
   vtkCellArray* SplitCell(vtkPolyData* input, vtkIdType cellId, const vtkIdType* cellPts,
-    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, int numCurrCells);
+    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, CellSplit& split);
 
   // Function to add point to check edge list for remeshing step
   int AddToPointEdgeMap(int index, vtkIdType ptId, double x[3], vtkPolyData* mesh, vtkIdType cellId,
@@ -94,22 +142,23 @@ protected:
     int inputIndex, int interPtCount, int interPts[3], vtkPolyData* interLines, int numCurrCells);
 
   // Function inside SplitCell to get the smaller triangle loops
-  int GetLoops(vtkPolyData* pd, std::vector<simPolygon>* loops);
+  int GetLoops(vtkPolyData* pd, std::vector<simPolygon>* loops, const CellSplit& split);
 
   // Get individual polygon loop of splitting cell
   int GetSingleLoop(vtkPolyData* pd, simPolygon* loop, vtkIdType nextCell,
-    std::vector<bool>& interPtBool, std::vector<bool>& lineBool);
+    std::vector<bool>& interPtBool, std::vector<bool>& lineBool, const CellSplit& split);
 
   // Follow a loop orientation to iterate around a split polygon
   int FollowLoopOrientation(vtkPolyData* pd, simPolygon* loop, vtkIdType* nextCell,
-    vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells);
+    vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells, const CellSplit& split);
 
   // Set the loop orientation based on CW CCW geometric test
   void SetLoopOrientation(vtkPolyData* pd, simPolygon* loop, vtkIdType* nextCell, vtkIdType nextPt,
-    vtkIdType prevPt, vtkIdList* pointCells);
+    vtkIdType prevPt, vtkIdList* pointCells, const CellSplit& split);
 
   // Get the loop orientation is already given
-  int GetLoopOrientation(vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2);
+  int GetLoopOrientation(vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2,
+    const CellSplit& split);
 
   // Orient the triangle based on the transform for remeshing
   void Orient(
@@ -126,6 +175,12 @@ public:
   vtkPolyData* Mesh[2];
   vtkOBBTree* OBBTree1;
 
+  // Pairs of leaf nodes whose bounding boxes intersect
+  std::vector<std::pair<vtkOBBNode*, vtkOBBNode*>> NodePairs;
+
+  // Intersection lines already added, by increasing point ids
+  std::set<std::pair<vtkIdType, vtkIdType>> LineEdges;
+
   // Stores the intersection lines.
   vtkCellArray* IntersectionLines;
 
@@ -158,10 +213,6 @@ public:
   // cell, and the ID of the line.
   PointEdgeMapType* PointEdgeMap[2];
 
-  // vtkPolyData to hold current splitting cell. Used to double check area
-  // of small area cells
-  vtkPolyData* SplittingPD;
-  int TransformSign;
   double Tolerance;
   double RelativeSubtriangleArea;
 
@@ -189,8 +240,6 @@ vtkIntersectionPolyDataFilter::Impl::Impl()
     this->PointEdgeMap[i] = new PointEdgeMapType();
   }
   this->PointMapper = new IntersectionMapType();
-  this->SplittingPD = vtkPolyData::New();
-  this->TransformSign = 0;
   this->Tolerance = 1e-6;
   this->RelativeSubtriangleArea = 1e-4;
 }
@@ -205,250 +254,290 @@ vtkIntersectionPolyDataFilter::Impl::~Impl()
     delete this->PointEdgeMap[i];
   }
   delete this->PointMapper;
-  this->SplittingPD->Delete();
 }
 
 //------------------------------------------------------------------------------
 int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
-  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg)
+  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* vtkNotUsed(transform), void* arg)
 {
   vtkIntersectionPolyDataFilter::Impl* info =
     reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
 
-  // Set up local structures to hold Impl array information
-  vtkPolyData* mesh0 = info->Mesh[0];
-  vtkPolyData* mesh1 = info->Mesh[1];
-  vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
-  double tolerance = info->Tolerance;
-
-  // The number of cells in OBBTree
-  int numCells0 = node0->Cells->GetNumberOfIds();
-
-  for (vtkIdType id0 = 0; id0 < numCells0; id0++)
-  {
-    vtkIdType cellId0 = node0->Cells->GetId(id0);
-    int type0 = mesh0->GetCellType(cellId0);
-
-    // Make sure the cell is a triangle
-    if (type0 == VTK_TRIANGLE)
+  // The triangles of the leaf nodes are intersected later on, in parallel.
+  info->NodePairs.emplace_back(node0, node1);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::IntersectNodePairs()
+{
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkOBBTree* obbTree1 = this->OBBTree1;
+  const double tolerance = this->Tolerance;
+  const vtkIdType numNodePairs = static_cast<vtkIdType>(this->NodePairs.size());
+  std::vector<std::vector<TriangleIntersection>> intersections(numNodePairs);
+
+  // Intersect the triangles of each pair of leaf nodes in parallel
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPoints0;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPoints1;
+  vtkSMPTools::For(0, numNodePairs, [&](vtkIdType pairId, vtkIdType endPairId) {
+    vtkIdList* cellPoints0 = tlCellPoints0.Local();
+    vtkIdList* cellPoints1 = tlCellPoints1.Local();
+    for (; pairId < endPairId; ++pairId)
     {
-      vtkIdType npts0;
-      const vtkIdType* triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
-      double triPts0[3][3];
-      for (vtkIdType id = 0; id < npts0; id++)
-      {
-        mesh0->GetPoint(triPtIds0[id], triPts0[id]);
-      }
+      vtkOBBNode* node0 = this->NodePairs[pairId].first;
+      vtkOBBNode* node1 = this->NodePairs[pairId].second;
+      std::vector<TriangleIntersection>& pairIntersections = intersections[pairId];
 
-      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], transform))
+      const vtkIdType numCells0 = node0->Cells->GetNumberOfIds();
+      for (vtkIdType id0 = 0; id0 < numCells0; id0++)
       {
-        int numCells1 = node1->Cells->GetNumberOfIds();
+        vtkIdType cellId0 = node0->Cells->GetId(id0);
+
+        // Make sure the cell is a triangle
+        if (mesh0->GetCellType(cellId0) != VTK_TRIANGLE)
+        {
+          continue;
+        }
+        vtkIdType npts0;
+        const vtkIdType* triPtIds0;
+        mesh0->GetCellPoints(cellId0, npts0, triPtIds0, cellPoints0);
+        double triPts0[3][3];
+        for (vtkIdType id = 0; id < npts0; id++)
+        {
+          mesh0->GetPoint(triPtIds0[id], triPts0[id]);
+        }
+
+        if (!obbTree1->TriangleIntersectsNode(
+              node1, triPts0[0], triPts0[1], triPts0[2], nullptr))
+        {
+          continue;
+        }
+        const vtkIdType numCells1 = node1->Cells->GetNumberOfIds();
         for (vtkIdType id1 = 0; id1 < numCells1; id1++)
         {
           vtkIdType cellId1 = node1->Cells->GetId(id1);
-          int type1 = mesh1->GetCellType(cellId1);
-          if (type1 == VTK_TRIANGLE)
+          if (mesh1->GetCellType(cellId1) != VTK_TRIANGLE)
           {
-            // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
-            vtkIdType npts1;
-            const vtkIdType* triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
-
-            double triPts1[3][3];
-            for (vtkIdType id = 0; id < npts1; id++)
-            {
-              mesh1->GetPoint(triPtIds1[id], triPts1[id]);
-            }
+            continue;
+          }
+          // See if the two cells actually intersect. If they do, the
+          // intersection is added to the maps afterwards.
+          vtkIdType npts1;
+          const vtkIdType* triPtIds1;
+          mesh1->GetCellPoints(cellId1, npts1, triPtIds1, cellPoints1);
+
+          double triPts1[3][3];
+          for (vtkIdType id = 0; id < npts1; id++)
+          {
+            mesh1->GetPoint(triPtIds1[id], triPts1[id]);
+          }
 
-            int coplanar = 0;
-            double outpt0[3], outpt1[3];
-            double surfaceid[2];
-            int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
-              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, outpt0, outpt1,
-              surfaceid, tolerance);
+          TriangleIntersection intersection;
+          int coplanar = 0;
+          int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(
+            triPts0[0], triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar,
+            intersection.Points[0], intersection.Points[1], intersection.SurfaceId, tolerance);
 
-            if (coplanar)
-            {
-              // Coplanar triangle intersection is not handled.
-              // This intersection will not be included in the output. TODO
-              // vtkDebugMacro(<<"Coplanar");
-              intersects = 0;
-              continue;
-            }
+          // Coplanar triangle intersection is not handled.
+          // This intersection will not be included in the output. TODO
+          if (intersects && !coplanar)
+          {
+            intersection.CellIds[0] = cellId0;
+            intersection.CellIds[1] = cellId1;
+            std::copy(triPtIds0, triPtIds0 + 3, intersection.TriPtIds[0]);
+            std::copy(triPtIds1, triPtIds1 + 3, intersection.TriPtIds[1]);
+            pairIntersections.push_back(intersection);
+          }
+        }
+      }
+    }
+  });
 
-            // If actual intersection, add point and cell to edge, line,
-            // and surface maps!
-            if (intersects)
-            {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+  // Merge the intersection points and lines in the order of the traversal
+  // of the trees.
+  for (auto& pairIntersections : intersections)
+  {
+    for (auto& intersection : pairIntersections)
+    {
+      this->AddIntersection(intersection);
+    }
+  }
+  this->NodePairs.clear();
+  this->LineEdges.clear();
+}
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::AddIntersection(TriangleIntersection& intersection)
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+  const vtkIdType cellId0 = intersection.CellIds[0];
+  const vtkIdType cellId1 = intersection.CellIds[1];
+  const vtkIdType* triPtIds0 = intersection.TriPtIds[0];
+  const vtkIdType* triPtIds1 = intersection.TriPtIds[1];
+  double* outpt0 = intersection.Points[0];
+  double* outpt1 = intersection.Points[1];
+  const double* surfaceid = intersection.SurfaceId;
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
-        }
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
+
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
       }
     }
   }
 
-  return 1;
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    if (this->LineEdges.count(std::minmax(ptId0, ptId1)))
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+    this->LineEdges.insert(std::minmax(ptId0, ptId1));
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -527,10 +616,56 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
     newPolys->AllocateEstimate(cells->GetNumberOfCells(), 3);
     output->SetPolys(newPolys);
 
-    vtkSmartPointer<vtkIdList> edgeNeighbors = vtkSmartPointer<vtkIdList>::New();
+    // Split the cells in parallel. The split lines are only read from now on.
+    const vtkIdType numPolys = cells->GetNumberOfCells();
+    std::vector<std::unique_ptr<CellSplit>> splits(numPolys);
+    splitLines->BuildLinks();
+    input->GetBounds();
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPoints;
+    vtkSMPThreadLocalObject<vtkIdList> tlEdgeNeighbors;
+    vtkSMPTools::For(0, numPolys, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* cellPoints = tlCellPoints.Local();
+      vtkIdList* edgeNeighbors = tlEdgeNeighbors.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (; cellId < endCellId; ++cellId)
+      {
+        cells->GetCellAtId(cellId, npts, pts, cellPoints);
+        if (npts != 3)
+        {
+          continue;
+        }
+
+        // If the cell is in the intersection map, split. If not, one of its
+        // edges may be split by an intersection line that splits a
+        // neighbor cell. Mark the cell as needing a split if this is
+        // the case.
+        bool needsSplit = intersectionMap->find(cellId) != intersectionMap->end();
+        for (vtkIdType ptId = 0; ptId < npts && !needsSplit; ptId++)
+        {
+          input->GetCellEdgeNeighbors(cellId, pts[ptId], pts[(ptId + 1) % npts], edgeNeighbors);
+          for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
+          {
+            if (intersectionMap->find(edgeNeighbors->GetId(nbr)) != intersectionMap->end())
+            {
+              needsSplit = true;
+            }
+          }
+        }
+
+        // Splitting occurs here
+        if (needsSplit)
+        {
+          splits[cellId].reset(new CellSplit);
+          splits[cellId]->Cells = vtk::TakeSmartPointer(this->SplitCell(
+            input, cellId, pts, intersectionMap, splitLines, inputIndex, *splits[cellId]));
+        }
+      }
+    });
+
+    // Add the cells to the output in order
     vtkIdType nptsX = 0;
     const vtkIdType* pts = nullptr;
-    vtkSmartPointer<vtkIdList> cellsToCheck = vtkSmartPointer<vtkIdList>::New();
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
     {
       if (nptsX != 3)
@@ -540,36 +675,8 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
         continue;
       }
 
-      cellsToCheck->Reset();
-      cellsToCheck->Allocate(nptsX + 1);
-      cellsToCheck->InsertNextId(cellIdX);
-
-      // Collect the cells relevant for splitting this cell.  If the
-      // cell is in the intersection map, split. If not, one of its
-      // edges may be split by an intersection line that splits a
-      // neighbor cell. Mark the cell as needing a split if this is
-      // the case.
-      bool needsSplit = intersectionMap->find(cellIdX) != intersectionMap->end();
-      for (vtkIdType ptId = 0; ptId < nptsX; ptId++)
-      {
-        vtkIdType pt0Id = pts[ptId];
-        vtkIdType pt1Id = pts[(ptId + 1) % nptsX];
-        edgeNeighbors->Reset();
-        input->GetCellEdgeNeighbors(cellIdX, pt0Id, pt1Id, edgeNeighbors);
-        for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
-        {
-          vtkIdType nbrId = edgeNeighbors->GetId(nbr);
-          cellsToCheck->InsertNextId(nbrId);
-
-          if (intersectionMap->find(nbrId) != intersectionMap->end())
-          {
-            needsSplit = true;
-          }
-        } // for (vtkIdType nbr = 0; ...
-      }   // for (vtkIdType pt = 0; ...
-
-      // Splitting occurs here
-      if (!needsSplit)
+      CellSplit* split = splits[cellIdX].get();
+      if (!split)
       {
         // Just insert the cell and copy the cell data
         newId = newPolys->InsertNextCell(3, pts);
@@ -577,11 +684,20 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
       }
       else
       {
+        for (const auto& boundaryPoint : split->BoundaryPoints)
+        {
+          this->BoundaryPoints[inputIndex]->InsertValue(boundaryPoint.first, boundaryPoint.second);
+        }
+
         // Total number of cells so that we know the id numbers of the new
         // cells added and we can add it to the new cell id mapping
-        int numCurrCells = newPolys->GetNumberOfCells();
-        vtkCellArray* splitCells = this->SplitCell(
-          input, cellIdX, pts, intersectionMap, splitLines, inputIndex, numCurrCells);
+        const vtkIdType numCurrCells = newPolys->GetNumberOfCells();
+        for (auto& newCell : split->NewCells)
+        {
+          this->AddToNewCellMap(inputIndex, newCell.InterPtCount, newCell.InterPts, splitLines,
+            static_cast<int>(numCurrCells + newCell.CellIndex));
+        }
+        vtkCellArray* splitCells = split->Cells;
         if (splitCells == nullptr)
         {
           vtkDebugWithObjectMacro(this->ParentFilter, << "Error in splitting cell!");
@@ -624,7 +740,7 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
           outCD->CopyData(inCD, cellIdX, newId); // Duplicate cell data
         }
-        splitCells->Delete();
+        splits[cellIdX].reset();
       }
     } // for (cells->InitTraversal(); ...
   }   // if inputGetPolys()->GetNumberOfCells() > 1 ...
@@ -634,7 +750,7 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
 vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input, vtkIdType cellId,
   const vtkIdType* cellPts, IntersectionMapType* map, vtkPolyData* interLines, int inputIndex,
-  int numCurrCells)
+  CellSplit& split)
 {
   // Copy down the SurfaceID array that tells which surface the point belongs
   // to
@@ -667,6 +783,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
 
   // Set up line cells and array to track the just the intersecting lines
   // on the cell.
+  vtkNew<vtkIdList> linePoints;
   vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
   vtkSmartPointer<vtkCellArray> interceptlines = vtkSmartPointer<vtkCellArray>::New();
 
@@ -688,7 +805,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     vtkIdType lineId = iterLower->second;
     vtkIdType nLinePts;
     const vtkIdType* linePtIds;
-    interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds);
+    interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds, linePoints);
 
     interceptlines->InsertNextCell(2);
     lines->InsertNextCell(2);
@@ -784,7 +901,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         vtkIdType lineId = iterLower->second;
         vtkIdType nLinePts;
         const vtkIdType* linePtIds;
-        interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds);
+        interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds, linePoints);
         for (vtkIdType k = 0; k < nLinePts; k++)
         {
           if (linePtIds[k] >= interLines->GetNumberOfPoints())
@@ -917,15 +1034,15 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     // Setting the boundary points
     if (ptId > 2)
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(reverseIdMap[ptId], 1);
+      split.BoundaryPoints.emplace_back(reverseIdMap[ptId], 1);
     }
     else if (CellPointOnInterLine[ptId])
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 1);
+      split.BoundaryPoints.emplace_back(cellPts[ptId], 1);
     }
     else
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 0);
+      split.BoundaryPoints.emplace_back(cellPts[ptId], 0);
     }
   }
   // Sort the edgePtIdList according to the angle list. The starting
@@ -962,7 +1079,8 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   // Set up a transform that will rotate the points to the
   // XY-plane (normal aligned with z-axis).
   vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
-  this->TransformSign = this->GetTransform(transform, points);
+  split.Points = points;
+  split.TransformSign = this->GetTransform(transform, points);
 
   vtkCellArray* splitCells = vtkCellArray::New();
   vtkSmartPointer<vtkPolyData> interpd = vtkSmartPointer<vtkPolyData>::New();
@@ -973,7 +1091,6 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   vtkSmartPointer<vtkPolyData> fullpd = vtkSmartPointer<vtkPolyData>::New();
   fullpd->SetPoints(points);
   fullpd->SetLines(lines);
-  SplittingPD->DeepCopy(fullpd);
 
   vtkSmartPointer<vtkTransformPolyDataFilter> transformer =
     vtkSmartPointer<vtkTransformPolyDataFilter>::New();
@@ -989,7 +1106,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   {
     // Get polygon loops of intersected triangle
     std::vector<simPolygon> loops;
-    if (this->GetLoops(transformedpd, &loops) != 1)
+    if (this->GetLoops(transformedpd, &loops, split) != 1)
     {
       splitCells->Delete();
       splitCells = nullptr;
@@ -1110,7 +1227,6 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       // Renumber the point IDs.
       vtkIdType npts;
       const vtkIdType* ptIds;
-      interLines->BuildLinks();
       for (polys->InitTraversal(); polys->GetNextCell(npts, ptIds);)
       {
         if (pointMapper[ptIds[0]] >= points->GetNumberOfPoints() ||
@@ -1122,7 +1238,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
 
         splitCells->InsertNextCell(npts);
         int interPtCount = 0;
-        int interPts[3];
+        int interPts[3] = { 0, 0, 0 };
         for (int i = 0; i < npts; i++)
         {
           vtkIdType remappedPtId;
@@ -1145,9 +1261,9 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         if (interPtCount >= 2) // If there are more than two, inter line
         {
           // Add the information to new cell mapping on intersection lines
-          this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+          split.NewCells.push_back({ splitCells->GetNumberOfCells() - 1, interPtCount,
+            { interPts[0], interPts[1], interPts[2] } });
         }
-        numCurrCells++;
       }
       delete[] pointMapper;
     }
@@ -1182,7 +1298,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
 
       splitCells->InsertNextCell(npts);
       int interPtCount = 0;
-      int interPts[3];
+      int interPts[3] = { 0, 0, 0 };
       for (int i = 0; i < npts; i++)
       {
         vtkIdType remappedPtId;
@@ -1203,9 +1319,9 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       }
       if (interPtCount >= 2)
       {
-        this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+        split.NewCells.push_back({ splitCells->GetNumberOfCells() - 1, interPtCount,
+          { interPts[0], interPts[1], interPts[2] } });
       }
-      numCurrCells++;
     }
   }
 
@@ -1318,7 +1434,8 @@ void vtkIntersectionPolyDataFilter::Impl::AddToNewCellMap(
   delete[] cellIds;
 }
 
-int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<simPolygon>* loops)
+int vtkIntersectionPolyDataFilter::Impl ::GetLoops(
+  vtkPolyData* pd, std::vector<simPolygon>* loops, const CellSplit& split)
 {
   vtkSmartPointer<vtkIdList> pointCells = vtkSmartPointer<vtkIdList>::New();
   vtkSmartPointer<vtkIdList> cellPoints = vtkSmartPointer<vtkIdList>::New();
@@ -1345,11 +1462,12 @@ int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<
 
       ptBool[nextPt.id] = true;
       pd->GetPointCells(nextPt.id, pointCells);
+      std::sort(pointCells->begin(), pointCells->end(), std::greater<vtkIdType>());
       nextCell = pointCells->GetId(0);
       lineBool[nextCell] = true;
 
       // Get one loop for untouched point
-      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool) != 1)
+      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool, split) != 1)
       {
         return 0;
       }
@@ -1373,7 +1491,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<
       nextCell = lineId;
 
       // Get single loop if the line is still untouched
-      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool) != 1)
+      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool, split) != 1)
       {
         return 0;
       }
@@ -1388,7 +1506,8 @@ int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<
 //------------------------------------------------------------------------------
 
 int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPolygon* loop,
-  vtkIdType nextCell, std::vector<bool>& interPtBool, std::vector<bool>& lineBool)
+  vtkIdType nextCell, std::vector<bool>& interPtBool, std::vector<bool>& lineBool,
+  const CellSplit& split)
 {
   int intertype = 0;
   vtkSmartPointer<vtkIdList> pointCells = vtkSmartPointer<vtkIdList>::New();
@@ -1422,6 +1541,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
   while (nextPt != startPt)
   {
     pd->GetPointCells(nextPt, pointCells);
+    std::sort(pointCells->begin(), pointCells->end(), std::greater<vtkIdType>());
     // There are multiple lines attached to this point; must figure out
     // the correct way to go
     if (pointCells->GetNumberOfIds() > 2)
@@ -1430,14 +1550,15 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
       // set the orientation of the loop (i.e. CW or CCW)
       if (intertype == 0)
       {
-        this->SetLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells);
+        this->SetLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells, split);
         intertype = 1;
       }
       // This is not the first intersection. Follow line that continues along
       // the set loop orientation
       else
       {
-        if (this->FollowLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells) != 1)
+        if (this->FollowLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells, split) !=
+          1)
         {
           return 0;
         }
@@ -1497,6 +1618,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
   {
     nextPt = 0;
     pd->GetPointCells(nextPt, pointCells);
+    std::sort(pointCells->begin(), pointCells->end(), std::greater<vtkIdType>());
     nextCell = pointCells->GetId(0);
     pd->GetCellPoints(pointCells->GetId(1), cellPoints);
     if (cellPoints->GetId(0) == nextPt)
@@ -1508,7 +1630,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
       prevPt = cellPoints->GetId(0);
     }
 
-    loop->orientation = this->GetLoopOrientation(pd, nextCell, prevPt, nextPt);
+    loop->orientation = this->GetLoopOrientation(pd, nextCell, prevPt, nextPt, split);
   }
   return 1;
 }
@@ -1516,7 +1638,8 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
 //------------------------------------------------------------------------------
 
 int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd, simPolygon* loop,
-  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells)
+  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells,
+  const CellSplit& split)
 {
   // Follow the orientation of this loop
   int foundcell = 0;
@@ -1528,7 +1651,7 @@ int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd,
     if (*nextCell != cellId)
     {
       // Get orientation for newly selected line
-      int neworient = this->GetLoopOrientation(pd, cellId, prevPt, nextPt);
+      int neworient = this->GetLoopOrientation(pd, cellId, prevPt, nextPt, split);
 
       // If the orientation of the newly selected line is correct, check
       // the angle of this it will make with the previous line
@@ -1595,7 +1718,8 @@ int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd,
 //------------------------------------------------------------------------------
 
 void vtkIntersectionPolyDataFilter::Impl ::SetLoopOrientation(vtkPolyData* pd, simPolygon* loop,
-  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells)
+  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells,
+  const CellSplit& split)
 {
   // Set the orientation of this loop!
   double mincell = 0;
@@ -1653,13 +1777,13 @@ void vtkIntersectionPolyDataFilter::Impl ::SetLoopOrientation(vtkPolyData* pd, s
   // Set the next line as the line that makes the minimum angle with the
   // previous cell and set the orientation of the loop
   *nextCell = mincell;
-  loop->orientation = this->GetLoopOrientation(pd, *nextCell, prevPt, nextPt);
+  loop->orientation = this->GetLoopOrientation(pd, *nextCell, prevPt, nextPt, split);
 }
 
 //------------------------------------------------------------------------------
 
 int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
-  vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2)
+  vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2, const CellSplit& split)
 {
   // Calculate the actual orientation of this loop, by calculating the signed
   // area of the triangle made by the three points
@@ -1699,9 +1823,9 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
     vtkSmartPointer<vtkPoints> testPoints = vtkSmartPointer<vtkPoints>::New();
     vtkSmartPointer<vtkPolyData> testPD = vtkSmartPointer<vtkPolyData>::New();
     vtkSmartPointer<vtkCellArray> testCells = vtkSmartPointer<vtkCellArray>::New();
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId1));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId2));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId3));
+    testPoints->InsertNextPoint(split.Points->GetPoint(ptId1));
+    testPoints->InsertNextPoint(split.Points->GetPoint(ptId2));
+    testPoints->InsertNextPoint(split.Points->GetPoint(ptId3));
     for (int i = 0; i < 3; i++)
     {
       testCells->InsertNextCell(2);
@@ -1714,13 +1838,13 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
 
     vtkSmartPointer<vtkTransform> newTransform = vtkSmartPointer<vtkTransform>::New();
     int sign = this->GetTransform(newTransform, testPoints);
-    if (sign != this->TransformSign)
+    if (sign != split.TransformSign)
     {
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId2));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(0, split.Points->GetPoint(ptId2));
+      testPoints->SetPoint(1, split.Points->GetPoint(ptId1));
       this->GetTransform(newTransform, testPoints);
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId1));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(0, split.Points->GetPoint(ptId1));
+      testPoints->SetPoint(1, split.Points->GetPoint(ptId2));
     }
 
     vtkSmartPointer<vtkTransformPolyDataFilter> newTransformer =
@@ -2372,6 +2496,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // This performs the triangle intersection search
   obbTree0->IntersectWithOBBTree(
     obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  impl->IntersectNodePairs();
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
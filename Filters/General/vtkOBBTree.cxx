@@ -7,9 +7,11 @@
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -70,8 +72,6 @@ vtkOBBTree::vtkOBBTree()
   this->MaxLevel = 12;
   this->Tolerance = 0.01;
   this->Tree = nullptr;
-  this->PointsList = nullptr;
-  this->InsertedPoints = nullptr;
   this->OBBCount = 0;
 }
 
@@ -230,13 +230,13 @@ void vtkOBBTree::ComputeOBB(
 void vtkOBBTree::ComputeOBB(
   vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
 {
-  vtkIdType numPts, numCells, i;
+  vtkIdType numCells, i;
   vtkIdList* cellList;
   vtkDataSet* origDataSet;
 
   vtkDebugMacro(<< "Computing OBB");
 
-  if (input == nullptr || (numPts = input->GetNumberOfPoints()) < 1 ||
+  if (input == nullptr || input->GetNumberOfPoints() < 1 ||
     (input->GetNumberOfCells()) < 1)
   {
     vtkErrorMacro(<< "Can't compute OBB - no data available!");
@@ -249,16 +249,6 @@ void vtkOBBTree::ComputeOBB(
   origDataSet = this->DataSet;
   this->DataSet = input;
 
-  // these are other member variables that ComputeOBB requires
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
-
   cellList = vtkIdList::New();
   cellList->Allocate(numCells);
   for (i = 0; i < numCells; i++)
@@ -269,8 +259,6 @@ void vtkOBBTree::ComputeOBB(
   this->ComputeOBB(cellList, corner, max, mid, min, size);
 
   this->DataSet = origDataSet;
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
   cellList->Delete();
 }
 
@@ -278,10 +266,11 @@ void vtkOBBTree::ComputeOBB(
 // Compute an OBB from the list of cells given. Return the corner point
 // and the three axes defining the orientation of the OBB. Also return
 // a sorted list of relative "sizes" of axes for comparison purposes.
+// The OBBs of different lists of cells may be computed concurrently.
 void vtkOBBTree::ComputeOBB(
   vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
 {
-  vtkIdType numCells, i, j, cellId, ptId, pId, qId, rId;
+  vtkIdType numCells, i, j, cellId, pId, qId, rId;
   int k, type;
   vtkIdType numPts = 0;
   const vtkIdType* ptIds = nullptr;
@@ -289,9 +278,7 @@ void vtkOBBTree::ComputeOBB(
   double *a[3], a0[3], a1[3], a2[3];
   double tMin[3], tMax[3], closest[3], t;
   double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
-
-  this->OBBCount++;
-  this->PointsList->Reset();
+  vtkNew<vtkIdList> cellPts;
   //
   // Compute mean & moments
   //
@@ -314,10 +301,10 @@ void vtkOBBTree::ComputeOBB(
     switch (this->DataSet->GetDataObjectType())
     {
       case VTK_POLY_DATA:
-        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
+        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds, cellPts);
         break;
       case VTK_UNSTRUCTURED_GRID:
-        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
+        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds, cellPts);
         break;
       default:
         vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
@@ -361,18 +348,6 @@ void vtkOBBTree::ComputeOBB(
       a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
       a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
     } // end foreach triangle
-
-    // While computing cell moments, gather all the cell's
-    // point coordinates into a single list.
-    //
-    for (j = 0; j < numPts; j++)
-    {
-      if (this->InsertedPoints[ptIds[j]] != this->OBBCount)
-      {
-        this->InsertedPoints[ptIds[j]] = this->OBBCount;
-        this->PointsList->InsertNextPoint(this->DataSet->GetPoint(ptIds[j]));
-      }
-    } // for all points of this cell
   }   // end foreach cell
 
   // normalize data
@@ -425,23 +400,35 @@ void vtkOBBTree::ComputeOBB(
   tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
   tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
 
-  numPts = this->PointsList->GetNumberOfPoints();
-  for (ptId = 0; ptId < numPts; ptId++)
+  // The points are projected in single precision, as they always were.
+  // Points shared by several cells are projected more than once, which
+  // does not change the extent of the projections.
+  for (i = 0; i < numCells; i++)
   {
-    this->PointsList->GetPoint(ptId, p);
-    for (i = 0; i < 3; i++)
+    cellId = cells->GetId(i);
+    this->DataSet->GetCellPoints(cellId, cellPts);
+    numPts = cellPts->GetNumberOfIds();
+    for (j = 0; j < numPts; j++)
     {
-      vtkLine::DistanceToLine(p, mean, a[i], t, closest);
-      if (t < tMin[i])
+      this->DataSet->GetPoint(cellPts->GetId(j), p);
+      for (k = 0; k < 3; k++)
       {
-        tMin[i] = t;
+        p[k] = static_cast<float>(p[k]);
       }
-      if (t > tMax[i])
+      for (k = 0; k < 3; k++)
       {
-        tMax[i] = t;
+        vtkLine::DistanceToLine(p, mean, a[k], t, closest);
+        if (t < tMin[k])
+        {
+          tMin[k] = t;
+        }
+        if (t > tMax[k])
+        {
+          tMax[k] = t;
+        }
       }
-    }
-  } // for all points
+    } // for all points of this cell
+  }   // for all cells
 
   for (i = 0; i < 3; i++)
   {
@@ -1039,6 +1026,33 @@ void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int*
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// A node left to build, with its cells
+struct vtkOBBTreeNodeTask
+{
+  vtkIdList* Cells;
+  vtkOBBNode* Node;
+  int Level;
+};
+
+// Find the deepest level of the tree and its number of nodes
+void vtkOBBTreeCountNodes(vtkOBBNode* OBBptr, int level, int& deepestLevel, int& numNodes)
+{
+  numNodes++;
+  if (level > deepestLevel)
+  {
+    deepestLevel = level;
+  }
+  if (OBBptr->Kids)
+  {
+    vtkOBBTreeCountNodes(OBBptr->Kids[0], level + 1, deepestLevel, numNodes);
+    vtkOBBTreeCountNodes(OBBptr->Kids[1], level + 1, deepestLevel, numNodes);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 void vtkOBBTree::BuildLocator()
 {
@@ -1079,15 +1093,6 @@ void vtkOBBTree::BuildLocatorInternal()
     return;
   }
 
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
-
   //
   // Begin recursively creating OBB's
   //
@@ -1100,9 +1105,57 @@ void vtkOBBTree::BuildLocatorInternal()
 
   this->FreeSearchStructure();
 
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCellType() and GetCellPoints().
+  vtkNew<vtkIdList> cellPts;
+  this->DataSet->GetCellType(0);
+  this->DataSet->GetCellPoints(0, cellPts);
+
+  // The nodes are built level by level, the nodes of a level concurrently,
+  // until there are enough subtrees to keep all the threads busy. The
+  // subtrees are then built concurrently. Each node is built from the same
+  // cells as when the tree is built recursively, so the tree does not depend
+  // on the number of threads.
   this->Tree = new vtkOBBNode;
+  const size_t minNumberOfTasks = 4 * vtkSMPTools::GetEstimatedNumberOfThreads();
+  std::vector<vtkOBBTreeNodeTask> tasks(1, vtkOBBTreeNodeTask{ cellList, this->Tree, 0 });
+  while (!tasks.empty() && tasks.size() < minNumberOfTasks)
+  {
+    std::vector<vtkOBBTreeNodeTask> kidTasks(2 * tasks.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType task = begin; task < end; ++task)
+        {
+          vtkIdList* kidCells[2] = { nullptr, nullptr };
+          this->BuildNode(tasks[task].Cells, tasks[task].Node, tasks[task].Level, kidCells);
+          for (int kid = 0; kid < 2; ++kid)
+          {
+            vtkOBBTreeNodeTask& kidTask = kidTasks[2 * task + kid];
+            kidTask.Cells = kidCells[kid];
+            kidTask.Node = kidCells[kid] ? tasks[task].Node->Kids[kid] : nullptr;
+            kidTask.Level = tasks[task].Level + 1;
+          }
+        }
+      });
+    tasks.clear();
+    for (const vtkOBBTreeNodeTask& kidTask : kidTasks)
+    {
+      if (kidTask.Node)
+      {
+        tasks.push_back(kidTask);
+      }
+    }
+  }
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType task = begin; task < end; ++task)
+    {
+      this->BuildTree(tasks[task].Cells, tasks[task].Node, tasks[task].Level);
+    }
+  });
+
   this->Level = 0;
-  this->BuildTree(cellList, this->Tree, 0);
+  this->OBBCount = 0;
+  vtkOBBTreeCountNodes(this->Tree, 0, this->Level, this->OBBCount);
 
   vtkDebugMacro(<< "# Cells: " << numCells << ", Deepest tree level: " << this->Level
                 << ", Created: " << this->OBBCount << " OBB nodes");
@@ -1116,12 +1169,6 @@ void vtkOBBTree::BuildLocatorInternal()
     cout.flush();
   }
 
-  //
-  // Clean up
-  //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-
   this->BuildTime.Modified();
 }
 
@@ -1129,6 +1176,20 @@ void vtkOBBTree::BuildLocatorInternal()
 // NOTE: for better memory usage this recursive method
 // frees its first argument
 void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
+{
+  vtkIdList* kidCells[2] = { nullptr, nullptr };
+  this->BuildNode(cells, OBBptr, level, kidCells);
+  if (OBBptr->Kids)
+  {
+    this->BuildTree(kidCells[0], OBBptr->Kids[0], level + 1);
+    this->BuildTree(kidCells[1], OBBptr->Kids[1], level + 1);
+  }
+}
+
+//------------------------------------------------------------------------------
+// NOTE: this method frees its first argument, or retains it in the node
+void vtkOBBTree::BuildNode(
+  vtkIdList* cells, vtkOBBNode* OBBptr, int level, vtkIdList* kidCells[2])
 {
   vtkIdType i, j, numCells = cells->GetNumberOfIds();
   vtkIdType cellId;
@@ -1136,10 +1197,6 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
   vtkIdList* cellPts = vtkIdList::New();
   double size[3];
 
-  if (level > this->Level)
-  {
-    this->Level = level;
-  }
   //
   // Now compute the OBB
   //
@@ -1270,8 +1327,8 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 
       cells->Delete();
       cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
+      kidCells[0] = LHlist;
+      kidCells[1] = RHlist;
     }
     else
     {
@@ -1916,23 +1973,6 @@ void vtkOBBTree::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Tree: (null)\n";
   }
-  if (this->PointsList)
-  {
-    os << indent << "PointsList " << this->PointsList << "\n";
-  }
-  else
-  {
-    os << indent << "PointsList: (null)\n";
-  }
-  if (this->InsertedPoints)
-  {
-    os << indent << "InsertedPoints " << this->InsertedPoints << "\n";
-  }
-  else
-  {
-    os << indent << "InsertedPoints: (null)\n";
-  }
-
   os << indent << "OBBCount " << this->OBBCount << "\n";
 }
 VTK_ABI_NAMESPACE_END
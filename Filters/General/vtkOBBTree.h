@@ -55,6 +55,7 @@
 #define vtkOBBTree_h
 
 #include "vtkAbstractCellLocator.h"
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersGeneralModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -205,8 +206,16 @@ protected:
 
   vtkOBBNode* Tree;
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
-  vtkPoints* PointsList;
-  int* InsertedPoints;
+  VTK_DEPRECATED_IN_9_4_0("The OBBs are computed without this scratch list, which is unused.")
+  vtkPoints* PointsList = nullptr;
+  VTK_DEPRECATED_IN_9_4_0("The OBBs are computed without this scratch array, which is unused.")
+  int* InsertedPoints = nullptr;
+
+  // Compute the OBB of a node from its cells and, if the node is to be
+  // split, create its two children and return their cells in kidCells. The
+  // cells are then freed, otherwise they are retained or freed as for a leaf.
+  // Different nodes may be built concurrently.
+  void BuildNode(vtkIdList* cells, vtkOBBNode* node, int level, vtkIdList* kidCells[2]);
   int OBBCount;
 
   void DeleteTree(vtkOBBNode* OBBptr);
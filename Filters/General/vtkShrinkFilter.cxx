@@ -10,6 +10,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -37,6 +38,8 @@ int vtkShrinkFilter::FillInputPortInformation(int, vtkInformation* info)
   // This filter uses the vtkDataSet cell traversal methods so it
   // suppors any data set type as input.
   info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  // Only the cells of the input are used, its arrays are passed
+  info->Set(vtkStreamingDemandDrivenPipeline::PROPAGATE_ARRAY_REQUESTS(), 1);
   return 1;
 }
 
@@ -11,6 +11,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkShrinkPolyData);
@@ -260,6 +261,17 @@ struct ShrinkWorker
 
 } // end anon namespace
 
+int vtkShrinkPolyData::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  // Only the cells of the input are used, its arrays are passed
+  info->Set(vtkStreamingDemandDrivenPipeline::PROPAGATE_ARRAY_REQUESTS(), 1);
+  return 1;
+}
+
 int vtkShrinkPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
@@ -56,6 +56,7 @@ protected:
   vtkShrinkPolyData(double sf = 0.5);
   ~vtkShrinkPolyData() override = default;
 
+  int FillInputPortInformation(int port, vtkInformation* info) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   double ShrinkFactor;
 
@@ -17,6 +17,7 @@
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridToPointSet.h"
 #include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 
 #include <vector>
@@ -46,6 +47,8 @@ int vtkTransformFilter::FillInputPortInformation(int vtkNotUsed(port), vtkInform
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPointSet");
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkRectilinearGrid");
+  // The arrays of the input are passed, the vectors and normals transformed
+  info->Set(vtkStreamingDemandDrivenPipeline::PROPAGATE_ARRAY_REQUESTS(), 1);
   return 1;
 }
 
@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkDataSetSurfaceFilter subdivides nonlinear cells the same way
+// with any number of threads, and as the serial subdivision did.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestSMPUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Order sensitive hash of the values of a single component array
+unsigned long long HashValues(vtkDataArray* array)
+{
+  unsigned long long hash = 7;
+  for (vtkIdType tupleId = 0; array && tupleId < array->GetNumberOfTuples(); ++tupleId)
+  {
+    hash = hash * 1000003ULL + static_cast<unsigned long long>(array->GetTuple1(tupleId) + 1);
+  }
+  return hash;
+}
+
+// Weighted sum of the components of an array
+double Checksum(vtkDataArray* array)
+{
+  double sum = 0.0;
+  for (vtkIdType tupleId = 0; array && tupleId < array->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+    {
+      sum += (tupleId % 7 + comp + 1) * array->GetComponent(tupleId, comp);
+    }
+  }
+  return sum;
+}
+
+// The surfaces computed by the serial subdivision
+struct Baseline
+{
+  int CellType;
+  int Level;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfPolys;
+  unsigned long long ConnectivityHash;
+  unsigned long long OriginalPointIdsHash;
+  unsigned long long OriginalCellIdsHash;
+  double PointsChecksum;
+  double DistanceChecksum;
+};
+
+const Baseline Baselines[] = {
+  { VTK_QUADRATIC_TETRA, 1, 1538, 3072, 8253483845818027743ULL, 17472530699910098948ULL,
+    10818957173596998663ULL, 92134.5, 31550.964661121368 },
+  { VTK_QUADRATIC_TETRA, 3, 24578, 49152, 8775035640370066907ULL, 14356776369566656752ULL,
+    9836446271025102855ULL, 1474701.375, 503628.23364210129 },
+  { VTK_LAGRANGE_HEXAHEDRON, 1, 3458, 6912, 10288168290233099725ULL, 8895951646258124484ULL,
+    13585379073429841671ULL, 207467.00004211068, 70956.798513412476 },
+  { VTK_LAGRANGE_HEXAHEDRON, 3, 55298, 110592, 12278656915530153555ULL, 7964694435588637068ULL,
+    9910358751023738887ULL, 3317808.5842375532, 1133249.3553404808 },
+  { VTK_LAGRANGE_TRIANGLE, 1, 625, 1152, 1121554680016053838ULL, 8220216344146880654ULL,
+    14246366389692159303ULL, 22486.0000038445, 7946.4439935684204 },
+  { VTK_LAGRANGE_TRIANGLE, 3, 9409, 18432, 2284221819918377430ULL, 11712219123953851752ULL,
+    6870865979432437767ULL, 338731.41681272537, 116368.09988696873 },
+  { VTK_BEZIER_QUADRILATERAL, 1, 625, 1152, 4651134730303008220ULL, 8220216344146880654ULL,
+    10509142387071231623ULL, 22477.666672617197, 7973.9681333899498 },
+  { VTK_BEZIER_QUADRILATERAL, 3, 9409, 18432, 16535847874942014849ULL, 17127205122182181172ULL,
+    17748316238191003655ULL, 338734.66674941033, 116801.06980673224 },
+};
+
+bool SameChecksum(double checksum, double expected)
+{
+  return std::abs(checksum - expected) <= 1e-6 * std::abs(expected);
+}
+
+bool MatchesBaseline(vtkPolyData* surface, int cellType, int level)
+{
+  for (const Baseline& baseline : Baselines)
+  {
+    if (baseline.CellType == cellType && baseline.Level == level)
+    {
+      vtkDataArray* pointIds = surface->GetPointData()->GetArray("vtkOriginalPointIds");
+      vtkDataArray* cellIds = surface->GetCellData()->GetArray("vtkOriginalCellIds");
+      vtkDataArray* distances = surface->GetPointData()->GetArray("DistanceToCenter");
+      return surface->GetNumberOfPoints() == baseline.NumberOfPoints &&
+        surface->GetNumberOfPolys() == baseline.NumberOfPolys &&
+        HashValues(surface->GetPolys()->GetConnectivityArray()) == baseline.ConnectivityHash &&
+        HashValues(pointIds) == baseline.OriginalPointIdsHash &&
+        HashValues(cellIds) == baseline.OriginalCellIdsHash &&
+        SameChecksum(Checksum(surface->GetPoints()->GetData()), baseline.PointsChecksum) &&
+        SameChecksum(Checksum(distances), baseline.DistanceChecksum);
+    }
+  }
+  return false;
+}
+}
+
+int TestDataSetSurfaceFilterSubdivisionThreads(int, char*[])
+{
+  struct CellTypeAndOrder
+  {
+    int CellType;
+    int Order;
+  };
+  const CellTypeAndOrder cellTypes[] = { { VTK_QUADRATIC_TETRA, 2 },
+    { VTK_LAGRANGE_HEXAHEDRON, 3 }, { VTK_LAGRANGE_TRIANGLE, 3 }, { VTK_BEZIER_QUADRILATERAL, 3 } };
+
+  int status = EXIT_SUCCESS;
+  for (const CellTypeAndOrder& cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType.CellType);
+    source->SetCellOrder(cellType.Order);
+    source->SetBlocksDimensions(8, 8, 8);
+
+    vtkNew<vtkDataSetSurfaceFilter> surfaceFilter;
+    surfaceFilter->SetInputConnection(source->GetOutputPort());
+    surfaceFilter->PassThroughCellIdsOn();
+    surfaceFilter->PassThroughPointIdsOn();
+
+    for (int level : { 1, 3 })
+    {
+      surfaceFilter->SetNonlinearSubdivisionLevel(level);
+      vtkSmartPointer<vtkPolyData> surface = vtkTest::UpdateAndCopy(surfaceFilter.GetPointer());
+      vtkSmartPointer<vtkPolyData> singleThreaded = vtkTest::ExecuteOnOneThread(
+        [&]() { return vtkTest::UpdateAndCopy(surfaceFilter.GetPointer()); });
+      if (surface->GetNumberOfPolys() == 0 || !vtkTest::SamePolyData(surface, singleThreaded))
+      {
+        std::cerr << "The surface of cells of type " << cellType.CellType << " at level " << level
+                  << " depends on the number of threads" << std::endl;
+        status = EXIT_FAILURE;
+      }
+
+      if (!MatchesBaseline(surface, cellType.CellType, level))
+      {
+        std::cerr << "The surface of cells of type " << cellType.CellType << " at level " << level
+                  << " differs from the serial subdivision" << std::endl;
+        status = EXIT_FAILURE;
+      }
+
+      // Each square of the boundary of the blocks has two quadratic
+      // triangles, with 4 triangles each at level 1.
+      if (cellType.CellType == VTK_QUADRATIC_TETRA)
+      {
+        const vtkIdType expected = 6 * 8 * 8 * 2 * 4 * (level == 1 ? 1 : 16);
+        if (surface->GetNumberOfPolys() != expected)
+        {
+          std::cerr << "Expected " << expected << " triangles at level " << level << ", got "
+                    << surface->GetNumberOfPolys() << std::endl;
+          status = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return status;
+}
@@ -28,6 +28,9 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -46,8 +49,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <map>
 #include <numeric>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -278,6 +284,243 @@ bool StructuredExecuteWithBlanking(
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Nonlinear 2D cells that are subdivided into triangles.
+bool IsSubdividedFace(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_BIQUADRATIC_TRIANGLE:
+    case VTK_QUADRATIC_QUAD:
+    case VTK_BIQUADRATIC_QUAD:
+    case VTK_QUADRATIC_LINEAR_QUAD:
+    case VTK_QUADRATIC_POLYGON:
+    case VTK_LAGRANGE_TRIANGLE:
+    case VTK_LAGRANGE_QUADRILATERAL:
+    case VTK_BEZIER_TRIANGLE:
+    case VTK_BEZIER_QUADRILATERAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Number of cells whose subdivision is computed at once, which bounds the
+// memory used to hold the subdivisions.
+constexpr vtkIdType SubdivisionBatchSize = 1024;
+
+/**
+ * The subdivision of a nonlinear 2D cell, computed before the cells are
+ * traversed in order to assign the output points. Local points are numbered
+ * as in the serial subdivision: the points of the cell, then the edge
+ * midpoints in the order they are created. The coordinates and interpolation
+ * weights are kept for the points that may have to be inserted in the
+ * output, i.e. the points of Bezier cells that are interpolated and the
+ * midpoints.
+ */
+struct SubdividedFace
+{
+  bool Valid = false;
+  vtkIdType NumberOfPointsToCopy = 0;
+  std::vector<vtkIdType> PointIds;  // input ids of the points of the cell
+  std::vector<vtkIdType> Midpoints; // local ids of the endpoints of each midpoint
+  std::vector<double> Coords;       // coordinates of the interpolated points
+  std::vector<double> Weights;      // their interpolation weights
+  std::vector<vtkIdType> Triangles; // local ids of the triangles
+};
+
+/**
+ * Functor subdividing the nonlinear 2D cells of a batch of cells. Evaluating
+ * the cells at the new points is the expensive part of the subdivision, and
+ * does not depend on the other cells. Hidden and degenerate cells are left
+ * to the serial code.
+ */
+struct SubdivideFaces
+{
+  using LocalEdgeMap = std::map<std::pair<vtkIdType, vtkIdType>, vtkIdType>;
+
+  vtkUnstructuredGridBase* Input;
+  vtkUnsignedCharArray* Ghosts;
+  vtkUnsignedCharArray* GhostCells;
+  int SubdivisionLevel;
+  bool AllowInterpolation;
+  vtkIdType BeginCellId;
+  std::vector<SubdividedFace>& Faces;
+  vtkAlgorithm* Filter;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> TLCell;
+  vtkSMPThreadLocalObject<vtkIdList> TLCellPointIds;
+  vtkSMPThreadLocalObject<vtkIdList> TLTriangles;
+  vtkSMPThreadLocalObject<vtkIdList> TLSubdividedTriangles;
+  vtkSMPThreadLocal<std::vector<double>> TLParametricCoords;
+  vtkSMPThreadLocal<LocalEdgeMap> TLLocalEdgeMap;
+
+  SubdivideFaces(vtkUnstructuredGridBase* input, int subdivisionLevel, bool allowInterpolation,
+    std::vector<SubdividedFace>& faces, vtkAlgorithm* filter)
+    : Input(input)
+    , Ghosts(input->GetPointGhostArray())
+    , GhostCells(input->GetCellGhostArray())
+    , SubdivisionLevel(subdivisionLevel)
+    , AllowInterpolation(allowInterpolation)
+    , BeginCellId(0)
+    , Faces(faces)
+    , Filter(filter)
+  {
+  }
+
+  // Evaluate the cell at a new point, and record its coordinates and weights
+  static void AddPoint(vtkGenericCell* cell, const double* pcoords, SubdividedFace& face)
+  {
+    int subId = -1;
+    double x[3];
+    const size_t offset = face.Weights.size();
+    face.Weights.resize(offset + face.PointIds.size());
+    cell->EvaluateLocation(subId, pcoords, x, face.Weights.data() + offset);
+    face.Coords.insert(face.Coords.end(), x, x + 3);
+  }
+
+  void operator()(vtkIdType beginCellId, vtkIdType endCellId)
+  {
+    vtkGenericCell* cell = this->TLCell.Local();
+    vtkIdList* cellPointIds = this->TLCellPointIds.Local();
+    vtkIdList* pts = this->TLTriangles.Local();
+    vtkIdList* pts2 = this->TLSubdividedTriangles.Local();
+    std::vector<double>& parametricCoords = this->TLParametricCoords.Local();
+    LocalEdgeMap& localEdgeMap = this->TLLocalEdgeMap.Local();
+    vtkIdType numCellPts;
+    const vtkIdType* ids;
+
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval =
+      std::min((endCellId - beginCellId) / 10 + 1, static_cast<vtkIdType>(1000));
+    for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      SubdividedFace& face = this->Faces[cellId - this->BeginCellId];
+      const int cellType = this->Input->GetCellType(cellId);
+      if (!IsSubdividedFace(cellType) ||
+        (this->GhostCells &&
+          (this->GhostCells->GetValue(cellId) & vtkDataSetAttributes::HIDDENCELL)))
+      {
+        continue;
+      }
+      this->Input->GetCellPoints(cellId, numCellPts, ids, cellPointIds);
+      if (this->Ghosts &&
+        std::any_of(ids, ids + numCellPts, [&](vtkIdType ptId) {
+          return (this->Ghosts->GetValue(ptId) & vtkDataSetAttributes::HIDDENPOINT) != 0;
+        }))
+      {
+        continue;
+      }
+
+      this->Input->GetCell(cellId, cell);
+      double* pc = cell->GetParametricCoords();
+      this->Input->SetCellOrderAndRationalWeights(cellId, cell);
+      cell->TriangulateLocalIds(0, pts);
+
+      const vtkIdType numFacePts = cell->GetNumberOfPoints();
+      vtkIdList* facePointIds = cell->GetPointIds();
+      face.PointIds.assign(facePointIds->begin(), facePointIds->end());
+      face.NumberOfPointsToCopy = !this->AllowInterpolation ||
+          (cellType != VTK_BEZIER_QUADRILATERAL && cellType != VTK_BEZIER_TRIANGLE)
+        ? numFacePts
+        : (cellType == VTK_BEZIER_QUADRILATERAL ? 4 : 3);
+      face.Midpoints.clear();
+      face.Coords.clear();
+      face.Weights.clear();
+
+      const bool subdivide = this->SubdivisionLevel > 1 && pc;
+      if (subdivide)
+      {
+        // Degenerate cells share points between the corners of a triangle,
+        // and need the output point ids to be subdivided.
+        const vtkIdType* pointIds = face.PointIds.data();
+        bool isDegenerateCell = false;
+        for (vtkIdType i = 0; i < pts->GetNumberOfIds() && !isDegenerateCell; i += 3)
+        {
+          const vtkIdType a = pointIds[pts->GetId(i)];
+          const vtkIdType b = pointIds[pts->GetId(i + 1)];
+          const vtkIdType c = pointIds[pts->GetId(i + 2)];
+          isDegenerateCell = a == b || a == c || b == c;
+        }
+        if (isDegenerateCell)
+        {
+          continue;
+        }
+      }
+
+      for (vtkIdType i = face.NumberOfPointsToCopy; i < numFacePts; ++i)
+      {
+        AddPoint(cell, pc + 3 * i, face);
+      }
+
+      if (subdivide)
+      {
+        const vtkIdType maxNumberOfIds = static_cast<vtkIdType>(
+          std::pow(4, this->SubdivisionLevel - 1) * pts->GetNumberOfIds());
+        pts2->Allocate(maxNumberOfIds);
+        parametricCoords.resize(maxNumberOfIds * 3);
+        std::copy(pc, pc + numFacePts * 3, parametricCoords.begin());
+        localEdgeMap.clear();
+
+        vtkIdType localIdCpt = numFacePts;
+        vtkIdType inPts[6];
+        for (int level = 1; level < this->SubdivisionLevel; ++level)
+        {
+          pts2->Reset();
+          // Each triangle is split into 4 triangles, see
+          // vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal.
+          for (vtkIdType i = 0; i < pts->GetNumberOfIds(); i += 3)
+          {
+            for (int k = 0; k < 3; ++k)
+            {
+              inPts[k] = pts->GetId(i + k);
+              const vtkIdType pt1 = inPts[k];
+              const vtkIdType pt2 = pts->GetId(i + ((k < 2) ? (k + 1) : 0));
+              const auto edge = std::make_pair(std::min(pt1, pt2), std::max(pt1, pt2));
+              auto inserted = localEdgeMap.insert(std::make_pair(edge, localIdCpt));
+              const vtkIdType id = inserted.first->second;
+              if (inserted.second)
+              {
+                for (int c = 0; c < 3; ++c)
+                {
+                  parametricCoords[id * 3 + c] =
+                    0.5 * (parametricCoords[pt1 * 3 + c] + parametricCoords[pt2 * 3 + c]);
+                }
+                face.Midpoints.push_back(pt1);
+                face.Midpoints.push_back(pt2);
+                AddPoint(cell, &parametricCoords[id * 3], face);
+                localIdCpt++;
+              }
+              inPts[k + 3] = id;
+            }
+            static const int subtriangles[12] = { 0, 3, 5, 3, 1, 4, 3, 4, 5, 5, 4, 2 };
+            for (int subId : subtriangles)
+            {
+              pts2->InsertNextId(inPts[subId]);
+            }
+          }
+          std::swap(pts, pts2);
+        }
+      }
+      face.Triangles.assign(pts->begin(), pts->end());
+      face.Valid = true;
+    }
+  }
+};
+
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1905,10 +2148,47 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   // to the hashes.  Alternatively, the higher order 2d cells could be handled
   // in the following loop.
 
+  // The nonlinear 2D cells are subdivided in parallel one batch of cells at a
+  // time. The output points are then assigned as the cells of the batch are
+  // traversed in order, so that the output does not depend on the number of
+  // threads.
+  std::vector<SubdividedFace> subdividedFaces;
+  SubdivideFaces subdivideFaces(
+    input, this->NonlinearSubdivisionLevel, this->AllowInterpolation != 0, subdividedFaces, this);
+  const bool subdivideInBatches = flag2D && this->NonlinearSubdivisionLevel >= 1;
+  // Other implementations of vtkUnstructuredGridBase may not be thread safe.
+  const bool isThreadSafe = vtkUnstructuredGrid::SafeDownCast(input) != nullptr;
+  vtkIdType batchEndId = 0;
+  vtkNew<vtkIdList> facePointIds;
+
   // Now insert 2DCells.  Because of poly datas (cell data) ordering,
   // the 2D cells have to come after points and lines.
   for (vtkIdType cellId = 0; cellId < numCells && !abort && flag2D; ++cellId)
   {
+    if (subdivideInBatches && cellId == batchEndId)
+    {
+      subdivideFaces.BeginCellId = cellId;
+      batchEndId = std::min(cellId + SubdivisionBatchSize, numCells);
+      subdividedFaces.resize(batchEndId - cellId);
+      for (SubdividedFace& subdividedFace : subdividedFaces)
+      {
+        subdividedFace.Valid = false;
+      }
+      if (isThreadSafe)
+      {
+        vtkSMPTools::For(cellId, batchEndId, subdivideFaces);
+      }
+      else
+      {
+        subdivideFaces(cellId, batchEndId);
+      }
+      abort = this->GetAbortOutput();
+      if (abort)
+      {
+        break;
+      }
+    }
+
     // We skip cells marked as hidden
     if (ghostCells &&
       (ghostCells->GetValue(cellId) & vtkDataSetAttributes::CellGhostTypes::HIDDENCELL))
@@ -2017,6 +2297,64 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
         continue;
       }
 
+      // Assign the output points of a subdivision computed in parallel, in the
+      // same order as below.
+      SubdividedFace* subdividedFace =
+        subdivideInBatches ? &subdividedFaces[cellId - subdivideFaces.BeginCellId] : nullptr;
+      if (subdividedFace && subdividedFace->Valid)
+      {
+        numFacePts = static_cast<vtkIdType>(subdividedFace->PointIds.size());
+        facePointIds->SetNumberOfIds(numFacePts);
+        std::copy(
+          subdividedFace->PointIds.begin(), subdividedFace->PointIds.end(), facePointIds->begin());
+        const double* x = subdividedFace->Coords.data();
+        double* w = subdividedFace->Weights.data();
+        outPts->Reset();
+        for (i = 0; i < subdividedFace->NumberOfPointsToCopy; i++)
+        {
+          outPts->InsertNextId(
+            this->GetOutputPointId(subdividedFace->PointIds[i], input, newPts, outputPD));
+        }
+        for (i = subdividedFace->NumberOfPointsToCopy; i < numFacePts; i++, x += 3, w += numFacePts)
+        {
+          inPtId = subdividedFace->PointIds[i];
+          outPtId = this->PointMap[inPtId];
+          if (outPtId == -1)
+          {
+            outPtId = newPts->InsertNextPoint(x);
+            outputPD->InterpolatePoint(inputPD, outPtId, facePointIds, w);
+            this->PointMap[inPtId] = outPtId;
+            this->RecordOrigPointId(outPtId, inPtId);
+          }
+          outPts->InsertNextId(outPtId);
+        }
+        for (size_t m = 0; m < subdividedFace->Midpoints.size(); m += 2, x += 3, w += numFacePts)
+        {
+          const vtkIdType edgePtA = outPts->GetId(subdividedFace->Midpoints[m]);
+          const vtkIdType edgePtB = outPts->GetId(subdividedFace->Midpoints[m + 1]);
+          outPtId = this->EdgeMap->FindEdge(edgePtA, edgePtB);
+          if (outPtId == -1)
+          {
+            outPtId = newPts->InsertNextPoint(x);
+            outputPD->InterpolatePoint(inputPD, outPtId, facePointIds, w);
+            this->RecordOrigPointId(outPtId, -1);
+            this->EdgeMap->AddEdge(edgePtA, edgePtB, outPtId);
+          }
+          outPts->InsertNextId(outPtId);
+        }
+        const std::vector<vtkIdType>& triangles = subdividedFace->Triangles;
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+          newPolys->InsertNextCell(3);
+          newPolys->InsertCellPoint(outPts->GetId(triangles[t]));
+          newPolys->InsertCellPoint(outPts->GetId(triangles[t + 1]));
+          newPolys->InsertCellPoint(outPts->GetId(triangles[t + 2]));
+          this->RecordOrigCellId(this->NumberOfNewCells, cellId);
+          outputCD->CopyData(cd, cellId, this->NumberOfNewCells++);
+        }
+        continue;
+      }
+
       // Note: we should not be here if this->NonlinearSubdivisionLevel is less
       // than 1.  See the check above.
       input->GetCell(cellId, cell);
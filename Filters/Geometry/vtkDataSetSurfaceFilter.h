@@ -25,6 +25,11 @@
  * vtkGeometryFilter will delegate to vtkDataSetSurfaceFilter when it
  * encounters nonlinear cells.)
  *
+ * Nonlinear 2D cells, including the boundary faces of nonlinear 3D cells,
+ * are subdivided in parallel with vtkSMPTools. The output points are then
+ * assigned in cell order, so the output does not depend on the number of
+ * threads.
+ *
  * @section FastMode Fast Mode
  *
  * vtkDataSetSurfaceFilter is sometimes used to simply render a 3D
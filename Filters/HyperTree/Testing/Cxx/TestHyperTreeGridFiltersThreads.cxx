@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkHyperTreeGridContour, vtkHyperTreeGridPlaneCutter and
+// vtkHyperTreeGridThreshold generate the same output with any number of threads.
+
+#include "vtkBitArray.h"
+#include "vtkCellData.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridContour.h"
+#include "vtkHyperTreeGridNonOrientedCursor.h"
+#include "vtkHyperTreeGridPlaneCutter.h"
+#include "vtkHyperTreeGridThreshold.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkRandomHyperTreeGridSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestSMPUtilities.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool SameTree(vtkHyperTreeGridNonOrientedCursor* cursor0, vtkBitArray* mask0,
+  vtkHyperTreeGridNonOrientedCursor* cursor1, vtkBitArray* mask1)
+{
+  const vtkIdType id0 = cursor0->GetGlobalNodeIndex();
+  const vtkIdType id1 = cursor1->GetGlobalNodeIndex();
+  if (id0 != id1 || cursor0->IsLeaf() != cursor1->IsLeaf() ||
+    (mask0 && mask0->GetValue(id0) != mask1->GetValue(id1)))
+  {
+    return false;
+  }
+  if (!cursor0->IsLeaf())
+  {
+    for (int child = 0; child < cursor0->GetNumberOfChildren(); ++child)
+    {
+      cursor0->ToChild(child);
+      cursor1->ToChild(child);
+      const bool same = SameTree(cursor0, mask0, cursor1, mask1);
+      cursor0->ToParent();
+      cursor1->ToParent();
+      if (!same)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkHyperTreeGrid* output0, vtkHyperTreeGrid* output1)
+{
+  if (output0->GetNumberOfCells() != output1->GetNumberOfCells() ||
+    output0->HasMask() != output1->HasMask() ||
+    !vtkTest::SameFieldData(output0->GetCellData(), output1->GetCellData()))
+  {
+    return false;
+  }
+  vtkBitArray* mask0 = output0->HasMask() ? output0->GetMask() : nullptr;
+  vtkBitArray* mask1 = output1->HasMask() ? output1->GetMask() : nullptr;
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor0;
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor1;
+  vtkIdType index;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  output0->InitializeTreeIterator(it);
+  while (it.GetNextTree(index))
+  {
+    output0->InitializeNonOrientedCursor(cursor0, index);
+    output1->InitializeNonOrientedCursor(cursor1, index);
+    if (!cursor1->HasTree() || !SameTree(cursor0, mask0, cursor1, mask1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkDataObject* output0, vtkDataObject* output1)
+{
+  vtkPolyData* polyData0 = vtkPolyData::SafeDownCast(output0);
+  vtkPolyData* polyData1 = vtkPolyData::SafeDownCast(output1);
+  if (polyData0 && polyData1)
+  {
+    return vtkTest::SamePolyData(polyData0, polyData1);
+  }
+  vtkHyperTreeGrid* htg0 = vtkHyperTreeGrid::SafeDownCast(output0);
+  vtkHyperTreeGrid* htg1 = vtkHyperTreeGrid::SafeDownCast(output1);
+  return htg0 && htg1 && SameOutput(htg0, htg1);
+}
+
+bool CheckThreads(vtkHyperTreeGridAlgorithm* filter, const char* description)
+{
+  vtkSmartPointer<vtkDataObject> output = vtkTest::UpdateAndCopy(filter);
+  vtkSmartPointer<vtkDataObject> singleThreaded =
+    vtkTest::ExecuteOnOneThread([&]() { return vtkTest::UpdateAndCopy(filter); });
+  if (output->GetNumberOfElements(vtkDataObject::CELL) == 0)
+  {
+    std::cerr << "The output of " << description << " is empty" << std::endl;
+    return false;
+  }
+  if (!SameOutput(output, singleThreaded))
+  {
+    std::cerr << "The output of " << description << " depends on the number of threads"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestHyperTreeGridFiltersThreads(int, char*[])
+{
+  vtkNew<vtkRandomHyperTreeGridSource> source;
+  source->SetDimensions(6, 6, 6);
+  source->SetMaxDepth(4);
+  source->SetSplitFraction(0.4);
+  source->SetMaskedFraction(0.1);
+  source->SetSeed(7);
+  source->Update();
+  vtkHyperTreeGrid* htg = vtkHyperTreeGrid::SafeDownCast(source->GetOutput());
+  htg->GetCellData()->SetScalars(htg->GetCellData()->GetArray("Depth"));
+  double range[2];
+  htg->GetCellData()->GetScalars()->GetRange(range);
+  bool success = true;
+
+  vtkNew<vtkHyperTreeGridContour> contour;
+  contour->SetInputData(htg);
+  contour->SetNumberOfContours(3);
+  contour->SetValue(0, range[0] + 0.31 * (range[1] - range[0]));
+  contour->SetValue(1, range[0] + 0.52 * (range[1] - range[0]));
+  contour->SetValue(2, range[0] + 0.77 * (range[1] - range[0]));
+  contour->SetStrategy3D(vtkHyperTreeGridContour::USE_VOXELS);
+  success &= CheckThreads(contour, "the contour with voxels");
+  contour->SetStrategy3D(vtkHyperTreeGridContour::USE_DECOMPOSED_POLYHEDRA);
+  success &= CheckThreads(contour, "the contour with decomposed polyhedra");
+
+  vtkNew<vtkHyperTreeGridPlaneCutter> cutter;
+  cutter->SetInputData(htg);
+  cutter->SetPlane(1., 0.3, 0.2, 2.2);
+  cutter->DualOff();
+  success &= CheckThreads(cutter, "the primal plane cutter");
+  cutter->DualOn();
+  success &= CheckThreads(cutter, "the dual plane cutter");
+
+  vtkNew<vtkHyperTreeGridThreshold> threshold;
+  threshold->SetInputData(htg);
+  threshold->ThresholdBetween(
+    range[0] + 0.2 * (range[1] - range[0]), range[0] + 0.6 * (range[1] - range[0]));
+  for (int strategy : { vtkHyperTreeGridThreshold::MaskInput,
+         vtkHyperTreeGridThreshold::CopyStructureAndIndexArrays,
+         vtkHyperTreeGridThreshold::DeepThreshold })
+  {
+    threshold->SetMemoryStrategy(strategy);
+    success &= CheckThreads(threshold, "the threshold");
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,9 +1,13 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkHyperTreeGridContour.h"
 
 #include "vtkArrayDispatch.h"
+#include "vtkBatch.h"
 #include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
@@ -32,6 +36,8 @@
 #include "vtkPolyData.h"
 #include "vtkPolyhedron.h"
 #include "vtkPolyhedronUtilities.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVoxel.h"
@@ -62,6 +68,45 @@ constexpr vtkIdType POLY_POINTS_NB = 8;
 
 constexpr int MAX_NB_OF_CONTOURS = std::numeric_limits<unsigned char>::max() + 1; // 256
 
+// Maximum number of batches of trees, each batch having its own output
+constexpr vtkIdType MAX_NUMBER_OF_BATCHES = 1024;
+
+// Output of the contour of a batch of trees
+struct BatchOutput
+{
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Verts;
+  vtkSmartPointer<vtkCellArray> Lines;
+  vtkSmartPointer<vtkCellArray> Polys;
+  vtkSmartPointer<vtkPointData> PointData;
+  vtkIdType NumberOfDualCells = 0;
+};
+
+// Append the cells of a batch to the output cells, renumbering their points.
+// Like the contour functions of the cells, skip the lines and triangles which
+// are degenerated once their points are merged with the output points.
+void AppendCells(vtkCellArray* cells, vtkCellArray* batchCells, const std::vector<vtkIdType>& ptMap)
+{
+  vtkIdType npts;
+  const vtkIdType* pts;
+  std::vector<vtkIdType> ids;
+  for (vtkIdType cellId = 0; cellId < batchCells->GetNumberOfCells(); ++cellId)
+  {
+    batchCells->GetCellAtId(cellId, npts, pts);
+    ids.resize(npts);
+    bool degenerate = false;
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      ids[i] = ptMap[pts[i]];
+      degenerate |= std::find(ids.begin(), ids.begin() + i, ids[i]) != ids.begin() + i;
+    }
+    if (!degenerate)
+    {
+      cells->InsertNextCell(npts, ids.data());
+    }
+  }
+}
+
 // Return true if all faces of the cell are planar.
 // The cell is expected to be a vtkVoxel instance.
 bool AreAllFacesPlanar(vtkCell* cell)
@@ -309,6 +354,47 @@ void ReplaceWithIndexedArray(const std::string& contourArrayName, vtkContourValu
 //------------------------------------------------------------------------------
 struct vtkHyperTreeGridContour::vtkInternals
 {
+  // Pre-selected cells to be processed, one byte per cell so that distinct
+  // trees can be pre-processed concurrently
+  std::vector<unsigned char> SelectedCells;
+
+  // Sign of each cell relative to each contour value, at
+  // CellSigns[cellId * numContours + contourId]
+  std::vector<unsigned char> CellSigns;
+};
+
+//------------------------------------------------------------------------------
+struct vtkHyperTreeGridContour::BatchStorage
+{
+  BatchStorage(vtkDataArray* inScalars)
+  {
+    // Create storage for output scalar values
+    this->CellScalars.TakeReference(inScalars->NewInstance());
+    this->CellScalars->SetNumberOfComponents(inScalars->GetNumberOfComponents());
+    this->CellScalars->Allocate(this->CellScalars->GetNumberOfComponents() * 8);
+
+    // Initialize temporal structures related to USE_DECOMPOSED_POLYHEDRA strategy
+    this->Polyhedron->GetPointIds()->SetNumberOfIds(::POLY_POINTS_NB);
+    this->Polyhedron->GetPoints()->SetNumberOfPoints(::POLY_POINTS_NB);
+    this->Faces->AllocateExact(::POLY_FACES_NB, ::POLY_FACES_POINTS_NB * ::POLY_FACES_NB);
+  }
+
+  // Output of the batch of trees being contoured
+  vtkIncrementalPointLocator* Locator = nullptr;
+  vtkCellArray* Verts = nullptr;
+  vtkCellArray* Lines = nullptr;
+  vtkCellArray* Polys = nullptr;
+  vtkPointData* PointData = nullptr;
+  vtkContourHelper* Helper = nullptr;
+  vtkIdType NumberOfDualCells = 0;
+
+  // Work storage shared by the batches processed by a thread
+  vtkSmartPointer<vtkDataArray> CellScalars;
+  vtkNew<vtkLine> Line;
+  vtkNew<vtkPixel> Pixel;
+  vtkNew<vtkVoxel> Voxel;
+  vtkNew<vtkIdList> Leaves;
+
   // Temporary data structures related to USE_DECOMPOSED_POLYHEDRA strategy
   vtkNew<vtkCellArray> Faces;
   vtkNew<vtkPolyhedron> Polyhedron;
@@ -352,11 +438,6 @@ vtkHyperTreeGridContour::vtkHyperTreeGridContour()
 
   // Input scalars point to null by default
   this->InScalars = nullptr;
-
-  // Initialize temporal structures related to USE_DECOMPOSED_POLYHEDRA strategy
-  this->Internals->Polyhedron->GetPointIds()->SetNumberOfIds(::POLY_POINTS_NB);
-  this->Internals->Polyhedron->GetPoints()->SetNumberOfPoints(::POLY_POINTS_NB);
-  this->Internals->Faces->AllocateExact(::POLY_FACES_NB, ::POLY_FACES_POINTS_NB * ::POLY_FACES_NB);
 }
 
 //------------------------------------------------------------------------------
@@ -426,42 +507,6 @@ void vtkHyperTreeGridContour::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Locator: (none)\n";
   }
-
-  if (this->Line)
-  {
-    os << indent << ": " << this->Line << "\n";
-  }
-  else
-  {
-    os << indent << ": (none)\n";
-  }
-
-  if (this->Pixel)
-  {
-    os << indent << ": " << this->Pixel << "\n";
-  }
-  else
-  {
-    os << indent << ": (none)\n";
-  }
-
-  if (this->Voxel)
-  {
-    os << indent << ": " << this->Voxel << "\n";
-  }
-  else
-  {
-    os << indent << ": (none)\n";
-  }
-
-  if (this->Leaves)
-  {
-    os << indent << ": " << this->Leaves << "\n";
-  }
-  else
-  {
-    os << indent << ": (none)\n";
-  }
 }
 
 //------------------------------------------------------------------------------
@@ -590,73 +635,187 @@ int vtkHyperTreeGridContour::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObject
   vtkNew<vtkCellArray> newPolys;
   newPolys->AllocateExact(estimatedSize, estimatedSize);
 
-  // Create storage for output scalar values
-  this->CellScalars = this->InScalars->NewInstance();
-  this->CellScalars->SetNumberOfComponents(this->InScalars->GetNumberOfComponents());
-  this->CellScalars->Allocate(this->CellScalars->GetNumberOfComponents() * 8);
-
   // Initialize point locator
   if (!this->Locator)
   {
     // Create default locator if needed
     this->CreateDefaultLocator();
   }
-  this->Locator->InitPointInsertion(newPts, input->GetBounds(), estimatedSize);
+  double bounds[6];
+  input->GetBounds(bounds);
+  this->Locator->InitPointInsertion(newPts, bounds, estimatedSize);
 
   // Used to store the input cell data (hyper tree grid cells)
   // as point data (dual mesh point data), the two being equivalent.
   vtkNew<vtkPointData> dualPointData;
   dualPointData->PassData(input->GetCellData());
 
-  // Instantiate a contour helper for convenience, with triangle generation on
-  this->Helper = new vtkContourHelper(this->Locator, newVerts, newLines, newPolys, dualPointData,
-    nullptr, output->GetPointData(), nullptr, estimatedSize, true);
+  // Create storage to keep track of selected cells and of their signs
+  this->Internals->SelectedCells.assign(numCells, 0);
+  this->Internals->CellSigns.assign(numCells * numContours, 0);
 
-  // Create storage to keep track of selected cells
-  this->SelectedCells = vtkBitArray::New();
-  this->SelectedCells->SetNumberOfTuples(numCells);
-
-  // Initialize storage for signs and values
-  // NOLINTNEXTLINE(bugprone-sizeof-expression)
-  this->CellSigns = (vtkBitArray**)malloc(numContours * sizeof(*this->CellSigns));
-  this->Signs.resize(numContours, true);
-  for (int c = 0; c < numContours; ++c)
-  {
-    this->CellSigns[c] = vtkBitArray::New();
-    this->CellSigns[c]->SetNumberOfTuples(numCells);
-  }
-
-  // First pass across tree roots to evince cells intersected by contours
+  // Collect the input trees, which are processed in parallel
+  std::vector<vtkIdType> treeIds;
   vtkIdType index;
   vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
   input->InitializeTreeIterator(it);
-  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
   while (it.GetNextTree(index))
   {
-    if (this->CheckAbort())
+    treeIds.push_back(index);
+  }
+  const vtkIdType numTrees = static_cast<vtkIdType>(treeIds.size());
+
+  // First pass across tree roots to evince cells intersected by contours
+  vtkSMPTools::For(0, numTrees, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
+    std::vector<bool> signs(numContours);
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      // Initialize new grid cursor at root of current input tree
+      input->InitializeNonOrientedCursor(cursor, treeIds[i]);
+      // Pre-process tree recursively
+      std::fill(signs.begin(), signs.end(), true);
+      this->RecursivelyPreProcessTree(cursor, signs);
+    }
+  });
+
+  // Second pass across tree roots: now compute isocontours recursively, by
+  // batches of consecutive trees. The points of each batch are merged with a
+  // locator of its own, in double precision so that only identical points are
+  // merged. They are then inserted in the output locator in the order of the
+  // batches, which gives the same output as processing the trees serially.
+  // This requires the exact merging of vtkMergePoints, the trees are processed
+  // serially with other locators.
+  vtkBatches<::BatchOutput> batches;
+  batches.Initialize(numTrees, static_cast<unsigned int>(numTrees / ::MAX_NUMBER_OF_BATCHES + 1));
+  const bool mergeBatches =
+    batches.GetNumberOfBatches() > 1 && this->Locator->IsA("vtkMergePoints");
+  if (!mergeBatches)
+  {
+    batches.Initialize(numTrees, static_cast<unsigned int>(std::max<vtkIdType>(numTrees, 1)));
+  }
+  const vtkIdType numBatches = batches.GetNumberOfBatches();
+  const vtkIdType batchEstimatedSize = std::max<vtkIdType>(estimatedSize / numBatches, 256);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    vtkNew<vtkHyperTreeGridNonOrientedMooreSuperCursor> supercursor;
+    BatchStorage storage(this->InScalars);
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      break;
+      ::BatchOutput& batchOutput = batches[batchId].Data;
+      vtkSmartPointer<vtkIncrementalPointLocator> locator;
+      if (mergeBatches)
+      {
+        batchOutput.Points = vtkSmartPointer<vtkPoints>::New();
+        batchOutput.Points->SetDataTypeToDouble();
+        batchOutput.Points->Allocate(batchEstimatedSize, batchEstimatedSize);
+        batchOutput.Verts = vtkSmartPointer<vtkCellArray>::New();
+        batchOutput.Lines = vtkSmartPointer<vtkCellArray>::New();
+        batchOutput.Polys = vtkSmartPointer<vtkCellArray>::New();
+        batchOutput.PointData = vtkSmartPointer<vtkPointData>::New();
+        batchOutput.PointData->CopyAllocate(this->InData);
+        // The locator covers the trees of the batch, the points of the dual
+        // cells shared with other trees lie in its outer bins
+        double batchBounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+          VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+        double origin[3], size[3];
+        for (vtkIdType i = batches[batchId].BeginId; i < batches[batchId].EndId; ++i)
+        {
+          input->GetLevelZeroOriginAndSizeFromIndex(treeIds[i], origin, size);
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            batchBounds[2 * axis] = std::min(batchBounds[2 * axis], origin[axis]);
+            batchBounds[2 * axis + 1] =
+              std::max(batchBounds[2 * axis + 1], origin[axis] + size[axis]);
+          }
+        }
+        locator = vtkSmartPointer<vtkMergePoints>::New();
+        locator->InitPointInsertion(batchOutput.Points, batchBounds, batchEstimatedSize);
+        storage.Locator = locator;
+        storage.Verts = batchOutput.Verts;
+        storage.Lines = batchOutput.Lines;
+        storage.Polys = batchOutput.Polys;
+        storage.PointData = batchOutput.PointData;
+      }
+      else
+      {
+        storage.Locator = this->Locator;
+        storage.Verts = newVerts;
+        storage.Lines = newLines;
+        storage.Polys = newPolys;
+        storage.PointData = output->GetPointData();
+      }
+      storage.NumberOfDualCells = 0;
+
+      // Instantiate a contour helper for convenience, with triangle generation on
+      vtkContourHelper helper(storage.Locator, storage.Verts, storage.Lines, storage.Polys,
+        dualPointData, nullptr, storage.PointData, nullptr, estimatedSize, true);
+      storage.Helper = &helper;
+
+      for (vtkIdType i = batches[batchId].BeginId; i < batches[batchId].EndId; ++i)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        // Initialize new Moore cursor at root of current tree
+        input->InitializeNonOrientedMooreSuperCursor(supercursor, treeIds[i]);
+        // Compute contours recursively
+        this->RecursivelyProcessTree(supercursor, storage, dualPointData);
+      }
+      storage.Helper = nullptr;
+      batchOutput.NumberOfDualCells = storage.NumberOfDualCells;
+      if (locator)
+      {
+        locator->Initialize();
+      }
     }
-    // Initialize new grid cursor at root of current input tree
-    input->InitializeNonOrientedCursor(cursor, index);
-    // Pre-process tree recursively
-    this->RecursivelyPreProcessTree(cursor);
-  } // it
+  });
 
-  // Second pass across tree roots: now compute isocontours recursively
-  input->InitializeTreeIterator(it);
-  vtkNew<vtkHyperTreeGridNonOrientedMooreSuperCursor> supercursor;
-  while (it.GetNextTree(index))
+  // Merge the points of the batches in order and append their cells
+  for (vtkIdType batchId = 0; batchId < numBatches; ++batchId)
   {
-    if (this->CheckAbort())
+    ::BatchOutput& batchOutput = batches[batchId].Data;
+    this->CurrentId += batchOutput.NumberOfDualCells;
+    if (!mergeBatches)
     {
-      break;
+      continue;
+    }
+    const vtkIdType numBatchPoints = batchOutput.Points->GetNumberOfPoints();
+    std::vector<vtkIdType> ptMap(numBatchPoints);
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < numBatchPoints; ++ptId)
+    {
+      batchOutput.Points->GetPoint(ptId, x);
+      if (this->Locator->InsertUniquePoint(x, ptMap[ptId]))
+      {
+        // Output and batch point data have the same arrays, both being
+        // allocated from the input cell data
+        for (int iArr = 0; iArr < this->OutData->GetNumberOfArrays(); ++iArr)
+        {
+          this->OutData->GetAbstractArray(iArr)->InsertTuple(
+            ptMap[ptId], ptId, batchOutput.PointData->GetAbstractArray(iArr));
+        }
+      }
     }
-    // Initialize new Moore cursor at root of current tree
-    input->InitializeNonOrientedMooreSuperCursor(supercursor, index);
-    // Compute contours recursively
-    this->RecursivelyProcessTree(supercursor, newVerts, newLines, newPolys, dualPointData);
-  } // it
+    ::AppendCells(newVerts, batchOutput.Verts, ptMap);
+    ::AppendCells(newLines, batchOutput.Lines, ptMap);
+    ::AppendCells(newPolys, batchOutput.Polys, ptMap);
+    batchOutput = ::BatchOutput();
+  }
 
   // Set output
   output->SetPoints(newPts);
@@ -681,17 +840,10 @@ int vtkHyperTreeGridContour::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObject
   }
 
   // Clean up
-  this->SelectedCells->Delete();
-  for (vtkIdType c = 0; c < this->GetNumberOfContours(); ++c)
-  {
-    if (this->CellSigns[c])
-    {
-      this->CellSigns[c]->Delete();
-    }
-  } // c
-  free(this->CellSigns);
-  delete this->Helper;
-  this->CellScalars->Delete();
+  this->Internals->SelectedCells.clear();
+  this->Internals->SelectedCells.shrink_to_fit();
+  this->Internals->CellSigns.clear();
+  this->Internals->CellSigns.shrink_to_fit();
   newPts->Delete();
   this->Locator->Initialize();
 
@@ -702,12 +854,13 @@ int vtkHyperTreeGridContour::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObject
 }
 
 //------------------------------------------------------------------------------
-bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrientedCursor* cursor)
+bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(
+  vtkHyperTreeGridNonOrientedCursor* cursor, std::vector<bool>& currentSigns)
 {
   // Retrieve global index of input cursor
   vtkIdType id = cursor->GetGlobalNodeIndex();
 
-  if (this->InGhostArray && this->InGhostArray->GetTuple1(id))
+  if (this->InGhostArray && this->InGhostArray->GetValue(id))
   {
     return false;
   }
@@ -724,16 +877,10 @@ bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrien
     std::vector<bool> signs(numContours);
     for (int child = 0; child < numChildren; ++child)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
-      // Create storage for signs relative to contour values
-
       cursor->ToChild(child);
 
       // Recurse and keep track of whether this branch is selected
-      selected |= this->RecursivelyPreProcessTree(cursor);
+      selected |= this->RecursivelyPreProcessTree(cursor, currentSigns);
 
       // Check if branch not completely selected
       if (!selected)
@@ -748,12 +895,12 @@ bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrien
           if (child == 0)
           {
             // Initialize sign array with sign of first child
-            signs[c] = (this->CellSigns[c]->GetTuple1(childId) != 0.0);
+            signs[c] = (this->Internals->CellSigns[childId * numContours + c] != 0);
           }
           else
           {
             // For subsequent children compare their sign with stored value
-            if (signs[c] != (this->CellSigns[c]->GetTuple1(childId) != 0.0))
+            if (signs[c] != (this->Internals->CellSigns[childId * numContours + c] != 0))
             {
               // A change of sign occurred, therefore cell must selected
               selected = true;
@@ -765,42 +912,49 @@ bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrien
       cursor->ToParent();
     } // child
   }
-  else if (!this->InGhostArray || !this->InGhostArray->GetTuple1(id))
+  else if (!this->InGhostArray || !this->InGhostArray->GetValue(id))
   {
     // Cursor is at leaf, retrieve its active scalar value
-    double val = this->InScalars->GetTuple1(id);
+    double val = this->InScalars->GetComponent(id, 0);
 
     // Iterate over all contours
     double* values = this->ContourValues->GetValues();
     for (int c = 0; c < numContours; ++c)
     {
-      this->Signs[c] = val > values[c];
+      currentSigns[c] = val > values[c];
     }
   } // else
 
   // Update list of selected cells
-  this->SelectedCells->SetTuple1(id, selected);
+  this->Internals->SelectedCells[id] = selected ? 1 : 0;
 
   // Set signs for all contours
   for (int c = 0; c < numContours; ++c)
   {
     // Parent cell has that of one of its children
-    this->CellSigns[c]->SetTuple1(id, this->Signs[c]);
+    this->Internals->CellSigns[id * numContours + c] = currentSigns[c] ? 1 : 0;
   }
 
   // Return whether current node was fully selected
   return selected;
 }
 
+//------------------------------------------------------------------------------
+bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrientedCursor* cursor)
+{
+  this->Signs.resize(this->ContourValues->GetNumberOfContours(), true);
+  return this->RecursivelyPreProcessTree(cursor, this->Signs);
+}
+
 //------------------------------------------------------------------------------
 void vtkHyperTreeGridContour::RecursivelyProcessTree(
-  vtkHyperTreeGridNonOrientedMooreSuperCursor* supercursor, vtkCellArray* newVerts,
-  vtkCellArray* newLines, vtkCellArray* newPolys, vtkPointData* inPd)
+  vtkHyperTreeGridNonOrientedMooreSuperCursor* supercursor, BatchStorage& storage,
+  vtkPointData* inPd)
 {
   // Retrieve global index of input cursor
   vtkIdType id = supercursor->GetGlobalNodeIndex();
 
-  if (this->InGhostArray && this->InGhostArray->GetTuple1(id))
+  if (this->InGhostArray && this->InGhostArray->GetValue(id))
   {
     return;
   }
@@ -811,13 +965,14 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
   if (!supercursor->IsLeaf())
   {
     // Selected cells are determined in RecursivelyPreProcessTree
-    bool selected = (this->SelectedCells->GetTuple1(id) == 1.0);
+    bool selected = (this->Internals->SelectedCells[id] == 1);
 
     // Iterate over contours
-    for (vtkIdType c = 0; c < this->ContourValues->GetNumberOfContours() && !selected; ++c)
+    vtkIdType numContours = this->ContourValues->GetNumberOfContours();
+    for (vtkIdType c = 0; c < numContours && !selected; ++c)
     {
       // Retrieve sign with respect to contour value at current cursor
-      bool sign = (this->CellSigns[c]->GetTuple1(id) != 0.0);
+      bool sign = (this->Internals->CellSigns[id * numContours + c] != 0);
 
       // Iterate over all cursors of Moore neighborhood around center
       unsigned int nn = supercursor->GetNumberOfCursors() - 1;
@@ -830,9 +985,9 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
           vtkIdType idN = supercursor->GetGlobalNodeIndex(icursorN);
 
           // Decide whether neighbor was selected or must be retained because of a sign change
-          selected = this->SelectedCells->GetTuple1(idN) == 1 ||
-            ((this->CellSigns[c]->GetTuple1(idN) != 0.0) != sign) ||
-            (this->InGhostArray && this->InGhostArray->GetTuple1(idN));
+          selected = this->Internals->SelectedCells[idN] == 1 ||
+            ((this->Internals->CellSigns[idN * numContours + c] != 0) != sign) ||
+            (this->InGhostArray && this->InGhostArray->GetValue(idN));
         }
         else
         {
@@ -849,24 +1004,24 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
         // Create child cursor from parent in input grid
         supercursor->ToChild(child);
         // Recurse
-        this->RecursivelyProcessTree(supercursor, newVerts, newLines, newPolys, inPd);
+        this->RecursivelyProcessTree(supercursor, storage, inPd);
         supercursor->ToParent();
       }
     }
   }
-  else if ((!this->InMask || !this->InMask->GetTuple1(id)))
+  else if ((!this->InMask || !this->InMask->GetValue(id)))
   {
     // Cell is not masked, iterate over its corners
     unsigned int numLeavesCorners = 1 << dim;
     for (unsigned int cornerIdx = 0; cornerIdx < numLeavesCorners; ++cornerIdx)
     {
       bool owner = true;
-      this->Leaves->SetNumberOfIds(numLeavesCorners);
+      storage.Leaves->SetNumberOfIds(numLeavesCorners);
 
       // Iterate over every leaf touching the corner and check ownership
       for (unsigned int leafIdx = 0; leafIdx < numLeavesCorners && owner; ++leafIdx)
       {
-        owner = supercursor->GetCornerCursors(cornerIdx, leafIdx, this->Leaves);
+        owner = supercursor->GetCornerCursors(cornerIdx, leafIdx, storage.Leaves);
       } // leafIdx
 
       // If cell owns dual cell, compute contours thereof
@@ -884,13 +1039,13 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
         switch (dim)
         {
           case 1:
-            cell = this->Line;
+            cell = storage.Line;
             break;
           case 2:
-            cell = this->Pixel;
+            cell = storage.Pixel;
             break;
           case 3:
-            cell = this->Voxel;
+            cell = storage.Voxel;
             break;
           default:
             vtkErrorMacro("Unsupported cell dimension had been encountered (must be 1, 2 or 3).");
@@ -904,7 +1059,7 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
         for (unsigned int _cornerIdx = 0; _cornerIdx < numLeavesCorners; ++_cornerIdx)
         {
           // Get cursor corresponding to this corner
-          vtkIdType cursorId = this->Leaves->GetId(_cornerIdx);
+          vtkIdType cursorId = storage.Leaves->GetId(_cornerIdx);
 
           // Retrieve neighbor coordinates and store them
           supercursor->GetPoint(cursorId, x);
@@ -915,7 +1070,7 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
           cell->PointIds->SetId(_cornerIdx, idN);
 
           // Assign scalar value attached to this contour item
-          this->CellScalars->InsertTuple(_cornerIdx, this->InScalars->GetTuple(idN));
+          storage.CellScalars->InsertTuple(_cornerIdx, idN, this->InScalars);
         } // cornerIdx
 
         /* If we are in 3D and the contour strategy is set to USE_DECOMPOSED_POLYHEDRA,
@@ -932,35 +1087,28 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
           // Insert points and global point IDs
           for (int i = 0; i < ::POLY_POINTS_NB; ++i)
           {
-            this->Internals->Polyhedron->GetPointIds()->SetId(i, cell->GetPointId(i));
-            this->Internals->Polyhedron->GetPoints()->SetPoint(i, cell->GetPoints()->GetPoint(i));
+            storage.Polyhedron->GetPointIds()->SetId(i, cell->GetPointId(i));
+            storage.Polyhedron->GetPoints()->SetPoint(i, cell->GetPoints()->GetPoint(i));
           }
 
           // Construct faces from voxel point ids (global ids)
-          this->Internals->Faces->Reset();
+          storage.Faces->Reset();
           for (int faceId = 0, canonicalId = 0; faceId < ::POLY_FACES_NB; faceId++)
           {
-            this->Internals->Faces->InsertNextCell(::POLY_FACES_POINTS_NB);
+            storage.Faces->InsertNextCell(::POLY_FACES_POINTS_NB);
             for (int i = 0; i < ::POLY_FACES_POINTS_NB; i++, canonicalId++)
             {
-              this->Internals->Faces->InsertCellPoint(
+              storage.Faces->InsertCellPoint(
                 cell->GetPointId(::CANONICAL_FACES[canonicalId]));
             }
           }
 
-          this->Internals->Polyhedron->SetCellFaces(this->Internals->Faces);
-          this->Internals->Polyhedron->Initialize();
+          storage.Polyhedron->SetCellFaces(storage.Faces);
+          storage.Polyhedron->Initialize();
 
-          // Decompose the this->Internals->Polyhedron
+          // Decompose the storage.Polyhedron
           auto resultUG = vtkPolyhedronUtilities::Decompose(
-            this->Internals->Polyhedron, inPd, this->CurrentId, nullptr);
-
-          auto outPointData = vtkPointData::SafeDownCast(this->OutData);
-          if (!outPointData)
-          {
-            vtkErrorMacro("Unable to retrieve the output point data.");
-            return;
-          }
+            storage.Polyhedron, inPd, storage.NumberOfDualCells, nullptr);
 
           /* Estimated size: estimated number of generated triangles (before merging them).
            * Only used in that case. Unused here because we choose to output triangles.
@@ -971,8 +1119,8 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
            * Needed because we have to change the input point data (now indexed on resultUG point
            * ids)
            */
-          vtkContourHelper helper(this->Locator, newVerts, newLines, newPolys,
-            resultUG->GetPointData(), nullptr, outPointData, nullptr, estimatedSize, true);
+          vtkContourHelper helper(storage.Locator, storage.Verts, storage.Lines, storage.Polys,
+            resultUG->GetPointData(), nullptr, storage.PointData, nullptr, estimatedSize, true);
 
           // Retrieve the contouring array in the resultUG
           auto contourScalars = resultUG->GetPointData()->GetArray(this->InScalars->GetName());
@@ -991,18 +1139,18 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
             iter.TakeReference(resultUG->NewCellIterator());
             for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
             {
-              iter->GetCell(this->Internals->Tetra);
+              iter->GetCell(storage.Tetra);
 
               // Scalars used for contouring need to be indexed on tetrahedron local ids
-              this->Internals->TetraScalars->Reset();
-              this->Internals->TetraScalars->SetNumberOfComponents(
+              storage.TetraScalars->Reset();
+              storage.TetraScalars->SetNumberOfComponents(
                 contourScalars->GetNumberOfComponents());
-              this->Internals->TetraScalars->SetNumberOfTuples(iter->GetNumberOfPoints());
-              contourScalars->GetTuples(iter->GetPointIds(), this->Internals->TetraScalars);
+              storage.TetraScalars->SetNumberOfTuples(iter->GetNumberOfPoints());
+              contourScalars->GetTuples(iter->GetPointIds(), storage.TetraScalars);
 
               vtkIdType cellId = iter->GetCellId();
               helper.Contour(
-                this->Internals->Tetra, values[c], this->Internals->TetraScalars, cellId);
+                storage.Tetra, values[c], storage.TetraScalars, cellId);
             }
           }
         }
@@ -1011,14 +1159,38 @@ void vtkHyperTreeGridContour::RecursivelyProcessTree(
           // Compute cell isocontour for each isovalue
           for (int c = 0; c < numContours; ++c)
           {
-            this->Helper->Contour(cell, values[c], this->CellScalars, this->CurrentId);
+            storage.Helper->Contour(
+              cell, values[c], storage.CellScalars, storage.NumberOfDualCells);
           }
         }
 
         // Increment output cell counter
-        ++this->CurrentId;
+        ++storage.NumberOfDualCells;
       } // if ( owner )
     }   // cornerIdx
-  }     // else if ( ! this->InMask || this->InMask->GetTuple1( id ) )
+  }     // else if ( ! this->InMask || this->InMask->GetValue( id ) )
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridContour::RecursivelyProcessTree(
+  vtkHyperTreeGridNonOrientedMooreSuperCursor* supercursor, vtkCellArray* verts,
+  vtkCellArray* lines, vtkCellArray* polys, vtkPointData* dualPointData)
+{
+  // Contour the tree as a batch of its own, merging its points with the
+  // locator of the filter
+  vtkPointData* outPd = vtkPointData::SafeDownCast(this->OutData);
+  BatchStorage storage(this->InScalars);
+  storage.Locator = this->Locator;
+  storage.Verts = verts;
+  storage.Lines = lines;
+  storage.Polys = polys;
+  storage.PointData = outPd;
+
+  // The estimated size of the triangles is not used, triangles being generated
+  vtkContourHelper helper(
+    this->Locator, verts, lines, polys, dualPointData, nullptr, outPd, nullptr, 0, true);
+  storage.Helper = &helper;
+  this->RecursivelyProcessTree(supercursor, storage, dualPointData);
+  this->CurrentId += storage.NumberOfDualCells;
 }
 VTK_ABI_NAMESPACE_END
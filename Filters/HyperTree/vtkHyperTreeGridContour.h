@@ -11,6 +11,10 @@
  * value for the active scalar is within a specified range (inclusive).
  * The output remains a hyper tree grid.
  *
+ * The hyper trees are processed in parallel with vtkSMPTools. With the default
+ * vtkMergePoints locator, the output does not depend on the number of threads;
+ * other locators are used serially.
+ *
  * @sa
  * vtkHyperTreeGrid vtkHyperTreeGridAlgorithm vtkContourFilter
  *
@@ -27,6 +31,7 @@
 
 #include "vtkCellArray.h"              // For vtkCellArray
 #include "vtkContourValues.h"          // Needed for inline methods
+#include "vtkDeprecation.h"            // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersHyperTreeModule.h" // For export macro
 #include "vtkHyperTreeGridAlgorithm.h"
 #include "vtkNew.h"       // For vtkNew
@@ -135,15 +140,40 @@ protected:
   int ProcessTrees(vtkHyperTreeGrid*, vtkDataObject*) override;
 
   /**
-   * Recursively decide whether a cell is intersected by a contour
+   * Recursively decide whether a cell is intersected by a contour.
+   * currentSigns holds the signs relative to the contour values of the last
+   * leaf processed in the tree. Distinct trees can be processed concurrently.
+   */
+  bool RecursivelyPreProcessTree(
+    vtkHyperTreeGridNonOrientedCursor*, std::vector<bool>& currentSigns);
+
+  /**
+   * Recursively decide whether a cell is intersected by a contour, the signs
+   * of the last leaf processed being kept in Signs.
    */
+  VTK_DEPRECATED_IN_9_4_0("Use the overload taking the signs of the last leaf.")
   bool RecursivelyPreProcessTree(vtkHyperTreeGridNonOrientedCursor*);
 
+  /**
+   * Output and work storage of the batch of hyper trees being contoured.
+   * Defined in the implementation file.
+   */
+  struct BatchStorage;
+
+  /**
+   * Recursively descend into the tree down to the leaves to construct the contour (verts, lines,
+   * polys) of the batch of trees. dualPointData represents the point data of the dual mesh, i.e.
+   * HTG cell data used for contouring.
+   */
+  void RecursivelyProcessTree(
+    vtkHyperTreeGridNonOrientedMooreSuperCursor*, BatchStorage&, vtkPointData* dualPointData);
+
   /**
    * Recursively descend into the tree down to the leaves to construct the contour (verts, lines,
-   * polys). dualPointData represents the point data of the dual mesh, i.e. HTG cell data used for
-   * contouring.
+   * polys), merging the points with the locator of the filter. dualPointData represents the point
+   * data of the dual mesh, i.e. HTG cell data used for contouring.
    */
+  VTK_DEPRECATED_IN_9_4_0("Use the overload taking the storage of a batch of trees.")
   void RecursivelyProcessTree(vtkHyperTreeGridNonOrientedMooreSuperCursor*, vtkCellArray* verts,
     vtkCellArray* lines, vtkCellArray* polys, vtkPointData* dualPointData);
 
@@ -152,40 +182,49 @@ protected:
    */
   vtkContourValues* ContourValues;
 
+  /**
+   * Spatial locator to merge points.
+   */
+  vtkIncrementalPointLocator* Locator;
+
   /**
    * Storage for pre-selected cells to be processed
    */
+  VTK_DEPRECATED_IN_9_4_0("The selected cells are stored by the filter internals.")
   vtkBitArray* SelectedCells;
 
   /**
    * Sign of isovalue if cell not treated
    */
+  VTK_DEPRECATED_IN_9_4_0("The signs of the cells are stored by the filter internals.")
   vtkBitArray** CellSigns;
 
-  /**
-   * Spatial locator to merge points.
-   */
-  vtkIncrementalPointLocator* Locator;
-
   ///@{
   /**
    * Pointers needed to perform isocontouring
    */
+  VTK_DEPRECATED_IN_9_4_0("Each batch of trees uses a helper of its own.")
   vtkContourHelper* Helper;
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses cell scalars of its own.")
   vtkDataArray* CellScalars;
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses a line of its own.")
   vtkLine* Line;
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses a pixel of its own.")
   vtkPixel* Pixel;
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses a voxel of its own.")
   vtkVoxel* Voxel;
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses a list of leaves of its own.")
   vtkIdList* Leaves;
   ///@}
 
   /**
    * Storage for signs relative to current contour value
    */
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated RecursivelyPreProcessTree overload.")
   std::vector<bool> Signs;
 
   /**
-   * Keep track of current index in output polydata
+   * Number of dual cells contoured
    */
   vtkIdType CurrentId;
 
@@ -1,7 +1,12 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkHyperTreeGridPlaneCutter.h"
 
+#include "vtkBatch.h"
 #include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
@@ -19,10 +24,14 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -31,12 +40,72 @@ vtkIdType First8Integers[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
 
 constexpr unsigned int MooreCursors3D[26] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 14, 15, 16,
   17, 18, 19, 20, 21, 22, 23, 24, 25, 26 };
+
+// Maximum number of batches of trees, each batch having its own output
+constexpr vtkIdType MAX_NUMBER_OF_BATCHES = 1024;
+
+// Create a cutter of dual cells by the plane of equation
+// plane[0] * x + plane[1] * y + plane[2] * z = plane[3]
+vtkSmartPointer<vtkCutter> NewDualCutter(const double plane[4])
+{
+  // Convert plane parameters into normal/origin specification
+  unsigned int maxId = 0;
+  if (fabs(plane[1]) > fabs(plane[0]))
+  {
+    maxId = 1;
+  }
+  if (fabs(plane[2]) > fabs(plane[maxId]))
+  {
+    maxId = 2;
+  }
+  double origin[] = { 0., 0., 0. };
+  origin[maxId] = plane[3] / plane[maxId];
+  vtkNew<vtkPlane> cutFunction;
+  cutFunction->SetOrigin(origin);
+  cutFunction->SetNormal(plane[0], plane[1], plane[2]);
+
+  vtkSmartPointer<vtkCutter> cutter = vtkSmartPointer<vtkCutter>::New();
+  cutter->GenerateTrianglesOff();
+  cutter->SetCutFunction(cutFunction);
+  return cutter;
+}
 }
 
+//------------------------------------------------------------------------------
+struct vtkHyperTreeGridPlaneCutter::vtkInternals
+{
+  // Pre-selected cells to be processed in dual mode, one byte per cell so
+  // that distinct trees can be pre-processed concurrently
+  std::vector<unsigned char> SelectedCells;
+};
+
+//------------------------------------------------------------------------------
+struct vtkHyperTreeGridPlaneCutter::BatchStorage
+{
+  // Output of the batch, appended to the output of the filter in the order of
+  // the batches
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells;
+
+  // Primal cut: input cell of each output polygon
+  std::vector<vtkIdType> CellIds;
+
+  // Dual cut: data of the output points
+  vtkSmartPointer<vtkPointData> PointData;
+
+  // Dual cut: work storage shared by the batches processed by a thread, for
+  // dual vertex indices, dual vertices at center of primal cells and the
+  // cutter of dual cells
+  vtkIdList* Leaves = nullptr;
+  vtkPoints* Centers = nullptr;
+  vtkCutter* Cutter = nullptr;
+};
+
 vtkStandardNewMacro(vtkHyperTreeGridPlaneCutter);
 
 //------------------------------------------------------------------------------
 vtkHyperTreeGridPlaneCutter::vtkHyperTreeGridPlaneCutter()
+  : Internals(new vtkHyperTreeGridPlaneCutter::vtkInternals())
 {
   this->Points = nullptr;
   this->Cells = nullptr;
@@ -130,36 +199,6 @@ void vtkHyperTreeGridPlaneCutter::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Cells: ( none )\n";
   }
-
-  if (this->Leaves)
-  {
-    os << indent << "Leaves:\n";
-    this->Leaves->PrintSelf(os, indent.GetNextIndent());
-  }
-  else
-  {
-    os << indent << "Leaves: ( none )\n";
-  }
-
-  if (this->Centers)
-  {
-    os << indent << "Centers:\n";
-    this->Centers->PrintSelf(os, indent.GetNextIndent());
-  }
-  else
-  {
-    os << indent << "Centers: ( none )\n";
-  }
-
-  if (this->Cutter)
-  {
-    os << indent << "Cutter:\n";
-    this->Cutter->PrintSelf(os, indent.GetNextIndent());
-  }
-  else
-  {
-    os << indent << "Cutter: ( none )\n";
-  }
 }
 
 //------------------------------------------------------------------------------
@@ -183,22 +222,7 @@ void vtkHyperTreeGridPlaneCutter::Reset()
     this->Cells->Delete();
   }
   this->Cells = vtkCellArray::New();
-  if (this->Centers)
-  {
-    this->Centers->Initialize();
-  }
-  if (this->Leaves)
-  {
-    this->Leaves->Initialize();
-  }
-  if (this->Cutter)
-  {
-    this->Cutter->SetNumberOfContours(0);
-  }
-  if (this->SelectedCells)
-  {
-    this->SelectedCells->Initialize();
-  }
+  this->Internals->SelectedCells.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -228,6 +252,20 @@ int vtkHyperTreeGridPlaneCutter::ProcessTrees(vtkHyperTreeGrid* input, vtkDataOb
   // Retrieve material mask
   this->InMask = input->HasMask() ? input->GetMask() : nullptr;
 
+  // Collect the input trees, cut in parallel by batches of consecutive trees
+  std::vector<vtkIdType> treeIds;
+  vtkIdType index;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  input->InitializeTreeIterator(it);
+  while (it.GetNextTree(index))
+  {
+    treeIds.push_back(index);
+  }
+  const vtkIdType numTrees = static_cast<vtkIdType>(treeIds.size());
+  vtkBatches<BatchStorage> batches;
+  batches.Initialize(numTrees, static_cast<unsigned int>(numTrees / ::MAX_NUMBER_OF_BATCHES + 1));
+  const vtkIdType numBatches = batches.GetNumberOfBatches();
+
   // Compute cut on dual or primal input depending on specification
   if (this->Dual)
   {
@@ -235,95 +273,74 @@ int vtkHyperTreeGridPlaneCutter::ProcessTrees(vtkHyperTreeGrid* input, vtkDataOb
     this->OutData = output->GetPointData();
     this->OutData->CopyAllocate(this->InData);
 
-    // Storage for leaf indices
-    if (this->Leaves == nullptr)
-    {
-      this->Leaves = vtkIdList::New();
-    }
-    this->Leaves->SetNumberOfIds(8);
-
-    // Initialize storage for dual geometry
-    if (this->Centers == nullptr)
-    {
-      this->Centers = vtkPoints::New();
-    }
-    this->Centers->SetNumberOfPoints(8);
-
-    // Convert plane parameters into normal/origin specification
-    unsigned int maxId = 0;
-    if (fabs(this->Plane[1]) > fabs(this->Plane[0]))
-    {
-      maxId = 1;
-    }
-    if (fabs(this->Plane[2]) > fabs(this->Plane[maxId]))
-    {
-      maxId = 2;
-    }
-    double origin[] = { 0., 0., 0. };
-    origin[maxId] = this->Plane[3] / this->Plane[maxId];
-    vtkPlane* plane = vtkPlane::New();
-    plane->SetOrigin(origin);
-    plane->SetNormal(this->Plane[0], this->Plane[1], this->Plane[2]);
-
-    // Initialize plane cutter
-    if (this->Cutter == nullptr)
-    {
-      this->Cutter = vtkCutter::New();
-    }
-    this->Cutter->GenerateTrianglesOff();
-    this->Cutter->SetCutFunction(plane);
-
-    // Clean up
-    plane->Delete();
-
-    // Create storage to keep track of selected cells
-    if (this->SelectedCells == nullptr)
-    {
-      this->SelectedCells = vtkBitArray::New();
-    }
-    vtkIdType numCells = input->GetNumberOfCells();
-    this->SelectedCells->SetNumberOfTuples(numCells);
-    for (vtkIdType i = 0; i < numCells; ++i)
-    {
-      // Initialization is needed because not all cells are pre-processed
-      this->SelectedCells->SetValue(i, 0);
-    }
+    // Create storage to keep track of selected cells.
+    // Initialization is needed because not all cells are pre-processed
+    this->Internals->SelectedCells.assign(input->GetNumberOfCells(), 0);
 
     // First pass across tree roots to evince cells intersected by contours
-    vtkIdType index;
-    vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-    input->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
-    while (it.GetNextTree(index))
-    {
-      if (this->CheckAbort())
+    vtkSMPTools::For(0, numTrees, [&](vtkIdType begin, vtkIdType end) {
+      vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        break;
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        // Initialize new geometric cursor at root of current input tree
+        input->InitializeNonOrientedGeometryCursor(cursor, treeIds[i]);
+        // Pre-process tree recursively
+        this->RecursivelyPreProcessTree(cursor);
       }
-      // Initialize new geometric cursor at root of current input tree
-      input->InitializeNonOrientedGeometryCursor(cursor, index);
-      // Pre-process tree recursively
-      this->RecursivelyPreProcessTree(cursor);
-    } // it
+    });
 
     // Second pass across tree roots: now compute isocontours recursively
-    input->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedMooreSuperCursor> supercursor;
-    while (it.GetNextTree(index))
-    {
-      if (this->CheckAbort())
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+      vtkNew<vtkHyperTreeGridNonOrientedMooreSuperCursor> supercursor;
+      vtkNew<vtkIdList> leaves;
+      leaves->SetNumberOfIds(8);
+      vtkNew<vtkPoints> centers;
+      centers->SetNumberOfPoints(8);
+      vtkSmartPointer<vtkCutter> cutter = ::NewDualCutter(this->Plane);
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
       {
-        break;
+        BatchStorage& batch = batches[batchId].Data;
+        batch.Points = vtkSmartPointer<vtkPoints>::New();
+        batch.Cells = vtkSmartPointer<vtkCellArray>::New();
+        batch.PointData = vtkSmartPointer<vtkPointData>::New();
+        batch.PointData->CopyAllocate(this->InData);
+        batch.Leaves = leaves;
+        batch.Centers = centers;
+        batch.Cutter = cutter;
+        for (vtkIdType i = batches[batchId].BeginId; i < batches[batchId].EndId; ++i)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+          // Initialize new Moore cursor at root of current tree
+          input->InitializeNonOrientedMooreSuperCursor(supercursor, treeIds[i]);
+          // Generate leaf cell centers recursively
+          this->RecursivelyProcessTreeDual(supercursor, batch);
+        }
+        batch.Leaves = nullptr;
+        batch.Centers = nullptr;
+        batch.Cutter = nullptr;
       }
-      // Initialize new Moore cursor at root of current tree
-      input->InitializeNonOrientedMooreSuperCursor(supercursor, index);
-      // Generate leaf cell centers recursively
-      this->RecursivelyProcessTreeDual(supercursor);
-    } // it
+    });
 
     // Clean up
-    this->SelectedCells->Delete();
-    this->SelectedCells = nullptr;
+    this->Internals->SelectedCells.clear();
+    this->Internals->SelectedCells.shrink_to_fit();
   } // if ( this->Dual )
   else
   {
@@ -332,22 +349,71 @@ int vtkHyperTreeGridPlaneCutter::ProcessTrees(vtkHyperTreeGrid* input, vtkDataOb
     this->OutData->CopyAllocate(this->InData);
 
     // Iterate over all hyper trees
-    vtkIdType index;
-    vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-    input->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
-    while (it.GetNextTree(index))
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+      vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+      {
+        BatchStorage& batch = batches[batchId].Data;
+        batch.Points = vtkSmartPointer<vtkPoints>::New();
+        batch.Cells = vtkSmartPointer<vtkCellArray>::New();
+        for (vtkIdType i = batches[batchId].BeginId; i < batches[batchId].EndId; ++i)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+          // Initialize new geometric cursor at root of current tree
+          input->InitializeNonOrientedGeometryCursor(cursor, treeIds[i]);
+          // Generate leaf cell centers recursively
+          this->RecursivelyProcessTreePrimal(cursor, batch);
+        }
+      }
+    });
+  } // else
+
+  // Append the output of the batches in order, so that it does not depend on
+  // the number of threads
+  for (vtkIdType batchId = 0; batchId < numBatches; ++batchId)
+  {
+    BatchStorage& batch = batches[batchId].Data;
+    if (!batch.Points)
+    {
+      continue;
+    }
+    const vtkIdType pointOffset = this->Points->GetNumberOfPoints();
+    const vtkIdType cellOffset = this->Cells->GetNumberOfCells();
+    const vtkIdType numPoints = batch.Points->GetNumberOfPoints();
+    if (numPoints)
+    {
+      this->Points->GetData()->InsertTuples(pointOffset, numPoints, 0, batch.Points->GetData());
+    }
+    this->Cells->Append(batch.Cells, pointOffset);
+    if (this->Dual)
+    {
+      // Output and batch point data have the same arrays, both being
+      // allocated from the input cell data
+      for (int iArr = 0; iArr < this->OutData->GetNumberOfArrays() && numPoints; ++iArr)
+      {
+        this->OutData->GetAbstractArray(iArr)->InsertTuples(
+          pointOffset, numPoints, 0, batch.PointData->GetAbstractArray(iArr));
+      }
+    }
+    else
     {
-      if (this->CheckAbort())
+      // Copy face data from that of the cell from which it comes
+      const vtkIdType numCells = static_cast<vtkIdType>(batch.CellIds.size());
+      for (vtkIdType i = 0; i < numCells; ++i)
       {
-        break;
+        this->OutData->CopyData(this->InData, batch.CellIds[i], cellOffset + i);
       }
-      // Initialize new geometric cursor at root of current tree
-      input->InitializeNonOrientedGeometryCursor(cursor, index);
-      // Generate leaf cell centers recursively
-      this->RecursivelyProcessTreePrimal(cursor);
-    } // it
-  }   // else
+    }
+    batch = BatchStorage();
+  }
 
   // Set output geometry and topology
   output->SetPoints(this->Points);
@@ -370,7 +436,7 @@ int vtkHyperTreeGridPlaneCutter::ProcessTrees(vtkHyperTreeGrid* input, vtkDataOb
 
 //------------------------------------------------------------------------------
 void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreePrimal(
-  vtkHyperTreeGridNonOrientedGeometryCursor* cursor)
+  vtkHyperTreeGridNonOrientedGeometryCursor* cursor, BatchStorage& batch)
 {
   // If cursor is at a masked cell stop recursion
   vtkIdType inId = cursor->GetGlobalNodeIndex();
@@ -480,14 +546,13 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreePrimal(
       for (int i = 0; i < n; ++i)
       {
         // Save points and get their IDs
-        ids[i] = this->Points->InsertNextPoint(points[i]);
+        ids[i] = batch.Points->InsertNextPoint(points[i]);
       }
 
-      // Insert next face
-      vtkIdType outId = this->Cells->InsertNextCell(n, ids);
-
-      // Copy face data from that of the cell from which it comes
-      this->OutData->CopyData(this->InData, inId, outId);
+      // Insert next face, its data is copied from that of the cell from
+      // which it comes when appending the batch to the output
+      batch.Cells->InsertNextCell(n, ids);
+      batch.CellIds.push_back(inId);
     } // if ( cursor->IsLeaf() )
     else
     {
@@ -495,19 +560,34 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreePrimal(
       int numChildren = cursor->GetNumberOfChildren();
       for (int ichild = 0; ichild < numChildren; ++ichild)
       {
-        if (this->CheckAbort())
-        {
-          break;
-        }
         cursor->ToChild(ichild);
         // Recurse
-        this->RecursivelyProcessTreePrimal(cursor);
+        this->RecursivelyProcessTreePrimal(cursor, batch);
         cursor->ToParent();
       } // ichild
     }   // else
   }     // CheckIntersection
 }
 
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreePrimal(
+  vtkHyperTreeGridNonOrientedGeometryCursor* cursor)
+{
+  // Cut the tree as a batch of its own, directly into the output of the filter
+  BatchStorage batch;
+  batch.Points = this->Points;
+  batch.Cells = this->Cells;
+  const vtkIdType cellOffset = this->Cells->GetNumberOfCells();
+  this->RecursivelyProcessTreePrimal(cursor, batch);
+
+  // Copy face data from that of the cell from which it comes
+  const vtkIdType numCells = static_cast<vtkIdType>(batch.CellIds.size());
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    this->OutData->CopyData(this->InData, batch.CellIds[i], cellOffset + i);
+  }
+}
+
 //------------------------------------------------------------------------------
 bool vtkHyperTreeGridPlaneCutter::RecursivelyPreProcessTree(
   vtkHyperTreeGridNonOrientedGeometryCursor* cursor)
@@ -549,10 +629,6 @@ bool vtkHyperTreeGridPlaneCutter::RecursivelyPreProcessTree(
       int numChildren = cursor->GetNumberOfChildren();
       for (int ichild = 0; ichild < numChildren; ++ichild)
       {
-        if (this->CheckAbort())
-        {
-          break;
-        }
         cursor->ToChild(ichild);
         // Recurse and keep track of whether this branch is selected
         selected |= this->RecursivelyPreProcessTree(cursor);
@@ -562,7 +638,7 @@ bool vtkHyperTreeGridPlaneCutter::RecursivelyPreProcessTree(
   }     // if ( this->CheckIntersection )
 
   // Update list of selected cells
-  this->SelectedCells->SetTuple1(id, selected);
+  this->Internals->SelectedCells[id] = selected ? 1 : 0;
 
   // Return whether current node was selected
   return selected;
@@ -570,7 +646,7 @@ bool vtkHyperTreeGridPlaneCutter::RecursivelyPreProcessTree(
 
 //------------------------------------------------------------------------------
 void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
-  vtkHyperTreeGridNonOrientedMooreSuperCursor* cursor)
+  vtkHyperTreeGridNonOrientedMooreSuperCursor* cursor, BatchStorage& batch)
 {
   // If cursor is at a masked cell stop recursion
   vtkIdType id = cursor->GetGlobalNodeIndex();
@@ -583,7 +659,7 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
   if (!cursor->IsLeaf())
   {
     // Check if cursor is at selected cell
-    if (!this->SelectedCells->GetTuple1(id))
+    if (!this->Internals->SelectedCells[id])
     {
       // Cell is not selected until proven otherwise
       bool selected = false;
@@ -598,7 +674,7 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
           vtkIdType idN = cursor->GetGlobalNodeIndex(indN);
 
           // Decide whether neighbor was selected
-          selected = (this->SelectedCells->GetTuple1(idN) != 0.0);
+          selected = (this->Internals->SelectedCells[idN] != 0);
         }
         else
         {
@@ -611,19 +687,15 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
       {
         return;
       }
-    } // if ( this->SelectedCells->GetTuple1( id ) )
+    } // if ( this->Internals->SelectedCells[id] )
 
     // Recurse to all children
     int numChildren = cursor->GetNumberOfChildren();
     for (int ichild = 0; ichild < numChildren; ++ichild)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
       cursor->ToChild(ichild);
       // Recurse
-      this->RecursivelyProcessTreeDual(cursor);
+      this->RecursivelyProcessTreeDual(cursor, batch);
       cursor->ToParent();
     } // ichild
   }   // if ( ! cursor->IsLeaf() )
@@ -632,17 +704,13 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
     // Cursor is at leaf, iterate over its corners
     for (unsigned int cornerIdx = 0; cornerIdx < 8; ++cornerIdx)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
       // Cell is not selected until proven otherwise
       bool owner = true;
 
       // Iterate over every leaf touching the corner and check ownership
       for (unsigned int leafIdx = 0; leafIdx < 8 && owner; ++leafIdx)
       {
-        owner = cursor->GetCornerCursors(cornerIdx, leafIdx, this->Leaves);
+        owner = cursor->GetCornerCursors(cornerIdx, leafIdx, batch.Leaves);
       } // leafIdx
 
       // If cell owns dual cell, compute intersection thereof
@@ -659,11 +727,11 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
         for (int _cornerIdx = 0; _cornerIdx < 8; ++_cornerIdx)
         {
           // Get cursor corresponding to this corner
-          vtkIdType cursorId = this->Leaves->GetId(_cornerIdx);
+          vtkIdType cursorId = batch.Leaves->GetId(_cornerIdx);
 
           // Retrieve neighbor coordinates and store them
           cursor->GetPoint(cursorId, x);
-          this->Centers->SetPoint(_cornerIdx, x);
+          batch.Centers->SetPoint(_cornerIdx, x);
 
           // Retrieve neighbor index and corresponding input scalar value
           vtkIdType idN = cursor->GetGlobalNodeIndex(cursorId);
@@ -673,31 +741,31 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
         } // _cornerIdx
 
         // Assign geometry of dual cell
-        dual->SetPoints(this->Centers);
+        dual->SetPoints(batch.Centers);
 
         // Compute intersection with plane
-        this->Cutter->SetInputData(dual);
-        this->Cutter->Update();
+        batch.Cutter->SetInputData(dual);
+        batch.Cutter->Update();
 
         // Append computed polygons if some are present in cutter output
-        vtkPolyData* pd = this->Cutter->GetOutput();
+        vtkPolyData* pd = batch.Cutter->GetOutput();
         vtkIdType nPoints = pd->GetNumberOfPoints();
         if (nPoints)
         {
           // Keep handle to cut point data
           vtkPointData* pdata = pd->GetPointData();
 
-          // Append new points to existing cut points
-          vtkIdType offset = this->Points->GetNumberOfPoints();
+          // Append new points to existing cut points of the batch
+          vtkIdType offset = batch.Points->GetNumberOfPoints();
           double pt[3];
           for (vtkIdType i = 0; i < nPoints; ++i)
           {
             // Retrieve cut point coordinates and insert them into output points
             pd->GetPoint(i, pt);
-            this->Points->InsertNextPoint(pt);
+            batch.Points->InsertNextPoint(pt);
 
             // Copy cut point data to that of corresponding output point
-            this->OutData->CopyData(pdata, i, i + offset);
+            batch.PointData->CopyData(pdata, i, i + offset);
           } // i
 
           // Append new elements to existing cut element
@@ -716,7 +784,7 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
             } // j
 
             // Insert next cell with offset ids
-            this->Cells->InsertNextCell(n, ids);
+            batch.Cells->InsertNextCell(n, ids);
           } // i
         }   // if ( nPoints )
 
@@ -727,6 +795,26 @@ void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
   }     // else
 }
 
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridPlaneCutter::RecursivelyProcessTreeDual(
+  vtkHyperTreeGridNonOrientedMooreSuperCursor* cursor)
+{
+  // Cut the tree as a batch of its own, directly into the output of the filter
+  vtkNew<vtkIdList> leaves;
+  leaves->SetNumberOfIds(8);
+  vtkNew<vtkPoints> centers;
+  centers->SetNumberOfPoints(8);
+  vtkSmartPointer<vtkCutter> cutter = ::NewDualCutter(this->Plane);
+  BatchStorage batch;
+  batch.Points = this->Points;
+  batch.Cells = this->Cells;
+  batch.PointData = vtkPointData::SafeDownCast(this->OutData);
+  batch.Leaves = leaves;
+  batch.Centers = centers;
+  batch.Cutter = cutter;
+  this->RecursivelyProcessTreeDual(cursor, batch);
+}
+
 //------------------------------------------------------------------------------
 bool vtkHyperTreeGridPlaneCutter::CheckIntersection(double cellCoords[8][3], double functEval[8])
 {
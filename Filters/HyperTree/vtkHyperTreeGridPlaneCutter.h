@@ -15,6 +15,9 @@
  * cost of interpolation to the dual of the input AMR mesh, and therefore
  * of missing intersection plane pieces near the primal boundary.
  *
+ * The hyper trees are cut in parallel with vtkSMPTools. The output does not
+ * depend on the number of threads.
+ *
  * @sa
  * vtkHyperTreeGrid vtkHyperTreeGridAlgorithm
  *
@@ -28,9 +31,12 @@
 #ifndef vtkHyperTreeGridPlaneCutter_h
 #define vtkHyperTreeGridPlaneCutter_h
 
+#include "vtkDeprecation.h"            // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersHyperTreeModule.h" // For export macro
 #include "vtkHyperTreeGridAlgorithm.h"
 
+#include <memory> // For std::unique_ptr
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
 class vtkCutter;
@@ -100,9 +106,22 @@ protected:
    */
   int ProcessTrees(vtkHyperTreeGrid*, vtkDataObject*) override;
 
+  /**
+   * Output of the cut of a batch of hyper trees, and work storage of the
+   * thread processing it. Defined in the implementation file.
+   */
+  struct BatchStorage;
+
   /**
    * Recursively descend into tree down to leaves, cutting primal cells
    */
+  void RecursivelyProcessTreePrimal(vtkHyperTreeGridNonOrientedGeometryCursor*, BatchStorage&);
+
+  /**
+   * Recursively descend into tree down to leaves, cutting primal cells into
+   * the output of the filter
+   */
+  VTK_DEPRECATED_IN_9_4_0("Use the overload taking the storage of a batch of trees.")
   void RecursivelyProcessTreePrimal(vtkHyperTreeGridNonOrientedGeometryCursor*);
 
   /**
@@ -113,6 +132,13 @@ protected:
   /**
    * Recursively descend into tree down to leaves, cutting dual cells
    */
+  void RecursivelyProcessTreeDual(vtkHyperTreeGridNonOrientedMooreSuperCursor*, BatchStorage&);
+
+  /**
+   * Recursively descend into tree down to leaves, cutting dual cells into the
+   * output of the filter
+   */
+  VTK_DEPRECATED_IN_9_4_0("Use the overload taking the storage of a batch of trees.")
   void RecursivelyProcessTreeDual(vtkHyperTreeGridNonOrientedMooreSuperCursor*);
 
   /**
@@ -147,6 +173,7 @@ protected:
   /**
    * Storage for pre-selected cells to be processed in dual mode
    */
+  VTK_DEPRECATED_IN_9_4_0("The selected cells are stored by the filter internals.")
   vtkBitArray* SelectedCells;
 
   /**
@@ -162,16 +189,19 @@ protected:
   /**
    * Storage for dual vertex indices
    */
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses a list of leaves of its own.")
   vtkIdList* Leaves;
 
   /**
    * Storage for dual vertices at center of primal cells
    */
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses centers of its own.")
   vtkPoints* Centers;
 
   /**
    * Cutter to be used on dual cells
    */
+  VTK_DEPRECATED_IN_9_4_0("Each thread uses a cutter of its own.")
   vtkCutter* Cutter;
 
   /**
@@ -187,6 +217,9 @@ protected:
 private:
   vtkHyperTreeGridPlaneCutter(const vtkHyperTreeGridPlaneCutter&) = delete;
   void operator=(const vtkHyperTreeGridPlaneCutter&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 VTK_ABI_NAMESPACE_END
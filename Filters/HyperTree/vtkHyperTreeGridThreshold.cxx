@@ -14,13 +14,16 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
-#include "vtkThreadedTaskQueue.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformHyperTreeGrid.h"
 
 #include "vtkHyperTreeGridNonOrientedCursor.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
+#include <vector>
 
 namespace
 {
@@ -40,6 +43,17 @@ public:
 
   virtual ~CellDataManager() = default;
 
+  /*
+   * Allocate the output data for the given number of cells. The data of
+   * distinct cells may then be set concurrently.
+   */
+  virtual void Allocate(vtkIdType numberOfCells) = 0;
+
+  /*
+   * Return whether the data of distinct output cells can be set concurrently.
+   */
+  virtual bool IsThreadSafe() const { return true; }
+
   virtual void operator()(vtkIdType inputIndex, vtkIdType outputIndex) = 0;
 
   virtual void WrapUp() = 0;
@@ -64,6 +78,27 @@ public:
 
   ~CellDataCopier() override = default;
 
+  void Allocate(vtkIdType numberOfCells) override
+  {
+    for (int iArr = 0; iArr < this->OutputData->GetNumberOfArrays(); ++iArr)
+    {
+      this->OutputData->GetAbstractArray(iArr)->SetNumberOfTuples(numberOfCells);
+    }
+  }
+
+  bool IsThreadSafe() const override
+  {
+    // Bits of distinct cells may share the same byte
+    for (int iArr = 0; iArr < this->OutputData->GetNumberOfArrays(); ++iArr)
+    {
+      if (vtkBitArray::SafeDownCast(this->OutputData->GetAbstractArray(iArr)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void operator()(vtkIdType inputIndex, vtkIdType outputIndex) override
   {
     this->OutputData->CopyData(this->InputData, inputIndex, outputIndex);
@@ -134,9 +169,14 @@ public:
     }
   }
 
+  void Allocate(vtkIdType numberOfCells) override
+  {
+    this->IndirectionMap->SetNumberOfTuples(numberOfCells);
+  }
+
   void operator()(vtkIdType inputIndex, vtkIdType outputIndex) override
   {
-    this->IndirectionMap->InsertValue(outputIndex, inputIndex);
+    this->IndirectionMap->SetValue(outputIndex, inputIndex);
   }
 
   void WrapUp() override
@@ -157,6 +197,27 @@ private:
   vtkSmartPointer<vtkIdTypeArray> IndirectionMap;
 };
 
+/*
+ * Return the number of cells of the output tree copied from the input tree
+ * pointed by the cursor: the descendants of masked cells are not copied.
+ */
+vtkIdType CountOutputCells(vtkHyperTreeGridNonOrientedCursor* cursor, vtkBitArray* mask)
+{
+  vtkIdType count = 1;
+  if (cursor->IsLeaf() || (mask && mask->GetValue(cursor->GetGlobalNodeIndex())))
+  {
+    return count;
+  }
+  int numChildren = cursor->GetNumberOfChildren();
+  for (int ichild = 0; ichild < numChildren; ++ichild)
+  {
+    cursor->ToChild(ichild);
+    count += CountOutputCells(cursor, mask);
+    cursor->ToParent();
+  }
+  return count;
+}
+
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -262,44 +323,63 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
   // Retrieve material mask
   this->InMask = input->HasMask() ? input->GetMask() : nullptr;
 
+  // Collect the input trees, which are processed in parallel
+  std::vector<vtkIdType> treeIds;
+  vtkIdType index;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  input->InitializeTreeIterator(it);
+  while (it.GetNextTree(index))
+  {
+    treeIds.push_back(index);
+  }
+  const vtkIdType numTrees = static_cast<vtkIdType>(treeIds.size());
+
   if (this->MemoryStrategy == MaskInput)
   {
     output->ShallowCopy(input);
 
-    // Create mutexes covering the whole array for concurrent accesses to the same byte of
-    // vtkBitArray
+    // The descendants of masked cells are not visited, do not leave their
+    // values uninitialized
     const vtkIdType nbCells = output->GetNumberOfCells();
-    const vtkIdType nbBytesMask = nbCells / 8;
-    const vtkIdType nbMutexes = std::max<vtkIdType>(std::min<vtkIdType>(MAX_MUTEX, nbBytesMask), 1);
-    this->ArrayMutexSize = nbCells / nbMutexes + 1;
-    if (this->ArrayMutexSize % 8 != 0)
-    {
-      // Align the size of mutex array with byte delimitation
-      this->ArrayMutexSize += 8 - this->ArrayMutexSize % 8;
-    }
-    this->ArrayMutexSize = std::max(this->ArrayMutexSize, 8);
-    assert("ArrayMutexSize is a multiple of 8" && this->ArrayMutexSize % 8 == 0);
-    std::vector<std::mutex> list(nbMutexes);
-    this->OutMaskMutexes.swap(list); // std::mutex is not movable, need to use a swap
-
-    this->OutMask->SetNumberOfTuples(output->GetNumberOfCells());
+    this->InitializeOutMask(nbCells);
 
-    // Iterate over all input and output hyper trees
-    vtkIdType outIndex;
-    vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-    output->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedCursor> outCursor;
-    while (it.GetNextTree(outIndex))
+    // When there are fewer trees than threads, the children of the cells of
+    // the first levels are processed in parallel instead
+    if (numTrees < vtkSMPTools::GetEstimatedNumberOfThreads())
     {
-      if (this->CheckAbort())
+      vtkNew<vtkHyperTreeGridNonOrientedCursor> outCursor;
+      for (vtkIdType treeId : treeIds)
       {
-        break;
+        if (this->CheckAbort())
+        {
+          break;
+        }
+        output->InitializeNonOrientedCursor(outCursor, treeId);
+        this->RecursivelyProcessTreeWithCreateNewMask(outCursor);
       }
-      // Initialize new grid cursor at root of current input tree
-      output->InitializeNonOrientedCursor(outCursor, outIndex);
-      // Limit depth recursively
-      this->RecursivelyProcessTreeWithCreateNewMask(outCursor);
-    } // it
+    }
+    else
+    {
+      vtkSMPTools::For(0, numTrees, [&](vtkIdType begin, vtkIdType end) {
+        vtkNew<vtkHyperTreeGridNonOrientedCursor> outCursor;
+        bool isFirst = vtkSMPTools::GetSingleThread();
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+          // Initialize new grid cursor at root of current input tree
+          output->InitializeNonOrientedCursor(outCursor, treeIds[i]);
+          // Limit depth recursively
+          this->RecursivelyProcessTreeWithCreateNewMask(outCursor);
+        }
+      });
+    }
   }
   else if (this->MemoryStrategy == CopyStructureAndIndexArrays ||
     this->MemoryStrategy == DeepThreshold)
@@ -333,28 +413,57 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
         break;
     }
 
-    // Output indices begin at 0
-    this->CurrentId = 0;
+    // The output cells of each tree are numbered consecutively, in depth
+    // first order and in the order of the trees: count them to get the
+    // first output index of each tree.
+    std::vector<vtkIdType> treeOffsets(numTrees + 1, 0);
+    vtkSMPTools::For(0, numTrees, [&](vtkIdType begin, vtkIdType end) {
+      vtkNew<vtkHyperTreeGridNonOrientedCursor> inCursor;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        input->InitializeNonOrientedCursor(inCursor, treeIds[i]);
+        treeOffsets[i + 1] = ::CountOutputCells(inCursor, this->InMask);
+      }
+    });
+    std::partial_sum(treeOffsets.begin(), treeOffsets.end(), treeOffsets.begin());
+    this->CurrentId = treeOffsets[numTrees];
 
-    // Iterate over all input and output hyper trees
-    vtkIdType inIndex;
-    vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-    input->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedCursor> inCursor;
+    this->InitializeOutMask(this->CurrentId);
+    this->Internal->CDManager->Allocate(this->CurrentId);
+
+    // Output trees are created serially, the tree map of the output is not
+    // thread safe
     vtkNew<vtkHyperTreeGridNonOrientedCursor> outCursor;
-    while (it.GetNextTree(inIndex))
+    for (vtkIdType treeId : treeIds)
     {
-      if (this->CheckAbort())
+      output->InitializeNonOrientedCursor(outCursor, treeId, true);
+    }
+
+    const vtkIdType grain =
+      this->Internal->CDManager->IsThreadSafe() ? 0 : std::max<vtkIdType>(numTrees, 1);
+    vtkSMPTools::For(0, numTrees, grain, [&](vtkIdType begin, vtkIdType end) {
+      vtkNew<vtkHyperTreeGridNonOrientedCursor> inCursor;
+      vtkNew<vtkHyperTreeGridNonOrientedCursor> treeOutCursor;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        break;
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        // Initialize new cursor at root of current input tree
+        input->InitializeNonOrientedCursor(inCursor, treeIds[i]);
+        // Initialize new cursor at root of current output tree
+        output->InitializeNonOrientedCursor(treeOutCursor, treeIds[i]);
+        // Limit depth recursively
+        vtkIdType currentId = treeOffsets[i];
+        this->RecursivelyProcessTree(inCursor, treeOutCursor, currentId);
       }
-      // Initialize new cursor at root of current input tree
-      input->InitializeNonOrientedCursor(inCursor, inIndex);
-      // Initialize new cursor at root of current output tree
-      output->InitializeNonOrientedCursor(outCursor, inIndex, true);
-      // Limit depth recursively
-      this->RecursivelyProcessTree(inCursor, outCursor);
-    } // it
+    });
 
     this->Internal->CDManager->WrapUp();
   }
@@ -374,14 +483,14 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
 }
 
 //------------------------------------------------------------------------------
-bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
-  vtkHyperTreeGridNonOrientedCursor* inCursor, vtkHyperTreeGridNonOrientedCursor* outCursor)
+bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(vtkHyperTreeGridNonOrientedCursor* inCursor,
+  vtkHyperTreeGridNonOrientedCursor* outCursor, vtkIdType& currentId)
 {
   // Retrieve global index of input cursor
   vtkIdType inId = inCursor->GetGlobalNodeIndex();
 
   // Increase index count on output: postfix is intended
-  vtkIdType outId = this->CurrentId++;
+  vtkIdType outId = currentId++;
 
   // Copy out cell data from that of input cell
   if (!this->Internal->CDManager)
@@ -401,7 +510,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
   if (this->InMask && this->InMask->GetValue(inId))
   {
     // Mask output cell if necessary
-    this->OutMask->InsertTuple1(outId, discard);
+    this->SafeInsertOutMask(outId, discard);
 
     // Return whether current node is within range
     return discard;
@@ -417,16 +526,12 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
     int numChildren = inCursor->GetNumberOfChildren();
     for (int ichild = 0; ichild < numChildren; ++ichild)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
       // Descend into child in input grid as well
       inCursor->ToChild(ichild);
       // Descend into child in output grid as well
       outCursor->ToChild(ichild);
       // Recurse and keep track of whether some children are kept
-      discard &= this->RecursivelyProcessTree(inCursor, outCursor);
+      discard &= this->RecursivelyProcessTree(inCursor, outCursor, currentId);
       // Return to parent in input grid
       outCursor->ToParent();
       // Return to parent in output grid
@@ -436,7 +541,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
   else
   {
     // Input cursor is at leaf, check whether it is within range
-    double value = this->InScalars->GetTuple1(inId);
+    double value = this->InScalars->GetComponent(inId, 0);
     if (!(this->InMask && this->InMask->GetValue(inId)) && value >= this->LowerThreshold &&
       value <= this->UpperThreshold)
     {
@@ -446,7 +551,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
   } // else
 
   // Mask output cell if necessary
-  this->OutMask->InsertTuple1(outId, discard);
+  this->SafeInsertOutMask(outId, discard);
 
   // Return whether current node is within range
   return discard;
@@ -482,26 +587,22 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTreeWithCreateNewMask(
 
     if (outCursor->GetLevel() <= 2)
     {
-      // Create a new thread for every child, when we're not too deep into the tree
-      vtkThreadedTaskQueue<bool, int> queue(
-        [this, outCursor](int ichild) {
-          vtkSmartPointer<vtkHyperTreeGridNonOrientedCursor> childOutCursor =
-            vtk::TakeSmartPointer(outCursor->CloneFromCurrentEntry());
-
-          return this->RecursivelyProcessChild(childOutCursor, ichild);
-        },
-        true);
-
-      for (unsigned char ichild = 0; ichild < outCursor->GetNumberOfChildren(); ++ichild)
-      {
-        queue.Push(static_cast<int>(ichild));
-      }
-
-      while (!queue.IsEmpty())
+      // Process the children in parallel when we're not too deep into the tree.
+      // This only spawns threads when the trees are not already processed in
+      // parallel, nested parallelism being disabled by default.
+      std::vector<unsigned char> childDiscards(numChildren, 1);
+      vtkSMPTools::For(0, numChildren, 1, [&](vtkIdType begin, vtkIdType end) {
+        vtkSmartPointer<vtkHyperTreeGridNonOrientedCursor> childOutCursor =
+          vtk::TakeSmartPointer(outCursor->CloneFromCurrentEntry());
+        for (vtkIdType ichild = begin; ichild < end; ++ichild)
+        {
+          childDiscards[ichild] =
+            this->RecursivelyProcessChild(childOutCursor, static_cast<int>(ichild));
+        }
+      });
+      for (unsigned char childDiscard : childDiscards)
       {
-        bool result;
-        queue.Pop(result);
-        discard &= result;
+        discard &= childDiscard != 0;
       }
     }
     else
@@ -540,11 +641,33 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessChild(
   return discard;
 }
 
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridThreshold::InitializeOutMask(vtkIdType numberOfCells)
+{
+  // Create one mutex per block of bytes, bits of the same byte of a
+  // vtkBitArray cannot be written concurrently
+  const vtkIdType nbBytesMask = numberOfCells / 8;
+  const vtkIdType nbMutexes = std::max<vtkIdType>(std::min<vtkIdType>(MAX_MUTEX, nbBytesMask), 1);
+  this->ArrayMutexSize = numberOfCells / nbMutexes + 1;
+  if (this->ArrayMutexSize % 8 != 0)
+  {
+    // Align the size of mutex array with byte delimitation
+    this->ArrayMutexSize += 8 - this->ArrayMutexSize % 8;
+  }
+  this->ArrayMutexSize = std::max(this->ArrayMutexSize, 8);
+  assert("ArrayMutexSize is a multiple of 8" && this->ArrayMutexSize % 8 == 0);
+  std::vector<std::mutex> list(nbMutexes);
+  this->OutMaskMutexes.swap(list); // std::mutex is not movable, need to use a swap
+
+  this->OutMask->SetNumberOfTuples(numberOfCells);
+  std::fill_n(this->OutMask->GetPointer(0), (numberOfCells + 7) / 8, 0);
+}
+
 //------------------------------------------------------------------------------
 void vtkHyperTreeGridThreshold::SafeInsertOutMask(vtkIdType tupleIdx, double value)
 {
   assert("pre: ArrayMutexSize not null" && this->ArrayMutexSize > 0);
   const std::lock_guard<std::mutex> lock(this->OutMaskMutexes[tupleIdx / this->ArrayMutexSize]);
-  this->OutMask->InsertTuple1(tupleIdx, value);
+  this->OutMask->SetValue(tupleIdx, value != 0.0);
 }
 VTK_ABI_NAMESPACE_END
@@ -13,6 +13,9 @@
  * A parameter (JustCreateNewMask) allows to only redefine the mask
  * and not create a new HTG.
  *
+ * The hyper trees are processed in parallel with vtkSMPTools. The output does
+ * not depend on the number of threads.
+ *
  * @sa
  * vtkHyperTreeGrid vtkHyperTreeGridAlgorithm vtkThreshold
  *
@@ -120,10 +123,12 @@ protected:
   int ProcessTrees(vtkHyperTreeGrid*, vtkDataObject*) override;
 
   /**
-   * Recursively descend into input tree down to leaves, creating output structure at the same time
+   * Recursively descend into input tree down to leaves, creating output structure at the same time.
+   * The output cells are numbered from `currentId`, which is incremented for each of them.
+   * Distinct trees can be processed concurrently.
    */
-  bool RecursivelyProcessTree(
-    vtkHyperTreeGridNonOrientedCursor*, vtkHyperTreeGridNonOrientedCursor*);
+  bool RecursivelyProcessTree(vtkHyperTreeGridNonOrientedCursor*,
+    vtkHyperTreeGridNonOrientedCursor*, vtkIdType& currentId);
 
   /**
    * Recursively descend into input tree down to leaves, filling the output mask
@@ -152,7 +157,7 @@ protected:
   vtkBitArray* OutMask;
 
   /**
-   * Keep track of current index in output hyper tree grid
+   * Number of cells of the output hyper tree grid
    */
   vtkIdType CurrentId;
 
@@ -176,6 +181,12 @@ private:
    */
   bool RecursivelyProcessChild(vtkHyperTreeGridNonOrientedCursor* outCursor, int ichild);
 
+  /**
+   * Allocate OutMask for the given number of cells, with all cells unmasked,
+   * and the mutexes used by `SafeInsertOutMask`.
+   */
+  void InitializeOutMask(vtkIdType numberOfCells);
+
   /**
    * Thread-safe version of insertion in OutMask BitArray using a global mutex.
    */
@@ -1,5 +1,8 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkImageDataToHyperTreeGrid.h"
 
 #include <vtkBitArray.h>
@@ -8,6 +11,7 @@
 #include <vtkDoubleArray.h>
 #include <vtkHyperTree.h>
 #include <vtkHyperTreeGrid.h>
+#include <vtkHyperTreeGridNonOrientedCursor.h>
 #include <vtkIdTypeArray.h>
 #include <vtkImageData.h>
 #include <vtkInformation.h>
@@ -15,13 +19,83 @@
 #include <vtkIntArray.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
 #include <vtkUnsignedCharArray.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
-
-#include "vtkHyperTreeGridNonOrientedCursor.h"
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+struct VertexData
+{
+  // Group of colors of the first pixel of the vertex, -1 if outside the image
+  int Value;
+  double Depth;
+};
+
+struct TreeData
+{
+  std::vector<bool> Descriptor;
+  std::vector<VertexData> Values;
+};
+
+//------------------------------------------------------------------------------
+// Compute the breadth first order descriptor and the vertex values of a tree
+// from the groups of colors of its pixels
+void ProcessPixels(const std::vector<int>& pixels, int nbPxl, TreeData& tree)
+{
+  // The vertices of each depth, in breadth first order, are blocks of pixels
+  // given by their first pixel and their width
+  std::vector<std::array<int, 2>> currentDepth = { { 0, 0 } };
+  std::vector<std::array<int, 2>> nextDepth;
+  for (int size = nbPxl, level = 0; !currentDepth.empty(); size /= 2, ++level)
+  {
+    const std::size_t firstBit = tree.Descriptor.size();
+    nextDepth.clear();
+    for (const std::array<int, 2>& block : currentDepth)
+    {
+      const int first = block[0] + block[1] * nbPxl;
+      const int val = pixels[first];
+      bool raf = false;
+      for (int pj = 0; pj < size && !raf; ++pj)
+      {
+        for (int pi = 0; pi < size; ++pi)
+        {
+          if (pixels[first + pi + pj * nbPxl] != val)
+          {
+            raf = true;
+            break;
+          }
+        }
+      }
+      tree.Values.push_back({ val, static_cast<double>(level) });
+      tree.Descriptor.push_back(raf);
+      if (raf)
+      {
+        const int half = size / 2;
+        for (int j = 0; j < 2; ++j)
+        {
+          for (int i = 0; i < 2; ++i)
+          {
+            nextDepth.push_back({ block[0] + i * half, block[1] + j * half });
+          }
+        }
+      }
+    }
+    if (nextDepth.empty())
+    {
+      // The last depth is not described, its vertices are all leaves
+      tree.Descriptor.resize(firstBit);
+    }
+    std::swap(currentDepth, nextDepth);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkImageDataToHyperTreeGrid);
 
 //------------------------------------------------------------------------------
@@ -111,74 +185,177 @@ int vtkImageDataToHyperTreeGrid::RequestData(vtkInformation* vtkNotUsed(request)
   this->OutData = output->GetCellData();
   this->OutData->CopyAllocate(this->InData);
 
-  this->Color = vtkUnsignedCharArray::New();
-  this->Color->SetName("Colors");
-  this->Color->SetNumberOfComponents(3);
-
-  this->Depth = vtkDoubleArray::New();
-  this->Depth->SetName("Depth");
-  this->Depth->SetNumberOfComponents(1);
-
-  this->Mask = vtkBitArray::New();
-  this->Mask->SetName("Mask");
-  this->Mask->SetNumberOfComponents(1);
-
-  output->SetMask(this->Mask);
-
-  this->GlobalId = 0;
-  this->OutData->AddArray(this->Color);
-  this->OutData->AddArray(this->Depth);
+  // First pass: compute the breadth first order descriptor and the vertex
+  // values of every tree independently
+  const vtkIdType nbTrees = output->GetMaxNumberOfTrees();
+  const int nbPxl = pow(2, this->DepthMax);
+  const int car = this->NbColors * this->NbColors;
+  const unsigned char pas = 256 / this->NbColors;
+  std::vector<TreeData> trees(nbTrees);
+  vtkSMPTools::For(0, nbTrees, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<int> pixels(nbPxl * nbPxl);
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType itree = begin; itree < end; ++itree)
+    {
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      unsigned int i, j, k;
+      output->GetLevelZeroCoordinatesFromIndex(itree, i, j, k);
+      int id = 0;
+      for (int pj = 0; pj < nbPxl; ++pj)
+      {
+        for (int pi = 0; pi < nbPxl; ++pi, ++id)
+        {
+          int x = i * nbPxl + pi;
+          int y = j * nbPxl + pj;
+          if (x < inSize[0] && y < inSize[1])
+          {
+            unsigned char* val = static_cast<unsigned char*>(input->GetScalarPointer(x, y, 0));
+            pixels[id] = (val[0] / pas) + (val[1] / pas) * this->NbColors +
+              (val[2] / pas) * this->NbColors * this->NbColors;
+          }
+          else
+          {
+            pixels[id] = -1;
+          }
+        }
+      }
+      ::ProcessPixels(pixels, nbPxl, trees[itree]);
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
 
-  vtkIdType nbTrees = output->GetMaxNumberOfTrees();
-  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
+  // Second pass: write the descriptors and the vertex values of the trees,
+  // one after the other. The descriptor of each tree starts on a new byte, so
+  // that the trees can be written concurrently.
+  vtkNew<vtkIdTypeArray> treeIds;
+  treeIds->SetNumberOfValues(nbTrees);
+  vtkNew<vtkIdTypeArray> descriptorStarts;
+  descriptorStarts->SetNumberOfValues(nbTrees);
+  vtkNew<vtkIdTypeArray> descriptorSizes;
+  descriptorSizes->SetNumberOfValues(nbTrees);
+  std::vector<vtkIdType> vertexOffsets(nbTrees + 1, 0);
+  vtkIdType descriptorOffset = 0;
   for (vtkIdType itree = 0; itree < nbTrees; ++itree)
   {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    vtkIdType index = itree;
+    const vtkIdType descriptorSize = static_cast<vtkIdType>(trees[itree].Descriptor.size());
+    treeIds->SetValue(itree, itree);
+    descriptorStarts->SetValue(itree, descriptorOffset);
+    descriptorSizes->SetValue(itree, descriptorSize);
+    descriptorOffset += 8 * ((descriptorSize + 7) / 8);
+    vertexOffsets[itree + 1] =
+      vertexOffsets[itree] + static_cast<vtkIdType>(trees[itree].Values.size());
+  }
+  const vtkIdType nbVertices = vertexOffsets[nbTrees];
+
+  vtkNew<vtkBitArray> descriptors;
+  descriptors->SetNumberOfValues(descriptorOffset);
 
-    unsigned int i, j, k;
-    output->GetLevelZeroCoordinatesFromIndex(index, i, j, k);
+  vtkNew<vtkUnsignedCharArray> color;
+  color->SetName("Colors");
+  color->SetNumberOfComponents(3);
+  color->SetNumberOfTuples(nbVertices);
 
-    output->InitializeNonOrientedCursor(cursor, index, true);
+  vtkNew<vtkDoubleArray> depth;
+  depth->SetName("Depth");
+  depth->SetNumberOfComponents(1);
+  depth->SetNumberOfTuples(nbVertices);
 
-    vtkNew<vtkIntArray> pixels;
-    int nbPxl = pow(2, DepthMax);
-    pixels->SetNumberOfValues(nbPxl * nbPxl);
-    int id = 0;
-    unsigned char pas = 256 / this->NbColors;
-    for (int pj = 0; pj < nbPxl; ++pj)
+  vtkSMPTools::For(0, nbTrees, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType itree = begin; itree < end; ++itree)
     {
-      for (int pi = 0; pi < nbPxl; ++pi, ++id)
+      const TreeData& tree = trees[itree];
+      unsigned char* bits = descriptors->GetPointer(descriptorStarts->GetValue(itree));
+      std::fill_n(bits, (tree.Descriptor.size() + 7) / 8, 0);
+      for (std::size_t bit = 0; bit < tree.Descriptor.size(); ++bit)
       {
-        int x = i * nbPxl + pi;
-        int y = j * nbPxl + pj;
-        if (x < inSize[0] && y < inSize[1])
+        if (tree.Descriptor[bit])
         {
-          unsigned char* val = static_cast<unsigned char*>(input->GetScalarPointer(x, y, 0));
-          int grp = (val[0] / pas) + (val[1] / pas) * this->NbColors +
-            (val[2] / pas) * this->NbColors * this->NbColors;
-          pixels->SetValue(id, grp);
-        }
-        else
-        {
-          pixels->SetValue(id, -1);
+          bits[bit / 8] |= 0x80 >> (bit % 8);
         }
       }
+      vtkIdType globalId = vertexOffsets[itree];
+      for (const VertexData& vertex : tree.Values)
+      {
+        const int val = vertex.Value;
+        color->SetTypedComponent(globalId, 0, pas * (unsigned char)((val % car) % this->NbColors));
+        color->SetTypedComponent(globalId, 1, pas * (unsigned char)((val % car) / this->NbColors));
+        color->SetTypedComponent(globalId, 2, pas * (unsigned char)(val / car));
+        depth->SetValue(globalId, vertex.Depth);
+        ++globalId;
+      }
+    }
+  });
+
+  // A bit array cannot be written concurrently
+  vtkNew<vtkBitArray> mask;
+  mask->SetName("Mask");
+  mask->SetNumberOfComponents(1);
+  mask->SetNumberOfValues(nbVertices);
+  for (vtkIdType itree = 0; itree < nbTrees; ++itree)
+  {
+    vtkIdType globalId = vertexOffsets[itree];
+    for (const VertexData& vertex : trees[itree].Values)
+    {
+      mask->SetValue(globalId++, vertex.Value < 0);
     }
-    ProcessPixels(pixels, cursor);
   }
 
+  output->BuildTreesFromBreadthFirstOrderDescriptors(
+    treeIds, descriptors, descriptorStarts, descriptorSizes);
+  output->SetMask(mask);
+  this->OutData->AddArray(color);
+  this->OutData->AddArray(depth);
+
   // Update progress and return
   this->UpdateProgress(1.);
   return 1;
 }
 
+//------------------------------------------------------------------------------
 void vtkImageDataToHyperTreeGrid::ProcessPixels(
   vtkIntArray* grps, vtkHyperTreeGridNonOrientedCursor* cursor)
 {
+  vtkHyperTreeGrid* output = cursor->GetGrid();
+  vtkCellData* outData = output->GetCellData();
+  vtkUnsignedCharArray* color =
+    vtkArrayDownCast<vtkUnsignedCharArray>(outData->GetAbstractArray("Colors"));
+  if (!color)
+  {
+    vtkNew<vtkUnsignedCharArray> newColor;
+    newColor->SetName("Colors");
+    newColor->SetNumberOfComponents(3);
+    outData->AddArray(newColor);
+    color = newColor;
+  }
+  vtkDoubleArray* depth = vtkArrayDownCast<vtkDoubleArray>(outData->GetAbstractArray("Depth"));
+  if (!depth)
+  {
+    vtkNew<vtkDoubleArray> newDepth;
+    newDepth->SetName("Depth");
+    newDepth->SetNumberOfComponents(1);
+    outData->AddArray(newDepth);
+    depth = newDepth;
+  }
+  vtkBitArray* mask = output->GetMask();
+  if (!mask)
+  {
+    vtkNew<vtkBitArray> newMask;
+    newMask->SetName("Mask");
+    newMask->SetNumberOfComponents(1);
+    output->SetMask(newMask);
+    mask = newMask;
+  }
+
   int nbPixel = grps->GetNumberOfValues();
   int val = grps->GetTuple1(0);
   bool raf = false;
@@ -194,21 +371,16 @@ void vtkImageDataToHyperTreeGrid::ProcessPixels(
   int car = this->NbColors * this->NbColors;
   unsigned char pas = 256 / this->NbColors;
 
-  this->Color->InsertTuple3(this->GlobalId, pas * (unsigned char)((val % car) % this->NbColors),
+  // The vertices are numbered in the order they are processed
+  const vtkIdType globalId = depth->GetNumberOfTuples();
+  color->InsertTuple3(globalId, pas * (unsigned char)((val % car) % this->NbColors),
     pas * (unsigned char)((val % car) / this->NbColors), pas * (unsigned char)(val / car));
 
-  this->Depth->InsertTuple1(this->GlobalId, cursor->GetLevel());
+  depth->InsertTuple1(globalId, cursor->GetLevel());
 
-  if (val < 0)
-  {
-    this->Mask->InsertTuple1(this->GlobalId, true);
-  }
-  else
-  {
-    this->Mask->InsertTuple1(this->GlobalId, false);
-  }
+  mask->InsertTuple1(globalId, val < 0);
 
-  cursor->SetGlobalIndexFromLocal(this->GlobalId++);
+  cursor->SetGlobalIndexFromLocal(globalId);
   if (raf)
   {
     cursor->SubdivideLeaf();
@@ -231,7 +403,7 @@ void vtkImageDataToHyperTreeGrid::ProcessPixels(
             childPix->SetValue(id, grp);
           }
         }
-        ProcessPixels(childPix, cursor);
+        this->ProcessPixels(childPix, cursor);
 
         cursor->ToParent();
       }
@@ -17,16 +17,14 @@
 #ifndef vtkImageDataToHyperTreeGrid_h
 #define vtkImageDataToHyperTreeGrid_h
 
+#include "vtkDeprecation.h"            // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersHyperTreeModule.h" // For export macro
 #include "vtkHyperTreeGridAlgorithm.h"
 
 VTK_ABI_NAMESPACE_BEGIN
-class vtkBitArray;
-class vtkIntArray;
-class vtkUnsignedCharArray;
-class vtkDoubleArray;
 class vtkHyperTreeGrid;
 class vtkHyperTreeGridNonOrientedCursor;
+class vtkIntArray;
 
 class VTKFILTERSHYPERTREE_EXPORT vtkImageDataToHyperTreeGrid : public vtkHyperTreeGridAlgorithm
 {
@@ -49,6 +47,12 @@ protected:
 
   int ProcessTrees(vtkHyperTreeGrid*, vtkDataObject*) override;
 
+  /**
+   * Recursively subdivide the vertex of the cursor until its pixels all have
+   * the same group of colors. The colors, depth and mask of the vertices are
+   * appended to the arrays of the grid of the cursor.
+   */
+  VTK_DEPRECATED_IN_9_4_0("The trees are built from breadth first order descriptors.")
   void ProcessPixels(vtkIntArray*, vtkHyperTreeGridNonOrientedCursor*);
 
   int FillInputPortInformation(int, vtkInformation*) override;
@@ -62,11 +66,6 @@ private:
   int NbColors;
 
   vtkDataArray* InScalars;
-
-  vtkUnsignedCharArray* Color;
-  vtkDoubleArray* Depth;
-  vtkBitArray* Mask;
-  int GlobalId;
 };
 
 VTK_ABI_NAMESPACE_END
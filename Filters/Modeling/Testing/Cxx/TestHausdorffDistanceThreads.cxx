@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkHausdorffDistancePointSetFilter and vtkImplicitPolyDataDistance
+// compute the same distances with any number of threads.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkHausdorffDistancePointSetFilter.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestSMPUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+struct Distances
+{
+  vtkSmartPointer<vtkDataArray> Arrays[2];
+  double HausdorffDistance;
+};
+
+Distances Execute(vtkHausdorffDistancePointSetFilter* filter)
+{
+  filter->Modified();
+  filter->Update();
+  Distances distances;
+  for (int port = 0; port < 2; ++port)
+  {
+    distances.Arrays[port] = vtkSmartPointer<vtkDoubleArray>::New();
+    distances.Arrays[port]->DeepCopy(
+      vtkPointSet::SafeDownCast(filter->GetOutputDataObject(port))
+        ->GetPointData()
+        ->GetArray("Distance"));
+  }
+  distances.HausdorffDistance = filter->GetHausdorffDistance();
+  return distances;
+}
+
+// Compare the point to point distances with a brute force search
+bool CheckPointToPoint(vtkPointSet* source, vtkPointSet* target, vtkDataArray* distances)
+{
+  double x[3], y[3];
+  for (vtkIdType ptId = 0; ptId < source->GetNumberOfPoints(); ++ptId)
+  {
+    source->GetPoint(ptId, x);
+    double minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType targetId = 0; targetId < target->GetNumberOfPoints(); ++targetId)
+    {
+      target->GetPoint(targetId, y);
+      minDist2 = std::min(minDist2, vtkMath::Distance2BetweenPoints(x, y));
+    }
+    if (std::abs(distances->GetComponent(ptId, 0) - std::sqrt(minDist2)) > 1e-12)
+    {
+      std::cerr << "Wrong distance for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestHausdorffDistanceThreads(int, char*[])
+{
+  bool success = true;
+
+  vtkNew<vtkSphereSource> sphereA;
+  sphereA->SetThetaResolution(70);
+  sphereA->SetPhiResolution(50);
+  sphereA->Update();
+  vtkPolyData* surfaceA = sphereA->GetOutput();
+
+  vtkNew<vtkSphereSource> sphereB;
+  sphereB->SetThetaResolution(41);
+  sphereB->SetPhiResolution(37);
+  sphereB->SetRadius(0.55);
+  sphereB->SetCenter(0.1, -0.05, 0.02);
+  sphereB->Update();
+  vtkPolyData* surfaceB = sphereB->GetOutput();
+
+  vtkNew<vtkHausdorffDistancePointSetFilter> hausdorff;
+  hausdorff->SetInputData(0, surfaceA);
+  hausdorff->SetInputData(1, surfaceB);
+  for (int method : { vtkHausdorffDistancePointSetFilter::POINT_TO_POINT,
+         vtkHausdorffDistancePointSetFilter::POINT_TO_CELL })
+  {
+    hausdorff->SetTargetDistanceMethod(method);
+    Distances distances = Execute(hausdorff);
+    Distances singleThreaded = vtkTest::ExecuteOnOneThread([&]() { return Execute(hausdorff); });
+    if (distances.HausdorffDistance <= 0.0 ||
+      distances.HausdorffDistance != singleThreaded.HausdorffDistance ||
+      !vtkTest::SameArray(distances.Arrays[0], singleThreaded.Arrays[0]) ||
+      !vtkTest::SameArray(distances.Arrays[1], singleThreaded.Arrays[1]))
+    {
+      std::cerr << "The distances of vtkHausdorffDistancePointSetFilter with the method "
+                << hausdorff->GetTargetDistanceMethodAsString()
+                << " depend on the number of threads" << std::endl;
+      success = false;
+    }
+    if (method == vtkHausdorffDistancePointSetFilter::POINT_TO_POINT)
+    {
+      success &= CheckPointToPoint(surfaceA, surfaceB, distances.Arrays[0]);
+      success &= CheckPointToPoint(surfaceB, surfaceA, distances.Arrays[1]);
+    }
+  }
+
+  // Evaluate the signed distance to the first sphere on a grid of points,
+  // in parallel and serially.
+  vtkNew<vtkImplicitPolyDataDistance> implicitDistance;
+  implicitDistance->SetInput(surfaceA);
+  const int dim = 40;
+  const vtkIdType numPts = dim * dim * dim;
+  auto gridPoint = [](vtkIdType ptId, double x[3]) {
+    x[0] = -0.7 + 1.4 * (ptId % dim) / (dim - 1);
+    x[1] = -0.7 + 1.4 * ((ptId / dim) % dim) / (dim - 1);
+    x[2] = -0.7 + 1.4 * (ptId / (dim * dim)) / (dim - 1);
+  };
+  vtkNew<vtkDoubleArray> values;
+  values->SetNumberOfComponents(4);
+  values->SetNumberOfTuples(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3], value[4];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      gridPoint(ptId, x);
+      value[0] = implicitDistance->EvaluateFunction(x);
+      implicitDistance->EvaluateGradient(x, value + 1);
+      values->SetTuple(ptId, value);
+    }
+  });
+  int numInside = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3], value[4];
+    gridPoint(ptId, x);
+    value[0] = implicitDistance->EvaluateFunction(x);
+    implicitDistance->EvaluateGradient(x, value + 1);
+    for (int comp = 0; comp < 4; ++comp)
+    {
+      if (value[comp] != values->GetComponent(ptId, comp))
+      {
+        std::cerr << "The evaluation of vtkImplicitPolyDataDistance at point " << ptId
+                  << " depends on the number of threads" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    numInside += value[0] < 0.0 ? 1 : 0;
+  }
+  const double insideFraction = static_cast<double>(numInside) / numPts;
+  const double sphereFraction = 4.0 / 3.0 * vtkMath::Pi() * 0.125 / (1.4 * 1.4 * 1.4);
+  if (std::abs(insideFraction - sphereFraction) > 0.02)
+  {
+    std::cerr << "Wrong fraction of points inside the sphere: " << insideFraction
+              << " instead of " << sphereFraction << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkRibbonFilter generates the same output with any number of
+// threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkRibbonFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestSMPUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool CheckThreads(vtkPolyDataAlgorithm* filter, const char* description)
+{
+  if (!vtkTest::SamePolyDataOnOneThread(filter))
+  {
+    std::cerr << "The output of " << description << " depends on the number of threads"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Streamline-like polylines. Some of them are closed, and some share a
+// point with the previous one.
+vtkSmartPointer<vtkPolyData> MakeStreamlines()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkDoubleArray> lineData;
+  lineData->SetName("LineData");
+  std::vector<vtkIdType> ptIds;
+  for (int line = 0; line < 500; ++line)
+  {
+    ptIds.clear();
+    for (int i = 0; i < 20; ++i)
+    {
+      const double t = 0.1 * i;
+      ptIds.push_back(points->InsertNextPoint(
+        std::cos(t + line), std::sin(1.3 * t + line), t + 0.01 * line));
+      scalars->InsertNextValue(1.0 + std::sin(t * line));
+      vectors->InsertNextTuple3(1.0 + t, std::cos(line), 0.5);
+    }
+    if (line % 5 == 1)
+    {
+      ptIds.push_back(ptIds[0]);
+    }
+    if (line % 7 == 2)
+    {
+      ptIds[3] = ptIds[0] - 5;
+    }
+    lines->InsertNextCell(static_cast<vtkIdType>(ptIds.size()), ptIds.data());
+    lineData->InsertNextValue(line);
+  }
+
+  vtkSmartPointer<vtkPolyData> streamlines = vtkSmartPointer<vtkPolyData>::New();
+  streamlines->SetPoints(points);
+  streamlines->SetLines(lines);
+  streamlines->GetPointData()->SetScalars(scalars);
+  streamlines->GetPointData()->SetVectors(vectors);
+  streamlines->GetCellData()->AddArray(lineData);
+  return streamlines;
+}
+
+}
+
+int TestRibbonFilterThreads(int, char*[])
+{
+  bool success = true;
+
+  vtkSmartPointer<vtkPolyData> streamlines = MakeStreamlines();
+  vtkNew<vtkRibbonFilter> ribbons;
+  ribbons->SetInputData(streamlines);
+  ribbons->SetWidth(0.02);
+  ribbons->SetAngle(30.0);
+  for (int generateTCoords : { VTK_TCOORDS_OFF, VTK_TCOORDS_FROM_NORMALIZED_LENGTH,
+         VTK_TCOORDS_FROM_LENGTH, VTK_TCOORDS_FROM_SCALARS })
+  {
+    ribbons->SetGenerateTCoords(generateTCoords);
+    ribbons->SetVaryWidth(generateTCoords % 2);
+    ribbons->SetUseDefaultNormal(generateTCoords == VTK_TCOORDS_FROM_LENGTH);
+    success &= CheckThreads(ribbons, "vtkRibbonFilter");
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,14 +6,133 @@
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
-#include "vtkCellLocator.h"
 #include "vtkGenericCell.h"
-#include "vtkKdTreePointLocator.h"
 #include "vtkPointSet.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <cmath>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Compute the distance of the points of a point set to the closest point,
+// or to the closest cell, of another point set. The locators are thread safe
+// once built, so the points are processed in parallel.
+struct DistanceWorker
+{
+  vtkPointSet* Source;
+  vtkPointSet* Target;
+  vtkStaticPointLocator* PointLocator;
+  vtkStaticCellLocator* CellLocator;
+  vtkDoubleArray* Distances;
+  vtkHausdorffDistancePointSetFilter* Filter;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<double> LocalMaximum;
+  double Maximum;
+
+  DistanceWorker(vtkPointSet* source, vtkPointSet* target, vtkStaticPointLocator* pointLocator,
+    vtkStaticCellLocator* cellLocator, vtkDoubleArray* distances,
+    vtkHausdorffDistancePointSetFilter* filter)
+    : Source(source)
+    , Target(target)
+    , PointLocator(pointLocator)
+    , CellLocator(cellLocator)
+    , Distances(distances)
+    , Filter(filter)
+    , Maximum(0.0)
+  {
+  }
+
+  void Initialize() { this->LocalMaximum.Local() = 0.0; }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double& maximum = this->LocalMaximum.Local();
+    double* distances = this->Distances->GetPointer(0);
+    double currentPoint[3];
+    double closestPoint[3];
+    double dist2;
+    vtkIdType cellId;
+    int subId;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      this->Source->GetPoint(ptId, currentPoint);
+      if (this->PointLocator)
+      {
+        vtkIdType closestPointId = this->PointLocator->FindClosestPoint(currentPoint);
+        this->Target->GetPoint(closestPointId, closestPoint);
+      }
+      else
+      {
+        this->CellLocator->FindClosestPoint(
+          currentPoint, closestPoint, cell, cellId, subId, dist2);
+      }
+
+      const double dist = std::sqrt(vtkMath::Distance2BetweenPoints(currentPoint, closestPoint));
+      distances[ptId] = dist;
+      maximum = std::max(maximum, dist);
+    }
+  }
+
+  void Reduce()
+  {
+    for (const double& maximum : this->LocalMaximum)
+    {
+      this->Maximum = std::max(this->Maximum, maximum);
+    }
+  }
+};
+
+// Return the largest distance of the points of source to target
+double ComputeDistances(vtkPointSet* source, vtkPointSet* target, int targetDistanceMethod,
+  vtkDoubleArray* distances, vtkHausdorffDistancePointSetFilter* filter)
+{
+  vtkSmartPointer<vtkStaticPointLocator> pointLocator;
+  vtkSmartPointer<vtkStaticCellLocator> cellLocator;
+  if (targetDistanceMethod == vtkHausdorffDistancePointSetFilter::POINT_TO_POINT)
+  {
+    pointLocator = vtkSmartPointer<vtkStaticPointLocator>::New();
+    pointLocator->SetDataSet(target);
+    pointLocator->BuildLocator();
+  }
+  else
+  {
+    cellLocator = vtkSmartPointer<vtkStaticCellLocator>::New();
+    cellLocator->SetDataSet(target);
+    cellLocator->BuildLocator();
+  }
+
+  DistanceWorker worker(source, target, pointLocator, cellLocator, distances, filter);
+  vtkSMPTools::For(0, source->GetNumberOfPoints(), worker);
+  return worker.Maximum;
+}
+}
+VTK_ABI_NAMESPACE_END
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkHausdorffDistancePointSetFilter);
@@ -68,38 +187,6 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
   this->RelativeDistance[1] = 0.0;
   this->HausdorffDistance = 0.0;
 
-  // TODO: using vtkStaticCellLocator, vtkStaticPointLocator is going to be much faster.
-  // Need to investigate and replace if appropriate.
-  vtkSmartPointer<vtkKdTreePointLocator> pointLocatorA =
-    vtkSmartPointer<vtkKdTreePointLocator>::New();
-  vtkSmartPointer<vtkKdTreePointLocator> pointLocatorB =
-    vtkSmartPointer<vtkKdTreePointLocator>::New();
-
-  vtkSmartPointer<vtkCellLocator> cellLocatorA = vtkSmartPointer<vtkCellLocator>::New();
-  vtkSmartPointer<vtkCellLocator> cellLocatorB = vtkSmartPointer<vtkCellLocator>::New();
-
-  if (this->TargetDistanceMethod == POINT_TO_POINT)
-  {
-    pointLocatorA->SetDataSet(inputA);
-    pointLocatorA->BuildLocator();
-    pointLocatorB->SetDataSet(inputB);
-    pointLocatorB->BuildLocator();
-  }
-  else
-  {
-    cellLocatorA->SetDataSet(inputA);
-    cellLocatorA->BuildLocator();
-    cellLocatorB->SetDataSet(inputB);
-    cellLocatorB->BuildLocator();
-  }
-
-  double dist;
-  double currentPoint[3];
-  double closestPoint[3];
-  vtkIdType cellId;
-  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
-  int subId;
-
   vtkSmartPointer<vtkDoubleArray> distanceAToB = vtkSmartPointer<vtkDoubleArray>::New();
   distanceAToB->SetNumberOfComponents(1);
   distanceAToB->SetNumberOfTuples(inputA->GetNumberOfPoints());
@@ -110,63 +197,12 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
   distanceBToA->SetNumberOfTuples(inputB->GetNumberOfPoints());
   distanceBToA->SetName("Distance");
 
-  // Find the nearest neighbors to each point and add edges between them,
-  // if they do not already exist and they are not self loops
-  for (int i = 0; i < inputA->GetNumberOfPoints(); i++)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    inputA->GetPoint(i, currentPoint);
-    if (this->TargetDistanceMethod == POINT_TO_POINT)
-    {
-      vtkIdType closestPointId = pointLocatorB->FindClosestPoint(currentPoint);
-      inputB->GetPoint(closestPointId, closestPoint);
-    }
-    else
-    {
-      cellLocatorB->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist);
-    }
-
-    dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
-      std::pow(currentPoint[1] - closestPoint[1], 2) +
-      std::pow(currentPoint[2] - closestPoint[2], 2));
-    distanceAToB->SetValue(i, dist);
-
-    if (dist > this->RelativeDistance[0])
-    {
-      this->RelativeDistance[0] = dist;
-    }
-  }
-
-  for (int i = 0; i < inputB->GetNumberOfPoints(); i++)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    inputB->GetPoint(i, currentPoint);
-    if (this->TargetDistanceMethod == POINT_TO_POINT)
-    {
-      vtkIdType closestPointId = pointLocatorA->FindClosestPoint(currentPoint);
-      inputA->GetPoint(closestPointId, closestPoint);
-    }
-    else
-    {
-      cellLocatorA->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist);
-    }
-
-    dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
-      std::pow(currentPoint[1] - closestPoint[1], 2) +
-      std::pow(currentPoint[2] - closestPoint[2], 2));
-    distanceBToA->SetValue(i, dist);
-
-    if (dist > this->RelativeDistance[1])
-    {
-      this->RelativeDistance[1] = dist;
-    }
-  }
+  // Compute the distance of each point to the closest point or cell of the
+  // other input
+  this->RelativeDistance[0] =
+    ::ComputeDistances(inputA, inputB, this->TargetDistanceMethod, distanceAToB, this);
+  this->RelativeDistance[1] =
+    ::ComputeDistances(inputB, inputA, this->TargetDistanceMethod, distanceBToA, this);
 
   if (this->RelativeDistance[0] >= RelativeDistance[1])
   {
@@ -1,18 +1,37 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkRibbonFilter.h"
 
+#include "vtkArrayListTemplate.h"
+#include "vtkBatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -45,6 +64,402 @@ vtkRibbonFilter::vtkRibbonFilter()
 
 vtkRibbonFilter::~vtkRibbonFilter() = default;
 
+namespace
+{
+
+// The size of the ribbons generated by a batch of polylines. These are
+// turned into offsets once all the batches are counted.
+struct RibbonBatchData
+{
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfCells;
+
+  RibbonBatchData()
+    : NumberOfPoints(0)
+    , NumberOfCells(0)
+  {
+  }
+  ~RibbonBatchData() = default;
+  RibbonBatchData& operator+=(const RibbonBatchData& other)
+  {
+    this->NumberOfPoints += other.NumberOfPoints;
+    this->NumberOfCells += other.NumberOfCells;
+    return *this;
+  }
+  RibbonBatchData operator+(const RibbonBatchData& other) const
+  {
+    RibbonBatchData result = *this;
+    result += other;
+    return result;
+  }
+};
+using RibbonBatch = vtkBatch<RibbonBatchData>;
+using RibbonBatches = vtkBatches<RibbonBatchData>;
+
+// Per thread scratch space used to generate the ribbon of one polyline
+struct RibbonLocalData
+{
+  vtkSmartPointer<vtkIdList> CellIds;
+  // the polyline alone, to generate its normals independently
+  std::unordered_map<vtkIdType, vtkIdType> LinePointIds;
+  std::vector<vtkIdType> LineIds;
+  vtkSmartPointer<vtkPoints> LinePoints;
+  vtkSmartPointer<vtkCellArray> Line;
+  vtkSmartPointer<vtkFloatArray> LineNormals;
+  // for each point: the two points of the ribbon and their normal
+  std::vector<double> Frames;
+  // warnings of the polylines, reported once all the lines are processed
+  std::vector<std::pair<vtkIdType, std::string>> Warnings;
+};
+
+// Generates the ribbon of each polyline independently. A polyline of n
+// points generates 2n points and one triangle strip.
+struct RibbonGenerator
+{
+  vtkPoints* InPts;
+  vtkCellArray* InLines;
+  vtkDataArray* InNormals; // nullptr if the normals are generated
+  bool UseDefaultNormal;
+  double DefaultNormal[3];
+  vtkDataArray* InScalars;
+  double Range[2];
+  double Width;
+  bool VaryWidth;
+  double WidthFactor;
+  int GenerateTCoords;
+  double TextureLength;
+  double Theta;
+
+  // Compute the points of the ribbon of a polyline. Returns false if the
+  // polyline is not ribboned. The warnings are added to the given list, if
+  // any.
+  bool PrepareLine(vtkIdType lineId, vtkIdType& npts, const vtkIdType*& pts,
+    RibbonLocalData& local, std::vector<std::string>* warnings) const
+  {
+    if (!local.CellIds)
+    {
+      local.CellIds = vtkSmartPointer<vtkIdList>::New();
+      local.LinePoints = vtkSmartPointer<vtkPoints>::New();
+      local.LinePoints->SetDataType(this->InPts->GetDataType());
+      local.Line = vtkSmartPointer<vtkCellArray>::New();
+      local.LineNormals = vtkSmartPointer<vtkFloatArray>::New();
+      local.LineNormals->SetNumberOfComponents(3);
+    }
+
+    this->InLines->GetCellAtId(lineId, npts, pts, local.CellIds);
+    if (npts < 2)
+    {
+      if (warnings)
+      {
+        warnings->emplace_back("Less than two points in line!");
+      }
+      return false; // skip ribboning this polyline
+    }
+
+    // If necessary calculate normals, each polyline calculates its
+    // normals independently, avoiding conflicts at shared vertices.
+    if (!this->InNormals && !this->UseDefaultNormal)
+    {
+      // A polyline may visit a point more than once, e.g. when it is closed.
+      // Such a point gets a single normal, the last one generated.
+      double x[3];
+      local.LinePointIds.clear();
+      local.LineIds.resize(npts);
+      local.LinePoints->Reset();
+      local.Line->Reset();
+      local.Line->InsertNextCell(npts);
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        auto inserted = local.LinePointIds.emplace(pts[i], local.LinePoints->GetNumberOfPoints());
+        if (inserted.second)
+        {
+          this->InPts->GetPoint(pts[i], x);
+          local.LinePoints->InsertNextPoint(x);
+        }
+        local.LineIds[i] = inserted.first->second;
+        local.Line->InsertCellPoint(local.LineIds[i]);
+      }
+      local.LineNormals->SetNumberOfTuples(local.LinePoints->GetNumberOfPoints());
+      if (!vtkPolyLine::GenerateSlidingNormals(local.LinePoints, local.Line, local.LineNormals))
+      {
+        if (warnings)
+        {
+          warnings->emplace_back("No normals for line!");
+        }
+        return false; // skip ribboning this polyline
+      }
+    }
+
+    // Generate the points around the polyline. The strip is not created
+    // if the polyline is bad.
+    //
+    if (!this->ComputePoints(npts, pts, local, warnings))
+    {
+      if (warnings)
+      {
+        warnings->emplace_back("Could not generate points!");
+      }
+      return false; // skip ribboning this polyline
+    }
+    return true;
+  }
+
+  // Use "averaged" segment to create beveled effect.
+  // Watch out for first and last points.
+  bool ComputePoints(vtkIdType npts, const vtkIdType* pts, RibbonLocalData& local,
+    std::vector<std::string>* warnings) const
+  {
+    double p[3];
+    double pNext[3];
+    double sNext[3] = { 0, 0, 0 };
+    double sPrev[3];
+    double n[3];
+    double s[3], v[3];
+    double w[3];
+    double nP[3];
+    local.Frames.resize(9 * npts);
+
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      if (j == 0) // first point
+      {
+        this->InPts->GetPoint(pts[0], p);
+        this->InPts->GetPoint(pts[1], pNext);
+        for (int i = 0; i < 3; i++)
+        {
+          sNext[i] = pNext[i] - p[i];
+          sPrev[i] = sNext[i];
+        }
+      }
+      else if (j == (npts - 1)) // last point
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          sPrev[i] = sNext[i];
+          p[i] = pNext[i];
+        }
+      }
+      else
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          p[i] = pNext[i];
+        }
+        this->InPts->GetPoint(pts[j + 1], pNext);
+        for (int i = 0; i < 3; i++)
+        {
+          sPrev[i] = sNext[i];
+          sNext[i] = pNext[i] - p[i];
+        }
+      }
+
+      if (this->UseDefaultNormal)
+      {
+        std::copy_n(this->DefaultNormal, 3, n);
+      }
+      else if (this->InNormals)
+      {
+        this->InNormals->GetTuple(pts[j], n);
+      }
+      else
+      {
+        local.LineNormals->GetTuple(local.LineIds[j], n);
+      }
+
+      if (vtkMath::Normalize(sNext) == 0.0)
+      {
+        if (warnings)
+        {
+          warnings->emplace_back("Coincident points!");
+        }
+        return false;
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+        s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
+      }
+      // if s is zero then just use sPrev cross n
+      if (vtkMath::Normalize(s) == 0.0)
+      {
+        if (warnings)
+        {
+          warnings->emplace_back("Using alternate bevel vector");
+        }
+        vtkMath::Cross(sPrev, n, s);
+        if (vtkMath::Normalize(s) == 0.0 && warnings)
+        {
+          warnings->emplace_back("Using alternate bevel vector");
+        }
+      }
+
+      vtkMath::Cross(s, n, w);
+      if (vtkMath::Normalize(w) == 0.0)
+      {
+        if (warnings)
+        {
+          std::ostringstream message;
+          message << "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
+                  << " " << n[1] << " " << n[2];
+          warnings->push_back(message.str());
+        }
+        return false;
+      }
+
+      vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
+      vtkMath::Normalize(nP);
+
+      // Compute a scale factor based on scalars or vectors
+      double sFactor = 1.0;
+      if (this->InScalars && this->VaryWidth) // varying by scalar values
+      {
+        sFactor = 1.0 +
+          ((this->WidthFactor - 1.0) * (this->InScalars->GetComponent(pts[j], 0) - this->Range[0]) /
+            (this->Range[1] - this->Range[0]));
+      }
+
+      double* frame = local.Frames.data() + 9 * j;
+      for (int i = 0; i < 3; i++)
+      {
+        v[i] = (w[i] * cos(this->Theta) + nP[i] * sin(this->Theta));
+        frame[i] = p[i] - this->Width * sFactor * v[i];
+        frame[3 + i] = p[i] + this->Width * sFactor * v[i];
+        frame[6 + i] = nP[i];
+      }
+    } // for all points in polyline
+
+    return true;
+  }
+
+  // Write the points of the ribbon computed by PrepareLine()
+  void GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+    const RibbonLocalData& local, vtkPoints* newPts, vtkFloatArray* newNormals,
+    ArrayList& pointArrays) const
+  {
+    vtkIdType ptId = offset;
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      const double* frame = local.Frames.data() + 9 * j;
+      newPts->SetPoint(ptId, frame);
+      newNormals->SetTuple(ptId, frame + 6);
+      pointArrays.Copy(pts[j], ptId);
+      ptId++;
+      newPts->SetPoint(ptId, frame + 3);
+      newNormals->SetTuple(ptId, frame + 6);
+      pointArrays.Copy(pts[j], ptId);
+      ptId++;
+    }
+  }
+
+  void GenerateStrip(vtkIdType offset, vtkIdType npts, vtkIdType* outConnectivity) const
+  {
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      const vtkIdType idx = 2 * i;
+      *outConnectivity++ = offset + idx;
+      *outConnectivity++ = offset + idx + 1;
+    }
+  }
+
+  void GenerateTextureCoords(
+    vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkFloatArray* newTCoords) const
+  {
+    vtkIdType i;
+    int k;
+    double tc;
+
+    double s0, s;
+    // The first texture coordinate is always 0.
+    for (k = 0; k < 2; k++)
+    {
+      newTCoords->SetTuple2(offset + k, 0.0, 0.0);
+    }
+    if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && this->InScalars)
+    {
+      s0 = this->InScalars->GetTuple1(pts[0]);
+      for (i = 1; i < npts; i++)
+      {
+        s = this->InScalars->GetTuple1(pts[i]);
+        tc = (s - s0) / this->TextureLength;
+        for (k = 0; k < 2; k++)
+        {
+          newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
+        }
+      }
+    }
+    else if (this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH)
+    {
+      double xPrev[3], x[3], len = 0.0;
+      this->InPts->GetPoint(pts[0], xPrev);
+      for (i = 1; i < npts; i++)
+      {
+        this->InPts->GetPoint(pts[i], x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        tc = len / this->TextureLength;
+        for (k = 0; k < 2; k++)
+        {
+          newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
+        }
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
+      }
+    }
+    else if (this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+    {
+      double xPrev[3], x[3], length = 0.0, len = 0.0;
+      this->InPts->GetPoint(pts[0], xPrev);
+      for (i = 1; i < npts; i++)
+      {
+        this->InPts->GetPoint(pts[i], x);
+        length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
+      }
+
+      this->InPts->GetPoint(pts[0], xPrev);
+      for (i = 1; i < npts; i++)
+      {
+        this->InPts->GetPoint(pts[i], x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        tc = len / length;
+        for (k = 0; k < 2; k++)
+        {
+          newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
+        }
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
+      }
+    }
+  }
+};
+
+// A generator with the settings of the filter, used to generate the ribbon
+// of a single polyline with the deprecated helper methods.
+RibbonGenerator MakeGenerator(vtkRibbonFilter* self, double theta)
+{
+  RibbonGenerator generator;
+  generator.InPts = nullptr;
+  generator.InLines = nullptr;
+  generator.InNormals = nullptr;
+  generator.UseDefaultNormal = false;
+  self->GetDefaultNormal(generator.DefaultNormal);
+  generator.InScalars = nullptr;
+  generator.Range[0] = 0.0;
+  generator.Range[1] = 1.0;
+  generator.Width = self->GetWidth();
+  generator.VaryWidth = self->GetVaryWidth() != 0;
+  generator.WidthFactor = self->GetWidthFactor();
+  generator.GenerateTCoords = self->GetGenerateTCoords();
+  generator.TextureLength = self->GetTextureLength();
+  generator.Theta = theta;
+  return generator;
+}
+
+}
+
 int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
@@ -67,19 +482,7 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* inPts;
   vtkIdType numPts;
   vtkIdType numLines;
-  vtkIdType numNewPts, numNewCells;
-  vtkPoints* newPts;
-  int deleteNormals = 0;
-  vtkFloatArray* newNormals;
-  vtkIdType i;
-  double range[2];
-  vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType offset = 0;
-  vtkFloatArray* newTCoords = nullptr;
-  bool abort = false;
-  vtkIdType inCellId;
+  double range[2] = { 0.0, 1.0 };
 
   // Check input and initialize
   //
@@ -91,53 +494,26 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // Create the geometry and topology
-  numNewPts = 2 * numPts;
-  newPts = vtkPoints::New();
-  newPts->Allocate(numNewPts);
-  newNormals = vtkFloatArray::New();
-  newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
-  newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
-
-  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
-  outPD->CopyNormalsOff();
-  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    newTCoords = vtkFloatArray::New();
-    newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
-    outPD->CopyTCoordsOff();
-  }
-  outPD->CopyAllocate(pd, numNewPts);
-
-  int generateNormals = 0;
+  RibbonGenerator generator;
+  generator.InPts = inPts;
+  generator.InLines = inLines;
+  generator.InScalars = inScalars;
+  generator.Width = this->Width;
+  generator.VaryWidth = this->VaryWidth != 0;
+  generator.WidthFactor = this->WidthFactor;
+  generator.GenerateTCoords = this->GenerateTCoords;
+  generator.TextureLength = this->TextureLength;
+  generator.Theta = vtkMath::RadiansFromDegrees(this->Angle);
+  this->Theta = generator.Theta;
+
+  // Normals are either given, the default normal, or generated for each
+  // polyline. The default normal is stored as the float normals would be.
   inNormals = this->GetInputArrayToProcess(1, inputVector);
-  if (!inNormals || this->UseDefaultNormal)
+  generator.UseDefaultNormal = this->UseDefaultNormal != 0;
+  generator.InNormals = this->UseDefaultNormal ? nullptr : inNormals;
+  for (int i = 0; i < 3; i++)
   {
-    deleteNormals = 1;
-    inNormals = vtkFloatArray::New();
-    inNormals->SetNumberOfComponents(3);
-    inNormals->SetNumberOfTuples(numPts);
-
-    if (this->UseDefaultNormal)
-    {
-      for (i = 0; i < numPts; i++)
-      {
-        inNormals->SetTuple(i, this->DefaultNormal);
-      }
-    }
-    else
-    {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their ribbons) calculated independently
-      generateNormals = 1;
-    }
+    generator.DefaultNormal[i] = static_cast<float>(this->DefaultNormal[i]);
   }
 
   // If varying width, get appropriate info.
@@ -151,93 +527,181 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
       range[1] = range[0] + 1.0;
     }
   }
+  generator.Range[0] = range[0];
+  generator.Range[1] = range[1];
+
+  // First pass: compute the ribbons of the polylines and count the output
+  // of each batch of polylines. The polylines are processed again in the
+  // second pass, which avoids keeping all the ribbons in memory.
+  RibbonBatches batches;
+  batches.Initialize(numLines);
+  vtkSMPThreadLocal<RibbonLocalData> localData;
+  {
+    double x[3];
+    inPts->GetPoint(0, x); // for thread safety of GetPoint later on
+  }
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    RibbonLocalData& local = localData.Local();
+    std::vector<std::string> warnings;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      RibbonBatch& batch = batches[batchId];
+      for (vtkIdType lineId = batch.BeginId; lineId < batch.EndId; ++lineId)
+      {
+        warnings.clear();
+        if (generator.PrepareLine(lineId, npts, pts, local, &warnings))
+        {
+          batch.Data.NumberOfPoints += 2 * npts;
+          batch.Data.NumberOfCells++;
+        }
+        for (const std::string& warning : warnings)
+        {
+          local.Warnings.emplace_back(lineId, warning);
+        }
+      }
+    }
+  });
+
+  // Report the warnings of the polylines in order
+  std::vector<std::pair<vtkIdType, std::string>> warnings;
+  for (RibbonLocalData& local : localData)
+  {
+    warnings.insert(warnings.end(), local.Warnings.begin(), local.Warnings.end());
+    local.Warnings.clear();
+  }
+  using LineWarning = std::pair<vtkIdType, std::string>;
+  std::stable_sort(warnings.begin(), warnings.end(),
+    [](const LineWarning& warning0, const LineWarning& warning1) {
+      return warning0.first < warning1.first;
+    });
+  for (const auto& warning : warnings)
+  {
+    vtkWarningMacro(<< warning.second);
+  }
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+  const RibbonBatchData totals = batches.BuildOffsetsAndGetGlobalSum();
+  this->UpdateProgress(0.5);
+
+  // Create the geometry and topology
+  const vtkIdType numNewPts = totals.NumberOfPoints;
+  const vtkIdType numNewCells = totals.NumberOfCells;
+  vtkNew<vtkPoints> newPts;
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkFloatArray> newNormals;
+  newNormals->SetNumberOfComponents(3);
+  newNormals->SetNumberOfTuples(numNewPts);
+  // Each strip has two points per point of its polyline, so that its
+  // connectivity is the list of its points.
+  vtkNew<vtkIdTypeArray> newOffsets;
+  newOffsets->SetNumberOfValues(numNewCells + 1);
+  newOffsets->SetValue(numNewCells, numNewPts);
+  vtkNew<vtkIdTypeArray> newConnectivity;
+  newConnectivity->SetNumberOfValues(numNewPts);
+
+  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
+  vtkSmartPointer<vtkFloatArray> newTCoords;
+  outPD->CopyNormalsOff();
+  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  {
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(2);
+    newTCoords->SetNumberOfTuples(numNewPts);
+    outPD->CopyTCoordsOff();
+  }
+  outPD->CopyAllocate(pd, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
 
   // Copy selected parts of cell data; certainly don't want normals
   //
-  numNewCells = inLines->GetNumberOfCells();
   outCD->CopyNormalsOff();
   outCD->CopyAllocate(cd, numNewCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
 
-  //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
+  //  Second pass: create points along each polyline that are connected into
+  //  a triangle strip. Texture coordinates are optionally generated.
   //
-  this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
-  {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->CheckAbort();
-
-    if (npts < 2)
+  vtkIdType* outOffsets = newOffsets->GetPointer(0);
+  vtkIdType* outConnectivity = newConnectivity->GetPointer(0);
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    RibbonLocalData& local = localData.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
-    }
-
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+      if (isFirst)
       {
-        vtkWarningMacro(<< "No normals for line!");
-        continue; // skip tubing this polyline
+        this->CheckAbort();
       }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      const RibbonBatch& batch = batches[batchId];
+      vtkIdType offset = batch.Data.NumberOfPoints;
+      vtkIdType outCellId = batch.Data.NumberOfCells;
+      for (vtkIdType lineId = batch.BeginId; lineId < batch.EndId; ++lineId)
+      {
+        if (!generator.PrepareLine(lineId, npts, pts, local, nullptr))
+        {
+          continue; // skip ribboning this polyline
+        }
+
+        // Generate the points around the polyline.
+        generator.GeneratePoints(offset, npts, pts, local, newPts, newNormals, pointArrays);
+
+        // Generate the strip for this polyline
+        //
+        outOffsets[outCellId] = offset;
+        cellArrays.Copy(lineId, outCellId);
+        generator.GenerateStrip(offset, npts, outConnectivity + offset);
+        outCellId++;
+
+        // Generate the texture coordinates for this polyline
+        //
+        if (newTCoords)
+        {
+          generator.GenerateTextureCoords(offset, npts, pts, newTCoords);
+        }
+
+        // Compute the new offset for the next polyline
+        offset += 2 * npts;
+      } // for all polylines
     }
-
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
-    }
-
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
-
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
+  });
 
   // Update ourselves
   //
-  if (deleteNormals)
-  {
-    inNormals->Delete();
-  }
-
   if (newTCoords)
   {
     outPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
   output->SetPoints(newPts);
-  newPts->Delete();
 
+  vtkNew<vtkCellArray> newStrips;
+  newStrips->SetData(newOffsets, newConnectivity);
   output->SetStrips(newStrips);
-  newStrips->Delete();
 
   outPD->SetNormals(newNormals);
-  newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -248,131 +712,40 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
 {
-  vtkIdType j;
-  int i;
-  double p[3];
-  double pNext[3];
-  double sNext[3] = { 0, 0, 0 };
-  double sPrev[3];
-  double n[3];
-  double s[3], sp[3], sm[3], v[3];
-  // double bevelAngle;
-  double w[3];
-  double nP[3];
-  double sFactor = 1.0;
-  vtkIdType ptId = offset;
-
-  // Use "averaged" segment to create beveled effect.
-  // Watch out for first and last points.
-  //
-  for (j = 0; j < npts; j++)
+  RibbonGenerator generator = MakeGenerator(this, this->Theta);
+  generator.InPts = inPts;
+  generator.InNormals = inNormals;
+  generator.InScalars = inScalars;
+  generator.Range[0] = range[0];
+  generator.Range[1] = range[1];
+
+  RibbonLocalData local;
+  std::vector<std::string> warnings;
+  const bool computed = generator.ComputePoints(npts, pts, local, &warnings);
+  for (const std::string& warning : warnings)
   {
-    if (j == 0) // first point
-    {
-      inPts->GetPoint(pts[0], p);
-      inPts->GetPoint(pts[1], pNext);
-      for (i = 0; i < 3; i++)
-      {
-        sNext[i] = pNext[i] - p[i];
-        sPrev[i] = sNext[i];
-      }
-    }
-    else if (j == (npts - 1)) // last point
-    {
-      for (i = 0; i < 3; i++)
-      {
-        sPrev[i] = sNext[i];
-        p[i] = pNext[i];
-      }
-    }
-    else
-    {
-      for (i = 0; i < 3; i++)
-      {
-        p[i] = pNext[i];
-      }
-      inPts->GetPoint(pts[j + 1], pNext);
-      for (i = 0; i < 3; i++)
-      {
-        sPrev[i] = sNext[i];
-        sNext[i] = pNext[i] - p[i];
-      }
-    }
-
-    inNormals->GetTuple(pts[j], n);
-
-    if (vtkMath::Normalize(sNext) == 0.0)
-    {
-      vtkWarningMacro(<< "Coincident points!");
-      return 0;
-    }
-
-    for (i = 0; i < 3; i++)
-    {
-      s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
-    }
-    // if s is zero then just use sPrev cross n
-    if (vtkMath::Normalize(s) == 0.0)
-    {
-      vtkWarningMacro(<< "Using alternate bevel vector");
-      vtkMath::Cross(sPrev, n, s);
-      if (vtkMath::Normalize(s) == 0.0)
-      {
-        vtkWarningMacro(<< "Using alternate bevel vector");
-      }
-    }
-    /*
-        if ( (bevelAngle = vtkMath::Dot(sNext,sPrev)) > 1.0 )
-          {
-          bevelAngle = 1.0;
-          }
-        if ( bevelAngle < -1.0 )
-          {
-          bevelAngle = -1.0;
-          }
-        bevelAngle = acos((double)bevelAngle) / 2.0; //(0->90 degrees)
-        if ( (bevelAngle = cos(bevelAngle)) == 0.0 )
-          {
-          bevelAngle = 1.0;
-          }
-
-        bevelAngle = this->Width / bevelAngle; //keep ribbon constant width
-    */
-    vtkMath::Cross(s, n, w);
-    if (vtkMath::Normalize(w) == 0.0)
-    {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
-      return 0;
-    }
-
-    vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
-    vtkMath::Normalize(nP);
-
-    // Compute a scale factor based on scalars or vectors
-    if (inScalars && this->VaryWidth) // varying by scalar values
-    {
-      sFactor = 1.0 +
-        ((this->WidthFactor - 1.0) * (inScalars->GetComponent(pts[j], 0) - range[0]) /
-          (range[1] - range[0]));
-    }
-
-    for (i = 0; i < 3; i++)
-    {
-      v[i] = (w[i] * cos(this->Theta) + nP[i] * sin(this->Theta));
-      sp[i] = p[i] + this->Width * sFactor * v[i];
-      sm[i] = p[i] - this->Width * sFactor * v[i];
-    }
-    newPts->InsertPoint(ptId, sm);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
-    ptId++;
-    newPts->InsertPoint(ptId, sp);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
-    ptId++;
-  } // for all points in polyline
+    vtkWarningMacro(<< warning);
+  }
+  if (!computed)
+  {
+    return 0;
+  }
 
+  // Generate the ribbon alone, then insert it at the offset
+  vtkNew<vtkPoints> ribbonPts;
+  ribbonPts->SetDataType(VTK_DOUBLE);
+  ribbonPts->SetNumberOfPoints(2 * npts);
+  vtkNew<vtkFloatArray> ribbonNormals;
+  ribbonNormals->SetNumberOfComponents(3);
+  ribbonNormals->SetNumberOfTuples(2 * npts);
+  ArrayList noArrays;
+  generator.GeneratePoints(0, npts, pts, local, ribbonPts, ribbonNormals, noArrays);
+  for (vtkIdType i = 0; i < 2 * npts; i++)
+  {
+    newPts->InsertPoint(offset + i, ribbonPts->GetPoint(i));
+    newNormals->InsertTuple(offset + i, ribbonNormals->GetTuple(i));
+    outPD->CopyData(pd, pts[i / 2], offset + i);
+  }
   return 1;
 }
 
@@ -380,97 +753,32 @@ void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
   const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
   vtkCellArray* newStrips)
 {
-  vtkIdType i, idx, outCellId;
-
-  outCellId = newStrips->InsertNextCell(npts * 2);
+  std::vector<vtkIdType> connectivity(2 * npts);
+  MakeGenerator(this, this->Theta).GenerateStrip(offset, npts, connectivity.data());
+  const vtkIdType outCellId = newStrips->InsertNextCell(2 * npts, connectivity.data());
   outCD->CopyData(cd, inCellId, outCellId);
-  for (i = 0; i < npts; i++)
-  {
-    idx = 2 * i;
-    newStrips->InsertCellPoint(offset + idx);
-    newStrips->InsertCellPoint(offset + idx + 1);
-  }
 }
 
 void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords)
 {
-  vtkIdType i;
-  int k;
-  double tc;
-
-  double s0, s;
-  // The first texture coordinate is always 0.
-  for (k = 0; k < 2; k++)
-  {
-    newTCoords->InsertTuple2(offset + k, 0.0, 0.0);
-  }
-  if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
+  RibbonGenerator generator = MakeGenerator(this, this->Theta);
+  generator.InPts = inPts;
+  generator.InScalars = inScalars;
+  vtkNew<vtkFloatArray> ribbonTCoords;
+  ribbonTCoords->SetNumberOfComponents(2);
+  ribbonTCoords->SetNumberOfTuples(2 * npts);
+  ribbonTCoords->FillValue(0.0f);
+  generator.GenerateTextureCoords(0, npts, pts, ribbonTCoords);
+  for (vtkIdType i = 0; i < 2 * npts; i++)
   {
-    s0 = inScalars->GetTuple1(pts[0]);
-    for (i = 1; i < npts; i++)
-    {
-      s = inScalars->GetTuple1(pts[i]);
-      tc = (s - s0) / this->TextureLength;
-      for (k = 0; k < 2; k++)
-      {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
-      }
-    }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH)
-  {
-    double xPrev[3], x[3], len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 1; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / this->TextureLength;
-      for (k = 0; k < 2; k++)
-      {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
-      }
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    double xPrev[3], x[3], length = 0.0, len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 1; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 1; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / length;
-      for (k = 0; k < 2; k++)
-      {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
-      }
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
+    newTCoords->InsertTuple(offset + i, ribbonTCoords->GetTuple(i));
   }
 }
 
-// Compute the number of points in this ribbon
 vtkIdType vtkRibbonFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
 {
-  offset += 2 * npts;
-  return offset;
+  return offset + 2 * npts;
 }
 
 // Description:
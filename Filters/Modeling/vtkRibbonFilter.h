@@ -17,6 +17,12 @@
  * can be removed with vtkCleanPolyData.) If a line does not meet this
  * criteria, then that line is not tubed.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The polylines are
+ * processed independently, and the output is the same with any number of
+ * threads. Using TBB or other non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkTubeFilter
  */
@@ -24,6 +30,7 @@
 #ifndef vtkRibbonFilter_h
 #define vtkRibbonFilter_h
 
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersModelingModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
@@ -150,18 +157,23 @@ protected:
   int GenerateTCoords;  // control texture coordinate generation
   double TextureLength; // this length is mapped to [0,1) texture space
 
-  // Helper methods
+  // Helper methods, which generate the ribbon of a single polyline
+  VTK_DEPRECATED_IN_9_4_0("The polylines are ribboned concurrently by RequestData.")
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals);
+  VTK_DEPRECATED_IN_9_4_0("The polylines are ribboned concurrently by RequestData.")
   void GenerateStrip(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
+  VTK_DEPRECATED_IN_9_4_0("The polylines are ribboned concurrently by RequestData.")
   void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
+  VTK_DEPRECATED_IN_9_4_0("The polylines are ribboned concurrently by RequestData.")
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
   // Helper data members
-  double Theta;
+  VTK_DEPRECATED_IN_9_4_0("Only used by the deprecated helper methods.")
+  double Theta = 0.0;
 
 private:
   vtkRibbonFilter(const vtkRibbonFilter&) = delete;
@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkSMPDelaunay2D gives the same triangles as vtkDelaunay2D
+// with tiles, with constraint polygons, projection planes and degenerate
+// points.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPDelaunay2D.h"
+#include "vtkSmartPointer.h"
+#include "vtkTransform.h"
+#include "vtkTriangle.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+namespace
+{
+using TriangleSet = std::set<std::array<vtkIdType, 3>>;
+
+// The triangles using input points only
+TriangleSet GetTriangles(vtkPolyData* polyData, vtkIdType numPoints)
+{
+  TriangleSet triangles;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = polyData->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    std::array<vtkIdType, 3> triangle{ { pts[0], pts[1], pts[2] } };
+    std::sort(triangle.begin(), triangle.end());
+    if (triangle[2] < numPoints)
+    {
+      triangles.insert(triangle);
+    }
+  }
+  return triangles;
+}
+
+// Area of the projection of the triangles on the xy plane.
+double GetArea(vtkPolyData* polyData)
+{
+  double area = 0.0;
+  double x[3][3];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = polyData->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      polyData->GetPoint(pts[i], x[i]);
+      x[i][2] = 0.0;
+    }
+    area += vtkTriangle::TriangleArea(x[0], x[1], x[2]);
+  }
+  return area;
+}
+
+vtkSmartPointer<vtkPolyData> Triangulate(vtkDelaunay2D* delaunay, vtkPolyData* input)
+{
+  delaunay->SetInputData(input);
+  delaunay->Update();
+  return delaunay->GetOutput();
+}
+
+bool SameTriangles(vtkDelaunay2D* serial, vtkDelaunay2D* parallel, vtkPolyData* input)
+{
+  vtkSmartPointer<vtkPolyData> expected = Triangulate(serial, input);
+  vtkSmartPointer<vtkPolyData> actual = Triangulate(parallel, input);
+  const vtkIdType numPoints = input->GetNumberOfPoints();
+  const TriangleSet expectedTriangles = GetTriangles(expected, numPoints);
+  return !expectedTriangles.empty() && expectedTriangles == GetTriangles(actual, numPoints) &&
+    expected->GetNumberOfPolys() == actual->GetNumberOfPolys() &&
+    expected->GetNumberOfLines() == actual->GetNumberOfLines() &&
+    expected->GetNumberOfVerts() == actual->GetNumberOfVerts() &&
+    expected->GetNumberOfPoints() == actual->GetNumberOfPoints();
+}
+
+// Add a square loop of points to points and cells, counterclockwise or not.
+void AddLoop(vtkPoints* points, vtkCellArray* cells, double min, double max, bool counterClockwise)
+{
+  const int numPerSide = 40;
+  const double corners[5][2] = { { min, min }, { max, min }, { max, max }, { min, max },
+    { min, min } };
+  cells->InsertNextCell(4 * numPerSide);
+  for (int side = 0; side < 4; ++side)
+  {
+    for (int i = 0; i < numPerSide; ++i)
+    {
+      const int s = counterClockwise ? side : 3 - side;
+      const double t = counterClockwise ? i / static_cast<double>(numPerSide)
+                                        : 1.0 - i / static_cast<double>(numPerSide);
+      const double* a = corners[s];
+      const double* b = corners[s + 1];
+      cells->InsertCellPoint(points->InsertNextPoint(
+        a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]), 0.0));
+    }
+  }
+}
+}
+
+int TestSMPDelaunay2D(int, char*[])
+{
+  // Random terrain points, and a few duplicates of them
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  for (int i = 0; i < 20000; ++i)
+  {
+    random->Next();
+    const double x = random->GetValue();
+    random->Next();
+    const double y = random->GetValue();
+    points->InsertNextPoint(x, y, 0.1 * std::sin(10.0 * x) * std::cos(10.0 * y));
+  }
+  vtkNew<vtkPolyData> uniqueCloud;
+  uniqueCloud->SetPoints(points);
+  vtkNew<vtkPoints> duplicatedPoints;
+  duplicatedPoints->DeepCopy(points);
+  for (vtkIdType i = 0; i < 20000; i += 500)
+  {
+    duplicatedPoints->InsertNextPoint(points->GetPoint(i));
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(duplicatedPoints);
+
+  vtkNew<vtkDelaunay2D> serial;
+  vtkNew<vtkSMPDelaunay2D> parallel;
+  parallel->SetNumberOfPartitions(4);
+
+  int status = EXIT_SUCCESS;
+  for (bool boundingTriangulation : { false, true })
+  {
+    for (double alpha : { 0.0, 0.02 })
+    {
+      serial->SetAlpha(alpha);
+      serial->SetBoundingTriangulation(boundingTriangulation);
+      parallel->SetAlpha(alpha);
+      parallel->SetBoundingTriangulation(boundingTriangulation);
+      if (!SameTriangles(serial, parallel, cloud))
+      {
+        std::cerr << "Triangles differ with alpha " << alpha << " and bounding triangulation "
+                  << boundingTriangulation << std::endl;
+        status = EXIT_FAILURE;
+      }
+      if (parallel->GetNumberOfPartitionsUsed() != 4)
+      {
+        std::cerr << "Random points triangulated with " << parallel->GetNumberOfPartitionsUsed()
+                  << " tiles instead of 4" << std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  serial->SetAlpha(0.0);
+  serial->BoundingTriangulationOff();
+  parallel->SetAlpha(0.0);
+  parallel->BoundingTriangulationOff();
+
+  // The insertion order changes a few triangles of nearly cocircular points,
+  // even with vtkDelaunay2D alone, but not how the points are covered.
+  serial->RandomPointInsertionOn();
+  parallel->RandomPointInsertionOn();
+  vtkSmartPointer<vtkPolyData> expected = Triangulate(serial, uniqueCloud);
+  vtkSmartPointer<vtkPolyData> actual = Triangulate(parallel, uniqueCloud);
+  if (expected->GetNumberOfPolys() != actual->GetNumberOfPolys() ||
+    std::abs(GetArea(expected) - GetArea(actual)) > 1e-9)
+  {
+    std::cerr << "Triangles differ with random point insertion" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  serial->RandomPointInsertionOff();
+  parallel->RandomPointInsertionOff();
+
+  // The same points on a tilted plane
+  vtkNew<vtkTransform> tilt;
+  tilt->RotateX(30.0);
+  tilt->RotateY(20.0);
+  vtkNew<vtkPoints> tiltedPoints;
+  tilt->TransformPoints(points, tiltedPoints);
+  vtkNew<vtkPolyData> tiltedCloud;
+  tiltedCloud->SetPoints(tiltedPoints);
+  serial->SetProjectionPlaneMode(VTK_BEST_FITTING_PLANE);
+  parallel->SetProjectionPlaneMode(VTK_BEST_FITTING_PLANE);
+  if (!SameTriangles(serial, parallel, tiltedCloud))
+  {
+    std::cerr << "Triangles differ with the best fitting plane" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  serial->SetProjectionPlaneMode(VTK_DELAUNAY_XY_PLANE);
+  parallel->SetProjectionPlaneMode(VTK_DELAUNAY_XY_PLANE);
+
+  // A constrained triangulation: an outer loop and a hole
+  vtkNew<vtkPoints> constrainedPoints;
+  constrainedPoints->DeepCopy(points);
+  vtkNew<vtkCellArray> loops;
+  AddLoop(constrainedPoints, loops, 0.05, 0.95, true);
+  AddLoop(constrainedPoints, loops, 0.4, 0.6, false);
+  vtkNew<vtkPolyData> constrainedCloud;
+  constrainedCloud->SetPoints(constrainedPoints);
+  vtkNew<vtkPolyData> constraints;
+  constraints->SetPoints(constrainedPoints);
+  constraints->SetPolys(loops);
+  serial->SetSourceData(constraints);
+  parallel->SetSourceData(constraints);
+  const double area = GetArea(Triangulate(parallel, constrainedCloud));
+  if (std::abs(area - 0.77) > 1e-3 ||
+    std::abs(area - GetArea(Triangulate(serial, constrainedCloud))) > 1e-9)
+  {
+    std::cerr << "Unexpected area " << area << " for constrained triangulation" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  if (parallel->GetNumberOfPartitionsUsed() != 4)
+  {
+    std::cerr << "Constrained triangulation used " << parallel->GetNumberOfPartitionsUsed()
+              << " tiles instead of 4" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  serial->SetSourceData(nullptr);
+  parallel->SetSourceData(nullptr);
+
+  // Points on a grid have many valid triangulations, all filling the grid
+  // bounds.
+  vtkNew<vtkPoints> grid;
+  for (int j = 0; j < 100; ++j)
+  {
+    for (int i = 0; i < 100; ++i)
+    {
+      grid->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  cloud->SetPoints(grid);
+  const double gridArea = GetArea(Triangulate(parallel, cloud));
+  if (std::abs(gridArea - GetArea(Triangulate(serial, cloud))) > 1e-6 * gridArea)
+  {
+    std::cerr << "Unexpected area " << gridArea << " for grid points" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
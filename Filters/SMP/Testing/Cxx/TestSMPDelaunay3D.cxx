@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkSMPDelaunay3D gives the same tetrahedra as vtkDelaunay3D
+// with partitions, and falls back to it for degenerate points.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPDelaunay3D.h"
+#include "vtkSmartPointer.h"
+#include "vtkTetra.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+namespace
+{
+using TetraSet = std::set<std::array<vtkIdType, 4>>;
+
+TetraSet GetTetras(vtkUnstructuredGrid* grid)
+{
+  TetraSet tetras;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    if (grid->GetCellType(cellId) == VTK_TETRA)
+    {
+      grid->GetCellPoints(cellId, npts, pts);
+      std::array<vtkIdType, 4> tetra{ { pts[0], pts[1], pts[2], pts[3] } };
+      std::sort(tetra.begin(), tetra.end());
+      tetras.insert(tetra);
+    }
+  }
+  return tetras;
+}
+
+double GetVolume(vtkUnstructuredGrid* grid)
+{
+  double volume = 0.0;
+  double x[4][3];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, npts, pts);
+    for (int i = 0; i < 4; ++i)
+    {
+      grid->GetPoint(pts[i], x[i]);
+    }
+    volume += std::abs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]));
+  }
+  return volume;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Triangulate(
+  vtkDelaunay3D* delaunay, vtkPolyData* input, double alpha, bool boundingTriangulation)
+{
+  delaunay->SetInputData(input);
+  delaunay->SetAlpha(alpha);
+  delaunay->SetBoundingTriangulation(boundingTriangulation);
+  delaunay->Update();
+  return delaunay->GetOutput();
+}
+}
+
+int TestSMPDelaunay3D(int, char*[])
+{
+  // Random points, a few of them duplicated
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  for (int i = 0; i < 6000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetValue();
+    }
+    points->InsertNextPoint(x);
+    if (i % 500 == 499)
+    {
+      points->InsertNextPoint(points->GetPoint(i / 2));
+    }
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkDelaunay3D> serial;
+  vtkNew<vtkSMPDelaunay3D> parallel;
+  parallel->SetNumberOfPartitions(4);
+
+  int status = EXIT_SUCCESS;
+  for (bool boundingTriangulation : { false, true })
+  {
+    for (double alpha : { 0.0, 0.08 })
+    {
+      vtkSmartPointer<vtkUnstructuredGrid> expected =
+        Triangulate(serial, cloud, alpha, boundingTriangulation);
+      vtkSmartPointer<vtkUnstructuredGrid> actual =
+        Triangulate(parallel, cloud, alpha, boundingTriangulation);
+      const TetraSet expectedTetras = GetTetras(expected);
+      if (expectedTetras.empty() || expectedTetras != GetTetras(actual) ||
+        expected->GetNumberOfPoints() != actual->GetNumberOfPoints())
+      {
+        std::cerr << "Tetrahedra differ with alpha " << alpha << " and bounding triangulation "
+                  << boundingTriangulation << std::endl;
+        status = EXIT_FAILURE;
+      }
+      if (parallel->GetNumberOfPartitionsUsed() != 4)
+      {
+        std::cerr << "Random points triangulated with " << parallel->GetNumberOfPartitionsUsed()
+                  << " partitions instead of 4" << std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Points on a lattice have many valid triangulations, all filling the
+  // lattice bounds.
+  vtkNew<vtkPoints> lattice;
+  for (int k = 0; k < 20; ++k)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      for (int i = 0; i < 20; ++i)
+      {
+        lattice->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  cloud->SetPoints(lattice);
+  const double volume = GetVolume(Triangulate(parallel, cloud, 0.0, false));
+  if (std::abs(volume - GetVolume(Triangulate(serial, cloud, 0.0, false))) > 1e-6 * volume)
+  {
+    std::cerr << "Unexpected volume " << volume << " for lattice points" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkSMPQuadricDecimation reaches the target reduction with an
+// error close to the one of vtkQuadricDecimation, independently of the number
+// of threads.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSMPQuadricDecimation.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestSMPUtilities.h"
+#include "vtkTriangle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+double Height(double x, double y)
+{
+  return 0.1 * std::sin(6.0 * x) * std::cos(6.0 * y);
+}
+
+// A triangulated height field over the unit square, with its height as
+// scalars
+vtkSmartPointer<vtkPolyData> MakeHeightField(int resolution)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  vtkNew<vtkDoubleArray> heights;
+  heights->SetName("Height");
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      const double x = i / (resolution - 1.0);
+      const double y = j / (resolution - 1.0);
+      points->InsertNextPoint(x, y, Height(x, y));
+      heights->InsertNextValue(Height(x, y));
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < resolution - 1; ++j)
+  {
+    for (int i = 0; i < resolution - 1; ++i)
+    {
+      const vtkIdType p0 = i + j * resolution;
+      const vtkIdType p1 = p0 + 1;
+      const vtkIdType p2 = p0 + resolution;
+      const vtkIdType p3 = p2 + 1;
+      const vtkIdType tri0[3] = { p0, p1, p3 };
+      const vtkIdType tri1[3] = { p0, p3, p2 };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+    }
+  }
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->SetPoints(points);
+  mesh->SetPolys(polys);
+  mesh->GetPointData()->SetScalars(heights);
+  return mesh;
+}
+
+vtkSmartPointer<vtkPolyData> Decimate(vtkQuadricDecimation* decimation, vtkPolyData* input)
+{
+  decimation->SetInputData(input);
+  decimation->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->DeepCopy(decimation->GetOutput());
+  return output;
+}
+
+// The largest distance of the points to the height field
+double GetError(vtkPolyData* polyData)
+{
+  double error = 0.0;
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < polyData->GetNumberOfPoints(); ++ptId)
+  {
+    polyData->GetPoint(ptId, x);
+    error = std::max(error, std::abs(x[2] - Height(x[0], x[1])));
+  }
+  return error;
+}
+
+double GetArea(vtkPolyData* polyData)
+{
+  double area = 0.0;
+  double x[3][3];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = polyData->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      polyData->GetPoint(pts[i], x[i]);
+    }
+    area += vtkTriangle::TriangleArea(x[0], x[1], x[2]);
+  }
+  return area;
+}
+
+// Whether the output only has triangles of three distinct points
+bool HasValidTriangles(vtkPolyData* polyData)
+{
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = polyData->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] || pts[2] == pts[0])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSMPQuadricDecimation(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = MakeHeightField(100);
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  const double inputArea = GetArea(input);
+
+  vtkNew<vtkQuadricDecimation> serial;
+  vtkNew<vtkSMPQuadricDecimation> parallel;
+  int status = EXIT_SUCCESS;
+
+  for (double targetReduction : { 0.5, 0.9 })
+  {
+    serial->SetTargetReduction(targetReduction);
+    parallel->SetTargetReduction(targetReduction);
+    vtkSmartPointer<vtkPolyData> expected = Decimate(serial, input);
+    vtkSmartPointer<vtkPolyData> actual = Decimate(parallel, input);
+
+    const double reduction = parallel->GetActualReduction();
+    const vtkIdType numDeleted = static_cast<vtkIdType>(std::round(reduction * numTris));
+    if (reduction < targetReduction || reduction > targetReduction + 0.01 ||
+      actual->GetNumberOfPolys() != numTris - numDeleted)
+    {
+      std::cerr << "Unexpected reduction " << reduction << " for target " << targetReduction
+                << " with " << actual->GetNumberOfPolys() << " triangles" << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (!HasValidTriangles(actual))
+    {
+      std::cerr << "Invalid triangles for target " << targetReduction << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // The error is close to the one of the serial algorithm, and the
+    // boundary constraints keep the area of the square.
+    const double error = GetError(actual);
+    const double expectedError = GetError(expected);
+    if (error > 2.0 * expectedError + 1e-3)
+    {
+      std::cerr << "Error " << error << " against " << expectedError << " for target "
+                << targetReduction << std::endl;
+      status = EXIT_FAILURE;
+    }
+    const double area = GetArea(actual);
+    if (std::abs(area - inputArea) > 0.05 * inputArea)
+    {
+      std::cerr << "Area " << area << " against " << inputArea << " for target "
+                << targetReduction << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // The same mesh on a single thread
+    parallel->Modified();
+    vtkSmartPointer<vtkPolyData> singleThreaded =
+      vtkTest::ExecuteOnOneThread([&]() { return Decimate(parallel, input); });
+    if (!vtkTest::SamePolyData(actual, singleThreaded))
+    {
+      std::cerr << "The output depends on the number of threads for target " << targetReduction
+                << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  // Attributes in the error metric are interpolated along the edges
+  parallel->SetTargetReduction(0.8);
+  parallel->AttributeErrorMetricOn();
+  parallel->VolumePreservationOn();
+  vtkSmartPointer<vtkPolyData> withAttributes = Decimate(parallel, input);
+  vtkDataArray* heights = withAttributes->GetPointData()->GetScalars();
+  double inputRange[2], range[2] = { 0.0, 0.0 };
+  input->GetPointData()->GetScalars()->GetRange(inputRange);
+  if (heights)
+  {
+    heights->GetRange(range);
+  }
+  if (!heights || heights->GetNumberOfTuples() != withAttributes->GetNumberOfPoints() ||
+    range[0] < inputRange[0] - 1e-9 || range[1] > inputRange[1] + 1e-9 ||
+    parallel->GetActualReduction() < 0.8 || !HasValidTriangles(withAttributes))
+  {
+    std::cerr << "Unexpected decimation with attributes" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // No reduction leaves the mesh unchanged
+  parallel->AttributeErrorMetricOff();
+  parallel->VolumePreservationOff();
+  parallel->SetTargetReduction(0.0);
+  if (Decimate(parallel, input)->GetNumberOfPolys() != numTris)
+  {
+    std::cerr << "Triangles removed without reduction" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
@@ -0,0 +1,584 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSMPDelaunay2D.h"
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator2D.h"
+#include "vtkTriangle.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkSMPDelaunay2D);
+
+//------------------------------------------------------------------------------
+vtkSMPDelaunay2D::vtkSMPDelaunay2D()
+{
+  this->NumberOfPartitions = 0;
+  this->NumberOfPartitionsUsed = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPDelaunay2D::~vtkSMPDelaunay2D() = default;
+
+//------------------------------------------------------------------------------
+namespace
+{
+// Partitions smaller than this are not worth triangulating separately.
+constexpr vtkIdType VTK_MINIMUM_PARTITION_SIZE = 1000;
+
+// A tile of the points and what its triangulation contributes to the whole
+// one.
+struct vtkDelaunayPartition
+{
+  std::vector<vtkIdType> Ids; // point ids, in increasing order
+  double Bounds[4];           // 2D bounds of the tile
+  double Region[4];           // bounds extended beyond the outer sides
+  std::vector<vtkIdType> FinalTriangles; // 3 point ids per triangle
+  std::vector<vtkIdType> BorderEdges;    // 2 point ids and the opposite one
+};
+
+// An edge of a triangle, with sorted ids, and the triangle vertex opposite
+// to it.
+struct vtkDelaunayEdge
+{
+  std::array<vtkIdType, 2> Ids;
+  vtkIdType Opposite;
+
+  vtkDelaunayEdge(vtkIdType p1, vtkIdType p2, vtkIdType opposite)
+    : Ids{ { std::min(p1, p2), std::max(p1, p2) } }
+    , Opposite(opposite)
+  {
+  }
+
+  bool operator<(const vtkDelaunayEdge& other) const { return this->Ids < other.Ids; }
+};
+
+//------------------------------------------------------------------------------
+const double* vtkDelaunayCoordinates(vtkPoints* points)
+{
+  return static_cast<vtkDoubleArray*>(points->GetData())->GetPointer(0);
+}
+
+//------------------------------------------------------------------------------
+// A triangle whose circumcircle is strictly inside the region of its
+// partition cannot have points of other partitions in its circumcircle.
+// vtkDelaunay2D considers that circles larger than the bounding points
+// contain any point, so such triangles are never final. The ids are sorted
+// so that the partition and the stitching triangulations agree.
+bool vtkDelaunayIsFinal(
+  const double* x, const vtkIdType pts[3], const double region[4], double boundingRadius2)
+{
+  vtkIdType ids[3] = { pts[0], pts[1], pts[2] };
+  std::sort(ids, ids + 3);
+  double center[2];
+  const double radius2 =
+    vtkTriangle::Circumcircle(x + 3 * ids[0], x + 3 * ids[1], x + 3 * ids[2], center);
+  if (radius2 > boundingRadius2)
+  {
+    return false;
+  }
+  const double radius = std::sqrt(radius2);
+  for (int i = 0; i < 2; ++i)
+  {
+    if (center[i] - radius <= region[2 * i] || center[i] + radius >= region[2 * i + 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Keep the triangles of a partition whose circumcircle is inside the
+// partition region, the edges separating them from the other ones, and mark
+// the vertices of the other ones as border points.
+void vtkDelaunayCollectPartition(vtkDelaunayPartition& partition, vtkPolyData* mesh,
+  double boundingRadius2, std::vector<unsigned char>& border)
+{
+  const std::vector<vtkIdType>& ids = partition.Ids;
+  const auto numIds = static_cast<vtkIdType>(ids.size());
+  const double* x = vtkDelaunayCoordinates(mesh->GetPoints());
+  const vtkIdType numTriangles = mesh->GetNumberOfCells();
+
+  std::vector<unsigned char> isFinal(numTriangles, 0);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType triId = 0; triId < numTriangles; ++triId)
+  {
+    mesh->GetCellPoints(triId, npts, pts);
+    isFinal[triId] = std::all_of(pts, pts + 3, [numIds](vtkIdType p) { return p < numIds; }) &&
+      vtkDelaunayIsFinal(x, pts, partition.Region, boundingRadius2);
+  }
+
+  vtkNew<vtkIdList> neighbors;
+  for (vtkIdType triId = 0; triId < numTriangles; ++triId)
+  {
+    mesh->GetCellPoints(triId, npts, pts);
+    if (isFinal[triId])
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        partition.FinalTriangles.push_back(ids[pts[i]]);
+      }
+      continue;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      if (pts[i] < numIds)
+      {
+        border[ids[pts[i]]] = 1;
+      }
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      const vtkIdType p1 = pts[i];
+      const vtkIdType p2 = pts[(i + 1) % 3];
+      mesh->GetCellEdgeNeighbors(triId, p1, p2, neighbors);
+      if (neighbors->GetNumberOfIds() == 1 && isFinal[neighbors->GetId(0)])
+      {
+        vtkIdType neiNpts;
+        const vtkIdType* neiPts;
+        mesh->GetCellPoints(neighbors->GetId(0), neiNpts, neiPts);
+        const vtkIdType opposite =
+          *std::find_if(neiPts, neiPts + 3, [&](vtkIdType p) { return p != p1 && p != p2; });
+        partition.BorderEdges.insert(
+          partition.BorderEdges.end(), { ids[p1], ids[p2], ids[opposite] });
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Check that the two triangles sharing an edge lie on both sides of it and,
+// unless they both use bounding points, that the vertex of one is not inside
+// the circumcircle of the other. The triangles of the bounding points follow
+// the vtkDelaunay2D::InCircle() rule about large circles instead, which
+// stitching already applied.
+bool vtkDelaunayIsLocallyDelaunay(const double* x, vtkIdType numPoints, double boundingRadius2,
+  const vtkDelaunayEdge& edge, vtkIdType other)
+{
+  const double* x1 = x + 3 * edge.Ids[0];
+  const double* x2 = x + 3 * edge.Ids[1];
+  const double* xa = x + 3 * edge.Opposite;
+  const double* xb = x + 3 * other;
+  const double ex = x2[0] - x1[0];
+  const double ey = x2[1] - x1[1];
+  const double sideA = ex * (xa[1] - x1[1]) - ey * (xa[0] - x1[0]);
+  const double sideB = ex * (xb[1] - x1[1]) - ey * (xb[0] - x1[0]);
+  if (sideA == 0.0 || sideB == 0.0 || (sideA > 0.0) == (sideB > 0.0))
+  {
+    return false;
+  }
+
+  if (edge.Ids[1] >= numPoints || (edge.Opposite >= numPoints && other >= numPoints))
+  {
+    return true;
+  }
+  if (edge.Opposite >= numPoints)
+  {
+    std::swap(xa, xb);
+  }
+  double center[2];
+  const double radius2 = vtkTriangle::Circumcircle(x1, x2, xa, center);
+  const double dist2 =
+    (xb[0] - center[0]) * (xb[0] - center[0]) + (xb[1] - center[1]) * (xb[1] - center[1]);
+  // Same criterion as vtkDelaunay2D::InCircle()
+  return radius2 <= boundingRadius2 && dist2 >= 0.999999999999 * radius2;
+}
+
+//------------------------------------------------------------------------------
+// Check that the final triangles of the partitions and the stitching ones
+// form a Delaunay triangulation of the bounding points. Final triangles are
+// Delaunay by construction, so only the edges on the border of the final
+// regions and the edges of the stitching triangles are considered: each one
+// must be shared by two triangles on both sides of it meeting the Delaunay
+// criterion, or join two consecutive bounding points.
+bool vtkDelaunayIsValid(const double* x, vtkIdType numPoints, double boundingRadius2,
+  const std::vector<vtkDelaunayPartition>& partitions,
+  const std::vector<vtkIdType>& stitchTriangles)
+{
+  std::vector<vtkDelaunayEdge> edges;
+  for (std::size_t i = 0; i < stitchTriangles.size(); i += 3)
+  {
+    const vtkIdType* pts = stitchTriangles.data() + i;
+    for (int j = 0; j < 3; ++j)
+    {
+      edges.emplace_back(pts[j], pts[(j + 1) % 3], pts[(j + 2) % 3]);
+    }
+  }
+  for (const auto& partition : partitions)
+  {
+    for (std::size_t i = 0; i < partition.BorderEdges.size(); i += 3)
+    {
+      const vtkIdType* edge = partition.BorderEdges.data() + i;
+      edges.emplace_back(edge[0], edge[1], edge[2]);
+    }
+  }
+  vtkSMPTools::Sort(edges.begin(), edges.end());
+
+  for (std::size_t i = 0; i < edges.size();)
+  {
+    std::size_t j = i + 1;
+    while (j < edges.size() && edges[j].Ids == edges[i].Ids)
+    {
+      ++j;
+    }
+    if (j - i == 1)
+    {
+      // Only the outer edges of the bounding points are not shared
+      const vtkIdType gap = edges[i].Ids[1] - edges[i].Ids[0];
+      if (edges[i].Ids[0] < numPoints || (gap != 1 && gap != 7))
+      {
+        return false;
+      }
+    }
+    else if (j - i > 2 ||
+      !vtkDelaunayIsLocallyDelaunay(x, numPoints, boundingRadius2, edges[i], edges[i + 1].Opposite))
+    {
+      return false;
+    }
+    i = j;
+  }
+  return true;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkSMPDelaunay2D::TriangulateSubset(
+  vtkPoints* points, const vtkIdType* ids, vtkIdType numIds, double radius, double tol)
+{
+  const vtkIdType numPoints = points->GetNumberOfPoints() - 8;
+  vtkNew<vtkPoints> subset;
+  subset->SetDataTypeToDouble();
+  subset->SetNumberOfPoints(numIds + 8);
+  for (vtkIdType i = 0; i < numIds; ++i)
+  {
+    subset->SetPoint(i, points->GetPoint(ids[i]));
+  }
+  for (vtkIdType i = 0; i < 8; ++i)
+  {
+    subset->SetPoint(numIds + i, points->GetPoint(numPoints + i));
+  }
+
+  vtkNew<vtkSMPDelaunay2D> delaunay;
+  delaunay->SetRandomPointInsertion(this->RandomPointInsertion);
+  return delaunay->TriangulatePoints(subset, numIds, radius, tol);
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPDelaunay2D::RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* sourceInfo = inputVector[1]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkPointSet* input = vtkPointSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData* source = nullptr;
+  if (sourceInfo)
+  {
+    source = vtkPolyData::SafeDownCast(sourceInfo->Get(vtkDataObject::DATA_OBJECT()));
+  }
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  this->NumberOfPartitionsUsed = 0;
+
+  vtkPoints* inPoints = input->GetPoints();
+  const vtkIdType numPoints = inPoints ? inPoints->GetNumberOfPoints() : 0;
+  vtkIdType numPartitions = this->NumberOfPartitions > 0
+    ? this->NumberOfPartitions
+    : vtkSMPTools::GetEstimatedNumberOfThreads();
+  numPartitions = std::min(numPartitions, numPoints / VTK_MINIMUM_PARTITION_SIZE);
+  if (numPartitions < 2)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  vtkDebugMacro(<< "Generating 2D Delaunay triangulation with " << numPartitions << " partitions");
+
+  this->WarnIfNoBoundingTriangulation();
+
+  // The projected points followed by the bounding points, as vtkDelaunay2D
+  // triangulates them.
+  double radius, tol;
+  vtkSmartPointer<vtkPoints> points = this->CreateMeshPoints(input, radius, tol);
+  const double* x = vtkDelaunayCoordinates(points);
+  const double boundingRadius2 = 4 * radius * radius;
+
+  double bounds[4] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  vtkSMPThreadLocal<std::array<double, 4>> tlBounds(
+    std::array<double, 4>{ { bounds[0], bounds[1], bounds[2], bounds[3] } });
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    std::array<double, 4>& localBounds = tlBounds.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        localBounds[2 * i] = std::min(localBounds[2 * i], x[3 * ptId + i]);
+        localBounds[2 * i + 1] = std::max(localBounds[2 * i + 1], x[3 * ptId + i]);
+      }
+    }
+  });
+  for (const auto& localBounds : tlBounds)
+  {
+    for (int i = 0; i < 2; ++i)
+    {
+      bounds[2 * i] = std::min(bounds[2 * i], localBounds[2 * i]);
+      bounds[2 * i + 1] = std::max(bounds[2 * i + 1], localBounds[2 * i + 1]);
+    }
+  }
+
+  // Discard the points closer than the tolerance to a previous kept point,
+  // as vtkDelaunay2D does while inserting them. Most points have no such
+  // neighbor at all, so only the others are resolved in order.
+  std::vector<unsigned char> unique(numPoints, 1);
+  {
+    vtkNew<vtkPolyData> cloud;
+    cloud->SetPoints(points);
+    vtkNew<vtkStaticPointLocator2D> locator;
+    locator->SetDataSet(cloud);
+    locator->BuildLocator();
+    std::vector<unsigned char> candidate(numPoints, 0);
+    vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* neighbors = tlNeighbors.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        locator->FindPointsWithinRadius(tol, x + 3 * ptId, neighbors);
+        for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+        {
+          if (neighbors->GetId(i) < ptId)
+          {
+            candidate[ptId] = 1;
+            break;
+          }
+        }
+      }
+    });
+    vtkNew<vtkIdList> neighbors;
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+      if (candidate[ptId])
+      {
+        locator->FindPointsWithinRadius(tol, x + 3 * ptId, neighbors);
+        for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+        {
+          const vtkIdType neiId = neighbors->GetId(i);
+          if (neiId < ptId && unique[neiId])
+          {
+            unique[ptId] = 0;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // Split the points into tiles by recursive median subdivision of the
+  // largest tile along its longest side.
+  std::vector<vtkDelaunayPartition> partitions(1);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (unique[ptId])
+    {
+      partitions[0].Ids.push_back(ptId);
+    }
+  }
+  // Circumcircles may extend beyond the outer sides of the tiles, but not
+  // as far as the bounding points.
+  for (int i = 0; i < 4; ++i)
+  {
+    partitions[0].Bounds[i] = bounds[i];
+    partitions[0].Region[i] = bounds[i] + (i % 2 ? radius / 2 : -radius / 2);
+  }
+  while (static_cast<vtkIdType>(partitions.size()) < numPartitions)
+  {
+    auto largest = std::max_element(partitions.begin(), partitions.end(),
+      [](const vtkDelaunayPartition& a, const vtkDelaunayPartition& b) {
+        return a.Ids.size() < b.Ids.size();
+      });
+    vtkDelaunayPartition split;
+    std::copy(largest->Bounds, largest->Bounds + 4, split.Bounds);
+    std::copy(largest->Region, largest->Region + 4, split.Region);
+    const int axis = split.Bounds[3] - split.Bounds[2] > split.Bounds[1] - split.Bounds[0] ? 1 : 0;
+    std::vector<vtkIdType>& ids = largest->Ids;
+    const auto middle = ids.begin() + ids.size() / 2;
+    std::nth_element(ids.begin(), middle, ids.end(),
+      [x, axis](vtkIdType a, vtkIdType b) { return x[3 * a + axis] < x[3 * b + axis]; });
+    const double median = x[3 * *middle + axis];
+    split.Ids.assign(middle, ids.end());
+    ids.erase(middle, ids.end());
+    largest->Bounds[2 * axis + 1] = largest->Region[2 * axis + 1] = median;
+    split.Bounds[2 * axis] = split.Region[2 * axis] = median;
+    partitions.push_back(std::move(split));
+  }
+
+  // Triangulate the tiles concurrently.
+  std::vector<unsigned char> border(numPoints, 0);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkDelaunayPartition& partition = partitions[i];
+      std::sort(partition.Ids.begin(), partition.Ids.end());
+      vtkSmartPointer<vtkPolyData> mesh = this->TriangulateSubset(points, partition.Ids.data(),
+        static_cast<vtkIdType>(partition.Ids.size()), radius, tol);
+      vtkDelaunayCollectPartition(partition, mesh, boundingRadius2, border);
+    }
+  });
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    // vtkDelaunay2D releases the transform once done as well
+    this->Transform = nullptr;
+    return 1;
+  }
+
+  // Stitch the tiles: triangulate the border points and keep the triangles
+  // which are not final triangles of a tile.
+  std::vector<int> owner(numPoints, -1);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      for (vtkIdType ptId : partitions[i].Ids)
+      {
+        owner[ptId] = static_cast<int>(i);
+      }
+    }
+  });
+  std::vector<vtkIdType> borderIds;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (border[ptId])
+    {
+      borderIds.push_back(ptId);
+    }
+  }
+  const auto numBorderIds = static_cast<vtkIdType>(borderIds.size());
+  std::vector<vtkIdType> stitchTriangles;
+  {
+    vtkSmartPointer<vtkPolyData> stitch =
+      this->TriangulateSubset(points, borderIds.data(), numBorderIds, radius, tol);
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType triangle[3];
+    for (vtkIdType triId = 0; triId < stitch->GetNumberOfCells(); ++triId)
+    {
+      stitch->GetCellPoints(triId, npts, pts);
+      bool samePartition = true;
+      for (int i = 0; i < 3; ++i)
+      {
+        triangle[i] = pts[i] < numBorderIds ? borderIds[pts[i]] : numPoints + pts[i] - numBorderIds;
+        samePartition =
+          samePartition && triangle[i] < numPoints && owner[triangle[i]] == owner[triangle[0]];
+      }
+      if (samePartition &&
+        vtkDelaunayIsFinal(x, triangle, partitions[owner[triangle[0]]].Region, boundingRadius2))
+      {
+        continue;
+      }
+      stitchTriangles.insert(stitchTriangles.end(), triangle, triangle + 3);
+    }
+  }
+  this->UpdateProgress(0.8);
+
+  // Every kept point must be a vertex of the triangulation.
+  std::vector<unsigned char> used(numPoints, 0);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      for (vtkIdType ptId : partitions[i].FinalTriangles)
+      {
+        used[ptId] = 1;
+      }
+    }
+  });
+  for (vtkIdType ptId : stitchTriangles)
+  {
+    if (ptId < numPoints)
+    {
+      used[ptId] = 1;
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> mesh;
+  if (used != unique ||
+    !vtkDelaunayIsValid(x, numPoints, boundingRadius2, partitions, stitchTriangles))
+  {
+    vtkDebugMacro(<< "Stitched triangulation is not valid, using the serial algorithm");
+    mesh = this->TriangulatePoints(points, numPoints, radius, tol);
+  }
+  else
+  {
+    // Gather the triangles in a mesh like the one of vtkDelaunay2D, so that
+    // the source edges are recovered and the output is generated the same way.
+    std::vector<vtkIdType> triangleOffsets(numPartitions + 1, 0);
+    for (vtkIdType i = 0; i < numPartitions; ++i)
+    {
+      triangleOffsets[i + 1] = triangleOffsets[i] + partitions[i].FinalTriangles.size() / 3;
+    }
+    const vtkIdType numTriangles =
+      triangleOffsets[numPartitions] + static_cast<vtkIdType>(stitchTriangles.size() / 3);
+
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numTriangles + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(3 * numTriangles);
+    vtkIdType* conn = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        std::copy(partitions[i].FinalTriangles.begin(), partitions[i].FinalTriangles.end(),
+          conn + 3 * triangleOffsets[i]);
+        std::vector<vtkIdType>().swap(partitions[i].FinalTriangles);
+      }
+    });
+    std::copy(
+      stitchTriangles.begin(), stitchTriangles.end(), conn + 3 * triangleOffsets[numPartitions]);
+    vtkIdType* offs = offsets->GetPointer(0);
+    vtkSMPTools::For(0, numTriangles + 1, [offs](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        offs[i] = 3 * i;
+      }
+    });
+    vtkNew<vtkCellArray> triangles;
+    triangles->SetData(offsets, connectivity);
+
+    mesh = vtkSmartPointer<vtkPolyData>::New();
+    mesh->SetPoints(points);
+    mesh->SetPolys(triangles);
+    mesh->EditableOn();
+    mesh->BuildLinks();
+    this->NumberOfPartitionsUsed = static_cast<int>(numPartitions);
+  }
+
+  return this->GenerateOutput(input, source, mesh, radius, output);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
+  os << indent << "Number Of Partitions Used: " << this->NumberOfPartitionsUsed << "\n";
+}
+VTK_ABI_NAMESPACE_END
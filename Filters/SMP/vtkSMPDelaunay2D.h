@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkSMPDelaunay2D
+ * @brief   a subclass of vtkDelaunay2D that triangulates in parallel
+ *
+ * vtkSMPDelaunay2D computes the same 2D Delaunay triangulation as
+ * vtkDelaunay2D using multiple threads, which pays off for large point sets
+ * such as elevation or lidar tiles. The projected points are split into
+ * tiles by recursive median subdivision (as in a k-d tree) and the tiles
+ * are triangulated concurrently. Triangles whose circumcircle lies inside
+ * their tile are kept as is. The points of the other triangles, which run
+ * along the seams between the tiles, are triangulated again to stitch the
+ * tiles together.
+ *
+ * The stitched triangulation is checked to be a valid Delaunay
+ * triangulation of all the points. If it is not, which may happen with
+ * degenerate inputs such as points on a regular grid, the filter falls back
+ * to the serial algorithm of vtkDelaunay2D. It does so as well when there
+ * are too few points for partitioning to pay off.
+ *
+ * All the options of vtkDelaunay2D are supported: the edges and polygons of
+ * the Source are recovered in the stitched triangulation, and the points are
+ * projected according to Transform and ProjectionPlaneMode before being
+ * partitioned.
+ *
+ * @warning
+ * The triangles are output in a different order than vtkDelaunay2D.
+ * Coincident points are discarded in the order of the point ids, even when
+ * RandomPointInsertion is on, so another one of them may be kept.
+ *
+ * @sa
+ * vtkDelaunay2D vtkSMPDelaunay3D vtkSMPTools
+ */
+
+#ifndef vtkSMPDelaunay2D_h
+#define vtkSMPDelaunay2D_h
+
+#include "vtkDelaunay2D.h"
+#include "vtkFiltersSMPModule.h" // For export macro
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKFILTERSSMP_EXPORT vtkSMPDelaunay2D : public vtkDelaunay2D
+{
+public:
+  vtkTypeMacro(vtkSMPDelaunay2D, vtkDelaunay2D);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Construct object with the defaults of vtkDelaunay2D and an automatic
+   * number of partitions.
+   */
+  static vtkSMPDelaunay2D* New();
+
+  ///@{
+  /**
+   * Specify the number of tiles triangulated concurrently. When 0
+   * (default), one tile per thread is used. Tiles of less than a thousand
+   * points are not created; the serial algorithm is used when there would be
+   * less than two tiles.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
+  /**
+   * Get the number of tiles triangulated concurrently by the last execution,
+   * or 0 when it used the serial algorithm of vtkDelaunay2D.
+   */
+  vtkGetMacro(NumberOfPartitionsUsed, int);
+
+protected:
+  vtkSMPDelaunay2D();
+  ~vtkSMPDelaunay2D() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Triangulate the given points of a mesh point list, as returned by
+   * CreateMeshPoints(), inside the same bounding points. The returned mesh
+   * uses the indices in ids, followed by the eight bounding points.
+   */
+  vtkSmartPointer<vtkPolyData> TriangulateSubset(
+    vtkPoints* points, const vtkIdType* ids, vtkIdType numIds, double radius, double tol);
+
+  int NumberOfPartitions;
+  int NumberOfPartitionsUsed;
+
+private:
+  vtkSMPDelaunay2D(const vtkSMPDelaunay2D&) = delete;
+  void operator=(const vtkSMPDelaunay2D&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,719 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSMPDelaunay3D.h"
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkNonMergingPointLocator.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkTetra.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkSMPDelaunay3D);
+
+//------------------------------------------------------------------------------
+vtkSMPDelaunay3D::vtkSMPDelaunay3D()
+{
+  this->NumberOfPartitions = 0;
+  this->NumberOfPartitionsUsed = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPDelaunay3D::~vtkSMPDelaunay3D() = default;
+
+//------------------------------------------------------------------------------
+namespace
+{
+// Partitions smaller than this are not worth triangulating separately.
+constexpr vtkIdType VTK_MINIMUM_PARTITION_SIZE = 1000;
+
+// Vertices of the faces of a tetrahedron; face i is opposite to vertex i.
+constexpr int VTK_TETRA_FACES[4][3] = { { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 }, { 0, 1, 2 } };
+
+// A spatial partition of the points and what its triangulation contributes
+// to the whole one.
+struct vtkDelaunayPartition
+{
+  std::vector<vtkIdType> Ids; // point ids, in increasing order
+  double Bounds[6];           // bounds of the partition
+  double Region[6];           // bounds extended beyond the outer sides
+  std::vector<vtkIdType> FinalTetras; // 4 point ids per tetra
+  std::vector<vtkIdType> BorderFaces; // 3 point ids and the opposite one
+};
+
+// A face of a tetrahedron, with sorted ids, and the tetrahedron vertex
+// opposite to it.
+struct vtkDelaunayFace
+{
+  std::array<vtkIdType, 3> Ids;
+  vtkIdType Opposite;
+
+  vtkDelaunayFace(const vtkIdType ids[3], vtkIdType opposite)
+    : Ids{ { ids[0], ids[1], ids[2] } }
+    , Opposite(opposite)
+  {
+    std::sort(this->Ids.begin(), this->Ids.end());
+  }
+
+  bool operator<(const vtkDelaunayFace& other) const { return this->Ids < other.Ids; }
+};
+
+//------------------------------------------------------------------------------
+double vtkDelaunaySphere(vtkPoints* points, const vtkIdType pts[4], double center[3])
+{
+  double x[4][3];
+  for (int i = 0; i < 4; ++i)
+  {
+    points->GetPoint(pts[i], x[i]);
+  }
+  return vtkTetra::Circumsphere(x[0], x[1], x[2], x[3], center);
+}
+
+//------------------------------------------------------------------------------
+// A tetrahedron whose circumsphere is strictly inside the region of its
+// partition cannot have points of other partitions in its circumsphere.
+bool vtkDelaunaySphereInside(const double center[3], double radius2, const double region[6])
+{
+  const double radius = std::sqrt(radius2);
+  for (int i = 0; i < 3; ++i)
+  {
+    if (center[i] - radius <= region[2 * i] || center[i] + radius >= region[2 * i + 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Return the tetrahedron other than tetraId that uses the face (p1,p2,p3), or
+// -1 if there is none.
+vtkIdType vtkDelaunayFaceNeighbor(
+  vtkUnstructuredGrid* mesh, vtkIdType tetraId, vtkIdType p1, vtkIdType p2, vtkIdType p3)
+{
+  vtkIdType numCells;
+  vtkIdType* cells;
+  mesh->GetPointCells(p1, numCells, cells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    if (cells[i] != tetraId)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      mesh->GetCellPoints(cells[i], npts, pts);
+      if (std::find(pts, pts + 4, p2) != pts + 4 && std::find(pts, pts + 4, p3) != pts + 4)
+      {
+        return cells[i];
+      }
+    }
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Triangulate the given input points with vtkDelaunay3D, inside the same
+// bounding octahedron as the whole triangulation. The mesh uses the
+// indices in ids, followed by the six octahedron points.
+vtkUnstructuredGrid* vtkDelaunayTriangulate(const std::vector<vtkIdType>& ids,
+  vtkPoints* inPoints, int dataType, const double center[3], double length, const double bounds[6],
+  vtkIdList* holeTetras)
+{
+  const auto numIds = static_cast<vtkIdType>(ids.size());
+
+  // Coincident points have already been removed. Size the locator so that
+  // the buckets covering the points hold a few of them each.
+  vtkNew<vtkPointLocator> locator;
+  locator->SetTolerance(0.0);
+  int divisions = 25;
+  const double volume = (bounds[1] - bounds[0]) * (bounds[3] - bounds[2]) * (bounds[5] - bounds[4]);
+  if (volume > 0.0)
+  {
+    const double width = std::cbrt(3.0 * volume / numIds);
+    divisions = static_cast<int>(std::max(25.0, std::min(128.0, 2.0 * length / width)));
+  }
+  locator->SetDivisions(divisions, divisions, divisions);
+
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetLocator(locator);
+  vtkPoints* points = vtkPoints::New();
+  points->SetDataType(dataType);
+  points->Allocate(numIds + 6);
+  double c[3] = { center[0], center[1], center[2] };
+  vtkUnstructuredGrid* mesh = delaunay->InitPointInsertion(c, length, numIds, points);
+
+  double x[3];
+  for (vtkIdType i = 0; i < numIds; ++i)
+  {
+    inPoints->GetPoint(ids[i], x);
+    delaunay->InsertPoint(mesh, points, i, x, holeTetras);
+  }
+  delaunay->EndPointInsertion();
+  return mesh;
+}
+
+//------------------------------------------------------------------------------
+// Triangulate a partition. Keep the tetrahedra whose circumsphere is inside
+// the partition region, the faces separating them from the other ones, and
+// mark the vertices of the other ones as border points.
+void vtkDelaunayTriangulatePartition(vtkDelaunayPartition& partition, vtkPoints* inPoints,
+  vtkPoints* points, const double center[3], double length, std::vector<unsigned char>& border)
+{
+  const std::vector<vtkIdType>& ids = partition.Ids;
+  const auto numIds = static_cast<vtkIdType>(ids.size());
+  vtkNew<vtkIdList> holeTetras;
+  vtkUnstructuredGrid* mesh = vtkDelaunayTriangulate(
+    ids, inPoints, points->GetDataType(), center, length, partition.Bounds, holeTetras);
+  vtkPoints* meshPoints = mesh->GetPoints();
+
+  // 0: deleted, 1: on the border, 2: final
+  const vtkIdType numTetras = mesh->GetNumberOfCells();
+  std::vector<unsigned char> status(numTetras, 1);
+  for (vtkIdType i = 0; i < holeTetras->GetNumberOfIds(); ++i)
+  {
+    status[holeTetras->GetId(i)] = 0;
+  }
+  vtkIdType npts;
+  const vtkIdType* pts;
+  double sphereCenter[3];
+  for (vtkIdType tetraId = 0; tetraId < numTetras; ++tetraId)
+  {
+    mesh->GetCellPoints(tetraId, npts, pts);
+    if (status[tetraId] && std::all_of(pts, pts + 4, [numIds](vtkIdType p) { return p < numIds; }))
+    {
+      const double radius2 = vtkDelaunaySphere(meshPoints, pts, sphereCenter);
+      if (vtkDelaunaySphereInside(sphereCenter, radius2, partition.Region))
+      {
+        status[tetraId] = 2;
+      }
+    }
+  }
+
+  for (vtkIdType tetraId = 0; tetraId < numTetras; ++tetraId)
+  {
+    if (status[tetraId] == 0)
+    {
+      continue;
+    }
+    mesh->GetCellPoints(tetraId, npts, pts);
+    if (status[tetraId] == 2)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        partition.FinalTetras.push_back(ids[pts[i]]);
+      }
+      continue;
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      if (pts[i] < numIds)
+      {
+        border[ids[pts[i]]] = 1;
+      }
+    }
+    for (const auto& face : VTK_TETRA_FACES)
+    {
+      const vtkIdType p1 = pts[face[0]];
+      const vtkIdType p2 = pts[face[1]];
+      const vtkIdType p3 = pts[face[2]];
+      const vtkIdType nei = vtkDelaunayFaceNeighbor(mesh, tetraId, p1, p2, p3);
+      if (nei >= 0 && status[nei] == 2)
+      {
+        vtkIdType neiNpts;
+        const vtkIdType* neiPts;
+        mesh->GetCellPoints(nei, neiNpts, neiPts);
+        const vtkIdType opposite = *std::find_if(
+          neiPts, neiPts + 4, [&](vtkIdType p) { return p != p1 && p != p2 && p != p3; });
+        partition.BorderFaces.insert(
+          partition.BorderFaces.end(), { ids[p1], ids[p2], ids[p3], ids[opposite] });
+      }
+    }
+  }
+  mesh->Delete();
+}
+
+//------------------------------------------------------------------------------
+// Check that the two tetrahedra sharing a face lie on both sides of it and
+// that the vertex of the second one is not inside the circumsphere of the
+// first one.
+bool vtkDelaunayIsLocallyDelaunay(vtkPoints* points, const vtkDelaunayFace& face, vtkIdType other)
+{
+  double x[3][3], xa[3], xb[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    points->GetPoint(face.Ids[i], x[i]);
+  }
+  points->GetPoint(face.Opposite, xa);
+  points->GetPoint(other, xb);
+
+  double v1[3], v2[3], normal[3], va[3], vb[3];
+  vtkMath::Subtract(x[1], x[0], v1);
+  vtkMath::Subtract(x[2], x[0], v2);
+  vtkMath::Cross(v1, v2, normal);
+  vtkMath::Subtract(xa, x[0], va);
+  vtkMath::Subtract(xb, x[0], vb);
+  const double sideA = vtkMath::Dot(normal, va);
+  const double sideB = vtkMath::Dot(normal, vb);
+  if (sideA == 0.0 || sideB == 0.0 || (sideA > 0.0) == (sideB > 0.0))
+  {
+    return false;
+  }
+
+  double center[3];
+  const double radius2 = vtkTetra::Circumsphere(x[0], x[1], x[2], xa, center);
+  // Same criterion as vtkDelaunay3D::InSphere()
+  return vtkMath::Distance2BetweenPoints(xb, center) >= 0.9999999999L * radius2;
+}
+
+//------------------------------------------------------------------------------
+// Check that the final tetrahedra of the partitions and the stitching ones
+// form a Delaunay triangulation of the bounding octahedron. Final tetrahedra
+// are Delaunay by construction, so only the faces on the border of the
+// final regions and the faces of the stitching tetrahedra are considered:
+// each one must be shared by two tetrahedra on both sides of it meeting the
+// Delaunay criterion, or lie on the octahedron.
+bool vtkDelaunayIsValid(vtkPoints* points, vtkIdType numPoints,
+  const std::vector<vtkDelaunayPartition>& partitions, const std::vector<vtkIdType>& stitchTetras)
+{
+  std::vector<vtkDelaunayFace> faces;
+  for (std::size_t i = 0; i < stitchTetras.size(); i += 4)
+  {
+    const vtkIdType* pts = stitchTetras.data() + i;
+    for (int j = 0; j < 4; ++j)
+    {
+      const vtkIdType face[3] = { pts[VTK_TETRA_FACES[j][0]], pts[VTK_TETRA_FACES[j][1]],
+        pts[VTK_TETRA_FACES[j][2]] };
+      faces.emplace_back(face, pts[j]);
+    }
+  }
+  for (const auto& partition : partitions)
+  {
+    for (std::size_t i = 0; i < partition.BorderFaces.size(); i += 4)
+    {
+      const vtkIdType* face = partition.BorderFaces.data() + i;
+      faces.emplace_back(face, face[3]);
+    }
+  }
+  vtkSMPTools::Sort(faces.begin(), faces.end());
+
+  for (std::size_t i = 0; i < faces.size();)
+  {
+    std::size_t j = i + 1;
+    while (j < faces.size() && faces[j].Ids == faces[i].Ids)
+    {
+      ++j;
+    }
+    if (j - i == 1)
+    {
+      // Only the faces of the octahedron are not shared
+      if (faces[i].Ids[0] < numPoints)
+      {
+        return false;
+      }
+    }
+    else if (j - i > 2 || !vtkDelaunayIsLocallyDelaunay(points, faces[i], faces[i + 1].Opposite))
+    {
+      return false;
+    }
+    i = j;
+  }
+  return true;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int vtkSMPDelaunay3D::RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkPointSet* input = vtkPointSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkUnstructuredGrid* output =
+    vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  this->NumberOfPartitionsUsed = 0;
+
+  vtkPoints* inPoints = input->GetPoints();
+  const vtkIdType numPoints = inPoints ? inPoints->GetNumberOfPoints() : 0;
+  vtkIdType numPartitions = this->NumberOfPartitions > 0
+    ? this->NumberOfPartitions
+    : vtkSMPTools::GetEstimatedNumberOfThreads();
+  numPartitions = std::min(numPartitions, numPoints / VTK_MINIMUM_PARTITION_SIZE);
+
+  // Coincident points are the ones the locator would merge.
+  if (this->Locator == nullptr)
+  {
+    this->CreateDefaultLocator();
+  }
+  double tolerance = 0.0;
+  if (vtkMergePoints::SafeDownCast(this->Locator))
+  {
+    tolerance = 0.0; // only exactly coincident points are merged
+  }
+  else if (vtkPointLocator::SafeDownCast(this->Locator) &&
+    !vtkNonMergingPointLocator::SafeDownCast(this->Locator))
+  {
+    tolerance = this->Locator->GetTolerance();
+  }
+  else
+  {
+    numPartitions = 0; // unknown merging behavior
+  }
+
+  if (numPartitions < 2)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  vtkDebugMacro(<< "Generating 3D Delaunay triangulation with " << numPartitions << " partitions");
+
+  double center[3], bounds[6];
+  input->GetCenter(center);
+  input->GetBounds(bounds);
+  const double length = input->GetLength();
+  const double offsetLength = this->Offset * length > 0.0 ? this->Offset * length : 1.0;
+
+  // The points with the output precision, followed by the bounding octahedron
+  // of vtkDelaunay3D::InitPointInsertion().
+  vtkNew<vtkPoints> points;
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    points->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    points->SetDataType(VTK_DOUBLE);
+  }
+  else
+  {
+    points->SetDataType(inPoints->GetDataType());
+  }
+  points->SetNumberOfPoints(numPoints + 6);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      inPoints->GetPoint(ptId, x);
+      points->SetPoint(ptId, x);
+    }
+  });
+  for (int i = 0; i < 6; ++i)
+  {
+    double x[3] = { center[0], center[1], center[2] };
+    x[i / 2] += (i % 2 ? offsetLength : -offsetLength);
+    points->SetPoint(numPoints + i, x);
+  }
+
+  // Discard the points closer than the tolerance to a previous kept point,
+  // as vtkDelaunay3D does while inserting them. Most points have no such
+  // neighbor at all, so only the others are resolved in order.
+  std::vector<unsigned char> unique(numPoints, 1);
+  {
+    vtkNew<vtkPolyData> cloud;
+    cloud->SetPoints(points);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(cloud);
+    locator->BuildLocator();
+    std::vector<unsigned char> candidate(numPoints, 0);
+    vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* neighbors = tlNeighbors.Local();
+      double x[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        inPoints->GetPoint(ptId, x);
+        locator->FindPointsWithinRadius(tolerance, x, neighbors);
+        for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+        {
+          if (neighbors->GetId(i) < ptId)
+          {
+            candidate[ptId] = 1;
+            break;
+          }
+        }
+      }
+    });
+    vtkNew<vtkIdList> neighbors;
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+      if (candidate[ptId])
+      {
+        inPoints->GetPoint(ptId, x);
+        locator->FindPointsWithinRadius(tolerance, x, neighbors);
+        for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+        {
+          const vtkIdType neiId = neighbors->GetId(i);
+          if (neiId < ptId && unique[neiId])
+          {
+            unique[ptId] = 0;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // Split the points by recursive median subdivision of the largest partition
+  // along its longest side.
+  std::vector<vtkDelaunayPartition> partitions(1);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (unique[ptId])
+    {
+      partitions[0].Ids.push_back(ptId);
+    }
+  }
+  // Circumspheres may extend beyond the outer sides of the partitions, but
+  // not as far as the octahedron points.
+  for (int i = 0; i < 6; ++i)
+  {
+    partitions[0].Bounds[i] = bounds[i];
+    partitions[0].Region[i] = bounds[i] + (i % 2 ? length : -length);
+  }
+  while (static_cast<vtkIdType>(partitions.size()) < numPartitions)
+  {
+    auto largest = std::max_element(partitions.begin(), partitions.end(),
+      [](const vtkDelaunayPartition& a, const vtkDelaunayPartition& b) {
+        return a.Ids.size() < b.Ids.size();
+      });
+    vtkDelaunayPartition split;
+    std::copy(largest->Bounds, largest->Bounds + 6, split.Bounds);
+    std::copy(largest->Region, largest->Region + 6, split.Region);
+    int axis = 0;
+    for (int i = 1; i < 3; ++i)
+    {
+      if (split.Bounds[2 * i + 1] - split.Bounds[2 * i] >
+        split.Bounds[2 * axis + 1] - split.Bounds[2 * axis])
+      {
+        axis = i;
+      }
+    }
+    std::vector<vtkIdType>& ids = largest->Ids;
+    const auto middle = ids.begin() + ids.size() / 2;
+    vtkDataArray* coordinates = points->GetData();
+    std::nth_element(ids.begin(), middle, ids.end(), [&](vtkIdType a, vtkIdType b) {
+      return coordinates->GetComponent(a, axis) < coordinates->GetComponent(b, axis);
+    });
+    const double median = coordinates->GetComponent(*middle, axis);
+    split.Ids.assign(middle, ids.end());
+    ids.erase(middle, ids.end());
+    largest->Bounds[2 * axis + 1] = largest->Region[2 * axis + 1] = median;
+    split.Bounds[2 * axis] = split.Region[2 * axis] = median;
+    partitions.push_back(std::move(split));
+  }
+
+  // Triangulate the partitions concurrently.
+  std::vector<unsigned char> border(numPoints, 0);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkDelaunayPartition& partition = partitions[i];
+      std::sort(partition.Ids.begin(), partition.Ids.end());
+      vtkDelaunayTriangulatePartition(partition, inPoints, points, center, offsetLength, border);
+    }
+  });
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Stitch the partitions: triangulate the border points and keep the
+  // tetrahedra which are not final tetrahedra of a partition.
+  std::vector<int> owner(numPoints, -1);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      for (vtkIdType ptId : partitions[i].Ids)
+      {
+        owner[ptId] = static_cast<int>(i);
+      }
+    }
+  });
+  std::vector<vtkIdType> borderIds;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (border[ptId])
+    {
+      borderIds.push_back(ptId);
+    }
+  }
+  const auto numBorderIds = static_cast<vtkIdType>(borderIds.size());
+  std::vector<vtkIdType> stitchTetras;
+  {
+    vtkNew<vtkIdList> holeTetras;
+    vtkUnstructuredGrid* stitch = vtkDelaunayTriangulate(
+      borderIds, inPoints, points->GetDataType(), center, offsetLength, bounds, holeTetras);
+    std::vector<unsigned char> deleted(stitch->GetNumberOfCells(), 0);
+    for (vtkIdType i = 0; i < holeTetras->GetNumberOfIds(); ++i)
+    {
+      deleted[holeTetras->GetId(i)] = 1;
+    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType tetra[4];
+    double sphereCenter[3];
+    for (vtkIdType tetraId = 0; tetraId < stitch->GetNumberOfCells(); ++tetraId)
+    {
+      if (deleted[tetraId])
+      {
+        continue;
+      }
+      stitch->GetCellPoints(tetraId, npts, pts);
+      bool samePartition = true;
+      for (int i = 0; i < 4; ++i)
+      {
+        tetra[i] = pts[i] < numBorderIds ? borderIds[pts[i]] : numPoints + pts[i] - numBorderIds;
+        samePartition = samePartition && tetra[i] < numPoints && owner[tetra[i]] == owner[tetra[0]];
+      }
+      if (samePartition)
+      {
+        const double radius2 = vtkDelaunaySphere(points, tetra, sphereCenter);
+        if (vtkDelaunaySphereInside(sphereCenter, radius2, partitions[owner[tetra[0]]].Region))
+        {
+          continue;
+        }
+      }
+      stitchTetras.insert(stitchTetras.end(), tetra, tetra + 4);
+    }
+    stitch->Delete();
+  }
+  this->UpdateProgress(0.8);
+
+  // Every kept point must be a vertex of the triangulation.
+  std::vector<unsigned char> used(numPoints, 0);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      for (vtkIdType ptId : partitions[i].FinalTetras)
+      {
+        used[ptId] = 1;
+      }
+    }
+  });
+  for (vtkIdType ptId : stitchTetras)
+  {
+    if (ptId < numPoints)
+    {
+      used[ptId] = 1;
+    }
+  }
+  if (used != unique || !vtkDelaunayIsValid(points, numPoints, partitions, stitchTetras))
+  {
+    vtkDebugMacro(<< "Stitched triangulation is not valid, using the serial algorithm");
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // Gather the tetrahedra in a mesh like the one of vtkDelaunay3D. Without
+  // bounding triangulation, the tetrahedra using the octahedron are dropped
+  // right away.
+  std::vector<vtkIdType> tetraOffsets(numPartitions + 1, 0);
+  for (vtkIdType i = 0; i < numPartitions; ++i)
+  {
+    tetraOffsets[i + 1] = tetraOffsets[i] + partitions[i].FinalTetras.size() / 4;
+  }
+  if (!this->BoundingTriangulation)
+  {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < stitchTetras.size(); i += 4)
+    {
+      if (std::all_of(stitchTetras.begin() + i, stitchTetras.begin() + i + 4,
+            [numPoints](vtkIdType p) { return p < numPoints; }))
+      {
+        std::copy(stitchTetras.begin() + i, stitchTetras.begin() + i + 4,
+          stitchTetras.begin() + kept);
+        kept += 4;
+      }
+    }
+    stitchTetras.resize(kept);
+  }
+  const vtkIdType numTetras =
+    tetraOffsets[numPartitions] + static_cast<vtkIdType>(stitchTetras.size() / 4);
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTetras + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(4 * numTetras);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      std::copy(partitions[i].FinalTetras.begin(), partitions[i].FinalTetras.end(),
+        conn + 4 * tetraOffsets[i]);
+      std::vector<vtkIdType>().swap(partitions[i].FinalTetras);
+    }
+  });
+  std::copy(stitchTetras.begin(), stitchTetras.end(), conn + 4 * tetraOffsets[numPartitions]);
+  vtkIdType* offs = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numTetras + 1, [offs](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      offs[i] = 4 * i;
+    }
+  });
+  vtkNew<vtkCellArray> tetras;
+  tetras->SetData(offsets, connectivity);
+
+  vtkNew<vtkUnstructuredGrid> mesh;
+  mesh->SetPoints(points);
+  mesh->SetCells(VTK_TETRA, tetras);
+  if (this->Alpha > 0.0 && this->AlphaTris)
+  {
+    // Face neighbors are looked up through editable links
+    mesh->EditableOn();
+  }
+  mesh->BuildLinks();
+
+  std::vector<char> tetraUse(numTetras, 2);
+  std::vector<double> radii2;
+  if (this->Alpha > 0.0)
+  {
+    radii2.resize(numTetras);
+    vtkSMPTools::For(0, numTetras, [&](vtkIdType begin, vtkIdType end) {
+      double sphereCenter[3];
+      for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+      {
+        radii2[tetraId] = vtkDelaunaySphere(points, conn + 4 * tetraId, sphereCenter);
+      }
+    });
+  }
+
+  output->Allocate(numTetras);
+  this->GenerateOutput(
+    input, mesh, numPoints, tetraUse.data(), radii2.empty() ? nullptr : radii2.data(), output);
+  output->Squeeze();
+
+  this->NumberOfPartitionsUsed = static_cast<int>(numPartitions);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
+  os << indent << "Number Of Partitions Used: " << this->NumberOfPartitionsUsed << "\n";
+}
+VTK_ABI_NAMESPACE_END
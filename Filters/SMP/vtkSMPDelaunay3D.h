@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkSMPDelaunay3D
+ * @brief   a subclass of vtkDelaunay3D that triangulates in parallel
+ *
+ * vtkSMPDelaunay3D computes the same 3D Delaunay triangulation as
+ * vtkDelaunay3D using multiple threads. The points are split into spatial
+ * partitions by recursive median subdivision (as in a k-d tree) and the
+ * partitions are triangulated concurrently. Tetrahedra whose circumsphere
+ * lies inside their partition are kept as is. The points of the other
+ * tetrahedra, which border the partitions, are triangulated again to stitch
+ * the partitions together.
+ *
+ * The stitched triangulation is checked to be a valid Delaunay
+ * triangulation of all the points. If it is not, which may happen with
+ * degenerate inputs such as points on a regular lattice, the filter falls
+ * back to the serial algorithm of vtkDelaunay3D. It does so as well when
+ * there are too few points for partitioning to pay off.
+ *
+ * Alpha, the Alpha* flags, Offset, BoundingTriangulation and
+ * OutputPointsPrecision have the same meaning as in vtkDelaunay3D. Coincident
+ * points are discarded like vtkDelaunay3D does: a point closer than the
+ * tolerance of the locator to a previous point is ignored.
+ *
+ * @warning
+ * The tetrahedra are output in a different order than vtkDelaunay3D. When
+ * Alpha is non-zero, triangles on the convex hull are output whenever they
+ * satisfy the alpha criterion.
+ *
+ * @sa
+ * vtkDelaunay3D vtkSMPTools
+ */
+
+#ifndef vtkSMPDelaunay3D_h
+#define vtkSMPDelaunay3D_h
+
+#include "vtkDelaunay3D.h"
+#include "vtkFiltersSMPModule.h" // For export macro
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKFILTERSSMP_EXPORT vtkSMPDelaunay3D : public vtkDelaunay3D
+{
+public:
+  vtkTypeMacro(vtkSMPDelaunay3D, vtkDelaunay3D);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Construct object with the defaults of vtkDelaunay3D and an automatic
+   * number of partitions.
+   */
+  static vtkSMPDelaunay3D* New();
+
+  ///@{
+  /**
+   * Specify the number of spatial partitions triangulated concurrently. When
+   * 0 (default), one partition per thread is used. Partitions of less than
+   * a thousand points are not created; the serial algorithm is used when
+   * there would be less than two partitions.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
+  /**
+   * Get the number of partitions triangulated concurrently by the last
+   * execution, or 0 when it used the serial algorithm of vtkDelaunay3D.
+   */
+  vtkGetMacro(NumberOfPartitionsUsed, int);
+
+protected:
+  vtkSMPDelaunay3D();
+  ~vtkSMPDelaunay3D() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int NumberOfPartitions;
+  int NumberOfPartitionsUsed;
+
+private:
+  vtkSMPDelaunay3D(const vtkSMPDelaunay3D&) = delete;
+  void operator=(const vtkSMPDelaunay3D&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,624 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSMPQuadricDecimation.h"
+
+#include "vtkCellArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkSMPQuadricDecimation);
+
+//------------------------------------------------------------------------------
+vtkSMPQuadricDecimation::vtkSMPQuadricDecimation()
+{
+  this->BatchFraction = 0.25;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPQuadricDecimation::~vtkSMPQuadricDecimation() = default;
+
+//------------------------------------------------------------------------------
+namespace
+{
+// The triangles using each point, sorted by triangle id.
+struct vtkDecimationLinks
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Triangles;
+
+  vtkIdType GetNumberOfTriangles(vtkIdType ptId) const
+  {
+    return this->Offsets[ptId + 1] - this->Offsets[ptId];
+  }
+  const vtkIdType* GetTriangles(vtkIdType ptId) const
+  {
+    return this->Triangles.data() + this->Offsets[ptId];
+  }
+};
+
+// Whether the j-th point of a triangle already appears before in it
+bool vtkDecimationIsRepeated(const vtkIdType* pts, int j)
+{
+  return (j > 0 && pts[j] == pts[0]) || (j > 1 && pts[j] == pts[1]);
+}
+
+bool vtkDecimationHasPoint(const vtkIdType* pts, vtkIdType ptId)
+{
+  return pts[0] == ptId || pts[1] == ptId || pts[2] == ptId;
+}
+
+// Build the links of the triangles, counters being scratch space of one
+// counter per point.
+void vtkDecimationBuildLinks(const std::vector<vtkIdType>& triangles, vtkIdType numPts,
+  std::atomic<vtkIdType>* counters, vtkDecimationLinks& links)
+{
+  const vtkIdType numTris = static_cast<vtkIdType>(triangles.size() / 3);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      counters[ptId].store(0, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      const vtkIdType* pts = triangles.data() + 3 * triId;
+      for (int j = 0; j < 3; ++j)
+      {
+        if (!vtkDecimationIsRepeated(pts, j))
+        {
+          counters[pts[j]].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+  });
+
+  links.Offsets.resize(numPts + 1);
+  links.Offsets[0] = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    links.Offsets[ptId + 1] = links.Offsets[ptId] + counters[ptId].load(std::memory_order_relaxed);
+  }
+  links.Triangles.resize(links.Offsets[numPts]);
+
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      counters[ptId].store(links.Offsets[ptId], std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      const vtkIdType* pts = triangles.data() + 3 * triId;
+      for (int j = 0; j < 3; ++j)
+      {
+        if (!vtkDecimationIsRepeated(pts, j))
+        {
+          links.Triangles[counters[pts[j]].fetch_add(1, std::memory_order_relaxed)] = triId;
+        }
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      std::sort(links.Triangles.begin() + links.Offsets[ptId],
+        links.Triangles.begin() + links.Offsets[ptId + 1]);
+    }
+  });
+}
+
+// Visit the edges (ptId, neiId) with ptId < neiId, each one once, in the
+// order of the triangles using ptId.
+template <typename TFunctor>
+void vtkDecimationVisitEdges(const std::vector<vtkIdType>& triangles,
+  const vtkDecimationLinks& links, vtkIdType ptId, TFunctor&& functor)
+{
+  const vtkIdType numCells = links.GetNumberOfTriangles(ptId);
+  const vtkIdType* cells = links.GetTriangles(ptId);
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    const vtkIdType* pts = triangles.data() + 3 * cells[i];
+    for (int j = 0; j < 3; ++j)
+    {
+      const vtkIdType neiId = pts[j];
+      if (neiId <= ptId || vtkDecimationIsRepeated(pts, j))
+      {
+        continue;
+      }
+      bool visited = false;
+      for (vtkIdType k = 0; k < i && !visited; ++k)
+      {
+        visited = vtkDecimationHasPoint(triangles.data() + 3 * cells[k], neiId);
+      }
+      if (!visited)
+      {
+        functor(neiId);
+      }
+    }
+  }
+}
+
+// Visit the points of the triangles using the points of an edge
+template <typename TFunctor>
+void vtkDecimationVisitNeighborhood(const std::vector<vtkIdType>& triangles,
+  const vtkDecimationLinks& links, const vtkIdType* pointIds, TFunctor&& functor)
+{
+  for (int i = 0; i < 2; ++i)
+  {
+    const vtkIdType numCells = links.GetNumberOfTriangles(pointIds[i]);
+    const vtkIdType* cells = links.GetTriangles(pointIds[i]);
+    for (vtkIdType j = 0; j < numCells; ++j)
+    {
+      const vtkIdType* pts = triangles.data() + 3 * cells[j];
+      for (int k = 0; k < 3; ++k)
+      {
+        functor(pts[k]);
+      }
+    }
+  }
+}
+
+bool vtkDecimationSameTriangle(const vtkIdType* pts0, const vtkIdType* pts1)
+{
+  return vtkDecimationHasPoint(pts1, pts0[0]) && vtkDecimationHasPoint(pts1, pts0[1]) &&
+    vtkDecimationHasPoint(pts1, pts0[2]) && vtkDecimationHasPoint(pts0, pts1[0]) &&
+    vtkDecimationHasPoint(pts0, pts1[1]) && vtkDecimationHasPoint(pts0, pts1[2]);
+}
+
+// Per thread buffers of the cost computation
+struct vtkDecimationBuffers
+{
+  std::vector<double> Quad;
+  std::vector<double> B;
+  std::vector<double> Data;
+  std::vector<double*> A;
+};
+
+// Keep the smallest rank claiming a point
+void vtkDecimationClaim(std::atomic<vtkIdType>& owner, vtkIdType rank)
+{
+  vtkIdType current = owner.load(std::memory_order_relaxed);
+  while (rank < current &&
+    !owner.compare_exchange_weak(current, rank, std::memory_order_relaxed))
+  {
+  }
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int vtkSMPQuadricDecimation::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  // The batches work on triangles only
+  vtkCellArray* inPolys = input->GetPolys();
+  if (inPolys && inPolys->GetNumberOfCells() > 0 && inPolys->IsHomogeneous() != 3)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+  if (!this->InitializeMesh(input))
+  {
+    return 1;
+  }
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  std::vector<vtkIdType> triangles(3 * numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType npts;
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      inPolys->GetCellAtId(triId, npts, triangles.data() + 3 * triId);
+    }
+  });
+
+  this->NumberOfComponents = 0;
+  if (this->AttributeErrorMetric)
+  {
+    this->ComputeNumberOfComponents();
+  }
+  const int quadricSize = 11 + 4 * this->NumberOfComponents;
+  const int dimension = 3 + this->NumberOfComponents + this->VolumePreservation;
+
+  // The quadrics are stored contiguously rather than allocated per point
+  std::vector<double> quadrics(numPts * quadricSize, 0.0);
+  this->ErrorQuadrics = new vtkQuadricDecimation::ErrorQuadric[numPts];
+  if (this->VolumePreservation)
+  {
+    this->VolumeConstraints = new double[numPts * 4];
+  }
+
+  std::unique_ptr<std::atomic<vtkIdType>[]> counters(new std::atomic<vtkIdType>[numPts]);
+  vtkDecimationLinks links;
+  vtkDecimationBuildLinks(triangles, numPts, counters.get(), links);
+
+  vtkDebugMacro(<< "Computing Quadrics");
+  // Each point gathers the quadrics of its triangles and of its boundary
+  // edges, so that no two threads update the same quadric.
+  vtkSMPThreadLocal<std::vector<double>> tlQEM;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double>& QEM = tlQEM.Local();
+    QEM.resize(quadricSize);
+    double n[3], d, triArea2, w;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      double* quadric = quadrics.data() + ptId * quadricSize;
+      double* volume = this->VolumePreservation ? this->VolumeConstraints + 4 * ptId : nullptr;
+      this->ErrorQuadrics[ptId].Quadric = quadric;
+      if (volume)
+      {
+        std::fill(volume, volume + 4, 0.0);
+      }
+
+      const vtkIdType numCells = links.GetNumberOfTriangles(ptId);
+      const vtkIdType* cells = links.GetTriangles(ptId);
+      for (vtkIdType i = 0; i < numCells; ++i)
+      {
+        const vtkIdType* pts = triangles.data() + 3 * cells[i];
+        triArea2 = this->ComputeTriangleQuadric(pts, QEM.data(), n, d);
+        for (int j = 0; j < quadricSize; ++j)
+        {
+          quadric[j] += QEM[j] * triArea2;
+        }
+        if (volume)
+        {
+          for (int j = 0; j < 3; ++j)
+          {
+            volume[j] += n[j] * triArea2 * 2.0;
+          }
+          volume[3] += -d * triArea2 * 2.0;
+        }
+      }
+
+      // the edges of the triangles of the point not shared by another one
+      for (vtkIdType i = 0; i < numCells; ++i)
+      {
+        const vtkIdType* pts = triangles.data() + 3 * cells[i];
+        for (int j = 0; j < 3; ++j)
+        {
+          const vtkIdType p0 = pts[j];
+          const vtkIdType p1 = pts[(j + 1) % 3];
+          if ((p0 != ptId && p1 != ptId) || p0 == p1)
+          {
+            continue;
+          }
+          const vtkIdType neiId = p0 == ptId ? p1 : p0;
+          bool boundary = true;
+          for (vtkIdType k = 0; k < numCells && boundary; ++k)
+          {
+            boundary = k == i || !vtkDecimationHasPoint(triangles.data() + 3 * cells[k], neiId);
+          }
+          if (boundary)
+          {
+            w = this->ComputeBoundaryQuadric(pts, j, QEM.data());
+            for (int k = 0; k < 11; ++k)
+            {
+              quadric[k] += QEM[k] * w;
+            }
+          }
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.2);
+
+  std::vector<vtkIdType> edgeOffsets(numPts + 1);
+  std::vector<vtkIdType> edges;
+  std::vector<double> costs;
+  std::vector<double> targets;
+  std::vector<vtkIdType> order;
+  std::vector<unsigned char> selected;
+  std::vector<vtkIdType> numShared;
+  std::vector<vtkIdType> batch;
+  vtkSMPThreadLocal<vtkDecimationBuffers> tlBuffers;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlAround;
+
+  auto isGoodPlacement = [&](vtkIdType pt0Id, vtkIdType pt1Id, const double* x) {
+    for (const vtkIdType ptId : { pt0Id, pt1Id })
+    {
+      const vtkIdType otherId = ptId == pt0Id ? pt1Id : pt0Id;
+      const vtkIdType numCells = links.GetNumberOfTriangles(ptId);
+      const vtkIdType* cells = links.GetTriangles(ptId);
+      for (vtkIdType i = 0; i < numCells; ++i)
+      {
+        const vtkIdType* pts = triangles.data() + 3 * cells[i];
+        if (vtkDecimationHasPoint(pts, otherId))
+        {
+          continue;
+        }
+        for (int j = 0; j < 3; ++j)
+        {
+          if (pts[j] == ptId)
+          {
+            double pt1[3], pt2[3], pt3[3];
+            this->Mesh->GetPoint(pts[j], pt1);
+            this->Mesh->GetPoint(pts[(j + 1) % 3], pt2);
+            this->Mesh->GetPoint(pts[(j + 2) % 3], pt3);
+            if (!this->TrianglePlaneCheck(pt1, pt2, pt3, x))
+            {
+              return false;
+            }
+          }
+        }
+      }
+    }
+    return true;
+  };
+
+  this->ActualReduction = 0.0;
+  this->NumberOfEdgeCollapses = 0;
+  vtkIdType numDeletedTris = 0;
+  bool abort = false;
+  while (!abort && this->ActualReduction < this->TargetReduction)
+  {
+    // the edges of the current mesh
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        vtkIdType numEdges = 0;
+        vtkDecimationVisitEdges(triangles, links, ptId, [&](vtkIdType) { ++numEdges; });
+        edgeOffsets[ptId + 1] = numEdges;
+      }
+    });
+    edgeOffsets[0] = 0;
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      edgeOffsets[ptId + 1] += edgeOffsets[ptId];
+    }
+    const vtkIdType numEdges = edgeOffsets[numPts];
+    edges.resize(2 * numEdges);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        vtkIdType* edge = edges.data() + 2 * edgeOffsets[ptId];
+        vtkDecimationVisitEdges(triangles, links, ptId, [&](vtkIdType neiId) {
+          *edge++ = ptId;
+          *edge++ = neiId;
+        });
+      }
+    });
+
+    // their cost and target point, the cost of poorly placed targets being
+    // the maximum
+    costs.resize(numEdges);
+    targets.resize(numEdges * dimension);
+    vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+      vtkDecimationBuffers& buffers = tlBuffers.Local();
+      if (buffers.A.empty())
+      {
+        buffers.Quad.resize(quadricSize + this->VolumePreservation);
+        buffers.B.resize(dimension);
+        buffers.Data.resize(dimension * dimension);
+        buffers.A.resize(dimension);
+        for (int i = 0; i < dimension; ++i)
+        {
+          buffers.A[i] = buffers.Data.data() + i * dimension;
+        }
+      }
+      for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+      {
+        const vtkIdType* pointIds = edges.data() + 2 * edgeId;
+        double* x = targets.data() + edgeId * dimension;
+        double cost = this->AttributeErrorMetric
+          ? this->ComputeCost2(pointIds, x, buffers.Quad.data(), buffers.B.data(), buffers.A.data())
+          : this->ComputeCost(pointIds, x, buffers.Quad.data());
+        if (!(cost < VTK_DOUBLE_MAX) || !isGoodPlacement(pointIds[0], pointIds[1], x))
+        {
+          cost = VTK_DOUBLE_MAX;
+        }
+        costs[edgeId] = cost;
+      }
+    });
+
+    // the candidates, from the cheapest edge
+    order.clear();
+    for (vtkIdType edgeId = 0; edgeId < numEdges; ++edgeId)
+    {
+      if (costs[edgeId] < VTK_DOUBLE_MAX)
+      {
+        order.push_back(edgeId);
+      }
+    }
+    if (order.empty())
+    {
+      break;
+    }
+    vtkSMPTools::Sort(order.begin(), order.end(), [&](vtkIdType e0, vtkIdType e1) {
+      return costs[e0] < costs[e1] || (costs[e0] == costs[e1] && e0 < e1);
+    });
+    const vtkIdType numCandidates = std::max<vtkIdType>(
+      1, static_cast<vtkIdType>(std::ceil(this->BatchFraction * order.size())));
+
+    // each candidate claims the points of the triangles around it, the
+    // cheapest one winning
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        counters[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numCandidates, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType rank = begin; rank < end; ++rank)
+      {
+        vtkDecimationVisitNeighborhood(triangles, links, edges.data() + 2 * order[rank],
+          [&](vtkIdType ptId) { vtkDecimationClaim(counters[ptId], rank); });
+      }
+    });
+    selected.resize(numCandidates);
+    numShared.resize(numCandidates);
+    vtkSMPTools::For(0, numCandidates, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType rank = begin; rank < end; ++rank)
+      {
+        bool owned = true;
+        vtkDecimationVisitNeighborhood(triangles, links, edges.data() + 2 * order[rank],
+          [&](vtkIdType ptId) {
+            owned = owned && counters[ptId].load(std::memory_order_relaxed) == rank;
+          });
+        selected[rank] = owned;
+
+        const vtkIdType* pointIds = edges.data() + 2 * order[rank];
+        const vtkIdType numCells = links.GetNumberOfTriangles(pointIds[0]);
+        const vtkIdType* cells = links.GetTriangles(pointIds[0]);
+        numShared[rank] = std::count_if(cells, cells + numCells, [&](vtkIdType triId) {
+          return vtkDecimationHasPoint(triangles.data() + 3 * triId, pointIds[1]);
+        });
+      }
+    });
+
+    // the independent collapses, up to the target reduction
+    batch.clear();
+    vtkIdType numToDelete = numDeletedTris;
+    for (vtkIdType rank = 0; rank < numCandidates; ++rank)
+    {
+      if (static_cast<double>(numToDelete) / numTris >= this->TargetReduction)
+      {
+        break;
+      }
+      if (selected[rank])
+      {
+        batch.push_back(order[rank]);
+        numToDelete += numShared[rank];
+      }
+    }
+
+    // collapse them, keeping the first point of the edges
+    vtkSMPThreadLocal<vtkIdType> tlNumDeleted(0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(batch.size()), [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType& numDeleted = tlNumDeleted.Local();
+      std::vector<vtkIdType>& around = tlAround.Local();
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkIdType endPtIds[2] = { edges[2 * batch[i]], edges[2 * batch[i] + 1] };
+        this->SetPointAttributeArray(endPtIds, targets.data() + batch[i] * dimension);
+        this->AddQuadric(endPtIds[1], endPtIds[0]);
+
+        around.clear();
+        vtkIdType numCells = links.GetNumberOfTriangles(endPtIds[0]);
+        const vtkIdType* cells = links.GetTriangles(endPtIds[0]);
+        for (vtkIdType j = 0; j < numCells; ++j)
+        {
+          vtkIdType* pts = triangles.data() + 3 * cells[j];
+          if (vtkDecimationHasPoint(pts, endPtIds[1]))
+          {
+            pts[0] = -1;
+            ++numDeleted;
+          }
+          else
+          {
+            around.push_back(cells[j]);
+          }
+        }
+
+        // making sure we don't already have the triangle we're about to
+        // change each one to
+        numCells = links.GetNumberOfTriangles(endPtIds[1]);
+        cells = links.GetTriangles(endPtIds[1]);
+        for (vtkIdType j = 0; j < numCells; ++j)
+        {
+          vtkIdType* pts = triangles.data() + 3 * cells[j];
+          if (pts[0] < 0)
+          {
+            continue;
+          }
+          vtkIdType newPts[3];
+          for (int k = 0; k < 3; ++k)
+          {
+            newPts[k] = pts[k] == endPtIds[1] ? endPtIds[0] : pts[k];
+          }
+          if (std::any_of(around.begin(), around.end(), [&](vtkIdType triId) {
+                return vtkDecimationSameTriangle(newPts, triangles.data() + 3 * triId);
+              }))
+          {
+            pts[0] = -1;
+            ++numDeleted;
+          }
+          else
+          {
+            std::copy(newPts, newPts + 3, pts);
+            around.push_back(cells[j]);
+          }
+        }
+      }
+    });
+    for (const vtkIdType numDeleted : tlNumDeleted)
+    {
+      numDeletedTris += numDeleted;
+    }
+    this->NumberOfEdgeCollapses += static_cast<int>(batch.size());
+    this->ActualReduction = static_cast<double>(numDeletedTris) / numTris;
+    vtkDebugMacro(<< "Collapsed " << batch.size() << " edges among " << numCandidates
+                  << " candidates");
+
+    // drop the deleted triangles, keeping the order of the others
+    vtkIdType numLive = 0;
+    for (vtkIdType triId = 0; triId < static_cast<vtkIdType>(triangles.size() / 3); ++triId)
+    {
+      if (triangles[3 * triId] >= 0)
+      {
+        std::copy_n(triangles.begin() + 3 * triId, 3, triangles.begin() + 3 * numLive++);
+      }
+    }
+    triangles.resize(3 * numLive);
+    vtkDecimationBuildLinks(triangles, numPts, counters.get(), links);
+
+    this->UpdateProgress(0.2 + 0.8 * std::min(1.0, this->ActualReduction / this->TargetReduction));
+    abort = this->CheckAbort();
+  }
+
+  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses);
+
+  // clean up working data
+  delete[] this->ErrorQuadrics;
+  this->ErrorQuadrics = nullptr;
+  if (this->VolumePreservation)
+  {
+    delete[] this->VolumeConstraints;
+    this->VolumeConstraints = nullptr;
+  }
+
+  // copy the simplified mesh from the working mesh to the output mesh
+  const vtkIdType numLive = static_cast<vtkIdType>(triangles.size() / 3);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numLive + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numLive);
+  vtkSMPTools::For(0, numLive + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      offsets->SetValue(triId, 3 * triId);
+    }
+  });
+  std::copy(triangles.begin(), triangles.end(), connectivity->GetPointer(0));
+  vtkNew<vtkCellArray> polys;
+  polys->SetData(offsets, connectivity);
+  this->Mesh->SetPolys(polys);
+  this->GenerateOutput(output);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Batch Fraction: " << this->BatchFraction << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkSMPQuadricDecimation
+ * @brief   a subclass of vtkQuadricDecimation that collapses edges in parallel
+ *
+ * vtkSMPQuadricDecimation reduces the number of triangles of a mesh with the
+ * quadric error metric of vtkQuadricDecimation, using multiple threads to
+ * decimate large meshes such as isosurfaces of tens of millions of
+ * triangles. The quadrics of the points are computed concurrently. Edges are
+ * then collapsed in batches rather than one at a time: the costs of all the
+ * edges are computed concurrently, and among the cheapest edges (see
+ * BatchFraction) the edges whose neighborhoods do not overlap are collapsed
+ * concurrently. Each edge claims the points of the triangles around it, and
+ * keeps its claim on a point only if no cheaper edge claims it as well, so
+ * the cheapest edge of the mesh is always collapsed. Batches are repeated
+ * until TargetReduction is reached or no edge can be collapsed.
+ *
+ * The boundary constraints, the attribute error metric and its weights,
+ * volume preservation, regularization and MapPointData behave as in
+ * vtkQuadricDecimation.
+ *
+ * @warning
+ * The output differs from the one of vtkQuadricDecimation since edges are not
+ * collapsed in strict order of increasing cost: the edges collapsed by a
+ * batch cost no more than the cheapest BatchFraction of the edges of the mesh
+ * at that point. The output does not depend on the number of threads. Inputs
+ * with polygons that are not triangles are decimated by the serial algorithm.
+ *
+ * @sa
+ * vtkQuadricDecimation vtkSMPTools
+ */
+
+#ifndef vtkSMPQuadricDecimation_h
+#define vtkSMPQuadricDecimation_h
+
+#include "vtkFiltersSMPModule.h" // For export macro
+#include "vtkQuadricDecimation.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKFILTERSSMP_EXPORT vtkSMPQuadricDecimation : public vtkQuadricDecimation
+{
+public:
+  vtkTypeMacro(vtkSMPQuadricDecimation, vtkQuadricDecimation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Construct object with the defaults of vtkQuadricDecimation and a batch
+   * fraction of 0.25.
+   */
+  static vtkSMPQuadricDecimation* New();
+
+  ///@{
+  /**
+   * Specify the fraction of the edges, the cheapest ones, among which each
+   * batch selects the edges to collapse. Smaller fractions follow the order
+   * of the serial algorithm more closely, at the cost of more batches. At 0,
+   * a single edge is collapsed per batch. The default is 0.25.
+   */
+  vtkSetClampMacro(BatchFraction, double, 0.0, 1.0);
+  vtkGetMacro(BatchFraction, double);
+  ///@}
+
+protected:
+  vtkSMPQuadricDecimation();
+  ~vtkSMPQuadricDecimation() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  double BatchFraction;
+
+private:
+  vtkSMPQuadricDecimation(const vtkSMPQuadricDecimation&) = delete;
+  void operator=(const vtkSMPQuadricDecimation&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkFileResourceStream.h"
+#include "vtkMappedFileResourceStream.h"
 #include "vtkMemoryResourceStream.h"
 #include "vtkNew.h"
 #include "vtkTestUtilities.h"
@@ -103,6 +104,33 @@ bool TestFileResource(const std::string& temp_dir)
   return TestStream(file);
 }
 
+bool TestMappedFileResource(const std::string& temp_dir)
+{
+  const auto file_path = temp_dir + "/resmaptmp.txt";
+
+  vtksys::ofstream{ file_path.c_str(), std::ios_base::binary } << "Hello world!";
+
+  vtkNew<vtkMappedFileResourceStream> file;
+  Check(file->Open(file_path.c_str()), "Failed to open file");
+  Check(file->GetSize() == 12, "Wrong mapped size");
+  Check(std::strncmp(reinterpret_cast<const char*>(file->GetData()), "Hello world!", 12) == 0,
+    "Wrong mapped data");
+
+  Check(!file->Open(nullptr), "Open(nullptr) must return false");
+  Check(file->GetData() == nullptr && file->GetSize() == 0, "Closed file must be empty");
+  Check(file->EndOfStream(), "Closed file must be at end of stream");
+
+  Check(file->Open(file_path.c_str()), "Failed to open file");
+  Check(TestStream(file), "Basic checks failed");
+
+  const auto empty_path = temp_dir + "/resmapempty.txt";
+  vtksys::ofstream{ empty_path.c_str(), std::ios_base::binary } << "";
+  Check(file->Open(empty_path.c_str()), "Failed to open empty file");
+  Check(file->GetSize() == 0 && file->EndOfStream(), "Empty file must be at end of stream");
+
+  return true;
+}
+
 bool TestMemoryResource()
 {
   const std::string str{ "Hello world!" };
@@ -159,6 +187,11 @@ int TestResourceStreams(int argc, char* argv[])
   {
     return 1;
   }
+
+  if (!TestMappedFileResource(tempDir))
+  {
+    return 1;
+  }
   delete[] tempDir;
 
   if (!TestMemoryResource())
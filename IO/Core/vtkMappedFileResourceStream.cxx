@@ -0,0 +1,254 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMappedFileResourceStream.h"
+
+#include "vtkObjectFactory.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm> // std::min
+#include <cstring>   // std::memcpy
+#include <vector>    // std::vector
+
+#if defined(_WIN32)
+#include <vtksys/Encoding.hxx>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+
+vtkStandardNewMacro(vtkMappedFileResourceStream);
+
+//------------------------------------------------------------------------------
+struct vtkMappedFileResourceStream::vtkInternals
+{
+  ~vtkInternals() { this->Close(); }
+
+  bool Map(const char* path)
+  {
+#if defined(_WIN32)
+    std::wstring wpath = vtksys::Encoding::ToWindowsExtendedPath(path);
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+      CloseHandle(file);
+      return false;
+    }
+    this->Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!this->Mapping)
+    {
+      return false;
+    }
+    this->View = MapViewOfFile(this->Mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!this->View)
+    {
+      CloseHandle(this->Mapping);
+      this->Mapping = nullptr;
+      return false;
+    }
+    this->Size = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+      close(fd);
+      return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+      return false;
+    }
+    this->View = view;
+    this->Size = static_cast<std::size_t>(st.st_size);
+#endif
+    this->Data = static_cast<const unsigned char*>(this->View);
+    return true;
+  }
+
+  bool Load(const char* path)
+  {
+    vtksys::ifstream file(path, std::ios_base::binary);
+    if (!file.is_open())
+    {
+      return false;
+    }
+    file.seekg(0, std::ios_base::end);
+    const auto size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0, std::ios_base::beg);
+    this->Buffer.resize(size);
+    file.read(reinterpret_cast<char*>(this->Buffer.data()), size);
+    this->Buffer.resize(static_cast<std::size_t>(file.gcount()));
+    this->Data = this->Buffer.empty() ? nullptr : this->Buffer.data();
+    this->Size = this->Buffer.size();
+    return true;
+  }
+
+  void Close()
+  {
+#if defined(_WIN32)
+    if (this->View)
+    {
+      UnmapViewOfFile(this->View);
+    }
+    if (this->Mapping)
+    {
+      CloseHandle(this->Mapping);
+    }
+    this->Mapping = nullptr;
+#else
+    if (this->View)
+    {
+      munmap(this->View, this->Size);
+    }
+#endif
+    this->View = nullptr;
+    this->Buffer.clear();
+    this->Buffer.shrink_to_fit();
+    this->Data = nullptr;
+    this->Size = 0;
+    this->Pos = 0;
+    this->Eos = true;
+  }
+
+  void* View = nullptr;
+#if defined(_WIN32)
+  HANDLE Mapping = nullptr;
+#endif
+  std::vector<unsigned char> Buffer;
+  const unsigned char* Data = nullptr;
+  std::size_t Size = 0;
+  vtkTypeInt64 Pos = 0;
+  bool Eos = true;
+};
+
+//------------------------------------------------------------------------------
+vtkMappedFileResourceStream::vtkMappedFileResourceStream()
+  : vtkResourceStream{ true }
+  , Impl{ new vtkMappedFileResourceStream::vtkInternals }
+{
+}
+
+//------------------------------------------------------------------------------
+vtkMappedFileResourceStream::~vtkMappedFileResourceStream() = default;
+
+//------------------------------------------------------------------------------
+bool vtkMappedFileResourceStream::Open(VTK_FILEPATH const char* path)
+{
+  this->Impl->Close();
+
+  bool opened = false;
+  if (path)
+  {
+    // Empty files cannot be mapped, reading them gives an empty stream.
+    opened = this->Impl->Map(path) || this->Impl->Load(path);
+  }
+  this->Impl->Eos = (this->Impl->Size == 0);
+
+  this->Modified();
+  return opened;
+}
+
+//------------------------------------------------------------------------------
+const unsigned char* vtkMappedFileResourceStream::GetData() const
+{
+  return this->Impl->Data;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMappedFileResourceStream::GetSize() const
+{
+  return this->Impl->Size;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMappedFileResourceStream::IsMapped() const
+{
+  return this->Impl->View != nullptr;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMappedFileResourceStream::Read(void* buffer, std::size_t bytes)
+{
+  if (bytes == 0)
+  {
+    return 0;
+  }
+
+  const auto sbytes = static_cast<vtkTypeInt64>(bytes);
+  const auto ssize = static_cast<vtkTypeInt64>(this->Impl->Size);
+  const auto read = std::min(sbytes, ssize - this->Impl->Pos);
+
+  if (read <= 0)
+  {
+    this->Impl->Eos = true;
+    return 0;
+  }
+
+  std::memcpy(buffer, this->Impl->Data + this->Impl->Pos, static_cast<std::size_t>(read));
+  this->Impl->Pos += read;
+  this->Impl->Eos = read != sbytes;
+
+  return static_cast<std::size_t>(read);
+}
+
+//------------------------------------------------------------------------------
+bool vtkMappedFileResourceStream::EndOfStream()
+{
+  return this->Impl->Eos;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkMappedFileResourceStream::Seek(vtkTypeInt64 pos, SeekDirection dir)
+{
+  if (dir == SeekDirection::Begin)
+  {
+    this->Impl->Pos = pos;
+  }
+  else if (dir == SeekDirection::Current)
+  {
+    this->Impl->Pos += pos;
+  }
+  else
+  {
+    this->Impl->Pos = static_cast<vtkTypeInt64>(this->Impl->Size) + pos;
+  }
+
+  this->Impl->Eos = false;
+  return this->Impl->Pos;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkMappedFileResourceStream::Tell()
+{
+  return this->Impl->Pos;
+}
+
+//------------------------------------------------------------------------------
+void vtkMappedFileResourceStream::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Mapped: " << (this->IsMapped() ? "true" : "false") << "\n";
+  os << indent << "Size: " << this->Impl->Size << "o\n";
+  os << indent << "Position: " << this->Impl->Pos << "\n";
+}
+
+VTK_ABI_NAMESPACE_END
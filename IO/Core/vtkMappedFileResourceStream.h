@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkMappedFileResourceStream_h
+#define vtkMappedFileResourceStream_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkResourceStream.h"
+
+#include <memory> // for std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * @brief vtkResourceStream implementation for memory-mapped file input
+ *
+ * The whole file is mapped read-only in memory. It can be streamed like any
+ * other vtkResourceStream, and its content can also be accessed directly with
+ * `GetData` and `GetSize`, which lets readers decode or parse large files
+ * concurrently without copying them. When the file cannot be mapped, its
+ * content is read into an internal buffer instead.
+ */
+class VTKIOCORE_EXPORT vtkMappedFileResourceStream : public vtkResourceStream
+{
+  struct vtkInternals;
+
+public:
+  vtkTypeMacro(vtkMappedFileResourceStream, vtkResourceStream);
+  static vtkMappedFileResourceStream* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * @brief Open and map a file
+   *
+   * Opening a file releases the previous mapping, if any, and resets the
+   * stream to initial position: Tell() = 0.
+   * EndOfStream is set to true if file opening failed or if the file is empty.
+   * If path is nullptr, the file will only be closed.
+   * This function will increase modified time.
+   *
+   * @param path the file path
+   * @return true if file was successfully opened, false otherwise.
+   * Return false if path is nullptr.
+   */
+  bool Open(VTK_FILEPATH const char* path);
+
+  /**
+   * @brief Get the content of the opened file
+   *
+   * The returned pointer stays valid until the file is closed, another file
+   * is opened or the stream is destroyed. Returns nullptr if no file is open
+   * or if it is empty.
+   */
+  const unsigned char* GetData() const;
+
+  /**
+   * @brief Get the size in bytes of the opened file
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Return true if the content is mapped rather than read in memory
+   */
+  bool IsMapped() const;
+
+  ///@{
+  /**
+   * @brief Override vtkResourceStream functions
+   */
+  std::size_t Read(void* buffer, std::size_t bytes) override;
+  bool EndOfStream() override;
+  vtkTypeInt64 Seek(vtkTypeInt64 pos, SeekDirection dir) override;
+  vtkTypeInt64 Tell() override;
+  ///@}
+
+protected:
+  vtkMappedFileResourceStream();
+  ~vtkMappedFileResourceStream() override;
+  vtkMappedFileResourceStream(const vtkMappedFileResourceStream&) = delete;
+  vtkMappedFileResourceStream& operator=(const vtkMappedFileResourceStream&) = delete;
+
+private:
+  std::unique_ptr<vtkInternals> Impl;
+};
+
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -312,6 +312,8 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->IgnoreFileTime = false;
 
+  this->OutputInformation = nullptr;
+
   this->GenerateObjectIdArray = 1;
   this->GenerateGlobalElementIdArray = 0;
   this->GenerateGlobalNodeIdArray = 0;
@@ -563,7 +565,9 @@ int vtkExodusIIReaderPrivate::AssembleOutputPointArrays(
   for (ai = this->ArrayInfo[vtkExodusIIReader::NODAL].begin();
        ai != this->ArrayInfo[vtkExodusIIReader::NODAL].end(); ++ai, ++aidx)
   {
-    if (!ai->Status)
+    if (!ai->Status ||
+      !vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+        this->OutputInformation, vtkDataObject::POINT, ai->Name.c_str()))
       continue; // Skip arrays we don't want.
 
     vtkExodusIICacheKey key(timeStep, vtkExodusIIReader::NODAL, 0, aidx);
@@ -686,6 +690,10 @@ int vtkExodusIIReaderPrivate::AssembleOutputCellArrays(
     if (!ai->ObjectTruth[obj])
       continue;
 
+    if (!vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+          this->OutputInformation, vtkDataObject::CELL, ai->Name.c_str()))
+      continue;
+
     vtkDataArray* arr = this->GetCacheOrRead(vtkExodusIICacheKey(timeStep, ami->first, obj, aidx));
     if (arr)
     {
@@ -892,7 +900,9 @@ int vtkExodusIIReaderPrivate::AssembleOutputGlobalArrays(
   for (ai = this->ArrayInfo[vtkExodusIIReader::GLOBAL].begin();
        ai != this->ArrayInfo[vtkExodusIIReader::GLOBAL].end(); ++ai, ++aidx)
   {
-    if (!ai->Status)
+    if (!ai->Status ||
+      !vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+        this->OutputInformation, vtkDataObject::FIELD, ai->Name.c_str()))
     {
       continue;
     }
@@ -5588,7 +5598,9 @@ int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  this->Metadata->SetOutputInformation(outInfo);
   this->Metadata->RequestData(this->TimeStep, output);
+  this->Metadata->SetOutputInformation(nullptr);
 
   return 1;
 }
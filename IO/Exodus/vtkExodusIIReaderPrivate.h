@@ -21,6 +21,7 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkDataArray;
 class vtkExodusIIReaderParser;
 class vtkIdTypeArray;
+class vtkInformation;
 class vtkMultiBlockDataSet;
 class vtkMutableDirectedGraph;
 class vtkTypeInt64Array;
@@ -52,6 +53,10 @@ public:
   /// Read requested data and store in unstructured grid.
   int RequestData(vtkIdType timeStep, vtkMultiBlockDataSet* output);
 
+  /// Set the output information of the request being executed, used by
+  /// RequestData() to read only the arrays requested downstream.
+  void SetOutputInformation(vtkInformation* info) { this->OutputInformation = info; }
+
   /** Description:
    * Prepare a data set with the proper structure and arrays but no cells.
    * This is used by the parallel reader when a process has no files assigned to it.
@@ -824,6 +829,9 @@ protected:
 
   bool IgnoreFileTime;
 
+  /// The output information of the request being executed, or nullptr.
+  vtkInformation* OutputInformation;
+
   /** Should the reader output only points used by elements in the output mesh,
    * or all the points. Outputting all the points is much faster since the
    * point array can be read straight from disk and the mesh connectivity need
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that parallel OBJ parsing gives the same output as the serial path,
+// from a file and from a stream, including when it has to fall back to it.
+
+#include "vtkMemoryResourceStream.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestSMPUtilities.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+struct OBJOutput
+{
+  vtkSmartPointer<vtkPolyData> Data;
+  std::string Comment;
+};
+
+OBJOutput ReadOBJ(const std::string& fileName, const std::string& content, bool parallel)
+{
+  vtkNew<vtkOBJReader> reader;
+  vtkNew<vtkMemoryResourceStream> stream;
+  if (fileName.empty())
+  {
+    stream->SetBuffer(content.data(), content.size());
+    reader->SetStream(stream);
+  }
+  else
+  {
+    reader->SetFileName(fileName.c_str());
+  }
+  reader->SetParallelReading(parallel);
+  reader->Update();
+  OBJOutput output;
+  output.Data = reader->GetOutput();
+  output.Comment = reader->GetComment() ? reader->GetComment() : "";
+  return output;
+}
+
+bool SameOutput(const OBJOutput& expected, const OBJOutput& actual)
+{
+  return expected.Comment == actual.Comment && vtkTest::SamePolyData(expected.Data, actual.Data);
+}
+
+// A grid of quads split in groups and materials, large enough to be split in
+// several chunks.
+std::string MakeOBJ(int resolution)
+{
+  std::ostringstream obj;
+  obj << "# Parallel OBJ test\n#  second comment line\n";
+  obj << "mtllib grid.mtl\n";
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      obj << "v " << i * 0.25 << " " << j * -0.5 << " " << 1.0 / (i + j + 1) << "\n";
+      obj << "vt " << i / static_cast<double>(resolution) << " "
+          << j / static_cast<double>(resolution) << "\n";
+    }
+  }
+  obj << "vn 0 0 1\nvn 0 1 0\n";
+  for (int j = 0; j + 1 < resolution; ++j)
+  {
+    if (j % 37 == 0)
+    {
+      obj << "g row" << j << "\n";
+    }
+    if (j % 53 == 0)
+    {
+      obj << "usemtl material" << (j / 53) % 3 << "\n";
+    }
+    if (j % 41 == 0)
+    {
+      obj << "# row " << j << "\n";
+    }
+    for (int i = 0; i + 1 < resolution; ++i)
+    {
+      const int a = j * resolution + i + 1;
+      const int b = a + 1;
+      const int c = a + resolution + 1;
+      const int d = a + resolution;
+      if (i % 3 == 0)
+      {
+        obj << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << c << "/" << c << "/2 "
+            << d << "/" << d << "/2\n";
+      }
+      else if (i % 3 == 1)
+      {
+        obj << "f " << a << "//1 " << b << "//2\t" << c << "//1\r\n";
+      }
+      else
+      {
+        // Relative indices
+        const int count = resolution * resolution;
+        obj << "f " << a - count - 1 << " " << c - count - 1 << " " << d - count - 1 << "\n";
+      }
+    }
+  }
+  return obj.str();
+}
+}
+
+int TestOBJReaderParallel(int argc, char* argv[])
+{
+  char* temp_dir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!temp_dir)
+  {
+    std::cerr << "Could not determine temporary directory." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(temp_dir) + "/TestOBJReaderParallel.obj";
+  delete[] temp_dir;
+
+  const std::string content = MakeOBJ(200);
+  // Line elements are only handled by the serial parser.
+  const std::string fallbackContent = content + "l 1 2 3\n";
+
+  int status = EXIT_SUCCESS;
+  for (const std::string* obj : { &content, &fallbackContent })
+  {
+    {
+      std::ofstream file(fileName, std::ios::binary);
+      file << *obj;
+    }
+    const OBJOutput serial = ReadOBJ(fileName, *obj, false);
+    if (serial.Data->GetNumberOfPolys() == 0 || serial.Comment.empty())
+    {
+      std::cerr << "Unexpected serial output." << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!SameOutput(serial, ReadOBJ(fileName, *obj, true)))
+    {
+      std::cerr << "Parallel parsing of the file differs." << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (!SameOutput(serial, ReadOBJ("", *obj, true)))
+    {
+      std::cerr << "Parallel parsing of the stream differs." << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that parallel STL reading and merging give the same output as the
+// serial path, for binary and ASCII files.
+
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestSMPUtilities.h"
+#include "vtkTestUtilities.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> ReadSTL(const std::string& fileName, bool merging, bool parallel)
+{
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMerging(merging);
+  reader->SetParallelReading(parallel);
+  reader->Update();
+  return reader->GetOutput();
+}
+}
+
+int TestSTLReaderParallel(int argc, char* argv[])
+{
+  char* temp_dir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!temp_dir)
+  {
+    std::cerr << "Could not determine temporary directory." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string tempDir = temp_dir;
+  delete[] temp_dir;
+
+  // Collapse a few points onto the poles so that some triangles become
+  // degenerate once merged.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  sphere->Update();
+  vtkNew<vtkPolyData> mesh;
+  mesh->DeepCopy(sphere->GetOutput());
+  for (vtkIdType i = 2; i < 10; ++i)
+  {
+    mesh->GetPoints()->SetPoint(i, mesh->GetPoints()->GetPoint(0));
+  }
+
+  int status = EXIT_SUCCESS;
+  for (int fileType : { VTK_BINARY, VTK_ASCII })
+  {
+    const std::string fileName = tempDir + "/TestSTLReaderParallel" +
+      (fileType == VTK_BINARY ? "Binary" : "ASCII") + ".stl";
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetInputData(mesh);
+    writer->SetFileName(fileName.c_str());
+    writer->SetFileType(fileType);
+    writer->Write();
+
+    for (bool merging : { true, false })
+    {
+      vtkSmartPointer<vtkPolyData> serial = ReadSTL(fileName, merging, false);
+      vtkSmartPointer<vtkPolyData> parallel = ReadSTL(fileName, merging, true);
+      if (serial->GetNumberOfCells() == 0 || !vtkTest::SamePolyData(serial, parallel))
+      {
+        std::cerr << "Parallel reading differs for file type " << fileType << " with merging "
+                  << merging << std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  return status;
+}
@@ -6,25 +6,605 @@
 #include "vtkCellData.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMappedFileResourceStream.h"
+#include "vtkMemoryResourceStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkResourceParser.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
+#include "vtkValueFromString.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstring>
 #include <sstream>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace
+{
+// Contents smaller than this are not split further.
+constexpr std::size_t OBJMinimumChunkSize = 1 << 18;
+
+// Whitespace inside a line, as seen by the serial parser.
+inline bool vtkOBJIsBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// Return the end of the line starting at `begin`, that is its '\n' or `end`.
+// A '\r' that is not followed by '\n' is a new line for the serial parser, so
+// `valid` is set to false when the line contains one.
+const char* vtkOBJLineEnd(const char* begin, const char* end, bool& valid)
+{
+  const char* eol = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+  if (!eol)
+  {
+    eol = end;
+  }
+  const char* cr = static_cast<const char*>(std::memchr(begin, '\r', eol - begin));
+  if (cr && cr + 1 != eol)
+  {
+    valid = false;
+  }
+  return eol;
+}
+
+// Get the next whitespace separated token of [pos, end).
+bool vtkOBJNextToken(const char*& pos, const char* end, const char*& first, const char*& last)
+{
+  while (pos != end && vtkOBJIsBlank(*pos))
+  {
+    ++pos;
+  }
+  if (pos == end)
+  {
+    return false;
+  }
+  first = pos;
+  while (pos != end && !vtkOBJIsBlank(*pos))
+  {
+    ++pos;
+  }
+  last = pos;
+  return true;
+}
+
+bool vtkOBJTokenIs(const char* first, const char* last, const char* command)
+{
+  const std::size_t size = std::strlen(command);
+  return static_cast<std::size_t>(last - first) == size && std::memcmp(first, command, size) == 0;
+}
+
+// Check that nothing but whitespace remains in [pos, end).
+bool vtkOBJLineConsumed(const char* pos, const char* end)
+{
+  while (pos != end && vtkOBJIsBlank(*pos))
+  {
+    ++pos;
+  }
+  return pos == end;
+}
+
+// Parse a whole token of [pos, end) as a value.
+template <typename T>
+bool vtkOBJParseValue(const char*& pos, const char* end, T& value)
+{
+  while (pos != end && vtkOBJIsBlank(*pos))
+  {
+    ++pos;
+  }
+  const std::size_t consumed = vtkValueFromString(pos, end, value);
+  if (consumed == 0)
+  {
+    return false;
+  }
+  pos += consumed;
+  return pos == end || vtkOBJIsBlank(*pos);
+}
+
+// Parse an index of a face token, stopping at '/' or at the end of the token.
+bool vtkOBJParseIndex(const char*& pos, const char* end, int& value)
+{
+  const std::size_t consumed = vtkValueFromString(pos, end, value);
+  if (consumed == 0)
+  {
+    return false;
+  }
+  pos += consumed;
+  return pos == end || *pos == '/' || vtkOBJIsBlank(*pos);
+}
+
+// Parse a `v`, `v/vt`, `v//vn` or `v/vt/vn` face token starting at `pos`.
+bool vtkOBJParseFaceToken(
+  const char*& pos, const char* end, int indices[3], bool& hasTCoord, bool& hasNormal)
+{
+  hasTCoord = false;
+  hasNormal = false;
+  if (!vtkOBJParseIndex(pos, end, indices[0]))
+  {
+    return false;
+  }
+  if (pos != end && *pos == '/')
+  {
+    ++pos;
+    if (pos == end || *pos != '/')
+    {
+      if (!vtkOBJParseIndex(pos, end, indices[1]))
+      {
+        return false;
+      }
+      hasTCoord = true;
+    }
+    if (pos != end && *pos == '/')
+    {
+      ++pos;
+      if (!vtkOBJParseIndex(pos, end, indices[2]) || (pos != end && *pos == '/'))
+      {
+        return false;
+      }
+      hasNormal = true;
+    }
+  }
+  return pos == end || vtkOBJIsBlank(*pos);
+}
+
+// Sizes of the data held by a chunk of lines, or offsets of this data in the
+// output arrays once accumulated over the previous chunks.
+struct vtkOBJCounts
+{
+  vtkIdType Points = 0;
+  vtkIdType TCoords = 0;
+  vtkIdType Normals = 0;
+  vtkIdType Faces = 0;
+  vtkIdType FaceIds = 0;
+  vtkIdType FaceTCoordIds = 0;
+  vtkIdType FaceNormalIds = 0;
+
+  void operator+=(const vtkOBJCounts& other)
+  {
+    this->Points += other.Points;
+    this->TCoords += other.TCoords;
+    this->Normals += other.Normals;
+    this->Faces += other.Faces;
+    this->FaceIds += other.FaceIds;
+    this->FaceTCoordIds += other.FaceTCoordIds;
+    this->FaceNormalIds += other.FaceNormalIds;
+  }
+
+  bool operator==(const vtkOBJCounts& other) const
+  {
+    return this->Points == other.Points && this->TCoords == other.TCoords &&
+      this->Normals == other.Normals && this->Faces == other.Faces &&
+      this->FaceIds == other.FaceIds && this->FaceTCoordIds == other.FaceTCoordIds &&
+      this->FaceNormalIds == other.FaceNormalIds;
+  }
+};
+
+struct vtkOBJChunk
+{
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+  bool Valid = true;
+  vtkOBJCounts Count;
+  vtkOBJCounts Offset;
+  int Groups = 0;
+  int GroupsBeforeFirstFace = -1;
+  int GroupOffset = 0;
+  bool TCoordsMatchVertices = true;
+  bool NormalsMatchVertices = true;
+  // "usemtl" names with the number of faces of the chunk before them.
+  std::vector<std::pair<vtkIdType, std::string>> Materials;
+  // "mtllib" names.
+  std::vector<std::string> Libraries;
+};
+
+// Output of the parallel parsing.
+struct vtkOBJParallelResult
+{
+  int GroupId = -1;
+  bool TCoordsMatchVertices = true;
+  bool NormalsMatchVertices = true;
+  // "usemtl" names with the number of faces before them.
+  std::vector<std::pair<vtkIdType, std::string>> Materials;
+  std::vector<std::string> Libraries;
+};
+
+// Return the end of the comment lines at the beginning of [begin, end). These
+// lines form the file comment and are left to the serial parser.
+const char* vtkOBJLeadingCommentsEnd(const char* begin, const char* end, bool& valid)
+{
+  const char* pos = begin;
+  while (pos != end)
+  {
+    const char* eol = vtkOBJLineEnd(pos, end, valid);
+    const char* cursor = pos;
+    const char* first;
+    const char* last;
+    if (!vtkOBJNextToken(cursor, eol, first, last) || *first != '#')
+    {
+      break;
+    }
+    pos = eol == end ? end : eol + 1;
+  }
+  return pos;
+}
+
+// First pass: count the elements of each kind in a chunk. Point and line
+// elements are not supported.
+void vtkOBJCountChunk(vtkOBJChunk& chunk)
+{
+  const char* pos = chunk.Begin;
+  while (pos != chunk.End && chunk.Valid)
+  {
+    const char* eol = vtkOBJLineEnd(pos, chunk.End, chunk.Valid);
+    const char* cursor = pos;
+    pos = eol == chunk.End ? chunk.End : eol + 1;
+
+    const char* first;
+    const char* last;
+    if (!vtkOBJNextToken(cursor, eol, first, last) || *first == '#')
+    {
+      continue;
+    }
+    if (vtkOBJTokenIs(first, last, "v"))
+    {
+      ++chunk.Count.Points;
+    }
+    else if (vtkOBJTokenIs(first, last, "vt"))
+    {
+      ++chunk.Count.TCoords;
+    }
+    else if (vtkOBJTokenIs(first, last, "vn"))
+    {
+      ++chunk.Count.Normals;
+    }
+    else if (vtkOBJTokenIs(first, last, "g"))
+    {
+      ++chunk.Groups;
+    }
+    else if (vtkOBJTokenIs(first, last, "f"))
+    {
+      if (chunk.GroupsBeforeFirstFace < 0)
+      {
+        chunk.GroupsBeforeFirstFace = chunk.Groups;
+      }
+      // The first vertex tells which indices all vertices of the face have.
+      vtkIdType numberOfIds = 0;
+      bool hasTCoord = false;
+      bool hasNormal = false;
+      while (vtkOBJNextToken(cursor, eol, first, last))
+      {
+        if (numberOfIds == 0)
+        {
+          const char* slash = static_cast<const char*>(std::memchr(first, '/', last - first));
+          if (slash)
+          {
+            hasTCoord = slash + 1 != last && slash[1] != '/';
+            hasNormal = std::memchr(slash + 1, '/', last - slash - 1) != nullptr;
+          }
+        }
+        ++numberOfIds;
+      }
+      ++chunk.Count.Faces;
+      chunk.Count.FaceIds += numberOfIds;
+      chunk.Count.FaceTCoordIds += hasTCoord ? numberOfIds : 0;
+      chunk.Count.FaceNormalIds += hasNormal ? numberOfIds : 0;
+    }
+    else if (vtkOBJTokenIs(first, last, "p") || vtkOBJTokenIs(first, last, "l"))
+    {
+      chunk.Valid = false;
+    }
+  }
+}
+
+// Second pass: parse a chunk into the output arrays at the chunk offsets.
+// Return false on anything the serial parser reports.
+bool vtkOBJParseChunk(vtkOBJChunk& chunk, double* points, float* tcoords, float* normals,
+  vtkIdType* offsets, vtkIdType* ids, vtkIdType* tcoordOffsets, vtkIdType* tcoordIds,
+  vtkIdType* normalOffsets, vtkIdType* normalIds, float* groupIds)
+{
+  vtkOBJCounts local;
+  int groups = 0;
+  const char* pos = chunk.Begin;
+  while (pos != chunk.End)
+  {
+    const char* eol = vtkOBJLineEnd(pos, chunk.End, chunk.Valid);
+    const bool terminated = eol != chunk.End;
+    const char* cursor = pos;
+    pos = terminated ? eol + 1 : chunk.End;
+
+    const char* first;
+    const char* last;
+    if (!vtkOBJNextToken(cursor, eol, first, last) || *first == '#')
+    {
+      continue;
+    }
+    if (vtkOBJTokenIs(first, last, "v") || vtkOBJTokenIs(first, last, "vt"))
+    {
+      const bool isPoint = last - first == 1;
+      const int size = isPoint ? 3 : 2;
+      double values[3];
+      for (int i = 0; i < size; ++i)
+      {
+        if (!vtkOBJParseValue(cursor, eol, values[i]))
+        {
+          return false;
+        }
+      }
+      // A last optional value is ignored, but must end the line
+      double optional;
+      if (!vtkOBJLineConsumed(cursor, eol) &&
+        !(vtkOBJParseValue(cursor, eol, optional) && vtkOBJLineConsumed(cursor, eol) && terminated))
+      {
+        return false;
+      }
+      if (isPoint)
+      {
+        std::copy(values, values + 3, points + 3 * (chunk.Offset.Points + local.Points++));
+      }
+      else
+      {
+        float* tcoord = tcoords + 2 * (chunk.Offset.TCoords + local.TCoords++);
+        tcoord[0] = static_cast<float>(values[0]);
+        tcoord[1] = static_cast<float>(values[1]);
+      }
+    }
+    else if (vtkOBJTokenIs(first, last, "vn"))
+    {
+      float* normal = normals + 3 * (chunk.Offset.Normals + local.Normals++);
+      for (int i = 0; i < 3; ++i)
+      {
+        double value;
+        if (!vtkOBJParseValue(cursor, eol, value))
+        {
+          return false;
+        }
+        normal[i] = static_cast<float>(value);
+      }
+      if (!vtkOBJLineConsumed(cursor, eol) || !terminated)
+      {
+        return false;
+      }
+    }
+    else if (vtkOBJTokenIs(first, last, "g"))
+    {
+      ++groups;
+    }
+    else if (vtkOBJTokenIs(first, last, "usemtl") || vtkOBJTokenIs(first, last, "mtllib"))
+    {
+      const bool isMaterial = last - first == 6 && first[0] == 'u';
+      if (!vtkOBJNextToken(cursor, eol, first, last) || !vtkOBJLineConsumed(cursor, eol) ||
+        !terminated)
+      {
+        return false;
+      }
+      if (isMaterial)
+      {
+        chunk.Materials.emplace_back(local.Faces, std::string(first, last));
+      }
+      else
+      {
+        chunk.Libraries.emplace_back(first, last);
+      }
+    }
+    else if (vtkOBJTokenIs(first, last, "f"))
+    {
+      const vtkIdType face = chunk.Offset.Faces + local.Faces;
+      const vtkIdType faceIds = chunk.Offset.FaceIds + local.FaceIds;
+      const vtkIdType faceTCoordIds = chunk.Offset.FaceTCoordIds + local.FaceTCoordIds;
+      const vtkIdType faceNormalIds = chunk.Offset.FaceNormalIds + local.FaceNormalIds;
+      const vtkIdType numberOfPoints = chunk.Offset.Points + local.Points;
+      const vtkIdType numberOfTCoords = chunk.Offset.TCoords + local.TCoords;
+      const vtkIdType numberOfNormals = chunk.Offset.Normals + local.Normals;
+      offsets[face] = faceIds;
+      tcoordOffsets[face] = faceTCoordIds;
+      normalOffsets[face] = faceNormalIds;
+
+      vtkIdType count = 0;
+      bool faceHasTCoords = false;
+      bool faceHasNormals = false;
+      while (vtkOBJNextToken(cursor, eol, first, last))
+      {
+        int indices[3] = { 0, 0, 0 };
+        bool hasTCoord;
+        bool hasNormal;
+        const char* token = first;
+        if (!vtkOBJParseFaceToken(token, last, indices, hasTCoord, hasNormal))
+        {
+          return false;
+        }
+        if (count == 0)
+        {
+          faceHasTCoords = hasTCoord;
+          faceHasNormals = hasNormal;
+        }
+        else if (hasTCoord != faceHasTCoords || hasNormal != faceHasNormals)
+        {
+          return false;
+        }
+
+        const vtkIdType vertex = indices[0] < 0 ? numberOfPoints + indices[0] : indices[0] - 1;
+        if (vertex < 0)
+        {
+          return false;
+        }
+        ids[faceIds + count] = vertex;
+        if (hasTCoord)
+        {
+          const vtkIdType tcoord =
+            indices[1] < 0 ? numberOfTCoords + indices[1] : indices[1] - 1;
+          if (tcoord < 0)
+          {
+            return false;
+          }
+          tcoordIds[faceTCoordIds + count] = tcoord;
+          chunk.TCoordsMatchVertices &= tcoord == vertex;
+        }
+        if (hasNormal)
+        {
+          const vtkIdType normal =
+            indices[2] < 0 ? numberOfNormals + indices[2] : indices[2] - 1;
+          if (normal < 0)
+          {
+            return false;
+          }
+          normalIds[faceNormalIds + count] = normal;
+          chunk.NormalsMatchVertices &= normal == vertex;
+        }
+        ++count;
+      }
+      if (count < 3)
+      {
+        return false;
+      }
+      groupIds[face] = static_cast<float>(chunk.GroupOffset + groups);
+      ++local.Faces;
+      local.FaceIds += count;
+      local.FaceTCoordIds += faceHasTCoords ? count : 0;
+      local.FaceNormalIds += faceHasNormals ? count : 0;
+    }
+  }
+  // Both passes must agree on the layout.
+  return chunk.Valid && local == chunk.Count;
+}
+
+void vtkOBJAllocateCells(vtkCellArray* cells, vtkIdType numberOfCells, vtkIdType numberOfIds,
+  vtkIdType*& offsets, vtkIdType*& ids)
+{
+  vtkNew<vtkIdTypeArray> offsetsArray;
+  offsetsArray->SetNumberOfValues(numberOfCells + 1);
+  offsets = offsetsArray->GetPointer(0);
+  offsets[numberOfCells] = numberOfIds;
+  vtkNew<vtkIdTypeArray> idsArray;
+  idsArray->SetNumberOfValues(numberOfIds);
+  ids = idsArray->GetPointer(0);
+  cells->SetData(offsetsArray, idsArray);
+}
+
+// Parse the lines of [begin, end) concurrently into the given arrays, sized
+// here. Return false, leaving the arrays empty, if the content must be parsed
+// by the serial parser.
+bool vtkOBJParseParallel(const char* begin, const char* end, vtkPoints* points,
+  vtkFloatArray* tcoords, vtkFloatArray* normals, vtkCellArray* vertexPolys,
+  vtkCellArray* tcoordPolys, vtkCellArray* normalPolys, vtkFloatArray* groupIds,
+  vtkOBJParallelResult& result)
+{
+  // Split the content in chunks of whole lines.
+  const std::size_t size = static_cast<std::size_t>(end - begin);
+  const std::size_t maxChunks =
+    8 * static_cast<std::size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+  const std::size_t numberOfChunks =
+    std::max<std::size_t>(1, std::min(maxChunks, size / OBJMinimumChunkSize));
+  std::vector<vtkOBJChunk> chunks;
+  const char* chunkBegin = begin;
+  for (std::size_t i = 1; i <= numberOfChunks && chunkBegin != end; ++i)
+  {
+    const char* chunkEnd = end;
+    if (i < numberOfChunks)
+    {
+      chunkEnd = std::max(chunkBegin, begin + i * (size / numberOfChunks));
+      chunkEnd = static_cast<const char*>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+      chunkEnd = chunkEnd ? chunkEnd + 1 : end;
+    }
+    chunks.emplace_back();
+    chunks.back().Begin = chunkBegin;
+    chunks.back().End = chunkEnd;
+    chunkBegin = chunkEnd;
+  }
+
+  const vtkIdType numberOfChunkTasks = static_cast<vtkIdType>(chunks.size());
+  vtkSMPTools::For(0, numberOfChunkTasks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      vtkOBJCountChunk(chunks[i]);
+    }
+  });
+
+  // Offsets of the chunks in the output arrays, and group ids entering each
+  // chunk: a face sets the group id to 0 if no group was defined before it.
+  vtkOBJCounts total;
+  int groupId = -1;
+  for (auto& chunk : chunks)
+  {
+    if (!chunk.Valid)
+    {
+      return false;
+    }
+    chunk.Offset = total;
+    total += chunk.Count;
+    const bool reset = groupId < 0 && chunk.GroupsBeforeFirstFace == 0;
+    chunk.GroupOffset = reset ? 0 : groupId;
+    groupId = chunk.GroupOffset + chunk.Groups;
+  }
+
+  points->SetNumberOfPoints(total.Points);
+  tcoords->SetNumberOfTuples(total.TCoords);
+  normals->SetNumberOfTuples(total.Normals);
+  groupIds->SetNumberOfTuples(total.Faces);
+  vtkIdType *offsets, *ids, *tcoordOffsets, *tcoordIds, *normalOffsets, *normalIds;
+  vtkOBJAllocateCells(vertexPolys, total.Faces, total.FaceIds, offsets, ids);
+  vtkOBJAllocateCells(tcoordPolys, total.Faces, total.FaceTCoordIds, tcoordOffsets, tcoordIds);
+  vtkOBJAllocateCells(normalPolys, total.Faces, total.FaceNormalIds, normalOffsets, normalIds);
+
+  double* pointsData = static_cast<double*>(points->GetVoidPointer(0));
+  float* tcoordsData = tcoords->GetPointer(0);
+  float* normalsData = normals->GetPointer(0);
+  float* groupIdsData = groupIds->GetPointer(0);
+  std::atomic<bool> parsed(true);
+  vtkSMPTools::For(0, numberOfChunkTasks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last && parsed; ++i)
+    {
+      if (!vtkOBJParseChunk(chunks[i], pointsData, tcoordsData, normalsData, offsets, ids,
+            tcoordOffsets, tcoordIds, normalOffsets, normalIds, groupIdsData))
+      {
+        parsed = false;
+      }
+    }
+  });
+  if (!parsed)
+  {
+    points->Initialize();
+    tcoords->Initialize();
+    normals->Initialize();
+    vertexPolys->Initialize();
+    tcoordPolys->Initialize();
+    normalPolys->Initialize();
+    groupIds->Initialize();
+    return false;
+  }
+
+  result.GroupId = groupId;
+  for (const auto& chunk : chunks)
+  {
+    result.TCoordsMatchVertices &= chunk.TCoordsMatchVertices;
+    result.NormalsMatchVertices &= chunk.NormalsMatchVertices;
+    for (const auto& material : chunk.Materials)
+    {
+      result.Materials.emplace_back(chunk.Offset.Faces + material.first, material.second);
+    }
+    result.Libraries.insert(result.Libraries.end(), chunk.Libraries.begin(), chunk.Libraries.end());
+  }
+  return true;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkOBJReader::vtkOBJReader()
 {
   this->Comment = nullptr;
+  this->ParallelReading = false;
 }
 
 //------------------------------------------------------------------------------
@@ -46,6 +626,19 @@ vtkSmartPointer<vtkResourceStream> vtkOBJReader::Open()
     return this->Stream;
   }
 
+  if (this->ParallelReading)
+  {
+    auto mappedStream = vtkSmartPointer<vtkMappedFileResourceStream>::New();
+    if (!this->FileName || !mappedStream->Open(this->FileName))
+    {
+      vtkErrorMacro(<< "Failed to open file: "
+                    << (this->FileName ? this->FileName : "No file name set"));
+      return nullptr;
+    }
+
+    return mappedStream;
+  }
+
   auto fileStream = vtkSmartPointer<vtkFileResourceStream>::New();
   if (!this->FileName || !fileStream->Open(this->FileName))
   {
@@ -198,6 +791,20 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
   int materialCount = 0;
   bool cellWithNotTextureFound = false;
 
+  // Keep a record of a material, used starting with the given cell
+  const auto useMaterial = [&](const std::string& name, vtkIdType cellId) {
+    if (materialNameToId.find(name) == materialNameToId.end())
+    {
+      // haven't seen this material yet, keep a record of it
+      materialNameToId.emplace(name, materialCount);
+      materialNames->InsertNextValue(name);
+      materialCount++;
+    }
+
+    // remember that starting with this cell, we should draw with it
+    startCellToMaterialName[cellId] = name;
+  };
+
   // work through the file line by line, assigning into the above structures as appropriate
   std::string command;      // the command, may be a comment
   std::string firstComment; // the first comment is stored
@@ -219,6 +826,115 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
     return result;
   };
 
+  // When parsing in parallel, everything but the leading comments is parsed
+  // concurrently and the loop below only goes through these comments, or
+  // through the whole content if it cannot be parsed concurrently.
+  if (this->ParallelReading)
+  {
+    const char* data = nullptr;
+    std::size_t size = 0;
+    if (auto mappedStream = vtkMappedFileResourceStream::SafeDownCast(stream))
+    {
+      data = reinterpret_cast<const char*>(mappedStream->GetData());
+      size = mappedStream->GetSize();
+    }
+    else
+    {
+      constexpr std::size_t blockSize = 1 << 20;
+      std::vector<char> content;
+      std::size_t read = 0;
+      do
+      {
+        const std::size_t previousSize = content.size();
+        content.resize(previousSize + blockSize);
+        read = stream->Read(content.data() + previousSize, blockSize);
+        content.resize(previousSize + read);
+      } while (read > 0);
+
+      data = content.data();
+      size = content.size();
+      auto memoryStream = vtkSmartPointer<vtkMemoryResourceStream>::New();
+      memoryStream->SetBuffer(std::move(content));
+      stream = memoryStream;
+    }
+
+    vtkOBJParallelResult parallelResult;
+    bool valid = size > 0;
+    const char* body = valid ? vtkOBJLeadingCommentsEnd(data, data + size, valid) : nullptr;
+    if (valid &&
+      vtkOBJParseParallel(body, data + size, points, tcoords, normals, vertexPolys, tcoordPolys,
+        normalPolys, faceScalars, parallelResult))
+    {
+      groupId = parallelResult.GroupId;
+      tcoordsMatchVertices = parallelResult.TCoordsMatchVertices;
+      normalsMatchVertices = parallelResult.NormalsMatchVertices;
+      for (const auto& name : parallelResult.Libraries)
+      {
+        libNames->InsertNextValue(name);
+      }
+
+      // Go through the materials and the texture coordinates of the faces in
+      // order, as the serial parser does.
+      const auto& materials = parallelResult.Materials;
+      const vtkIdType faceCount = vertexPolys->GetNumberOfCells();
+      std::size_t nextMaterial = 0;
+      vtkNew<vtkIdList> faceTCoordIds;
+      for (vtkIdType face = 0; face <= faceCount; ++face)
+      {
+        for (; nextMaterial < materials.size() && materials[nextMaterial].first == face;
+             ++nextMaterial)
+        {
+          tcoordsName = materials[nextMaterial].second;
+          useMaterial(tcoordsName, face);
+
+          if (tcoordsMap.find(tcoordsName) == tcoordsMap.end())
+          {
+            tcoordsMap.emplace(tcoordsName, std::vector<bool>{});
+          }
+        }
+
+        if (face == faceCount)
+        {
+          break;
+        }
+
+        if (!cellWithNotTextureFound)
+        {
+          cellWithNotTextureFound = true;
+          useMaterial(noMaterialName, face);
+        }
+
+        vtkIdType tcoordCount;
+        const vtkIdType* tcoordIds;
+        tcoordPolys->GetCellAtId(face, tcoordCount, tcoordIds, faceTCoordIds);
+        if (tcoordCount > 0 && tcoordsMap.empty())
+        {
+          tcoordsName = "TCoords";
+          tcoordsMap.emplace(tcoordsName, std::vector<bool>{});
+        }
+        for (vtkIdType i = 0; i < tcoordCount; ++i)
+        {
+          auto& tcoordArray = tcoordsMap.find(tcoordsName)->second;
+          if (static_cast<std::size_t>(tcoordIds[i]) >= tcoordArray.size())
+          {
+            tcoordArray.resize(tcoordIds[i] + 1);
+          }
+          tcoordArray[tcoordIds[i]] = true;
+        }
+      }
+
+      auto commentStream = vtkSmartPointer<vtkMemoryResourceStream>::New();
+      commentStream->SetBuffer(data, static_cast<std::size_t>(body - data));
+      parser->SetStream(commentStream);
+    }
+    else
+    {
+      vtkDebugMacro(<< "Content cannot be parsed in parallel, parsing it serially");
+      stream->Seek(0, vtkResourceStream::SeekDirection::Begin);
+      parser->SetStream(stream);
+    }
+  }
+
   vtkParseResult result = vtkParseResult::Ok;
   while (result == vtkParseResult::Ok || result == vtkParseResult::EndOfLine)
   {
@@ -283,22 +999,13 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
         return 0;
       }
 
-      if (materialNameToId.find(tcoordsName) == materialNameToId.end())
-      {
-        // haven't seen this material yet, keep a record of it
-        materialNameToId.emplace(tcoordsName, materialCount);
-        materialNames->InsertNextValue(tcoordsName);
-        materialCount++;
-      }
+      useMaterial(tcoordsName, vertexPolys->GetNumberOfCells());
 
       if (tcoordsMap.find(tcoordsName) == tcoordsMap.end())
       {
         tcoordsMap.emplace(tcoordsName, std::vector<bool>{});
       }
 
-      // remember that starting with current cell, we should draw with it
-      startCellToMaterialName[vertexPolys->GetNumberOfCells()] = tcoordsName;
-
       result = flushLine();
     }
     else if (command == "mtllib")
@@ -576,17 +1283,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
           if (!cellWithNotTextureFound)
           {
             cellWithNotTextureFound = true;
-
-            if (materialNameToId.find(noMaterialName) == materialNameToId.end())
-            {
-              // haven't seen this material yet, keep a record of it
-              materialNameToId.emplace(noMaterialName, materialCount);
-              materialNames->InsertNextValue(noMaterialName);
-              materialCount++;
-            }
-
-            // remember that starting with current cell, we should draw with it
-            startCellToMaterialName[vertexPolys->GetNumberOfCells() - 1] = noMaterialName;
+            useMaterial(noMaterialName, vertexPolys->GetNumberOfCells() - 1);
           }
 
           // determine if we have tcoord or normal
@@ -1021,5 +1718,6 @@ void vtkOBJReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "Comment: " << (this->Comment ? this->Comment : "(none)") << "\n";
+  os << indent << "ParallelReading: " << (this->ParallelReading ? "On" : "Off") << "\n";
 }
 VTK_ABI_NAMESPACE_END
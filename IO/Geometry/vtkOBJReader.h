@@ -6,6 +6,9 @@
  *
  * vtkOBJReader is a source object that reads Wavefront .obj
  * files. The output of this source object is polygonal data.
+ *
+ * When ParallelReading is on, the content is split in line-aligned chunks
+ * that are parsed concurrently with vtkSMPTools.
  * @sa
  * vtkOBJImporter
  */
@@ -41,6 +44,21 @@ public:
   vtkGetSmartPointerMacro(Stream, vtkResourceStream);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the content is parsed concurrently. Files are memory-mapped
+   * and streams are read in memory, then the vertices, texture coordinates,
+   * normals and faces of each chunk of lines are parsed in parallel and
+   * assembled in place using prefix sums over the chunks. Files containing
+   * point or line elements, line continuations or anything the serial parser
+   * would warn about are parsed serially. The output is the same in both
+   * cases. Default is false.
+   */
+  vtkSetMacro(ParallelReading, bool);
+  vtkGetMacro(ParallelReading, bool);
+  vtkBooleanMacro(ParallelReading, bool);
+  ///@}
+
 protected:
   vtkOBJReader();
   ~vtkOBJReader() override;
@@ -54,6 +72,7 @@ protected:
 
   char* Comment;
   vtkSmartPointer<vtkResourceStream> Stream;
+  bool ParallelReading;
 
 private:
   vtkSmartPointer<vtkResourceStream> Open();
@@ -7,21 +7,27 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMappedFileResourceStream.h"
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -33,12 +39,84 @@ vtkStandardNewMacro(vtkSTLReader);
 vtkCxxSetObjectMacro(vtkSTLReader, Locator, vtkIncrementalPointLocator);
 vtkCxxSetObjectMacro(vtkSTLReader, BinaryHeader, vtkUnsignedCharArray);
 
+namespace
+{
+// Coordinates of a point as sortable bits, and the point id.
+struct vtkSTLPointKey
+{
+  uint32_t Bits[3];
+  vtkIdType Id;
+
+  bool operator<(const vtkSTLPointKey& other) const
+  {
+    if (this->Bits[0] != other.Bits[0])
+    {
+      return this->Bits[0] < other.Bits[0];
+    }
+    if (this->Bits[1] != other.Bits[1])
+    {
+      return this->Bits[1] < other.Bits[1];
+    }
+    if (this->Bits[2] != other.Bits[2])
+    {
+      return this->Bits[2] < other.Bits[2];
+    }
+    return this->Id < other.Id;
+  }
+
+  bool SameCoordinates(const vtkSTLPointKey& other) const
+  {
+    return this->Bits[0] == other.Bits[0] && this->Bits[1] == other.Bits[1] &&
+      this->Bits[2] == other.Bits[2];
+  }
+
+  // A NaN coordinate never compares equal, so such points are never merged.
+  bool HasNaN() const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if ((this->Bits[i] & 0x7f800000u) == 0x7f800000u && (this->Bits[i] & 0x007fffffu) != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// Run functor(chunk, begin, end) concurrently on contiguous chunks of [0, n).
+template <typename Functor>
+void vtkSTLForEachChunk(vtkIdType n, vtkIdType numChunks, Functor functor)
+{
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType chunk = first; chunk < last; ++chunk)
+    {
+      functor(chunk, n * chunk / numChunks, n * (chunk + 1) / numChunks);
+    }
+  });
+}
+
+// Turn per-chunk counts into per-chunk starting offsets and return the total.
+vtkIdType vtkSTLChunkOffsets(std::vector<vtkIdType>& counts)
+{
+  vtkIdType total = 0;
+  for (vtkIdType& count : counts)
+  {
+    const vtkIdType chunkCount = count;
+    count = total;
+    total += chunkCount;
+  }
+  return total;
+}
+}
+
 //------------------------------------------------------------------------------
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
 {
   this->Merging = 1;
   this->ScalarTags = 0;
+  this->ParallelReading = false;
   this->Locator = nullptr;
   this->Header = nullptr;
   this->BinaryHeader = nullptr;
@@ -121,25 +199,39 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   {
     // Close file and reopen in binary mode.
     fclose(fp);
-    fp = vtksys::SystemTools::Fopen(this->FileName, "rb");
-    if (fp == nullptr)
+    fp = nullptr;
+    if (this->ParallelReading)
     {
-      vtkErrorMacro(<< "File " << this->FileName << " not found");
-      this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-      return 0;
+      if (!this->ReadBinarySTLParallel(newPts.Get(), newPolys.Get()))
+      {
+        return 0;
+      }
     }
-
-    if (!this->ReadBinarySTL(fp, newPts.Get(), newPolys.Get()))
+    else
     {
-      fclose(fp);
-      return 0;
+      fp = vtksys::SystemTools::Fopen(this->FileName, "rb");
+      if (fp == nullptr)
+      {
+        vtkErrorMacro(<< "File " << this->FileName << " not found");
+        this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+        return 0;
+      }
+
+      if (!this->ReadBinarySTL(fp, newPts.Get(), newPolys.Get()))
+      {
+        fclose(fp);
+        return 0;
+      }
     }
   }
 
   vtkDebugMacro(<< "Read: " << newPts->GetNumberOfPoints() << " points, "
                 << newPolys->GetNumberOfCells() << " triangles");
 
-  fclose(fp);
+  if (fp)
+  {
+    fclose(fp);
+  }
 
   // If merging is on, create hash table and merge points/triangles.
   vtkSmartPointer<vtkPoints> mergedPts = newPts;
@@ -148,12 +240,26 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   if (this->Merging)
   {
     mergedPts = vtkSmartPointer<vtkPoints>::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
     mergedPolys = vtkSmartPointer<vtkCellArray>::New();
-    mergedPolys->AllocateCopy(newPolys);
     if (newScalars)
     {
       mergedScalars = vtkSmartPointer<vtkFloatArray>::New();
+    }
+  }
+  // Other locators may merge points within a tolerance.
+  if (this->Merging && this->ParallelReading &&
+    (!this->Locator || this->Locator->IsA("vtkMergePoints")) &&
+    this->MergePointsParallel(newPts, newPolys, newScalars, mergedPts, mergedPolys, mergedScalars))
+  {
+    vtkDebugMacro(<< "Merged to: " << mergedPts->GetNumberOfPoints() << " points, "
+                  << mergedPolys->GetNumberOfCells() << " triangles");
+  }
+  else if (this->Merging)
+  {
+    mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
+    mergedPolys->AllocateCopy(newPolys);
+    if (newScalars)
+    {
       mergedScalars->Allocate(newPolys->GetNumberOfCells());
     }
 
@@ -312,6 +418,220 @@ bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newP
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkSTLReader::ReadBinarySTLParallel(vtkPoints* newPts, vtkCellArray* newPolys)
+{
+  vtkDebugMacro(<< "Reading BINARY STL file in parallel");
+
+  vtkNew<vtkMappedFileResourceStream> file;
+  if (!file->Open(this->FileName))
+  {
+    vtkErrorMacro(<< "File " << this->FileName << " not found");
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return false;
+  }
+
+  const int headerSize = 80; // fixed in STL file format
+  if (file->GetSize() < headerSize + 4)
+  {
+    vtkErrorMacro(
+      "STLReader error reading file: " << this->FileName << " Premature EOF while reading header.");
+    return false;
+  }
+  if (!this->BinaryHeader)
+  {
+    vtkNew<vtkUnsignedCharArray> binaryHeader;
+    this->SetBinaryHeader(binaryHeader);
+  }
+  this->BinaryHeader->SetNumberOfValues(headerSize + 1); // allocate +1 byte for zero termination)
+  this->BinaryHeader->FillValue(0);
+  memcpy(this->BinaryHeader->GetVoidPointer(0), file->GetData(), headerSize);
+  this->SetHeader(static_cast<char*>(this->BinaryHeader->GetVoidPointer(0)));
+  // Remove extra zero termination from binary header
+  this->BinaryHeader->Resize(headerSize);
+
+  // Like the serial reader, ignore the often bogus triangle count and read
+  // every complete 50 byte facet: a normal, three vertices and 2 bytes of
+  // attributes.
+  const vtkIdType numTris = static_cast<vtkIdType>((file->GetSize() - headerSize - 4) / 50);
+  const unsigned char* facets = file->GetData() + headerSize + 4;
+
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3 * numTris);
+  float* coords = vtkFloatArray::FastDownCast(newPts->GetData())->GetPointer(0);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numTris);
+  vtkIdType* offsetIds = offsets->GetPointer(0);
+  vtkIdType* pointIds = connectivity->GetPointer(0);
+
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      memcpy(coords + 9 * i, facets + 50 * i + 12, 9 * sizeof(float));
+      vtkByteSwap::Swap4LERange(coords + 9 * i, 9);
+      offsetIds[i] = 3 * i;
+      pointIds[3 * i] = 3 * i;
+      pointIds[3 * i + 1] = 3 * i + 1;
+      pointIds[3 * i + 2] = 3 * i + 2;
+    }
+  });
+  offsetIds[numTris] = 3 * numTris;
+  newPolys->SetData(offsets, connectivity);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSTLReader::MergePointsParallel(vtkPoints* pts, vtkCellArray* polys,
+  vtkFloatArray* scalars, vtkPoints* mergedPts, vtkCellArray* mergedPolys,
+  vtkFloatArray* mergedScalars)
+{
+  // Both readers give every triangle its own three consecutive points.
+  vtkFloatArray* coordArray = vtkFloatArray::FastDownCast(pts->GetData());
+  const vtkIdType numTris = polys->GetNumberOfCells();
+  const vtkIdType numPts = pts->GetNumberOfPoints();
+  if (!coordArray || numPts != 3 * numTris || polys->GetNumberOfConnectivityIds() != numPts)
+  {
+    return false;
+  }
+  if (numTris == 0)
+  {
+    return true;
+  }
+  const float* coords = coordArray->GetPointer(0);
+  const vtkIdType numChunks =
+    std::min<vtkIdType>(numTris, 4 * std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+
+  // Sort the points by coordinates so that duplicates are contiguous, the
+  // first occurrence leading each run.  The bit patterns order the points
+  // consistently and, once -0 is folded onto 0, match exactly when the
+  // coordinates compare equal, like the incremental locator does.
+  std::vector<vtkSTLPointKey> keys(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        const float x = coords[3 * i + j] == 0.0f ? 0.0f : coords[3 * i + j];
+        memcpy(&keys[i].Bits[j], &x, sizeof(float));
+      }
+      keys[i].Id = i;
+    }
+  });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  // Find the first occurrence of every point.  Runs may span chunks, so the
+  // start of the last run of each chunk is carried over to the next ones.
+  auto startsRun = [&](vtkIdType k) { return k == 0 || !keys[k].SameCoordinates(keys[k - 1]); };
+  std::vector<vtkIdType> runStarts(numChunks);
+  vtkSTLForEachChunk(numPts, numChunks, [&](vtkIdType chunk, vtkIdType begin, vtkIdType end) {
+    runStarts[chunk] = -1;
+    for (vtkIdType k = begin; k < end; ++k)
+    {
+      runStarts[chunk] = startsRun(k) ? k : runStarts[chunk];
+    }
+  });
+  vtkIdType carry = 0;
+  for (vtkIdType& runStart : runStarts)
+  {
+    const vtkIdType chunkRunStart = runStart;
+    runStart = carry;
+    carry = chunkRunStart >= 0 ? chunkRunStart : carry;
+  }
+  std::vector<vtkIdType> firstIds(numPts);
+  vtkSTLForEachChunk(numPts, numChunks, [&](vtkIdType chunk, vtkIdType begin, vtkIdType end) {
+    vtkIdType runStart = runStarts[chunk];
+    for (vtkIdType k = begin; k < end; ++k)
+    {
+      runStart = startsRun(k) ? k : runStart;
+      firstIds[keys[k].Id] = keys[k].HasNaN() ? keys[k].Id : keys[runStart].Id;
+    }
+  });
+  std::vector<vtkSTLPointKey>().swap(keys);
+
+  // Number the first occurrences in order, as the locator inserts them.
+  std::vector<vtkIdType> newIds(numPts);
+  std::vector<vtkIdType> counts(numChunks);
+  vtkSTLForEachChunk(numPts, numChunks, [&](vtkIdType chunk, vtkIdType begin, vtkIdType end) {
+    vtkIdType count = 0;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      count += firstIds[i] == i ? 1 : 0;
+    }
+    counts[chunk] = count;
+  });
+  const vtkIdType numMergedPts = vtkSTLChunkOffsets(counts);
+  mergedPts->SetDataTypeToFloat();
+  mergedPts->SetNumberOfPoints(numMergedPts);
+  float* mergedCoords = vtkFloatArray::FastDownCast(mergedPts->GetData())->GetPointer(0);
+  vtkSTLForEachChunk(numPts, numChunks, [&](vtkIdType chunk, vtkIdType begin, vtkIdType end) {
+    vtkIdType newId = counts[chunk];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (firstIds[i] == i)
+      {
+        std::copy(coords + 3 * i, coords + 3 * i + 3, mergedCoords + 3 * newId);
+        newIds[i] = newId++;
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      firstIds[i] = newIds[firstIds[i]];
+    }
+  });
+  const std::vector<vtkIdType>& mergedIds = firstIds;
+
+  // Keep the triangles whose points are still distinct, in order.
+  auto isValid = [&](vtkIdType tri) {
+    const vtkIdType* ids = mergedIds.data() + 3 * tri;
+    return ids[0] != ids[1] && ids[0] != ids[2] && ids[1] != ids[2];
+  };
+  vtkSTLForEachChunk(numTris, numChunks, [&](vtkIdType chunk, vtkIdType begin, vtkIdType end) {
+    vtkIdType count = 0;
+    for (vtkIdType tri = begin; tri < end; ++tri)
+    {
+      count += isValid(tri) ? 1 : 0;
+    }
+    counts[chunk] = count;
+  });
+  const vtkIdType numMergedTris = vtkSTLChunkOffsets(counts);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numMergedTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numMergedTris);
+  if (scalars)
+  {
+    mergedScalars->SetNumberOfValues(numMergedTris);
+  }
+  vtkIdType* offsetIds = offsets->GetPointer(0);
+  vtkIdType* pointIds = connectivity->GetPointer(0);
+  vtkSTLForEachChunk(numTris, numChunks, [&](vtkIdType chunk, vtkIdType begin, vtkIdType end) {
+    vtkIdType newTri = counts[chunk];
+    for (vtkIdType tri = begin; tri < end; ++tri)
+    {
+      if (isValid(tri))
+      {
+        offsetIds[newTri] = 3 * newTri;
+        std::copy(mergedIds.data() + 3 * tri, mergedIds.data() + 3 * tri + 3,
+          pointIds + 3 * newTri);
+        if (scalars)
+        {
+          mergedScalars->SetValue(newTri, scalars->GetValue(tri));
+        }
+        ++newTri;
+      }
+    }
+  });
+  offsetIds[numMergedTris] = 3 * numMergedTris;
+  mergedPolys->SetData(offsets, connectivity);
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 
 // Local Functions
@@ -688,6 +1008,7 @@ void vtkSTLReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Merging: " << (this->Merging ? "On\n" : "Off\n");
   os << indent << "ScalarTags: " << (this->ScalarTags ? "On\n" : "Off\n");
+  os << indent << "ParallelReading: " << (this->ParallelReading ? "On\n" : "Off\n");
   os << indent << "Locator: ";
   if (this->Locator)
   {
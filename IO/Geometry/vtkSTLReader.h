@@ -15,6 +15,11 @@
  * however, merging requires a large amount of temporary storage since a
  * 3D hash table must be constructed.
  *
+ * When ParallelReading is enabled, binary files are memory-mapped and their
+ * facets decoded concurrently, and points are merged with a parallel sort
+ * instead of the incremental locator.  The result is identical to the
+ * serial path.
+ *
  * @warning
  * Binary files written on one system may not be readable on other systems.
  * vtkSTLWriter uses VAX or PC byte ordering and swaps bytes on other systems.
@@ -67,6 +72,21 @@ public:
   vtkBooleanMacro(ScalarTags, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off parallel reading.  When on, binary files are memory-mapped
+   * and their facets decoded concurrently using vtkSMPTools, and merging
+   * sorts the points in parallel to find exact duplicates.  Points keep the
+   * order of their first occurrence and degenerate triangles are removed as
+   * in the serial path, so the output is identical.  Merging only uses the
+   * parallel path when no locator or a vtkMergePoints locator is set, since
+   * other locators may merge points within a tolerance.  Default is false.
+   */
+  vtkSetMacro(ParallelReading, bool);
+  vtkGetMacro(ParallelReading, bool);
+  vtkBooleanMacro(ParallelReading, bool);
+  ///@}
+
   ///@{
   /**
    * Specify a spatial locator for merging points. By
@@ -112,12 +132,16 @@ protected:
 
   vtkTypeBool Merging;
   vtkTypeBool ScalarTags;
+  bool ParallelReading;
   vtkIncrementalPointLocator* Locator;
   char* Header;
   vtkUnsignedCharArray* BinaryHeader;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   bool ReadBinarySTL(FILE* fp, vtkPoints*, vtkCellArray*);
+  bool ReadBinarySTLParallel(vtkPoints*, vtkCellArray*);
+  bool MergePointsParallel(vtkPoints* pts, vtkCellArray* polys, vtkFloatArray* scalars,
+    vtkPoints* mergedPts, vtkCellArray* mergedPolys, vtkFloatArray* mergedScalars);
   bool ReadASCIISTL(FILE* fp, vtkPoints*, vtkCellArray*, vtkFloatArray* scalars = nullptr);
   int GetSTLFileType(const char* filename);
 
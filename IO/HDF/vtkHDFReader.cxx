@@ -327,6 +327,7 @@ vtkHDFReader::vtkHDFReader()
   : Cache(std::make_shared<DataCache>())
 {
   this->FileName = nullptr;
+  this->CurrentOutputInformation = nullptr;
   // Setup the selection callback to modify this object when an array
   // selection is changed.
   this->SelectionObserver = vtkCallbackCommand::New();
@@ -735,6 +736,14 @@ void vtkHDFReader::PrintPieceInformation(vtkInformation* outInfo)
   std::cout << std::endl;
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFReader::IsArrayEnabled(int attributeType, const char* name)
+{
+  return this->DataArraySelection[attributeType]->ArrayIsEnabled(name) &&
+    vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+      this->CurrentOutputInformation, attributeType, name);
+}
+
 //------------------------------------------------------------------------------
 int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
 {
@@ -755,7 +764,7 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
     std::vector<std::string> names = this->Impl->GetArrayNames(attributeType);
     for (const std::string& name : names)
     {
-      if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
+      if (this->IsArrayEnabled(attributeType, name.c_str()))
       {
         vtkSmartPointer<vtkDataArray> array;
         std::vector<hsize_t> fileExtent = ::ReduceDimension(updateExtent.data(), this->WholeExtent);
@@ -833,6 +842,11 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
   const std::vector<std::string> names = this->Impl->GetArrayNames(vtkDataObject::FIELD);
   for (const std::string& name : names)
   {
+    if (!vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+          this->CurrentOutputInformation, vtkDataObject::FIELD, name.c_str()))
+    {
+      continue;
+    }
     vtkSmartPointer<vtkAbstractArray> array;
     vtkIdType offset = -1;
     std::array<vtkIdType, 2> size = { -1, -1 };
@@ -974,7 +988,7 @@ int vtkHDFReader::Read(const std::vector<vtkIdType>& numberOfPoints,
     const std::vector<std::string> names = this->Impl->GetArrayNames(attributeType);
     for (const std::string& name : names)
     {
-      if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
+      if (this->IsArrayEnabled(attributeType, name.c_str()))
       {
         vtkIdType arrayOffset = offsets[attributeType];
         if (this->GetHasTemporalData())
@@ -1257,7 +1271,7 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data, vtkPartitione
       const std::vector<std::string> names = this->Impl->GetArrayNames(attributeType);
       for (const std::string& name : names)
       {
-        if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
+        if (this->IsArrayEnabled(attributeType, name.c_str()))
         {
           vtkIdType arrayOffset = offsets[attributeType];
           if (this->GetHasTemporalData())
@@ -1643,6 +1657,7 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
     this->TimeValue = values[this->Step];
   }
+  this->CurrentOutputInformation = outInfo;
   int dataSetType = this->Impl->GetDataSetType();
   if (dataSetType == VTK_IMAGE_DATA)
   {
@@ -1693,9 +1708,12 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
   else
   {
     vtkErrorMacro("HDF dataset type unknown: " << dataSetType);
+    this->CurrentOutputInformation = nullptr;
     return 0;
   }
-  return ok && this->AddFieldArrays(output);
+  ok = ok && this->AddFieldArrays(output);
+  this->CurrentOutputInformation = nullptr;
+  return ok;
 }
 
 //----------------------------------------------------------------------------
@@ -258,6 +258,18 @@ protected:
    */
   vtkDataArraySelection* DataArraySelection[3];
 
+  /**
+   * Returns true if the array is enabled in its array selection and
+   * requested by the consumers of the output.
+   */
+  bool IsArrayEnabled(int attributeType, const char* name);
+
+  /**
+   * The output information of the request being executed, used to read
+   * only the arrays requested downstream.
+   */
+  vtkInformation* CurrentOutputInformation;
+
   /**
    * The observer to modify this object when the array selections are
    * modified.
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that parallel ASCII parsing reads the same data as the serial path,
+// including when it has to fall back to it.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridReader.h"
+#include "vtkUnstructuredGridWriter.h"
+
+#include <cctype>
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkUnstructuredGrid> ReadGrid(const std::string& content, bool parallel)
+{
+  vtkNew<vtkUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->SetParallelASCIIParsing(parallel);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* actual, const char* name)
+{
+  if (!expected || !actual || expected->GetNumberOfValues() != actual->GetNumberOfValues() ||
+    expected->GetNumberOfComponents() != actual->GetNumberOfComponents())
+  {
+    std::cerr << "Array " << name << " missing or of wrong size." << std::endl;
+    return false;
+  }
+  const int numComps = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetComponent(i / numComps, i % numComps) !=
+      actual->GetComponent(i / numComps, i % numComps))
+    {
+      std::cerr << "Array " << name << " differs at value " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareGrids(vtkUnstructuredGrid* expected, vtkUnstructuredGrid* actual)
+{
+  if (actual->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of cells." << std::endl;
+    return false;
+  }
+  return CompareArrays(expected->GetPoints()->GetData(), actual->GetPoints()->GetData(),
+           "Points") &&
+    CompareArrays(expected->GetCells()->GetOffsetsArray(), actual->GetCells()->GetOffsetsArray(),
+      "Offsets") &&
+    CompareArrays(expected->GetCells()->GetConnectivityArray(),
+      actual->GetCells()->GetConnectivityArray(), "Connectivity") &&
+    CompareArrays(expected->GetPointData()->GetArray("Vectors"),
+      actual->GetPointData()->GetArray("Vectors"), "Vectors") &&
+    CompareArrays(expected->GetPointData()->GetArray("Labels"),
+      actual->GetPointData()->GetArray("Labels"), "Labels");
+}
+}
+
+int TestLegacyParallelASCIIParsing(int, char*[])
+{
+  const vtkIdType numPoints = 50000;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfTuples(numPoints);
+  vtkNew<vtkCellArray> cells;
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    points->SetPoint(i, 0.1 * (i % 97), -0.37 * (i / 97), 1.0 / (i + 3));
+    vectors->SetTuple3(i, 1e-7 * i, -2.5e12 / (i + 1), 0.3 * (i % 11));
+    labels->SetValue(i, static_cast<int>((i * 7919) % 100003) - 50000);
+    if (i + 2 < numPoints)
+    {
+      const vtkIdType triangle[3] = { i, i + 1, i + 2 };
+      cells->InsertNextCell(3, triangle);
+    }
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->SetCells(VTK_TRIANGLE, cells);
+  grid->GetPointData()->SetVectors(vectors);
+  grid->GetPointData()->SetScalars(labels);
+
+  int status = EXIT_SUCCESS;
+  // Check both the current cell layout and the legacy one.
+  for (int version : { vtkUnstructuredGridWriter::VTK_LEGACY_READER_VERSION_5_1,
+         vtkUnstructuredGridWriter::VTK_LEGACY_READER_VERSION_4_2 })
+  {
+    vtkNew<vtkUnstructuredGridWriter> writer;
+    writer->SetInputData(grid);
+    writer->SetFileTypeToASCII();
+    writer->SetFileVersion(version);
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    std::string content = writer->GetOutputStdString();
+
+    vtkSmartPointer<vtkUnstructuredGrid> serial = ReadGrid(content, false);
+    vtkSmartPointer<vtkUnstructuredGrid> parallel = ReadGrid(content, true);
+    if (serial->GetNumberOfPoints() != numPoints || !CompareGrids(serial, parallel))
+    {
+      std::cerr << "Parallel parsing differs for file version " << version << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // A leading '+' is not handled by the fast parser and makes the rest of
+    // the points fall back to the serial path.
+    const size_t pointsStart = content.find("POINTS");
+    const size_t pointsEnd = content.find("CELLS", pointsStart);
+    size_t pos = content.find(' ', (pointsStart + pointsEnd) / 2);
+    while (pos != std::string::npos && !std::isdigit(content[pos + 1]))
+    {
+      pos = content.find(' ', pos + 1);
+    }
+    content.insert(pos + 1, "+");
+    parallel = ReadGrid(content, true);
+    if (!CompareGrids(serial, parallel))
+    {
+      std::cerr << "Parallel parsing fallback differs for file version " << version << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
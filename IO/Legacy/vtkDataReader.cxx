@@ -34,6 +34,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -44,13 +45,17 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
+#include "vtkValueFromString.h"
 #include "vtkVariantArray.h"
 
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
@@ -115,6 +120,7 @@ vtkDataReader::vtkDataReader()
   this->ReadAllColorScalars = 0;
   this->ReadAllTCoords = 0;
   this->ReadAllFields = 0;
+  this->ParallelASCIIParsing = false;
   this->FileMajorVersion = 0;
   this->FileMinorVersion = 0;
 
@@ -1510,22 +1516,218 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
-// General templated function to read data of various types.
+namespace
+{
+// Smallest number of values worth parsing concurrently.
+const vtkIdType ParallelASCIIThreshold = 65536;
+// Size of the batches of text parsed concurrently.
+const size_t ParallelASCIIBatchSize = 1 << 24;
+
+// The type stream extraction reads for each value type.
 template <class T>
-int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
+struct vtkASCIIExtractedType
+{
+  using Type = T;
+};
+template <>
+struct vtkASCIIExtractedType<char>
+{
+  using Type = int;
+};
+template <>
+struct vtkASCIIExtractedType<unsigned char>
 {
-  vtkIdType i, j;
+  using Type = int;
+};
+
+inline bool vtkIsASCIISpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Stream extraction fails on infinite values, which the serial path reports.
+template <class T>
+inline bool vtkIsASCIIValueFinite(T)
+{
+  return true;
+}
+inline bool vtkIsASCIIValueFinite(float value)
+{
+  return !std::isinf(value);
+}
+inline bool vtkIsASCIIValueFinite(double value)
+{
+  return !std::isinf(value);
+}
+
+// Parse one token.  Returns false for anything stream extraction might not
+// read the same way, such as prefixed integers, nan, inf or partial tokens.
+template <class T>
+bool vtkParseASCIIToken(const char* begin, const char* end, T& value)
+{
+  const char* digits = (*begin == '-') ? begin + 1 : begin;
+  if (digits == end || !((*digits >= '0' && *digits <= '9') || *digits == '.'))
+  {
+    return false;
+  }
+  if (end - digits > 1 && digits[0] == '0' && !(digits[1] >= '0' && digits[1] <= '9') &&
+    digits[1] != '.' && digits[1] != 'e' && digits[1] != 'E')
+  {
+    return false;
+  }
+  typename vtkASCIIExtractedType<T>::Type extracted;
+  if (vtkValueFromString(begin, end, extracted) != static_cast<std::size_t>(end - begin) ||
+    !vtkIsASCIIValueFinite(extracted))
+  {
+    return false;
+  }
+  value = static_cast<T>(extracted);
+  return true;
+}
 
-  for (i = 0; i < numTuples; i++)
+// Parse whitespace separated values from the stream in large batches of
+// text, each split into whitespace-aligned chunks that are tokenized and
+// parsed concurrently.  Returns the number of values read.  The stream is
+// left right after the last of them, so that the serial path can take over
+// when not all values were read.
+template <class T>
+vtkIdType vtkParallelReadASCIIData(istream* is, T* data, vtkIdType numValues)
+{
+  const vtkIdType numRanges = 4 * std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+  std::vector<char> buffer(ParallelASCIIBatchSize);
+  std::vector<size_t> bounds(numRanges + 1);
+  std::vector<vtkIdType> counts(numRanges + 1);
+  vtkIdType done = 0;
+  while (done < numValues)
   {
-    for (j = 0; j < numComp; j++)
+    const std::streampos batchStart = is->tellg();
+    if (batchStart == std::streampos(-1))
+    {
+      break;
+    }
+    is->read(buffer.data(), buffer.size());
+    size_t length = static_cast<size_t>(is->gcount());
+    const bool atEnd = length < buffer.size();
+    is->clear();
+    if (!atEnd)
     {
-      if (!self->Read(data++))
+      // Only keep the tokens entirely held by the buffer.
+      while (length > 0 && !vtkIsASCIISpace(buffer[length - 1]))
       {
-        vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
-                                  "datasize with declaration.");
-        return 0;
+        --length;
+      }
+    }
+
+    // Split the text on whitespace and count the tokens of each range.
+    const char* text = buffer.data();
+    bounds[0] = 0;
+    for (vtkIdType r = 1; r < numRanges; ++r)
+    {
+      size_t bound =
+        std::max(bounds[r - 1], length / static_cast<size_t>(numRanges) * static_cast<size_t>(r));
+      while (bound < length && !vtkIsASCIISpace(text[bound]))
+      {
+        ++bound;
+      }
+      bounds[r] = bound;
+    }
+    bounds[numRanges] = length;
+    counts[0] = 0;
+    vtkSMPTools::For(0, numRanges, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType r = first; r < last; ++r)
+      {
+        vtkIdType count = 0;
+        bool inToken = false;
+        for (size_t pos = bounds[r]; pos < bounds[r + 1]; ++pos)
+        {
+          const bool space = vtkIsASCIISpace(text[pos]);
+          count += (!space && !inToken) ? 1 : 0;
+          inToken = !space;
+        }
+        counts[r + 1] = count;
+      }
+    });
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+    const vtkIdType wanted = std::min(counts[numRanges], numValues - done);
+
+    // Parse the tokens of each range at their final place.
+    std::atomic<bool> valid(wanted > 0);
+    T* output = data + done;
+    vtkSMPTools::For(0, numRanges, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType r = first; r < last && valid; ++r)
+      {
+        vtkIdType index = counts[r];
+        size_t pos = bounds[r];
+        while (index < wanted && pos < bounds[r + 1])
+        {
+          while (pos < bounds[r + 1] && vtkIsASCIISpace(text[pos]))
+          {
+            ++pos;
+          }
+          if (pos == bounds[r + 1])
+          {
+            break;
+          }
+          const size_t tokenStart = pos;
+          while (pos < bounds[r + 1] && !vtkIsASCIISpace(text[pos]))
+          {
+            ++pos;
+          }
+          if (!vtkParseASCIIToken(text + tokenStart, text + pos, output[index++]))
+          {
+            valid = false;
+            return;
+          }
+        }
+      }
+    });
+
+    // Position the stream right after the last token used, or back at the
+    // start of the batch if it must be read serially.
+    is->seekg(batchStart);
+    if (!valid)
+    {
+      break;
+    }
+    size_t consumed = 0;
+    vtkIdType index = 0;
+    while (index < wanted)
+    {
+      while (consumed < length && vtkIsASCIISpace(text[consumed]))
+      {
+        ++consumed;
       }
+      while (consumed < length && !vtkIsASCIISpace(text[consumed]))
+      {
+        ++consumed;
+      }
+      ++index;
+    }
+    is->ignore(static_cast<std::streamsize>(consumed));
+    done += wanted;
+  }
+  return done;
+}
+}
+
+// General templated function to read data of various types.
+template <class T>
+int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
+{
+  const vtkIdType numValues = numTuples * numComp;
+  vtkIdType i = 0;
+
+  if (self->GetParallelASCIIParsing() && numValues >= ParallelASCIIThreshold)
+  {
+    i = vtkParallelReadASCIIData(self->GetIStream(), data, numValues);
+  }
+  for (; i < numValues; i++)
+  {
+    if (!self->Read(data + i))
+    {
+      vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
+                                "datasize with declaration.");
+      return 0;
     }
   }
   return 1;
@@ -3162,7 +3364,7 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
+  vtkIdType i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3180,7 +3382,12 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    i = 0;
+    if (this->ParallelASCIIParsing && size >= ParallelASCIIThreshold)
+    {
+      i = vtkParallelReadASCIIData(this->IS, data, size);
+    }
+    for (; i < size; i++)
     {
       if (!this->Read(data + i))
       {
@@ -3792,6 +3999,8 @@ void vtkDataReader::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Field Data Name: (None)\n";
   }
   os << indent << "ReadAllFields: " << (this->ReadAllFields ? "On" : "Off") << "\n";
+  os << indent << "ParallelASCIIParsing: " << (this->ParallelASCIIParsing ? "On" : "Off")
+     << "\n";
 
   os << indent << "InputStringLength: " << this->InputStringLength << endl;
 }
@@ -332,6 +332,20 @@ public:
   vtkBooleanMacro(ReadAllFields, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Enable parsing large ASCII numeric sections (points, cells, attributes
+   * and fields) concurrently using vtkSMPTools.  The text is read in large
+   * batches which are split into whitespace-aligned chunks, tokenized and
+   * parsed in parallel.  Any value the fast parser is not certain to read
+   * exactly like stream extraction makes the rest of the section fall back
+   * to the serial path, so the results are identical.  Default is false.
+   */
+  vtkSetMacro(ParallelASCIIParsing, bool);
+  vtkGetMacro(ParallelASCIIParsing, bool);
+  vtkBooleanMacro(ParallelASCIIParsing, bool);
+  ///@}
+
   /**
    * Open a vtk data file. Returns zero if error.
    */
@@ -587,6 +601,7 @@ protected:
   vtkTypeBool ReadAllColorScalars;
   vtkTypeBool ReadAllTCoords;
   vtkTypeBool ReadAllFields;
+  bool ParallelASCIIParsing;
 
   std::locale CurrentLocale;
 
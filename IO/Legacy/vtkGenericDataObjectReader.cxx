@@ -64,6 +64,7 @@ void vtkGenericDataObjectReader::ReadData(
   reader->SetReadAllColorScalars(this->GetReadAllColorScalars());
   reader->SetReadAllTCoords(this->GetReadAllTCoords());
   reader->SetReadAllFields(this->GetReadAllFields());
+  reader->SetParallelASCIIParsing(this->GetParallelASCIIParsing());
   reader->Update();
 
   // copy the header from the reader.
@@ -2,14 +2,19 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPLYReader.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMappedFileResourceStream.h"
+#include "vtkMath.h"
 #include "vtkMathUtilities.h"
+#include "vtkMemoryResourceStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPLY.h"
@@ -17,15 +22,20 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkResourceParser.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkValueFromString.h"
 
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstddef>
+#include <cstring>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -81,6 +91,718 @@ bool FuzzyEqual(double* f, double* s, double t)
 }
 }
 
+namespace
+{
+// Contents smaller than this are not split further.
+constexpr std::size_t PLYMinimumChunkSize = 1 << 18;
+
+// Value of a property as converted by vtkPLY::get_binary_item and
+// vtkPLY::get_ascii_item.
+struct vtkPLYValue
+{
+  int Int = 0;
+  unsigned int UInt = 0;
+  double Double = 0.0;
+};
+
+// A property of the file, in file order, and where the reader stores it.
+struct vtkPLYField
+{
+  int Type = 0;      // file type of the values
+  int CountType = 0; // file type of the list count, 0 for scalar properties
+  float* Floats = nullptr;
+  unsigned char* UChars = nullptr;
+  int Stride = 0;
+  bool Indices = false; // the vertex indices of a face
+};
+
+// A property read by the reader, with the array component storing it.
+struct vtkPLYTarget
+{
+  const char* Name;
+  vtkDataArray* Array;
+  int Component;
+};
+
+std::size_t vtkPLYTypeSize(int type)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      return 1;
+    case PLY_SHORT:
+    case PLY_INT16:
+    case PLY_USHORT:
+    case PLY_UINT16:
+      return 2;
+    case PLY_DOUBLE:
+    case PLY_FLOAT64:
+      return 8;
+    default:
+      return 4;
+  }
+}
+
+bool vtkPLYIsFloating(int type)
+{
+  return type == PLY_FLOAT || type == PLY_FLOAT32 || type == PLY_DOUBLE || type == PLY_FLOAT64;
+}
+
+template <typename T>
+T vtkPLYLoad(const char* pos, bool bigEndian)
+{
+  T value;
+  std::memcpy(&value, pos, sizeof(T));
+  if (bigEndian)
+  {
+    vtkByteSwap::SwapBE(&value);
+  }
+  else
+  {
+    vtkByteSwap::SwapLE(&value);
+  }
+  return value;
+}
+
+template <typename T>
+vtkPLYValue vtkPLYLoadIntegral(const char* pos, bool bigEndian)
+{
+  const T value = vtkPLYLoad<T>(pos, bigEndian);
+  vtkPLYValue result;
+  result.Int = static_cast<int>(value);
+  result.UInt = static_cast<unsigned int>(value);
+  result.Double = static_cast<double>(value);
+  return result;
+}
+
+// Decode a binary value the way vtkPLY::get_binary_item does.
+vtkPLYValue vtkPLYLoadValue(const char* pos, int type, bool bigEndian)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+      return vtkPLYLoadIntegral<vtkTypeInt8>(pos, bigEndian);
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      return vtkPLYLoadIntegral<vtkTypeUInt8>(pos, bigEndian);
+    case PLY_SHORT:
+    case PLY_INT16:
+      return vtkPLYLoadIntegral<vtkTypeInt16>(pos, bigEndian);
+    case PLY_USHORT:
+    case PLY_UINT16:
+      return vtkPLYLoadIntegral<vtkTypeUInt16>(pos, bigEndian);
+    case PLY_INT:
+    case PLY_INT32:
+      return vtkPLYLoadIntegral<vtkTypeInt32>(pos, bigEndian);
+    case PLY_UINT:
+    case PLY_UINT32:
+      return vtkPLYLoadIntegral<vtkTypeUInt32>(pos, bigEndian);
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+    {
+      const vtkTypeFloat32 value = vtkPLYLoad<vtkTypeFloat32>(pos, bigEndian);
+      vtkPLYValue result;
+      result.Int = static_cast<int>(
+        vtkMath::ClampValue(value, static_cast<float>(VTK_INT_MIN), 2147483520.0f));
+      result.UInt = static_cast<unsigned int>(vtkMath::ClampValue(value, 0.0f, 4294967040.0f));
+      result.Double = static_cast<double>(value);
+      return result;
+    }
+    default:
+    {
+      const vtkTypeFloat64 value = vtkPLYLoad<vtkTypeFloat64>(pos, bigEndian);
+      vtkPLYValue result;
+      result.Int = static_cast<int>(vtkMath::ClampValue(
+        value, static_cast<double>(VTK_INT_MIN), static_cast<double>(VTK_INT_MAX)));
+      result.UInt = static_cast<unsigned int>(
+        vtkMath::ClampValue(value, 0.0, static_cast<double>(VTK_UNSIGNED_INT_MAX)));
+      result.Double = value;
+      return result;
+    }
+  }
+}
+
+void vtkPLYStore(const vtkPLYField& field, vtkIdType record, const vtkPLYValue& value)
+{
+  if (field.Floats)
+  {
+    field.Floats[record * field.Stride] = static_cast<float>(value.Double);
+  }
+  else if (field.UChars)
+  {
+    field.UChars[record * field.Stride] = static_cast<unsigned char>(value.UInt);
+  }
+}
+
+// Number of vertex indices the serial reader accepts in a face.
+bool vtkPLYValidCount(const vtkPLYField& field, int count)
+{
+  return count >= 0 && (!field.Indices || count <= VTK_UNSIGNED_CHAR_MAX);
+}
+
+// Return the end of the binary record at `pos` without decoding it, or
+// nullptr if the record is truncated or invalid.
+const char* vtkPLYSkipBinaryRecord(const char* pos, const char* end, bool bigEndian,
+  const std::vector<vtkPLYField>& fields, vtkIdType& numberOfIds)
+{
+  numberOfIds = 0;
+  for (const auto& field : fields)
+  {
+    const std::size_t size = vtkPLYTypeSize(field.Type);
+    int count = 1;
+    if (field.CountType)
+    {
+      const std::size_t countSize = vtkPLYTypeSize(field.CountType);
+      if (static_cast<std::size_t>(end - pos) < countSize)
+      {
+        return nullptr;
+      }
+      count = vtkPLYLoadValue(pos, field.CountType, bigEndian).Int;
+      pos += countSize;
+      if (!vtkPLYValidCount(field, count))
+      {
+        return nullptr;
+      }
+      numberOfIds = field.Indices ? count : numberOfIds;
+    }
+    if (static_cast<std::size_t>(end - pos) / size < static_cast<std::size_t>(count))
+    {
+      return nullptr;
+    }
+    pos += count * size;
+  }
+  return pos;
+}
+
+// Decode the binary record at `pos` and its face vertex indices, if any, into
+// `ids`. Return the end of the record, or nullptr if it is truncated, invalid
+// or does not hold `numberOfIds` vertex indices.
+const char* vtkPLYReadBinaryRecord(const char* pos, const char* end, bool bigEndian,
+  const std::vector<vtkPLYField>& fields, vtkIdType record, vtkIdType* ids, vtkIdType numberOfIds)
+{
+  for (const auto& field : fields)
+  {
+    const std::size_t size = vtkPLYTypeSize(field.Type);
+    if (!field.CountType)
+    {
+      if (static_cast<std::size_t>(end - pos) < size)
+      {
+        return nullptr;
+      }
+      vtkPLYStore(field, record, vtkPLYLoadValue(pos, field.Type, bigEndian));
+      pos += size;
+      continue;
+    }
+
+    const std::size_t countSize = vtkPLYTypeSize(field.CountType);
+    if (static_cast<std::size_t>(end - pos) < countSize)
+    {
+      return nullptr;
+    }
+    const int count = vtkPLYLoadValue(pos, field.CountType, bigEndian).Int;
+    pos += countSize;
+    if (!vtkPLYValidCount(field, count) || (field.Indices && count != numberOfIds) ||
+      static_cast<std::size_t>(end - pos) / size < static_cast<std::size_t>(count))
+    {
+      return nullptr;
+    }
+    if (field.Indices)
+    {
+      for (int i = 0; i < count; ++i, pos += size)
+      {
+        ids[i] = vtkPLYLoadValue(pos, field.Type, bigEndian).Int;
+      }
+    }
+    else
+    {
+      pos += count * size;
+    }
+  }
+  return pos;
+}
+
+void vtkPLYAllocateCells(vtkCellArray* cells, vtkIdType numberOfCells, vtkIdType numberOfIds,
+  vtkIdType*& offsets, vtkIdType*& ids)
+{
+  vtkNew<vtkIdTypeArray> offsetsArray;
+  offsetsArray->SetNumberOfValues(numberOfCells + 1);
+  offsets = offsetsArray->GetPointer(0);
+  offsets[numberOfCells] = numberOfIds;
+  vtkNew<vtkIdTypeArray> idsArray;
+  idsArray->SetNumberOfValues(numberOfIds);
+  ids = idsArray->GetPointer(0);
+  cells->SetData(offsetsArray, idsArray);
+}
+
+// Decode the `numberOfRecords` binary records of an element starting at
+// `begin` concurrently, and their vertex indices into `cells` if not nullptr.
+// Records are first assumed to have the size and number of indices of the
+// first one, and are located by a serial scan if they do not. Return the end
+// of the element, or nullptr on failure.
+const char* vtkPLYReadBinaryElement(const char* begin, const char* end, bool bigEndian,
+  const std::vector<vtkPLYField>& fields, vtkIdType numberOfRecords, vtkCellArray* cells)
+{
+  vtkIdType* offsets = nullptr;
+  vtkIdType* ids = nullptr;
+  if (numberOfRecords == 0)
+  {
+    if (cells)
+    {
+      vtkPLYAllocateCells(cells, 0, 0, offsets, ids);
+    }
+    return begin;
+  }
+
+  vtkIdType firstIds;
+  const char* firstEnd = vtkPLYSkipBinaryRecord(begin, end, bigEndian, fields, firstIds);
+  if (!firstEnd)
+  {
+    return nullptr;
+  }
+
+  const std::size_t stride = static_cast<std::size_t>(firstEnd - begin);
+  if (stride > 0 &&
+    static_cast<std::size_t>(end - begin) / stride >= static_cast<std::size_t>(numberOfRecords))
+  {
+    if (cells)
+    {
+      vtkPLYAllocateCells(cells, numberOfRecords, numberOfRecords * firstIds, offsets, ids);
+    }
+    std::atomic<bool> fixedSize(true);
+    vtkSMPTools::For(0, numberOfRecords, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last && fixedSize; ++i)
+      {
+        const char* record = begin + i * stride;
+        vtkIdType* recordIds = nullptr;
+        if (cells)
+        {
+          offsets[i] = i * firstIds;
+          recordIds = ids + offsets[i];
+        }
+        if (vtkPLYReadBinaryRecord(record, end, bigEndian, fields, i, recordIds, firstIds) !=
+          record + stride)
+        {
+          fixedSize = false;
+        }
+      }
+    });
+    if (fixedSize)
+    {
+      return begin + numberOfRecords * stride;
+    }
+  }
+
+  // Records of different sizes are located serially, only reading list counts.
+  std::vector<const char*> records(numberOfRecords + 1);
+  std::vector<vtkIdType> recordIds(numberOfRecords + 1);
+  records[0] = begin;
+  recordIds[0] = 0;
+  for (vtkIdType i = 0; i < numberOfRecords; ++i)
+  {
+    vtkIdType numberOfIds;
+    records[i + 1] = vtkPLYSkipBinaryRecord(records[i], end, bigEndian, fields, numberOfIds);
+    if (!records[i + 1])
+    {
+      return nullptr;
+    }
+    recordIds[i + 1] = recordIds[i] + numberOfIds;
+  }
+  if (cells)
+  {
+    vtkPLYAllocateCells(cells, numberOfRecords, recordIds[numberOfRecords], offsets, ids);
+    std::copy(recordIds.begin(), recordIds.end() - 1, offsets);
+  }
+  vtkSMPTools::For(0, numberOfRecords, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      vtkPLYReadBinaryRecord(records[i], end, bigEndian, fields, i,
+        cells ? ids + recordIds[i] : nullptr, recordIds[i + 1] - recordIds[i]);
+    }
+  });
+  return records[numberOfRecords];
+}
+
+// Whitespace inside a line of an ASCII file.
+inline bool vtkPLYIsBlank(char c)
+{
+  return c != '\n' && std::isspace(static_cast<unsigned char>(c));
+}
+
+// Parse a whole token the way vtkPLY::get_ascii_item does. Return false if
+// the serial parser would not consume exactly this token.
+bool vtkPLYParseASCII(const char*& pos, const char* end, int type, vtkPLYValue& value)
+{
+  while (pos != end && vtkPLYIsBlank(*pos))
+  {
+    ++pos;
+  }
+  std::size_t consumed = 0;
+  if (vtkPLYIsFloating(type))
+  {
+    consumed = vtkValueFromString(pos, end, value.Double);
+  }
+  else if (type == PLY_UINT || type == PLY_UINT32)
+  {
+    consumed = vtkValueFromString(pos, end, value.UInt);
+    value.Int = static_cast<int>(value.UInt);
+  }
+  else
+  {
+    consumed = vtkValueFromString(pos, end, value.Int);
+    value.UInt = static_cast<unsigned int>(value.Int);
+  }
+  pos += consumed;
+  return consumed != 0 && (pos == end || vtkPLYIsBlank(*pos));
+}
+
+// Parse the ASCII record held by the line [pos, end), appending its face
+// vertex indices, if any, to `ids`.
+bool vtkPLYReadASCIIRecord(const char* pos, const char* end,
+  const std::vector<vtkPLYField>& fields, vtkIdType record, std::vector<vtkIdType>& ids)
+{
+  vtkPLYValue value;
+  for (const auto& field : fields)
+  {
+    if (!field.CountType)
+    {
+      if (!vtkPLYParseASCII(pos, end, field.Type, value))
+      {
+        return false;
+      }
+      vtkPLYStore(field, record, value);
+      continue;
+    }
+
+    if (!vtkPLYParseASCII(pos, end, field.CountType, value) || !vtkPLYValidCount(field, value.Int))
+    {
+      return false;
+    }
+    const int count = value.Int;
+    for (int i = 0; i < count; ++i)
+    {
+      if (!vtkPLYParseASCII(pos, end, field.Type, value))
+      {
+        return false;
+      }
+      if (field.Indices)
+      {
+        ids.push_back(value.Int);
+      }
+    }
+  }
+  while (pos != end && vtkPLYIsBlank(*pos))
+  {
+    ++pos;
+  }
+  return pos == end;
+}
+
+// Lines of an ASCII file parsed by a task.
+struct vtkPLYChunk
+{
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+  vtkIdType NumberOfRecords = 0;
+  vtkIdType FirstRecord = 0;
+  std::vector<vtkIdType> Ids;
+  vtkIdType FirstId = 0;
+};
+
+// Call `functor(first, last)` for each line of [begin, end) holding a record.
+template <typename Functor>
+bool vtkPLYForEachRecord(const char* begin, const char* end, Functor&& functor)
+{
+  const char* pos = begin;
+  while (pos != end)
+  {
+    const char* eol = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    eol = eol ? eol : end;
+    const char* first = pos;
+    while (first != eol && vtkPLYIsBlank(*first))
+    {
+      ++first;
+    }
+    pos = eol == end ? end : eol + 1;
+    if (first != eol && !functor(first, eol))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parse the vertex records, then the face records, of the ASCII content
+// [begin, end) concurrently, each record being on its own line.
+bool vtkPLYReadASCIIElements(const char* begin, const char* end,
+  const std::vector<vtkPLYField>& vertexFields, vtkIdType numberOfVertices,
+  const std::vector<vtkPLYField>& faceFields, vtkIdType numberOfFaces, vtkCellArray* cells)
+{
+  const std::size_t size = static_cast<std::size_t>(end - begin);
+  const std::size_t maxChunks =
+    8 * static_cast<std::size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+  const std::size_t numberOfChunks =
+    std::max<std::size_t>(1, std::min(maxChunks, size / PLYMinimumChunkSize));
+  std::vector<vtkPLYChunk> chunks;
+  const char* chunkBegin = begin;
+  for (std::size_t i = 1; i <= numberOfChunks && chunkBegin != end; ++i)
+  {
+    const char* chunkEnd = end;
+    if (i < numberOfChunks)
+    {
+      chunkEnd = std::max(chunkBegin, begin + i * (size / numberOfChunks));
+      chunkEnd = static_cast<const char*>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+      chunkEnd = chunkEnd ? chunkEnd + 1 : end;
+    }
+    chunks.emplace_back();
+    chunks.back().Begin = chunkBegin;
+    chunks.back().End = chunkEnd;
+    chunkBegin = chunkEnd;
+  }
+
+  const vtkIdType numberOfTasks = static_cast<vtkIdType>(chunks.size());
+  vtkSMPTools::For(0, numberOfTasks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      vtkPLYChunk& chunk = chunks[i];
+      vtkPLYForEachRecord(chunk.Begin, chunk.End, [&chunk](const char*, const char*) {
+        ++chunk.NumberOfRecords;
+        return true;
+      });
+    }
+  });
+  vtkIdType numberOfRecords = 0;
+  for (auto& chunk : chunks)
+  {
+    chunk.FirstRecord = numberOfRecords;
+    numberOfRecords += chunk.NumberOfRecords;
+  }
+  // Records of other elements may follow, the serial reader ignores them.
+  if (numberOfRecords < numberOfVertices + numberOfFaces)
+  {
+    return false;
+  }
+
+  vtkIdType* offsets = nullptr;
+  vtkIdType* ids = nullptr;
+  vtkNew<vtkIdTypeArray> offsetsArray;
+  if (cells)
+  {
+    offsetsArray->SetNumberOfValues(numberOfFaces + 1);
+    offsets = offsetsArray->GetPointer(0);
+  }
+  std::atomic<bool> parsed(true);
+  vtkSMPTools::For(0, numberOfTasks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last && parsed; ++i)
+    {
+      vtkPLYChunk& chunk = chunks[i];
+      vtkIdType record = chunk.FirstRecord;
+      const bool chunkParsed =
+        vtkPLYForEachRecord(chunk.Begin, chunk.End, [&](const char* line, const char* eol) {
+          const vtkIdType current = record++;
+          if (current < numberOfVertices)
+          {
+            return vtkPLYReadASCIIRecord(line, eol, vertexFields, current, chunk.Ids);
+          }
+          const vtkIdType face = current - numberOfVertices;
+          if (face < numberOfFaces)
+          {
+            if (offsets)
+            {
+              offsets[face] = static_cast<vtkIdType>(chunk.Ids.size());
+            }
+            return vtkPLYReadASCIIRecord(line, eol, faceFields, face, chunk.Ids);
+          }
+          return true;
+        });
+      if (!chunkParsed)
+      {
+        parsed = false;
+      }
+    }
+  });
+  if (!parsed || !cells)
+  {
+    return parsed;
+  }
+
+  // Shift the face offsets of each chunk and gather their vertex indices.
+  vtkIdType numberOfIds = 0;
+  for (auto& chunk : chunks)
+  {
+    chunk.FirstId = numberOfIds;
+    numberOfIds += static_cast<vtkIdType>(chunk.Ids.size());
+  }
+  offsets[numberOfFaces] = numberOfIds;
+  vtkNew<vtkIdTypeArray> idsArray;
+  idsArray->SetNumberOfValues(numberOfIds);
+  ids = idsArray->GetPointer(0);
+  vtkSMPTools::For(0, numberOfTasks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      const vtkPLYChunk& chunk = chunks[i];
+      const vtkIdType firstFace = std::max<vtkIdType>(chunk.FirstRecord - numberOfVertices, 0);
+      const vtkIdType lastFace = std::min(
+        chunk.FirstRecord + chunk.NumberOfRecords - numberOfVertices, numberOfFaces);
+      for (vtkIdType face = firstFace; face < lastFace; ++face)
+      {
+        offsets[face] += chunk.FirstId;
+      }
+      std::copy(chunk.Ids.begin(), chunk.Ids.end(), ids + chunk.FirstId);
+    }
+  });
+  cells->SetData(offsetsArray, idsArray);
+  return true;
+}
+
+// Describe how the properties of `elem` are read into the targets. Return
+// false if a target cannot be decoded concurrently as the serial reader does.
+bool vtkPLYGetFields(PlyElement* elem, bool ascii, const std::vector<vtkPLYTarget>& targets,
+  bool faces, std::vector<vtkPLYField>& fields)
+{
+  fields.resize(elem->nprops);
+  for (int i = 0; i < elem->nprops; ++i)
+  {
+    const PlyProperty* prop = elem->props[i];
+    fields[i].Type = prop->external_type;
+    fields[i].CountType = prop->is_list ? prop->count_external : 0;
+    // ASCII list counts are read as integers only.
+    if (ascii && prop->is_list && vtkPLYIsFloating(prop->count_external))
+    {
+      return false;
+    }
+  }
+
+  int index;
+  if (faces)
+  {
+    if (!vtkPLY::find_property(elem, "vertex_indices", &index) || !fields[index].CountType ||
+      (ascii && vtkPLYIsFloating(fields[index].Type)))
+    {
+      return false;
+    }
+    fields[index].Indices = true;
+  }
+
+  for (const auto& target : targets)
+  {
+    if (!vtkPLY::find_property(elem, target.Name, &index) || fields[index].CountType)
+    {
+      return false;
+    }
+    vtkPLYField& field = fields[index];
+    field.Stride = target.Array->GetNumberOfComponents();
+    if (auto floats = vtkFloatArray::SafeDownCast(target.Array))
+    {
+      // ASCII integers are not converted to floating point values.
+      if (ascii && !vtkPLYIsFloating(field.Type))
+      {
+        return false;
+      }
+      field.Floats = floats->GetPointer(0) + target.Component;
+    }
+    else if (auto uchars = vtkUnsignedCharArray::SafeDownCast(target.Array))
+    {
+      // ASCII floating point values are not converted to integers.
+      if (ascii && vtkPLYIsFloating(field.Type))
+      {
+        return false;
+      }
+      field.UChars = uchars->GetPointer(0) + target.Component;
+    }
+  }
+  return true;
+}
+
+// Read the vertex and face elements of `ply`, held by [begin, end), into the
+// output concurrently. Return false if they must be read by the serial reader.
+bool vtkPLYReadParallel(PlyFile* ply, const char* begin, const char* end,
+  std::vector<vtkPLYTarget> vertexTargets, const std::vector<vtkPLYTarget>& faceTargets,
+  vtkPolyData* output)
+{
+  // The vertex element comes first, directly followed by the face element if
+  // any. Other elements are ignored by the serial reader.
+  PlyElement* vertices = ply->elems[0];
+  PlyElement* faces = nullptr;
+  if (!vtkPLY::equal_strings(vertices->name, "vertex"))
+  {
+    return false;
+  }
+  for (int i = 1; i < ply->nelems; ++i)
+  {
+    const char* name = ply->elems[i]->name;
+    if (i == 1 && vtkPLY::equal_strings(name, "face"))
+    {
+      faces = ply->elems[i];
+    }
+    else if (vtkPLY::equal_strings(name, "vertex") || vtkPLY::equal_strings(name, "face"))
+    {
+      return false;
+    }
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(vertices->num);
+  const char* const coordinates[] = { "x", "y", "z" };
+  for (int i = 0; i < 3; ++i)
+  {
+    vertexTargets.push_back({ coordinates[i], points->GetData(), i });
+  }
+  for (const auto& target : vertexTargets)
+  {
+    target.Array->SetNumberOfTuples(vertices->num);
+  }
+  for (const auto& target : faceTargets)
+  {
+    target.Array->SetNumberOfTuples(faces ? faces->num : 0);
+  }
+
+  const bool ascii = ply->file_type == PLY_ASCII;
+  std::vector<vtkPLYField> vertexFields;
+  std::vector<vtkPLYField> faceFields;
+  if (!vtkPLYGetFields(vertices, ascii, vertexTargets, false, vertexFields) ||
+    (faces && !vtkPLYGetFields(faces, ascii, faceTargets, true, faceFields)))
+  {
+    return false;
+  }
+
+  vtkNew<vtkCellArray> polys;
+  vtkCellArray* cells = faces ? polys.Get() : nullptr;
+  const vtkIdType numberOfFaces = faces ? faces->num : 0;
+  if (ascii)
+  {
+    if (!vtkPLYReadASCIIElements(
+          begin, end, vertexFields, vertices->num, faceFields, numberOfFaces, cells))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    const bool bigEndian = ply->file_type == PLY_BINARY_BE;
+    const char* facesBegin =
+      vtkPLYReadBinaryElement(begin, end, bigEndian, vertexFields, vertices->num, nullptr);
+    if (!facesBegin ||
+      (cells &&
+        !vtkPLYReadBinaryElement(facesBegin, end, bigEndian, faceFields, numberOfFaces, cells)))
+    {
+      return false;
+    }
+  }
+
+  output->SetPoints(points);
+  if (cells)
+  {
+    output->SetPolys(cells);
+  }
+  return true;
+}
+}
+
 // Construct object with merging set to true.
 vtkPLYReader::vtkPLYReader()
 {
@@ -88,6 +810,7 @@ vtkPLYReader::vtkPLYReader()
   this->ReadFromInputString = false;
   this->FaceTextureTolerance = 0.000001;
   this->DuplicatePointsForFaceTexture = true;
+  this->ParallelReading = false;
 }
 
 vtkPLYReader::~vtkPLYReader()
@@ -168,6 +891,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   PlyFile* ply;
   int nelems, numElems, nprops;
   char **elist, *elemName;
+  vtkSmartPointer<vtkMappedFileResourceStream> mappedFile;
 
   if (this->ReadFromInputStream)
   {
@@ -185,6 +909,17 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       return 0;
     }
   }
+  else if (this->ParallelReading)
+  {
+    // Map the file so that its elements can be decoded in place
+    mappedFile = vtkSmartPointer<vtkMappedFileResourceStream>::New();
+    if (!this->FileName || !mappedFile->Open(this->FileName) ||
+      !(ply = vtkPLY::ply_read(mappedFile, &nelems, &elist)))
+    {
+      vtkWarningMacro(<< "Could not open PLY file");
+      return 0;
+    }
+  }
   else
   {
     if (!(ply = vtkPLY::ply_open_for_reading(this->FileName, &nelems, &elist)))
@@ -205,6 +940,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   // Check to make sure that we can read geometry
   PlyElement* elem;
   int index;
+  bool geometryAvailable = true;
   if ((elem = vtkPLY::find_element(ply, "vertex")) == nullptr ||
     vtkPLY::find_property(elem, "x", &index) == nullptr ||
     vtkPLY::find_property(elem, "y", &index) == nullptr ||
@@ -212,6 +948,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   {
     vtkErrorMacro(<< "Cannot read geometry");
     vtkPLY::ply_close(ply);
+    geometryAvailable = false;
   }
 
   // Check for optional attribute data. We can handle intensity; and the
@@ -343,6 +1080,96 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       output->GetPointData()->SetTCoords(texCoordsPoints);
     }
   }
+
+  // Decode the elements concurrently when the layout of the file allows it.
+  // Face texture coordinates need the faces to be processed in order.
+  std::vector<char> streamContent;
+  if (this->ParallelReading && geometryAvailable && !texCoordsFaceAvailable)
+  {
+    // Content of the elements, following the header
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (this->ReadFromInputStream)
+    {
+      constexpr std::size_t blockSize = 1 << 20;
+      std::size_t read = 0;
+      do
+      {
+        const std::size_t previousSize = streamContent.size();
+        streamContent.resize(previousSize + blockSize);
+        read = ply->parser->Read(streamContent.data() + previousSize, blockSize);
+        streamContent.resize(previousSize + read);
+      } while (read > 0);
+      begin = streamContent.data();
+      end = begin + streamContent.size();
+
+      // The serial reader continues from the content read
+      auto memoryStream = vtkSmartPointer<vtkMemoryResourceStream>::New();
+      memoryStream->SetBuffer(streamContent.data(), streamContent.size());
+      ply->is = memoryStream;
+      ply->parser->SetStream(memoryStream);
+    }
+    else if (this->ReadFromInputString)
+    {
+      begin = this->InputString.data() + ply->parser->Tell();
+      end = this->InputString.data() + this->InputString.size();
+    }
+    else
+    {
+      begin = reinterpret_cast<const char*>(mappedFile->GetData()) + ply->parser->Tell();
+      end = reinterpret_cast<const char*>(mappedFile->GetData()) + mappedFile->GetSize();
+    }
+
+    std::vector<vtkPLYTarget> vertexTargets;
+    if (texCoordsPointsAvailable)
+    {
+      vertexTargets.push_back({ vertProps[3].name, texCoordsPoints, 0 });
+      vertexTargets.push_back({ vertProps[4].name, texCoordsPoints, 1 });
+    }
+    if (normalPointsAvailable)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        vertexTargets.push_back({ vertProps[5 + i].name, normals, i });
+      }
+    }
+    if (rgbPointsAvailable)
+    {
+      for (int i = 0; i < rgbPoints->GetNumberOfComponents(); ++i)
+      {
+        vertexTargets.push_back({ vertProps[8 + i].name, rgbPoints, i });
+      }
+    }
+    std::vector<vtkPLYTarget> faceTargets;
+    if (intensityAvailable)
+    {
+      faceTargets.push_back({ faceProps[1].name, intensity, 0 });
+    }
+    if (rgbCellsAvailable)
+    {
+      for (int i = 0; i < rgbCells->GetNumberOfComponents(); ++i)
+      {
+        faceTargets.push_back({ faceProps[2 + i].name, rgbCells, i });
+      }
+    }
+
+    if (vtkPLYReadParallel(ply, begin, end, vertexTargets, faceTargets, output))
+    {
+      for (int i = 0; i < nelems; i++)
+      {
+        free(elist[i]); // allocated by ply_open_for_reading
+      }
+      free(elist);
+
+      vtkDebugMacro(<< "Read: " << output->GetNumberOfPoints() << " points, "
+                    << output->GetNumberOfPolys() << " polygons");
+
+      vtkPLY::ply_close(ply);
+      return 1;
+    }
+    vtkDebugMacro(<< "Elements cannot be decoded concurrently, reading them serially");
+  }
+
   // Okay, now we can grab the data
   int numPts = 0, numPolys = 0;
   for (int i = 0; i < nelems; i++)
@@ -646,5 +1473,6 @@ void vtkPLYReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << this->Comments->GetValue(i) << "\n";
   }
+  os << indent << "ParallelReading: " << (this->ParallelReading ? "On" : "Off") << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -22,6 +22,9 @@
  * filter after this reader or use this reader with DuplicatePointsForFaceTexture
  * set to false.
  *
+ * When ParallelReading is on, the vertex and face elements of ASCII and
+ * binary files are decoded concurrently.
+ *
  * @sa
  * vtkPLYWriter, vtkCleanPolyData
  */
@@ -103,6 +106,21 @@ public:
   vtkGetMacro(DuplicatePointsForFaceTexture, bool);
   vtkSetMacro(DuplicatePointsForFaceTexture, bool);
 
+  ///@{
+  /**
+   * If true, decode the vertex and face elements concurrently using
+   * vtkSMPTools. Files are memory-mapped and binary records are decoded in
+   * place, while the lines of ASCII files are split in chunks parsed
+   * concurrently. Files with face texture coordinates, or whose layout cannot
+   * be decoded this way, are read serially. The output is the same as with
+   * serial reading.
+   * Default is false.
+   */
+  vtkSetMacro(ParallelReading, bool);
+  vtkGetMacro(ParallelReading, bool);
+  vtkBooleanMacro(ParallelReading, bool);
+  ///@}
+
 protected:
   vtkPLYReader();
   ~vtkPLYReader() override;
@@ -125,6 +143,7 @@ private:
 
   float FaceTextureTolerance;
   bool DuplicatePointsForFaceTexture;
+  bool ParallelReading;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that memory-mapped raw appended arrays read the same values as the
+// copying path, outlive their reader and do not write through to the file.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkUnstructuredGrid> ReadGrid(
+  const std::string& fileName, bool mapped, vtkIdType& numMappedArrays)
+{
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(mapped);
+  reader->Update();
+  numMappedArrays = reader->GetNumberOfMappedArrays();
+  return reader->GetOutput();
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* actual, const char* name)
+{
+  if (!expected || !actual || expected->GetNumberOfValues() != actual->GetNumberOfValues())
+  {
+    std::cerr << "Array " << name << " missing or of wrong size." << std::endl;
+    return false;
+  }
+  const int numComps = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetComponent(i / numComps, i % numComps) !=
+      actual->GetComponent(i / numComps, i % numComps))
+    {
+      std::cerr << "Array " << name << " differs at value " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLMemoryMappedRead(int argc, char* argv[])
+{
+  char* temp_dir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!temp_dir)
+  {
+    std::cerr << "Could not determine temporary directory." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(temp_dir) + "/TestXMLMemoryMappedRead.vtu";
+  delete[] temp_dir;
+
+  const vtkIdType numPoints = 10000;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkCellArray> cells;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    points->SetPoint(i, i % 100, i / 100, 0.5 * (i % 7));
+    values->SetTuple3(i, 0.25 * i, -1.0 * i, 1.0 / (i + 1));
+    labels->SetValue(i, static_cast<int>((i * 7919) % 1009));
+    cells->InsertNextCell(1, &i);
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->SetCells(VTK_VERTEX, cells);
+  grid->GetPointData()->AddArray(values);
+  grid->GetPointData()->AddArray(labels);
+
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+
+  // Arrays are only mapped when their values are aligned in the file, which
+  // depends on the length of the XML header: lengthen the name of Values
+  // until the points, Values and Labels are. The reader is destroyed before
+  // the arrays are checked.
+  vtkIdType numMapped = 0;
+  vtkIdType numCopied = 0;
+  vtkSmartPointer<vtkUnstructuredGrid> mapped;
+  vtkSmartPointer<vtkUnstructuredGrid> copied;
+  for (int padding = 0; padding < 8 && numMapped < 3; ++padding)
+  {
+    mapped = nullptr;
+    values->SetName((std::string("Values") + std::string(padding, '_')).c_str());
+    if (!writer->Write())
+    {
+      std::cerr << "Could not write " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    mapped = ReadGrid(fileName, true, numMapped);
+    copied = ReadGrid(fileName, false, numCopied);
+    if (mapped->GetNumberOfPoints() != numPoints || mapped->GetNumberOfCells() != numPoints)
+    {
+      std::cerr << "Unexpected number of points or cells." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // At least the points, Values and Labels must be mapped, and nothing when disabled.
+  if (numMapped < 3 || numCopied != 0)
+  {
+    std::cerr << "Expected at least 3 mapped arrays and none when copying, got " << numMapped
+              << " and " << numCopied << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int status = EXIT_SUCCESS;
+  if (!CompareArrays(points->GetData(), mapped->GetPoints()->GetData(), "Points") ||
+    !CompareArrays(copied->GetPoints()->GetData(), mapped->GetPoints()->GetData(), "Points") ||
+    !CompareArrays(values, mapped->GetPointData()->GetArray(values->GetName()), "Values") ||
+    !CompareArrays(labels, mapped->GetPointData()->GetArray("Labels"), "Labels"))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // Writing to a mapped array must not change the file.
+  vtkIntArray* mappedLabels = vtkIntArray::SafeDownCast(mapped->GetPointData()->GetArray("Labels"));
+  if (!mappedLabels)
+  {
+    std::cerr << "Labels array has the wrong type." << std::endl;
+    return EXIT_FAILURE;
+  }
+  mappedLabels->SetValue(0, -1);
+  mapped = nullptr;
+  vtkSmartPointer<vtkUnstructuredGrid> reread = ReadGrid(fileName, true, numMapped);
+  if (!CompareArrays(labels, reread->GetPointData()->GetArray("Labels"), "Labels"))
+  {
+    std::cerr << "Modifying a mapped array changed the file." << std::endl;
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
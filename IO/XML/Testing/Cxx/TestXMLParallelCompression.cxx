@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that parallel block compression produces byte-identical files and
+// that parallel block decompression reads the same values back.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+std::string WriteImage(
+  vtkImageData* image, int compressor, int dataMode, bool encode, bool parallel)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  writer->SetEncodeAppendedData(encode);
+  // Use small blocks so that every array spans many of them.
+  writer->SetBlockSize(1024);
+  writer->SetParallelCompression(parallel);
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+bool CheckReadBack(vtkImageData* image, const std::string& content)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->ParallelDecompressionOn();
+  reader->Update();
+
+  vtkImageData* output = reader->GetOutput();
+  for (const char* name : { "Values", "Ids" })
+  {
+    vtkDataArray* expected = image->GetPointData()->GetArray(name);
+    vtkDataArray* actual = output->GetPointData()->GetArray(name);
+    if (!actual || actual->GetNumberOfValues() != expected->GetNumberOfValues())
+    {
+      std::cerr << "Array " << name << " missing or of wrong size." << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+    {
+      if (actual->GetComponent(i / 3, i % 3) != expected->GetComponent(i / 3, i % 3))
+      {
+        std::cerr << "Array " << name << " differs at value " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLParallelCompression(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  const vtkIdType numPoints = image->GetNumberOfPoints();
+
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfComponents(3);
+  ids->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < 3 * numPoints; ++i)
+  {
+    values->SetValue(i, std::sin(0.01 * i) * (i % 17));
+    ids->SetValue(i, (i * 7919) % 1009);
+  }
+  image->GetPointData()->AddArray(values);
+  image->GetPointData()->AddArray(ids);
+
+  int status = EXIT_SUCCESS;
+  for (int compressor : { vtkXMLImageDataWriter::ZLIB, vtkXMLImageDataWriter::LZ4,
+         vtkXMLImageDataWriter::LZMA })
+  {
+    for (int dataMode : { vtkXMLImageDataWriter::Binary, vtkXMLImageDataWriter::Appended })
+    {
+      for (bool encode : { true, false })
+      {
+        const std::string serial = WriteImage(image, compressor, dataMode, encode, false);
+        const std::string parallel = WriteImage(image, compressor, dataMode, encode, true);
+        if (serial != parallel)
+        {
+          std::cerr << "Parallel compression output differs for compressor " << compressor
+                    << ", data mode " << dataMode << ", encoding " << encode << std::endl;
+          status = EXIT_FAILURE;
+        }
+        if (!CheckReadBack(image, parallel))
+        {
+          std::cerr << "Parallel decompression failed for compressor " << compressor
+                    << ", data mode " << dataMode << ", encoding " << encode << std::endl;
+          status = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return status;
+}
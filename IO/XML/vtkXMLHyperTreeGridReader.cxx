@@ -858,7 +858,6 @@ void vtkXMLHyperTreeGridReader::ReadTrees_1(vtkXMLDataElement* elem)
 void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
 {
   vtkHyperTreeGrid* output = vtkHyperTreeGrid::SafeDownCast(this->GetCurrentOutput());
-  vtkNew<vtkHyperTreeGridNonOrientedCursor> treeCursor;
 
   vtkXMLDataElement* treesElement = element->LookupElementWithName("Trees");
 
@@ -923,18 +922,23 @@ void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
     treesElement->FindNestedElementWithNameAndAttribute("DataArray", "Name", "Descriptors");
 
   vtkIdType totalNumberOfVertices = 0;
+  vtkIdType totalReadableDescriptorSize = 0;
   auto numberOfVerticesPerDepthRange = vtk::DataArrayValueRange<1>(numberOfVerticesPerDepth);
   auto numberOfVerticesPerDepthIterator = numberOfVerticesPerDepthRange.cbegin();
 
-  // Computing the total size of scalar fields / mask
+  // Computing the total size of scalar fields / mask / descriptors
   for (vtkIdType treeId = 0; treeId < treeIdsSize; ++treeId)
   {
     unsigned int depth = 0;
+    vtkIdType lastReadableDepthSize = 0;
     for (; depth < std::min<unsigned int>(depthPerTree->GetValue(treeId), this->FixedLevel);
          ++depth, ++numberOfVerticesPerDepthIterator)
     {
-      totalNumberOfVertices += *numberOfVerticesPerDepthIterator;
+      lastReadableDepthSize = *numberOfVerticesPerDepthIterator;
+      totalNumberOfVertices += lastReadableDepthSize;
+      totalReadableDescriptorSize += lastReadableDepthSize;
     }
+    totalReadableDescriptorSize -= lastReadableDepthSize;
     while (depth < depthPerTree->GetValue(treeId) && ++numberOfVerticesPerDepthIterator)
     {
       ++depth;
@@ -976,7 +980,25 @@ void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
     }
   }
 
+  // The readable part of the descriptor of every tree is gathered, the trees
+  // are then built all at once
+  auto descriptors = vtkSmartPointer<vtkBitArray>::Take(
+    vtkArrayDownCast<vtkBitArray>(this->CreateArray(descriptorsElement)));
+  if (!descriptors)
+  {
+    vtkErrorMacro(<< "Missing Descriptor. Aborting");
+    return;
+  }
+  descriptors->SetNumberOfValues(totalReadableDescriptorSize);
+  vtkNew<vtkIdTypeArray> builtTreeIds;
+  builtTreeIds->SetNumberOfValues(treeIdsSize);
+  vtkNew<vtkIdTypeArray> descriptorStarts;
+  descriptorStarts->SetNumberOfValues(treeIdsSize);
+  vtkNew<vtkIdTypeArray> descriptorSizes;
+  descriptorSizes->SetNumberOfValues(treeIdsSize);
+
   vtkIdType descriptorOffset = 0;
+  vtkIdType readableDescriptorOffset = 0;
   vtkIdType inputOffset = 0;
   vtkIdType outputOffset = 0;
   numberOfVerticesPerDepthIterator = numberOfVerticesPerDepthRange.cbegin();
@@ -1001,28 +1023,17 @@ void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
 
     vtkIdType descriptorSize = treeSize - lastDepthSize;
     vtkIdType readableDescriptorSize = readableTreeSize - lastReadableDepthSize;
-    auto descriptor = vtkSmartPointer<vtkBitArray>::Take(
-      vtkArrayDownCast<vtkBitArray>(this->CreateArray(descriptorsElement)));
-    descriptor->SetNumberOfValues(readableDescriptorSize);
-    if (!descriptor)
-    {
-      vtkErrorMacro(<< "Missing Descriptor. Aborting");
-      return;
-    }
     if (readableDescriptorSize &&
-      !this->ReadArrayValues(
-        descriptorsElement, 0, descriptor, descriptorOffset, readableDescriptorSize))
+      !this->ReadArrayValues(descriptorsElement, readableDescriptorOffset, descriptors,
+        descriptorOffset, readableDescriptorSize))
     {
       vtkErrorMacro(<< "Failed reading descriptor at tree " << treeIds->GetValue(treeId)
                     << ". Aborting.");
       return;
     }
-
-    // Parse descriptor storing the global index per level of hypertree
-    output->InitializeNonOrientedCursor(treeCursor, treeIds->GetValue(treeId), true);
-
-    treeCursor->SetGlobalIndexStart(outputOffset);
-    vtkHyperTree* tree = treeCursor->GetTree();
+    builtTreeIds->SetValue(treeId, treeIds->GetValue(treeId));
+    descriptorStarts->SetValue(treeId, readableDescriptorOffset);
+    descriptorSizes->SetValue(treeId, readableDescriptorSize);
 
     if (maskElement)
     {
@@ -1044,10 +1055,17 @@ void vtkXMLHyperTreeGridReader::ReadTrees_2(vtkXMLDataElement* element)
       }
     }
 
-    tree->BuildFromBreadthFirstOrderDescriptor(descriptor, readableDescriptorSize, 0);
     descriptorOffset += descriptorSize;
+    readableDescriptorOffset += readableDescriptorSize;
     outputOffset += readableTreeSize;
     inputOffset += treeSize;
   }
+
+  // The global indices of the trees follow each other, as the values read above
+  if (output->BuildTreesFromBreadthFirstOrderDescriptors(
+        builtTreeIds, descriptors, descriptorStarts, descriptorSizes) != outputOffset)
+  {
+    vtkErrorMacro(<< "The descriptors do not match the number of vertices per depth. Aborting.");
+  }
 }
 VTK_ABI_NAMESPACE_END
@@ -292,6 +292,8 @@ int vtkXMLPDataReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(
     vtkCommand::ProgressEvent, this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetParallelDecompression(this->ParallelDecompression);
+  reader->SetMemoryMapAppendedData(this->MemoryMapAppendedData);
 
   delete[] pieceFileName;
 
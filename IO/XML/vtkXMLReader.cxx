@@ -34,6 +34,9 @@
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
 
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
@@ -43,12 +46,23 @@
 #include <cassert>
 #include <cctype>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <locale> // C++ locale
 #include <numeric>
 #include <sstream>
 #include <vector>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
@@ -124,6 +138,117 @@ static void ReadStringVersion(const char* version, int& major, int& minor)
 
 vtkCxxSetObjectMacro(vtkXMLReader, InputArray, vtkCharArray);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Map size bytes of a file at offset in a private copy-on-write mapping of
+// its own, released by UnmapFileRange.  Returns nullptr if the range is not
+// in the file or cannot be mapped.
+void* MapFileRange(const char* fileName, vtkTypeUInt64 offset, std::size_t size)
+{
+  if (!fileName || size == 0)
+  {
+    return nullptr;
+  }
+#if defined(_WIN32)
+  std::wstring wname = vtksys::Encoding::ToWindowsExtendedPath(fileName);
+  HANDLE file = CreateFileW(wname.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 &&
+    offset <= static_cast<vtkTypeUInt64>(fileSize.QuadPart) &&
+    size <= static_cast<vtkTypeUInt64>(fileSize.QuadPart) - offset)
+  {
+    mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  }
+  CloseHandle(file);
+  if (!mapping)
+  {
+    return nullptr;
+  }
+
+  // Views start at a multiple of the allocation granularity.  The view keeps
+  // the mapping alive, and UnmapFileRange finds the view from any address in it.
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const vtkTypeUInt64 delta = offset % info.dwAllocationGranularity;
+  const vtkTypeUInt64 start = offset - delta;
+  void* view = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(start >> 32),
+    static_cast<DWORD>(start & 0xffffffff), static_cast<SIZE_T>(delta + size));
+  CloseHandle(mapping);
+  return view ? static_cast<unsigned char*>(view) + delta : nullptr;
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0 ||
+    offset > static_cast<vtkTypeUInt64>(st.st_size) ||
+    size > static_cast<vtkTypeUInt64>(st.st_size) - offset)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // The range is mapped after a page recording the length of the whole
+  // region, so that UnmapFileRange only needs the address of the range.
+  const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  const auto delta = static_cast<std::size_t>(offset % pageSize);
+  const std::size_t length = pageSize + delta + size;
+  void* region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (region == MAP_FAILED)
+  {
+    close(fd);
+    return nullptr;
+  }
+  unsigned char* header = static_cast<unsigned char*>(region);
+  void* view = mmap(header + pageSize, delta + size, PROT_READ | PROT_WRITE,
+    MAP_PRIVATE | MAP_FIXED, fd, static_cast<off_t>(offset - delta));
+  close(fd);
+  if (view == MAP_FAILED)
+  {
+    munmap(region, length);
+    return nullptr;
+  }
+  std::memcpy(header, &length, sizeof(length));
+  return header + pageSize + delta;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Free function given to the arrays pointing into a range mapped by
+// MapFileRange.
+void UnmapFileRange(void* data)
+{
+  if (!data)
+  {
+    return;
+  }
+#if defined(_WIN32)
+  MEMORY_BASIC_INFORMATION info;
+  if (VirtualQuery(data, &info, sizeof(info)) == sizeof(info))
+  {
+    UnmapViewOfFile(info.AllocationBase);
+  }
+#else
+  const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  auto* header =
+    reinterpret_cast<unsigned char*>(reinterpret_cast<std::uintptr_t>(data) & ~(pageSize - 1)) -
+    pageSize;
+  std::size_t length;
+  std::memcpy(&length, header, sizeof(length));
+  munmap(header, length);
+#endif
+}
+}
+
 //------------------------------------------------------------------------------
 vtkXMLReader::vtkXMLReader()
 {
@@ -132,6 +257,9 @@ vtkXMLReader::vtkXMLReader()
   this->FileStream = nullptr;
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
+  this->ParallelDecompression = false;
+  this->MemoryMapAppendedData = false;
+  this->NumberOfMappedArrays = 0;
   this->InputString = "";
   this->InputArray = nullptr;
   this->XMLParser = nullptr;
@@ -236,6 +364,9 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << "," << this->TimeStepRange[1]
      << ")\n";
+  os << indent << "ParallelDecompression: " << this->ParallelDecompression << "\n";
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData << "\n";
+  os << indent << "NumberOfMappedArrays: " << this->NumberOfMappedArrays << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -448,6 +579,7 @@ void vtkXMLReader::CloseVTKFile()
     delete this->FileStream;
     this->FileStream = nullptr;
   }
+  // Arrays still pointing into the mapping keep it alive.
 }
 
 //------------------------------------------------------------------------------
@@ -475,6 +607,7 @@ void vtkXMLReader::CreateXMLParser()
     this->DestroyXMLParser();
   }
   this->XMLParser = vtkXMLDataParser::New();
+  this->XMLParser->SetParallelDecompression(this->ParallelDecompression);
 }
 
 //------------------------------------------------------------------------------
@@ -515,6 +648,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -675,6 +814,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
   this->CurrentTimeStep = this->TimeStep;
+  this->NumberOfMappedArrays = 0;
 
   // Get the output pipeline information and data object.
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
@@ -732,6 +872,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   // reads will work.
   (*this->Stream).imbue(std::locale::classic());
   this->XMLParser->SetStream(this->Stream);
+  this->XMLParser->SetParallelDecompression(this->ParallelDecompression);
 
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
@@ -969,24 +1110,33 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
     return 0;
   }
   this->InReadData = 1;
-  int result;
-  vtkArrayIterator* iter = array->NewIterator();
+  int result = 0;
   if (arrayIndex + numValues > array->GetNumberOfValues())
   {
     vtkErrorMacro("Array has " << array->GetNumberOfValues() << " allocated elements, but "
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (this->MemoryMapAppendedData && arrayIndex == 0 && startIndex == 0 &&
+    numValues == array->GetNumberOfValues() && this->MapArrayValues(da, array))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = 1;
   }
-  if (iter)
+  else
   {
-    iter->Delete();
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser, arrayIndex,
+          static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -1002,6 +1152,78 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array)
+{
+  // Only raw, uncompressed appended data read from a file in the native
+  // byte order can be used in place.
+  vtkIdType offset;
+  if (!this->FileName || !this->FileStream || this->Stream != this->FileStream ||
+    !da->GetScalarAttribute("offset", offset) || this->XMLParser->GetCompressor() ||
+    !this->XMLParser->IsAppendedDataRaw())
+  {
+    return false;
+  }
+#ifdef VTK_WORDS_BIGENDIAN
+  if (this->XMLParser->GetByteOrder() != vtkXMLDataParser::BigEndian)
+#else
+  if (this->XMLParser->GetByteOrder() != vtkXMLDataParser::LittleEndian)
+#endif
+  {
+    return false;
+  }
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  if (!dataArray || !dataArray->HasStandardMemoryLayout() ||
+    dataArray->GetDataType() == VTK_BIT || dataArray->GetNumberOfValues() == 0)
+  {
+    return false;
+  }
+
+  // The block starts with its size in bytes, followed by the values.
+  const std::size_t wordSize = static_cast<std::size_t>(dataArray->GetDataTypeSize());
+  const std::size_t headerSize = this->XMLParser->GetHeaderType() == 64 ? 8 : 4;
+  const std::size_t numBytes = static_cast<std::size_t>(dataArray->GetNumberOfValues()) * wordSize;
+  const vtkTypeInt64 blockPosition = this->XMLParser->GetAppendedDataPosition() + offset;
+  const vtkTypeInt64 valuesPosition = blockPosition + static_cast<vtkTypeInt64>(headerSize);
+  if (offset < 0 || blockPosition < 0 || valuesPosition % static_cast<vtkTypeInt64>(wordSize) != 0)
+  {
+    return false;
+  }
+  vtkTypeUInt64 blockSize = 0;
+  this->Stream->clear();
+  this->Stream->seekg(blockPosition);
+  if (headerSize == 8)
+  {
+    vtkTypeUInt64 size64 = 0;
+    this->Stream->read(reinterpret_cast<char*>(&size64), sizeof(size64));
+    blockSize = size64;
+  }
+  else
+  {
+    vtkTypeUInt32 size32 = 0;
+    this->Stream->read(reinterpret_cast<char*>(&size32), sizeof(size32));
+    blockSize = size32;
+  }
+  const bool headerRead = !this->Stream->fail();
+  this->Stream->clear();
+  if (!headerRead || blockSize != numBytes)
+  {
+    return false;
+  }
+
+  // Each array owns its own copy-on-write mapping, released with its values.
+  void* values = MapFileRange(this->FileName, static_cast<vtkTypeUInt64>(valuesPosition), numBytes);
+  if (!values)
+  {
+    vtkDebugMacro("Cannot map " << this->FileName << ", reading the array instead.");
+    return false;
+  }
+  dataArray->SetVoidArray(values, dataArray->GetNumberOfValues(), 0);
+  dataArray->SetArrayFreeFunction(&UnmapFileRange);
+  ++this->NumberOfMappedArrays;
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayTuples(vtkXMLDataElement* da, vtkIdType arrayTupleIndex,
   vtkAbstractArray* array, vtkIdType startTupleIndex, vtkIdType numTuples, FieldType fieldType)
@@ -1109,6 +1331,11 @@ void vtkXMLReader::ReadFieldData()
          i++)
     {
       vtkXMLDataElement* eNested = this->FieldDataElement->GetNestedElement(i);
+      if (!vtkStreamingDemandDrivenPipeline::IsArrayRequested(this->CurrentOutputInformation,
+            vtkDataObject::FIELD, eNested->GetAttribute("Name")))
+      {
+        continue;
+      }
       vtkAbstractArray* array = this->CreateArray(eNested);
       if (array)
       {
@@ -1880,14 +2107,18 @@ int vtkXMLReader::SetFieldDataInfo(
 int vtkXMLReader::PointDataArrayIsEnabled(vtkXMLDataElement* ePDA)
 {
   const char* name = ePDA->GetAttribute("Name");
-  return (name && this->PointDataArraySelection->ArrayIsEnabled(name));
+  return (name && this->PointDataArraySelection->ArrayIsEnabled(name) &&
+    vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+      this->CurrentOutputInformation, vtkDataObject::POINT, name));
 }
 
 //------------------------------------------------------------------------------
 int vtkXMLReader::CellDataArrayIsEnabled(vtkXMLDataElement* eCDA)
 {
   const char* name = eCDA->GetAttribute("Name");
-  return (name && this->CellDataArraySelection->ArrayIsEnabled(name));
+  return (name && this->CellDataArraySelection->ArrayIsEnabled(name) &&
+    vtkStreamingDemandDrivenPipeline::IsArrayRequested(
+      this->CurrentOutputInformation, vtkDataObject::CELL, name));
 }
 
 //------------------------------------------------------------------------------
@@ -216,6 +216,42 @@ public:
   vtkGetObjectMacro(ParserErrorObserver, vtkCommand);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether compressed binary and appended data blocks are
+   * decompressed concurrently using vtkSMPTools.  The data read is
+   * identical to the serial path.  The number of threads used is
+   * controlled through vtkSMPTools::Initialize().  Default is false.
+   */
+  vtkSetMacro(ParallelDecompression, bool);
+  vtkGetMacro(ParallelDecompression, bool);
+  vtkBooleanMacro(ParallelDecompression, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether arrays stored as raw, uncompressed appended data
+   * are memory-mapped instead of copied.  When enabled and the input is
+   * read from FileName, an array whose values cover a whole appended
+   * block, whose byte order matches the machine and whose start is
+   * suitably aligned in the file is made to point directly into its
+   * own private copy-on-write mapping of the file.  Pages are then
+   * loaded on demand, and the mapping is released with the values of
+   * the array.  Arrays that do not qualify or cannot be mapped are read
+   * as usual.  The file should not be truncated or modified while mapped
+   * arrays are alive.  Default is false.
+   */
+  vtkSetMacro(MemoryMapAppendedData, bool);
+  vtkGetMacro(MemoryMapAppendedData, bool);
+  vtkBooleanMacro(MemoryMapAppendedData, bool);
+  ///@}
+
+  /**
+   * Get the number of arrays memory-mapped by the last update of the
+   * reader.  See MemoryMapAppendedData.
+   */
+  vtkGetMacro(NumberOfMappedArrays, vtkIdType);
+
 protected:
   vtkXMLReader();
   ~vtkXMLReader() override;
@@ -453,6 +489,19 @@ protected:
   // Whether there was an error reading the file in RequestData.
   int DataError;
 
+  // Whether to decompress data blocks concurrently.
+  bool ParallelDecompression;
+
+  // Whether to memory-map raw appended arrays instead of copying them.
+  bool MemoryMapAppendedData;
+
+  // Number of arrays memory-mapped by the last update.
+  vtkIdType NumberOfMappedArrays;
+
+  // Try to make the array point into a mapping of the file instead of
+  // reading its values.  Returns true on success.
+  bool MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   // incrementally fine-tuned progress updates.
   virtual void GetProgressRange(float* range);
   virtual void SetProgressRange(const float range[2], int curStep, int numSteps);
@@ -31,10 +31,15 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZLibDataCompressor.h"
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef vtkXMLOffsetsManager_DoNotInclude
@@ -51,6 +56,7 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <sstream>
@@ -576,6 +582,18 @@ int vtkXMLWriter::RequestData(vtkInformation* vtkNotUsed(request),
 //------------------------------------------------------------------------------
 int vtkXMLWriter::OpenStream()
 {
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+  // The readers cannot provide the dictionary the blocks were compressed with.
+  vtkZstdDataCompressor* zstd = vtkZstdDataCompressor::SafeDownCast(this->Compressor);
+  if (zstd && zstd->GetDictionarySize() > 0)
+  {
+    vtkErrorMacro("Zstd compression with a dictionary cannot be read back, "
+                  "clear the dictionary of the compressor.");
+    this->SetErrorCode(vtkErrorCode::UserError);
+    return 0;
+  }
+#endif
+
   if (this->Stream)
   {
     // Rewind stream to the beginning.
@@ -1005,6 +1023,14 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write any blocks still waiting in the parallel batch.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->PendingCompressionData.clear();
+    this->PendingCompressionBlockSizes.clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1367,8 +1393,30 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  if (this->ParallelCompression)
+  {
+    // Queue the block.  Blocks are independent, so a batch of them can
+    // be compressed concurrently and then written in their original order.
+    this->PendingCompressionData.insert(this->PendingCompressionData.end(), data, data + size);
+    this->PendingCompressionBlockSizes.push_back(size);
+
+    // Keep a few blocks per thread in flight to balance the load while
+    // bounding the memory held by the batch.
+    const size_t batchSize =
+      4 * static_cast<size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+    if (this->PendingCompressionBlockSizes.size() >= batchSize)
+    {
+      return this->FlushCompressionBlocks();
+    }
+    return 1;
+  }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  if (!outputArray)
+  {
+    return 0;
+  }
 
   // Find the compressed size.
   size_t outputSize = outputArray->GetNumberOfTuples();
@@ -1390,6 +1438,63 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   return result;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  const size_t numBlocks = this->PendingCompressionBlockSizes.size();
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
+
+  // Find where each queued block starts in the pending buffer.
+  std::vector<size_t> blockOffsets(numBlocks);
+  size_t offset = 0;
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    blockOffsets[i] = offset;
+    offset += this->PendingCompressionBlockSizes[i];
+  }
+
+  // Compress all blocks of the batch concurrently.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> outputArrays(numBlocks);
+  vtkDataCompressor* compressor = this->Compressor;
+  const unsigned char* pendingData = this->PendingCompressionData.data();
+  const size_t* blockSizes = this->PendingCompressionBlockSizes.data();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      outputArrays[i].TakeReference(
+        compressor->Compress(pendingData + blockOffsets[i], blockSizes[i]));
+    }
+  });
+
+  // Write the compressed blocks in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    vtkUnsignedCharArray* outputArray = outputArrays[i];
+    if (!outputArray)
+    {
+      result = 0;
+      break;
+    }
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    result = this->DataStream->Write(outputArray->GetPointer(0), outputSize);
+    this->Stream->flush();
+    if (this->Stream->fail())
+    {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+      result = 0;
+    }
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
+
+  this->PendingCompressionData.clear();
+  this->PendingCompressionBlockSizes.clear();
+  return result;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
@@ -8,6 +8,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
@@ -31,6 +34,7 @@ vtkXMLWriterBase::vtkXMLWriterBase()
   , Compressor(vtkZLibDataCompressor::New())
   , BlockSize(32768) // 2^15
   , CompressionLevel(5)
+  , ParallelCompression(false)
   , UsePreviousVersion(true)
 {
   this->SetNumberOfInputPorts(1);
@@ -120,6 +124,20 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkErrorMacro("Zstd compression requires VTK to be built with the IOZstd module.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -259,5 +277,6 @@ void vtkXMLWriterBase::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "ParallelCompression: " << this->ParallelCompression << "\n";
 }
 VTK_ABI_NAMESPACE_END
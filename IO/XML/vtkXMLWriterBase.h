@@ -139,18 +139,21 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   ///@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD is only available when VTK is built with the IOZstd module.
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
   ///@}
 
   ///@{
@@ -173,6 +176,20 @@ public:
   vtkGetMacro(BlockSize, size_t);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether compression blocks are compressed concurrently.
+   * When enabled, consecutive blocks of an array are gathered into
+   * batches that are compressed in parallel using vtkSMPTools and then
+   * written in order, so the output is byte-identical to the serial
+   * path. The number of threads used is controlled through
+   * vtkSMPTools::Initialize(). Default is false.
+   */
+  vtkSetMacro(ParallelCompression, bool);
+  vtkGetMacro(ParallelCompression, bool);
+  vtkBooleanMacro(ParallelCompression, bool);
+  ///@}
+
   ///@{
   /**
    * Get/Set the data mode used for the file's data.  The options are
@@ -263,6 +280,9 @@ protected:
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel;
 
+  // Whether to compress blocks concurrently.
+  bool ParallelCompression;
+
   // This variable is used to ease transition to new versions of VTK XML files.
   // If data that needs to be written satisfies certain conditions,
   // the writer can use the previous file version version.
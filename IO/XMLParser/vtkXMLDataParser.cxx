@@ -9,12 +9,14 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -44,6 +46,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
   this->Compressor = nullptr;
+  this->ParallelDecompression = false;
 
   this->AsciiDataBuffer = nullptr;
   this->AsciiDataBufferLength = 0;
@@ -102,6 +105,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Compressor: (none)\n";
   }
+  os << indent << "ParallelDecompression: " << this->ParallelDecompression << "\n";
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
@@ -169,6 +173,12 @@ void vtkXMLDataParser::StartElement(const char* name, const char** atts)
   }
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLDataParser::IsAppendedDataRaw()
+{
+  return this->AppendedDataStream && !this->AppendedDataStream->IsA("vtkBase64InputStream");
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLDataParser::SeekInlineDataPosition(vtkXMLDataElement* element)
 {
@@ -628,6 +638,50 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadFullBlocks(
+  vtkTypeUInt64 firstBlock, size_t numBlocks, unsigned char* buffer, size_t wordSize)
+{
+  // The blocks are stored contiguously, so the compressed bytes of the
+  // whole range can be fetched with a single read.
+  size_t compressedSize = 0;
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    compressedSize += this->BlockCompressedSizes[firstBlock + i];
+  }
+  if (!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  // Decompress and byte swap the independent blocks concurrently.
+  const vtkTypeInt64 baseOffset = this->BlockStartOffsets[firstBlock];
+  const size_t blockSize = this->BlockUncompressedSize;
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkTypeUInt64 block = firstBlock + i;
+      unsigned char* output = buffer + i * blockSize;
+      const size_t result = this->Compressor->Uncompress(
+        readBuffer.data() + (this->BlockStartOffsets[block] - baseOffset),
+        this->BlockCompressedSizes[block], output, blockSize);
+      if (result == 0)
+      {
+        success = false;
+        return;
+      }
+      this->PerformByteSwap(output, blockSize / wordSize, wordSize);
+    }
+  });
+  return success ? 1 : 0;
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -800,7 +854,27 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    if (this->ParallelDecompression)
+    {
+      // Decompress the complete blocks in batches of a few blocks per
+      // thread so that progress and abort requests are still honored.
+      const vtkTypeUInt64 batchSize =
+        4 * static_cast<vtkTypeUInt64>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+      while (currentBlock != lastBlock && !this->Abort)
+      {
+        const size_t numBlocks = static_cast<size_t>(std::min(batchSize, lastBlock - currentBlock));
+        if (!this->ReadFullBlocks(currentBlock, numBlocks, outputPointer, wordSize))
+        {
+          return 0;
+        }
+        outputPointer += numBlocks * blockSize;
+        currentBlock += numBlocks;
+
+        // Report progress.
+        this->UpdateProgress(float(outputPointer - data) / length);
+      }
+    }
     for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
     {
       // Read this block.
@@ -91,6 +91,19 @@ public:
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether complete compression blocks are decompressed
+   * concurrently.  When enabled, the compressed bytes of a batch of
+   * consecutive blocks are read from the stream and then decompressed
+   * in parallel using vtkSMPTools.  The number of threads used is
+   * controlled through vtkSMPTools::Initialize().  Default is false.
+   */
+  vtkSetMacro(ParallelDecompression, bool);
+  vtkGetMacro(ParallelDecompression, bool);
+  vtkBooleanMacro(ParallelDecompression, bool);
+  ///@}
+
   /**
    * Get the size of a word of the given type.
    */
@@ -147,6 +160,22 @@ public:
    */
   vtkTypeInt64 GetAppendedDataPosition() { return this->AppendedDataPosition; }
 
+  /**
+   * Returns true if the appended data section is stored raw rather
+   * than base64 encoded. Valid after the XML is parsed.
+   */
+  bool IsAppendedDataRaw();
+
+  ///@{
+  /**
+   * Get the byte order (BigEndian or LittleEndian) and the size in bits
+   * of the header words (32 or 64) of the binary data. Valid after the
+   * XML is parsed.
+   */
+  vtkGetMacro(ByteOrder, int);
+  vtkGetMacro(HeaderType, int);
+  ///@}
+
 protected:
   vtkXMLDataParser();
   ~vtkXMLDataParser() override;
@@ -175,6 +204,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadFullBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks, unsigned char* buffer,
+    size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -231,6 +262,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  bool ParallelDecompression;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
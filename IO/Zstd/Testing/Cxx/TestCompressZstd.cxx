@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+// Round trips data through the compressor with several levels, long
+// distance matching and a dictionary, then through the XML writer and
+// reader with every setting the writer allows.
+
+#include "vtkCommand.h"
+#include "vtkErrorCode.h"
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool RoundTrip(vtkZstdDataCompressor* compressor, const std::vector<unsigned char>& buffer)
+{
+  std::vector<unsigned char> cbuffer(compressor->GetMaximumCompressionSpace(buffer.size()));
+  size_t rlen = compressor->Compress(buffer.data(), buffer.size(), cbuffer.data(), cbuffer.size());
+  if (rlen == 0)
+  {
+    std::cerr << "Compression failed at level " << compressor->GetZstdLevel() << std::endl;
+    return false;
+  }
+  std::vector<unsigned char> ucbuffer(buffer.size());
+  rlen = compressor->Uncompress(cbuffer.data(), rlen, ucbuffer.data(), ucbuffer.size());
+  if (rlen != buffer.size() || ucbuffer != buffer)
+  {
+    std::cerr << "Round trip failed at level " << compressor->GetZstdLevel() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool XMLRoundTrip(vtkXMLImageDataWriter* writer, vtkFloatArray* values, const char* setting)
+{
+  if (!writer->Write())
+  {
+    std::cerr << "XML writing failed with " << setting << std::endl;
+    return false;
+  }
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->Update();
+  vtkDataArray* result = reader->GetOutput()->GetPointData()->GetArray("Values");
+  if (!result || result->GetNumberOfTuples() != values->GetNumberOfTuples())
+  {
+    std::cerr << "XML round trip failed with " << setting << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    if (result->GetComponent(i, 0) != values->GetValue(i))
+    {
+      std::cerr << "XML round trip differs at " << i << " with " << setting << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCompressZstd(int, char*[])
+{
+  std::vector<unsigned char> buffer(100024);
+  for (size_t cc = 0; cc < buffer.size(); cc++)
+  {
+    buffer[cc] = static_cast<unsigned char>((cc * cc) % 251);
+  }
+  std::memcpy(buffer.data(), "vtk", 3);
+
+  bool success = true;
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int level = 1; level <= 9; ++level)
+  {
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level)
+    {
+      std::cerr << "CompressionLevel " << level << " not preserved." << std::endl;
+      success = false;
+    }
+    success &= RoundTrip(compressor, buffer);
+  }
+
+  // Negative "fast" levels and long distance matching.
+  compressor->SetZstdLevel(-5);
+  if (compressor->GetZstdLevel() != -5)
+  {
+    std::cerr << "Negative level not accepted." << std::endl;
+    success = false;
+  }
+  compressor->LongDistanceMatchingOn();
+  compressor->SetWindowLog(5);
+  if (compressor->GetWindowLog() != 10)
+  {
+    std::cerr << "Window log below the zstd minimum not clamped." << std::endl;
+    success = false;
+  }
+  success &= RoundTrip(compressor, buffer);
+  compressor->SetWindowLog(24);
+  success &= RoundTrip(compressor, buffer);
+
+  // Dictionary compression.
+  compressor->SetZstdLevel(3);
+  compressor->SetDictionary(buffer.data(), 4096);
+  success &= RoundTrip(compressor, buffer);
+  compressor->ClearDictionary();
+
+  // XML writer and reader integration, with every setting the writer allows.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 20, 20);
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    values->SetValue(i, static_cast<float>(i % 97) * 0.5f);
+  }
+  image->GetPointData()->SetScalars(values);
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorTypeToZstd();
+  vtkZstdDataCompressor* writerCompressor =
+    vtkZstdDataCompressor::SafeDownCast(writer->GetCompressor());
+  if (!writerCompressor)
+  {
+    std::cerr << "Writer does not use vtkZstdDataCompressor." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int level = 1; level <= 9; ++level)
+  {
+    writer->SetCompressionLevel(level);
+    success &= XMLRoundTrip(writer, values, "compression level");
+  }
+  writerCompressor->SetZstdLevel(-5);
+  success &= XMLRoundTrip(writer, values, "negative level");
+  writerCompressor->SetZstdLevel(3);
+  writerCompressor->LongDistanceMatchingOn();
+  success &= XMLRoundTrip(writer, values, "long distance matching");
+  for (int windowLog : { 10, 24, 27, 28, 31 })
+  {
+    writerCompressor->SetWindowLog(windowLog);
+    success &= XMLRoundTrip(writer, values, "window log");
+  }
+
+  // Files compressed with a dictionary could not be read back.
+  writerCompressor->SetDictionary(buffer.data(), 4096);
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  writer->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  writer->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  writer->Write();
+  if (writer->GetErrorCode() != vtkErrorCode::UserError || !errorObserver->GetError())
+  {
+    std::cerr << "Writing with a dictionary did not fail." << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+namespace
+{
+// zstd levels matching the generic 1..9 compression levels.
+const int ZstdLevels[9] = { 1, 2, 3, 5, 7, 9, 12, 15, 19 };
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->ZstdLevel = 3;
+  this->LongDistanceMatching = false;
+  this->WindowLog = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ZstdLevel: " << this->ZstdLevel << endl;
+  os << indent << "LongDistanceMatching: " << this->LongDistanceMatching << endl;
+  os << indent << "WindowLog: " << this->WindowLog << endl;
+  os << indent << "DictionarySize: " << this->Dictionary.size() << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // Use a context per call so that blocks may be compressed concurrently.
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  if (!cctx)
+  {
+    vtkErrorMacro("Zstd error while creating compression context.");
+    return 0;
+  }
+
+  size_t result = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, this->ZstdLevel);
+  if (!ZSTD_isError(result) && this->LongDistanceMatching)
+  {
+    result = ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+  }
+  if (!ZSTD_isError(result) && this->WindowLog > 0)
+  {
+    result = ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, this->WindowLog);
+  }
+  if (!ZSTD_isError(result) && !this->Dictionary.empty())
+  {
+    result = ZSTD_CCtx_loadDictionary(cctx, this->Dictionary.data(), this->Dictionary.size());
+  }
+  if (!ZSTD_isError(result))
+  {
+    result =
+      ZSTD_compress2(cctx, compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  }
+  ZSTD_freeCCtx(cctx);
+
+  if (ZSTD_isError(result))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(result));
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  ZSTD_DCtx* dctx = ZSTD_createDCtx();
+  if (!dctx)
+  {
+    vtkErrorMacro("Zstd error while creating decompression context.");
+    return 0;
+  }
+
+  // The whole output buffer is provided, so no window is allocated: accept
+  // the largest ones, whatever the WindowLog used for compression.
+  const ZSTD_bounds bounds = ZSTD_dParam_getBounds(ZSTD_d_windowLogMax);
+  size_t result = ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, bounds.upperBound);
+  if (!ZSTD_isError(result) && !this->Dictionary.empty())
+  {
+    result = ZSTD_DCtx_loadDictionary(dctx, this->Dictionary.data(), this->Dictionary.size());
+  }
+  if (!ZSTD_isError(result))
+  {
+    result =
+      ZSTD_decompressDCtx(dctx, uncompressedData, uncompressedSize, compressedData, compressedSize);
+  }
+  ZSTD_freeDCtx(dctx);
+
+  if (ZSTD_isError(result))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(result));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (result != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << result);
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  // Report the generic level whose zstd level is closest to the current one.
+  int level = 1;
+  while (level < 9 && ZstdLevels[level] <= this->ZstdLevel)
+  {
+    ++level;
+  }
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << level);
+  return level;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  compressionLevel = std::min(std::max(compressionLevel, min), max);
+  this->SetZstdLevel(ZstdLevels[compressionLevel - 1]);
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetZstdLevel(int level)
+{
+  level = std::min(std::max(level, ZSTD_minCLevel()), ZSTD_maxCLevel());
+  if (this->ZstdLevel != level)
+  {
+    this->ZstdLevel = level;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetWindowLog(int windowLog)
+{
+  // 0 lets zstd choose, other values must be within the bounds of zstd.
+  if (windowLog > 0)
+  {
+    const ZSTD_bounds bounds = ZSTD_cParam_getBounds(ZSTD_c_windowLog);
+    windowLog = std::min(std::max(windowLog, bounds.lowerBound), bounds.upperBound);
+  }
+  else
+  {
+    windowLog = 0;
+  }
+  if (this->WindowLog != windowLog)
+  {
+    this->WindowLog = windowLog;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetDictionary(const unsigned char* dictionary, size_t size)
+{
+  if (!dictionary || size == 0)
+  {
+    if (!this->Dictionary.empty())
+    {
+      this->Dictionary.clear();
+      this->Modified();
+    }
+    return;
+  }
+  this->Dictionary.assign(dictionary, dictionary + size);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+VTK_ABI_NAMESPACE_END
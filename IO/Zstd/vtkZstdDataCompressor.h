@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using Zstandard (zstd) for compressing and uncompressing data.
+ *
+ * The generic CompressionLevel (1..9) is mapped onto the zstd level
+ * range.  The full zstd range, including the negative "fast" levels,
+ * can be used directly through SetZstdLevel.  Long distance matching
+ * may be enabled to find redundancy across large blocks, and a
+ * dictionary may be provided to improve the ratio on small blocks.
+ * Data compressed with a dictionary can only be uncompressed by a
+ * compressor holding the same dictionary, so the XML writers refuse
+ * to write files with such a compressor.
+ *
+ * Every call uses its own zstd contexts, so a single instance may be
+ * used to compress or uncompress several blocks concurrently.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOZstdModule.h" // For export macro
+
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOZSTD_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  ///@{
+  /**
+   *  Get/Set the compression level.  The values 1..9 are mapped onto
+   *  the zstd levels 1..19.
+   */
+  // Compression level getter required by vtkDataCompressor.
+  int GetCompressionLevel() override;
+
+  // Compression level setter required by vtkDataCompressor.
+  void SetCompressionLevel(int compressionLevel) override;
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the zstd compression level directly.  Values are clamped
+   * to the range supported by the zstd library, which includes
+   * negative levels trading ratio for speed.  Default is 3.
+   */
+  virtual void SetZstdLevel(int level);
+  vtkGetMacro(ZstdLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether long distance matching is enabled.  This improves
+   * the compression ratio of large blocks containing distant repeated
+   * content at the cost of memory.  Default is false.
+   */
+  vtkSetMacro(LongDistanceMatching, bool);
+  vtkGetMacro(LongDistanceMatching, bool);
+  vtkBooleanMacro(LongDistanceMatching, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the base-2 logarithm of the maximum back-reference
+   * distance.  Zero lets zstd choose it from the level.  Other values
+   * are clamped to the range supported by zstd, 10 to 30 or 31.  Data
+   * compressed with any window log can be uncompressed, whatever the
+   * setting of the uncompressing compressor.  Default is 0.
+   */
+  virtual void SetWindowLog(int windowLog);
+  vtkGetMacro(WindowLog, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the dictionary used for compression and decompression.  The
+   * content is copied.  Passing a null pointer or zero size clears it.
+   * Dictionaries are typically trained with `zstd --train` on samples
+   * of representative blocks.
+   */
+  void SetDictionary(const unsigned char* dictionary, size_t size);
+  void ClearDictionary() { this->SetDictionary(nullptr, 0); }
+  size_t GetDictionarySize() const { return this->Dictionary.size(); }
+  ///@}
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int ZstdLevel;
+  bool LongDistanceMatching;
+  int WindowLog;
+  std::vector<unsigned char> Dictionary;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
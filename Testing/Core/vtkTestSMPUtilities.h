@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Functions used to check that an algorithm threaded with vtkSMPTools produces
+ * the same output with any number of threads.
+ *
+ * Unlike vtkTestUtilities::CompareDataObjects, the comparisons are exact and
+ * depend on the order of the points, the cells and the arrays.
+ */
+#ifndef vtkTestSMPUtilities_h
+#define vtkTestSMPUtilities_h
+
+#include "vtkCellArray.h"    // For vtkCellArray
+#include "vtkCellData.h"     // For vtkCellData
+#include "vtkDataArray.h"    // For vtkDataArray
+#include "vtkFieldData.h"    // For vtkFieldData
+#include "vtkPointData.h"    // For vtkPointData
+#include "vtkPoints.h"       // For vtkPoints
+#include "vtkPolyData.h"     // For vtkPolyData
+#include "vtkSMPTools.h"     // For vtkSMPTools::LocalScope
+#include "vtkSmartPointer.h" // For vtkSmartPointer
+#include "vtkVariant.h"      // For vtkVariant
+
+#include <algorithm>   // For std::equal
+#include <cstring>     // For std::strcmp
+#include <type_traits> // For std::remove_pointer
+
+namespace vtkTest
+{
+VTK_ABI_NAMESPACE_BEGIN
+/**
+ * Return true if both arrays exist and have the same number of tuples and
+ * components and exactly the same values.
+ */
+inline bool SameArray(vtkAbstractArray* array0, vtkAbstractArray* array1)
+{
+  if (!array0 || !array1 || array0->GetNumberOfTuples() != array1->GetNumberOfTuples() ||
+    array0->GetNumberOfComponents() != array1->GetNumberOfComponents())
+  {
+    return false;
+  }
+  vtkDataArray* dataArray0 = vtkDataArray::SafeDownCast(array0);
+  vtkDataArray* dataArray1 = vtkDataArray::SafeDownCast(array1);
+  if (dataArray0 && dataArray1)
+  {
+    const int numComps = dataArray0->GetNumberOfComponents();
+    for (vtkIdType tupleId = 0; tupleId < dataArray0->GetNumberOfTuples(); ++tupleId)
+    {
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        if (dataArray0->GetComponent(tupleId, comp) != dataArray1->GetComponent(tupleId, comp))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  for (vtkIdType valueId = 0; valueId < array0->GetNumberOfValues(); ++valueId)
+  {
+    if (array0->GetVariantValue(valueId) != array1->GetVariantValue(valueId))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if the field data have the same arrays, in the same order.
+ */
+inline bool SameFieldData(vtkFieldData* data0, vtkFieldData* data1)
+{
+  if (data0->GetNumberOfArrays() != data1->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int arrayId = 0; arrayId < data0->GetNumberOfArrays(); ++arrayId)
+  {
+    vtkAbstractArray* array0 = data0->GetAbstractArray(arrayId);
+    vtkAbstractArray* array1 = data1->GetAbstractArray(arrayId);
+    const char* name0 = array0 && array0->GetName() ? array0->GetName() : "";
+    const char* name1 = array1 && array1->GetName() ? array1->GetName() : "";
+    if (std::strcmp(name0, name1) != 0 || !SameArray(array0, array1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if the cell arrays have the same cells, in the same order.
+ */
+inline bool SameCells(vtkCellArray* cells0, vtkCellArray* cells1)
+{
+  if (!cells0 || !cells1)
+  {
+    return cells0 == cells1;
+  }
+  if (cells0->GetNumberOfCells() != cells1->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkIdType npts0, npts1;
+  const vtkIdType *pts0, *pts1;
+  for (vtkIdType cellId = 0; cellId < cells0->GetNumberOfCells(); ++cellId)
+  {
+    cells0->GetCellAtId(cellId, npts0, pts0);
+    cells1->GetCellAtId(cellId, npts1, pts1);
+    if (npts0 != npts1 || !std::equal(pts0, pts0 + npts0, pts1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if the polydata have the same points, cells, point data, cell
+ * data and field data.
+ */
+inline bool SamePolyData(vtkPolyData* polyData0, vtkPolyData* polyData1)
+{
+  vtkPoints* points0 = polyData0->GetPoints();
+  vtkPoints* points1 = polyData1->GetPoints();
+  if (!points0 || !points1)
+  {
+    return !points0 && !points1 && polyData0->GetNumberOfCells() == 0 &&
+      polyData1->GetNumberOfCells() == 0;
+  }
+  return SameArray(points0->GetData(), points1->GetData()) &&
+    SameCells(polyData0->GetVerts(), polyData1->GetVerts()) &&
+    SameCells(polyData0->GetLines(), polyData1->GetLines()) &&
+    SameCells(polyData0->GetPolys(), polyData1->GetPolys()) &&
+    SameCells(polyData0->GetStrips(), polyData1->GetStrips()) &&
+    SameFieldData(polyData0->GetPointData(), polyData1->GetPointData()) &&
+    SameFieldData(polyData0->GetCellData(), polyData1->GetCellData()) &&
+    SameFieldData(polyData0->GetFieldData(), polyData1->GetFieldData());
+}
+
+/**
+ * Call the functor with a single thread and return its result.
+ */
+template <class FunctorT>
+auto ExecuteOnOneThread(FunctorT&& functor) -> decltype(functor())
+{
+  decltype(functor()) result;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { result = functor(); });
+  return result;
+}
+
+/**
+ * Execute the algorithm again and return a copy of its output.
+ */
+template <class AlgorithmT>
+auto UpdateAndCopy(AlgorithmT* algorithm)
+  -> vtkSmartPointer<typename std::remove_pointer<decltype(algorithm->GetOutput())>::type>
+{
+  using OutputT = typename std::remove_pointer<decltype(algorithm->GetOutput())>::type;
+  algorithm->Modified();
+  algorithm->Update();
+  vtkSmartPointer<OutputT> output;
+  output.TakeReference(algorithm->GetOutput()->NewInstance());
+  output->DeepCopy(algorithm->GetOutput());
+  return output;
+}
+
+/**
+ * Execute the polydata algorithm with the current number of threads, then
+ * with a single thread, and return true if both outputs have cells and are the
+ * same.
+ */
+template <class AlgorithmT>
+bool SamePolyDataOnOneThread(AlgorithmT* algorithm)
+{
+  vtkSmartPointer<vtkPolyData> output = UpdateAndCopy(algorithm);
+  vtkSmartPointer<vtkPolyData> singleThreaded =
+    ExecuteOnOneThread([&]() { return UpdateAndCopy(algorithm); });
+  return output->GetNumberOfCells() > 0 && SamePolyData(output, singleThreaded);
+}
+VTK_ABI_NAMESPACE_END
+}
+#endif
+// VTK-HeaderTest-Exclude: vtkTestSMPUtilities.h